@@ -0,0 +1,95 @@
+# Runtime CPU dispatching of the hot kernels
+# ----------------------------------------------------------------------------
+# The baseline instruction set of the library is fixed by the ENABLE_<ISA> options.
+# The kernels from <name>.simd.hpp files can be additionally compiled for the newer
+# instruction sets listed in CPU_DISPATCH, the best copy is selected at runtime with
+# cv::checkHardwareSupport(), see opencv2/core/cv_cpu_dispatch.h:
+#
+#   ocv_add_dispatched_file(arithm)  # in the module CMakeLists.txt, compiles src/arithm.simd.hpp
+#                                    # for each of CPU_DISPATCH_FINAL instruction sets
+#
+#   #include "arithm.simd.hpp"                # baseline code, cv::cpu_baseline namespace
+#   #include "arithm.simd_declarations.hpp"   # cv::opt_AVX2, cv::opt_AVX512 declarations
+#   ...
+#   return CV_CPU_DISPATCH(div_simd, (src1, src2, dst, width, scale));
+
+set(CPU_DISPATCH_SUPPORTED "AVX2;AVX512")
+set(CPU_DISPATCH "${CPU_DISPATCH_SUPPORTED}" CACHE STRING "Instruction sets for the runtime dispatched kernels (${CPU_DISPATCH_SUPPORTED})")
+
+if(MSVC)
+  set(CPU_AVX2_FLAGS_ON "/arch:AVX2")
+elseif(CMAKE_COMPILER_IS_GNUCXX OR CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+  set(CPU_AVX2_FLAGS_ON "-mavx2")
+  set(CPU_AVX512_FLAGS_ON "-mavx512f -mavx512bw")
+  # results of the dispatched kernels must be bit-exact with the baseline ones,
+  # so the compiler is not allowed to fuse the separate multiplications and additions
+  ocv_check_flag_support(CXX "-ffp-contract=off" _varname)
+  if(${_varname})
+    set(CPU_DISPATCH_FLAGS_COMMON "-ffp-contract=off")
+  endif()
+endif()
+
+# the instruction sets which are already enabled for the whole library are not dispatched
+set(CPU_AVX2_BASELINE ${ENABLE_AVX2})
+
+set(CPU_DISPATCH_FINAL "")
+if((X86 OR X86_64) AND NOT MINGW)
+  foreach(mode ${CPU_DISPATCH})
+    list(FIND CPU_DISPATCH_SUPPORTED "${mode}" __idx)
+    if(__idx EQUAL -1)
+      message(WARNING "CPU_DISPATCH: unknown instruction set '${mode}', ignored")
+    elseif(DEFINED CPU_${mode}_FLAGS_ON AND NOT CPU_${mode}_BASELINE)
+      ocv_check_flag_support(CXX "${CPU_${mode}_FLAGS_ON}" _varname)
+      if(${_varname})
+        list(APPEND CPU_DISPATCH_FINAL ${mode})
+      endif()
+    endif()
+  endforeach()
+endif()
+
+set(OPENCV_CPU_DISPATCH_DEFINITIONS_CONFIGMAKE "")
+foreach(mode ${CPU_DISPATCH_FINAL})
+  set(OPENCV_CPU_DISPATCH_DEFINITIONS_CONFIGMAKE "${OPENCV_CPU_DISPATCH_DEFINITIONS_CONFIGMAKE}#define CV_TRY_${mode} 1\n")
+endforeach()
+configure_file("${OpenCV_SOURCE_DIR}/cmake/templates/cv_cpu_config.h.in" "${OPENCV_CONFIG_FILE_INCLUDE_DIR}/cv_cpu_config.h")
+
+# Compiles src/<filename>.simd.hpp of the current module once more for every CPU_DISPATCH_FINAL
+# instruction set and generates <filename>.simd_declarations.hpp with the declarations of these copies.
+# Must be called before ocv_glob_module_sources() (ocv_define_module()).
+macro(ocv_add_dispatched_file filename)
+  if(NOT OPENCV_INITIAL_PASS)
+    set(__src "${CMAKE_CURRENT_LIST_DIR}/src/${filename}.simd.hpp")
+    if(NOT EXISTS "${__src}")
+      message(FATAL_ERROR "ocv_add_dispatched_file: ${__src} is not found")
+    endif()
+    set(__declarations "// Generated by ocv_add_dispatched_file(), do not edit\n\n")
+    foreach(mode ${CPU_DISPATCH_FINAL})
+      string(TOLOWER "${mode}" __mode_lower)
+      set(__file "${CMAKE_CURRENT_BINARY_DIR}/${filename}.${__mode_lower}.cpp")
+      set(__content "// Generated by ocv_add_dispatched_file(), do not edit\n\n#define CV_CPU_DISPATCH_MODE ${mode}\n#include \"opencv2/core/cv_cpu_dispatch.h\"\n#include \"${__src}\"\n")
+      if(EXISTS "${__file}")
+        file(READ "${__file}" __old_content)
+      else()
+        set(__old_content "")
+      endif()
+      if(NOT __old_content STREQUAL __content)
+        file(WRITE "${__file}" "${__content}")
+      endif()
+      set_source_files_properties("${__file}" PROPERTIES
+          COMPILE_FLAGS "${CPU_${mode}_FLAGS_ON} ${CPU_DISPATCH_FLAGS_COMMON}"
+          SKIP_PRECOMPILE_HEADERS ON)
+      list(APPEND OPENCV_DISPATCHED_SOURCES "${__file}")
+      set(__declarations "${__declarations}#define CV_CPU_SIMD_FILENAME \"${__src}\"\n#define CV_CPU_DISPATCH_MODE ${mode}\n#include \"opencv2/core/cv_cpu_include_simd_declarations.hpp\"\n#undef CV_CPU_SIMD_FILENAME\n\n")
+    endforeach()
+    set(__file "${CMAKE_CURRENT_BINARY_DIR}/${filename}.simd_declarations.hpp")
+    if(EXISTS "${__file}")
+      file(READ "${__file}" __old_content)
+    else()
+      set(__old_content "")
+    endif()
+    if(NOT __old_content STREQUAL __declarations)
+      file(WRITE "${__file}" "${__declarations}")
+    endif()
+    list(APPEND OPENCV_DISPATCHED_SOURCES "${__file}")
+  endif()
+endmacro()
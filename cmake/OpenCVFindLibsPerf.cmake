@@ -133,3 +133,10 @@ if(WITH_PTHREADS_PF)
 else()
   set(HAVE_PTHREADS_PF 0)
 endif()
+
+ocv_clear_vars(HAVE_WORKSTEALING_PF)
+if(WITH_WORKSTEALING_PF)
+  set(HAVE_WORKSTEALING_PF ${HAVE_PTHREADS})
+else()
+  set(HAVE_WORKSTEALING_PF 0)
+endif()
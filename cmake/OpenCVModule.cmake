@@ -710,6 +710,11 @@ macro(ocv_glob_module_sources)
     list(APPEND lib_srcs ${cl_kernels} "${CMAKE_CURRENT_BINARY_DIR}/${OCL_NAME}.cpp" "${CMAKE_CURRENT_BINARY_DIR}/${OCL_NAME}.hpp")
   endif()
 
+  if(OPENCV_DISPATCHED_SOURCES)
+    ocv_source_group("Src\\autogenerated" FILES ${OPENCV_DISPATCHED_SOURCES})
+    list(APPEND lib_srcs ${OPENCV_DISPATCHED_SOURCES})
+  endif()
+
   ocv_set_module_sources(${_argn} HEADERS ${lib_hdrs} ${lib_hdrs_detail}
                          SOURCES ${lib_srcs} ${lib_int_hdrs} ${lib_cuda_srcs} ${lib_cuda_hdrs})
 endmacro()
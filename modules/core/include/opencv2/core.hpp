@@ -207,7 +207,9 @@ enum KmeansFlags {
         user-supplied labels instead of computing them from the initial centers. For the second and
         further attempts, use the random or semi-random centers. Use one of KMEANS_\*_CENTERS flag
         to specify the exact method.*/
-    KMEANS_USE_INITIAL_LABELS = 1
+    KMEANS_USE_INITIAL_LABELS = 1,
+    /** Update the centers by random subsets of the samples of the default size, see cv::kmeansMiniBatch.*/
+    KMEANS_MINI_BATCH         = 4
 };
 
 //! type of line
@@ -540,6 +542,36 @@ number of channels as in the input array.
 */
 CV_EXPORTS_W void LUT(InputArray src, InputArray lut, OutputArray dst);
 
+/** @brief Scales, optionally transforms by a look-up table and reorders channels of an array in one pass.
+
+The function is equivalent to the sequence of per-channel Mat::convertTo, LUT and mixChannels calls,
+but reads the source and writes the destination only once, which matters for large images.
+Every channel c of src is first transformed as
+\f[\texttt{t} (I)_c  \leftarrow \texttt{src} (I)_c \cdot \texttt{alpha} _c +  \texttt{beta} _c\f]
+When lut is not empty, the result is saturated to 8 bits and used as an index in the table:
+\f[\texttt{t} (I)_c  \leftarrow \texttt{lut} ( \texttt{saturate\_cast<uchar>} ( \texttt{t} (I)_c))\f]
+The channels are finally permuted and stored with saturation to the destination depth:
+\f[\texttt{dst} (I)_k  \leftarrow \texttt{saturate\_cast<dtype>} ( \texttt{t} (I)_{ \texttt{order} _k})\f]
+For example, order = {2, 1, 0} converts BGR to RGB, {2, 1, 0, -1} converts BGR to RGBA with
+zero alpha channel.
+@param src input array with 1 to 4 channels.
+@param dst output array of the same size as src, ddepth depth and order.size() channels (or the
+same number of channels as src if order is empty).
+@param ddepth depth of the output array; when it is negative, the depth of lut is used if it is
+not empty, the depth of src otherwise.
+@param alpha per-channel scale factors.
+@param beta per-channel deltas added to the scaled values.
+@param lut optional look-up table of 256 elements with either a single channel or the same number of
+channels as src.
+@param order indices of the source channels copied to the destination channels; -1 fills the
+destination channel with zeros.
+@sa  Mat::convertTo, LUT, mixChannels
+*/
+CV_EXPORTS_W void convertScaleLUT(InputArray src, OutputArray dst, int ddepth,
+                                  const Scalar& alpha, const Scalar& beta = Scalar(),
+                                  InputArray lut = noArray(),
+                                  const std::vector<int>& order = std::vector<int>());
+
 /** @brief Calculates the sum of array elements.
 
 The functions sum calculate and return the sum of array elements,
@@ -1810,6 +1842,32 @@ stores the indices of sorted elements in the output array. For example:
 */
 CV_EXPORTS_W void sortIdx(InputArray src, OutputArray dst, int flags);
 
+/** @brief Finds the k smallest or the k largest elements of each row or each column of a matrix.
+
+The function partialSort selects the k smallest elements of each matrix row or each matrix column
+(the k largest ones when SORT_DESCENDING is passed) without sorting the whole row or column and
+stores them in the ascending (descending) order together with their positions. Equal elements
+are ordered by their positions. When k is small compared to the row or column length, the
+function is much faster than sort or sortIdx. For example, to find 5 nearest neighbours of each
+query in a distance matrix:
+@code
+    Mat dist; // nqueries x ntrain, CV_32F
+    Mat nnDist, nnIdx;
+    partialSort(dist, nnDist, nnIdx, 5, SORT_EVERY_ROW + SORT_ASCENDING);
+    // nnIdx.at<int>(i, j) is the index of the (j+1)-th nearest neighbour of the i-th query
+@endcode
+@param src input single-channel array.
+@param dst output array of the selected elements of the same type as src. It has k columns when
+the rows are processed and k rows when the columns are processed. Pass noArray() if only the
+indices are needed.
+@param idx output integer array of the same size as dst with the positions of the selected
+elements within their rows or columns. Pass noArray() if only the values are needed.
+@param k number of the elements to select, 0 \< k \<= row (column) length.
+@param flags operation flags, a combination of cv::SortFlags
+@sa sort, sortIdx
+*/
+CV_EXPORTS_W void partialSort(InputArray src, OutputArray dst, OutputArray idx, int k, int flags);
+
 /** @brief Finds the real roots of a cubic equation.
 
 The function solveCubic finds the real roots of a cubic equation:
@@ -1905,6 +1963,29 @@ CV_EXPORTS_W void SVDecomp( InputArray src, OutputArray w, OutputArray u, Output
 CV_EXPORTS_W void SVBackSubst( InputArray w, InputArray u, InputArray vt,
                                InputArray rhs, OutputArray dst );
 
+/** @brief Computes the k largest singular values and the corresponding singular vectors of a matrix.
+
+The function computes the truncated singular value decomposition \f$\texttt{src} \approx u \cdot
+\texttt{diag}(w) \cdot vt\f$ using the randomized range finder (Halko, Martinsson, Tropp): the
+matrix is multiplied by the \f$n \times (k+oversampling)\f$ Gaussian matrix, the orthonormal
+basis Q of the product is refined by the power iterations and then the small matrix \f$Q^T \cdot
+\texttt{src}\f$ is decomposed by SVD::compute. The cost is dominated by a few matrix products,
+so the function is much faster than the full SVD when k is small compared to the matrix size. The
+random generator is seeded with a constant, so the results are reproducible. When
+k+oversampling is not less than min(src.rows, src.cols), the full SVD is computed and truncated.
+@param src decomposed matrix of CV_32FC1 or CV_64FC1 type.
+@param k number of the singular values to compute, 0 < k <= min(src.rows, src.cols).
+@param w computed k x 1 vector of the singular values in the descending order.
+@param u computed src.rows x k matrix of the left singular vectors.
+@param vt computed k x src.cols matrix of the right singular vectors (stored as the rows).
+@param oversampling number of the additional random projections; the larger it is, the more accurate
+the result is when the singular values decay slowly.
+@param powerIters number of the power iterations.
+@sa SVDecomp, PCA
+*/
+CV_EXPORTS_W void SVDecompTruncated( InputArray src, int k, OutputArray w, OutputArray u, OutputArray vt,
+                                     int oversampling = 10, int powerIters = 2 );
+
 /** @brief Calculates the Mahalanobis distance between two vectors.
 
 The function Mahalanobis calculates and returns the weighted distance between two vectors:
@@ -2065,6 +2146,49 @@ the convolution sample in dft description.
 */
 CV_EXPORTS_W void idft(InputArray src, OutputArray dst, int flags = 0, int nonzeroRows = 0);
 
+/** @brief The precomputed discrete Fourier transform of the arrays of the fixed size and type.
+
+The plan keeps the factorization of the transform sizes, the permutation tables and the twiddle
+factors, so the repeated transforms of the same size do not recompute them. The plans are
+immutable, one plan can be applied from several threads at once. dft and idft take the plans from
+the process-wide cache of the recently used plans, DFTPlan::create uses the same cache.
+@code
+    Ptr<DFTPlan> plan = DFTPlan::create(Size(64, 64), CV_32FC1, DFT_COMPLEX_OUTPUT);
+    std::vector<Mat> spectrums;
+    plan->applyBatch(patches, spectrums); // the patches are transformed in parallel
+@endcode
+@sa dft, idft
+ */
+class CV_EXPORTS DFTPlan
+{
+public:
+    virtual ~DFTPlan();
+
+    /** @brief Creates the plan or takes it from the cache.
+    @param size size of the source arrays.
+    @param type type of the source arrays, CV_32FC1, CV_32FC2, CV_64FC1 or CV_64FC2.
+    @param flags transformation flags, see dft and cv::DftFlags.
+     */
+    static Ptr<DFTPlan> create(Size size, int type, int flags = 0);
+
+    /** @brief Transforms the array, the same as dft(src, dst, flags, nonzeroRows).
+    @param src source array of the plan size and type.
+    @param dst output array whose size and type depend on the flags.
+    @param nonzeroRows see dft.
+     */
+    virtual void apply(InputArray src, OutputArray dst, int nonzeroRows = 0) const = 0;
+
+    /** @brief Transforms each of the arrays, the arrays are processed in parallel.
+    @param src vector of the source arrays of the plan size and type.
+    @param dst output vector of the transformed arrays.
+     */
+    virtual void applyBatch(InputArrayOfArrays src, OutputArrayOfArrays dst) const = 0;
+
+    virtual Size size() const = 0;
+    virtual int type() const = 0;
+    virtual int flags() const = 0;
+};
+
 /** @brief Performs a forward or inverse discrete Cosine transform of 1D or 2D array.
 
 The function dct performs a forward or inverse discrete Cosine transform (DCT) of a 1D or 2D
@@ -2278,7 +2402,11 @@ class CV_EXPORTS PCA
 public:
     enum Flags { DATA_AS_ROW = 0, //!< indicates that the input samples are stored as matrix rows
                  DATA_AS_COL = 1, //!< indicates that the input samples are stored as matrix columns
-                 USE_AVG     = 2  //!
+                 USE_AVG     = 2, //!
+                 /** computes only maxComponents leading components with SVDecompTruncated instead
+                 of the eigen decomposition of the full covariance matrix; used only when maxComponents
+                 is positive and less than the number of the components */
+                 RANDOMIZED  = 4
                };
 
     /** @brief default constructor
@@ -2415,6 +2543,73 @@ public:
   An example using %PCA for dimensionality reduction while maintaining an amount of variance
  */
 
+/** @brief Accumulates the statistics of the samples for %PCA batch by batch.
+
+The class keeps the number of the samples, their mean and the scatter matrix (the sum of the outer
+products of the centered samples), so the memory does not depend on the number of the samples and
+the whole dataset never has to be stored. The batches are added with PCAAccumulator::add; the
+accumulators filled independently (for example, by different threads from the different parts of
+the dataset) are combined with PCAAccumulator::merge, which gives the same result as adding all the
+batches to one accumulator. The statistics are updated using the pairwise formulas of Chan et al.,
+which are numerically stable even for the large offsets of the data. Finally,
+PCAAccumulator::compute fills the regular PCA object that can be used for PCA::project and
+PCA::backProject:
+@code
+    PCAAccumulator acc;
+    for( ... )
+        acc.add(batch);           // CV_32F or CV_64F samples stored as rows
+    PCA pca;
+    acc.compute(pca, PCA::DATA_AS_ROW, 32);
+@endcode
+@sa PCA
+*/
+class CV_EXPORTS PCAAccumulator
+{
+public:
+    /** @brief The constructor creates an empty accumulator */
+    PCAAccumulator();
+
+    /** @brief Adds the samples.
+    @param data input samples stored as the matrix rows or as the matrix columns, CV_32FC1 or
+    CV_64FC1 matrix of the same dimensionality as the previously added samples.
+    @param flags data layout, PCA::DATA_AS_ROW or PCA::DATA_AS_COL.
+    */
+    void add(InputArray data, int flags = PCA::DATA_AS_ROW);
+
+    /** @brief Adds the statistics accumulated by another accumulator.
+    @param other accumulator of the samples of the same dimensionality; may be empty.
+    */
+    void merge(const PCAAccumulator& other);
+
+    /** @brief Computes %PCA of the accumulated samples.
+
+    The eigenvalues and the eigenvectors of the covariance matrix (scaled by 1/count, as in
+    PCA::operator()) are stored in pca together with the mean.
+    @param pca the output %PCA object.
+    @param flags layout of the data that will be projected, PCA::DATA_AS_ROW or
+    PCA::DATA_AS_COL; it defines the shape of PCA::mean.
+    @param maxComponents maximum number of components that %PCA should retain; by default, all the
+    components are retained.
+    */
+    void compute(PCA& pca, int flags = PCA::DATA_AS_ROW, int maxComponents = 0) const;
+
+    /** @overload
+    @param pca the output %PCA object.
+    @param flags layout of the data that will be projected.
+    @param retainedVariance Percentage of variance that %PCA should retain, at least 2 components
+    are retained.
+    */
+    void compute(PCA& pca, int flags, double retainedVariance) const;
+
+    /** @brief Clears the accumulated statistics */
+    void clear();
+
+    int64 count; //!< number of the accumulated samples
+    Mat mean; //!< mean of the accumulated samples, 1 x dims CV_64FC1 matrix
+    Mat scatter; //!< sum of the outer products of the centered samples, dims x dims CV_64FC1 matrix
+    int depth; //!< depth of the computed %PCA: CV_64F if any of the added samples were CV_64F, CV_32F otherwise
+};
+
 /**
    @brief Linear Discriminant Analysis
    @todo document this class
@@ -2877,6 +3072,32 @@ CV_EXPORTS_W double kmeans( InputArray data, int K, InputOutputArray bestLabels,
                             TermCriteria criteria, int attempts,
                             int flags, OutputArray centers = noArray() );
 
+/** @brief Finds centers of clusters using the mini-batch k-means algorithm.
+
+Instead of assigning all the samples to the clusters in every iteration, the function draws a random
+subset (batch) of batchSize samples and moves every center towards the samples of the batch that are
+closest to it, with the learning rate decreasing as the center collects more samples [Sculley2010].
+The cost of an iteration does not depend on the number of samples, which makes the function suitable
+for large data sets, e.g. for training visual vocabularies from millions of descriptors. The result is
+usually slightly less compact than the one of cv::kmeans.
+
+The initial centers are chosen from a random subset of max(3*batchSize, K) samples. After the last
+iteration all the samples are assigned to the nearest centers.
+@param data Data for clustering, see cv::kmeans.
+@param K Number of clusters to split the set by.
+@param bestLabels Input/output integer array that stores the cluster indices for every sample.
+@param criteria The algorithm termination criteria: the maximum number of batches (100 by default,
+not limited by 100 as in cv::kmeans) and/or the maximum change of a center position in one batch.
+@param batchSize Number of samples in a batch.
+@param attempts Number of times the algorithm is executed using different initial labellings.
+@param flags Flag that can take values of cv::KmeansFlags except KMEANS_MINI_BATCH.
+@param centers Output matrix of the cluster centers, one row per each cluster center.
+@return The compactness measure of the best attempt, see cv::kmeans.
+ */
+CV_EXPORTS_W double kmeansMiniBatch( InputArray data, int K, InputOutputArray bestLabels,
+                                     TermCriteria criteria, int batchSize, int attempts,
+                                     int flags, OutputArray centers = noArray() );
+
 //! @} core_cluster
 
 //! @addtogroup core_basic
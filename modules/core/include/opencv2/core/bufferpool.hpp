@@ -13,6 +13,19 @@ namespace cv
 //! @addtogroup core
 //! @{
 
+//! Usage statistics of a buffer pool, see getPoolMatAllocatorStats
+struct BufferPoolStats
+{
+    BufferPoolStats() : allocations(0), hits(0), reservedSize(0) { }
+
+    //! ratio of the allocations served with the reserved buffers
+    double hitRate() const { return allocations > 0 ? (double)hits / allocations : 0.; }
+
+    size_t allocations;  //!< number of allocation requests
+    size_t hits;         //!< number of requests served with a reserved buffer
+    size_t reservedSize; //!< number of bytes kept in the pool
+};
+
 class BufferPoolController
 {
 protected:
@@ -0,0 +1,83 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef __OPENCV_CORE_CV_CPU_DISPATCH_H__
+#define __OPENCV_CORE_CV_CPU_DISPATCH_H__
+
+#include "opencv2/core/cvdef.h"
+
+// The kernels which are compiled several times with the different instruction set flags
+// are put into the separate namespaces, so the copies don't clash at link time:
+//
+//   cpu_baseline  - the regular translation units, compiled with the baseline flags
+//   opt_<MODE>    - the translation units which define CV_CPU_DISPATCH_MODE=<MODE>
+//
+// The universal intrinsics are put into the namespace named after the instruction set
+// they are compiled for. Otherwise the linker could pick the AVX2 copy of some inline
+// function for the baseline code, which would crash on the older CPUs.
+
+#ifdef CV_CPU_DISPATCH_MODE
+#  define CV_CPU_OPTIMIZATION_NAMESPACE __CV_CPU_CAT(opt_, CV_CPU_DISPATCH_MODE)
+#else
+#  define CV_CPU_OPTIMIZATION_NAMESPACE cpu_baseline
+#endif
+#define CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN namespace CV_CPU_OPTIMIZATION_NAMESPACE {
+#define CV_CPU_OPTIMIZATION_NAMESPACE_END }
+
+#if CV_AVX_512F && CV_AVX_512BW
+#  define CV_CPU_OPTIMIZATION_HAL_NAMESPACE hal_AVX512
+#elif CV_AVX2
+#  define CV_CPU_OPTIMIZATION_HAL_NAMESPACE hal_AVX2
+#elif CV_SSE4_1
+#  define CV_CPU_OPTIMIZATION_HAL_NAMESPACE hal_SSE4_1
+#else
+#  define CV_CPU_OPTIMIZATION_HAL_NAMESPACE hal_baseline
+#endif
+#ifdef CV_DOXYGEN
+#  define CV_CPU_OPTIMIZATION_HAL_NAMESPACE_BEGIN
+#  define CV_CPU_OPTIMIZATION_HAL_NAMESPACE_END
+#else
+#  define CV_CPU_OPTIMIZATION_HAL_NAMESPACE_BEGIN namespace CV_CPU_OPTIMIZATION_HAL_NAMESPACE {
+#  define CV_CPU_OPTIMIZATION_HAL_NAMESPACE_END }
+#endif
+
+#define __CV_CPU_CAT__(x, y) x ## y
+#define __CV_CPU_CAT_(x, y) __CV_CPU_CAT__(x, y)
+#define __CV_CPU_CAT(x, y) __CV_CPU_CAT_(x, y)
+
+// CV_TRY_<MODE> is set by the build system when the dispatched kernels for <MODE> are compiled
+#if defined __OPENCV_BUILD && !defined CV_DOXYGEN
+#  include "cv_cpu_config.h"
+#endif
+#ifndef CV_TRY_AVX2
+#  define CV_TRY_AVX2 0
+#endif
+#ifndef CV_TRY_AVX512
+#  define CV_TRY_AVX512 0
+#endif
+
+#define CV_CPU_HAS_SUPPORT_AVX2 (cv::checkHardwareSupport(CV_CPU_AVX2))
+#define CV_CPU_HAS_SUPPORT_AVX512 (cv::checkHardwareSupport(CV_CPU_AVX_512F) && cv::checkHardwareSupport(CV_CPU_AVX_512BW))
+
+#if CV_TRY_AVX512
+#  define CV_CPU_CALL_AVX512_(fn, args) CV_CPU_HAS_SUPPORT_AVX512 ? opt_AVX512::fn args :
+#else
+#  define CV_CPU_CALL_AVX512_(fn, args)
+#endif
+#if CV_TRY_AVX2
+#  define CV_CPU_CALL_AVX2_(fn, args) CV_CPU_HAS_SUPPORT_AVX2 ? opt_AVX2::fn args :
+#else
+#  define CV_CPU_CALL_AVX2_(fn, args)
+#endif
+
+// Calls the best copy of the dispatched kernel fn supported by the CPU, the baseline one otherwise.
+// Must be used inside the cv namespace after the <name>.simd_declarations.hpp is included:
+//
+//   return CV_CPU_DISPATCH(div_simd, (src1, src2, dst, width, scale));
+//
+// checkHardwareSupport() reports nothing when the optimizations are turned off by setUseOptimized(false),
+// so the baseline kernels are used in that case.
+#define CV_CPU_DISPATCH(fn, args) (CV_CPU_CALL_AVX512_(fn, args) CV_CPU_CALL_AVX2_(fn, args) cpu_baseline::fn args)
+
+#endif // __OPENCV_CORE_CV_CPU_DISPATCH_H__
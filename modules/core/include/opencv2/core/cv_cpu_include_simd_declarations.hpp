@@ -0,0 +1,33 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+// No include guard, the header is included once per dispatched instruction set:
+//
+//   #define CV_CPU_SIMD_FILENAME "arithm.simd.hpp"
+//   #define CV_CPU_DISPATCH_MODE AVX2
+//   #include "opencv2/core/cv_cpu_include_simd_declarations.hpp"
+//
+// declares the cv::opt_AVX2 copies of the kernels from arithm.simd.hpp.
+
+#ifndef CV_CPU_SIMD_FILENAME
+#error "CV_CPU_SIMD_FILENAME is not defined"
+#endif
+#ifndef CV_CPU_DISPATCH_MODE
+#error "CV_CPU_DISPATCH_MODE is not defined"
+#endif
+
+#undef CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
+#undef CV_CPU_OPTIMIZATION_NAMESPACE_END
+#define CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN namespace __CV_CPU_CAT(opt_, CV_CPU_DISPATCH_MODE) {
+#define CV_CPU_OPTIMIZATION_NAMESPACE_END }
+#define CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+#include CV_CPU_SIMD_FILENAME
+
+#undef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+#undef CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
+#undef CV_CPU_OPTIMIZATION_NAMESPACE_END
+#define CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN namespace CV_CPU_OPTIMIZATION_NAMESPACE {
+#define CV_CPU_OPTIMIZATION_NAMESPACE_END }
+#undef CV_CPU_DISPATCH_MODE
@@ -211,6 +211,22 @@ enum CpuFeatures {
 #      define CV_FMA3 1
 #    endif
 #  endif
+#  if defined __AVX512F__
+#    include <immintrin.h>
+#    define CV_AVX_512F 1
+#  endif
+#  if defined __AVX512BW__
+#    define CV_AVX_512BW 1
+#  endif
+#  if defined __AVX512CD__
+#    define CV_AVX_512CD 1
+#  endif
+#  if defined __AVX512DQ__
+#    define CV_AVX_512DQ 1
+#  endif
+#  if defined __AVX512VL__
+#    define CV_AVX_512VL 1
+#  endif
 #endif
 
 #if (defined WIN32 || defined _WIN32) && defined(_M_ARM)
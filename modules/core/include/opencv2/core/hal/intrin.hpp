@@ -49,6 +49,7 @@
 #include <float.h>
 #include <stdlib.h>
 #include "opencv2/core/cvdef.h"
+#include "opencv2/core/cv_cpu_dispatch.h"
 
 #define OPENCV_HAL_ADD(a, b) ((a) + (b))
 #define OPENCV_HAL_AND(a, b) ((a) & (b))
@@ -302,6 +303,21 @@ template <typename T> struct V_SIMD128Traits
 
 #endif
 
+// the wider registers extend the 128-bit implementation, they don't replace it
+#if CV_AVX2
+#include "opencv2/core/hal/intrin_avx.hpp"
+#endif
+
+#if CV_AVX_512F && CV_AVX_512BW
+#include "opencv2/core/hal/intrin_avx512.hpp"
+#endif
+
+#ifndef CV_DOXYGEN
+namespace cv {
+using namespace CV_CPU_OPTIMIZATION_HAL_NAMESPACE;
+}
+#endif
+
 //! @addtogroup core_hal_intrin
 //! @{
 
@@ -315,6 +331,133 @@ template <typename T> struct V_SIMD128Traits
 #define CV_SIMD128_64F 0
 #endif
 
+#ifndef CV_SIMD256
+//! Set to 1 if the 256-bit vectors (v_uint8x32, ..., v_float64x4) are available (AVX2 is enabled)
+#define CV_SIMD256 0
+#endif
+
+#ifndef CV_SIMD256_64F
+#define CV_SIMD256_64F 0
+#endif
+
+#ifndef CV_SIMD512
+//! Set to 1 if the 512-bit vectors (v_uint8x64, ..., v_float64x8) are available (AVX-512F and AVX-512BW are enabled)
+#define CV_SIMD512 0
+#endif
+
+#ifndef CV_SIMD512_64F
+#define CV_SIMD512_64F 0
+#endif
+
+/** @brief The widest vectors supported by the current compiler flags
+
+The kernels written with v_uint8, ..., v_float64 types and the vx_ functions (vx_load, vx_setall_f32,
+...) use 512-, 256- or 128-bit registers, whatever is the widest one. The number of lanes is not
+known in advance, so such code should use the nlanes member, e.g. v_float32::nlanes. Compile such
+kernels several times with the different instruction set flags to get the runtime dispatching,
+see arithm.simd.hpp in the core module.
+
+CV_SIMD_WIDTH is the vector size in bytes, CV_SIMD is set to 0 if there are no vector extensions.
+*/
+#if CV_SIMD512
+#define CV_SIMD 1
+#define CV_SIMD_64F CV_SIMD512_64F
+#define CV_SIMD_WIDTH 64
+#define CV__SIMD_FORWARD(name) v512_##name
+#elif CV_SIMD256
+#define CV_SIMD 1
+#define CV_SIMD_64F CV_SIMD256_64F
+#define CV_SIMD_WIDTH 32
+#define CV__SIMD_FORWARD(name) v256_##name
+#elif CV_SIMD128
+#define CV_SIMD 1
+#define CV_SIMD_64F CV_SIMD128_64F
+#define CV_SIMD_WIDTH 16
+#define CV__SIMD_FORWARD(name) v_##name
+#else
+#define CV_SIMD 0
+#define CV_SIMD_64F 0
+#define CV_SIMD_WIDTH 16
+#endif
+
 //! @}
 
+#if CV_SIMD
+
+namespace cv {
+
+//! @cond IGNORED
+
+CV_CPU_OPTIMIZATION_HAL_NAMESPACE_BEGIN
+
+#if CV_SIMD512
+typedef v_uint8x64   v_uint8;
+typedef v_int8x64    v_int8;
+typedef v_uint16x32  v_uint16;
+typedef v_int16x32   v_int16;
+typedef v_uint32x16  v_uint32;
+typedef v_int32x16   v_int32;
+typedef v_uint64x8   v_uint64;
+typedef v_int64x8    v_int64;
+typedef v_float32x16 v_float32;
+typedef v_float64x8  v_float64;
+#elif CV_SIMD256
+typedef v_uint8x32   v_uint8;
+typedef v_int8x32    v_int8;
+typedef v_uint16x16  v_uint16;
+typedef v_int16x16   v_int16;
+typedef v_uint32x8   v_uint32;
+typedef v_int32x8    v_int32;
+typedef v_uint64x4   v_uint64;
+typedef v_int64x4    v_int64;
+typedef v_float32x8  v_float32;
+typedef v_float64x4  v_float64;
+#else
+typedef v_uint8x16   v_uint8;
+typedef v_int8x16    v_int8;
+typedef v_uint16x8   v_uint16;
+typedef v_int16x8    v_int16;
+typedef v_uint32x4   v_uint32;
+typedef v_int32x4    v_int32;
+typedef v_uint64x2   v_uint64;
+typedef v_int64x2    v_int64;
+typedef v_float32x4  v_float32;
+#if CV_SIMD128_64F
+typedef v_float64x2  v_float64;
+#endif
+#endif
+
+#define OPENCV_HAL_IMPL_VX_FORWARD(_Tpvec, _Tp, suffix) \
+inline _Tpvec vx_setall_##suffix(_Tp v) { return CV__SIMD_FORWARD(setall_##suffix)(v); } \
+inline _Tpvec vx_setzero_##suffix() { return CV__SIMD_FORWARD(setzero_##suffix)(); } \
+inline _Tpvec vx_load(const _Tp* ptr) { return CV__SIMD_FORWARD(load)(ptr); } \
+inline _Tpvec vx_load_aligned(const _Tp* ptr) { return CV__SIMD_FORWARD(load_aligned)(ptr); } \
+inline _Tpvec vx_load_halves(const _Tp* ptr0, const _Tp* ptr1) { return CV__SIMD_FORWARD(load_halves)(ptr0, ptr1); }
+
+OPENCV_HAL_IMPL_VX_FORWARD(v_uint8,   uchar,    u8)
+OPENCV_HAL_IMPL_VX_FORWARD(v_int8,    schar,    s8)
+OPENCV_HAL_IMPL_VX_FORWARD(v_uint16,  ushort,   u16)
+OPENCV_HAL_IMPL_VX_FORWARD(v_int16,   short,    s16)
+OPENCV_HAL_IMPL_VX_FORWARD(v_uint32,  unsigned, u32)
+OPENCV_HAL_IMPL_VX_FORWARD(v_int32,   int,      s32)
+OPENCV_HAL_IMPL_VX_FORWARD(v_float32, float,    f32)
+#if CV_SIMD_64F
+OPENCV_HAL_IMPL_VX_FORWARD(v_float64, double,   f64)
+#endif
+
+inline v_uint16 vx_load_expand(const uchar* ptr) { return CV__SIMD_FORWARD(load_expand)(ptr); }
+inline v_int16 vx_load_expand(const schar* ptr) { return CV__SIMD_FORWARD(load_expand)(ptr); }
+inline v_uint32 vx_load_expand(const ushort* ptr) { return CV__SIMD_FORWARD(load_expand)(ptr); }
+inline v_int32 vx_load_expand(const short* ptr) { return CV__SIMD_FORWARD(load_expand)(ptr); }
+inline v_uint32 vx_load_expand_q(const uchar* ptr) { return CV__SIMD_FORWARD(load_expand_q)(ptr); }
+inline v_int32 vx_load_expand_q(const schar* ptr) { return CV__SIMD_FORWARD(load_expand_q)(ptr); }
+
+CV_CPU_OPTIMIZATION_HAL_NAMESPACE_END
+
+//! @endcond
+
+}
+
+#endif // CV_SIMD
+
 #endif
@@ -0,0 +1,1018 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef __OPENCV_HAL_INTRIN_AVX_HPP__
+#define __OPENCV_HAL_INTRIN_AVX_HPP__
+
+#define CV_SIMD256 1
+#define CV_SIMD256_64F 1
+
+namespace cv
+{
+
+//! @cond IGNORED
+
+CV_CPU_OPTIMIZATION_HAL_NAMESPACE_BEGIN
+
+///////// Utils ////////////
+
+// [a0 a1 | a2 a3] => [a0 a2 | a1 a3], fixes the lane order after the in-lane packs and unpacks
+inline __m256i _v256_shuffle_odd_64(const __m256i& v)
+{ return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(3, 1, 2, 0)); }
+
+inline __m256i _v256_combine(const __m128i& lo, const __m128i& hi)
+{ return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1); }
+
+inline __m256 _v256_combine(const __m128& lo, const __m128& hi)
+{ return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1); }
+
+inline __m256d _v256_combine(const __m128d& lo, const __m128d& hi)
+{ return _mm256_insertf128_pd(_mm256_castpd128_pd256(lo), hi, 1); }
+
+inline __m128i _v256_extract_high(const __m256i& v)
+{ return _mm256_extracti128_si256(v, 1); }
+
+inline __m128 _v256_extract_high(const __m256& v)
+{ return _mm256_extractf128_ps(v, 1); }
+
+inline __m128d _v256_extract_high(const __m256d& v)
+{ return _mm256_extractf128_pd(v, 1); }
+
+inline __m128i _v256_extract_low(const __m256i& v)
+{ return _mm256_castsi256_si128(v); }
+
+inline __m128 _v256_extract_low(const __m256& v)
+{ return _mm256_castps256_ps128(v); }
+
+inline __m128d _v256_extract_low(const __m256d& v)
+{ return _mm256_castpd256_pd128(v); }
+
+///////// Types ////////////
+
+struct v_uint8x32
+{
+    typedef uchar lane_type;
+    enum { nlanes = 32 };
+
+    v_uint8x32() {}
+    explicit v_uint8x32(__m256i v) : val(v) {}
+    uchar get0() const
+    {
+        return (uchar)_mm_cvtsi128_si32(_mm256_castsi256_si128(val));
+    }
+
+    __m256i val;
+};
+
+struct v_int8x32
+{
+    typedef schar lane_type;
+    enum { nlanes = 32 };
+
+    v_int8x32() {}
+    explicit v_int8x32(__m256i v) : val(v) {}
+    schar get0() const
+    {
+        return (schar)_mm_cvtsi128_si32(_mm256_castsi256_si128(val));
+    }
+
+    __m256i val;
+};
+
+struct v_uint16x16
+{
+    typedef ushort lane_type;
+    enum { nlanes = 16 };
+
+    v_uint16x16() {}
+    explicit v_uint16x16(__m256i v) : val(v) {}
+    ushort get0() const
+    {
+        return (ushort)_mm_cvtsi128_si32(_mm256_castsi256_si128(val));
+    }
+
+    __m256i val;
+};
+
+struct v_int16x16
+{
+    typedef short lane_type;
+    enum { nlanes = 16 };
+
+    v_int16x16() {}
+    explicit v_int16x16(__m256i v) : val(v) {}
+    short get0() const
+    {
+        return (short)_mm_cvtsi128_si32(_mm256_castsi256_si128(val));
+    }
+
+    __m256i val;
+};
+
+struct v_uint32x8
+{
+    typedef unsigned lane_type;
+    enum { nlanes = 8 };
+
+    v_uint32x8() {}
+    explicit v_uint32x8(__m256i v) : val(v) {}
+    v_uint32x8(unsigned v0, unsigned v1, unsigned v2, unsigned v3,
+               unsigned v4, unsigned v5, unsigned v6, unsigned v7)
+    {
+        val = _mm256_setr_epi32((int)v0, (int)v1, (int)v2, (int)v3,
+                                (int)v4, (int)v5, (int)v6, (int)v7);
+    }
+    unsigned get0() const
+    {
+        return (unsigned)_mm_cvtsi128_si32(_mm256_castsi256_si128(val));
+    }
+
+    __m256i val;
+};
+
+struct v_int32x8
+{
+    typedef int lane_type;
+    enum { nlanes = 8 };
+
+    v_int32x8() {}
+    explicit v_int32x8(__m256i v) : val(v) {}
+    v_int32x8(int v0, int v1, int v2, int v3, int v4, int v5, int v6, int v7)
+    {
+        val = _mm256_setr_epi32(v0, v1, v2, v3, v4, v5, v6, v7);
+    }
+    int get0() const
+    {
+        return _mm_cvtsi128_si32(_mm256_castsi256_si128(val));
+    }
+
+    __m256i val;
+};
+
+struct v_float32x8
+{
+    typedef float lane_type;
+    enum { nlanes = 8 };
+
+    v_float32x8() {}
+    explicit v_float32x8(__m256 v) : val(v) {}
+    v_float32x8(float v0, float v1, float v2, float v3,
+                float v4, float v5, float v6, float v7)
+    {
+        val = _mm256_setr_ps(v0, v1, v2, v3, v4, v5, v6, v7);
+    }
+    float get0() const
+    {
+        return _mm_cvtss_f32(_mm256_castps256_ps128(val));
+    }
+
+    __m256 val;
+};
+
+struct v_uint64x4
+{
+    typedef uint64 lane_type;
+    enum { nlanes = 4 };
+
+    v_uint64x4() {}
+    explicit v_uint64x4(__m256i v) : val(v) {}
+    v_uint64x4(uint64 v0, uint64 v1, uint64 v2, uint64 v3)
+    {
+        val = _mm256_setr_epi64x((int64)v0, (int64)v1, (int64)v2, (int64)v3);
+    }
+    uint64 get0() const
+    {
+        __m128i v = _mm256_castsi256_si128(val);
+        int a = _mm_cvtsi128_si32(v);
+        int b = _mm_cvtsi128_si32(_mm_srli_epi64(v, 32));
+        return (unsigned)a | ((uint64)(unsigned)b << 32);
+    }
+
+    __m256i val;
+};
+
+struct v_int64x4
+{
+    typedef int64 lane_type;
+    enum { nlanes = 4 };
+
+    v_int64x4() {}
+    explicit v_int64x4(__m256i v) : val(v) {}
+    v_int64x4(int64 v0, int64 v1, int64 v2, int64 v3)
+    {
+        val = _mm256_setr_epi64x(v0, v1, v2, v3);
+    }
+    int64 get0() const
+    {
+        __m128i v = _mm256_castsi256_si128(val);
+        int a = _mm_cvtsi128_si32(v);
+        int b = _mm_cvtsi128_si32(_mm_srli_epi64(v, 32));
+        return (int64)((unsigned)a | ((uint64)(unsigned)b << 32));
+    }
+
+    __m256i val;
+};
+
+struct v_float64x4
+{
+    typedef double lane_type;
+    enum { nlanes = 4 };
+
+    v_float64x4() {}
+    explicit v_float64x4(__m256d v) : val(v) {}
+    v_float64x4(double v0, double v1, double v2, double v3)
+    {
+        val = _mm256_setr_pd(v0, v1, v2, v3);
+    }
+    double get0() const
+    {
+        return _mm_cvtsd_f64(_mm256_castpd256_pd128(val));
+    }
+
+    __m256d val;
+};
+
+//////////////// Load and store operations ///////////////
+
+#define OPENCV_HAL_IMPL_AVX_LOADSTORE(_Tpvec, _Tp) \
+inline _Tpvec v256_load(const _Tp* ptr) \
+{ return _Tpvec(_mm256_loadu_si256((const __m256i*)ptr)); } \
+inline _Tpvec v256_load_aligned(const _Tp* ptr) \
+{ return _Tpvec(_mm256_load_si256((const __m256i*)ptr)); } \
+inline _Tpvec v256_load_halves(const _Tp* ptr0, const _Tp* ptr1) \
+{ \
+    return _Tpvec(_v256_combine(_mm_loadu_si128((const __m128i*)ptr0), \
+                                _mm_loadu_si128((const __m128i*)ptr1))); \
+} \
+inline void v_store(_Tp* ptr, const _Tpvec& a) \
+{ _mm256_storeu_si256((__m256i*)ptr, a.val); } \
+inline void v_store_aligned(_Tp* ptr, const _Tpvec& a) \
+{ _mm256_store_si256((__m256i*)ptr, a.val); } \
+inline void v_store_low(_Tp* ptr, const _Tpvec& a) \
+{ _mm_storeu_si128((__m128i*)ptr, _v256_extract_low(a.val)); } \
+inline void v_store_high(_Tp* ptr, const _Tpvec& a) \
+{ _mm_storeu_si128((__m128i*)ptr, _v256_extract_high(a.val)); }
+
+OPENCV_HAL_IMPL_AVX_LOADSTORE(v_uint8x32,  uchar)
+OPENCV_HAL_IMPL_AVX_LOADSTORE(v_int8x32,   schar)
+OPENCV_HAL_IMPL_AVX_LOADSTORE(v_uint16x16, ushort)
+OPENCV_HAL_IMPL_AVX_LOADSTORE(v_int16x16,  short)
+OPENCV_HAL_IMPL_AVX_LOADSTORE(v_uint32x8,  unsigned)
+OPENCV_HAL_IMPL_AVX_LOADSTORE(v_int32x8,   int)
+OPENCV_HAL_IMPL_AVX_LOADSTORE(v_uint64x4,  uint64)
+OPENCV_HAL_IMPL_AVX_LOADSTORE(v_int64x4,   int64)
+
+#define OPENCV_HAL_IMPL_AVX_LOADSTORE_FLT(_Tpvec, _Tp, suffix, halfreg) \
+inline _Tpvec v256_load(const _Tp* ptr) \
+{ return _Tpvec(_mm256_loadu_##suffix(ptr)); } \
+inline _Tpvec v256_load_aligned(const _Tp* ptr) \
+{ return _Tpvec(_mm256_load_##suffix(ptr)); } \
+inline _Tpvec v256_load_halves(const _Tp* ptr0, const _Tp* ptr1) \
+{ return _Tpvec(_v256_combine(_mm_loadu_##suffix(ptr0), _mm_loadu_##suffix(ptr1))); } \
+inline void v_store(_Tp* ptr, const _Tpvec& a) \
+{ _mm256_storeu_##suffix(ptr, a.val); } \
+inline void v_store_aligned(_Tp* ptr, const _Tpvec& a) \
+{ _mm256_store_##suffix(ptr, a.val); } \
+inline void v_store_low(_Tp* ptr, const _Tpvec& a) \
+{ _mm_storeu_##suffix(ptr, _v256_extract_low(a.val)); } \
+inline void v_store_high(_Tp* ptr, const _Tpvec& a) \
+{ _mm_storeu_##suffix(ptr, _v256_extract_high(a.val)); }
+
+OPENCV_HAL_IMPL_AVX_LOADSTORE_FLT(v_float32x8, float,  ps, __m128)
+OPENCV_HAL_IMPL_AVX_LOADSTORE_FLT(v_float64x4, double, pd, __m128d)
+
+// conversions between the 256-bit and the 128-bit registers of the same lane type
+#define OPENCV_HAL_IMPL_AVX_HALVES(_Tpvec, _Tpvec128) \
+inline _Tpvec128 v_get_low(const _Tpvec& a) \
+{ return _Tpvec128(_v256_extract_low(a.val)); } \
+inline _Tpvec128 v_get_high(const _Tpvec& a) \
+{ return _Tpvec128(_v256_extract_high(a.val)); } \
+inline _Tpvec v256_combine(const _Tpvec128& lo, const _Tpvec128& hi) \
+{ return _Tpvec(_v256_combine(lo.val, hi.val)); }
+
+OPENCV_HAL_IMPL_AVX_HALVES(v_uint8x32,  v_uint8x16)
+OPENCV_HAL_IMPL_AVX_HALVES(v_int8x32,   v_int8x16)
+OPENCV_HAL_IMPL_AVX_HALVES(v_uint16x16, v_uint16x8)
+OPENCV_HAL_IMPL_AVX_HALVES(v_int16x16,  v_int16x8)
+OPENCV_HAL_IMPL_AVX_HALVES(v_uint32x8,  v_uint32x4)
+OPENCV_HAL_IMPL_AVX_HALVES(v_int32x8,   v_int32x4)
+OPENCV_HAL_IMPL_AVX_HALVES(v_uint64x4,  v_uint64x2)
+OPENCV_HAL_IMPL_AVX_HALVES(v_int64x4,   v_int64x2)
+OPENCV_HAL_IMPL_AVX_HALVES(v_float32x8, v_float32x4)
+OPENCV_HAL_IMPL_AVX_HALVES(v_float64x4, v_float64x2)
+
+//////////////// Initialization and reinterpretation ///////////////
+
+#define OPENCV_HAL_IMPL_AVX_INIT(_Tpvec, _Tp, suffix, zsuffix, ssuffix, _Tps) \
+inline _Tpvec v256_setzero_##suffix() { return _Tpvec(_mm256_setzero_##zsuffix()); } \
+inline _Tpvec v256_setall_##suffix(_Tp v) { return _Tpvec(_mm256_set1_##ssuffix((_Tps)v)); }
+
+OPENCV_HAL_IMPL_AVX_INIT(v_uint8x32,  uchar,    u8,  si256, epi8,   char)
+OPENCV_HAL_IMPL_AVX_INIT(v_int8x32,   schar,    s8,  si256, epi8,   char)
+OPENCV_HAL_IMPL_AVX_INIT(v_uint16x16, ushort,   u16, si256, epi16,  short)
+OPENCV_HAL_IMPL_AVX_INIT(v_int16x16,  short,    s16, si256, epi16,  short)
+OPENCV_HAL_IMPL_AVX_INIT(v_uint32x8,  unsigned, u32, si256, epi32,  int)
+OPENCV_HAL_IMPL_AVX_INIT(v_int32x8,   int,      s32, si256, epi32,  int)
+OPENCV_HAL_IMPL_AVX_INIT(v_uint64x4,  uint64,   u64, si256, epi64x, int64)
+OPENCV_HAL_IMPL_AVX_INIT(v_int64x4,   int64,    s64, si256, epi64x, int64)
+OPENCV_HAL_IMPL_AVX_INIT(v_float32x8, float,    f32, ps,    ps,     float)
+OPENCV_HAL_IMPL_AVX_INIT(v_float64x4, double,   f64, pd,    pd,     double)
+
+// the 128-bit reinterpret functions are templates accepting any type,
+// so the 256-bit ones are declared for every source type explicitly
+#define OPENCV_HAL_IMPL_AVX_CAST(_Tpvec, suffix, cast_si, cast_ps, cast_pd) \
+inline _Tpvec v_reinterpret_as_##suffix(const v_uint8x32& a)  { return _Tpvec(cast_si(a.val)); } \
+inline _Tpvec v_reinterpret_as_##suffix(const v_int8x32& a)   { return _Tpvec(cast_si(a.val)); } \
+inline _Tpvec v_reinterpret_as_##suffix(const v_uint16x16& a) { return _Tpvec(cast_si(a.val)); } \
+inline _Tpvec v_reinterpret_as_##suffix(const v_int16x16& a)  { return _Tpvec(cast_si(a.val)); } \
+inline _Tpvec v_reinterpret_as_##suffix(const v_uint32x8& a)  { return _Tpvec(cast_si(a.val)); } \
+inline _Tpvec v_reinterpret_as_##suffix(const v_int32x8& a)   { return _Tpvec(cast_si(a.val)); } \
+inline _Tpvec v_reinterpret_as_##suffix(const v_uint64x4& a)  { return _Tpvec(cast_si(a.val)); } \
+inline _Tpvec v_reinterpret_as_##suffix(const v_int64x4& a)   { return _Tpvec(cast_si(a.val)); } \
+inline _Tpvec v_reinterpret_as_##suffix(const v_float32x8& a) { return _Tpvec(cast_ps(a.val)); } \
+inline _Tpvec v_reinterpret_as_##suffix(const v_float64x4& a) { return _Tpvec(cast_pd(a.val)); }
+
+OPENCV_HAL_IMPL_AVX_CAST(v_uint8x32,  u8,  OPENCV_HAL_NOP, _mm256_castps_si256, _mm256_castpd_si256)
+OPENCV_HAL_IMPL_AVX_CAST(v_int8x32,   s8,  OPENCV_HAL_NOP, _mm256_castps_si256, _mm256_castpd_si256)
+OPENCV_HAL_IMPL_AVX_CAST(v_uint16x16, u16, OPENCV_HAL_NOP, _mm256_castps_si256, _mm256_castpd_si256)
+OPENCV_HAL_IMPL_AVX_CAST(v_int16x16,  s16, OPENCV_HAL_NOP, _mm256_castps_si256, _mm256_castpd_si256)
+OPENCV_HAL_IMPL_AVX_CAST(v_uint32x8,  u32, OPENCV_HAL_NOP, _mm256_castps_si256, _mm256_castpd_si256)
+OPENCV_HAL_IMPL_AVX_CAST(v_int32x8,   s32, OPENCV_HAL_NOP, _mm256_castps_si256, _mm256_castpd_si256)
+OPENCV_HAL_IMPL_AVX_CAST(v_uint64x4,  u64, OPENCV_HAL_NOP, _mm256_castps_si256, _mm256_castpd_si256)
+OPENCV_HAL_IMPL_AVX_CAST(v_int64x4,   s64, OPENCV_HAL_NOP, _mm256_castps_si256, _mm256_castpd_si256)
+OPENCV_HAL_IMPL_AVX_CAST(v_float32x8, f32, _mm256_castsi256_ps, OPENCV_HAL_NOP, _mm256_castpd_ps)
+OPENCV_HAL_IMPL_AVX_CAST(v_float64x4, f64, _mm256_castsi256_pd, _mm256_castps_pd, OPENCV_HAL_NOP)
+
+//////////////// Pack ///////////////
+
+// the AVX2 packs work within the 128-bit lanes, _v256_shuffle_odd_64 restores the element order
+
+inline v_uint8x32 v_pack(const v_uint16x16& a, const v_uint16x16& b)
+{
+    __m256i delta = _mm256_set1_epi16(255);
+    return v_uint8x32(_v256_shuffle_odd_64(_mm256_packus_epi16(_mm256_min_epu16(a.val, delta),
+                                                               _mm256_min_epu16(b.val, delta))));
+}
+
+inline void v_pack_store(uchar* ptr, const v_uint16x16& a)
+{
+    __m256i a1 = _mm256_min_epu16(a.val, _mm256_set1_epi16(255));
+    _mm_storeu_si128((__m128i*)ptr, _mm_packus_epi16(_v256_extract_low(a1), _v256_extract_high(a1)));
+}
+
+inline v_uint8x32 v_pack_u(const v_int16x16& a, const v_int16x16& b)
+{ return v_uint8x32(_v256_shuffle_odd_64(_mm256_packus_epi16(a.val, b.val))); }
+
+inline void v_pack_u_store(uchar* ptr, const v_int16x16& a)
+{ _mm_storeu_si128((__m128i*)ptr, _mm_packus_epi16(_v256_extract_low(a.val), _v256_extract_high(a.val))); }
+
+inline v_int8x32 v_pack(const v_int16x16& a, const v_int16x16& b)
+{ return v_int8x32(_v256_shuffle_odd_64(_mm256_packs_epi16(a.val, b.val))); }
+
+inline void v_pack_store(schar* ptr, const v_int16x16& a)
+{ _mm_storeu_si128((__m128i*)ptr, _mm_packs_epi16(_v256_extract_low(a.val), _v256_extract_high(a.val))); }
+
+inline v_uint16x16 v_pack(const v_uint32x8& a, const v_uint32x8& b)
+{
+    __m256i delta = _mm256_set1_epi32(65535);
+    return v_uint16x16(_v256_shuffle_odd_64(_mm256_packus_epi32(_mm256_min_epu32(a.val, delta),
+                                                                _mm256_min_epu32(b.val, delta))));
+}
+
+inline void v_pack_store(ushort* ptr, const v_uint32x8& a)
+{
+    __m256i a1 = _mm256_min_epu32(a.val, _mm256_set1_epi32(65535));
+    _mm_storeu_si128((__m128i*)ptr, _mm_packus_epi32(_v256_extract_low(a1), _v256_extract_high(a1)));
+}
+
+inline v_uint16x16 v_pack_u(const v_int32x8& a, const v_int32x8& b)
+{ return v_uint16x16(_v256_shuffle_odd_64(_mm256_packus_epi32(a.val, b.val))); }
+
+inline void v_pack_u_store(ushort* ptr, const v_int32x8& a)
+{ _mm_storeu_si128((__m128i*)ptr, _mm_packus_epi32(_v256_extract_low(a.val), _v256_extract_high(a.val))); }
+
+inline v_int16x16 v_pack(const v_int32x8& a, const v_int32x8& b)
+{ return v_int16x16(_v256_shuffle_odd_64(_mm256_packs_epi32(a.val, b.val))); }
+
+inline void v_pack_store(short* ptr, const v_int32x8& a)
+{ _mm_storeu_si128((__m128i*)ptr, _mm_packs_epi32(_v256_extract_low(a.val), _v256_extract_high(a.val))); }
+
+// the 64-bit lanes are truncated, like in the 128-bit version
+inline __m256i _v256_pack_epi64(const __m256i& a, const __m256i& b)
+{
+    __m256i idx = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    __m256i a1 = _mm256_permutevar8x32_epi32(a, idx); // a0 a1 a2 a3 x x x x
+    __m256i b1 = _mm256_permutevar8x32_epi32(b, idx); // b0 b1 b2 b3 x x x x
+    return _mm256_permute2x128_si256(a1, b1, 0x20);
+}
+
+inline __m128i _v256_pack_low_epi64(const __m256i& a)
+{
+    __m256i idx = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(a, idx));
+}
+
+inline v_uint32x8 v_pack(const v_uint64x4& a, const v_uint64x4& b)
+{ return v_uint32x8(_v256_pack_epi64(a.val, b.val)); }
+
+inline void v_pack_store(unsigned* ptr, const v_uint64x4& a)
+{ _mm_storeu_si128((__m128i*)ptr, _v256_pack_low_epi64(a.val)); }
+
+inline v_int32x8 v_pack(const v_int64x4& a, const v_int64x4& b)
+{ return v_int32x8(_v256_pack_epi64(a.val, b.val)); }
+
+inline void v_pack_store(int* ptr, const v_int64x4& a)
+{ _mm_storeu_si128((__m128i*)ptr, _v256_pack_low_epi64(a.val)); }
+
+inline __m256i _v256_srai_epi64(const __m256i& a, int imm)
+{
+    __m256i smask = _mm256_cmpgt_epi64(_mm256_setzero_si256(), a);
+    return _mm256_xor_si256(_mm256_srli_epi64(_mm256_xor_si256(a, smask), imm), smask);
+}
+
+// rounding shift and pack, we assume that n > 0
+template<int n> inline
+v_uint8x32 v_rshr_pack(const v_uint16x16& a, const v_uint16x16& b)
+{
+    __m256i delta = _mm256_set1_epi16((short)(1 << (n-1)));
+    return v_uint8x32(_v256_shuffle_odd_64(_mm256_packus_epi16(_mm256_srli_epi16(_mm256_adds_epu16(a.val, delta), n),
+                                                               _mm256_srli_epi16(_mm256_adds_epu16(b.val, delta), n))));
+}
+
+template<int n> inline
+void v_rshr_pack_store(uchar* ptr, const v_uint16x16& a)
+{
+    __m256i delta = _mm256_set1_epi16((short)(1 << (n-1)));
+    __m256i a1 = _mm256_srli_epi16(_mm256_adds_epu16(a.val, delta), n);
+    _mm_storeu_si128((__m128i*)ptr, _mm_packus_epi16(_v256_extract_low(a1), _v256_extract_high(a1)));
+}
+
+template<int n> inline
+v_uint8x32 v_rshr_pack_u(const v_int16x16& a, const v_int16x16& b)
+{
+    __m256i delta = _mm256_set1_epi16((short)(1 << (n-1)));
+    return v_uint8x32(_v256_shuffle_odd_64(_mm256_packus_epi16(_mm256_srai_epi16(_mm256_adds_epi16(a.val, delta), n),
+                                                               _mm256_srai_epi16(_mm256_adds_epi16(b.val, delta), n))));
+}
+
+template<int n> inline
+void v_rshr_pack_u_store(uchar* ptr, const v_int16x16& a)
+{
+    __m256i delta = _mm256_set1_epi16((short)(1 << (n-1)));
+    __m256i a1 = _mm256_srai_epi16(_mm256_adds_epi16(a.val, delta), n);
+    _mm_storeu_si128((__m128i*)ptr, _mm_packus_epi16(_v256_extract_low(a1), _v256_extract_high(a1)));
+}
+
+template<int n> inline
+v_int8x32 v_rshr_pack(const v_int16x16& a, const v_int16x16& b)
+{
+    __m256i delta = _mm256_set1_epi16((short)(1 << (n-1)));
+    return v_int8x32(_v256_shuffle_odd_64(_mm256_packs_epi16(_mm256_srai_epi16(_mm256_adds_epi16(a.val, delta), n),
+                                                             _mm256_srai_epi16(_mm256_adds_epi16(b.val, delta), n))));
+}
+
+template<int n> inline
+void v_rshr_pack_store(schar* ptr, const v_int16x16& a)
+{
+    __m256i delta = _mm256_set1_epi16((short)(1 << (n-1)));
+    __m256i a1 = _mm256_srai_epi16(_mm256_adds_epi16(a.val, delta), n);
+    _mm_storeu_si128((__m128i*)ptr, _mm_packs_epi16(_v256_extract_low(a1), _v256_extract_high(a1)));
+}
+
+template<int n> inline
+v_uint16x16 v_rshr_pack(const v_uint32x8& a, const v_uint32x8& b)
+{
+    // after the shift the values fit into the signed 32-bit range, so the signed-to-unsigned pack does the saturation
+    __m256i delta = _mm256_set1_epi32(1 << (n-1));
+    return v_uint16x16(_v256_shuffle_odd_64(_mm256_packus_epi32(_mm256_srli_epi32(_mm256_add_epi32(a.val, delta), n),
+                                                                _mm256_srli_epi32(_mm256_add_epi32(b.val, delta), n))));
+}
+
+template<int n> inline
+void v_rshr_pack_store(ushort* ptr, const v_uint32x8& a)
+{
+    __m256i delta = _mm256_set1_epi32(1 << (n-1));
+    __m256i a1 = _mm256_srli_epi32(_mm256_add_epi32(a.val, delta), n);
+    _mm_storeu_si128((__m128i*)ptr, _mm_packus_epi32(_v256_extract_low(a1), _v256_extract_high(a1)));
+}
+
+template<int n> inline
+v_uint16x16 v_rshr_pack_u(const v_int32x8& a, const v_int32x8& b)
+{
+    __m256i delta = _mm256_set1_epi32(1 << (n-1));
+    return v_uint16x16(_v256_shuffle_odd_64(_mm256_packus_epi32(_mm256_srai_epi32(_mm256_add_epi32(a.val, delta), n),
+                                                                _mm256_srai_epi32(_mm256_add_epi32(b.val, delta), n))));
+}
+
+template<int n> inline
+void v_rshr_pack_u_store(ushort* ptr, const v_int32x8& a)
+{
+    __m256i delta = _mm256_set1_epi32(1 << (n-1));
+    __m256i a1 = _mm256_srai_epi32(_mm256_add_epi32(a.val, delta), n);
+    _mm_storeu_si128((__m128i*)ptr, _mm_packus_epi32(_v256_extract_low(a1), _v256_extract_high(a1)));
+}
+
+template<int n> inline
+v_int16x16 v_rshr_pack(const v_int32x8& a, const v_int32x8& b)
+{
+    __m256i delta = _mm256_set1_epi32(1 << (n-1));
+    return v_int16x16(_v256_shuffle_odd_64(_mm256_packs_epi32(_mm256_srai_epi32(_mm256_add_epi32(a.val, delta), n),
+                                                              _mm256_srai_epi32(_mm256_add_epi32(b.val, delta), n))));
+}
+
+template<int n> inline
+void v_rshr_pack_store(short* ptr, const v_int32x8& a)
+{
+    __m256i delta = _mm256_set1_epi32(1 << (n-1));
+    __m256i a1 = _mm256_srai_epi32(_mm256_add_epi32(a.val, delta), n);
+    _mm_storeu_si128((__m128i*)ptr, _mm_packs_epi32(_v256_extract_low(a1), _v256_extract_high(a1)));
+}
+
+template<int n> inline
+v_uint32x8 v_rshr_pack(const v_uint64x4& a, const v_uint64x4& b)
+{
+    __m256i delta = _mm256_set1_epi64x((int64)1 << (n-1));
+    return v_uint32x8(_v256_pack_epi64(_mm256_srli_epi64(_mm256_add_epi64(a.val, delta), n),
+                                       _mm256_srli_epi64(_mm256_add_epi64(b.val, delta), n)));
+}
+
+template<int n> inline
+void v_rshr_pack_store(unsigned* ptr, const v_uint64x4& a)
+{
+    __m256i delta = _mm256_set1_epi64x((int64)1 << (n-1));
+    _mm_storeu_si128((__m128i*)ptr, _v256_pack_low_epi64(_mm256_srli_epi64(_mm256_add_epi64(a.val, delta), n)));
+}
+
+template<int n> inline
+v_int32x8 v_rshr_pack(const v_int64x4& a, const v_int64x4& b)
+{
+    __m256i delta = _mm256_set1_epi64x((int64)1 << (n-1));
+    return v_int32x8(_v256_pack_epi64(_v256_srai_epi64(_mm256_add_epi64(a.val, delta), n),
+                                      _v256_srai_epi64(_mm256_add_epi64(b.val, delta), n)));
+}
+
+template<int n> inline
+void v_rshr_pack_store(int* ptr, const v_int64x4& a)
+{
+    __m256i delta = _mm256_set1_epi64x((int64)1 << (n-1));
+    _mm_storeu_si128((__m128i*)ptr, _v256_pack_low_epi64(_v256_srai_epi64(_mm256_add_epi64(a.val, delta), n)));
+}
+
+//////////////// Arithmetic, bitwise and comparison operations ///////////////
+
+#define OPENCV_HAL_IMPL_AVX_BIN_OP(bin_op, _Tpvec, intrin) \
+    inline _Tpvec operator bin_op (const _Tpvec& a, const _Tpvec& b) \
+    { return _Tpvec(intrin(a.val, b.val)); } \
+    inline _Tpvec& operator bin_op##= (_Tpvec& a, const _Tpvec& b) \
+    { a.val = intrin(a.val, b.val); return a; }
+
+OPENCV_HAL_IMPL_AVX_BIN_OP(+, v_uint8x32,  _mm256_adds_epu8)
+OPENCV_HAL_IMPL_AVX_BIN_OP(-, v_uint8x32,  _mm256_subs_epu8)
+OPENCV_HAL_IMPL_AVX_BIN_OP(+, v_int8x32,   _mm256_adds_epi8)
+OPENCV_HAL_IMPL_AVX_BIN_OP(-, v_int8x32,   _mm256_subs_epi8)
+OPENCV_HAL_IMPL_AVX_BIN_OP(+, v_uint16x16, _mm256_adds_epu16)
+OPENCV_HAL_IMPL_AVX_BIN_OP(-, v_uint16x16, _mm256_subs_epu16)
+OPENCV_HAL_IMPL_AVX_BIN_OP(*, v_uint16x16, _mm256_mullo_epi16)
+OPENCV_HAL_IMPL_AVX_BIN_OP(+, v_int16x16,  _mm256_adds_epi16)
+OPENCV_HAL_IMPL_AVX_BIN_OP(-, v_int16x16,  _mm256_subs_epi16)
+OPENCV_HAL_IMPL_AVX_BIN_OP(*, v_int16x16,  _mm256_mullo_epi16)
+OPENCV_HAL_IMPL_AVX_BIN_OP(+, v_uint32x8,  _mm256_add_epi32)
+OPENCV_HAL_IMPL_AVX_BIN_OP(-, v_uint32x8,  _mm256_sub_epi32)
+OPENCV_HAL_IMPL_AVX_BIN_OP(*, v_uint32x8,  _mm256_mullo_epi32)
+OPENCV_HAL_IMPL_AVX_BIN_OP(+, v_int32x8,   _mm256_add_epi32)
+OPENCV_HAL_IMPL_AVX_BIN_OP(-, v_int32x8,   _mm256_sub_epi32)
+OPENCV_HAL_IMPL_AVX_BIN_OP(*, v_int32x8,   _mm256_mullo_epi32)
+OPENCV_HAL_IMPL_AVX_BIN_OP(+, v_uint64x4,  _mm256_add_epi64)
+OPENCV_HAL_IMPL_AVX_BIN_OP(-, v_uint64x4,  _mm256_sub_epi64)
+OPENCV_HAL_IMPL_AVX_BIN_OP(+, v_int64x4,   _mm256_add_epi64)
+OPENCV_HAL_IMPL_AVX_BIN_OP(-, v_int64x4,   _mm256_sub_epi64)
+OPENCV_HAL_IMPL_AVX_BIN_OP(+, v_float32x8, _mm256_add_ps)
+OPENCV_HAL_IMPL_AVX_BIN_OP(-, v_float32x8, _mm256_sub_ps)
+OPENCV_HAL_IMPL_AVX_BIN_OP(*, v_float32x8, _mm256_mul_ps)
+OPENCV_HAL_IMPL_AVX_BIN_OP(/, v_float32x8, _mm256_div_ps)
+OPENCV_HAL_IMPL_AVX_BIN_OP(+, v_float64x4, _mm256_add_pd)
+OPENCV_HAL_IMPL_AVX_BIN_OP(-, v_float64x4, _mm256_sub_pd)
+OPENCV_HAL_IMPL_AVX_BIN_OP(*, v_float64x4, _mm256_mul_pd)
+OPENCV_HAL_IMPL_AVX_BIN_OP(/, v_float64x4, _mm256_div_pd)
+
+// the in-lane unpacks interleave [0..3 | 8..11] and [4..7 | 12..15], the lane permutes restore the order
+inline void v_mul_expand(const v_int16x16& a, const v_int16x16& b,
+                         v_int32x8& c, v_int32x8& d)
+{
+    __m256i v0 = _mm256_mullo_epi16(a.val, b.val);
+    __m256i v1 = _mm256_mulhi_epi16(a.val, b.val);
+    __m256i lo = _mm256_unpacklo_epi16(v0, v1), hi = _mm256_unpackhi_epi16(v0, v1);
+    c.val = _mm256_permute2x128_si256(lo, hi, 0x20);
+    d.val = _mm256_permute2x128_si256(lo, hi, 0x31);
+}
+
+inline void v_mul_expand(const v_uint16x16& a, const v_uint16x16& b,
+                         v_uint32x8& c, v_uint32x8& d)
+{
+    __m256i v0 = _mm256_mullo_epi16(a.val, b.val);
+    __m256i v1 = _mm256_mulhi_epu16(a.val, b.val);
+    __m256i lo = _mm256_unpacklo_epi16(v0, v1), hi = _mm256_unpackhi_epi16(v0, v1);
+    c.val = _mm256_permute2x128_si256(lo, hi, 0x20);
+    d.val = _mm256_permute2x128_si256(lo, hi, 0x31);
+}
+
+inline void v_mul_expand(const v_uint32x8& a, const v_uint32x8& b,
+                         v_uint64x4& c, v_uint64x4& d)
+{
+    __m256i c0 = _mm256_mul_epu32(a.val, b.val);
+    __m256i c1 = _mm256_mul_epu32(_mm256_srli_epi64(a.val, 32), _mm256_srli_epi64(b.val, 32));
+    __m256i lo = _mm256_unpacklo_epi64(c0, c1), hi = _mm256_unpackhi_epi64(c0, c1);
+    c.val = _mm256_permute2x128_si256(lo, hi, 0x20);
+    d.val = _mm256_permute2x128_si256(lo, hi, 0x31);
+}
+
+inline v_int32x8 v_dotprod(const v_int16x16& a, const v_int16x16& b)
+{ return v_int32x8(_mm256_madd_epi16(a.val, b.val)); }
+
+#define OPENCV_HAL_IMPL_AVX_LOGIC_OP(_Tpvec, suffix, not_const) \
+    OPENCV_HAL_IMPL_AVX_BIN_OP(&, _Tpvec, _mm256_and_##suffix) \
+    OPENCV_HAL_IMPL_AVX_BIN_OP(|, _Tpvec, _mm256_or_##suffix) \
+    OPENCV_HAL_IMPL_AVX_BIN_OP(^, _Tpvec, _mm256_xor_##suffix) \
+    inline _Tpvec operator ~ (const _Tpvec& a) \
+    { return _Tpvec(_mm256_xor_##suffix(a.val, not_const)); }
+
+OPENCV_HAL_IMPL_AVX_LOGIC_OP(v_uint8x32,  si256, _mm256_set1_epi32(-1))
+OPENCV_HAL_IMPL_AVX_LOGIC_OP(v_int8x32,   si256, _mm256_set1_epi32(-1))
+OPENCV_HAL_IMPL_AVX_LOGIC_OP(v_uint16x16, si256, _mm256_set1_epi32(-1))
+OPENCV_HAL_IMPL_AVX_LOGIC_OP(v_int16x16,  si256, _mm256_set1_epi32(-1))
+OPENCV_HAL_IMPL_AVX_LOGIC_OP(v_uint32x8,  si256, _mm256_set1_epi32(-1))
+OPENCV_HAL_IMPL_AVX_LOGIC_OP(v_int32x8,   si256, _mm256_set1_epi32(-1))
+OPENCV_HAL_IMPL_AVX_LOGIC_OP(v_uint64x4,  si256, _mm256_set1_epi32(-1))
+OPENCV_HAL_IMPL_AVX_LOGIC_OP(v_int64x4,   si256, _mm256_set1_epi32(-1))
+OPENCV_HAL_IMPL_AVX_LOGIC_OP(v_float32x8, ps,    _mm256_castsi256_ps(_mm256_set1_epi32(-1)))
+OPENCV_HAL_IMPL_AVX_LOGIC_OP(v_float64x4, pd,    _mm256_castsi256_pd(_mm256_set1_epi32(-1)))
+
+inline v_float32x8 v_sqrt(const v_float32x8& x)
+{ return v_float32x8(_mm256_sqrt_ps(x.val)); }
+
+inline v_float32x8 v_invsqrt(const v_float32x8& x)
+{
+    const __m256 _0_5 = _mm256_set1_ps(0.5f), _1_5 = _mm256_set1_ps(1.5f);
+    __m256 t = x.val;
+    __m256 h = _mm256_mul_ps(t, _0_5);
+    t = _mm256_rsqrt_ps(t);
+    t = _mm256_mul_ps(t, _mm256_sub_ps(_1_5, _mm256_mul_ps(_mm256_mul_ps(t, t), h)));
+    return v_float32x8(t);
+}
+
+inline v_float64x4 v_sqrt(const v_float64x4& x)
+{ return v_float64x4(_mm256_sqrt_pd(x.val)); }
+
+inline v_float64x4 v_invsqrt(const v_float64x4& x)
+{ return v_float64x4(_mm256_div_pd(_mm256_set1_pd(1.), _mm256_sqrt_pd(x.val))); }
+
+inline v_float32x8 v_abs(const v_float32x8& x)
+{ return v_float32x8(_mm256_and_ps(x.val, _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff)))); }
+
+inline v_float64x4 v_abs(const v_float64x4& x)
+{ return v_float64x4(_mm256_and_pd(x.val, _mm256_castsi256_pd(_mm256_srli_epi64(_mm256_set1_epi32(-1), 1)))); }
+
+#define OPENCV_HAL_IMPL_AVX_BIN_FUNC(_Tpvec, func, intrin) \
+inline _Tpvec func(const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(intrin(a.val, b.val)); }
+
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_uint8x32,  v_min, _mm256_min_epu8)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_uint8x32,  v_max, _mm256_max_epu8)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_int8x32,   v_min, _mm256_min_epi8)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_int8x32,   v_max, _mm256_max_epi8)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_uint16x16, v_min, _mm256_min_epu16)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_uint16x16, v_max, _mm256_max_epu16)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_int16x16,  v_min, _mm256_min_epi16)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_int16x16,  v_max, _mm256_max_epi16)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_uint32x8,  v_min, _mm256_min_epu32)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_uint32x8,  v_max, _mm256_max_epu32)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_int32x8,   v_min, _mm256_min_epi32)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_int32x8,   v_max, _mm256_max_epi32)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_float32x8, v_min, _mm256_min_ps)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_float32x8, v_max, _mm256_max_ps)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_float64x4, v_min, _mm256_min_pd)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_float64x4, v_max, _mm256_max_pd)
+
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_uint8x32,  v_add_wrap, _mm256_add_epi8)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_int8x32,   v_add_wrap, _mm256_add_epi8)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_uint16x16, v_add_wrap, _mm256_add_epi16)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_int16x16,  v_add_wrap, _mm256_add_epi16)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_uint8x32,  v_sub_wrap, _mm256_sub_epi8)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_int8x32,   v_sub_wrap, _mm256_sub_epi8)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_uint16x16, v_sub_wrap, _mm256_sub_epi16)
+OPENCV_HAL_IMPL_AVX_BIN_FUNC(v_int16x16,  v_sub_wrap, _mm256_sub_epi16)
+
+#define OPENCV_HAL_IMPL_AVX_INT_CMP_OP(_Tpuvec, _Tpsvec, suffix, sbit) \
+inline _Tpuvec operator == (const _Tpuvec& a, const _Tpuvec& b) \
+{ return _Tpuvec(_mm256_cmpeq_##suffix(a.val, b.val)); } \
+inline _Tpuvec operator != (const _Tpuvec& a, const _Tpuvec& b) \
+{ return _Tpuvec(_mm256_xor_si256(_mm256_cmpeq_##suffix(a.val, b.val), _mm256_set1_epi32(-1))); } \
+inline _Tpsvec operator == (const _Tpsvec& a, const _Tpsvec& b) \
+{ return _Tpsvec(_mm256_cmpeq_##suffix(a.val, b.val)); } \
+inline _Tpsvec operator != (const _Tpsvec& a, const _Tpsvec& b) \
+{ return _Tpsvec(_mm256_xor_si256(_mm256_cmpeq_##suffix(a.val, b.val), _mm256_set1_epi32(-1))); } \
+inline _Tpuvec operator < (const _Tpuvec& a, const _Tpuvec& b) \
+{ \
+    __m256i smask = _mm256_set1_##suffix(sbit); \
+    return _Tpuvec(_mm256_cmpgt_##suffix(_mm256_xor_si256(b.val, smask), _mm256_xor_si256(a.val, smask))); \
+} \
+inline _Tpuvec operator > (const _Tpuvec& a, const _Tpuvec& b) \
+{ \
+    __m256i smask = _mm256_set1_##suffix(sbit); \
+    return _Tpuvec(_mm256_cmpgt_##suffix(_mm256_xor_si256(a.val, smask), _mm256_xor_si256(b.val, smask))); \
+} \
+inline _Tpuvec operator <= (const _Tpuvec& a, const _Tpuvec& b) \
+{ return ~(a > b); } \
+inline _Tpuvec operator >= (const _Tpuvec& a, const _Tpuvec& b) \
+{ return ~(a < b); } \
+inline _Tpsvec operator < (const _Tpsvec& a, const _Tpsvec& b) \
+{ return _Tpsvec(_mm256_cmpgt_##suffix(b.val, a.val)); } \
+inline _Tpsvec operator > (const _Tpsvec& a, const _Tpsvec& b) \
+{ return _Tpsvec(_mm256_cmpgt_##suffix(a.val, b.val)); } \
+inline _Tpsvec operator <= (const _Tpsvec& a, const _Tpsvec& b) \
+{ return ~(a > b); } \
+inline _Tpsvec operator >= (const _Tpsvec& a, const _Tpsvec& b) \
+{ return ~(a < b); }
+
+OPENCV_HAL_IMPL_AVX_INT_CMP_OP(v_uint8x32,  v_int8x32,  epi8,  (char)-128)
+OPENCV_HAL_IMPL_AVX_INT_CMP_OP(v_uint16x16, v_int16x16, epi16, (short)-32768)
+OPENCV_HAL_IMPL_AVX_INT_CMP_OP(v_uint32x8,  v_int32x8,  epi32, (int)0x80000000)
+
+#define OPENCV_HAL_IMPL_AVX_FLT_CMP_OP(_Tpvec, suffix) \
+inline _Tpvec operator == (const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(_mm256_cmp_##suffix(a.val, b.val, _CMP_EQ_OQ)); } \
+inline _Tpvec operator != (const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(_mm256_cmp_##suffix(a.val, b.val, _CMP_NEQ_UQ)); } \
+inline _Tpvec operator < (const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(_mm256_cmp_##suffix(a.val, b.val, _CMP_LT_OQ)); } \
+inline _Tpvec operator > (const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(_mm256_cmp_##suffix(a.val, b.val, _CMP_GT_OQ)); } \
+inline _Tpvec operator <= (const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(_mm256_cmp_##suffix(a.val, b.val, _CMP_LE_OQ)); } \
+inline _Tpvec operator >= (const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(_mm256_cmp_##suffix(a.val, b.val, _CMP_GE_OQ)); }
+
+OPENCV_HAL_IMPL_AVX_FLT_CMP_OP(v_float32x8, ps)
+OPENCV_HAL_IMPL_AVX_FLT_CMP_OP(v_float64x4, pd)
+
+#define OPENCV_HAL_IMPL_AVX_ABSDIFF_8_16(_Tpuvec, _Tpsvec, bits) \
+inline _Tpuvec v_absdiff(const _Tpuvec& a, const _Tpuvec& b) \
+{ return _Tpuvec(_mm256_add_epi##bits(_mm256_subs_epu##bits(a.val, b.val), _mm256_subs_epu##bits(b.val, a.val))); } \
+inline _Tpuvec v_absdiff(const _Tpsvec& a, const _Tpsvec& b) \
+{ return _Tpuvec(_mm256_sub_epi##bits(_mm256_max_epi##bits(a.val, b.val), _mm256_min_epi##bits(a.val, b.val))); }
+
+OPENCV_HAL_IMPL_AVX_ABSDIFF_8_16(v_uint8x32,  v_int8x32,  8)
+OPENCV_HAL_IMPL_AVX_ABSDIFF_8_16(v_uint16x16, v_int16x16, 16)
+
+inline v_uint32x8 v_absdiff(const v_uint32x8& a, const v_uint32x8& b)
+{ return v_max(a, b) - v_min(a, b); }
+
+inline v_uint32x8 v_absdiff(const v_int32x8& a, const v_int32x8& b)
+{ return v_uint32x8(_mm256_sub_epi32(_mm256_max_epi32(a.val, b.val), _mm256_min_epi32(a.val, b.val))); }
+
+#define OPENCV_HAL_IMPL_AVX_MISC_FLT_OP(_Tpvec, _Tpreg, suffix, absmask_vec) \
+inline _Tpvec v_absdiff(const _Tpvec& a, const _Tpvec& b) \
+{ \
+    _Tpreg absmask = _mm256_castsi256_##suffix(absmask_vec); \
+    return _Tpvec(_mm256_and_##suffix(_mm256_sub_##suffix(a.val, b.val), absmask)); \
+} \
+inline _Tpvec v_magnitude(const _Tpvec& a, const _Tpvec& b) \
+{ \
+    _Tpreg res = _mm256_add_##suffix(_mm256_mul_##suffix(a.val, a.val), _mm256_mul_##suffix(b.val, b.val)); \
+    return _Tpvec(_mm256_sqrt_##suffix(res)); \
+} \
+inline _Tpvec v_sqr_magnitude(const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(_mm256_add_##suffix(_mm256_mul_##suffix(a.val, a.val), _mm256_mul_##suffix(b.val, b.val))); } \
+inline _Tpvec v_muladd(const _Tpvec& a, const _Tpvec& b, const _Tpvec& c) \
+{ return _Tpvec(_mm256_add_##suffix(_mm256_mul_##suffix(a.val, b.val), c.val)); }
+
+OPENCV_HAL_IMPL_AVX_MISC_FLT_OP(v_float32x8, __m256,  ps, _mm256_set1_epi32((int)0x7fffffff))
+OPENCV_HAL_IMPL_AVX_MISC_FLT_OP(v_float64x4, __m256d, pd, _mm256_srli_epi64(_mm256_set1_epi32(-1), 1))
+
+#define OPENCV_HAL_IMPL_AVX_SHIFT_OP(_Tpuvec, _Tpsvec, suffix, srai) \
+inline _Tpuvec operator << (const _Tpuvec& a, int imm) \
+{ return _Tpuvec(_mm256_slli_##suffix(a.val, imm)); } \
+inline _Tpsvec operator << (const _Tpsvec& a, int imm) \
+{ return _Tpsvec(_mm256_slli_##suffix(a.val, imm)); } \
+inline _Tpuvec operator >> (const _Tpuvec& a, int imm) \
+{ return _Tpuvec(_mm256_srli_##suffix(a.val, imm)); } \
+inline _Tpsvec operator >> (const _Tpsvec& a, int imm) \
+{ return _Tpsvec(srai(a.val, imm)); } \
+template<int imm> \
+inline _Tpuvec v_shl(const _Tpuvec& a) \
+{ return _Tpuvec(_mm256_slli_##suffix(a.val, imm)); } \
+template<int imm> \
+inline _Tpsvec v_shl(const _Tpsvec& a) \
+{ return _Tpsvec(_mm256_slli_##suffix(a.val, imm)); } \
+template<int imm> \
+inline _Tpuvec v_shr(const _Tpuvec& a) \
+{ return _Tpuvec(_mm256_srli_##suffix(a.val, imm)); } \
+template<int imm> \
+inline _Tpsvec v_shr(const _Tpsvec& a) \
+{ return _Tpsvec(srai(a.val, imm)); }
+
+OPENCV_HAL_IMPL_AVX_SHIFT_OP(v_uint16x16, v_int16x16, epi16, _mm256_srai_epi16)
+OPENCV_HAL_IMPL_AVX_SHIFT_OP(v_uint32x8,  v_int32x8,  epi32, _mm256_srai_epi32)
+OPENCV_HAL_IMPL_AVX_SHIFT_OP(v_uint64x4,  v_int64x4,  epi64, _v256_srai_epi64)
+
+//////////////// Reductions, masks and selection ///////////////
+
+// the halves are combined first, then the 128-bit version finishes the job
+#define OPENCV_HAL_IMPL_AVX_REDUCE_8(_Tpvec, _Tpvec128, scalartype, func, intrin) \
+inline scalartype v_reduce_##func(const _Tpvec& a) \
+{ return v_reduce_##func(_Tpvec128(intrin(_v256_extract_low(a.val), _v256_extract_high(a.val)))); }
+
+OPENCV_HAL_IMPL_AVX_REDUCE_8(v_uint32x8,  v_uint32x4,  unsigned, sum, _mm_add_epi32)
+OPENCV_HAL_IMPL_AVX_REDUCE_8(v_uint32x8,  v_uint32x4,  unsigned, max, _mm_max_epu32)
+OPENCV_HAL_IMPL_AVX_REDUCE_8(v_uint32x8,  v_uint32x4,  unsigned, min, _mm_min_epu32)
+OPENCV_HAL_IMPL_AVX_REDUCE_8(v_int32x8,   v_int32x4,   int,      sum, _mm_add_epi32)
+OPENCV_HAL_IMPL_AVX_REDUCE_8(v_int32x8,   v_int32x4,   int,      max, _mm_max_epi32)
+OPENCV_HAL_IMPL_AVX_REDUCE_8(v_int32x8,   v_int32x4,   int,      min, _mm_min_epi32)
+OPENCV_HAL_IMPL_AVX_REDUCE_8(v_float32x8, v_float32x4, float,    sum, _mm_add_ps)
+OPENCV_HAL_IMPL_AVX_REDUCE_8(v_float32x8, v_float32x4, float,    max, _mm_max_ps)
+OPENCV_HAL_IMPL_AVX_REDUCE_8(v_float32x8, v_float32x4, float,    min, _mm_min_ps)
+
+inline int v_signmask(const v_uint8x32& a) { return _mm256_movemask_epi8(a.val); }
+inline int v_signmask(const v_int8x32& a) { return _mm256_movemask_epi8(a.val); }
+inline int v_signmask(const v_uint16x16& a)
+{ return _mm_movemask_epi8(_mm_packs_epi16(_v256_extract_low(a.val), _v256_extract_high(a.val))); }
+inline int v_signmask(const v_int16x16& a)
+{ return _mm_movemask_epi8(_mm_packs_epi16(_v256_extract_low(a.val), _v256_extract_high(a.val))); }
+inline int v_signmask(const v_uint32x8& a) { return _mm256_movemask_ps(_mm256_castsi256_ps(a.val)); }
+inline int v_signmask(const v_int32x8& a) { return _mm256_movemask_ps(_mm256_castsi256_ps(a.val)); }
+inline int v_signmask(const v_float32x8& a) { return _mm256_movemask_ps(a.val); }
+inline int v_signmask(const v_float64x4& a) { return _mm256_movemask_pd(a.val); }
+
+#define OPENCV_HAL_IMPL_AVX_CHECK(_Tpvec, movemask, cast, allmask) \
+inline bool v_check_all(const _Tpvec& a) \
+{ return (movemask(cast(a.val)) & allmask) == allmask; } \
+inline bool v_check_any(const _Tpvec& a) \
+{ return (movemask(cast(a.val)) & allmask) != 0; }
+
+OPENCV_HAL_IMPL_AVX_CHECK(v_uint8x32,  _mm256_movemask_epi8, OPENCV_HAL_NOP, -1)
+OPENCV_HAL_IMPL_AVX_CHECK(v_int8x32,   _mm256_movemask_epi8, OPENCV_HAL_NOP, -1)
+OPENCV_HAL_IMPL_AVX_CHECK(v_uint16x16, _mm256_movemask_epi8, OPENCV_HAL_NOP, (int)0xaaaaaaaa)
+OPENCV_HAL_IMPL_AVX_CHECK(v_int16x16,  _mm256_movemask_epi8, OPENCV_HAL_NOP, (int)0xaaaaaaaa)
+OPENCV_HAL_IMPL_AVX_CHECK(v_uint32x8,  _mm256_movemask_ps, _mm256_castsi256_ps, 255)
+OPENCV_HAL_IMPL_AVX_CHECK(v_int32x8,   _mm256_movemask_ps, _mm256_castsi256_ps, 255)
+OPENCV_HAL_IMPL_AVX_CHECK(v_float32x8, _mm256_movemask_ps, OPENCV_HAL_NOP, 255)
+OPENCV_HAL_IMPL_AVX_CHECK(v_float64x4, _mm256_movemask_pd, OPENCV_HAL_NOP, 15)
+
+// the mask lanes are expected to be all zeros or all ones, like the comparison results are
+#define OPENCV_HAL_IMPL_AVX_SELECT(_Tpvec, blend) \
+inline _Tpvec v_select(const _Tpvec& mask, const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(blend(b.val, a.val, mask.val)); }
+
+OPENCV_HAL_IMPL_AVX_SELECT(v_uint8x32,  _mm256_blendv_epi8)
+OPENCV_HAL_IMPL_AVX_SELECT(v_int8x32,   _mm256_blendv_epi8)
+OPENCV_HAL_IMPL_AVX_SELECT(v_uint16x16, _mm256_blendv_epi8)
+OPENCV_HAL_IMPL_AVX_SELECT(v_int16x16,  _mm256_blendv_epi8)
+OPENCV_HAL_IMPL_AVX_SELECT(v_uint32x8,  _mm256_blendv_epi8)
+OPENCV_HAL_IMPL_AVX_SELECT(v_int32x8,   _mm256_blendv_epi8)
+OPENCV_HAL_IMPL_AVX_SELECT(v_float32x8, _mm256_blendv_ps)
+OPENCV_HAL_IMPL_AVX_SELECT(v_float64x4, _mm256_blendv_pd)
+
+//////////////// Expand, zip and combine ///////////////
+
+#define OPENCV_HAL_IMPL_AVX_EXPAND(_Tpvec, _Tpwvec, _Tp, intrin) \
+inline void v_expand(const _Tpvec& a, _Tpwvec& b0, _Tpwvec& b1) \
+{ \
+    b0.val = intrin(_v256_extract_low(a.val)); \
+    b1.val = intrin(_v256_extract_high(a.val)); \
+} \
+inline _Tpwvec v256_load_expand(const _Tp* ptr) \
+{ return _Tpwvec(intrin(_mm_loadu_si128((const __m128i*)ptr))); }
+
+OPENCV_HAL_IMPL_AVX_EXPAND(v_uint8x32,  v_uint16x16, uchar,    _mm256_cvtepu8_epi16)
+OPENCV_HAL_IMPL_AVX_EXPAND(v_int8x32,   v_int16x16,  schar,    _mm256_cvtepi8_epi16)
+OPENCV_HAL_IMPL_AVX_EXPAND(v_uint16x16, v_uint32x8,  ushort,   _mm256_cvtepu16_epi32)
+OPENCV_HAL_IMPL_AVX_EXPAND(v_int16x16,  v_int32x8,   short,    _mm256_cvtepi16_epi32)
+OPENCV_HAL_IMPL_AVX_EXPAND(v_uint32x8,  v_uint64x4,  unsigned, _mm256_cvtepu32_epi64)
+OPENCV_HAL_IMPL_AVX_EXPAND(v_int32x8,   v_int64x4,   int,      _mm256_cvtepi32_epi64)
+
+inline v_uint32x8 v256_load_expand_q(const uchar* ptr)
+{ return v_uint32x8(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)ptr))); }
+
+inline v_int32x8 v256_load_expand_q(const schar* ptr)
+{ return v_int32x8(_mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i*)ptr))); }
+
+#define OPENCV_HAL_IMPL_AVX_UNPACKS(_Tpvec, suffix, perm) \
+inline void v_zip(const _Tpvec& a0, const _Tpvec& a1, _Tpvec& b0, _Tpvec& b1) \
+{ \
+    _Tpvec lo(_mm256_unpacklo_##suffix(a0.val, a1.val)), hi(_mm256_unpackhi_##suffix(a0.val, a1.val)); \
+    b0.val = perm(lo.val, hi.val, 0x20); \
+    b1.val = perm(lo.val, hi.val, 0x31); \
+} \
+inline _Tpvec v_combine_low(const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(perm(a.val, b.val, 0x20)); } \
+inline _Tpvec v_combine_high(const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(perm(a.val, b.val, 0x31)); } \
+inline void v_recombine(const _Tpvec& a, const _Tpvec& b, _Tpvec& c, _Tpvec& d) \
+{ \
+    c.val = perm(a.val, b.val, 0x20); \
+    d.val = perm(a.val, b.val, 0x31); \
+}
+
+OPENCV_HAL_IMPL_AVX_UNPACKS(v_uint8x32,  epi8,  _mm256_permute2x128_si256)
+OPENCV_HAL_IMPL_AVX_UNPACKS(v_int8x32,   epi8,  _mm256_permute2x128_si256)
+OPENCV_HAL_IMPL_AVX_UNPACKS(v_uint16x16, epi16, _mm256_permute2x128_si256)
+OPENCV_HAL_IMPL_AVX_UNPACKS(v_int16x16,  epi16, _mm256_permute2x128_si256)
+OPENCV_HAL_IMPL_AVX_UNPACKS(v_uint32x8,  epi32, _mm256_permute2x128_si256)
+OPENCV_HAL_IMPL_AVX_UNPACKS(v_int32x8,   epi32, _mm256_permute2x128_si256)
+OPENCV_HAL_IMPL_AVX_UNPACKS(v_float32x8, ps,    _mm256_permute2f128_ps)
+OPENCV_HAL_IMPL_AVX_UNPACKS(v_float64x4, pd,    _mm256_permute2f128_pd)
+
+//////////////// Conversions ///////////////
+
+inline v_int32x8 v_round(const v_float32x8& a)
+{ return v_int32x8(_mm256_cvtps_epi32(a.val)); }
+
+inline v_int32x8 v_floor(const v_float32x8& a)
+{ return v_int32x8(_mm256_cvtps_epi32(_mm256_floor_ps(a.val))); }
+
+inline v_int32x8 v_ceil(const v_float32x8& a)
+{ return v_int32x8(_mm256_cvtps_epi32(_mm256_ceil_ps(a.val))); }
+
+inline v_int32x8 v_trunc(const v_float32x8& a)
+{ return v_int32x8(_mm256_cvttps_epi32(a.val)); }
+
+// the double precision conversions fill the lower half of the result, like the 128-bit ones do
+inline v_int32x8 v_round(const v_float64x4& a)
+{ return v_int32x8(_mm256_inserti128_si256(_mm256_setzero_si256(), _mm256_cvtpd_epi32(a.val), 0)); }
+
+inline v_int32x8 v_floor(const v_float64x4& a)
+{ return v_round(v_float64x4(_mm256_floor_pd(a.val))); }
+
+inline v_int32x8 v_ceil(const v_float64x4& a)
+{ return v_round(v_float64x4(_mm256_ceil_pd(a.val))); }
+
+inline v_int32x8 v_trunc(const v_float64x4& a)
+{ return v_int32x8(_mm256_inserti128_si256(_mm256_setzero_si256(), _mm256_cvttpd_epi32(a.val), 0)); }
+
+inline v_float32x8 v_cvt_f32(const v_int32x8& a)
+{ return v_float32x8(_mm256_cvtepi32_ps(a.val)); }
+
+inline v_float32x8 v_cvt_f32(const v_float64x4& a)
+{ return v_float32x8(_mm256_insertf128_ps(_mm256_setzero_ps(), _mm256_cvtpd_ps(a.val), 0)); }
+
+inline v_float64x4 v_cvt_f64(const v_int32x8& a)
+{ return v_float64x4(_mm256_cvtepi32_pd(_v256_extract_low(a.val))); }
+
+inline v_float64x4 v_cvt_f64(const v_float32x8& a)
+{ return v_float64x4(_mm256_cvtps_pd(_v256_extract_low(a.val))); }
+
+// (de)interleaving is done with the 128-bit halves
+#define OPENCV_HAL_IMPL_AVX_LOADSTORE_INTERLEAVE(_Tpvec, _Tp, _Tpvec128) \
+inline void v_load_deinterleave(const _Tp* ptr, _Tpvec& a, _Tpvec& b) \
+{ \
+    _Tpvec128 a0, b0, a1, b1; \
+    v_load_deinterleave(ptr, a0, b0); \
+    v_load_deinterleave(ptr + _Tpvec128::nlanes*2, a1, b1); \
+    a = v256_combine(a0, a1); b = v256_combine(b0, b1); \
+} \
+inline void v_load_deinterleave(const _Tp* ptr, _Tpvec& a, _Tpvec& b, _Tpvec& c) \
+{ \
+    _Tpvec128 a0, b0, c0, a1, b1, c1; \
+    v_load_deinterleave(ptr, a0, b0, c0); \
+    v_load_deinterleave(ptr + _Tpvec128::nlanes*3, a1, b1, c1); \
+    a = v256_combine(a0, a1); b = v256_combine(b0, b1); c = v256_combine(c0, c1); \
+} \
+inline void v_load_deinterleave(const _Tp* ptr, _Tpvec& a, _Tpvec& b, _Tpvec& c, _Tpvec& d) \
+{ \
+    _Tpvec128 a0, b0, c0, d0, a1, b1, c1, d1; \
+    v_load_deinterleave(ptr, a0, b0, c0, d0); \
+    v_load_deinterleave(ptr + _Tpvec128::nlanes*4, a1, b1, c1, d1); \
+    a = v256_combine(a0, a1); b = v256_combine(b0, b1); c = v256_combine(c0, c1); d = v256_combine(d0, d1); \
+} \
+inline void v_store_interleave(_Tp* ptr, const _Tpvec& a, const _Tpvec& b) \
+{ \
+    v_store_interleave(ptr, v_get_low(a), v_get_low(b)); \
+    v_store_interleave(ptr + _Tpvec128::nlanes*2, v_get_high(a), v_get_high(b)); \
+} \
+inline void v_store_interleave(_Tp* ptr, const _Tpvec& a, const _Tpvec& b, const _Tpvec& c) \
+{ \
+    v_store_interleave(ptr, v_get_low(a), v_get_low(b), v_get_low(c)); \
+    v_store_interleave(ptr + _Tpvec128::nlanes*3, v_get_high(a), v_get_high(b), v_get_high(c)); \
+} \
+inline void v_store_interleave(_Tp* ptr, const _Tpvec& a, const _Tpvec& b, const _Tpvec& c, const _Tpvec& d) \
+{ \
+    v_store_interleave(ptr, v_get_low(a), v_get_low(b), v_get_low(c), v_get_low(d)); \
+    v_store_interleave(ptr + _Tpvec128::nlanes*4, v_get_high(a), v_get_high(b), v_get_high(c), v_get_high(d)); \
+}
+
+OPENCV_HAL_IMPL_AVX_LOADSTORE_INTERLEAVE(v_uint8x32, uchar, v_uint8x16)
+OPENCV_HAL_IMPL_AVX_LOADSTORE_INTERLEAVE(v_int8x32, schar, v_int8x16)
+OPENCV_HAL_IMPL_AVX_LOADSTORE_INTERLEAVE(v_uint16x16, ushort, v_uint16x8)
+OPENCV_HAL_IMPL_AVX_LOADSTORE_INTERLEAVE(v_int16x16, short, v_int16x8)
+OPENCV_HAL_IMPL_AVX_LOADSTORE_INTERLEAVE(v_uint32x8, unsigned, v_uint32x4)
+OPENCV_HAL_IMPL_AVX_LOADSTORE_INTERLEAVE(v_int32x8, int, v_int32x4)
+OPENCV_HAL_IMPL_AVX_LOADSTORE_INTERLEAVE(v_float32x8, float, v_float32x4)
+
+CV_CPU_OPTIMIZATION_HAL_NAMESPACE_END
+
+//! @endcond
+
+}
+
+#endif
@@ -0,0 +1,737 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef __OPENCV_HAL_INTRIN_AVX512_HPP__
+#define __OPENCV_HAL_INTRIN_AVX512_HPP__
+
+// only AVX-512F and AVX-512BW instructions are used here
+#define CV_SIMD512 1
+#define CV_SIMD512_64F 1
+
+namespace cv
+{
+
+//! @cond IGNORED
+
+CV_CPU_OPTIMIZATION_HAL_NAMESPACE_BEGIN
+
+///////// Utils ////////////
+
+// the 128-bit lanes of the in-lane packs are [a0 b0 | a1 b1 | a2 b2 | a3 b3], this restores the order
+inline __m512i _v512_shuffle_odd_64(const __m512i& v)
+{ return _mm512_permutexvar_epi64(_mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7), v); }
+
+// [lo0 hi0 | lo1 hi1 | lo2 hi2 | lo3 hi3] from the in-lane unpack results
+inline void _v512_interleave_lanes(const __m512i& lo, const __m512i& hi, __m512i& a, __m512i& b)
+{
+    a = _mm512_permutex2var_epi64(lo, _mm512_setr_epi64(0, 1, 8, 9, 2, 3, 10, 11), hi);
+    b = _mm512_permutex2var_epi64(lo, _mm512_setr_epi64(4, 5, 12, 13, 6, 7, 14, 15), hi);
+}
+
+inline __m512i _v512_combine(const __m256i& lo, const __m256i& hi)
+{ return _mm512_inserti64x4(_mm512_castsi256_si512(lo), hi, 1); }
+
+inline __m512 _v512_combine(const __m256& lo, const __m256& hi)
+{ return _mm512_castpd_ps(_mm512_insertf64x4(_mm512_castpd256_pd512(_mm256_castps_pd(lo)), _mm256_castps_pd(hi), 1)); }
+
+inline __m512d _v512_combine(const __m256d& lo, const __m256d& hi)
+{ return _mm512_insertf64x4(_mm512_castpd256_pd512(lo), hi, 1); }
+
+inline __m256i _v512_extract_low(const __m512i& v)
+{ return _mm512_castsi512_si256(v); }
+
+inline __m256 _v512_extract_low(const __m512& v)
+{ return _mm512_castps512_ps256(v); }
+
+inline __m256d _v512_extract_low(const __m512d& v)
+{ return _mm512_castpd512_pd256(v); }
+
+inline __m256i _v512_extract_high(const __m512i& v)
+{ return _mm512_extracti64x4_epi64(v, 1); }
+
+inline __m256 _v512_extract_high(const __m512& v)
+{ return _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(v), 1)); }
+
+inline __m256d _v512_extract_high(const __m512d& v)
+{ return _mm512_extractf64x4_pd(v, 1); }
+
+// the comparisons produce the mask registers, the universal intrinsics keep masks as vectors
+inline __m512i _v512_mask8(__mmask64 m) { return _mm512_movm_epi8(m); }
+inline __m512i _v512_mask16(__mmask32 m) { return _mm512_movm_epi16(m); }
+inline __m512i _v512_mask32(__mmask16 m) { return _mm512_maskz_set1_epi32(m, -1); }
+inline __m512i _v512_mask64(__mmask8 m) { return _mm512_maskz_set1_epi64(m, -1); }
+
+///////// Types ////////////
+
+#define OPENCV_HAL_IMPL_AVX512_TYPE(_Tpvec, _Tp, n, _Tpreg, cvt0) \
+struct _Tpvec \
+{ \
+    typedef _Tp lane_type; \
+    enum { nlanes = n }; \
+ \
+    _Tpvec() {} \
+    explicit _Tpvec(_Tpreg v) : val(v) {} \
+    _Tp get0() const \
+    { \
+        return (_Tp)cvt0; \
+    } \
+ \
+    _Tpreg val; \
+};
+
+OPENCV_HAL_IMPL_AVX512_TYPE(v_uint8x64,   uchar,    64, __m512i, _mm_cvtsi128_si32(_mm512_castsi512_si128(val)))
+OPENCV_HAL_IMPL_AVX512_TYPE(v_int8x64,    schar,    64, __m512i, _mm_cvtsi128_si32(_mm512_castsi512_si128(val)))
+OPENCV_HAL_IMPL_AVX512_TYPE(v_uint16x32,  ushort,   32, __m512i, _mm_cvtsi128_si32(_mm512_castsi512_si128(val)))
+OPENCV_HAL_IMPL_AVX512_TYPE(v_int16x32,   short,    32, __m512i, _mm_cvtsi128_si32(_mm512_castsi512_si128(val)))
+OPENCV_HAL_IMPL_AVX512_TYPE(v_uint32x16,  unsigned, 16, __m512i, _mm_cvtsi128_si32(_mm512_castsi512_si128(val)))
+OPENCV_HAL_IMPL_AVX512_TYPE(v_int32x16,   int,      16, __m512i, _mm_cvtsi128_si32(_mm512_castsi512_si128(val)))
+OPENCV_HAL_IMPL_AVX512_TYPE(v_uint64x8,   uint64,    8, __m512i, v_uint64x2(_mm512_castsi512_si128(val)).get0())
+OPENCV_HAL_IMPL_AVX512_TYPE(v_int64x8,    int64,     8, __m512i, v_int64x2(_mm512_castsi512_si128(val)).get0())
+OPENCV_HAL_IMPL_AVX512_TYPE(v_float32x16, float,    16, __m512,  _mm_cvtss_f32(_mm512_castps512_ps128(val)))
+OPENCV_HAL_IMPL_AVX512_TYPE(v_float64x8,  double,    8, __m512d, _mm_cvtsd_f64(_mm512_castpd512_pd128(val)))
+
+//////////////// Load and store operations ///////////////
+
+#define OPENCV_HAL_IMPL_AVX512_LOADSTORE(_Tpvec, _Tp) \
+inline _Tpvec v512_load(const _Tp* ptr) \
+{ return _Tpvec(_mm512_loadu_si512((const void*)ptr)); } \
+inline _Tpvec v512_load_aligned(const _Tp* ptr) \
+{ return _Tpvec(_mm512_load_si512((const void*)ptr)); } \
+inline _Tpvec v512_load_halves(const _Tp* ptr0, const _Tp* ptr1) \
+{ \
+    return _Tpvec(_v512_combine(_mm256_loadu_si256((const __m256i*)ptr0), \
+                                _mm256_loadu_si256((const __m256i*)ptr1))); \
+} \
+inline void v_store(_Tp* ptr, const _Tpvec& a) \
+{ _mm512_storeu_si512((void*)ptr, a.val); } \
+inline void v_store_aligned(_Tp* ptr, const _Tpvec& a) \
+{ _mm512_store_si512((void*)ptr, a.val); } \
+inline void v_store_low(_Tp* ptr, const _Tpvec& a) \
+{ _mm256_storeu_si256((__m256i*)ptr, _v512_extract_low(a.val)); } \
+inline void v_store_high(_Tp* ptr, const _Tpvec& a) \
+{ _mm256_storeu_si256((__m256i*)ptr, _v512_extract_high(a.val)); }
+
+OPENCV_HAL_IMPL_AVX512_LOADSTORE(v_uint8x64,  uchar)
+OPENCV_HAL_IMPL_AVX512_LOADSTORE(v_int8x64,   schar)
+OPENCV_HAL_IMPL_AVX512_LOADSTORE(v_uint16x32, ushort)
+OPENCV_HAL_IMPL_AVX512_LOADSTORE(v_int16x32,  short)
+OPENCV_HAL_IMPL_AVX512_LOADSTORE(v_uint32x16, unsigned)
+OPENCV_HAL_IMPL_AVX512_LOADSTORE(v_int32x16,  int)
+OPENCV_HAL_IMPL_AVX512_LOADSTORE(v_uint64x8,  uint64)
+OPENCV_HAL_IMPL_AVX512_LOADSTORE(v_int64x8,   int64)
+
+#define OPENCV_HAL_IMPL_AVX512_LOADSTORE_FLT(_Tpvec, _Tp, suffix) \
+inline _Tpvec v512_load(const _Tp* ptr) \
+{ return _Tpvec(_mm512_loadu_##suffix(ptr)); } \
+inline _Tpvec v512_load_aligned(const _Tp* ptr) \
+{ return _Tpvec(_mm512_load_##suffix(ptr)); } \
+inline _Tpvec v512_load_halves(const _Tp* ptr0, const _Tp* ptr1) \
+{ return _Tpvec(_v512_combine(_mm256_loadu_##suffix(ptr0), _mm256_loadu_##suffix(ptr1))); } \
+inline void v_store(_Tp* ptr, const _Tpvec& a) \
+{ _mm512_storeu_##suffix(ptr, a.val); } \
+inline void v_store_aligned(_Tp* ptr, const _Tpvec& a) \
+{ _mm512_store_##suffix(ptr, a.val); } \
+inline void v_store_low(_Tp* ptr, const _Tpvec& a) \
+{ _mm256_storeu_##suffix(ptr, _v512_extract_low(a.val)); } \
+inline void v_store_high(_Tp* ptr, const _Tpvec& a) \
+{ _mm256_storeu_##suffix(ptr, _v512_extract_high(a.val)); }
+
+OPENCV_HAL_IMPL_AVX512_LOADSTORE_FLT(v_float32x16, float,  ps)
+OPENCV_HAL_IMPL_AVX512_LOADSTORE_FLT(v_float64x8,  double, pd)
+
+#define OPENCV_HAL_IMPL_AVX512_HALVES(_Tpvec, _Tpvec256) \
+inline _Tpvec256 v_get_low(const _Tpvec& a) \
+{ return _Tpvec256(_v512_extract_low(a.val)); } \
+inline _Tpvec256 v_get_high(const _Tpvec& a) \
+{ return _Tpvec256(_v512_extract_high(a.val)); } \
+inline _Tpvec v512_combine(const _Tpvec256& lo, const _Tpvec256& hi) \
+{ return _Tpvec(_v512_combine(lo.val, hi.val)); }
+
+OPENCV_HAL_IMPL_AVX512_HALVES(v_uint8x64,   v_uint8x32)
+OPENCV_HAL_IMPL_AVX512_HALVES(v_int8x64,    v_int8x32)
+OPENCV_HAL_IMPL_AVX512_HALVES(v_uint16x32,  v_uint16x16)
+OPENCV_HAL_IMPL_AVX512_HALVES(v_int16x32,   v_int16x16)
+OPENCV_HAL_IMPL_AVX512_HALVES(v_uint32x16,  v_uint32x8)
+OPENCV_HAL_IMPL_AVX512_HALVES(v_int32x16,   v_int32x8)
+OPENCV_HAL_IMPL_AVX512_HALVES(v_uint64x8,   v_uint64x4)
+OPENCV_HAL_IMPL_AVX512_HALVES(v_int64x8,    v_int64x4)
+OPENCV_HAL_IMPL_AVX512_HALVES(v_float32x16, v_float32x8)
+OPENCV_HAL_IMPL_AVX512_HALVES(v_float64x8,  v_float64x4)
+
+//////////////// Initialization and reinterpretation ///////////////
+
+#define OPENCV_HAL_IMPL_AVX512_INIT(_Tpvec, _Tp, suffix, zsuffix, ssuffix, _Tps) \
+inline _Tpvec v512_setzero_##suffix() { return _Tpvec(_mm512_setzero_##zsuffix()); } \
+inline _Tpvec v512_setall_##suffix(_Tp v) { return _Tpvec(_mm512_set1_##ssuffix((_Tps)v)); }
+
+OPENCV_HAL_IMPL_AVX512_INIT(v_uint8x64,   uchar,    u8,  si512, epi8,  char)
+OPENCV_HAL_IMPL_AVX512_INIT(v_int8x64,    schar,    s8,  si512, epi8,  char)
+OPENCV_HAL_IMPL_AVX512_INIT(v_uint16x32,  ushort,   u16, si512, epi16, short)
+OPENCV_HAL_IMPL_AVX512_INIT(v_int16x32,   short,    s16, si512, epi16, short)
+OPENCV_HAL_IMPL_AVX512_INIT(v_uint32x16,  unsigned, u32, si512, epi32, int)
+OPENCV_HAL_IMPL_AVX512_INIT(v_int32x16,   int,      s32, si512, epi32, int)
+OPENCV_HAL_IMPL_AVX512_INIT(v_uint64x8,   uint64,   u64, si512, epi64, int64)
+OPENCV_HAL_IMPL_AVX512_INIT(v_int64x8,    int64,    s64, si512, epi64, int64)
+OPENCV_HAL_IMPL_AVX512_INIT(v_float32x16, float,    f32, ps,    ps,    float)
+OPENCV_HAL_IMPL_AVX512_INIT(v_float64x8,  double,   f64, pd,    pd,    double)
+
+#define OPENCV_HAL_IMPL_AVX512_CAST(_Tpvec, suffix, cast_si, cast_ps, cast_pd) \
+inline _Tpvec v_reinterpret_as_##suffix(const v_uint8x64& a)   { return _Tpvec(cast_si(a.val)); } \
+inline _Tpvec v_reinterpret_as_##suffix(const v_int8x64& a)    { return _Tpvec(cast_si(a.val)); } \
+inline _Tpvec v_reinterpret_as_##suffix(const v_uint16x32& a)  { return _Tpvec(cast_si(a.val)); } \
+inline _Tpvec v_reinterpret_as_##suffix(const v_int16x32& a)   { return _Tpvec(cast_si(a.val)); } \
+inline _Tpvec v_reinterpret_as_##suffix(const v_uint32x16& a)  { return _Tpvec(cast_si(a.val)); } \
+inline _Tpvec v_reinterpret_as_##suffix(const v_int32x16& a)   { return _Tpvec(cast_si(a.val)); } \
+inline _Tpvec v_reinterpret_as_##suffix(const v_uint64x8& a)   { return _Tpvec(cast_si(a.val)); } \
+inline _Tpvec v_reinterpret_as_##suffix(const v_int64x8& a)    { return _Tpvec(cast_si(a.val)); } \
+inline _Tpvec v_reinterpret_as_##suffix(const v_float32x16& a) { return _Tpvec(cast_ps(a.val)); } \
+inline _Tpvec v_reinterpret_as_##suffix(const v_float64x8& a)  { return _Tpvec(cast_pd(a.val)); }
+
+OPENCV_HAL_IMPL_AVX512_CAST(v_uint8x64,   u8,  OPENCV_HAL_NOP, _mm512_castps_si512, _mm512_castpd_si512)
+OPENCV_HAL_IMPL_AVX512_CAST(v_int8x64,    s8,  OPENCV_HAL_NOP, _mm512_castps_si512, _mm512_castpd_si512)
+OPENCV_HAL_IMPL_AVX512_CAST(v_uint16x32,  u16, OPENCV_HAL_NOP, _mm512_castps_si512, _mm512_castpd_si512)
+OPENCV_HAL_IMPL_AVX512_CAST(v_int16x32,   s16, OPENCV_HAL_NOP, _mm512_castps_si512, _mm512_castpd_si512)
+OPENCV_HAL_IMPL_AVX512_CAST(v_uint32x16,  u32, OPENCV_HAL_NOP, _mm512_castps_si512, _mm512_castpd_si512)
+OPENCV_HAL_IMPL_AVX512_CAST(v_int32x16,   s32, OPENCV_HAL_NOP, _mm512_castps_si512, _mm512_castpd_si512)
+OPENCV_HAL_IMPL_AVX512_CAST(v_uint64x8,   u64, OPENCV_HAL_NOP, _mm512_castps_si512, _mm512_castpd_si512)
+OPENCV_HAL_IMPL_AVX512_CAST(v_int64x8,    s64, OPENCV_HAL_NOP, _mm512_castps_si512, _mm512_castpd_si512)
+OPENCV_HAL_IMPL_AVX512_CAST(v_float32x16, f32, _mm512_castsi512_ps, OPENCV_HAL_NOP, _mm512_castpd_ps)
+OPENCV_HAL_IMPL_AVX512_CAST(v_float64x8,  f64, _mm512_castsi512_pd, _mm512_castps_pd, OPENCV_HAL_NOP)
+
+//////////////// Pack ///////////////
+
+inline v_uint8x64 v_pack(const v_uint16x32& a, const v_uint16x32& b)
+{ return v_uint8x64(_v512_combine(_mm512_cvtusepi16_epi8(a.val), _mm512_cvtusepi16_epi8(b.val))); }
+
+inline void v_pack_store(uchar* ptr, const v_uint16x32& a)
+{ _mm256_storeu_si256((__m256i*)ptr, _mm512_cvtusepi16_epi8(a.val)); }
+
+inline v_uint8x64 v_pack_u(const v_int16x32& a, const v_int16x32& b)
+{ return v_uint8x64(_v512_shuffle_odd_64(_mm512_packus_epi16(a.val, b.val))); }
+
+inline void v_pack_u_store(uchar* ptr, const v_int16x32& a)
+{ _mm256_storeu_si256((__m256i*)ptr, _mm512_cvtusepi16_epi8(_mm512_max_epi16(a.val, _mm512_setzero_si512()))); }
+
+inline v_int8x64 v_pack(const v_int16x32& a, const v_int16x32& b)
+{ return v_int8x64(_v512_combine(_mm512_cvtsepi16_epi8(a.val), _mm512_cvtsepi16_epi8(b.val))); }
+
+inline void v_pack_store(schar* ptr, const v_int16x32& a)
+{ _mm256_storeu_si256((__m256i*)ptr, _mm512_cvtsepi16_epi8(a.val)); }
+
+inline v_uint16x32 v_pack(const v_uint32x16& a, const v_uint32x16& b)
+{ return v_uint16x32(_v512_combine(_mm512_cvtusepi32_epi16(a.val), _mm512_cvtusepi32_epi16(b.val))); }
+
+inline void v_pack_store(ushort* ptr, const v_uint32x16& a)
+{ _mm256_storeu_si256((__m256i*)ptr, _mm512_cvtusepi32_epi16(a.val)); }
+
+inline v_uint16x32 v_pack_u(const v_int32x16& a, const v_int32x16& b)
+{ return v_uint16x32(_v512_shuffle_odd_64(_mm512_packus_epi32(a.val, b.val))); }
+
+inline void v_pack_u_store(ushort* ptr, const v_int32x16& a)
+{ _mm256_storeu_si256((__m256i*)ptr, _mm512_cvtusepi32_epi16(_mm512_max_epi32(a.val, _mm512_setzero_si512()))); }
+
+inline v_int16x32 v_pack(const v_int32x16& a, const v_int32x16& b)
+{ return v_int16x32(_v512_combine(_mm512_cvtsepi32_epi16(a.val), _mm512_cvtsepi32_epi16(b.val))); }
+
+inline void v_pack_store(short* ptr, const v_int32x16& a)
+{ _mm256_storeu_si256((__m256i*)ptr, _mm512_cvtsepi32_epi16(a.val)); }
+
+// the 64-bit lanes are truncated, like in the 128-bit version
+inline v_uint32x16 v_pack(const v_uint64x8& a, const v_uint64x8& b)
+{ return v_uint32x16(_v512_combine(_mm512_cvtepi64_epi32(a.val), _mm512_cvtepi64_epi32(b.val))); }
+
+inline void v_pack_store(unsigned* ptr, const v_uint64x8& a)
+{ _mm256_storeu_si256((__m256i*)ptr, _mm512_cvtepi64_epi32(a.val)); }
+
+inline v_int32x16 v_pack(const v_int64x8& a, const v_int64x8& b)
+{ return v_int32x16(_v512_combine(_mm512_cvtepi64_epi32(a.val), _mm512_cvtepi64_epi32(b.val))); }
+
+inline void v_pack_store(int* ptr, const v_int64x8& a)
+{ _mm256_storeu_si256((__m256i*)ptr, _mm512_cvtepi64_epi32(a.val)); }
+
+// rounding shift and pack, we assume that n > 0
+#define OPENCV_HAL_IMPL_AVX512_RSHR_PACK(_Tpvec, _Tp, _Tpwvec, add, shr, setall, _Tpd) \
+template<int n> inline \
+_Tpvec v_rshr_pack(const _Tpwvec& a, const _Tpwvec& b) \
+{ \
+    __m512i delta = setall((_Tpd)1 << (n-1)); \
+    return v_pack(_Tpwvec(shr(add(a.val, delta), n)), _Tpwvec(shr(add(b.val, delta), n))); \
+} \
+template<int n> inline \
+void v_rshr_pack_store(_Tp* ptr, const _Tpwvec& a) \
+{ \
+    __m512i delta = setall((_Tpd)1 << (n-1)); \
+    v_pack_store(ptr, _Tpwvec(shr(add(a.val, delta), n))); \
+}
+
+OPENCV_HAL_IMPL_AVX512_RSHR_PACK(v_uint8x64,  uchar,    v_uint16x32, _mm512_adds_epu16, _mm512_srli_epi16, _mm512_set1_epi16, short)
+OPENCV_HAL_IMPL_AVX512_RSHR_PACK(v_int8x64,   schar,    v_int16x32,  _mm512_adds_epi16, _mm512_srai_epi16, _mm512_set1_epi16, short)
+OPENCV_HAL_IMPL_AVX512_RSHR_PACK(v_uint16x32, ushort,   v_uint32x16, _mm512_add_epi32,  _mm512_srli_epi32, _mm512_set1_epi32, int)
+OPENCV_HAL_IMPL_AVX512_RSHR_PACK(v_int16x32,  short,    v_int32x16,  _mm512_add_epi32,  _mm512_srai_epi32, _mm512_set1_epi32, int)
+OPENCV_HAL_IMPL_AVX512_RSHR_PACK(v_uint32x16, unsigned, v_uint64x8,  _mm512_add_epi64,  _mm512_srli_epi64, _mm512_set1_epi64, int64)
+OPENCV_HAL_IMPL_AVX512_RSHR_PACK(v_int32x16,  int,      v_int64x8,   _mm512_add_epi64,  _mm512_srai_epi64, _mm512_set1_epi64, int64)
+
+#define OPENCV_HAL_IMPL_AVX512_RSHR_PACK_U(_Tpvec, _Tp, _Tpwvec, add, setall, _Tpd, bits) \
+template<int n> inline \
+_Tpvec v_rshr_pack_u(const _Tpwvec& a, const _Tpwvec& b) \
+{ \
+    __m512i delta = setall((_Tpd)1 << (n-1)); \
+    return v_pack_u(_Tpwvec(_mm512_srai_epi##bits(add(a.val, delta), n)), \
+                    _Tpwvec(_mm512_srai_epi##bits(add(b.val, delta), n))); \
+} \
+template<int n> inline \
+void v_rshr_pack_u_store(_Tp* ptr, const _Tpwvec& a) \
+{ \
+    __m512i delta = setall((_Tpd)1 << (n-1)); \
+    v_pack_u_store(ptr, _Tpwvec(_mm512_srai_epi##bits(add(a.val, delta), n))); \
+}
+
+OPENCV_HAL_IMPL_AVX512_RSHR_PACK_U(v_uint8x64,  uchar,  v_int16x32, _mm512_adds_epi16, _mm512_set1_epi16, short, 16)
+OPENCV_HAL_IMPL_AVX512_RSHR_PACK_U(v_uint16x32, ushort, v_int32x16, _mm512_add_epi32,  _mm512_set1_epi32, int,   32)
+
+//////////////// Arithmetic, bitwise and comparison operations ///////////////
+
+#define OPENCV_HAL_IMPL_AVX512_BIN_OP(bin_op, _Tpvec, intrin) \
+    inline _Tpvec operator bin_op (const _Tpvec& a, const _Tpvec& b) \
+    { return _Tpvec(intrin(a.val, b.val)); } \
+    inline _Tpvec& operator bin_op##= (_Tpvec& a, const _Tpvec& b) \
+    { a.val = intrin(a.val, b.val); return a; }
+
+OPENCV_HAL_IMPL_AVX512_BIN_OP(+, v_uint8x64,   _mm512_adds_epu8)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(-, v_uint8x64,   _mm512_subs_epu8)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(+, v_int8x64,    _mm512_adds_epi8)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(-, v_int8x64,    _mm512_subs_epi8)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(+, v_uint16x32,  _mm512_adds_epu16)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(-, v_uint16x32,  _mm512_subs_epu16)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(*, v_uint16x32,  _mm512_mullo_epi16)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(+, v_int16x32,   _mm512_adds_epi16)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(-, v_int16x32,   _mm512_subs_epi16)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(*, v_int16x32,   _mm512_mullo_epi16)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(+, v_uint32x16,  _mm512_add_epi32)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(-, v_uint32x16,  _mm512_sub_epi32)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(*, v_uint32x16,  _mm512_mullo_epi32)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(+, v_int32x16,   _mm512_add_epi32)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(-, v_int32x16,   _mm512_sub_epi32)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(*, v_int32x16,   _mm512_mullo_epi32)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(+, v_uint64x8,   _mm512_add_epi64)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(-, v_uint64x8,   _mm512_sub_epi64)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(+, v_int64x8,    _mm512_add_epi64)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(-, v_int64x8,    _mm512_sub_epi64)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(+, v_float32x16, _mm512_add_ps)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(-, v_float32x16, _mm512_sub_ps)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(*, v_float32x16, _mm512_mul_ps)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(/, v_float32x16, _mm512_div_ps)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(+, v_float64x8,  _mm512_add_pd)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(-, v_float64x8,  _mm512_sub_pd)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(*, v_float64x8,  _mm512_mul_pd)
+OPENCV_HAL_IMPL_AVX512_BIN_OP(/, v_float64x8,  _mm512_div_pd)
+
+inline void v_mul_expand(const v_int16x32& a, const v_int16x32& b,
+                         v_int32x16& c, v_int32x16& d)
+{
+    __m512i v0 = _mm512_mullo_epi16(a.val, b.val);
+    __m512i v1 = _mm512_mulhi_epi16(a.val, b.val);
+    _v512_interleave_lanes(_mm512_unpacklo_epi16(v0, v1), _mm512_unpackhi_epi16(v0, v1), c.val, d.val);
+}
+
+inline void v_mul_expand(const v_uint16x32& a, const v_uint16x32& b,
+                         v_uint32x16& c, v_uint32x16& d)
+{
+    __m512i v0 = _mm512_mullo_epi16(a.val, b.val);
+    __m512i v1 = _mm512_mulhi_epu16(a.val, b.val);
+    _v512_interleave_lanes(_mm512_unpacklo_epi16(v0, v1), _mm512_unpackhi_epi16(v0, v1), c.val, d.val);
+}
+
+inline void v_mul_expand(const v_uint32x16& a, const v_uint32x16& b,
+                         v_uint64x8& c, v_uint64x8& d)
+{
+    __m512i c0 = _mm512_mul_epu32(a.val, b.val);
+    __m512i c1 = _mm512_mul_epu32(_mm512_srli_epi64(a.val, 32), _mm512_srli_epi64(b.val, 32));
+    _v512_interleave_lanes(_mm512_unpacklo_epi64(c0, c1), _mm512_unpackhi_epi64(c0, c1), c.val, d.val);
+}
+
+inline v_int32x16 v_dotprod(const v_int16x32& a, const v_int16x32& b)
+{ return v_int32x16(_mm512_madd_epi16(a.val, b.val)); }
+
+// AVX-512F has no floating-point bitwise operations, the integer ones are used for all the types
+#define OPENCV_HAL_IMPL_AVX512_LOGIC_OP(_Tpvec, cast_to, cast_from) \
+    inline _Tpvec operator & (const _Tpvec& a, const _Tpvec& b) \
+    { return _Tpvec(cast_to(_mm512_and_si512(cast_from(a.val), cast_from(b.val)))); } \
+    inline _Tpvec operator | (const _Tpvec& a, const _Tpvec& b) \
+    { return _Tpvec(cast_to(_mm512_or_si512(cast_from(a.val), cast_from(b.val)))); } \
+    inline _Tpvec operator ^ (const _Tpvec& a, const _Tpvec& b) \
+    { return _Tpvec(cast_to(_mm512_xor_si512(cast_from(a.val), cast_from(b.val)))); } \
+    inline _Tpvec& operator &= (_Tpvec& a, const _Tpvec& b) \
+    { a = a & b; return a; } \
+    inline _Tpvec& operator |= (_Tpvec& a, const _Tpvec& b) \
+    { a = a | b; return a; } \
+    inline _Tpvec& operator ^= (_Tpvec& a, const _Tpvec& b) \
+    { a = a ^ b; return a; } \
+    inline _Tpvec operator ~ (const _Tpvec& a) \
+    { return _Tpvec(cast_to(_mm512_ternarylogic_epi32(cast_from(a.val), cast_from(a.val), cast_from(a.val), 0x55))); }
+
+OPENCV_HAL_IMPL_AVX512_LOGIC_OP(v_uint8x64,   OPENCV_HAL_NOP, OPENCV_HAL_NOP)
+OPENCV_HAL_IMPL_AVX512_LOGIC_OP(v_int8x64,    OPENCV_HAL_NOP, OPENCV_HAL_NOP)
+OPENCV_HAL_IMPL_AVX512_LOGIC_OP(v_uint16x32,  OPENCV_HAL_NOP, OPENCV_HAL_NOP)
+OPENCV_HAL_IMPL_AVX512_LOGIC_OP(v_int16x32,   OPENCV_HAL_NOP, OPENCV_HAL_NOP)
+OPENCV_HAL_IMPL_AVX512_LOGIC_OP(v_uint32x16,  OPENCV_HAL_NOP, OPENCV_HAL_NOP)
+OPENCV_HAL_IMPL_AVX512_LOGIC_OP(v_int32x16,   OPENCV_HAL_NOP, OPENCV_HAL_NOP)
+OPENCV_HAL_IMPL_AVX512_LOGIC_OP(v_uint64x8,   OPENCV_HAL_NOP, OPENCV_HAL_NOP)
+OPENCV_HAL_IMPL_AVX512_LOGIC_OP(v_int64x8,    OPENCV_HAL_NOP, OPENCV_HAL_NOP)
+OPENCV_HAL_IMPL_AVX512_LOGIC_OP(v_float32x16, _mm512_castsi512_ps, _mm512_castps_si512)
+OPENCV_HAL_IMPL_AVX512_LOGIC_OP(v_float64x8,  _mm512_castsi512_pd, _mm512_castpd_si512)
+
+inline v_float32x16 v_sqrt(const v_float32x16& x)
+{ return v_float32x16(_mm512_sqrt_ps(x.val)); }
+
+inline v_float32x16 v_invsqrt(const v_float32x16& x)
+{
+    const __m512 _0_5 = _mm512_set1_ps(0.5f), _1_5 = _mm512_set1_ps(1.5f);
+    __m512 t = x.val;
+    __m512 h = _mm512_mul_ps(t, _0_5);
+    t = _mm512_rsqrt14_ps(t);
+    t = _mm512_mul_ps(t, _mm512_sub_ps(_1_5, _mm512_mul_ps(_mm512_mul_ps(t, t), h)));
+    return v_float32x16(t);
+}
+
+inline v_float64x8 v_sqrt(const v_float64x8& x)
+{ return v_float64x8(_mm512_sqrt_pd(x.val)); }
+
+inline v_float64x8 v_invsqrt(const v_float64x8& x)
+{ return v_float64x8(_mm512_div_pd(_mm512_set1_pd(1.), _mm512_sqrt_pd(x.val))); }
+
+inline v_float32x16 v_abs(const v_float32x16& x)
+{ return v_float32x16(_mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(x.val), _mm512_set1_epi32(0x7fffffff)))); }
+
+inline v_float64x8 v_abs(const v_float64x8& x)
+{ return v_float64x8(_mm512_castsi512_pd(_mm512_and_si512(_mm512_castpd_si512(x.val), _mm512_set1_epi64(0x7fffffffffffffffLL)))); }
+
+#define OPENCV_HAL_IMPL_AVX512_BIN_FUNC(_Tpvec, func, intrin) \
+inline _Tpvec func(const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(intrin(a.val, b.val)); }
+
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_uint8x64,   v_min, _mm512_min_epu8)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_uint8x64,   v_max, _mm512_max_epu8)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_int8x64,    v_min, _mm512_min_epi8)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_int8x64,    v_max, _mm512_max_epi8)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_uint16x32,  v_min, _mm512_min_epu16)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_uint16x32,  v_max, _mm512_max_epu16)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_int16x32,   v_min, _mm512_min_epi16)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_int16x32,   v_max, _mm512_max_epi16)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_uint32x16,  v_min, _mm512_min_epu32)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_uint32x16,  v_max, _mm512_max_epu32)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_int32x16,   v_min, _mm512_min_epi32)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_int32x16,   v_max, _mm512_max_epi32)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_float32x16, v_min, _mm512_min_ps)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_float32x16, v_max, _mm512_max_ps)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_float64x8,  v_min, _mm512_min_pd)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_float64x8,  v_max, _mm512_max_pd)
+
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_uint8x64,   v_add_wrap, _mm512_add_epi8)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_int8x64,    v_add_wrap, _mm512_add_epi8)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_uint16x32,  v_add_wrap, _mm512_add_epi16)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_int16x32,   v_add_wrap, _mm512_add_epi16)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_uint8x64,   v_sub_wrap, _mm512_sub_epi8)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_int8x64,    v_sub_wrap, _mm512_sub_epi8)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_uint16x32,  v_sub_wrap, _mm512_sub_epi16)
+OPENCV_HAL_IMPL_AVX512_BIN_FUNC(v_int16x32,   v_sub_wrap, _mm512_sub_epi16)
+
+#define OPENCV_HAL_IMPL_AVX512_CMP_OP(_Tpvec, cmp, tomask) \
+inline _Tpvec operator == (const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(tomask(cmp(a.val, b.val, _MM_CMPINT_EQ))); } \
+inline _Tpvec operator != (const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(tomask(cmp(a.val, b.val, _MM_CMPINT_NE))); } \
+inline _Tpvec operator < (const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(tomask(cmp(a.val, b.val, _MM_CMPINT_LT))); } \
+inline _Tpvec operator > (const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(tomask(cmp(a.val, b.val, _MM_CMPINT_NLE))); } \
+inline _Tpvec operator <= (const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(tomask(cmp(a.val, b.val, _MM_CMPINT_LE))); } \
+inline _Tpvec operator >= (const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(tomask(cmp(a.val, b.val, _MM_CMPINT_NLT))); }
+
+OPENCV_HAL_IMPL_AVX512_CMP_OP(v_uint8x64,  _mm512_cmp_epu8_mask,  _v512_mask8)
+OPENCV_HAL_IMPL_AVX512_CMP_OP(v_int8x64,   _mm512_cmp_epi8_mask,  _v512_mask8)
+OPENCV_HAL_IMPL_AVX512_CMP_OP(v_uint16x32, _mm512_cmp_epu16_mask, _v512_mask16)
+OPENCV_HAL_IMPL_AVX512_CMP_OP(v_int16x32,  _mm512_cmp_epi16_mask, _v512_mask16)
+OPENCV_HAL_IMPL_AVX512_CMP_OP(v_uint32x16, _mm512_cmp_epu32_mask, _v512_mask32)
+OPENCV_HAL_IMPL_AVX512_CMP_OP(v_int32x16,  _mm512_cmp_epi32_mask, _v512_mask32)
+
+#define OPENCV_HAL_IMPL_AVX512_FLT_CMP_OP(_Tpvec, suffix, tomask, cast) \
+inline _Tpvec operator == (const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(cast(tomask(_mm512_cmp_##suffix##_mask(a.val, b.val, _CMP_EQ_OQ)))); } \
+inline _Tpvec operator != (const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(cast(tomask(_mm512_cmp_##suffix##_mask(a.val, b.val, _CMP_NEQ_UQ)))); } \
+inline _Tpvec operator < (const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(cast(tomask(_mm512_cmp_##suffix##_mask(a.val, b.val, _CMP_LT_OQ)))); } \
+inline _Tpvec operator > (const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(cast(tomask(_mm512_cmp_##suffix##_mask(a.val, b.val, _CMP_GT_OQ)))); } \
+inline _Tpvec operator <= (const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(cast(tomask(_mm512_cmp_##suffix##_mask(a.val, b.val, _CMP_LE_OQ)))); } \
+inline _Tpvec operator >= (const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(cast(tomask(_mm512_cmp_##suffix##_mask(a.val, b.val, _CMP_GE_OQ)))); }
+
+OPENCV_HAL_IMPL_AVX512_FLT_CMP_OP(v_float32x16, ps, _v512_mask32, _mm512_castsi512_ps)
+OPENCV_HAL_IMPL_AVX512_FLT_CMP_OP(v_float64x8,  pd, _v512_mask64, _mm512_castsi512_pd)
+
+#define OPENCV_HAL_IMPL_AVX512_ABSDIFF_8_16(_Tpuvec, _Tpsvec, bits) \
+inline _Tpuvec v_absdiff(const _Tpuvec& a, const _Tpuvec& b) \
+{ return _Tpuvec(_mm512_add_epi##bits(_mm512_subs_epu##bits(a.val, b.val), _mm512_subs_epu##bits(b.val, a.val))); } \
+inline _Tpuvec v_absdiff(const _Tpsvec& a, const _Tpsvec& b) \
+{ return _Tpuvec(_mm512_sub_epi##bits(_mm512_max_epi##bits(a.val, b.val), _mm512_min_epi##bits(a.val, b.val))); }
+
+OPENCV_HAL_IMPL_AVX512_ABSDIFF_8_16(v_uint8x64,  v_int8x64,  8)
+OPENCV_HAL_IMPL_AVX512_ABSDIFF_8_16(v_uint16x32, v_int16x32, 16)
+
+inline v_uint32x16 v_absdiff(const v_uint32x16& a, const v_uint32x16& b)
+{ return v_max(a, b) - v_min(a, b); }
+
+inline v_uint32x16 v_absdiff(const v_int32x16& a, const v_int32x16& b)
+{ return v_uint32x16(_mm512_sub_epi32(_mm512_max_epi32(a.val, b.val), _mm512_min_epi32(a.val, b.val))); }
+
+#define OPENCV_HAL_IMPL_AVX512_MISC_FLT_OP(_Tpvec, suffix) \
+inline _Tpvec v_absdiff(const _Tpvec& a, const _Tpvec& b) \
+{ return v_abs(a - b); } \
+inline _Tpvec v_magnitude(const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(_mm512_sqrt_##suffix(_mm512_fmadd_##suffix(a.val, a.val, _mm512_mul_##suffix(b.val, b.val)))); } \
+inline _Tpvec v_sqr_magnitude(const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(_mm512_fmadd_##suffix(a.val, a.val, _mm512_mul_##suffix(b.val, b.val))); } \
+inline _Tpvec v_muladd(const _Tpvec& a, const _Tpvec& b, const _Tpvec& c) \
+{ return _Tpvec(_mm512_fmadd_##suffix(a.val, b.val, c.val)); }
+
+OPENCV_HAL_IMPL_AVX512_MISC_FLT_OP(v_float32x16, ps)
+OPENCV_HAL_IMPL_AVX512_MISC_FLT_OP(v_float64x8,  pd)
+
+#define OPENCV_HAL_IMPL_AVX512_SHIFT_OP(_Tpuvec, _Tpsvec, suffix) \
+inline _Tpuvec operator << (const _Tpuvec& a, int imm) \
+{ return _Tpuvec(_mm512_slli_##suffix(a.val, imm)); } \
+inline _Tpsvec operator << (const _Tpsvec& a, int imm) \
+{ return _Tpsvec(_mm512_slli_##suffix(a.val, imm)); } \
+inline _Tpuvec operator >> (const _Tpuvec& a, int imm) \
+{ return _Tpuvec(_mm512_srli_##suffix(a.val, imm)); } \
+inline _Tpsvec operator >> (const _Tpsvec& a, int imm) \
+{ return _Tpsvec(_mm512_srai_##suffix(a.val, imm)); } \
+template<int imm> \
+inline _Tpuvec v_shl(const _Tpuvec& a) \
+{ return _Tpuvec(_mm512_slli_##suffix(a.val, imm)); } \
+template<int imm> \
+inline _Tpsvec v_shl(const _Tpsvec& a) \
+{ return _Tpsvec(_mm512_slli_##suffix(a.val, imm)); } \
+template<int imm> \
+inline _Tpuvec v_shr(const _Tpuvec& a) \
+{ return _Tpuvec(_mm512_srli_##suffix(a.val, imm)); } \
+template<int imm> \
+inline _Tpsvec v_shr(const _Tpsvec& a) \
+{ return _Tpsvec(_mm512_srai_##suffix(a.val, imm)); }
+
+OPENCV_HAL_IMPL_AVX512_SHIFT_OP(v_uint16x32, v_int16x32, epi16)
+OPENCV_HAL_IMPL_AVX512_SHIFT_OP(v_uint32x16, v_int32x16, epi32)
+OPENCV_HAL_IMPL_AVX512_SHIFT_OP(v_uint64x8,  v_int64x8,  epi64)
+
+//////////////// Reductions, masks and selection ///////////////
+
+inline unsigned v_reduce_sum(const v_uint32x16& a) { return (unsigned)_mm512_reduce_add_epi32(a.val); }
+inline unsigned v_reduce_max(const v_uint32x16& a) { return _mm512_reduce_max_epu32(a.val); }
+inline unsigned v_reduce_min(const v_uint32x16& a) { return _mm512_reduce_min_epu32(a.val); }
+inline int v_reduce_sum(const v_int32x16& a) { return _mm512_reduce_add_epi32(a.val); }
+inline int v_reduce_max(const v_int32x16& a) { return _mm512_reduce_max_epi32(a.val); }
+inline int v_reduce_min(const v_int32x16& a) { return _mm512_reduce_min_epi32(a.val); }
+inline float v_reduce_sum(const v_float32x16& a) { return _mm512_reduce_add_ps(a.val); }
+inline float v_reduce_max(const v_float32x16& a) { return _mm512_reduce_max_ps(a.val); }
+inline float v_reduce_min(const v_float32x16& a) { return _mm512_reduce_min_ps(a.val); }
+
+// there are 64 lanes in the 8-bit vectors, so they have no v_signmask
+inline int v_signmask(const v_uint16x32& a) { return (int)_mm512_movepi16_mask(a.val); }
+inline int v_signmask(const v_int16x32& a) { return (int)_mm512_movepi16_mask(a.val); }
+inline int v_signmask(const v_uint32x16& a) { return (int)_mm512_cmplt_epi32_mask(a.val, _mm512_setzero_si512()); }
+inline int v_signmask(const v_int32x16& a) { return (int)_mm512_cmplt_epi32_mask(a.val, _mm512_setzero_si512()); }
+inline int v_signmask(const v_float32x16& a)
+{ return (int)_mm512_cmplt_epi32_mask(_mm512_castps_si512(a.val), _mm512_setzero_si512()); }
+inline int v_signmask(const v_float64x8& a)
+{ return (int)_mm512_cmplt_epi64_mask(_mm512_castpd_si512(a.val), _mm512_setzero_si512()); }
+
+#define OPENCV_HAL_IMPL_AVX512_CHECK(_Tpvec, movemask, cast, allmask) \
+inline bool v_check_all(const _Tpvec& a) \
+{ return movemask(cast(a.val)) == allmask; } \
+inline bool v_check_any(const _Tpvec& a) \
+{ return movemask(cast(a.val)) != 0; }
+
+inline __mmask16 _v512_movemask32(const __m512i& a) { return _mm512_cmplt_epi32_mask(a, _mm512_setzero_si512()); }
+inline __mmask8 _v512_movemask64(const __m512i& a) { return _mm512_cmplt_epi64_mask(a, _mm512_setzero_si512()); }
+
+OPENCV_HAL_IMPL_AVX512_CHECK(v_uint8x64,   _mm512_movepi8_mask,  OPENCV_HAL_NOP, (__mmask64)-1)
+OPENCV_HAL_IMPL_AVX512_CHECK(v_int8x64,    _mm512_movepi8_mask,  OPENCV_HAL_NOP, (__mmask64)-1)
+OPENCV_HAL_IMPL_AVX512_CHECK(v_uint16x32,  _mm512_movepi16_mask, OPENCV_HAL_NOP, (__mmask32)-1)
+OPENCV_HAL_IMPL_AVX512_CHECK(v_int16x32,   _mm512_movepi16_mask, OPENCV_HAL_NOP, (__mmask32)-1)
+OPENCV_HAL_IMPL_AVX512_CHECK(v_uint32x16,  _v512_movemask32, OPENCV_HAL_NOP, (__mmask16)-1)
+OPENCV_HAL_IMPL_AVX512_CHECK(v_int32x16,   _v512_movemask32, OPENCV_HAL_NOP, (__mmask16)-1)
+OPENCV_HAL_IMPL_AVX512_CHECK(v_float32x16, _v512_movemask32, _mm512_castps_si512, (__mmask16)-1)
+OPENCV_HAL_IMPL_AVX512_CHECK(v_float64x8,  _v512_movemask64, _mm512_castpd_si512, (__mmask8)-1)
+
+// bitwise (mask ? a : b), the mask lanes are expected to be all zeros or all ones
+#define OPENCV_HAL_IMPL_AVX512_SELECT(_Tpvec, cast_to, cast_from) \
+inline _Tpvec v_select(const _Tpvec& mask, const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(cast_to(_mm512_ternarylogic_epi32(cast_from(mask.val), cast_from(a.val), cast_from(b.val), 0xca))); }
+
+OPENCV_HAL_IMPL_AVX512_SELECT(v_uint8x64,   OPENCV_HAL_NOP, OPENCV_HAL_NOP)
+OPENCV_HAL_IMPL_AVX512_SELECT(v_int8x64,    OPENCV_HAL_NOP, OPENCV_HAL_NOP)
+OPENCV_HAL_IMPL_AVX512_SELECT(v_uint16x32,  OPENCV_HAL_NOP, OPENCV_HAL_NOP)
+OPENCV_HAL_IMPL_AVX512_SELECT(v_int16x32,   OPENCV_HAL_NOP, OPENCV_HAL_NOP)
+OPENCV_HAL_IMPL_AVX512_SELECT(v_uint32x16,  OPENCV_HAL_NOP, OPENCV_HAL_NOP)
+OPENCV_HAL_IMPL_AVX512_SELECT(v_int32x16,   OPENCV_HAL_NOP, OPENCV_HAL_NOP)
+OPENCV_HAL_IMPL_AVX512_SELECT(v_float32x16, _mm512_castsi512_ps, _mm512_castps_si512)
+OPENCV_HAL_IMPL_AVX512_SELECT(v_float64x8,  _mm512_castsi512_pd, _mm512_castpd_si512)
+
+//////////////// Expand, zip and combine ///////////////
+
+#define OPENCV_HAL_IMPL_AVX512_EXPAND(_Tpvec, _Tpwvec, _Tp, intrin) \
+inline void v_expand(const _Tpvec& a, _Tpwvec& b0, _Tpwvec& b1) \
+{ \
+    b0.val = intrin(_v512_extract_low(a.val)); \
+    b1.val = intrin(_v512_extract_high(a.val)); \
+} \
+inline _Tpwvec v512_load_expand(const _Tp* ptr) \
+{ return _Tpwvec(intrin(_mm256_loadu_si256((const __m256i*)ptr))); }
+
+OPENCV_HAL_IMPL_AVX512_EXPAND(v_uint8x64,  v_uint16x32, uchar,    _mm512_cvtepu8_epi16)
+OPENCV_HAL_IMPL_AVX512_EXPAND(v_int8x64,   v_int16x32,  schar,    _mm512_cvtepi8_epi16)
+OPENCV_HAL_IMPL_AVX512_EXPAND(v_uint16x32, v_uint32x16, ushort,   _mm512_cvtepu16_epi32)
+OPENCV_HAL_IMPL_AVX512_EXPAND(v_int16x32,  v_int32x16,  short,    _mm512_cvtepi16_epi32)
+OPENCV_HAL_IMPL_AVX512_EXPAND(v_uint32x16, v_uint64x8,  unsigned, _mm512_cvtepu32_epi64)
+OPENCV_HAL_IMPL_AVX512_EXPAND(v_int32x16,  v_int64x8,   int,      _mm512_cvtepi32_epi64)
+
+inline v_uint32x16 v512_load_expand_q(const uchar* ptr)
+{ return v_uint32x16(_mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i*)ptr))); }
+
+inline v_int32x16 v512_load_expand_q(const schar* ptr)
+{ return v_int32x16(_mm512_cvtepi8_epi32(_mm_loadu_si128((const __m128i*)ptr))); }
+
+#define OPENCV_HAL_IMPL_AVX512_UNPACKS(_Tpvec, suffix, cast_to, cast_from) \
+inline void v_zip(const _Tpvec& a0, const _Tpvec& a1, _Tpvec& b0, _Tpvec& b1) \
+{ \
+    __m512i lo = cast_from(_mm512_unpacklo_##suffix(a0.val, a1.val)); \
+    __m512i hi = cast_from(_mm512_unpackhi_##suffix(a0.val, a1.val)); \
+    __m512i r0, r1; \
+    _v512_interleave_lanes(lo, hi, r0, r1); \
+    b0.val = cast_to(r0); \
+    b1.val = cast_to(r1); \
+} \
+inline _Tpvec v_combine_low(const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(cast_to(_mm512_shuffle_i64x2(cast_from(a.val), cast_from(b.val), 0x44))); } \
+inline _Tpvec v_combine_high(const _Tpvec& a, const _Tpvec& b) \
+{ return _Tpvec(cast_to(_mm512_shuffle_i64x2(cast_from(a.val), cast_from(b.val), 0xee))); } \
+inline void v_recombine(const _Tpvec& a, const _Tpvec& b, _Tpvec& c, _Tpvec& d) \
+{ \
+    c = v_combine_low(a, b); \
+    d = v_combine_high(a, b); \
+}
+
+OPENCV_HAL_IMPL_AVX512_UNPACKS(v_uint8x64,   epi8,  OPENCV_HAL_NOP, OPENCV_HAL_NOP)
+OPENCV_HAL_IMPL_AVX512_UNPACKS(v_int8x64,    epi8,  OPENCV_HAL_NOP, OPENCV_HAL_NOP)
+OPENCV_HAL_IMPL_AVX512_UNPACKS(v_uint16x32,  epi16, OPENCV_HAL_NOP, OPENCV_HAL_NOP)
+OPENCV_HAL_IMPL_AVX512_UNPACKS(v_int16x32,   epi16, OPENCV_HAL_NOP, OPENCV_HAL_NOP)
+OPENCV_HAL_IMPL_AVX512_UNPACKS(v_uint32x16,  epi32, OPENCV_HAL_NOP, OPENCV_HAL_NOP)
+OPENCV_HAL_IMPL_AVX512_UNPACKS(v_int32x16,   epi32, OPENCV_HAL_NOP, OPENCV_HAL_NOP)
+OPENCV_HAL_IMPL_AVX512_UNPACKS(v_float32x16, ps,    _mm512_castsi512_ps, _mm512_castps_si512)
+OPENCV_HAL_IMPL_AVX512_UNPACKS(v_float64x8,  pd,    _mm512_castsi512_pd, _mm512_castpd_si512)
+
+//////////////// Conversions ///////////////
+
+inline v_int32x16 v_round(const v_float32x16& a)
+{ return v_int32x16(_mm512_cvtps_epi32(a.val)); }
+
+inline v_int32x16 v_floor(const v_float32x16& a)
+{ return v_int32x16(_mm512_cvt_roundps_epi32(a.val, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)); }
+
+inline v_int32x16 v_ceil(const v_float32x16& a)
+{ return v_int32x16(_mm512_cvt_roundps_epi32(a.val, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC)); }
+
+inline v_int32x16 v_trunc(const v_float32x16& a)
+{ return v_int32x16(_mm512_cvttps_epi32(a.val)); }
+
+// the double precision conversions fill the lower half of the result, like the 128-bit ones do
+inline v_int32x16 v_round(const v_float64x8& a)
+{ return v_int32x16(_mm512_inserti64x4(_mm512_setzero_si512(), _mm512_cvtpd_epi32(a.val), 0)); }
+
+inline v_int32x16 v_floor(const v_float64x8& a)
+{
+    return v_int32x16(_mm512_inserti64x4(_mm512_setzero_si512(),
+        _mm512_cvt_roundpd_epi32(a.val, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC), 0));
+}
+
+inline v_int32x16 v_ceil(const v_float64x8& a)
+{
+    return v_int32x16(_mm512_inserti64x4(_mm512_setzero_si512(),
+        _mm512_cvt_roundpd_epi32(a.val, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC), 0));
+}
+
+inline v_int32x16 v_trunc(const v_float64x8& a)
+{ return v_int32x16(_mm512_inserti64x4(_mm512_setzero_si512(), _mm512_cvttpd_epi32(a.val), 0)); }
+
+inline v_float32x16 v_cvt_f32(const v_int32x16& a)
+{ return v_float32x16(_mm512_cvtepi32_ps(a.val)); }
+
+inline v_float32x16 v_cvt_f32(const v_float64x8& a)
+{ return v_float32x16(_v512_combine(_mm512_cvtpd_ps(a.val), _mm256_setzero_ps())); }
+
+inline v_float64x8 v_cvt_f64(const v_int32x16& a)
+{ return v_float64x8(_mm512_cvtepi32_pd(_v512_extract_low(a.val))); }
+
+inline v_float64x8 v_cvt_f64(const v_float32x16& a)
+{ return v_float64x8(_mm512_cvtps_pd(_v512_extract_low(a.val))); }
+
+// (de)interleaving is done with the 256-bit halves
+#define OPENCV_HAL_IMPL_AVX512_LOADSTORE_INTERLEAVE(_Tpvec, _Tp, _Tpvec256) \
+inline void v_load_deinterleave(const _Tp* ptr, _Tpvec& a, _Tpvec& b) \
+{ \
+    _Tpvec256 a0, b0, a1, b1; \
+    v_load_deinterleave(ptr, a0, b0); \
+    v_load_deinterleave(ptr + _Tpvec256::nlanes*2, a1, b1); \
+    a = v512_combine(a0, a1); b = v512_combine(b0, b1); \
+} \
+inline void v_load_deinterleave(const _Tp* ptr, _Tpvec& a, _Tpvec& b, _Tpvec& c) \
+{ \
+    _Tpvec256 a0, b0, c0, a1, b1, c1; \
+    v_load_deinterleave(ptr, a0, b0, c0); \
+    v_load_deinterleave(ptr + _Tpvec256::nlanes*3, a1, b1, c1); \
+    a = v512_combine(a0, a1); b = v512_combine(b0, b1); c = v512_combine(c0, c1); \
+} \
+inline void v_load_deinterleave(const _Tp* ptr, _Tpvec& a, _Tpvec& b, _Tpvec& c, _Tpvec& d) \
+{ \
+    _Tpvec256 a0, b0, c0, d0, a1, b1, c1, d1; \
+    v_load_deinterleave(ptr, a0, b0, c0, d0); \
+    v_load_deinterleave(ptr + _Tpvec256::nlanes*4, a1, b1, c1, d1); \
+    a = v512_combine(a0, a1); b = v512_combine(b0, b1); c = v512_combine(c0, c1); d = v512_combine(d0, d1); \
+} \
+inline void v_store_interleave(_Tp* ptr, const _Tpvec& a, const _Tpvec& b) \
+{ \
+    v_store_interleave(ptr, v_get_low(a), v_get_low(b)); \
+    v_store_interleave(ptr + _Tpvec256::nlanes*2, v_get_high(a), v_get_high(b)); \
+} \
+inline void v_store_interleave(_Tp* ptr, const _Tpvec& a, const _Tpvec& b, const _Tpvec& c) \
+{ \
+    v_store_interleave(ptr, v_get_low(a), v_get_low(b), v_get_low(c)); \
+    v_store_interleave(ptr + _Tpvec256::nlanes*3, v_get_high(a), v_get_high(b), v_get_high(c)); \
+} \
+inline void v_store_interleave(_Tp* ptr, const _Tpvec& a, const _Tpvec& b, const _Tpvec& c, const _Tpvec& d) \
+{ \
+    v_store_interleave(ptr, v_get_low(a), v_get_low(b), v_get_low(c), v_get_low(d)); \
+    v_store_interleave(ptr + _Tpvec256::nlanes*4, v_get_high(a), v_get_high(b), v_get_high(c), v_get_high(d)); \
+}
+
+OPENCV_HAL_IMPL_AVX512_LOADSTORE_INTERLEAVE(v_uint8x64, uchar, v_uint8x32)
+OPENCV_HAL_IMPL_AVX512_LOADSTORE_INTERLEAVE(v_int8x64, schar, v_int8x32)
+OPENCV_HAL_IMPL_AVX512_LOADSTORE_INTERLEAVE(v_uint16x32, ushort, v_uint16x16)
+OPENCV_HAL_IMPL_AVX512_LOADSTORE_INTERLEAVE(v_int16x32, short, v_int16x16)
+OPENCV_HAL_IMPL_AVX512_LOADSTORE_INTERLEAVE(v_uint32x16, unsigned, v_uint32x8)
+OPENCV_HAL_IMPL_AVX512_LOADSTORE_INTERLEAVE(v_int32x16, int, v_int32x8)
+OPENCV_HAL_IMPL_AVX512_LOADSTORE_INTERLEAVE(v_float32x16, float, v_float32x8)
+
+CV_CPU_OPTIMIZATION_HAL_NAMESPACE_END
+
+//! @endcond
+
+}
+
+#endif
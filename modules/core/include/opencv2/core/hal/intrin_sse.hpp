@@ -53,6 +53,8 @@
 namespace cv
 {
 
+CV_CPU_OPTIMIZATION_HAL_NAMESPACE_BEGIN
+
 //! @cond IGNORED
 
 struct v_uint8x16
@@ -362,7 +364,7 @@ void v_rshr_pack_u_store(uchar* ptr, const v_int16x8& a)
 inline v_int8x16 v_pack(const v_int16x8& a, const v_int16x8& b)
 { return v_int8x16(_mm_packs_epi16(a.val, b.val)); }
 
-inline void v_pack_store(schar* ptr, v_int16x8& a)
+inline void v_pack_store(schar* ptr, const v_int16x8& a)
 { _mm_storel_epi64((__m128i*)ptr, _mm_packs_epi16(a.val, a.val)); }
 
 template<int n> inline
@@ -1255,6 +1257,40 @@ OPENCV_HAL_IMPL_SSE_TRANSPOSE4x4(v_uint32x4, epi32, OPENCV_HAL_NOP, OPENCV_HAL_N
 OPENCV_HAL_IMPL_SSE_TRANSPOSE4x4(v_int32x4, epi32, OPENCV_HAL_NOP, OPENCV_HAL_NOP)
 OPENCV_HAL_IMPL_SSE_TRANSPOSE4x4(v_float32x4, ps, _mm_castps_si128, _mm_castsi128_ps)
 
+inline void v_load_deinterleave(const uchar* ptr, v_uint8x16& a, v_uint8x16& b)
+{
+    __m128i t0 = _mm_loadu_si128((const __m128i*)ptr);        // a0 b0 a1 b1 ...
+    __m128i t1 = _mm_loadu_si128((const __m128i*)(ptr + 16)); // a8 b8 a9 b9 ...
+    __m128i mask = _mm_set1_epi16(255);
+
+    a.val = _mm_packus_epi16(_mm_and_si128(t0, mask), _mm_and_si128(t1, mask));
+    b.val = _mm_packus_epi16(_mm_srli_epi16(t0, 8), _mm_srli_epi16(t1, 8));
+}
+
+inline void v_load_deinterleave(const ushort* ptr, v_uint16x8& a, v_uint16x8& b)
+{
+    __m128i t0 = _mm_loadu_si128((const __m128i*)ptr);       // a0 b0 a1 b1 a2 b2 a3 b3
+    __m128i t1 = _mm_loadu_si128((const __m128i*)(ptr + 8)); // a4 b4 a5 b5 a6 b6 a7 b7
+
+    __m128i u0 = _mm_unpacklo_epi16(t0, t1); // a0 a4 b0 b4 a1 a5 b1 b5
+    __m128i u1 = _mm_unpackhi_epi16(t0, t1); // a2 a6 b2 b6 a3 a7 b3 b7
+
+    __m128i v0 = _mm_unpacklo_epi16(u0, u1); // a0 a2 a4 a6 b0 b2 b4 b6
+    __m128i v1 = _mm_unpackhi_epi16(u0, u1); // a1 a3 a5 a7 b1 b3 b5 b7
+
+    a.val = _mm_unpacklo_epi16(v0, v1);
+    b.val = _mm_unpackhi_epi16(v0, v1);
+}
+
+inline void v_load_deinterleave(const unsigned* ptr, v_uint32x4& a, v_uint32x4& b)
+{
+    __m128 t0 = _mm_loadu_ps((const float*)ptr);       // a0 b0 a1 b1
+    __m128 t1 = _mm_loadu_ps((const float*)(ptr + 4)); // a2 b2 a3 b3
+
+    a.val = _mm_castps_si128(_mm_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 2, 0)));
+    b.val = _mm_castps_si128(_mm_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 1, 3, 1)));
+}
+
 // adopted from sse_utils.hpp
 inline void v_load_deinterleave(const uchar* ptr, v_uint8x16& a, v_uint8x16& b, v_uint8x16& c)
 {
@@ -1374,6 +1410,24 @@ inline void v_load_deinterleave(const unsigned* ptr, v_uint32x4& a, v_uint32x4&
     v_transpose4x4(u0, u1, u2, u3, a, b, c, d);
 }
 
+inline void v_store_interleave( uchar* ptr, const v_uint8x16& a, const v_uint8x16& b )
+{
+    _mm_storeu_si128((__m128i*)ptr, _mm_unpacklo_epi8(a.val, b.val));
+    _mm_storeu_si128((__m128i*)(ptr + 16), _mm_unpackhi_epi8(a.val, b.val));
+}
+
+inline void v_store_interleave( ushort* ptr, const v_uint16x8& a, const v_uint16x8& b )
+{
+    _mm_storeu_si128((__m128i*)ptr, _mm_unpacklo_epi16(a.val, b.val));
+    _mm_storeu_si128((__m128i*)(ptr + 8), _mm_unpackhi_epi16(a.val, b.val));
+}
+
+inline void v_store_interleave( unsigned* ptr, const v_uint32x4& a, const v_uint32x4& b )
+{
+    _mm_storeu_si128((__m128i*)ptr, _mm_unpacklo_epi32(a.val, b.val));
+    _mm_storeu_si128((__m128i*)(ptr + 4), _mm_unpackhi_epi32(a.val, b.val));
+}
+
 inline void v_store_interleave( uchar* ptr, const v_uint8x16& a, const v_uint8x16& b,
                                 const v_uint8x16& c )
 {
@@ -1530,6 +1584,13 @@ inline void v_store_interleave(unsigned* ptr, const v_uint32x4& a, const v_uint3
 }
 
 #define OPENCV_HAL_IMPL_SSE_LOADSTORE_INTERLEAVE(_Tpvec, _Tp, suffix, _Tpuvec, _Tpu, usuffix) \
+inline void v_load_deinterleave( const _Tp* ptr, _Tpvec& a0, _Tpvec& b0 ) \
+{ \
+    _Tpuvec a1, b1; \
+    v_load_deinterleave((const _Tpu*)ptr, a1, b1); \
+    a0 = v_reinterpret_as_##suffix(a1); \
+    b0 = v_reinterpret_as_##suffix(b1); \
+} \
 inline void v_load_deinterleave( const _Tp* ptr, _Tpvec& a0, \
                                  _Tpvec& b0, _Tpvec& c0 ) \
 { \
@@ -1549,6 +1610,12 @@ inline void v_load_deinterleave( const _Tp* ptr, _Tpvec& a0, \
     c0 = v_reinterpret_as_##suffix(c1); \
     d0 = v_reinterpret_as_##suffix(d1); \
 } \
+inline void v_store_interleave( _Tp* ptr, const _Tpvec& a0, const _Tpvec& b0 ) \
+{ \
+    _Tpuvec a1 = v_reinterpret_as_##usuffix(a0); \
+    _Tpuvec b1 = v_reinterpret_as_##usuffix(b0); \
+    v_store_interleave((_Tpu*)ptr, a1, b1); \
+} \
 inline void v_store_interleave( _Tp* ptr, const _Tpvec& a0, \
                                const _Tpvec& b0, const _Tpvec& c0 ) \
 { \
@@ -1592,6 +1659,8 @@ inline v_float64x2 v_cvt_f64(const v_float32x4& a)
     return v_float64x2(_mm_cvtps_pd(a.val));
 }
 
+CV_CPU_OPTIMIZATION_HAL_NAMESPACE_END
+
 //! @endcond
 
 }
@@ -434,6 +434,60 @@ public:
     virtual BufferPoolController* getBufferPoolController(const char* id = NULL) const;
 };
 
+/** @brief Returns the allocator that keeps released buffers for reuse.
+
+The buffers are grouped into size classes (four per power of two, so no more than a quarter of a
+buffer is wasted). Every thread keeps a small cache of recently released buffers, the rest goes to
+the shared pool. It is useful for the temporary matrices of the same sizes allocated over and over,
+e.g. for every frame of a video. Mat does not use the allocator by default, install it with
+Mat::setDefaultAllocator or for a scope with MatAllocatorScope. UMat uses it when OpenCL is not in use
+and the default allocator is not replaced.
+
+The amount of the retained memory, including the thread caches, is limited by the
+OPENCV_BUFFERPOOL_LIMIT environment variable (256Mb by default) or
+BufferPoolController::setMaxReservedSize. The controller returned by
+getBufferPoolController also releases the retained buffers, the hit rate is reported by
+getPoolMatAllocatorStats.
+ */
+CV_EXPORTS MatAllocator* getPoolMatAllocator();
+
+/** @brief Returns the usage statistics of the allocator returned by getPoolMatAllocator.
+
+The counters are accumulated over all the threads since the start or the last call of
+resetPoolMatAllocatorStats.
+ */
+CV_EXPORTS BufferPoolStats getPoolMatAllocatorStats();
+
+//! Resets the allocation and hit counters of the allocator returned by getPoolMatAllocator.
+CV_EXPORTS void resetPoolMatAllocatorStats();
+
+/** @brief Makes the allocator default for the lifetime of the object.
+
+The allocator is used instead of Mat::getDefaultAllocator() only in the calling thread, so several
+threads may open their scopes concurrently. The previous allocator is restored by the destructor,
+the scopes can be nested. The matrices allocated inside the scope can safely outlive it.
+@code
+    for(;;)
+    {
+        cap >> frame;
+        cv::MatAllocatorScope scope(cv::getPoolMatAllocator());
+        processFrame(frame); // the temporary matrices reuse the buffers of the previous frame
+    }
+@endcode
+ */
+class CV_EXPORTS MatAllocatorScope
+{
+public:
+    explicit MatAllocatorScope(MatAllocator* allocator);
+    ~MatAllocatorScope();
+
+private:
+    MatAllocator* prevAllocator;
+
+    MatAllocatorScope(const MatAllocatorScope&);
+    MatAllocatorScope& operator = (const MatAllocatorScope&);
+};
+
 
 //////////////////////////////// MatCommaInitializer //////////////////////////////////
 
@@ -471,9 +525,11 @@ protected:
 // it should be explicitly initialized using init().
 struct CV_EXPORTS UMatData
 {
+    // HOST_MEMORY: the data is a plain host buffer, which is accessed directly
+    // and needs neither mapping nor synchronization
     enum { COPY_ON_MAP=1, HOST_COPY_OBSOLETE=2,
         DEVICE_COPY_OBSOLETE=4, TEMP_UMAT=8, TEMP_COPIED_UMAT=24,
-        USER_ALLOCATED=32, DEVICE_MEM_MAPPED=64};
+        USER_ALLOCATED=32, DEVICE_MEM_MAPPED=64, HOST_MEMORY=128};
     UMatData(const MatAllocator* allocator);
     ~UMatData();
 
@@ -487,6 +543,7 @@ struct CV_EXPORTS UMatData
     bool copyOnMap() const;
     bool tempUMat() const;
     bool tempCopiedUMat() const;
+    bool hostMemory() const;
     void markHostCopyObsolete(bool flag);
     void markDeviceCopyObsolete(bool flag);
     void markDeviceMemMapped(bool flag);
@@ -3272,6 +3329,15 @@ real-valued scalar ( double )):
 @note Comma-separated initializers and probably some other operations may require additional
 explicit Mat() or Mat_<T>() constructor calls to resolve a possible ambiguity.
 
+Chains of the element-wise operations (addition, subtraction, scaling, per-element multiplication
+and division, absolute value, minimum and maximum, comparison) on floating-point matrices are not
+evaluated step by step with a temporary matrix for every intermediate result. They are collected
+into a single expression which is computed in one pass over the data when it is assigned to a
+matrix, including the conversion to the destination type. The intermediate results are still
+rounded and saturated to their types and computed with the same precision as the corresponding
+functions (e.g. cv::addWeighted computes 32-bit floating-point matrices in double), so the result
+is bit-exact to the one when the operations are done one by one.
+
 Here are examples of matrix expressions:
 @code
     // compute pseudo-inverse of A, equivalent to A.inv(DECOMP_SVD)
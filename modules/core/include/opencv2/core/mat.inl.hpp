@@ -3644,6 +3644,7 @@ inline bool UMatData::deviceMemMapped() const { return (flags & DEVICE_MEM_MAPPE
 inline bool UMatData::copyOnMap() const { return (flags & COPY_ON_MAP) != 0; }
 inline bool UMatData::tempUMat() const { return (flags & TEMP_UMAT) != 0; }
 inline bool UMatData::tempCopiedUMat() const { return (flags & TEMP_COPIED_UMAT) == TEMP_COPIED_UMAT; }
+inline bool UMatData::hostMemory() const { return (flags & HOST_MEMORY) != 0; }
 
 inline void UMatData::markDeviceMemMapped(bool flag)
 {
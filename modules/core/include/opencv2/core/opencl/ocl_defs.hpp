@@ -18,6 +18,7 @@
             printf("%s: OpenCL implementation is running\n", CV_Func);      \
             fflush(stdout);                                                 \
             CV_IMPL_ADD(CV_IMPL_OCL);                                       \
+            CV_TRACE_IMPL(cv::tracing::IMPL_OPENCL);                        \
             return __VA_ARGS__;                                             \
         }                                                                   \
         else                                                                \
@@ -34,6 +35,7 @@
             if(func)                                                        \
             {                                                               \
                 CV_IMPL_ADD(CV_IMPL_OCL);                                   \
+                CV_TRACE_IMPL(cv::tracing::IMPL_OPENCL);                    \
             }                                                               \
             else                                                            \
             {                                                               \
@@ -47,6 +49,7 @@
     if (cv::ocl::useOpenCL() && (condition) && func)                        \
     {                                                                       \
         CV_IMPL_ADD(CV_IMPL_OCL);                                           \
+        CV_TRACE_IMPL(cv::tracing::IMPL_OPENCL);                            \
         return __VA_ARGS__;                                                 \
     }
 #endif
@@ -117,6 +117,14 @@ extension (".xml" and ".yml"/".yaml", respectively)
 streams.
 -# Close the file using FileStorage::release. FileStorage destructor also closes the file.
 
+Large matrices (trained models, PCA bases etc.) can be stored in the binary container instead, it is
+chosen by the ".cvbin" extension or FileStorage::FORMAT_BINARY flag. The data of the matrices is kept
+there as raw aligned blocks, the rest of the document is YAML. For reading the file is memory-mapped:
+the matrices loaded with `>>` reference the mapped pages without copying (the pages are loaded on
+first access; the modifications are private and do not change the file) and stay valid after the
+storage is released. The container uses the byte order of the writing platform and can not be
+appended, compressed or written to memory.
+
 Here is an example:
 @code
     #include "opencv2/opencv.hpp"
@@ -309,7 +317,8 @@ public:
         FORMAT_MASK = (7<<3), //!< mask for format flags
         FORMAT_AUTO = 0,      //!< flag, auto format
         FORMAT_XML  = (1<<3), //!< flag, XML format
-        FORMAT_YAML = (2<<3)  //!< flag, YAML format
+        FORMAT_YAML = (2<<3), //!< flag, YAML format
+        FORMAT_BINARY = (3<<3) //!< flag, binary container with the raw matrix data, see @ref xml_storage
     };
     enum
     {
@@ -328,7 +337,8 @@ public:
 
     /** @overload
     @param source Name of the file to open or the text string to read the data from. Extension of the
-    file (.xml or .yml/.yaml) determines its format (XML or YAML respectively). Also you can append .gz
+    file (.xml, .yml/.yaml or .cvbin) determines its format (XML, YAML or binary respectively), the
+    format of the file to read is detected from its content. Also you can append .gz
     to work with compressed files, for example myHugeMatrix.xml.gz. If both FileStorage::WRITE and
     FileStorage::MEMORY flags are specified, source is used just to specify the output file format (e.g.
     mydata.xml, .yml etc.).
@@ -646,6 +656,101 @@ public:
     size_t remaining;
 };
 
+/** @brief Forward-only reader of XML/YAML storages.
+
+Unlike FileStorage, which parses the whole file into the tree of nodes when it is opened, the reader
+parses the file piece by piece while the application walks over it, so the memory footprint does not
+depend on the file size. The reader is positioned at one element of the current collection at a
+time; the values of the collections are not parsed until they are requested, and the elements which
+are not accessed are skipped without building the nodes. The numbers of the matrices are parsed
+directly into the destination matrix, see FileStreamReader::read.
+
+The storage root is entered when the file is opened:
+@code
+    FileStreamReader reader("forest.yml");
+    while( reader.next() )
+    {
+        if( reader.name() != "trees" )
+            continue;
+        reader.enter();
+        while( reader.next() )
+        {
+            Tree tree;
+            tree.read(reader.node()); // the subtree of the single element
+        }
+        reader.leave();
+    }
+@endcode
+
+Files in the binary container (FileStorage::FORMAT_BINARY) are supported as well, their matrices
+are mapped as in cv::read. Only the first stream of a file is read.
+ */
+class CV_EXPORTS FileStreamReader
+{
+public:
+    //! The default constructor
+    FileStreamReader();
+    /** @overload
+    @param filename Name of the file to open, see FileStreamReader::open.
+    */
+    FileStreamReader(const String& filename);
+    //! The destructor, closes the file
+    ~FileStreamReader();
+
+    /** @brief Opens the file and enters the root collection.
+
+    The reader is not positioned at any element until next() is called.
+    @param filename Name of the file to open. The compressed files (.gz) are supported.
+    @returns true if the file has been opened.
+     */
+    bool open(const String& filename);
+    //! Checks whether the file is opened
+    bool isOpened() const;
+    //! Closes the file
+    void release();
+
+    /** @brief Moves to the next element of the current collection.
+
+    The rest of the current element is skipped.
+    @returns false when there are no more elements in the collection.
+     */
+    bool next();
+    //! Returns the name of the current element of the map or an empty string for the sequences
+    String name() const;
+    //! Returns the type of the current element, see FileNode::Type (FileNode::NONE if there is none)
+    int type() const;
+    //! Returns the number of the entered collections, including the root one
+    int depth() const;
+
+    /** @brief Enters the current collection element.
+
+    After the call the reader is positioned before the first element of the collection.
+     */
+    void enter();
+    /** @brief Skips the rest of the entered collection and returns to its parent.
+
+    The collection becomes the current element again.
+     */
+    void leave();
+
+    /** @brief Parses the current element and returns it as a regular file node.
+
+    The node is valid until the next call of next(); if the current element is a large collection,
+    its entire subtree is parsed into memory.
+     */
+    FileNode node() const;
+    /** @brief Reads the current element into the matrix.
+
+    The element has to be a matrix written by cv::write. Its data is parsed directly into the matrix
+    without building the intermediate nodes.
+     */
+    void read(Mat& m);
+
+    struct Impl;
+protected:
+    Ptr<Impl> p;
+};
+
 //! @} core_xml
 
 /////////////////// XML & YAML I/O implementation //////////////////
@@ -326,6 +326,7 @@ static struct __IppInitializer__ __ipp_initializer__;
             printf("%s: IPP implementation is running\n", CV_Func);         \
             fflush(stdout);                                                 \
             CV_IMPL_ADD(CV_IMPL_IPP);                                       \
+            CV_TRACE_IMPL(cv::tracing::IMPL_IPP);                           \
             return __VA_ARGS__;                                             \
         }                                                                   \
         else                                                                \
@@ -342,6 +343,7 @@ static struct __IppInitializer__ __ipp_initializer__;
             if(func)                                                        \
             {                                                               \
                 CV_IMPL_ADD(CV_IMPL_IPP);                                   \
+                CV_TRACE_IMPL(cv::tracing::IMPL_IPP);                       \
             }                                                               \
             else                                                            \
             {                                                               \
@@ -356,6 +358,7 @@ static struct __IppInitializer__ __ipp_initializer__;
     if (cv::ipp::useIPP() && (condition) && func)                           \
     {                                                                       \
         CV_IMPL_ADD(CV_IMPL_IPP);                                           \
+        CV_TRACE_IMPL(cv::tracing::IMPL_IPP);                               \
         return __VA_ARGS__;                                                 \
     }
 #endif
@@ -202,6 +202,8 @@ framework:
     functions sequentially.
 -   `GCD` – Supports only values \<= 0.
 -   `C=` – No special defined behaviour.
+-   `work-stealing` – The calling thread takes part in the computations, so threads - 1 worker
+    threads are created. Nested parallel regions are executed in parallel too.
 @param nthreads Number of threads used by OpenCV.
 @sa getNumThreads, getThreadNum
  */
@@ -221,6 +223,8 @@ The exact meaning of return value depends on the threading framework used by Ope
 - `C=` – The number of threads, that OpenCV will try to use for parallel regions, if before
   called setNumThreads with threads \> 0, otherwise returns the number of logical CPUs,
   available for the process.
+- `work-stealing` – The number of threads, that OpenCV will try to use for parallel regions,
+  including the calling thread.
 @sa setNumThreads, getThreadNum
  */
 CV_EXPORTS_W int getNumThreads();
@@ -235,10 +239,35 @@ The exact meaning of return value depends on the threading framework used by Ope
   for master thread and unique number for others, but not necessary 1,2,3,...).
 - `GCD` – System calling thread's ID. Never returns 0 inside parallel region.
 - `C=` – The index of the current parallel task.
+- `work-stealing` – 0 for the threads not owned by OpenCV (e.g. the calling thread), 1..N-1 for
+  the worker threads.
 @sa setNumThreads, getNumThreads
  */
 CV_EXPORTS_W int getThreadNum();
 
+/** @brief Enables or disables NUMA-aware execution of parallel regions.
+
+On a machine with several NUMA nodes the worker threads are bound to the CPUs of the nodes, each
+parallel region is split between the nodes in contiguous chunks (the first part of the range goes to
+the threads of the first node and so on) and the large matrices allocated by the default allocator
+are first touched with the same mapping, so their memory pages reside on the nodes that process them.
+Has no effect on single node machines and is supported by the `pthreads` and `work-stealing`
+frameworks only. Like setNumThreads, it must be called outside of parallel region.
+@param enabled true to enable NUMA-aware execution, false to restore the default behaviour.
+@sa isNumaAware, getNumberOfNumaNodes, setNumThreads
+ */
+CV_EXPORTS_W void setNumaAware(bool enabled);
+
+/** @brief Returns true if NUMA-aware execution of parallel regions is enabled.
+@sa setNumaAware
+ */
+CV_EXPORTS_W bool isNumaAware();
+
+/** @brief Returns the number of NUMA nodes having CPUs, 1 if it can not be determined.
+@sa setNumaAware
+ */
+CV_EXPORTS_W int getNumberOfNumaNodes();
+
 /** @brief Returns full configuration time cmake output.
 
 Returned value is raw cmake output including version control system revision, compiler version,
@@ -536,6 +565,126 @@ private:
     TLSData& operator =(const TLSData &) {return *this;};
 };
 
+/////////////////////////////////// Trace ////////////////////////////////////////
+
+/** @brief Lightweight instrumentation of the library calls.
+
+The functions marked with CV_TRACE_FUNCTION() and the blocks marked with CV_TRACE_REGION() are
+timed and written to a trace file in the Trace Event Format, so it can be loaded into
+chrome://tracing or the Perfetto UI. Every region is reported with its thread, its parent region,
+the implementation which has done the work (plain code, IPP or OpenCL) and the source location;
+the stripes of parallel_for_ executed by each thread are reported as one region per thread with the
+region which has called parallel_for_ as the parent.
+
+The trace is off by default, it can be enabled with setLevel() or with the `OPENCV_TRACE`
+environment variable (`1` for the coarse level, `2` for the fine one); the file name is taken from
+`OPENCV_TRACE_LOCATION` (`OpenCVTrace.json` by default). At the coarse level only the outermost
+regions of the calling threads and the parallel_for_ stripes are recorded (the stripes of one job
+are merged into a single region per thread), which keeps the overhead of the small calls low; the
+fine level records all the nested regions too.
+
+The regions can be removed at compile time by defining CV_TRACE=0 (see the `ENABLE_TRACE` CMake
+option for the library itself), then they have no overhead at all. When the trace is compiled in but
+not enabled each region costs one function call.
+
+@code
+    void process(const cv::Mat& src, cv::Mat& dst)
+    {
+        CV_TRACE_FUNCTION();
+        {
+            CV_TRACE_REGION("prepare");
+            ...
+        }
+        cv::GaussianBlur(src, dst, cv::Size(5, 5), 0); // reported as a nested region at the fine level
+    }
+@endcode
+ */
+namespace tracing {
+
+enum Level
+{
+    LEVEL_DISABLED = 0, //!< nothing is recorded
+    LEVEL_COARSE = 1,   //!< the outermost regions and the parallel_for_ stripes
+    LEVEL_FINE = 2      //!< all regions
+};
+
+//! the implementations reported by CV_TRACE_IMPL
+enum Impl
+{
+    IMPL_PLAIN = 0,
+    IMPL_IPP = 1,
+    IMPL_OPENCL = 2
+};
+
+/** @brief Starts, stops or changes the level of the trace.
+
+Starting the trace truncates the trace file, stopping it writes the buffered events and closes the
+file. Like setNumThreads, it must be called outside of parallel region.
+@param level one of cv::tracing::Level values.
+ */
+CV_EXPORTS void setLevel(int level);
+
+//! Returns the current trace level
+CV_EXPORTS int getLevel();
+
+/** @brief Sets the name of the trace file.
+
+If the trace is running, the current file is closed and the new one is started.
+ */
+CV_EXPORTS void setOutputFile(const String& filename);
+
+/** @brief Writes the events buffered by all threads to the trace file.
+
+The regions which are still open are written when they end. Must be called outside of parallel region.
+ */
+CV_EXPORTS void flush();
+
+//! Marks the open regions of the calling thread as executed with the given implementation, see CV_TRACE_IMPL
+CV_EXPORTS void setImpl(int impl);
+
+//! Scoped trace region, use CV_TRACE_FUNCTION() and CV_TRACE_REGION() instead of the class itself
+class CV_EXPORTS Region
+{
+public:
+    struct LocationStaticStorage
+    {
+        const char* name;
+        const char* filename;
+        int line;
+    };
+
+    explicit Region(const LocationStaticStorage& location);
+    ~Region() { if (data) destroy(); }
+
+private:
+    void destroy();
+
+    void* data;
+
+    Region(const Region&);
+    Region& operator = (const Region&);
+};
+
+} // namespace tracing
+
+#ifndef CV_TRACE
+#  define CV_TRACE 1
+#endif
+
+#if CV_TRACE
+#  define CV__TRACE_CAT_(x, y) x ## y
+#  define CV__TRACE_CAT(x, y) CV__TRACE_CAT_(x, y)
+#  define CV_TRACE_REGION(name) \
+    static const cv::tracing::Region::LocationStaticStorage CV__TRACE_CAT(cv_trace_location_, __LINE__) = { name, __FILE__, __LINE__ }; \
+    const cv::tracing::Region CV__TRACE_CAT(cv_trace_region_, __LINE__)(CV__TRACE_CAT(cv_trace_location_, __LINE__))
+#  define CV_TRACE_FUNCTION() CV_TRACE_REGION(CV_Func)
+#  define CV_TRACE_IMPL(impl) cv::tracing::setImpl(impl)
+#else
+#  define CV_TRACE_REGION(name)
+#  define CV_TRACE_FUNCTION()
+#  define CV_TRACE_IMPL(impl)
+#endif
+
 /** @brief Designed for command line parsing
 
 The sample below demonstrates how to use CommandLineParser:
@@ -270,3 +270,42 @@ PERF_TEST_P(Size_MatType, reciprocal, TYPICAL_MATS_CORE_ARITHM)
 
     SANITY_CHECK_NOTHING();
 }
+
+enum { ELEMWISE_ADD, ELEMWISE_ADD_MASK, ELEMWISE_ADD_SCALAR, ELEMWISE_SUB_MIXED, ELEMWISE_MUL_SCALE,
+       ELEMWISE_ABSDIFF, ELEMWISE_CMP, ELEMWISE_AND };
+CV_ENUM(ElemwiseOp, ELEMWISE_ADD, ELEMWISE_ADD_MASK, ELEMWISE_ADD_SCALAR, ELEMWISE_SUB_MIXED, ELEMWISE_MUL_SCALE,
+        ELEMWISE_ABSDIFF, ELEMWISE_CMP, ELEMWISE_AND)
+
+typedef std::tr1::tuple<int, ElemwiseOp, MatType> Threads_ElemwiseOp_MatType_t;
+typedef perf::TestBaseWithParam<Threads_ElemwiseOp_MatType_t> Threads_ElemwiseOp_MatType;
+
+// the scaling of the element-wise operations on the 4K image with the number of threads
+PERF_TEST_P(Threads_ElemwiseOp_MatType, elemwise_threads,
+            testing::Combine(testing::Values(1, 2, 4, 8), ElemwiseOp::all(), testing::Values(CV_8UC1, CV_32FC1)))
+{
+    int threads = get<0>(GetParam());
+    int op = get<1>(GetParam());
+    int type = get<2>(GetParam());
+    Size sz(3840, 2160);
+
+    cv::Mat a(sz, type), b(sz, type), b16s(sz, CV_16SC1), mask(sz, CV_8UC1), c(sz, type);
+    declare.in(a, b, b16s, mask, WARMUP_RNG).out(c);
+
+    setNumThreads(threads);
+
+    switch (op)
+    {
+    case ELEMWISE_ADD: TEST_CYCLE() add(a, b, c); break;
+    case ELEMWISE_ADD_MASK: TEST_CYCLE() add(a, b, c, mask); break;
+    case ELEMWISE_ADD_SCALAR: TEST_CYCLE() add(a, Scalar::all(3), c); break;
+    case ELEMWISE_SUB_MIXED: TEST_CYCLE() subtract(a, b16s, c, noArray(), CV_32F); break;
+    case ELEMWISE_MUL_SCALE: TEST_CYCLE() multiply(a, b, c, 0.5); break;
+    case ELEMWISE_ABSDIFF: TEST_CYCLE() absdiff(a, b, c); break;
+    case ELEMWISE_CMP: TEST_CYCLE() compare(a, b, c, CMP_GT); break;
+    case ELEMWISE_AND: TEST_CYCLE() bitwise_and(a, b, c); break;
+    }
+
+    setNumThreads(-1);
+
+    SANITY_CHECK_NOTHING();
+}
@@ -35,3 +35,38 @@ PERF_TEST_P( Size_DepthSrc_DepthDst_Channels_alpha, convertTo,
 
     SANITY_CHECK(dst, alpha == 1.0 ? 1e-12 : 1e-7);
 }
+
+typedef std::tr1::tuple<Size, MatType, MatType, bool> Size_DepthSrc_DepthDst_LUT_t;
+typedef perf::TestBaseWithParam<Size_DepthSrc_DepthDst_LUT_t> Size_DepthSrc_DepthDst_LUT;
+
+PERF_TEST_P( Size_DepthSrc_DepthDst_LUT, convertScaleLUT,
+             testing::Combine
+             (
+                 testing::Values(szVGA, sz1080p),
+                 testing::Values(CV_8U, CV_16U, CV_32F),
+                 testing::Values(CV_8U, CV_32F),
+                 testing::Bool()
+             )
+           )
+{
+    Size sz = get<0>(GetParam());
+    int depthSrc = get<1>(GetParam());
+    int depthDst = get<2>(GetParam());
+    bool useLUT = get<3>(GetParam());
+
+    Mat src(sz, CV_MAKETYPE(depthSrc, 3)), dst(sz, CV_MAKETYPE(depthDst, 3)), lut;
+    randu(src, 0, 255);
+    if( useLUT )
+    {
+        lut.create(1, 256, CV_8UC3);
+        randu(lut, 0, 255);
+    }
+
+    // BGR -> RGB
+    std::vector<int> order(3);
+    order[0] = 2; order[1] = 1; order[2] = 0;
+
+    TEST_CYCLE() convertScaleLUT(src, dst, depthDst, Scalar(0.5, 1.5, 2), Scalar::all(3), lut, order);
+
+    SANITY_CHECK_NOTHING();
+}
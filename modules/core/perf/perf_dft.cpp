@@ -38,6 +38,42 @@ PERF_TEST_P(Size_MatType_FlagsType_NzeroRows, dft, TEST_MATS_DFT)
     SANITY_CHECK(dst, 1e-5, ERROR_RELATIVE);
 }
 
+typedef std::tr1::tuple<Size, MatType, bool> Size_MatType_Batched_t;
+typedef perf::TestBaseWithParam<Size_MatType_Batched_t> Size_MatType_Batched;
+
+// many small transforms of the same size, e.g. the filter bank or the template patches
+PERF_TEST_P(Size_MatType_Batched, dft_small, testing::Combine(
+                                    testing::Values(cv::Size(16, 16), cv::Size(32, 32), cv::Size(64, 64)),
+                                    testing::Values(CV_32FC1, CV_32FC2), testing::Bool()))
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    bool batched = get<2>(GetParam());
+
+    std::vector<Mat> src(1000), dst(src.size());
+    for (size_t i = 0; i < src.size(); i++)
+    {
+        src[i].create(sz, type);
+        randu(src[i], -1, 1);
+    }
+    Ptr<DFTPlan> plan = DFTPlan::create(sz, type, DFT_COMPLEX_OUTPUT);
+
+    if (batched)
+    {
+        TEST_CYCLE() plan->applyBatch(src, dst);
+    }
+    else
+    {
+        TEST_CYCLE()
+        {
+            for (size_t i = 0; i < src.size(); i++)
+                dft(src[i], dst[i], DFT_COMPLEX_OUTPUT);
+        }
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
 ///////////////////////////////////////////////////////dct//////////////////////////////////////////////////////
 
 CV_ENUM(DCT_FlagsType, 0, DCT_INVERSE , DCT_ROWS, DCT_INVERSE|DCT_ROWS)
@@ -0,0 +1,47 @@
+#include "perf_precomp.hpp"
+
+using namespace std;
+using namespace cv;
+using namespace perf;
+using std::tr1::make_tuple;
+using std::tr1::get;
+
+CV_ENUM(GemmFlag, 0, GEMM_1_T, GEMM_2_T, GEMM_3_T, GEMM_1_T|GEMM_2_T)
+
+typedef std::tr1::tuple<Size, GemmFlag, MatType> Size_GemmFlag_MatType_t;
+typedef perf::TestBaseWithParam<Size_GemmFlag_MatType_t> Size_GemmFlag_MatType;
+
+PERF_TEST_P(Size_GemmFlag_MatType, gemm,
+            testing::Combine(testing::Values(Size(128, 128), Size(640, 640), Size(1280, 1280)),
+                             GemmFlag::all(), testing::Values(CV_32FC1, CV_64FC1)))
+{
+    Size sz = get<0>(GetParam());
+    int flags = get<1>(GetParam());
+    int type = get<2>(GetParam());
+
+    Mat a(sz, type), b(sz, type), c(sz, type), dst(sz, type);
+    declare.in(a, b, c, WARMUP_RNG).out(dst).time(100);
+
+    TEST_CYCLE() cv::gemm(a, b, 0.6, c, 1.5, dst, flags);
+
+    SANITY_CHECK_NOTHING();
+}
+
+typedef std::tr1::tuple<int, int, int, MatType> GemmShape_t;
+typedef perf::TestBaseWithParam<GemmShape_t> GemmShape;
+
+// the products of the tall and the narrow matrices, e.g. the PCA projection or a layer of the MLP
+PERF_TEST_P(GemmShape, gemm_shapes,
+            testing::Combine(testing::Values(1000, 10000), testing::Values(16, 100),
+                             testing::Values(64, 256), testing::Values(CV_32FC1, CV_64FC1)))
+{
+    int rows = get<0>(GetParam()), ncomp = get<1>(GetParam()), dims = get<2>(GetParam());
+    int type = get<3>(GetParam());
+
+    Mat data(rows, dims, type), vectors(ncomp, dims, type), dst(rows, ncomp, type);
+    declare.in(data, vectors, WARMUP_RNG).out(dst).time(100);
+
+    TEST_CYCLE() cv::gemm(data, vectors, 1, noArray(), 0, dst, GEMM_2_T);
+
+    SANITY_CHECK_NOTHING();
+}
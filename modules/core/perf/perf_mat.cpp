@@ -96,3 +96,28 @@ PERF_TEST_P(Size_MatType, Mat_Clone_Roi,
 
     SANITY_CHECK(destination, 1);
 }
+
+typedef TestBaseWithParam<bool> MatAllocator_Pool;
+
+PERF_TEST_P(MatAllocator_Pool, temporaries, testing::Bool())
+{
+    const bool usePool = GetParam();
+    Size size = sz1080p;
+
+    MatAllocator* allocator = usePool ? getPoolMatAllocator() : Mat::getStdAllocator();
+
+    Mat src(size, CV_8UC3), dst(size, CV_8UC3);
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE()
+    {
+        MatAllocatorScope scope(allocator);
+        Mat tmp, result;
+        src.convertTo(tmp, CV_32F);
+        tmp.convertTo(result, CV_8U);
+        result.copyTo(dst);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
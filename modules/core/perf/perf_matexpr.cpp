@@ -0,0 +1,71 @@
+#include "perf_precomp.hpp"
+
+using namespace std;
+using namespace cv;
+using namespace perf;
+using std::tr1::make_tuple;
+using std::tr1::get;
+
+#define TYPICAL_MAT_TYPES_MATEXPR   CV_8UC1, CV_16SC1, CV_32FC1, CV_32FC3, CV_64FC1
+#define TYPICAL_MATS_MATEXPR        testing::Combine(testing::Values(szVGA, sz1080p), testing::Values(TYPICAL_MAT_TYPES_MATEXPR))
+
+PERF_TEST_P(Size_MatType, MatExpr_weightedDiff, TYPICAL_MATS_MATEXPR)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    Mat a(sz, type), b(sz, type), c(sz, type), dst(sz, type);
+
+    declare.in(a, b, c, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() dst = a*0.75 + b*1.25 - c;
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(Size_MatType, MatExpr_weightedDiff_multipass, TYPICAL_MATS_MATEXPR)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    Mat a(sz, type), b(sz, type), c(sz, type), dst(sz, type);
+
+    declare.in(a, b, c, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE()
+    {
+        addWeighted(a, 0.75, b, 1.25, 0, dst);
+        subtract(dst, c, dst);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(Size_MatType, MatExpr_mulAddCompare, TYPICAL_MATS_MATEXPR)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    Mat a(sz, type), b(sz, type), c(sz, type), dst(sz, CV_8UC(CV_MAT_CN(type)));
+
+    declare.in(a, b, c, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() dst = (a + b).mul(c, 0.5) > b;
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(Size_MatType, MatExpr_mulAddCompare_multipass, TYPICAL_MATS_MATEXPR)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    Mat a(sz, type), b(sz, type), c(sz, type), t(sz, type), dst(sz, CV_8UC(CV_MAT_CN(type)));
+
+    declare.in(a, b, c, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE()
+    {
+        add(a, b, t);
+        multiply(t, c, t, 0.5);
+        compare(t, b, dst, CMP_GT);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
@@ -69,3 +69,119 @@ PERF_TEST_P( MaxDim_MaxPoints, kmeans,
 
     SANITY_CHECK(sortedClusterPointsNumber);
 }
+
+typedef std::tr1::tuple<int, int> N_K_t;
+typedef perf::TestBaseWithParam<N_K_t> N_K;
+
+PERF_TEST_P( N_K, kmeans_pp_seeding,
+             testing::Combine( testing::Values( 100000, 1000000 ),
+                               testing::Values( 16, 64 ) ) )
+{
+    const int N = get<0>(GetParam()), K = get<1>(GetParam()), dims = 128;
+
+    Mat data(N, dims, CV_32F), labels, centers;
+    declare.in(data, WARMUP_RNG);
+
+    // the first iteration only assigns the labels to the initial centers
+    TEST_CYCLE_N(1)
+    {
+        kmeans(data, K, labels, TermCriteria(TermCriteria::MAX_ITER, 1, 0),
+               1, KMEANS_PP_CENTERS, centers);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+typedef std::tr1::tuple<int, int> N_BatchSize_t;
+typedef perf::TestBaseWithParam<N_BatchSize_t> N_BatchSize;
+
+PERF_TEST_P( N_BatchSize, kmeansMiniBatch,
+             testing::Combine( testing::Values( 100000, 1000000 ),
+                               testing::Values( 1024, 4096 ) ) )
+{
+    const int N = get<0>(GetParam()), batchSize = get<1>(GetParam()), dims = 128, K = 64;
+
+    Mat data(N, dims, CV_32F), labels, centers;
+    declare.in(data, WARMUP_RNG);
+
+    TEST_CYCLE_N(1)
+    {
+        kmeansMiniBatch(data, K, labels, TermCriteria(TermCriteria::MAX_ITER, 100, 0),
+                        batchSize, 1, KMEANS_PP_CENTERS, centers);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+typedef std::tr1::tuple<Size, MatType> Size_MatType_t;
+typedef perf::TestBaseWithParam<Size_MatType_t> Size_MatType;
+
+PERF_TEST_P( Size_MatType, SVD,
+             testing::Combine( testing::Values( Size(64, 64), Size(256, 256), Size(512, 512), Size(256, 1024) ),
+                               testing::Values( CV_32F, CV_64F ) ) )
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+
+    Mat a(sz, type), w, u, vt;
+    declare.in(a, WARMUP_RNG);
+
+    TEST_CYCLE_N(3) SVD::compute(a, w, u, vt);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P( Size_MatType, eigen,
+             testing::Combine( testing::Values( Size(64, 64), Size(256, 256), Size(512, 512) ),
+                               testing::Values( CV_32F, CV_64F ) ) )
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+
+    Mat a(sz, type), evals, evects;
+    declare.in(a, WARMUP_RNG);
+    completeSymm(a);
+
+    TEST_CYCLE_N(3) eigen(a, evals, evects);
+
+    SANITY_CHECK_NOTHING();
+}
+
+typedef std::tr1::tuple<Size, int> Size_K_t;
+typedef perf::TestBaseWithParam<Size_K_t> Size_K;
+
+PERF_TEST_P( Size_K, SVDecompTruncated,
+             testing::Combine( testing::Values( Size(512, 512), Size(1000, 2000) ),
+                               testing::Values( 10, 50 ) ) )
+{
+    Size sz = get<0>(GetParam());
+    int k = get<1>(GetParam());
+
+    Mat a(sz, CV_32F), w, u, vt;
+    declare.in(a, WARMUP_RNG);
+
+    TEST_CYCLE_N(3) SVDecompTruncated(a, k, w, u, vt);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P( N_K, PCAAccumulator_add,
+             testing::Combine( testing::Values( 10000, 100000 ),
+                               testing::Values( 64, 128 ) ) )
+{
+    const int N = get<0>(GetParam()), dims = get<1>(GetParam()), batchSize = 65536;
+
+    Mat data(N, dims, CV_32F);
+    declare.in(data, WARMUP_RNG);
+    PCA pca;
+
+    TEST_CYCLE_N(1)
+    {
+        PCAAccumulator acc;
+        for( int y = 0; y < N; y += batchSize )
+            acc.add(data.rowRange(y, std::min(y + batchSize, N)));
+        acc.compute(pca, PCA::DATA_AS_ROW, 32);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
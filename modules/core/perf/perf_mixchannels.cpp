@@ -0,0 +1,44 @@
+#include "perf_precomp.hpp"
+
+using namespace std;
+using namespace cv;
+using namespace perf;
+using std::tr1::make_tuple;
+using std::tr1::get;
+
+enum { MIX_BGR2RGB, MIX_BGRA2RGBA, MIX_BGRA2BGR, MIX_BGR2BGRA, MIX_EXTRACT_G };
+CV_ENUM(MixOp, MIX_BGR2RGB, MIX_BGRA2RGBA, MIX_BGRA2BGR, MIX_BGR2BGRA, MIX_EXTRACT_G)
+
+typedef std::tr1::tuple<Size, MatType, MixOp> Size_Depth_MixOp_t;
+typedef perf::TestBaseWithParam<Size_Depth_MixOp_t> Size_Depth_MixOp;
+
+PERF_TEST_P( Size_Depth_MixOp, mixChannels,
+             testing::Combine
+             (
+                 testing::Values(szVGA, sz1080p),
+                 testing::Values(CV_8U, CV_16U, CV_32F),
+                 MixOp::all()
+             )
+           )
+{
+    Size sz = get<0>(GetParam());
+    int depth = get<1>(GetParam());
+    int op = get<2>(GetParam());
+
+    static const int scn[] = { 3, 4, 4, 3, 3 }, dcn[] = { 3, 4, 3, 4, 1 };
+    static const int fromTo[][8] =
+    {
+        { 0, 2, 1, 1, 2, 0 },
+        { 0, 2, 1, 1, 2, 0, 3, 3 },
+        { 0, 0, 1, 1, 2, 2 },
+        { 0, 0, 1, 1, 2, 2, -1, 3 },
+        { 1, 0 }
+    };
+
+    Mat src(sz, CV_MAKETYPE(depth, scn[op])), dst(sz, CV_MAKETYPE(depth, dcn[op]));
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() mixChannels(&src, 1, &dst, 1, fromTo[op], dcn[op]);
+
+    SANITY_CHECK_NOTHING();
+}
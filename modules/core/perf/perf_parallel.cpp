@@ -0,0 +1,156 @@
+#include "perf_precomp.hpp"
+
+using namespace std;
+using namespace cv;
+using namespace perf;
+
+namespace {
+
+class RowsBody : public ParallelLoopBody
+{
+public:
+    RowsBody(const Mat& _src, Mat& _dst) : src(_src), dst(_dst) {}
+
+    void operator()(const Range& range) const
+    {
+        for (int y = range.start; y < range.end; y++)
+        {
+            const float* s = src.ptr<float>(y);
+            float* d = dst.ptr<float>(y);
+            for (int x = 0; x < src.cols; x++)
+                d[x] = std::sqrt(std::exp(s[x]) + 1.f);
+        }
+    }
+
+private:
+    const Mat& src;
+    Mat& dst;
+};
+
+class NestedBody : public ParallelLoopBody
+{
+public:
+    NestedBody(const Mat& _src, Mat& _dst, int _blocks) : src(_src), dst(_dst), blocks(_blocks) {}
+
+    void operator()(const Range& range) const
+    {
+        int rowsPerBlock = (src.rows + blocks - 1) / blocks;
+        for (int b = range.start; b < range.end; b++)
+        {
+            Range rows(b * rowsPerBlock, std::min((b + 1) * rowsPerBlock, src.rows));
+            if (rows.start >= rows.end)
+                continue;
+            Mat s = src.rowRange(rows), d = dst.rowRange(rows);
+            parallel_for_(Range(0, s.rows), RowsBody(s, d));
+        }
+    }
+
+private:
+    const Mat& src;
+    Mat& dst;
+    int blocks;
+};
+
+}
+
+typedef TestBaseWithParam<int> ParallelFor_Threads;
+
+#define PARALLEL_FOR_THREADS testing::Values(1, 2, 4, 8, 16, 32)
+
+PERF_TEST_P(ParallelFor_Threads, flat, PARALLEL_FOR_THREADS)
+{
+    const int threads = GetParam();
+
+    Mat src(2048, 2048, CV_32FC1), dst(src.size(), src.type());
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    setNumThreads(threads);
+
+    TEST_CYCLE() parallel_for_(Range(0, src.rows), RowsBody(src, dst));
+
+    setNumThreads(-1);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(ParallelFor_Threads, nested, PARALLEL_FOR_THREADS)
+{
+    const int threads = GetParam(), blocks = 4;
+
+    Mat src(2048, 2048, CV_32FC1), dst(src.size(), src.type());
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    setNumThreads(threads);
+
+    TEST_CYCLE() parallel_for_(Range(0, blocks), NestedBody(src, dst, blocks));
+
+    setNumThreads(-1);
+
+    SANITY_CHECK_NOTHING();
+}
+
+typedef TestBaseWithParam<bool> ParallelFor_Numa;
+
+PERF_TEST_P(ParallelFor_Numa, rows, testing::Bool())
+{
+    const bool numa = GetParam();
+
+    setNumaAware(numa);
+
+    // allocated after switching the mode, so the pages are first touched by the right nodes
+    Mat src(4096, 4096, CV_32FC1), dst(src.size(), src.type());
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() parallel_for_(Range(0, src.rows), RowsBody(src, dst));
+
+    setNumaAware(false);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(ParallelFor_Numa, allocate, testing::Bool())
+{
+    const bool numa = GetParam();
+
+    setNumaAware(numa);
+
+    TEST_CYCLE()
+    {
+        Mat m(4096, 4096, CV_32FC1);
+        m.setTo(Scalar::all(1));
+    }
+
+    setNumaAware(false);
+
+    SANITY_CHECK_NOTHING();
+}
+
+typedef TestBaseWithParam<int> ParallelFor_Trace;
+
+// the same workload with the trace off and on, the difference is the cost of the trace regions
+PERF_TEST_P(ParallelFor_Trace, rows, testing::Values((int)tracing::LEVEL_DISABLED, (int)tracing::LEVEL_COARSE, (int)tracing::LEVEL_FINE))
+{
+    const int level = GetParam();
+
+    Mat src(2048, 2048, CV_32FC1), dst(src.size(), src.type());
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    String filename = tempfile(".json");
+    tracing::setOutputFile(filename);
+    tracing::setLevel(level);
+
+    TEST_CYCLE()
+    {
+        CV_TRACE_REGION("ParallelFor_Trace");
+        parallel_for_(Range(0, src.rows), RowsBody(src, dst));
+    }
+
+    tracing::setLevel(tracing::LEVEL_DISABLED);
+    remove(filename.c_str());
+
+    SANITY_CHECK_NOTHING();
+}
@@ -50,3 +50,24 @@ PERF_TEST_P(sortIdxFixture, sorIdx, TYPICAL_MATS_SORT)
 
     SANITY_CHECK_NOTHING();
 }
+
+typedef tuple<Size, MatType, int> partialSortParams;
+typedef TestBaseWithParam<partialSortParams> partialSortFixture;
+
+// the nearest neighbours of 1000 queries in a distance matrix
+PERF_TEST_P(partialSortFixture, partialSort,
+            testing::Combine(testing::Values(Size(10000, 1000), Size(100000, 100)),
+                             testing::Values(CV_32SC1, CV_32FC1), testing::Values(1, 10, 100)))
+{
+    const partialSortParams params = GetParam();
+    const Size sz = get<0>(params);
+    const int type = get<1>(params), k = get<2>(params);
+
+    cv::Mat a(sz, type), b, idx;
+
+    declare.in(a, WARMUP_RNG);
+
+    TEST_CYCLE() cv::partialSort(a, b, idx, k, SORT_EVERY_ROW | SORT_ASCENDING);
+
+    SANITY_CHECK_NOTHING();
+}
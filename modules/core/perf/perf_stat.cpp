@@ -102,3 +102,44 @@ PERF_TEST_P(Size_MatType, countNonZero, testing::Combine( testing::Values( TYPIC
 
     SANITY_CHECK(cnt);
 }
+
+enum { STAT_SUM, STAT_MEAN_MASK, STAT_MEANSTDDEV, STAT_NORM_L2, STAT_NORM_DIFF_INF,
+       STAT_MINMAXLOC, STAT_COUNTNONZERO };
+CV_ENUM(StatOp, STAT_SUM, STAT_MEAN_MASK, STAT_MEANSTDDEV, STAT_NORM_L2, STAT_NORM_DIFF_INF,
+        STAT_MINMAXLOC, STAT_COUNTNONZERO)
+
+typedef std::tr1::tuple<int, StatOp, MatType> Threads_StatOp_MatType_t;
+typedef perf::TestBaseWithParam<Threads_StatOp_MatType_t> Threads_StatOp_MatType;
+
+// the scaling of the reductions of the 4K image with the number of threads
+PERF_TEST_P(Threads_StatOp_MatType, stat_threads,
+            testing::Combine(testing::Values(1, 2, 4, 8), StatOp::all(), testing::Values(CV_8UC1, CV_32FC1)))
+{
+    int threads = get<0>(GetParam());
+    int op = get<1>(GetParam());
+    int type = get<2>(GetParam());
+    Size sz(3840, 2160);
+
+    Mat a(sz, type), b(sz, type), mask(sz, CV_8UC1);
+    Scalar s, sdv;
+    double n = 0;
+    Point minLoc, maxLoc;
+    declare.in(a, b, mask, WARMUP_RNG);
+
+    setNumThreads(threads);
+
+    switch (op)
+    {
+    case STAT_SUM: TEST_CYCLE() s = sum(a); break;
+    case STAT_MEAN_MASK: TEST_CYCLE() s = mean(a, mask); break;
+    case STAT_MEANSTDDEV: TEST_CYCLE() meanStdDev(a, s, sdv); break;
+    case STAT_NORM_L2: TEST_CYCLE() n = norm(a, NORM_L2); break;
+    case STAT_NORM_DIFF_INF: TEST_CYCLE() n = norm(a, b, NORM_INF); break;
+    case STAT_MINMAXLOC: TEST_CYCLE() minMaxLoc(a, 0, &n, &minLoc, &maxLoc); break;
+    case STAT_COUNTNONZERO: TEST_CYCLE() n = countNonZero(a); break;
+    }
+
+    setNumThreads(-1);
+
+    SANITY_CHECK_NOTHING();
+}
@@ -65,4 +65,73 @@ OCL_PERF_TEST_P(UMatTest, CustomPtr, Combine(Values(sz1080p, sz2160p), Bool(), :
     SANITY_CHECK_NOTHING();
 }
 
+// the same chain of the operations on Mat and on UMat, the temporary arrays are created on every iteration
+typedef TestBaseWithParam< tuple<Size, bool> > UMatTest_CPU;
+
+OCL_PERF_TEST_P(UMatTest_CPU, OpsChain, Combine(Values(Size(32, 32), szVGA, sz1080p), Bool()))
+{
+    OpenCLState s(false);
+
+    const Size size = get<0>(GetParam());
+    const bool useUMat = get<1>(GetParam());
+    Mat a(size, CV_8UC1), b(size, CV_8UC1), dst;
+    declare.in(a, b, WARMUP_RNG);
+
+    if( useUMat )
+    {
+        UMat ua = a.getUMat(ACCESS_READ), ub = b.getUMat(ACCESS_READ);
+        OCL_TEST_CYCLE_MULTIRUN(10)
+        {
+            UMat t1, t2, t3;
+            cv::add(ua, ub, t1);
+            cv::absdiff(t1, ua, t2);
+            cv::bitwise_and(t2, ub, t3);
+            t3.copyTo(dst);
+        }
+    }
+    else
+    {
+        OCL_TEST_CYCLE_MULTIRUN(10)
+        {
+            Mat t1, t2, t3;
+            cv::add(a, b, t1);
+            cv::absdiff(t1, a, t2);
+            cv::bitwise_and(t2, b, t3);
+            t3.copyTo(dst);
+        }
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+// wrapping Mat into UMat and back, as the T-API code does for every call
+OCL_PERF_TEST_P(UMatTest_CPU, GetUMatGetMat, Combine(Values(Size(32, 32), sz1080p), Bool()))
+{
+    OpenCLState s(false);
+
+    const Size size = get<0>(GetParam());
+    const bool fromUMat = get<1>(GetParam());
+    Mat m(size, CV_8UC1, Scalar::all(1));
+    UMat u(size, CV_8UC1, Scalar::all(1));
+    int sum = 0;
+
+    OCL_TEST_CYCLE_MULTIRUN(1000)
+    {
+        if( fromUMat )
+        {
+            Mat m1 = u.getMat(ACCESS_READ);
+            sum += m1.ptr()[0];
+        }
+        else
+        {
+            UMat u1 = m.getUMat(ACCESS_READ);
+            Mat m1 = u1.getMat(ACCESS_READ);
+            sum += m1.ptr()[0];
+        }
+    }
+    ASSERT_GT(sum, 0);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace cvtest
@@ -49,6 +49,7 @@
 
 #include "precomp.hpp"
 #include "opencl_kernels_core.hpp"
+#include "arithm.simd.hpp"
 
 namespace cv
 {
@@ -74,6 +75,78 @@ void convertAndUnrollScalar( const Mat& sc, int buftype, uchar* scbuf, size_t bl
         scbuf[i] = scbuf[i - esz];
 }
 
+/****************************************************************************************\
+*                       parallel processing of the element-wise operations               *
+\****************************************************************************************/
+
+// processes the whole arrays or their stripes, src2 is not split when it is a scalar
+class ElemwiseBody
+{
+public:
+    virtual ~ElemwiseBody() {}
+    virtual void operator()(const Mat& src1, const Mat& src2, Mat& dst, const Mat& mask) const = 0;
+};
+
+class ElemwiseInvoker : public ParallelLoopBody
+{
+public:
+    ElemwiseInvoker(const ElemwiseBody& _body, const Mat& _src1, const Mat& _src2, Mat& _dst,
+                    const Mat& _mask, bool _scalar2, const ParallelStripes& _stripes)
+        : body(_body), src1(_src1), src2(_src2), dst(_dst), mask(_mask),
+          scalar2(_scalar2), stripe(_stripes) {}
+
+    void operator()(const Range& range) const
+    {
+        Mat d = stripe(dst, range);
+        body(stripe(src1, range), scalar2 ? src2 : stripe(src2, range), d,
+             mask.empty() ? mask : stripe(mask, range));
+    }
+
+protected:
+    const ElemwiseBody& body;
+    const Mat& src1;
+    const Mat& src2;
+    Mat& dst;
+    const Mat& mask;
+    bool scalar2;
+    ParallelStripes stripe;
+};
+
+static void runElemwise(const ElemwiseBody& body, const Mat& src1, const Mat& src2, Mat& dst,
+                        const Mat& mask, bool scalar2)
+{
+    // the stripes are measured by the larger of src1 and dst
+    ParallelStripes stripes(dst, dst.total()*std::max(src1.elemSize(), dst.elemSize()));
+
+    if( stripes.nstripes < 2 || dst.dims > 2 || src1.dims > 2 )
+    {
+        body(src1, src2, dst, mask);
+        return;
+    }
+
+    parallel_for_(stripes.range(), ElemwiseInvoker(body, src1, src2, dst, mask, scalar2, stripes),
+                  stripes.nstripes);
+}
+
+// calls the kernel for the arrays of the same size and type, cn is the number of the kernel elements per pixel
+class ElemwiseFuncBody : public ElemwiseBody
+{
+public:
+    ElemwiseFuncBody(BinaryFuncC _func, int _cn, void* _usrdata)
+        : func(_func), cn(_cn), usrdata(_usrdata) {}
+
+    void operator()(const Mat& src1, const Mat& src2, Mat& dst, const Mat&) const
+    {
+        Size sz = getContinuousSize(src1, src2, dst, cn);
+        func(src1.ptr(), src1.step, src2.ptr(), src2.step, dst.ptr(), dst.step, sz.width, sz.height, usrdata);
+    }
+
+protected:
+    BinaryFuncC func;
+    int cn;
+    void* usrdata;
+};
+
 
 enum { OCL_OP_ADD=0, OCL_OP_SUB=1, OCL_OP_RSUB=2, OCL_OP_ABSDIFF=3, OCL_OP_MUL=4,
        OCL_OP_MUL_SCALE=5, OCL_OP_DIV_SCALE=6, OCL_OP_RECIP_SCALE=7, OCL_OP_ADDW=8,
@@ -162,6 +235,98 @@ static bool ocl_binary_op(InputArray _src1, InputArray _src2, OutputArray _dst,
 
 #endif
 
+// the operation on the arrays with the different types or the mask, or on an array and a scalar
+class BinaryOpBody : public ElemwiseBody
+{
+public:
+    BinaryOpBody(BinaryFuncC _func, int _cn, size_t _esz, bool _haveScalar, BinaryFunc _copymask)
+        : func(_func), cn(_cn), elemSize(_esz), haveScalar(_haveScalar), copymask(_copymask) {}
+
+    void operator()(const Mat& src1, const Mat& src2, Mat& dst, const Mat& mask) const
+    {
+        bool haveMask = !mask.empty();
+        size_t esz = elemSize, blocksize0 = (BLOCK_SIZE + esz-1)/esz;
+        AutoBuffer<uchar> _buf;
+        uchar *scbuf = 0, *maskbuf = 0;
+
+        if( !haveScalar )
+        {
+            const Mat* arrays[] = { &src1, &src2, &dst, &mask, 0 };
+            uchar* ptrs[4];
+
+            NAryMatIterator it(arrays, ptrs);
+            size_t total = it.size, blocksize = total;
+
+            if( blocksize*cn > INT_MAX )
+                blocksize = INT_MAX/cn;
+
+            if( haveMask )
+            {
+                blocksize = std::min(blocksize, blocksize0);
+                _buf.allocate(blocksize*esz);
+                maskbuf = _buf;
+            }
+
+            for( size_t i = 0; i < it.nplanes; i++, ++it )
+            {
+                for( size_t j = 0; j < total; j += blocksize )
+                {
+                    int bsz = (int)MIN(total - j, blocksize);
+
+                    func( ptrs[0], 0, ptrs[1], 0, haveMask ? maskbuf : ptrs[2], 0, bsz*cn, 1, 0 );
+                    if( haveMask )
+                    {
+                        copymask( maskbuf, 0, ptrs[3], 0, ptrs[2], 0, Size(bsz, 1), &esz );
+                        ptrs[3] += bsz;
+                    }
+
+                    bsz *= (int)esz;
+                    ptrs[0] += bsz; ptrs[1] += bsz; ptrs[2] += bsz;
+                }
+            }
+        }
+        else
+        {
+            const Mat* arrays[] = { &src1, &dst, &mask, 0 };
+            uchar* ptrs[3];
+
+            NAryMatIterator it(arrays, ptrs);
+            size_t total = it.size, blocksize = std::min(total, blocksize0);
+
+            _buf.allocate(blocksize*(haveMask ? 2 : 1)*esz + 32);
+            scbuf = _buf;
+            maskbuf = alignPtr(scbuf + blocksize*esz, 16);
+
+            convertAndUnrollScalar( src2, src1.type(), scbuf, blocksize);
+
+            for( size_t i = 0; i < it.nplanes; i++, ++it )
+            {
+                for( size_t j = 0; j < total; j += blocksize )
+                {
+                    int bsz = (int)MIN(total - j, blocksize);
+
+                    func( ptrs[0], 0, scbuf, 0, haveMask ? maskbuf : ptrs[1], 0, bsz*cn, 1, 0 );
+                    if( haveMask )
+                    {
+                        copymask( maskbuf, 0, ptrs[2], 0, ptrs[1], 0, Size(bsz, 1), &esz );
+                        ptrs[2] += bsz;
+                    }
+
+                    bsz *= (int)esz;
+                    ptrs[0] += bsz; ptrs[1] += bsz;
+                }
+            }
+        }
+    }
+
+protected:
+    BinaryFuncC func;
+    int cn;
+    size_t elemSize;
+    bool haveScalar;
+    BinaryFunc copymask;
+};
+
 static void binary_op( InputArray _src1, InputArray _src2, OutputArray _dst,
                        InputArray _mask, const BinaryFuncC* tab,
                        bool bitwise, int oclop )
@@ -199,8 +364,7 @@ static void binary_op( InputArray _src1, InputArray _src2, OutputArray _dst,
         size_t len = sz.width*(size_t)cn;
         if( len == (size_t)(int)len )
         {
-            sz.width = (int)len;
-            func(src1.ptr(), src1.step, src2.ptr(), src2.step, dst.ptr(), dst.step, sz.width, sz.height, 0);
+            runElemwise(ElemwiseFuncBody(func, cn, 0), src1, src2, dst, Mat(), false);
             return;
         }
     }
@@ -231,7 +395,6 @@ static void binary_op( InputArray _src1, InputArray _src2, OutputArray _dst,
     }
 
     size_t esz = CV_ELEM_SIZE(type1);
-    size_t blocksize0 = (BLOCK_SIZE + esz-1)/esz;
     BinaryFunc copymask = 0;
     bool reallocate = false;
 
@@ -243,9 +406,6 @@ static void binary_op( InputArray _src1, InputArray _src2, OutputArray _dst,
         reallocate = !_dst.sameSize(*psrc1) || _dst.type() != type1;
     }
 
-    AutoBuffer<uchar> _buf;
-    uchar *scbuf = 0, *maskbuf = 0;
-
     _dst.createSameSize(*psrc1, type1);
     // if this is mask operation and dst has been reallocated,
     // we have to clear the destination
@@ -267,74 +427,7 @@ static void binary_op( InputArray _src1, InputArray _src2, OutputArray _dst,
     else
         func = tab[depth1];
 
-    if( !haveScalar )
-    {
-        const Mat* arrays[] = { &src1, &src2, &dst, &mask, 0 };
-        uchar* ptrs[4];
-
-        NAryMatIterator it(arrays, ptrs);
-        size_t total = it.size, blocksize = total;
-
-        if( blocksize*cn > INT_MAX )
-            blocksize = INT_MAX/cn;
-
-        if( haveMask )
-        {
-            blocksize = std::min(blocksize, blocksize0);
-            _buf.allocate(blocksize*esz);
-            maskbuf = _buf;
-        }
-
-        for( size_t i = 0; i < it.nplanes; i++, ++it )
-        {
-            for( size_t j = 0; j < total; j += blocksize )
-            {
-                int bsz = (int)MIN(total - j, blocksize);
-
-                func( ptrs[0], 0, ptrs[1], 0, haveMask ? maskbuf : ptrs[2], 0, bsz*cn, 1, 0 );
-                if( haveMask )
-                {
-                    copymask( maskbuf, 0, ptrs[3], 0, ptrs[2], 0, Size(bsz, 1), &esz );
-                    ptrs[3] += bsz;
-                }
-
-                bsz *= (int)esz;
-                ptrs[0] += bsz; ptrs[1] += bsz; ptrs[2] += bsz;
-            }
-        }
-    }
-    else
-    {
-        const Mat* arrays[] = { &src1, &dst, &mask, 0 };
-        uchar* ptrs[3];
-
-        NAryMatIterator it(arrays, ptrs);
-        size_t total = it.size, blocksize = std::min(total, blocksize0);
-
-        _buf.allocate(blocksize*(haveMask ? 2 : 1)*esz + 32);
-        scbuf = _buf;
-        maskbuf = alignPtr(scbuf + blocksize*esz, 16);
-
-        convertAndUnrollScalar( src2, src1.type(), scbuf, blocksize);
-
-        for( size_t i = 0; i < it.nplanes; i++, ++it )
-        {
-            for( size_t j = 0; j < total; j += blocksize )
-            {
-                int bsz = (int)MIN(total - j, blocksize);
-
-                func( ptrs[0], 0, scbuf, 0, haveMask ? maskbuf : ptrs[1], 0, bsz*cn, 1, 0 );
-                if( haveMask )
-                {
-                    copymask( maskbuf, 0, ptrs[2], 0, ptrs[1], 0, Size(bsz, 1), &esz );
-                    ptrs[2] += bsz;
-                }
-
-                bsz *= (int)esz;
-                ptrs[0] += bsz; ptrs[1] += bsz;
-            }
-        }
-    }
+    runElemwise(BinaryOpBody(func, cn, esz, haveScalar, copymask), src1, src2, dst, mask, haveScalar);
 }
 
 static BinaryFuncC* getMaxTab()
@@ -369,24 +462,32 @@ static BinaryFuncC* getMinTab()
 
 void cv::bitwise_and(InputArray a, InputArray b, OutputArray c, InputArray mask)
 {
+    CV_TRACE_FUNCTION();
+
     BinaryFuncC f = (BinaryFuncC)GET_OPTIMIZED(cv::hal::and8u);
     binary_op(a, b, c, mask, &f, true, OCL_OP_AND);
 }
 
 void cv::bitwise_or(InputArray a, InputArray b, OutputArray c, InputArray mask)
 {
+    CV_TRACE_FUNCTION();
+
     BinaryFuncC f = (BinaryFuncC)GET_OPTIMIZED(cv::hal::or8u);
     binary_op(a, b, c, mask, &f, true, OCL_OP_OR);
 }
 
 void cv::bitwise_xor(InputArray a, InputArray b, OutputArray c, InputArray mask)
 {
+    CV_TRACE_FUNCTION();
+
     BinaryFuncC f = (BinaryFuncC)GET_OPTIMIZED(cv::hal::xor8u);
     binary_op(a, b, c, mask, &f, true, OCL_OP_XOR);
 }
 
 void cv::bitwise_not(InputArray a, OutputArray c, InputArray mask)
 {
+    CV_TRACE_FUNCTION();
+
     BinaryFuncC f = (BinaryFuncC)GET_OPTIMIZED(cv::hal::not8u);
     binary_op(a, a, c, mask, &f, true, OCL_OP_NOT);
 }
@@ -575,6 +676,174 @@ static bool ocl_arithm_op(InputArray _src1, InputArray _src2, OutputArray _dst,
 
 #endif
 
+// the operation on the arrays with the different types or the mask, or on an array and a scalar,
+// the inputs are converted to the working type and the result to the destination type by blocks
+class ArithmOpBody : public ElemwiseBody
+{
+public:
+    ArithmOpBody(BinaryFuncC _func, BinaryFunc _cvtsrc1, BinaryFunc _cvtsrc2, BinaryFunc _cvtdst,
+                 BinaryFunc _copymask, int _type1, int _type2, int _dtype, int _wtype,
+                 bool _haveScalar, bool _swapped12, void* _usrdata)
+        : func(_func), cvtsrc1(_cvtsrc1), cvtsrc2(_cvtsrc2), cvtdst(_cvtdst), copymask(_copymask),
+          wtype(_wtype), cn(CV_MAT_CN(_type1)), haveScalar(_haveScalar), swapped12(_swapped12), usrdata(_usrdata)
+    {
+        esz1 = CV_ELEM_SIZE(_type1); esz2 = CV_ELEM_SIZE(_type2);
+        dsz = CV_ELEM_SIZE(_dtype); wsz = CV_ELEM_SIZE(_wtype);
+    }
+
+    void operator()(const Mat& src1, const Mat& src2, Mat& dst, const Mat& mask) const
+    {
+        bool haveMask = !mask.empty();
+        size_t dsz0 = dsz, blocksize0 = (size_t)(BLOCK_SIZE + wsz-1)/wsz;
+        size_t bufesz = (cvtsrc1 ? wsz : 0) +
+                        (cvtsrc2 || haveScalar ? wsz : 0) +
+                        (cvtdst ? wsz : 0) +
+                        (haveMask ? dsz : 0);
+
+        AutoBuffer<uchar> _buf;
+        uchar *buf, *maskbuf = 0, *buf1 = 0, *buf2 = 0, *wbuf = 0;
+
+        if( !haveScalar )
+        {
+            const Mat* arrays[] = { &src1, &src2, &dst, &mask, 0 };
+            uchar* ptrs[4];
+
+            NAryMatIterator it(arrays, ptrs);
+            size_t total = it.size, blocksize = total;
+
+            if( haveMask || cvtsrc1 || cvtsrc2 || cvtdst )
+                blocksize = std::min(blocksize, blocksize0);
+
+            _buf.allocate(bufesz*blocksize + 64);
+            buf = _buf;
+            if( cvtsrc1 )
+                buf1 = buf, buf = alignPtr(buf + blocksize*wsz, 16);
+            if( cvtsrc2 )
+                buf2 = buf, buf = alignPtr(buf + blocksize*wsz, 16);
+            wbuf = maskbuf = buf;
+            if( cvtdst )
+                buf = alignPtr(buf + blocksize*wsz, 16);
+            if( haveMask )
+                maskbuf = buf;
+
+            for( size_t i = 0; i < it.nplanes; i++, ++it )
+            {
+                for( size_t j = 0; j < total; j += blocksize )
+                {
+                    int bsz = (int)MIN(total - j, blocksize);
+                    Size bszn(bsz*cn, 1);
+                    const uchar *sptr1 = ptrs[0], *sptr2 = ptrs[1];
+                    uchar* dptr = ptrs[2];
+                    if( cvtsrc1 )
+                    {
+                        cvtsrc1( sptr1, 1, 0, 1, buf1, 1, bszn, 0 );
+                        sptr1 = buf1;
+                    }
+                    if( ptrs[0] == ptrs[1] )
+                        sptr2 = sptr1;
+                    else if( cvtsrc2 )
+                    {
+                        cvtsrc2( sptr2, 1, 0, 1, buf2, 1, bszn, 0 );
+                        sptr2 = buf2;
+                    }
+
+                    if( !haveMask && !cvtdst )
+                        func( sptr1, 1, sptr2, 1, dptr, 1, bszn.width, bszn.height, usrdata );
+                    else
+                    {
+                        func( sptr1, 1, sptr2, 1, wbuf, 0, bszn.width, bszn.height, usrdata );
+                        if( !haveMask )
+                            cvtdst( wbuf, 1, 0, 1, dptr, 1, bszn, 0 );
+                        else if( !cvtdst )
+                        {
+                            copymask( wbuf, 1, ptrs[3], 1, dptr, 1, Size(bsz, 1), &dsz0 );
+                            ptrs[3] += bsz;
+                        }
+                        else
+                        {
+                            cvtdst( wbuf, 1, 0, 1, maskbuf, 1, bszn, 0 );
+                            copymask( maskbuf, 1, ptrs[3], 1, dptr, 1, Size(bsz, 1), &dsz0 );
+                            ptrs[3] += bsz;
+                        }
+                    }
+                    ptrs[0] += bsz*esz1; ptrs[1] += bsz*esz2; ptrs[2] += bsz*dsz;
+                }
+            }
+        }
+        else
+        {
+            const Mat* arrays[] = { &src1, &dst, &mask, 0 };
+            uchar* ptrs[3];
+
+            NAryMatIterator it(arrays, ptrs);
+            size_t total = it.size, blocksize = std::min(total, blocksize0);
+
+            _buf.allocate(bufesz*blocksize + 64);
+            buf = _buf;
+            if( cvtsrc1 )
+                buf1 = buf, buf = alignPtr(buf + blocksize*wsz, 16);
+            buf2 = buf; buf = alignPtr(buf + blocksize*wsz, 16);
+            wbuf = maskbuf = buf;
+            if( cvtdst )
+                buf = alignPtr(buf + blocksize*wsz, 16);
+            if( haveMask )
+                maskbuf = buf;
+
+            convertAndUnrollScalar( src2, wtype, buf2, blocksize);
+
+            for( size_t i = 0; i < it.nplanes; i++, ++it )
+            {
+                for( size_t j = 0; j < total; j += blocksize )
+                {
+                    int bsz = (int)MIN(total - j, blocksize);
+                    Size bszn(bsz*cn, 1);
+                    const uchar *sptr1 = ptrs[0];
+                    const uchar* sptr2 = buf2;
+                    uchar* dptr = ptrs[1];
+
+                    if( cvtsrc1 )
+                    {
+                        cvtsrc1( sptr1, 1, 0, 1, buf1, 1, bszn, 0 );
+                        sptr1 = buf1;
+                    }
+
+                    if( swapped12 )
+                        std::swap(sptr1, sptr2);
+
+                    if( !haveMask && !cvtdst )
+                        func( sptr1, 1, sptr2, 1, dptr, 1, bszn.width, bszn.height, usrdata );
+                    else
+                    {
+                        func( sptr1, 1, sptr2, 1, wbuf, 1, bszn.width, bszn.height, usrdata );
+                        if( !haveMask )
+                            cvtdst( wbuf, 1, 0, 1, dptr, 1, bszn, 0 );
+                        else if( !cvtdst )
+                        {
+                            copymask( wbuf, 1, ptrs[2], 1, dptr, 1, Size(bsz, 1), &dsz0 );
+                            ptrs[2] += bsz;
+                        }
+                        else
+                        {
+                            cvtdst( wbuf, 1, 0, 1, maskbuf, 1, bszn, 0 );
+                            copymask( maskbuf, 1, ptrs[2], 1, dptr, 1, Size(bsz, 1), &dsz0 );
+                            ptrs[2] += bsz;
+                        }
+                    }
+                    ptrs[0] += bsz*esz1; ptrs[1] += bsz*dsz;
+                }
+            }
+        }
+    }
+
+protected:
+    BinaryFuncC func;
+    BinaryFunc cvtsrc1, cvtsrc2, cvtdst, copymask;
+    size_t esz1, esz2, dsz, wsz;
+    int wtype, cn;
+    bool haveScalar, swapped12;
+    void* usrdata;
+};
+
 static void arithm_op(InputArray _src1, InputArray _src2, OutputArray _dst,
                       InputArray _mask, int dtype, BinaryFuncC* tab, bool muldiv=false,
                       void* usrdata=0, int oclop=-1 )
@@ -606,8 +875,7 @@ static void arithm_op(InputArray _src1, InputArray _src2, OutputArray _dst,
                           usrdata, oclop, false))
 
         Mat src1 = psrc1->getMat(), src2 = psrc2->getMat(), dst = _dst.getMat();
-        Size sz = getContinuousSize(src1, src2, dst, src1.channels());
-        tab[depth1](src1.ptr(), src1.step, src2.ptr(), src2.step, dst.ptr(), dst.step, sz.width, sz.height, usrdata);
+        runElemwise(ElemwiseFuncBody(tab[depth1], src1.channels(), usrdata), src1, src2, dst, Mat(), false);
         return;
     }
 
@@ -708,150 +976,12 @@ static void arithm_op(InputArray _src1, InputArray _src2, OutputArray _dst,
     BinaryFunc cvtsrc2 = type2 == type1 ? cvtsrc1 : type2 == wtype ? 0 : getConvertFunc(type2, wtype);
     BinaryFunc cvtdst = dtype == wtype ? 0 : getConvertFunc(wtype, dtype);
 
-    size_t esz1 = CV_ELEM_SIZE(type1), esz2 = CV_ELEM_SIZE(type2);
-    size_t dsz = CV_ELEM_SIZE(dtype), wsz = CV_ELEM_SIZE(wtype);
-    size_t blocksize0 = (size_t)(BLOCK_SIZE + wsz-1)/wsz;
-    BinaryFunc copymask = getCopyMaskFunc(dsz);
+    BinaryFunc copymask = getCopyMaskFunc(CV_ELEM_SIZE(dtype));
     Mat src1 = psrc1->getMat(), src2 = psrc2->getMat(), dst = _dst.getMat(), mask = _mask.getMat();
-
-    AutoBuffer<uchar> _buf;
-    uchar *buf, *maskbuf = 0, *buf1 = 0, *buf2 = 0, *wbuf = 0;
-    size_t bufesz = (cvtsrc1 ? wsz : 0) +
-                    (cvtsrc2 || haveScalar ? wsz : 0) +
-                    (cvtdst ? wsz : 0) +
-                    (haveMask ? dsz : 0);
     BinaryFuncC func = tab[CV_MAT_DEPTH(wtype)];
 
-    if( !haveScalar )
-    {
-        const Mat* arrays[] = { &src1, &src2, &dst, &mask, 0 };
-        uchar* ptrs[4];
-
-        NAryMatIterator it(arrays, ptrs);
-        size_t total = it.size, blocksize = total;
-
-        if( haveMask || cvtsrc1 || cvtsrc2 || cvtdst )
-            blocksize = std::min(blocksize, blocksize0);
-
-        _buf.allocate(bufesz*blocksize + 64);
-        buf = _buf;
-        if( cvtsrc1 )
-            buf1 = buf, buf = alignPtr(buf + blocksize*wsz, 16);
-        if( cvtsrc2 )
-            buf2 = buf, buf = alignPtr(buf + blocksize*wsz, 16);
-        wbuf = maskbuf = buf;
-        if( cvtdst )
-            buf = alignPtr(buf + blocksize*wsz, 16);
-        if( haveMask )
-            maskbuf = buf;
-
-        for( size_t i = 0; i < it.nplanes; i++, ++it )
-        {
-            for( size_t j = 0; j < total; j += blocksize )
-            {
-                int bsz = (int)MIN(total - j, blocksize);
-                Size bszn(bsz*cn, 1);
-                const uchar *sptr1 = ptrs[0], *sptr2 = ptrs[1];
-                uchar* dptr = ptrs[2];
-                if( cvtsrc1 )
-                {
-                    cvtsrc1( sptr1, 1, 0, 1, buf1, 1, bszn, 0 );
-                    sptr1 = buf1;
-                }
-                if( ptrs[0] == ptrs[1] )
-                    sptr2 = sptr1;
-                else if( cvtsrc2 )
-                {
-                    cvtsrc2( sptr2, 1, 0, 1, buf2, 1, bszn, 0 );
-                    sptr2 = buf2;
-                }
-
-                if( !haveMask && !cvtdst )
-                    func( sptr1, 1, sptr2, 1, dptr, 1, bszn.width, bszn.height, usrdata );
-                else
-                {
-                    func( sptr1, 1, sptr2, 1, wbuf, 0, bszn.width, bszn.height, usrdata );
-                    if( !haveMask )
-                        cvtdst( wbuf, 1, 0, 1, dptr, 1, bszn, 0 );
-                    else if( !cvtdst )
-                    {
-                        copymask( wbuf, 1, ptrs[3], 1, dptr, 1, Size(bsz, 1), &dsz );
-                        ptrs[3] += bsz;
-                    }
-                    else
-                    {
-                        cvtdst( wbuf, 1, 0, 1, maskbuf, 1, bszn, 0 );
-                        copymask( maskbuf, 1, ptrs[3], 1, dptr, 1, Size(bsz, 1), &dsz );
-                        ptrs[3] += bsz;
-                    }
-                }
-                ptrs[0] += bsz*esz1; ptrs[1] += bsz*esz2; ptrs[2] += bsz*dsz;
-            }
-        }
-    }
-    else
-    {
-        const Mat* arrays[] = { &src1, &dst, &mask, 0 };
-        uchar* ptrs[3];
-
-        NAryMatIterator it(arrays, ptrs);
-        size_t total = it.size, blocksize = std::min(total, blocksize0);
-
-        _buf.allocate(bufesz*blocksize + 64);
-        buf = _buf;
-        if( cvtsrc1 )
-            buf1 = buf, buf = alignPtr(buf + blocksize*wsz, 16);
-        buf2 = buf; buf = alignPtr(buf + blocksize*wsz, 16);
-        wbuf = maskbuf = buf;
-        if( cvtdst )
-            buf = alignPtr(buf + blocksize*wsz, 16);
-        if( haveMask )
-            maskbuf = buf;
-
-        convertAndUnrollScalar( src2, wtype, buf2, blocksize);
-
-        for( size_t i = 0; i < it.nplanes; i++, ++it )
-        {
-            for( size_t j = 0; j < total; j += blocksize )
-            {
-                int bsz = (int)MIN(total - j, blocksize);
-                Size bszn(bsz*cn, 1);
-                const uchar *sptr1 = ptrs[0];
-                const uchar* sptr2 = buf2;
-                uchar* dptr = ptrs[1];
-
-                if( cvtsrc1 )
-                {
-                    cvtsrc1( sptr1, 1, 0, 1, buf1, 1, bszn, 0 );
-                    sptr1 = buf1;
-                }
-
-                if( swapped12 )
-                    std::swap(sptr1, sptr2);
-
-                if( !haveMask && !cvtdst )
-                    func( sptr1, 1, sptr2, 1, dptr, 1, bszn.width, bszn.height, usrdata );
-                else
-                {
-                    func( sptr1, 1, sptr2, 1, wbuf, 1, bszn.width, bszn.height, usrdata );
-                    if( !haveMask )
-                        cvtdst( wbuf, 1, 0, 1, dptr, 1, bszn, 0 );
-                    else if( !cvtdst )
-                    {
-                        copymask( wbuf, 1, ptrs[2], 1, dptr, 1, Size(bsz, 1), &dsz );
-                        ptrs[2] += bsz;
-                    }
-                    else
-                    {
-                        cvtdst( wbuf, 1, 0, 1, maskbuf, 1, bszn, 0 );
-                        copymask( maskbuf, 1, ptrs[2], 1, dptr, 1, Size(bsz, 1), &dsz );
-                        ptrs[2] += bsz;
-                    }
-                }
-                ptrs[0] += bsz*esz1; ptrs[1] += bsz*dsz;
-            }
-        }
-    }
+    runElemwise(ArithmOpBody(func, cvtsrc1, cvtsrc2, cvtdst, copymask, type1, type2, dtype, wtype,
+                             haveScalar, swapped12, usrdata), src1, src2, dst, mask, haveScalar);
 }
 
 static BinaryFuncC* getAddTab()
@@ -901,12 +1031,16 @@ static BinaryFuncC* getAbsDiffTab()
 void cv::add( InputArray src1, InputArray src2, OutputArray dst,
           InputArray mask, int dtype )
 {
+    CV_TRACE_FUNCTION();
+
     arithm_op(src1, src2, dst, mask, dtype, getAddTab(), false, 0, OCL_OP_ADD );
 }
 
 void cv::subtract( InputArray _src1, InputArray _src2, OutputArray _dst,
                InputArray mask, int dtype )
 {
+    CV_TRACE_FUNCTION();
+
 #ifdef HAVE_TEGRA_OPTIMIZATION
     if (tegra::useTegra())
     {
@@ -965,6 +1099,8 @@ void cv::subtract( InputArray _src1, InputArray _src2, OutputArray _dst,
 
 void cv::absdiff( InputArray src1, InputArray src2, OutputArray dst )
 {
+    CV_TRACE_FUNCTION();
+
     arithm_op(src1, src2, dst, noArray(), -1, getAbsDiffTab(), false, 0, OCL_OP_ABSDIFF);
 }
 
@@ -1016,6 +1152,8 @@ static BinaryFuncC* getRecipTab()
 void cv::multiply(InputArray src1, InputArray src2,
                   OutputArray dst, double scale, int dtype)
 {
+    CV_TRACE_FUNCTION();
+
     arithm_op(src1, src2, dst, noArray(), dtype, getMulTab(),
               true, &scale, std::abs(scale - 1.0) < DBL_EPSILON ? OCL_OP_MUL : OCL_OP_MUL_SCALE);
 }
@@ -1023,12 +1161,16 @@ void cv::multiply(InputArray src1, InputArray src2,
 void cv::divide(InputArray src1, InputArray src2,
                 OutputArray dst, double scale, int dtype)
 {
+    CV_TRACE_FUNCTION();
+
     arithm_op(src1, src2, dst, noArray(), dtype, getDivTab(), true, &scale, OCL_OP_DIV_SCALE);
 }
 
 void cv::divide(double scale, InputArray src2,
                 OutputArray dst, int dtype)
 {
+    CV_TRACE_FUNCTION();
+
     arithm_op(src2, src2, dst, noArray(), dtype, getRecipTab(), true, &scale, OCL_OP_RECIP_SCALE);
 }
 
@@ -1056,6 +1198,8 @@ static BinaryFuncC* getAddWeightedTab()
 void cv::addWeighted( InputArray src1, double alpha, InputArray src2,
                       double beta, double gamma, OutputArray dst, int dtype )
 {
+    CV_TRACE_FUNCTION();
+
     double scalars[] = {alpha, beta, gamma};
     arithm_op(src1, src2, dst, noArray(), dtype, getAddWeightedTab(), true, scalars, OCL_OP_ADDW);
 }
@@ -1190,10 +1334,67 @@ static bool ocl_compare(InputArray _src1, InputArray _src2, OutputArray _dst, in
 
 #endif
 
+// the comparison of the multi-dimensional arrays or of an array and a scalar,
+// the arrays are single-channel, the scalar is converted to the array depth by blocks
+class CompareBody : public ElemwiseBody
+{
+public:
+    CompareBody(BinaryFuncC _func, int _op, bool _haveScalar)
+        : func(_func), op(_op), haveScalar(_haveScalar) {}
+
+    void operator()(const Mat& src1, const Mat& src2, Mat& dst, const Mat&) const
+    {
+        int cmpop = op;
+
+        if( !haveScalar )
+        {
+            const Mat* arrays[] = { &src1, &src2, &dst, 0 };
+            uchar* ptrs[3];
+
+            NAryMatIterator it(arrays, ptrs);
+            size_t total = it.size;
+
+            for( size_t i = 0; i < it.nplanes; i++, ++it )
+                func( ptrs[0], 0, ptrs[1], 0, ptrs[2], 0, (int)total, 1, &cmpop );
+        }
+        else
+        {
+            const Mat* arrays[] = { &src1, &dst, 0 };
+            uchar* ptrs[2];
+
+            NAryMatIterator it(arrays, ptrs);
+            size_t esz = src1.elemSize(), blocksize0 = (size_t)(BLOCK_SIZE + esz-1)/esz;
+            size_t total = it.size, blocksize = std::min(total, blocksize0);
+
+            AutoBuffer<uchar> _buf(blocksize*esz);
+            uchar *buf = _buf;
+            convertAndUnrollScalar( src2, src1.depth(), buf, blocksize );
+
+            for( size_t i = 0; i < it.nplanes; i++, ++it )
+            {
+                for( size_t j = 0; j < total; j += blocksize )
+                {
+                    int bsz = (int)MIN(total - j, blocksize);
+                    func( ptrs[0], 0, buf, 0, ptrs[1], 0, bsz, 1, &cmpop );
+                    ptrs[0] += bsz*esz;
+                    ptrs[1] += bsz;
+                }
+            }
+        }
+    }
+
+protected:
+    BinaryFuncC func;
+    int op;
+    bool haveScalar;
+};
+
 }
 
 void cv::compare(InputArray _src1, InputArray _src2, OutputArray _dst, int op)
 {
+    CV_TRACE_FUNCTION();
+
     CV_Assert( op == CMP_LT || op == CMP_LE || op == CMP_EQ ||
                op == CMP_NE || op == CMP_GE || op == CMP_GT );
 
@@ -1229,8 +1430,7 @@ void cv::compare(InputArray _src1, InputArray _src2, OutputArray _dst, int op)
         int cn = src1.channels();
         _dst.create(src1.size(), CV_8UC(cn));
         Mat dst = _dst.getMat();
-        Size sz = getContinuousSize(src1, src2, dst, src1.channels());
-        getCmpFunc(src1.depth())(src1.ptr(), src1.step, src2.ptr(), src2.step, dst.ptr(), dst.step, sz.width, sz.height, &op);
+        runElemwise(ElemwiseFuncBody(getCmpFunc(src1.depth()), cn, &op), src1, src2, dst, Mat(), false);
         return;
     }
 
@@ -1240,77 +1440,40 @@ void cv::compare(InputArray _src1, InputArray _src2, OutputArray _dst, int op)
     src1 = src1.reshape(1); src2 = src2.reshape(1);
     Mat dst = _dst.getMat().reshape(1);
 
-    size_t esz = src1.elemSize();
-    size_t blocksize0 = (size_t)(BLOCK_SIZE + esz-1)/esz;
-    BinaryFuncC func = getCmpFunc(depth1);
-
-    if( !haveScalar )
-    {
-        const Mat* arrays[] = { &src1, &src2, &dst, 0 };
-        uchar* ptrs[3];
-
-        NAryMatIterator it(arrays, ptrs);
-        size_t total = it.size;
-
-        for( size_t i = 0; i < it.nplanes; i++, ++it )
-            func( ptrs[0], 0, ptrs[1], 0, ptrs[2], 0, (int)total, 1, &op );
-    }
-    else
+    Mat scalar = src2;
+    if( haveScalar && depth1 <= CV_32S )
     {
-        const Mat* arrays[] = { &src1, &dst, 0 };
-        uchar* ptrs[2];
-
-        NAryMatIterator it(arrays, ptrs);
-        size_t total = it.size, blocksize = std::min(total, blocksize0);
-
-        AutoBuffer<uchar> _buf(blocksize*esz);
-        uchar *buf = _buf;
-
-        if( depth1 > CV_32S )
-            convertAndUnrollScalar( src2, depth1, buf, blocksize );
-        else
+        double fval=0;
+        getConvertFunc(depth2, CV_64F)(src2.ptr(), 1, 0, 1, (uchar*)&fval, 1, Size(1,1), 0);
+        if( fval < getMinVal(depth1) )
         {
-            double fval=0;
-            getConvertFunc(depth2, CV_64F)(src2.ptr(), 1, 0, 1, (uchar*)&fval, 1, Size(1,1), 0);
-            if( fval < getMinVal(depth1) )
-            {
-                dst = Scalar::all(op == CMP_GT || op == CMP_GE || op == CMP_NE ? 255 : 0);
-                return;
-            }
-
-            if( fval > getMaxVal(depth1) )
-            {
-                dst = Scalar::all(op == CMP_LT || op == CMP_LE || op == CMP_NE ? 255 : 0);
-                return;
-            }
+            dst = Scalar::all(op == CMP_GT || op == CMP_GE || op == CMP_NE ? 255 : 0);
+            return;
+        }
 
-            int ival = cvRound(fval);
-            if( fval != ival )
-            {
-                if( op == CMP_LT || op == CMP_GE )
-                    ival = cvCeil(fval);
-                else if( op == CMP_LE || op == CMP_GT )
-                    ival = cvFloor(fval);
-                else
-                {
-                    dst = Scalar::all(op == CMP_NE ? 255 : 0);
-                    return;
-                }
-            }
-            convertAndUnrollScalar(Mat(1, 1, CV_32S, &ival), depth1, buf, blocksize);
+        if( fval > getMaxVal(depth1) )
+        {
+            dst = Scalar::all(op == CMP_LT || op == CMP_LE || op == CMP_NE ? 255 : 0);
+            return;
         }
 
-        for( size_t i = 0; i < it.nplanes; i++, ++it )
+        int ival = cvRound(fval);
+        if( fval != ival )
         {
-            for( size_t j = 0; j < total; j += blocksize )
+            if( op == CMP_LT || op == CMP_GE )
+                ival = cvCeil(fval);
+            else if( op == CMP_LE || op == CMP_GT )
+                ival = cvFloor(fval);
+            else
             {
-                int bsz = (int)MIN(total - j, blocksize);
-                func( ptrs[0], 0, buf, 0, ptrs[1], 0, bsz, 1, &op);
-                ptrs[0] += bsz*esz;
-                ptrs[1] += bsz;
+                dst = Scalar::all(op == CMP_NE ? 255 : 0);
+                return;
             }
         }
+        scalar = Mat(1, 1, CV_32S, Scalar(ival));
     }
+
+    runElemwise(CompareBody(getCmpFunc(depth1), op, haveScalar), src1, scalar, dst, Mat(), haveScalar);
 }
 
 /****************************************************************************************\
@@ -1889,6 +2052,8 @@ static bool ocl_inRange( InputArray _src, InputArray _lowerb,
 void cv::inRange(InputArray _src, InputArray _lowerb,
                  InputArray _upperb, OutputArray _dst)
 {
+    CV_TRACE_FUNCTION();
+
     CV_OCL_RUN(_src.dims() <= 2 && _lowerb.dims() <= 2 &&
                _upperb.dims() <= 2 && OCL_PERFORMANCE_CHECK(_dst.isUMat()),
                ocl_inRange(_src, _lowerb, _upperb, _dst))
@@ -2336,7 +2501,7 @@ void add8u( const uchar* src1, size_t step1,
 {
     CALL_HAL(add8u, cv_hal_add8u, src1, step1, src2, step2, dst, step, width, height)
     CALL_IPP_BIN_E_12(ippiAdd_8u_C1RSfs)
-    (vBinOp<uchar, cv::OpAdd<uchar>, IF_SIMD(VAdd<uchar>)>(src1, step1, src2, step2, dst, step, width, height));
+    (vBinOpDispatched<uchar, cv::OpAdd<uchar>, Add_SIMD<uchar> >(src1, step1, src2, step2, dst, step, width, height));
 }
 
 void add8s( const schar* src1, size_t step1,
@@ -2344,7 +2509,7 @@ void add8s( const schar* src1, size_t step1,
                    schar* dst, size_t step, int width, int height, void* )
 {
     CALL_HAL(add8s, cv_hal_add8s, src1, step1, src2, step2, dst, step, width, height)
-    vBinOp<schar, cv::OpAdd<schar>, IF_SIMD(VAdd<schar>)>(src1, step1, src2, step2, dst, step, width, height);
+    vBinOpDispatched<schar, cv::OpAdd<schar>, Add_SIMD<schar> >(src1, step1, src2, step2, dst, step, width, height);
 }
 
 void add16u( const ushort* src1, size_t step1,
@@ -2353,7 +2518,7 @@ void add16u( const ushort* src1, size_t step1,
 {
     CALL_HAL(add16u, cv_hal_add16u, src1, step1, src2, step2, dst, step, width, height)
     CALL_IPP_BIN_E_12(ippiAdd_16u_C1RSfs)
-    (vBinOp<ushort, cv::OpAdd<ushort>, IF_SIMD(VAdd<ushort>)>(src1, step1, src2, step2, dst, step, width, height));
+    (vBinOpDispatched<ushort, cv::OpAdd<ushort>, Add_SIMD<ushort> >(src1, step1, src2, step2, dst, step, width, height));
 }
 
 void add16s( const short* src1, size_t step1,
@@ -2362,7 +2527,7 @@ void add16s( const short* src1, size_t step1,
 {
     CALL_HAL(add16s, cv_hal_add16s, src1, step1, src2, step2, dst, step, width, height)
     CALL_IPP_BIN_E_12(ippiAdd_16s_C1RSfs)
-    (vBinOp<short, cv::OpAdd<short>, IF_SIMD(VAdd<short>)>(src1, step1, src2, step2, dst, step, width, height));
+    (vBinOpDispatched<short, cv::OpAdd<short>, Add_SIMD<short> >(src1, step1, src2, step2, dst, step, width, height));
 }
 
 void add32s( const int* src1, size_t step1,
@@ -2370,7 +2535,7 @@ void add32s( const int* src1, size_t step1,
                     int* dst, size_t step, int width, int height, void* )
 {
     CALL_HAL(add32s, cv_hal_add32s, src1, step1, src2, step2, dst, step, width, height)
-    vBinOp32<int, cv::OpAdd<int>, IF_SIMD(VAdd<int>)>(src1, step1, src2, step2, dst, step, width, height);
+    vBinOpDispatched<int, cv::OpAdd<int>, Add_SIMD<int> >(src1, step1, src2, step2, dst, step, width, height);
 }
 
 void add32f( const float* src1, size_t step1,
@@ -2379,7 +2544,7 @@ void add32f( const float* src1, size_t step1,
 {
     CALL_HAL(add32f, cv_hal_add32f, src1, step1, src2, step2, dst, step, width, height)
     CALL_IPP_BIN_12(ippiAdd_32f_C1R)
-    (vBinOp32<float, cv::OpAdd<float>, IF_SIMD(VAdd<float>)>(src1, step1, src2, step2, dst, step, width, height));
+    (vBinOpDispatched<float, cv::OpAdd<float>, Add_SIMD<float> >(src1, step1, src2, step2, dst, step, width, height));
 }
 
 void add64f( const double* src1, size_t step1,
@@ -2387,7 +2552,7 @@ void add64f( const double* src1, size_t step1,
                     double* dst, size_t step, int width, int height, void* )
 {
     CALL_HAL(add64f, cv_hal_add64f, src1, step1, src2, step2, dst, step, width, height)
-    vBinOp64<double, cv::OpAdd<double>, IF_SIMD(VAdd<double>)>(src1, step1, src2, step2, dst, step, width, height);
+    vBinOpDispatched<double, cv::OpAdd<double>, Add_SIMD<double> >(src1, step1, src2, step2, dst, step, width, height);
 }
 
 //=======================================
@@ -2400,7 +2565,7 @@ void sub8u( const uchar* src1, size_t step1,
 {
     CALL_HAL(sub8u, cv_hal_sub8u, src1, step1, src2, step2, dst, step, width, height)
     CALL_IPP_BIN_E_21(ippiSub_8u_C1RSfs)
-    (vBinOp<uchar, cv::OpSub<uchar>, IF_SIMD(VSub<uchar>)>(src1, step1, src2, step2, dst, step, width, height));
+    (vBinOpDispatched<uchar, cv::OpSub<uchar>, Sub_SIMD<uchar> >(src1, step1, src2, step2, dst, step, width, height));
 }
 
 void sub8s( const schar* src1, size_t step1,
@@ -2408,7 +2573,7 @@ void sub8s( const schar* src1, size_t step1,
                    schar* dst, size_t step, int width, int height, void* )
 {
     CALL_HAL(sub8s, cv_hal_sub8s, src1, step1, src2, step2, dst, step, width, height)
-    vBinOp<schar, cv::OpSub<schar>, IF_SIMD(VSub<schar>)>(src1, step1, src2, step2, dst, step, width, height);
+    vBinOpDispatched<schar, cv::OpSub<schar>, Sub_SIMD<schar> >(src1, step1, src2, step2, dst, step, width, height);
 }
 
 void sub16u( const ushort* src1, size_t step1,
@@ -2417,7 +2582,7 @@ void sub16u( const ushort* src1, size_t step1,
 {
     CALL_HAL(sub16u, cv_hal_sub16u, src1, step1, src2, step2, dst, step, width, height)
     CALL_IPP_BIN_E_21(ippiSub_16u_C1RSfs)
-    (vBinOp<ushort, cv::OpSub<ushort>, IF_SIMD(VSub<ushort>)>(src1, step1, src2, step2, dst, step, width, height));
+    (vBinOpDispatched<ushort, cv::OpSub<ushort>, Sub_SIMD<ushort> >(src1, step1, src2, step2, dst, step, width, height));
 }
 
 void sub16s( const short* src1, size_t step1,
@@ -2426,7 +2591,7 @@ void sub16s( const short* src1, size_t step1,
 {
     CALL_HAL(sub16s, cv_hal_sub16s, src1, step1, src2, step2, dst, step, width, height)
     CALL_IPP_BIN_E_21(ippiSub_16s_C1RSfs)
-    (vBinOp<short, cv::OpSub<short>, IF_SIMD(VSub<short>)>(src1, step1, src2, step2, dst, step, width, height));
+    (vBinOpDispatched<short, cv::OpSub<short>, Sub_SIMD<short> >(src1, step1, src2, step2, dst, step, width, height));
 }
 
 void sub32s( const int* src1, size_t step1,
@@ -2434,7 +2599,7 @@ void sub32s( const int* src1, size_t step1,
                     int* dst, size_t step, int width, int height, void* )
 {
     CALL_HAL(sub32s, cv_hal_sub32s, src1, step1, src2, step2, dst, step, width, height)
-    vBinOp32<int, cv::OpSub<int>, IF_SIMD(VSub<int>)>(src1, step1, src2, step2, dst, step, width, height);
+    vBinOpDispatched<int, cv::OpSub<int>, Sub_SIMD<int> >(src1, step1, src2, step2, dst, step, width, height);
 }
 
 void sub32f( const float* src1, size_t step1,
@@ -2443,7 +2608,7 @@ void sub32f( const float* src1, size_t step1,
 {
     CALL_HAL(sub32f, cv_hal_sub32f, src1, step1, src2, step2, dst, step, width, height)
     CALL_IPP_BIN_21(ippiSub_32f_C1R)
-    (vBinOp32<float, cv::OpSub<float>, IF_SIMD(VSub<float>)>(src1, step1, src2, step2, dst, step, width, height));
+    (vBinOpDispatched<float, cv::OpSub<float>, Sub_SIMD<float> >(src1, step1, src2, step2, dst, step, width, height));
 }
 
 void sub64f( const double* src1, size_t step1,
@@ -2451,7 +2616,7 @@ void sub64f( const double* src1, size_t step1,
                     double* dst, size_t step, int width, int height, void* )
 {
     CALL_HAL(sub64f, cv_hal_sub64f, src1, step1, src2, step2, dst, step, width, height)
-    vBinOp64<double, cv::OpSub<double>, IF_SIMD(VSub<double>)>(src1, step1, src2, step2, dst, step, width, height);
+    vBinOpDispatched<double, cv::OpSub<double>, Sub_SIMD<double> >(src1, step1, src2, step2, dst, step, width, height);
 }
 
 //=======================================
@@ -2622,7 +2787,7 @@ void absdiff8u( const uchar* src1, size_t step1,
 {
     CALL_HAL(absdiff8u, cv_hal_absdiff8u, src1, step1, src2, step2, dst, step, width, height)
     CALL_IPP_BIN_12(ippiAbsDiff_8u_C1R)
-    (vBinOp<uchar, cv::OpAbsDiff<uchar>, IF_SIMD(VAbsDiff<uchar>)>(src1, step1, src2, step2, dst, step, width, height));
+    (vBinOpDispatched<uchar, cv::OpAbsDiff<uchar>, AbsDiff_SIMD<uchar> >(src1, step1, src2, step2, dst, step, width, height));
 }
 
 void absdiff8s( const schar* src1, size_t step1,
@@ -2630,7 +2795,7 @@ void absdiff8s( const schar* src1, size_t step1,
                        schar* dst, size_t step, int width, int height, void* )
 {
     CALL_HAL(absdiff8s, cv_hal_absdiff8s, src1, step1, src2, step2, dst, step, width, height)
-    vBinOp<schar, cv::OpAbsDiff<schar>, IF_SIMD(VAbsDiff<schar>)>(src1, step1, src2, step2, dst, step, width, height);
+    vBinOpDispatched<schar, cv::OpAbsDiff<schar>, AbsDiff_SIMD<schar> >(src1, step1, src2, step2, dst, step, width, height);
 }
 
 void absdiff16u( const ushort* src1, size_t step1,
@@ -2639,7 +2804,7 @@ void absdiff16u( const ushort* src1, size_t step1,
 {
     CALL_HAL(absdiff16u, cv_hal_absdiff16u, src1, step1, src2, step2, dst, step, width, height)
     CALL_IPP_BIN_12(ippiAbsDiff_16u_C1R)
-    (vBinOp<ushort, cv::OpAbsDiff<ushort>, IF_SIMD(VAbsDiff<ushort>)>(src1, step1, src2, step2, dst, step, width, height));
+    (vBinOpDispatched<ushort, cv::OpAbsDiff<ushort>, AbsDiff_SIMD<ushort> >(src1, step1, src2, step2, dst, step, width, height));
 }
 
 void absdiff16s( const short* src1, size_t step1,
@@ -2647,7 +2812,7 @@ void absdiff16s( const short* src1, size_t step1,
                         short* dst, size_t step, int width, int height, void* )
 {
     CALL_HAL(absdiff16s, cv_hal_absdiff16s, src1, step1, src2, step2, dst, step, width, height)
-    vBinOp<short, cv::OpAbsDiff<short>, IF_SIMD(VAbsDiff<short>)>(src1, step1, src2, step2, dst, step, width, height);
+    vBinOpDispatched<short, cv::OpAbsDiff<short>, AbsDiff_SIMD<short> >(src1, step1, src2, step2, dst, step, width, height);
 }
 
 void absdiff32s( const int* src1, size_t step1,
@@ -2655,7 +2820,7 @@ void absdiff32s( const int* src1, size_t step1,
                         int* dst, size_t step, int width, int height, void* )
 {
     CALL_HAL(absdiff32s, cv_hal_absdiff32s, src1, step1, src2, step2, dst, step, width, height)
-    vBinOp32<int, cv::OpAbsDiff<int>, IF_SIMD(VAbsDiff<int>)>(src1, step1, src2, step2, dst, step, width, height);
+    vBinOpDispatched<int, cv::OpAbsDiff<int>, AbsDiff_SIMD<int> >(src1, step1, src2, step2, dst, step, width, height);
 }
 
 void absdiff32f( const float* src1, size_t step1,
@@ -2664,7 +2829,7 @@ void absdiff32f( const float* src1, size_t step1,
 {
     CALL_HAL(absdiff32f, cv_hal_absdiff32f, src1, step1, src2, step2, dst, step, width, height)
     CALL_IPP_BIN_12(ippiAbsDiff_32f_C1R)
-    (vBinOp32<float, cv::OpAbsDiff<float>, IF_SIMD(VAbsDiff<float>)>(src1, step1, src2, step2, dst, step, width, height));
+    (vBinOpDispatched<float, cv::OpAbsDiff<float>, AbsDiff_SIMD<float> >(src1, step1, src2, step2, dst, step, width, height));
 }
 
 void absdiff64f( const double* src1, size_t step1,
@@ -2672,7 +2837,7 @@ void absdiff64f( const double* src1, size_t step1,
                         double* dst, size_t step, int width, int height, void* )
 {
     CALL_HAL(absdiff64f, cv_hal_absdiff64f, src1, step1, src2, step2, dst, step, width, height)
-    vBinOp64<double, cv::OpAbsDiff<double>, IF_SIMD(VAbsDiff<double>)>(src1, step1, src2, step2, dst, step, width, height);
+    vBinOpDispatched<double, cv::OpAbsDiff<double>, AbsDiff_SIMD<double> >(src1, step1, src2, step2, dst, step, width, height);
 }
 
 //=======================================
@@ -3232,92 +3397,7 @@ addWeighted8u( const uchar* src1, size_t step1,
                void* scalars )
 {
     CALL_HAL(addWeighted8u, cv_hal_addWeighted8u, src1, step1, src2, step2, dst, step, width, height, (const double*)scalars)
-    const double* scalars_ = (const double*)scalars;
-    float alpha = (float)scalars_[0], beta = (float)scalars_[1], gamma = (float)scalars_[2];
-
-    for( ; height--; src1 += step1, src2 += step2, dst += step )
-    {
-        int x = 0;
-
-#if CV_SSE2
-        if( USE_SSE2 )
-        {
-            __m128 a4 = _mm_set1_ps(alpha), b4 = _mm_set1_ps(beta), g4 = _mm_set1_ps(gamma);
-            __m128i z = _mm_setzero_si128();
-
-            for( ; x <= width - 8; x += 8 )
-            {
-                __m128i u = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(src1 + x)), z);
-                __m128i v = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(src2 + x)), z);
-
-                __m128 u0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(u, z));
-                __m128 u1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(u, z));
-                __m128 v0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v, z));
-                __m128 v1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v, z));
-
-                u0 = _mm_add_ps(_mm_mul_ps(u0, a4), _mm_mul_ps(v0, b4));
-                u1 = _mm_add_ps(_mm_mul_ps(u1, a4), _mm_mul_ps(v1, b4));
-                u0 = _mm_add_ps(u0, g4); u1 = _mm_add_ps(u1, g4);
-
-                u = _mm_packs_epi32(_mm_cvtps_epi32(u0), _mm_cvtps_epi32(u1));
-                u = _mm_packus_epi16(u, u);
-
-                _mm_storel_epi64((__m128i*)(dst + x), u);
-            }
-        }
-#elif CV_NEON
-        float32x4_t g = vdupq_n_f32 (gamma);
-
-        for( ; x <= width - 8; x += 8 )
-        {
-            uint8x8_t in1 = vld1_u8(src1+x);
-            uint16x8_t in1_16 = vmovl_u8(in1);
-            float32x4_t in1_f_l = vcvtq_f32_u32(vmovl_u16(vget_low_u16(in1_16)));
-            float32x4_t in1_f_h = vcvtq_f32_u32(vmovl_u16(vget_high_u16(in1_16)));
-
-            uint8x8_t in2 = vld1_u8(src2+x);
-            uint16x8_t in2_16 = vmovl_u8(in2);
-            float32x4_t in2_f_l = vcvtq_f32_u32(vmovl_u16(vget_low_u16(in2_16)));
-            float32x4_t in2_f_h = vcvtq_f32_u32(vmovl_u16(vget_high_u16(in2_16)));
-
-            float32x4_t out_f_l = vaddq_f32(vmulq_n_f32(in1_f_l, alpha), vmulq_n_f32(in2_f_l, beta));
-            float32x4_t out_f_h = vaddq_f32(vmulq_n_f32(in1_f_h, alpha), vmulq_n_f32(in2_f_h, beta));
-            out_f_l = vaddq_f32(out_f_l, g);
-            out_f_h = vaddq_f32(out_f_h, g);
-
-            uint16x4_t out_16_l = vqmovun_s32(cv_vrndq_s32_f32(out_f_l));
-            uint16x4_t out_16_h = vqmovun_s32(cv_vrndq_s32_f32(out_f_h));
-
-            uint16x8_t out_16 = vcombine_u16(out_16_l, out_16_h);
-            uint8x8_t out = vqmovn_u16(out_16);
-
-            vst1_u8(dst+x, out);
-        }
-#endif
-        #if CV_ENABLE_UNROLLED
-        for( ; x <= width - 4; x += 4 )
-        {
-            float t0, t1;
-            t0 = CV_8TO32F(src1[x])*alpha + CV_8TO32F(src2[x])*beta + gamma;
-            t1 = CV_8TO32F(src1[x+1])*alpha + CV_8TO32F(src2[x+1])*beta + gamma;
-
-            dst[x] = saturate_cast<uchar>(t0);
-            dst[x+1] = saturate_cast<uchar>(t1);
-
-            t0 = CV_8TO32F(src1[x+2])*alpha + CV_8TO32F(src2[x+2])*beta + gamma;
-            t1 = CV_8TO32F(src1[x+3])*alpha + CV_8TO32F(src2[x+3])*beta + gamma;
-
-            dst[x+2] = saturate_cast<uchar>(t0);
-            dst[x+3] = saturate_cast<uchar>(t1);
-        }
-        #endif
-
-        for( ; x < width; x++ )
-        {
-            float t0 = CV_8TO32F(src1[x])*alpha + CV_8TO32F(src2[x])*beta + gamma;
-            dst[x] = saturate_cast<uchar>(t0);
-        }
-    }
+    addWeighted_<uchar, float>(src1, step1, src2, step2, dst, step, width, height, scalars);
 }
 
 void addWeighted8s( const schar* src1, size_t step1, const schar* src2, size_t step2,
@@ -0,0 +1,869 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+// No include guard: the kernels are compiled once per dispatched instruction set,
+// see ocv_add_dispatched_file() in cmake/OpenCVCompilerOptimizations.cmake and
+// the dispatcher in arithm_simd.hpp. The kernels process the widest vectors available
+// (CV_SIMD) and return the number of processed elements, the tail is handled by the caller.
+
+#include "opencv2/core/hal/intrin.hpp"
+
+namespace cv {
+CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
+
+int add_simd(const uchar* src1, const uchar* src2, uchar* dst, int width);
+int add_simd(const schar* src1, const schar* src2, schar* dst, int width);
+int add_simd(const ushort* src1, const ushort* src2, ushort* dst, int width);
+int add_simd(const short* src1, const short* src2, short* dst, int width);
+int add_simd(const int* src1, const int* src2, int* dst, int width);
+int add_simd(const float* src1, const float* src2, float* dst, int width);
+int add_simd(const double* src1, const double* src2, double* dst, int width);
+
+int sub_simd(const uchar* src1, const uchar* src2, uchar* dst, int width);
+int sub_simd(const schar* src1, const schar* src2, schar* dst, int width);
+int sub_simd(const ushort* src1, const ushort* src2, ushort* dst, int width);
+int sub_simd(const short* src1, const short* src2, short* dst, int width);
+int sub_simd(const int* src1, const int* src2, int* dst, int width);
+int sub_simd(const float* src1, const float* src2, float* dst, int width);
+int sub_simd(const double* src1, const double* src2, double* dst, int width);
+
+int absdiff_simd(const uchar* src1, const uchar* src2, uchar* dst, int width);
+int absdiff_simd(const schar* src1, const schar* src2, schar* dst, int width);
+int absdiff_simd(const ushort* src1, const ushort* src2, ushort* dst, int width);
+int absdiff_simd(const short* src1, const short* src2, short* dst, int width);
+int absdiff_simd(const int* src1, const int* src2, int* dst, int width);
+int absdiff_simd(const float* src1, const float* src2, float* dst, int width);
+int absdiff_simd(const double* src1, const double* src2, double* dst, int width);
+
+int mul_simd(const uchar* src1, const uchar* src2, uchar* dst, int width, float scale);
+int mul_simd(const schar* src1, const schar* src2, schar* dst, int width, float scale);
+int mul_simd(const ushort* src1, const ushort* src2, ushort* dst, int width, float scale);
+int mul_simd(const short* src1, const short* src2, short* dst, int width, float scale);
+int mul_simd(const float* src1, const float* src2, float* dst, int width, float scale);
+
+int addWeighted_simd(const uchar* src1, const uchar* src2, uchar* dst, int width, float alpha, float beta, float gamma);
+int addWeighted_simd(const schar* src1, const schar* src2, schar* dst, int width, float alpha, float beta, float gamma);
+int addWeighted_simd(const ushort* src1, const ushort* src2, ushort* dst, int width, float alpha, float beta, float gamma);
+int addWeighted_simd(const short* src1, const short* src2, short* dst, int width, float alpha, float beta, float gamma);
+
+int div_simd(const uchar* src1, const uchar* src2, uchar* dst, int width, double scale);
+int div_simd(const schar* src1, const schar* src2, schar* dst, int width, double scale);
+int div_simd(const ushort* src1, const ushort* src2, ushort* dst, int width, double scale);
+int div_simd(const short* src1, const short* src2, short* dst, int width, double scale);
+int div_simd(const int* src1, const int* src2, int* dst, int width, double scale);
+int div_simd(const float* src1, const float* src2, float* dst, int width, double scale);
+int div_simd(const double* src1, const double* src2, double* dst, int width, double scale);
+
+int recip_simd(const uchar* src2, uchar* dst, int width, double scale);
+int recip_simd(const schar* src2, schar* dst, int width, double scale);
+int recip_simd(const ushort* src2, ushort* dst, int width, double scale);
+int recip_simd(const short* src2, short* dst, int width, double scale);
+int recip_simd(const int* src2, int* dst, int width, double scale);
+int recip_simd(const float* src2, float* dst, int width, double scale);
+int recip_simd(const double* src2, double* dst, int width, double scale);
+
+#ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+///////////////////////// ADD, SUBTRACT, ABSDIFF //////////////////////
+
+// the same saturation as the scalar code: 8- and 16-bit results are saturated, 32-bit ones wrap around
+#if CV_SIMD
+
+template<typename _Tpvec> inline _Tpvec add_op(const _Tpvec& a, const _Tpvec& b) { return a + b; }
+template<typename _Tpvec> inline _Tpvec sub_op(const _Tpvec& a, const _Tpvec& b) { return a - b; }
+
+inline v_uint8 absdiff_op(const v_uint8& a, const v_uint8& b) { return v_absdiff(a, b); }
+inline v_uint16 absdiff_op(const v_uint16& a, const v_uint16& b) { return v_absdiff(a, b); }
+inline v_int16 absdiff_op(const v_int16& a, const v_int16& b) { return v_max(a, b) - v_min(a, b); }
+inline v_float32 absdiff_op(const v_float32& a, const v_float32& b) { return v_absdiff(a, b); }
+
+inline v_int8 absdiff_op(const v_int8& a, const v_int8& b)
+{
+    v_int8 d = a - b, m = b > a;
+    return (d ^ m) - m;
+}
+
+inline v_int32 absdiff_op(const v_int32& a, const v_int32& b)
+{
+    v_int32 d = a - b, m = b > a;
+    return (d ^ m) - m;
+}
+
+#if CV_SIMD_64F
+inline v_float64 absdiff_op(const v_float64& a, const v_float64& b) { return v_absdiff(a, b); }
+#endif
+
+#define ARITHM_BIN_SIMD(fun, op, _Tp, _Tpvec) \
+int fun(const _Tp* src1, const _Tp* src2, _Tp* dst, int width) \
+{ \
+    int x = 0; \
+    const int VECSZ = _Tpvec::nlanes; \
+    for ( ; x <= width - VECSZ*2; x += VECSZ*2) \
+    { \
+        _Tpvec a0 = vx_load(src1 + x), a1 = vx_load(src1 + x + VECSZ); \
+        _Tpvec b0 = vx_load(src2 + x), b1 = vx_load(src2 + x + VECSZ); \
+        v_store(dst + x, op(a0, b0)); \
+        v_store(dst + x + VECSZ, op(a1, b1)); \
+    } \
+    return x; \
+}
+
+#endif
+
+#define ARITHM_BIN_NOSIMD(fun, _Tp) \
+int fun(const _Tp*, const _Tp*, _Tp*, int) \
+{ \
+    return 0; \
+}
+
+#if CV_SIMD
+#define ARITHM_BIN_SIMD_ALL(fun, op) \
+ARITHM_BIN_SIMD(fun, op, uchar, v_uint8) \
+ARITHM_BIN_SIMD(fun, op, schar, v_int8) \
+ARITHM_BIN_SIMD(fun, op, ushort, v_uint16) \
+ARITHM_BIN_SIMD(fun, op, short, v_int16) \
+ARITHM_BIN_SIMD(fun, op, int, v_int32) \
+ARITHM_BIN_SIMD(fun, op, float, v_float32)
+#else
+#define ARITHM_BIN_SIMD_ALL(fun, op) \
+ARITHM_BIN_NOSIMD(fun, uchar) \
+ARITHM_BIN_NOSIMD(fun, schar) \
+ARITHM_BIN_NOSIMD(fun, ushort) \
+ARITHM_BIN_NOSIMD(fun, short) \
+ARITHM_BIN_NOSIMD(fun, int) \
+ARITHM_BIN_NOSIMD(fun, float)
+#endif
+
+#if CV_SIMD_64F
+#define ARITHM_BIN_SIMD_64F(fun, op) ARITHM_BIN_SIMD(fun, op, double, v_float64)
+#else
+#define ARITHM_BIN_SIMD_64F(fun, op) ARITHM_BIN_NOSIMD(fun, double)
+#endif
+
+ARITHM_BIN_SIMD_ALL(add_simd, add_op)
+ARITHM_BIN_SIMD_64F(add_simd, add_op)
+ARITHM_BIN_SIMD_ALL(sub_simd, sub_op)
+ARITHM_BIN_SIMD_64F(sub_simd, sub_op)
+ARITHM_BIN_SIMD_ALL(absdiff_simd, absdiff_op)
+ARITHM_BIN_SIMD_64F(absdiff_simd, absdiff_op)
+
+#undef ARITHM_BIN_SIMD
+#undef ARITHM_BIN_NOSIMD
+#undef ARITHM_BIN_SIMD_ALL
+#undef ARITHM_BIN_SIMD_64F
+
+///////////////////////// MULTIPLICATION //////////////////////
+
+// the products are computed as (float)src1*src2*scale, like the scalar code does;
+// multiplying by the scale of 1 does not change them, so the same loop serves both cases
+
+int mul_simd(const uchar* src1, const uchar* src2, uchar* dst, int width, float scale)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_uint16::nlanes;
+    v_float32 v_scale = vx_setall_f32(scale);
+
+    for ( ; x <= width - VECSZ; x += VECSZ)
+    {
+        v_uint32 t0, t1, t2, t3;
+        v_expand(vx_load_expand(src1 + x), t0, t1);
+        v_expand(vx_load_expand(src2 + x), t2, t3);
+
+        v_float32 f0 = v_cvt_f32(v_reinterpret_as_s32(t0)) * v_cvt_f32(v_reinterpret_as_s32(t2)) * v_scale;
+        v_float32 f1 = v_cvt_f32(v_reinterpret_as_s32(t1)) * v_cvt_f32(v_reinterpret_as_s32(t3)) * v_scale;
+
+        v_pack_store(dst + x, v_pack_u(v_round(f0), v_round(f1)));
+    }
+#else
+    (void)src1; (void)src2; (void)dst; (void)width; (void)scale;
+#endif
+    return x;
+}
+
+int mul_simd(const schar* src1, const schar* src2, schar* dst, int width, float scale)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_int16::nlanes;
+    v_float32 v_scale = vx_setall_f32(scale);
+
+    for ( ; x <= width - VECSZ; x += VECSZ)
+    {
+        v_int32 t0, t1, t2, t3;
+        v_expand(vx_load_expand(src1 + x), t0, t1);
+        v_expand(vx_load_expand(src2 + x), t2, t3);
+
+        v_float32 f0 = v_cvt_f32(t0) * v_cvt_f32(t2) * v_scale;
+        v_float32 f1 = v_cvt_f32(t1) * v_cvt_f32(t3) * v_scale;
+
+        v_pack_store(dst + x, v_pack(v_round(f0), v_round(f1)));
+    }
+#else
+    (void)src1; (void)src2; (void)dst; (void)width; (void)scale;
+#endif
+    return x;
+}
+
+// the products of the 16-bit numbers do not always fit the float mantissa, with the scale of 1
+// the scalar code computes them exactly in int
+int mul_simd(const ushort* src1, const ushort* src2, ushort* dst, int width, float scale)
+{
+    int x = 0;
+#if CV_SIMD
+    if( scale == 1.f )
+        return x;
+
+    const int VECSZ = v_uint16::nlanes;
+    v_float32 v_scale = vx_setall_f32(scale);
+
+    for ( ; x <= width - VECSZ; x += VECSZ)
+    {
+        v_uint32 t0, t1, t2, t3;
+        v_expand(vx_load(src1 + x), t0, t1);
+        v_expand(vx_load(src2 + x), t2, t3);
+
+        v_float32 f0 = v_cvt_f32(v_reinterpret_as_s32(t0)) * v_cvt_f32(v_reinterpret_as_s32(t2)) * v_scale;
+        v_float32 f1 = v_cvt_f32(v_reinterpret_as_s32(t1)) * v_cvt_f32(v_reinterpret_as_s32(t3)) * v_scale;
+
+        v_store(dst + x, v_pack_u(v_round(f0), v_round(f1)));
+    }
+#else
+    (void)src1; (void)src2; (void)dst; (void)width; (void)scale;
+#endif
+    return x;
+}
+
+int mul_simd(const short* src1, const short* src2, short* dst, int width, float scale)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_int16::nlanes;
+    v_float32 v_scale = vx_setall_f32(scale);
+
+    if( scale == 1.f )
+    {
+        for ( ; x <= width - VECSZ; x += VECSZ)
+        {
+            v_int32 p0, p1;
+            v_mul_expand(vx_load(src1 + x), vx_load(src2 + x), p0, p1);
+            v_store(dst + x, v_pack(p0, p1));
+        }
+        return x;
+    }
+
+    for ( ; x <= width - VECSZ; x += VECSZ)
+    {
+        v_int32 t0, t1, t2, t3;
+        v_expand(vx_load(src1 + x), t0, t1);
+        v_expand(vx_load(src2 + x), t2, t3);
+
+        v_float32 f0 = v_cvt_f32(t0) * v_cvt_f32(t2) * v_scale;
+        v_float32 f1 = v_cvt_f32(t1) * v_cvt_f32(t3) * v_scale;
+
+        v_store(dst + x, v_pack(v_round(f0), v_round(f1)));
+    }
+#else
+    (void)src1; (void)src2; (void)dst; (void)width; (void)scale;
+#endif
+    return x;
+}
+
+int mul_simd(const float* src1, const float* src2, float* dst, int width, float scale)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_float32::nlanes;
+    v_float32 v_scale = vx_setall_f32(scale);
+
+    for ( ; x <= width - VECSZ*2; x += VECSZ*2)
+    {
+        v_float32 f0 = vx_load(src1 + x) * vx_load(src2 + x) * v_scale;
+        v_float32 f1 = vx_load(src1 + x + VECSZ) * vx_load(src2 + x + VECSZ) * v_scale;
+
+        v_store(dst + x, f0);
+        v_store(dst + x + VECSZ, f1);
+    }
+#else
+    (void)src1; (void)src2; (void)dst; (void)width; (void)scale;
+#endif
+    return x;
+}
+
+///////////////////////// ADD WEIGHTED //////////////////////
+
+// src1*alpha + src2*beta + gamma is computed in float in the same order as the scalar code does
+
+int addWeighted_simd(const uchar* src1, const uchar* src2, uchar* dst, int width, float alpha, float beta, float gamma)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_uint16::nlanes;
+    v_float32 v_alpha = vx_setall_f32(alpha), v_beta = vx_setall_f32(beta), v_gamma = vx_setall_f32(gamma);
+
+    for ( ; x <= width - VECSZ; x += VECSZ)
+    {
+        v_uint32 t0, t1, t2, t3;
+        v_expand(vx_load_expand(src1 + x), t0, t1);
+        v_expand(vx_load_expand(src2 + x), t2, t3);
+
+        v_float32 f0 = v_cvt_f32(v_reinterpret_as_s32(t0)) * v_alpha + v_cvt_f32(v_reinterpret_as_s32(t2)) * v_beta + v_gamma;
+        v_float32 f1 = v_cvt_f32(v_reinterpret_as_s32(t1)) * v_alpha + v_cvt_f32(v_reinterpret_as_s32(t3)) * v_beta + v_gamma;
+
+        v_pack_store(dst + x, v_pack_u(v_round(f0), v_round(f1)));
+    }
+#else
+    (void)src1; (void)src2; (void)dst; (void)width; (void)alpha; (void)beta; (void)gamma;
+#endif
+    return x;
+}
+
+int addWeighted_simd(const schar* src1, const schar* src2, schar* dst, int width, float alpha, float beta, float gamma)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_int16::nlanes;
+    v_float32 v_alpha = vx_setall_f32(alpha), v_beta = vx_setall_f32(beta), v_gamma = vx_setall_f32(gamma);
+
+    for ( ; x <= width - VECSZ; x += VECSZ)
+    {
+        v_int32 t0, t1, t2, t3;
+        v_expand(vx_load_expand(src1 + x), t0, t1);
+        v_expand(vx_load_expand(src2 + x), t2, t3);
+
+        v_float32 f0 = v_cvt_f32(t0) * v_alpha + v_cvt_f32(t2) * v_beta + v_gamma;
+        v_float32 f1 = v_cvt_f32(t1) * v_alpha + v_cvt_f32(t3) * v_beta + v_gamma;
+
+        v_pack_store(dst + x, v_pack(v_round(f0), v_round(f1)));
+    }
+#else
+    (void)src1; (void)src2; (void)dst; (void)width; (void)alpha; (void)beta; (void)gamma;
+#endif
+    return x;
+}
+
+int addWeighted_simd(const ushort* src1, const ushort* src2, ushort* dst, int width, float alpha, float beta, float gamma)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_uint16::nlanes;
+    v_float32 v_alpha = vx_setall_f32(alpha), v_beta = vx_setall_f32(beta), v_gamma = vx_setall_f32(gamma);
+
+    for ( ; x <= width - VECSZ; x += VECSZ)
+    {
+        v_uint32 t0, t1, t2, t3;
+        v_expand(vx_load(src1 + x), t0, t1);
+        v_expand(vx_load(src2 + x), t2, t3);
+
+        v_float32 f0 = v_cvt_f32(v_reinterpret_as_s32(t0)) * v_alpha + v_cvt_f32(v_reinterpret_as_s32(t2)) * v_beta + v_gamma;
+        v_float32 f1 = v_cvt_f32(v_reinterpret_as_s32(t1)) * v_alpha + v_cvt_f32(v_reinterpret_as_s32(t3)) * v_beta + v_gamma;
+
+        v_store(dst + x, v_pack_u(v_round(f0), v_round(f1)));
+    }
+#else
+    (void)src1; (void)src2; (void)dst; (void)width; (void)alpha; (void)beta; (void)gamma;
+#endif
+    return x;
+}
+
+int addWeighted_simd(const short* src1, const short* src2, short* dst, int width, float alpha, float beta, float gamma)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_int16::nlanes;
+    v_float32 v_alpha = vx_setall_f32(alpha), v_beta = vx_setall_f32(beta), v_gamma = vx_setall_f32(gamma);
+
+    for ( ; x <= width - VECSZ; x += VECSZ)
+    {
+        v_int32 t0, t1, t2, t3;
+        v_expand(vx_load(src1 + x), t0, t1);
+        v_expand(vx_load(src2 + x), t2, t3);
+
+        v_float32 f0 = v_cvt_f32(t0) * v_alpha + v_cvt_f32(t2) * v_beta + v_gamma;
+        v_float32 f1 = v_cvt_f32(t1) * v_alpha + v_cvt_f32(t3) * v_beta + v_gamma;
+
+        v_store(dst + x, v_pack(v_round(f0), v_round(f1)));
+    }
+#else
+    (void)src1; (void)src2; (void)dst; (void)width; (void)alpha; (void)beta; (void)gamma;
+#endif
+    return x;
+}
+
+///////////////////////// DIVISION //////////////////////
+
+int div_simd(const uchar* src1, const uchar* src2, uchar* dst, int width, double scale)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_uint16::nlanes;
+    v_float32 v_scale = vx_setall_f32((float)scale);
+    v_uint16 v_zero = vx_setzero_u16();
+
+    for ( ; x <= width - VECSZ; x += VECSZ)
+    {
+        v_uint16 v_src1 = vx_load_expand(src1 + x);
+        v_uint16 v_src2 = vx_load_expand(src2 + x);
+
+        v_uint32 t0, t1, t2, t3;
+        v_expand(v_src1, t0, t1);
+        v_expand(v_src2, t2, t3);
+
+        v_float32 f0 = v_cvt_f32(v_reinterpret_as_s32(t0));
+        v_float32 f1 = v_cvt_f32(v_reinterpret_as_s32(t1));
+
+        v_float32 f2 = v_cvt_f32(v_reinterpret_as_s32(t2));
+        v_float32 f3 = v_cvt_f32(v_reinterpret_as_s32(t3));
+
+        f0 = f0 * v_scale / f2;
+        f1 = f1 * v_scale / f3;
+
+        v_int32 i0 = v_round(f0), i1 = v_round(f1);
+        v_uint16 res = v_pack_u(i0, i1);
+
+        res = v_select(v_src2 == v_zero, v_zero, res);
+        v_pack_store(dst + x, res);
+    }
+#else
+    (void)src1; (void)src2; (void)dst; (void)width; (void)scale;
+#endif
+    return x;
+}
+
+int div_simd(const schar* src1, const schar* src2, schar* dst, int width, double scale)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_int16::nlanes;
+    v_float32 v_scale = vx_setall_f32((float)scale);
+    v_int16 v_zero = vx_setzero_s16();
+
+    for ( ; x <= width - VECSZ; x += VECSZ)
+    {
+        v_int16 v_src1 = vx_load_expand(src1 + x);
+        v_int16 v_src2 = vx_load_expand(src2 + x);
+
+        v_int32 t0, t1, t2, t3;
+        v_expand(v_src1, t0, t1);
+        v_expand(v_src2, t2, t3);
+
+        v_float32 f0 = v_cvt_f32(t0);
+        v_float32 f1 = v_cvt_f32(t1);
+
+        v_float32 f2 = v_cvt_f32(t2);
+        v_float32 f3 = v_cvt_f32(t3);
+
+        f0 = f0 * v_scale / f2;
+        f1 = f1 * v_scale / f3;
+
+        v_int32 i0 = v_round(f0), i1 = v_round(f1);
+        v_int16 res = v_pack(i0, i1);
+
+        res = v_select(v_src2 == v_zero, v_zero, res);
+        v_pack_store(dst + x, res);
+    }
+#else
+    (void)src1; (void)src2; (void)dst; (void)width; (void)scale;
+#endif
+    return x;
+}
+
+int div_simd(const ushort* src1, const ushort* src2, ushort* dst, int width, double scale)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_uint16::nlanes;
+    v_float32 v_scale = vx_setall_f32((float)scale);
+    v_uint16 v_zero = vx_setzero_u16();
+
+    for ( ; x <= width - VECSZ; x += VECSZ)
+    {
+        v_uint16 v_src1 = vx_load(src1 + x);
+        v_uint16 v_src2 = vx_load(src2 + x);
+
+        v_uint32 t0, t1, t2, t3;
+        v_expand(v_src1, t0, t1);
+        v_expand(v_src2, t2, t3);
+
+        v_float32 f0 = v_cvt_f32(v_reinterpret_as_s32(t0));
+        v_float32 f1 = v_cvt_f32(v_reinterpret_as_s32(t1));
+
+        v_float32 f2 = v_cvt_f32(v_reinterpret_as_s32(t2));
+        v_float32 f3 = v_cvt_f32(v_reinterpret_as_s32(t3));
+
+        f0 = f0 * v_scale / f2;
+        f1 = f1 * v_scale / f3;
+
+        v_int32 i0 = v_round(f0), i1 = v_round(f1);
+        v_uint16 res = v_pack_u(i0, i1);
+
+        res = v_select(v_src2 == v_zero, v_zero, res);
+        v_store(dst + x, res);
+    }
+#else
+    (void)src1; (void)src2; (void)dst; (void)width; (void)scale;
+#endif
+    return x;
+}
+
+int div_simd(const short* src1, const short* src2, short* dst, int width, double scale)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_int16::nlanes;
+    v_float32 v_scale = vx_setall_f32((float)scale);
+    v_int16 v_zero = vx_setzero_s16();
+
+    for ( ; x <= width - VECSZ; x += VECSZ)
+    {
+        v_int16 v_src1 = vx_load(src1 + x);
+        v_int16 v_src2 = vx_load(src2 + x);
+
+        v_int32 t0, t1, t2, t3;
+        v_expand(v_src1, t0, t1);
+        v_expand(v_src2, t2, t3);
+
+        v_float32 f0 = v_cvt_f32(t0);
+        v_float32 f1 = v_cvt_f32(t1);
+
+        v_float32 f2 = v_cvt_f32(t2);
+        v_float32 f3 = v_cvt_f32(t3);
+
+        f0 = f0 * v_scale / f2;
+        f1 = f1 * v_scale / f3;
+
+        v_int32 i0 = v_round(f0), i1 = v_round(f1);
+        v_int16 res = v_pack(i0, i1);
+
+        res = v_select(v_src2 == v_zero, v_zero, res);
+        v_store(dst + x, res);
+    }
+#else
+    (void)src1; (void)src2; (void)dst; (void)width; (void)scale;
+#endif
+    return x;
+}
+
+int div_simd(const int* src1, const int* src2, int* dst, int width, double scale)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_int32::nlanes;
+    v_float32 v_scale = vx_setall_f32((float)scale);
+    v_int32 v_zero = vx_setzero_s32();
+
+    for ( ; x <= width - VECSZ*2; x += VECSZ*2)
+    {
+        v_int32 t0 = vx_load(src1 + x);
+        v_int32 t1 = vx_load(src1 + x + VECSZ);
+        v_int32 t2 = vx_load(src2 + x);
+        v_int32 t3 = vx_load(src2 + x + VECSZ);
+
+        v_float32 f0 = v_cvt_f32(t0);
+        v_float32 f1 = v_cvt_f32(t1);
+        v_float32 f2 = v_cvt_f32(t2);
+        v_float32 f3 = v_cvt_f32(t3);
+
+        f0 = f0 * v_scale / f2;
+        f1 = f1 * v_scale / f3;
+
+        v_int32 res0 = v_round(f0), res1 = v_round(f1);
+
+        res0 = v_select(t2 == v_zero, v_zero, res0);
+        res1 = v_select(t3 == v_zero, v_zero, res1);
+        v_store(dst + x, res0);
+        v_store(dst + x + VECSZ, res1);
+    }
+#else
+    (void)src1; (void)src2; (void)dst; (void)width; (void)scale;
+#endif
+    return x;
+}
+
+int div_simd(const float* src1, const float* src2, float* dst, int width, double scale)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_float32::nlanes;
+    v_float32 v_scale = vx_setall_f32((float)scale);
+    v_float32 v_zero = vx_setzero_f32();
+
+    for ( ; x <= width - VECSZ*2; x += VECSZ*2)
+    {
+        v_float32 f0 = vx_load(src1 + x);
+        v_float32 f1 = vx_load(src1 + x + VECSZ);
+        v_float32 f2 = vx_load(src2 + x);
+        v_float32 f3 = vx_load(src2 + x + VECSZ);
+
+        v_float32 res0 = f0 * v_scale / f2;
+        v_float32 res1 = f1 * v_scale / f3;
+
+        res0 = v_select(f2 == v_zero, v_zero, res0);
+        res1 = v_select(f3 == v_zero, v_zero, res1);
+
+        v_store(dst + x, res0);
+        v_store(dst + x + VECSZ, res1);
+    }
+#else
+    (void)src1; (void)src2; (void)dst; (void)width; (void)scale;
+#endif
+    return x;
+}
+
+int div_simd(const double* src1, const double* src2, double* dst, int width, double scale)
+{
+    int x = 0;
+#if CV_SIMD_64F
+    const int VECSZ = v_float64::nlanes;
+    v_float64 v_scale = vx_setall_f64(scale);
+    v_float64 v_zero = vx_setzero_f64();
+
+    for ( ; x <= width - VECSZ*2; x += VECSZ*2)
+    {
+        v_float64 f0 = vx_load(src1 + x);
+        v_float64 f1 = vx_load(src1 + x + VECSZ);
+        v_float64 f2 = vx_load(src2 + x);
+        v_float64 f3 = vx_load(src2 + x + VECSZ);
+
+        v_float64 res0 = f0 * v_scale / f2;
+        v_float64 res1 = f1 * v_scale / f3;
+
+        res0 = v_select(f2 == v_zero, v_zero, res0);
+        res1 = v_select(f3 == v_zero, v_zero, res1);
+
+        v_store(dst + x, res0);
+        v_store(dst + x + VECSZ, res1);
+    }
+#else
+    (void)src1; (void)src2; (void)dst; (void)width; (void)scale;
+#endif
+    return x;
+}
+
+///////////////////////// RECIPROCAL //////////////////////
+
+int recip_simd(const uchar* src2, uchar* dst, int width, double scale)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_uint16::nlanes;
+    v_float32 v_scale = vx_setall_f32((float)scale);
+    v_uint16 v_zero = vx_setzero_u16();
+
+    for ( ; x <= width - VECSZ; x += VECSZ)
+    {
+        v_uint16 v_src2 = vx_load_expand(src2 + x);
+
+        v_uint32 t0, t1;
+        v_expand(v_src2, t0, t1);
+
+        v_float32 f0 = v_cvt_f32(v_reinterpret_as_s32(t0));
+        v_float32 f1 = v_cvt_f32(v_reinterpret_as_s32(t1));
+
+        f0 = v_scale / f0;
+        f1 = v_scale / f1;
+
+        v_int32 i0 = v_round(f0), i1 = v_round(f1);
+        v_uint16 res = v_pack_u(i0, i1);
+
+        res = v_select(v_src2 == v_zero, v_zero, res);
+        v_pack_store(dst + x, res);
+    }
+#else
+    (void)src2; (void)dst; (void)width; (void)scale;
+#endif
+    return x;
+}
+
+int recip_simd(const schar* src2, schar* dst, int width, double scale)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_int16::nlanes;
+    v_float32 v_scale = vx_setall_f32((float)scale);
+    v_int16 v_zero = vx_setzero_s16();
+
+    for ( ; x <= width - VECSZ; x += VECSZ)
+    {
+        v_int16 v_src2 = vx_load_expand(src2 + x);
+
+        v_int32 t0, t1;
+        v_expand(v_src2, t0, t1);
+
+        v_float32 f0 = v_cvt_f32(t0);
+        v_float32 f1 = v_cvt_f32(t1);
+
+        f0 = v_scale / f0;
+        f1 = v_scale / f1;
+
+        v_int32 i0 = v_round(f0), i1 = v_round(f1);
+        v_int16 res = v_pack(i0, i1);
+
+        res = v_select(v_src2 == v_zero, v_zero, res);
+        v_pack_store(dst + x, res);
+    }
+#else
+    (void)src2; (void)dst; (void)width; (void)scale;
+#endif
+    return x;
+}
+
+int recip_simd(const ushort* src2, ushort* dst, int width, double scale)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_uint16::nlanes;
+    v_float32 v_scale = vx_setall_f32((float)scale);
+    v_uint16 v_zero = vx_setzero_u16();
+
+    for ( ; x <= width - VECSZ; x += VECSZ)
+    {
+        v_uint16 v_src2 = vx_load(src2 + x);
+
+        v_uint32 t0, t1;
+        v_expand(v_src2, t0, t1);
+
+        v_float32 f0 = v_cvt_f32(v_reinterpret_as_s32(t0));
+        v_float32 f1 = v_cvt_f32(v_reinterpret_as_s32(t1));
+
+        f0 = v_scale / f0;
+        f1 = v_scale / f1;
+
+        v_int32 i0 = v_round(f0), i1 = v_round(f1);
+        v_uint16 res = v_pack_u(i0, i1);
+
+        res = v_select(v_src2 == v_zero, v_zero, res);
+        v_store(dst + x, res);
+    }
+#else
+    (void)src2; (void)dst; (void)width; (void)scale;
+#endif
+    return x;
+}
+
+int recip_simd(const short* src2, short* dst, int width, double scale)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_int16::nlanes;
+    v_float32 v_scale = vx_setall_f32((float)scale);
+    v_int16 v_zero = vx_setzero_s16();
+
+    for ( ; x <= width - VECSZ; x += VECSZ)
+    {
+        v_int16 v_src2 = vx_load(src2 + x);
+
+        v_int32 t0, t1;
+        v_expand(v_src2, t0, t1);
+
+        v_float32 f0 = v_cvt_f32(t0);
+        v_float32 f1 = v_cvt_f32(t1);
+
+        f0 = v_scale / f0;
+        f1 = v_scale / f1;
+
+        v_int32 i0 = v_round(f0), i1 = v_round(f1);
+        v_int16 res = v_pack(i0, i1);
+
+        res = v_select(v_src2 == v_zero, v_zero, res);
+        v_store(dst + x, res);
+    }
+#else
+    (void)src2; (void)dst; (void)width; (void)scale;
+#endif
+    return x;
+}
+
+int recip_simd(const int* src2, int* dst, int width, double scale)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_int32::nlanes;
+    v_float32 v_scale = vx_setall_f32((float)scale);
+    v_int32 v_zero = vx_setzero_s32();
+
+    for ( ; x <= width - VECSZ*2; x += VECSZ*2)
+    {
+        v_int32 t0 = vx_load(src2 + x);
+        v_int32 t1 = vx_load(src2 + x + VECSZ);
+
+        v_float32 f0 = v_cvt_f32(t0);
+        v_float32 f1 = v_cvt_f32(t1);
+
+        f0 = v_scale / f0;
+        f1 = v_scale / f1;
+
+        v_int32 res0 = v_round(f0), res1 = v_round(f1);
+
+        res0 = v_select(t0 == v_zero, v_zero, res0);
+        res1 = v_select(t1 == v_zero, v_zero, res1);
+        v_store(dst + x, res0);
+        v_store(dst + x + VECSZ, res1);
+    }
+#else
+    (void)src2; (void)dst; (void)width; (void)scale;
+#endif
+    return x;
+}
+
+int recip_simd(const float* src2, float* dst, int width, double scale)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_float32::nlanes;
+    v_float32 v_scale = vx_setall_f32((float)scale);
+    v_float32 v_zero = vx_setzero_f32();
+
+    for ( ; x <= width - VECSZ*2; x += VECSZ*2)
+    {
+        v_float32 f0 = vx_load(src2 + x);
+        v_float32 f1 = vx_load(src2 + x + VECSZ);
+
+        v_float32 res0 = v_scale / f0;
+        v_float32 res1 = v_scale / f1;
+
+        res0 = v_select(f0 == v_zero, v_zero, res0);
+        res1 = v_select(f1 == v_zero, v_zero, res1);
+
+        v_store(dst + x, res0);
+        v_store(dst + x + VECSZ, res1);
+    }
+#else
+    (void)src2; (void)dst; (void)width; (void)scale;
+#endif
+    return x;
+}
+
+int recip_simd(const double* src2, double* dst, int width, double scale)
+{
+    int x = 0;
+#if CV_SIMD_64F
+    const int VECSZ = v_float64::nlanes;
+    v_float64 v_scale = vx_setall_f64(scale);
+    v_float64 v_zero = vx_setzero_f64();
+
+    for ( ; x <= width - VECSZ*2; x += VECSZ*2)
+    {
+        v_float64 f0 = vx_load(src2 + x);
+        v_float64 f1 = vx_load(src2 + x + VECSZ);
+
+        v_float64 res0 = v_scale / f0;
+        v_float64 res1 = v_scale / f1;
+
+        res0 = v_select(f0 == v_zero, v_zero, res0);
+        res1 = v_select(f1 == v_zero, v_zero, res1);
+
+        v_store(dst + x, res0);
+        v_store(dst + x + VECSZ, res1);
+    }
+#else
+    (void)src2; (void)dst; (void)width; (void)scale;
+#endif
+    return x;
+}
+
+#endif // CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+CV_CPU_OPTIMIZATION_NAMESPACE_END
+} // namespace cv
@@ -207,6 +207,36 @@ void vBinOp(const T* src1, size_t step1, const T* src2, size_t step2, T* dst, si
     }
 }
 
+// the vector part of the rows is processed by the dispatched kernels, see arithm_simd.hpp
+template<typename T, class Op, class VOp>
+void vBinOpDispatched(const T* src1, size_t step1, const T* src2, size_t step2, T* dst, size_t step, int width, int height)
+{
+    VOp vop;
+    Op op;
+
+    for( ; height--; src1 = (const T *)((const uchar *)src1 + step1),
+                        src2 = (const T *)((const uchar *)src2 + step2),
+                        dst = (T *)((uchar *)dst + step) )
+    {
+        int x = vop(src1, src2, dst, width);
+
+#if CV_ENABLE_UNROLLED
+        for( ; x <= width - 4; x += 4 )
+        {
+            T v0 = op(src1[x], src2[x]);
+            T v1 = op(src1[x+1], src2[x+1]);
+            dst[x] = v0; dst[x+1] = v1;
+            v0 = op(src1[x+2], src2[x+2]);
+            v1 = op(src1[x+3], src2[x+3]);
+            dst[x+2] = v0; dst[x+3] = v1;
+        }
+#endif
+
+        for( ; x < width; x++ )
+            dst[x] = op(src1[x], src2[x]);
+    }
+}
+
 template<typename T, class Op, class Op32>
 void vBinOp32(const T* src1, size_t step1, const T* src2, size_t step2,
               T* dst, size_t step, int width, int height)
@@ -467,17 +497,17 @@ mul_( const T* src1, size_t step1, const T* src2, size_t step2,
             #if CV_ENABLE_UNROLLED
             for(; i <= width - 4; i += 4 )
             {
-                T t0 = saturate_cast<T>(scale*(WT)src1[i]*src2[i]);
-                T t1 = saturate_cast<T>(scale*(WT)src1[i+1]*src2[i+1]);
+                T t0 = saturate_cast<T>((WT)src1[i]*src2[i]*scale);
+                T t1 = saturate_cast<T>((WT)src1[i+1]*src2[i+1]*scale);
                 dst[i] = t0; dst[i+1] = t1;
 
-                t0 = saturate_cast<T>(scale*(WT)src1[i+2]*src2[i+2]);
-                t1 = saturate_cast<T>(scale*(WT)src1[i+3]*src2[i+3]);
+                t0 = saturate_cast<T>((WT)src1[i+2]*src2[i+2]*scale);
+                t1 = saturate_cast<T>((WT)src1[i+3]*src2[i+3]*scale);
                 dst[i+2] = t0; dst[i+3] = t1;
             }
             #endif
             for( ; i < width; i++ )
-                dst[i] = saturate_cast<T>(scale*(WT)src1[i]*src2[i]);
+                dst[i] = saturate_cast<T>((WT)src1[i]*src2[i]*scale);
         }
     }
 }
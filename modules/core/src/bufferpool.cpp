@@ -0,0 +1,380 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+namespace cv {
+
+// Buffers up to 256 bytes share one class, then there are 4 classes per power of two
+enum
+{
+    POOL_MIN_SHIFT = 8,
+    POOL_MAX_SHIFT = 30,
+    POOL_BUCKETS = 1 + (POOL_MAX_SHIFT - POOL_MIN_SHIFT + 1)*4,
+    POOL_THREAD_CACHE_DEPTH = 4,
+    // the capacities of all the classes are multiples of it, the total reserved size is counted in these units
+    POOL_UNIT_SHIFT = 6
+};
+
+// returns -1 for the buffers which are too large to be pooled
+static inline int poolBucket(size_t size)
+{
+    if( size <= ((size_t)1 << POOL_MIN_SHIFT) )
+        return 0;
+    if( size > ((size_t)1 << (POOL_MAX_SHIFT + 1)) )
+        return -1;
+    size_t s = size - 1;
+    int e = POOL_MIN_SHIFT;
+    while( (s >> (e + 1)) != 0 )
+        e++;
+    // 2^e < size <= 2^(e+1), the two bits below the highest one select the class
+    int sub = (int)(s >> (e - 2)) & 3;
+    return 1 + (e - POOL_MIN_SHIFT)*4 + sub;
+}
+
+static inline size_t poolBucketCapacity(int idx)
+{
+    if( idx == 0 )
+        return (size_t)1 << POOL_MIN_SHIFT;
+    int e = POOL_MIN_SHIFT + (idx - 1)/4, sub = (idx - 1) % 4;
+    return (size_t)(5 + sub) << (e - 2);
+}
+
+class PoolMatAllocator;
+
+struct PoolThreadCache
+{
+    PoolThreadCache(const PoolMatAllocator* _owner = 0) : owner(_owner), reservedSize(0), allocations(0), hits(0)
+    {
+        memset(count, 0, sizeof(count));
+    }
+
+    // the cached buffers are moved to the shared pool, so they are still counted against its limit
+    ~PoolThreadCache();
+
+    const PoolMatAllocator* owner;
+    Mutex mutex; // not contended, unless the pool is released or queried from another thread
+    void* buffers[POOL_BUCKETS][POOL_THREAD_CACHE_DEPTH];
+    int count[POOL_BUCKETS];
+    size_t reservedSize;
+    size_t allocations;
+    size_t hits;
+};
+
+class PoolThreadCaches : public TLSData<PoolThreadCache>
+{
+public:
+    PoolThreadCaches(const PoolMatAllocator* _owner) : owner(_owner) { }
+
+private:
+    virtual void* createDataInstance() const { return new PoolThreadCache(owner); }
+
+    const PoolMatAllocator* owner;
+};
+
+class PoolMatAllocator : public MatAllocator, public BufferPoolController
+{
+public:
+    PoolMatAllocator() : reservedSize(0), allocations(0), hits(0), reservedUnits(0), threadCaches(this)
+    {
+        setLimit(getConfigurationParameterForSize("OPENCV_BUFFERPOOL_LIMIT", (size_t)1 << 28));
+    }
+
+    virtual ~PoolMatAllocator()
+    {
+        freeAllReservedBuffers();
+    }
+
+    UMatData* allocate(int dims, const int* sizes, int type,
+                       void* data0, size_t* step, int /*flags*/, UMatUsageFlags /*usageFlags*/) const
+    {
+        size_t total = CV_ELEM_SIZE(type);
+        for( int i = dims-1; i >= 0; i-- )
+        {
+            if( step )
+            {
+                if( data0 && step[i] != CV_AUTOSTEP )
+                {
+                    CV_Assert(total <= step[i]);
+                    total = step[i];
+                }
+                else
+                    step[i] = total;
+            }
+            total *= sizes[i];
+        }
+        uchar* data = data0 ? (uchar*)data0 : (uchar*)allocateBuffer(total);
+        UMatData* u = new UMatData(this);
+        u->data = u->origdata = data;
+        u->size = total;
+        u->flags |= UMatData::HOST_MEMORY;
+        if(data0)
+            u->flags |= UMatData::USER_ALLOCATED;
+
+        return u;
+    }
+
+    bool allocate(UMatData* u, int /*accessFlags*/, UMatUsageFlags /*usageFlags*/) const
+    {
+        if(!u) return false;
+        return true;
+    }
+
+    void deallocate(UMatData* u) const
+    {
+        if(!u)
+            return;
+
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        if( !(u->flags & UMatData::USER_ALLOCATED) )
+        {
+            releaseBuffer(u->origdata, u->size);
+            u->origdata = 0;
+        }
+        delete u;
+    }
+
+    BufferPoolController* getBufferPoolController(const char* /*id*/) const
+    {
+        return const_cast<PoolMatAllocator*>(this);
+    }
+
+    size_t getReservedSize() const
+    {
+        return getStats().reservedSize;
+    }
+
+    size_t getMaxReservedSize() const
+    {
+        return maxReservedSize;
+    }
+
+    void setMaxReservedSize(size_t size)
+    {
+        size_t oldMaxReservedSize = maxReservedSize;
+        setLimit(size);
+        if( maxReservedSize < oldMaxReservedSize )
+            freeAllReservedBuffers();
+    }
+
+    void freeAllReservedBuffers()
+    {
+        std::vector<PoolThreadCache*> caches;
+        threadCaches.gather(caches);
+        for( size_t i = 0; i < caches.size(); i++ )
+        {
+            PoolThreadCache& tc = *caches[i];
+            AutoLock lock(tc.mutex);
+            for( int idx = 0; idx < POOL_BUCKETS; idx++ )
+            {
+                for( int j = 0; j < tc.count[idx]; j++ )
+                    fastFree(tc.buffers[idx][j]);
+                tc.count[idx] = 0;
+            }
+            CV_XADD(&reservedUnits, -(int)(tc.reservedSize >> POOL_UNIT_SHIFT));
+            tc.reservedSize = 0;
+        }
+
+        AutoLock lock(mutex);
+        for( int idx = 0; idx < POOL_BUCKETS; idx++ )
+        {
+            for( size_t j = 0; j < reserved[idx].size(); j++ )
+                fastFree(reserved[idx][j]);
+            reserved[idx].clear();
+        }
+        CV_XADD(&reservedUnits, -(int)(reservedSize >> POOL_UNIT_SHIFT));
+        reservedSize = 0;
+    }
+
+    BufferPoolStats getStats() const
+    {
+        BufferPoolStats stats;
+        std::vector<PoolThreadCache*> caches;
+        threadCaches.gather(caches);
+        for( size_t i = 0; i < caches.size(); i++ )
+        {
+            PoolThreadCache& tc = *caches[i];
+            AutoLock lock(tc.mutex);
+            stats.allocations += tc.allocations;
+            stats.hits += tc.hits;
+            stats.reservedSize += tc.reservedSize;
+        }
+
+        AutoLock lock(mutex);
+        stats.allocations += allocations;
+        stats.hits += hits;
+        stats.reservedSize += reservedSize;
+        return stats;
+    }
+
+    void resetStats()
+    {
+        std::vector<PoolThreadCache*> caches;
+        threadCaches.gather(caches);
+        for( size_t i = 0; i < caches.size(); i++ )
+        {
+            PoolThreadCache& tc = *caches[i];
+            AutoLock lock(tc.mutex);
+            tc.allocations = tc.hits = 0;
+        }
+
+        AutoLock lock(mutex);
+        allocations = hits = 0;
+    }
+
+    void releaseThreadCache(PoolThreadCache& tc) const
+    {
+        AutoLock tcLock(tc.mutex);
+        AutoLock lock(mutex);
+        for( int idx = 0; idx < POOL_BUCKETS; idx++ )
+        {
+            for( int j = 0; j < tc.count[idx]; j++ )
+                reserved[idx].push_back(tc.buffers[idx][j]);
+            tc.count[idx] = 0;
+        }
+        reservedSize += tc.reservedSize;
+        tc.reservedSize = 0;
+        allocations += tc.allocations;
+        hits += tc.hits;
+        tc.allocations = tc.hits = 0;
+    }
+
+protected:
+    void setLimit(size_t size)
+    {
+        maxReservedSize = size;
+        maxReservedUnits = (int)std::min(size >> POOL_UNIT_SHIFT, (size_t)INT_MAX);
+    }
+
+    void* allocateBuffer(size_t size) const
+    {
+        int idx = poolBucket(size);
+        PoolThreadCache& tc = *threadCaches.get();
+        {
+            AutoLock lock(tc.mutex);
+            tc.allocations++;
+            if( idx >= 0 && tc.count[idx] > 0 )
+            {
+                tc.hits++;
+                tc.reservedSize -= poolBucketCapacity(idx);
+                CV_XADD(&reservedUnits, -(int)(poolBucketCapacity(idx) >> POOL_UNIT_SHIFT));
+                return tc.buffers[idx][--tc.count[idx]];
+            }
+        }
+
+        if( idx < 0 )
+            return fastMalloc(size);
+
+        {
+            AutoLock lock(mutex);
+            if( !reserved[idx].empty() )
+            {
+                void* ptr = reserved[idx].back();
+                reserved[idx].pop_back();
+                reservedSize -= poolBucketCapacity(idx);
+                CV_XADD(&reservedUnits, -(int)(poolBucketCapacity(idx) >> POOL_UNIT_SHIFT));
+                hits++;
+                return ptr;
+            }
+        }
+
+        size_t capacity = poolBucketCapacity(idx);
+        void* ptr = fastMalloc(capacity);
+        numaFirstTouch(ptr, capacity);
+        return ptr;
+    }
+
+    void releaseBuffer(void* ptr, size_t size) const
+    {
+        int idx = poolBucket(size);
+        size_t capacity = idx >= 0 ? poolBucketCapacity(idx) : size;
+
+        // the same heuristic as the OpenCL buffer pool uses: don't keep the buffers
+        // larger than 1/8 of the limit, they would evict everything else
+        if( idx < 0 || capacity > maxReservedSize / 8 )
+        {
+            fastFree(ptr);
+            return;
+        }
+
+        // the thread caches and the shared pool are counted against the same limit
+        int units = (int)(capacity >> POOL_UNIT_SHIFT);
+        if( CV_XADD(&reservedUnits, units) + units > maxReservedUnits )
+        {
+            CV_XADD(&reservedUnits, -units);
+            fastFree(ptr);
+            return;
+        }
+
+        PoolThreadCache& tc = *threadCaches.get();
+        {
+            AutoLock lock(tc.mutex);
+            if( tc.count[idx] < POOL_THREAD_CACHE_DEPTH && tc.reservedSize + capacity <= maxReservedSize / 8 )
+            {
+                tc.buffers[idx][tc.count[idx]++] = ptr;
+                tc.reservedSize += capacity;
+                return;
+            }
+        }
+
+        AutoLock lock(mutex);
+        reserved[idx].push_back(ptr);
+        reservedSize += capacity;
+    }
+
+    mutable Mutex mutex;
+    mutable std::vector<void*> reserved[POOL_BUCKETS];
+    mutable size_t reservedSize;
+    // the hits of the shared pool and the requests counted by the released thread caches,
+    // the live caches count the rest
+    mutable size_t allocations;
+    mutable size_t hits;
+    // the size of the buffers kept in the thread caches and in the shared pool, in POOL_UNIT_SHIFT units
+    mutable int reservedUnits;
+
+    size_t maxReservedSize;
+    int maxReservedUnits;
+
+    // the last member, the caches are released while the shared pool is still alive
+    mutable PoolThreadCaches threadCaches;
+};
+
+PoolThreadCache::~PoolThreadCache()
+{
+    if( owner )
+        owner->releaseThreadCache(*this);
+}
+
+MatAllocator* getPoolMatAllocator()
+{
+    CV_SINGLETON_LAZY_INIT(MatAllocator, new PoolMatAllocator())
+}
+
+BufferPoolStats getPoolMatAllocatorStats()
+{
+    return static_cast<PoolMatAllocator*>(getPoolMatAllocator())->getStats();
+}
+
+void resetPoolMatAllocatorStats()
+{
+    static_cast<PoolMatAllocator*>(getPoolMatAllocator())->resetStats();
+}
+
+MatAllocatorScope::MatAllocatorScope(MatAllocator* allocator)
+{
+    // only the calling thread is affected, the nested scopes restore the outer ones
+    CoreTLSData* data = getCoreTlsData().get();
+    prevAllocator = data->matAllocator;
+    data->matAllocator = allocator;
+    CV_XADD(&g_matAllocatorScopes, 1);
+}
+
+MatAllocatorScope::~MatAllocatorScope()
+{
+    CV_XADD(&g_matAllocatorScopes, -1);
+    getCoreTlsData().get()->matAllocator = prevAllocator;
+}
+
+} // namespace cv
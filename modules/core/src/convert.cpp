@@ -44,6 +44,8 @@
 #include "precomp.hpp"
 
 #include "opencl_kernels_core.hpp"
+#include "convert.simd.hpp"
+#include "convert.simd_declarations.hpp"
 
 #ifdef __APPLE__
 #undef CV_NEON
@@ -81,15 +83,70 @@ static MergeFunc getMergeFunc(int depth)
     return mergeTab[depth];
 }
 
-void cv::split(const Mat& src, Mat* mv)
+namespace cv
 {
-    int k, depth = src.depth(), cn = src.channels();
-    if( cn == 1 )
+
+// processes the arrays of the same size or their stripes
+typedef void (*ChannelsFunc)( const Mat* src, size_t nsrcs, Mat* dst, size_t ndsts,
+                              const int* fromTo, size_t npairs );
+
+class ChannelsInvoker : public ParallelLoopBody
+{
+public:
+    ChannelsInvoker(ChannelsFunc _func, const Mat* _src, size_t _nsrcs, Mat* _dst, size_t _ndsts,
+                    const int* _fromTo, size_t _npairs, const ParallelStripes& _stripes)
+        : func(_func), src(_src), nsrcs(_nsrcs), dst(_dst), ndsts(_ndsts),
+          fromTo(_fromTo), npairs(_npairs), stripe(_stripes) {}
+
+    void operator()(const Range& range) const
     {
-        src.copyTo(mv[0]);
+        std::vector<Mat> stripes(nsrcs + ndsts);
+        for( size_t i = 0; i < nsrcs; i++ )
+            stripes[i] = stripe(src[i], range);
+        for( size_t i = 0; i < ndsts; i++ )
+            stripes[nsrcs + i] = stripe(dst[i], range);
+        func(&stripes[0], nsrcs, &stripes[nsrcs], ndsts, fromTo, npairs);
+    }
+
+protected:
+    ChannelsFunc func;
+    const Mat* src;
+    size_t nsrcs;
+    Mat* dst;
+    size_t ndsts;
+    const int* fromTo;
+    size_t npairs;
+    ParallelStripes stripe;
+};
+
+static void runChannels( ChannelsFunc func, const Mat* src, size_t nsrcs, Mat* dst, size_t ndsts,
+                         const int* fromTo, size_t npairs )
+{
+    size_t i, total = 0;
+    bool is2D = true;
+    for( i = 0; i < nsrcs; i++ )
+    {
+        total += src[i].total()*src[i].elemSize();
+        is2D = is2D && src[i].dims <= 2;
+    }
+    for( i = 0; i < ndsts; i++ )
+        is2D = is2D && dst[i].dims <= 2;
+    ParallelStripes stripes(src[0], total);
+
+    if( stripes.nstripes < 2 || !is2D )
+    {
+        func(src, nsrcs, dst, ndsts, fromTo, npairs);
         return;
     }
 
+    parallel_for_(stripes.range(), ChannelsInvoker(func, src, nsrcs, dst, ndsts, fromTo, npairs, stripes),
+                  stripes.nstripes);
+}
+
+static void splitSerial( const Mat* _src, size_t, Mat* mv, size_t, const int*, size_t )
+{
+    const Mat& src = *_src;
+    int k, depth = src.depth(), cn = src.channels();
     SplitFunc func = getSplitFunc(depth);
     CV_Assert( func != 0 );
 
@@ -101,10 +158,7 @@ void cv::split(const Mat& src, Mat* mv)
 
     arrays[0] = &src;
     for( k = 0; k < cn; k++ )
-    {
-        mv[k].create(src.dims, src.size, depth);
         arrays[k+1] = &mv[k];
-    }
 
     NAryMatIterator it(arrays, ptrs, cn+1);
     int total = (int)it.size, blocksize = cn <= 4 ? total : std::min(total, blocksize0);
@@ -126,6 +180,23 @@ void cv::split(const Mat& src, Mat* mv)
     }
 }
 
+}
+
+void cv::split(const Mat& src, Mat* mv)
+{
+    int k, depth = src.depth(), cn = src.channels();
+    if( cn == 1 )
+    {
+        src.copyTo(mv[0]);
+        return;
+    }
+
+    for( k = 0; k < cn; k++ )
+        mv[k].create(src.dims, src.size, depth);
+
+    runChannels(splitSerial, &src, 1, mv, cn, 0, 0);
+}
+
 #ifdef HAVE_OPENCL
 
 namespace cv {
@@ -174,6 +245,8 @@ static bool ocl_split( InputArray _m, OutputArrayOfArrays _mv )
 
 void cv::split(InputArray _m, OutputArrayOfArrays _mv)
 {
+    CV_TRACE_FUNCTION();
+
     CV_OCL_RUN(_m.dims() <= 2 && _mv.isUMatVector(),
                ocl_split(_m, _mv))
 
@@ -197,6 +270,47 @@ void cv::split(InputArray _m, OutputArrayOfArrays _mv)
     split(m, &dst[0]);
 }
 
+namespace cv
+{
+
+// merges the single-channel arrays
+static void mergeSerial( const Mat* mv, size_t, Mat* _dst, size_t, const int*, size_t )
+{
+    Mat& dst = *_dst;
+    int k, cn = dst.channels();
+    size_t i, esz = dst.elemSize(), esz1 = dst.elemSize1();
+    int blocksize0 = (int)((BLOCK_SIZE + esz-1)/esz);
+    AutoBuffer<uchar> _buf((cn+1)*(sizeof(Mat*) + sizeof(uchar*)) + 16);
+    const Mat** arrays = (const Mat**)(uchar*)_buf;
+    uchar** ptrs = (uchar**)alignPtr(arrays + cn + 1, 16);
+
+    arrays[0] = &dst;
+    for( k = 0; k < cn; k++ )
+        arrays[k+1] = &mv[k];
+
+    NAryMatIterator it(arrays, ptrs, cn+1);
+    int total = (int)it.size, blocksize = cn <= 4 ? total : std::min(total, blocksize0);
+    MergeFunc func = getMergeFunc(dst.depth());
+
+    for( i = 0; i < it.nplanes; i++, ++it )
+    {
+        for( int j = 0; j < total; j += blocksize )
+        {
+            int bsz = std::min(total - j, blocksize);
+            func( (const uchar**)&ptrs[1], ptrs[0], bsz, cn );
+
+            if( j + blocksize < total )
+            {
+                ptrs[0] += bsz*esz;
+                for( int t = 0; t < cn; t++ )
+                    ptrs[t+1] += bsz*esz1;
+            }
+        }
+    }
+}
+
+}
+
 void cv::merge(const Mat* mv, size_t n, OutputArray _dst)
 {
     CV_Assert( mv && n > 0 );
@@ -241,35 +355,7 @@ void cv::merge(const Mat* mv, size_t n, OutputArray _dst)
         return;
     }
 
-    size_t esz = dst.elemSize(), esz1 = dst.elemSize1();
-    int blocksize0 = (int)((BLOCK_SIZE + esz-1)/esz);
-    AutoBuffer<uchar> _buf((cn+1)*(sizeof(Mat*) + sizeof(uchar*)) + 16);
-    const Mat** arrays = (const Mat**)(uchar*)_buf;
-    uchar** ptrs = (uchar**)alignPtr(arrays + cn + 1, 16);
-
-    arrays[0] = &dst;
-    for( k = 0; k < cn; k++ )
-        arrays[k+1] = &mv[k];
-
-    NAryMatIterator it(arrays, ptrs, cn+1);
-    int total = (int)it.size, blocksize = cn <= 4 ? total : std::min(total, blocksize0);
-    MergeFunc func = getMergeFunc(depth);
-
-    for( i = 0; i < it.nplanes; i++, ++it )
-    {
-        for( int j = 0; j < total; j += blocksize )
-        {
-            int bsz = std::min(total - j, blocksize);
-            func( (const uchar**)&ptrs[1], ptrs[0], bsz, cn );
-
-            if( j + blocksize < total )
-            {
-                ptrs[0] += bsz*esz;
-                for( int t = 0; t < cn; t++ )
-                    ptrs[t+1] += bsz*esz1;
-            }
-        }
-    }
+    runChannels(mergeSerial, mv, n, &dst, 1, 0, 0);
 }
 
 #ifdef HAVE_OPENCL
@@ -340,6 +426,8 @@ static bool ocl_merge( InputArrayOfArrays _mv, OutputArray _dst )
 
 void cv::merge(InputArrayOfArrays _mv, OutputArray _dst)
 {
+    CV_TRACE_FUNCTION();
+
     CV_OCL_RUN(_mv.isUMatVector() && _dst.isUMat(),
                ocl_merge(_mv, _dst))
 
@@ -430,14 +518,136 @@ static MixChannelsFunc getMixchFunc(int depth)
     return mixchTab[depth];
 }
 
+// The common case of mixChannels: every channel of the only destination array is taken from
+// the only source array or filled with 0, e.g. BGR<->RGB, BGRA->RGB, BGR->BGRA or extracting
+// one channel. map[k] is the source channel of the k-th destination channel or -1.
+#if CV_SIMD128
+template<typename T, typename VecT> static int
+vecShuffleChannels_( const T* src, int scn, T* dst, int dcn, const int* map, int len, const VecT& zero )
+{
+    const int VECSZ = VecT::nlanes;
+    VecT v[5];
+    int k, m[4] = { 4, 4, 4, 4 }, i = 0;
+
+    v[4] = zero;
+    for( k = 0; k < dcn; k++ )
+        m[k] = map[k] >= 0 ? map[k] : 4;
+
+    for( ; i <= len - VECSZ; i += VECSZ )
+    {
+        const T* s = src + i*scn;
+        T* d = dst + i*dcn;
+
+        if( scn == 1 )
+            v[0] = v_load(s);
+        else if( scn == 2 )
+            v_load_deinterleave(s, v[0], v[1]);
+        else if( scn == 3 )
+            v_load_deinterleave(s, v[0], v[1], v[2]);
+        else
+            v_load_deinterleave(s, v[0], v[1], v[2], v[3]);
+
+        if( dcn == 1 )
+            v_store(d, v[m[0]]);
+        else if( dcn == 2 )
+            v_store_interleave(d, v[m[0]], v[m[1]]);
+        else if( dcn == 3 )
+            v_store_interleave(d, v[m[0]], v[m[1]], v[m[2]]);
+        else
+            v_store_interleave(d, v[m[0]], v[m[1]], v[m[2]], v[m[3]]);
+    }
+    return i;
+}
+
+static int vecShuffleChannels( const uchar* src, int scn, uchar* dst, int dcn, const int* map, int len )
+{ return vecShuffleChannels_(src, scn, dst, dcn, map, len, v_setzero_u8()); }
+
+static int vecShuffleChannels( const ushort* src, int scn, ushort* dst, int dcn, const int* map, int len )
+{ return vecShuffleChannels_(src, scn, dst, dcn, map, len, v_setzero_u16()); }
+
+static int vecShuffleChannels( const int* src, int scn, int* dst, int dcn, const int* map, int len )
+{ return vecShuffleChannels_(src, scn, dst, dcn, map, len, v_setzero_s32()); }
+#endif
+
+template<typename T> static int
+vecShuffleChannels( const T*, int, T*, int, const int*, int )
+{
+    return 0;
 }
 
-void cv::mixChannels( const Mat* src, size_t nsrcs, Mat* dst, size_t ndsts, const int* fromTo, size_t npairs )
+template<typename T> static void
+shuffleChannels_( const T* src, int scn, T* dst, int dcn, const int* map, int len )
 {
-    if( npairs == 0 )
-        return;
-    CV_Assert( src && nsrcs > 0 && dst && ndsts > 0 && fromTo && npairs > 0 );
+    int i = vecShuffleChannels(src, scn, dst, dcn, map, len), k;
+    for( ; i < len; i++ )
+    {
+        // the source and the destination may be the same array
+        T buf[4];
+        for( k = 0; k < dcn; k++ )
+            buf[k] = map[k] >= 0 ? src[i*scn + map[k]] : 0;
+        for( k = 0; k < dcn; k++ )
+            dst[i*dcn + k] = buf[k];
+    }
+}
+
+static void shuffleChannels8u( const uchar* src, int scn, uchar* dst, int dcn, const int* map, int len )
+{
+    shuffleChannels_(src, scn, dst, dcn, map, len);
+}
+
+static void shuffleChannels16u( const ushort* src, int scn, ushort* dst, int dcn, const int* map, int len )
+{
+    shuffleChannels_(src, scn, dst, dcn, map, len);
+}
+
+static void shuffleChannels32s( const int* src, int scn, int* dst, int dcn, const int* map, int len )
+{
+    shuffleChannels_(src, scn, dst, dcn, map, len);
+}
+
+static void shuffleChannels64s( const int64* src, int scn, int64* dst, int dcn, const int* map, int len )
+{
+    shuffleChannels_(src, scn, dst, dcn, map, len);
+}
+
+typedef void (*ShuffleChannelsFunc)( const uchar* src, int scn, uchar* dst, int dcn, const int* map, int len );
 
+static ShuffleChannelsFunc getShuffleChannelsFunc(int depth)
+{
+    static ShuffleChannelsFunc shuffleTab[] =
+    {
+        (ShuffleChannelsFunc)shuffleChannels8u, (ShuffleChannelsFunc)shuffleChannels8u, (ShuffleChannelsFunc)shuffleChannels16u,
+        (ShuffleChannelsFunc)shuffleChannels16u, (ShuffleChannelsFunc)shuffleChannels32s, (ShuffleChannelsFunc)shuffleChannels32s,
+        (ShuffleChannelsFunc)shuffleChannels64s, 0
+    };
+
+    return shuffleTab[depth];
+}
+
+// returns false if fromTo is not a shuffle of the channels of one array into all the channels of another one
+static bool getShuffleMap( const Mat* src, size_t nsrcs, const Mat* dst, size_t ndsts,
+                           const int* fromTo, size_t npairs, int* map )
+{
+    int scn = src[0].channels(), dcn = dst[0].channels();
+    if( nsrcs != 1 || ndsts != 1 || scn > 4 || dcn > 4 || (int)npairs != dcn ||
+        src[0].depth() != dst[0].depth() )
+        return false;
+
+    int k;
+    for( k = 0; k < dcn; k++ )
+        map[k] = INT_MIN;
+    for( k = 0; k < dcn; k++ )
+    {
+        int i0 = fromTo[k*2], i1 = fromTo[k*2+1];
+        if( i0 >= scn || i1 < 0 || i1 >= dcn || map[i1] != INT_MIN )
+            return false;
+        map[i1] = i0 >= 0 ? i0 : -1;
+    }
+    return true;
+}
+
+static void mixChannelsSerial( const Mat* src, size_t nsrcs, Mat* dst, size_t ndsts, const int* fromTo, size_t npairs )
+{
     size_t i, j, k, esz1 = dst[0].elemSize1();
     int depth = dst[0].depth();
 
@@ -483,6 +693,16 @@ void cv::mixChannels( const Mat* src, size_t nsrcs, Mat* dst, size_t ndsts, cons
 
     NAryMatIterator it(arrays, ptrs, (int)(nsrcs + ndsts));
     int total = (int)it.size, blocksize = std::min(total, (int)((BLOCK_SIZE + esz1-1)/esz1));
+    int map[4];
+
+    if( getShuffleMap(src, nsrcs, dst, ndsts, fromTo, npairs, map) )
+    {
+        ShuffleChannelsFunc func = getShuffleChannelsFunc(depth);
+        for( i = 0; i < it.nplanes; i++, ++it )
+            func( ptrs[0], src[0].channels(), ptrs[1], dst[0].channels(), map, total );
+        return;
+    }
+
     MixChannelsFunc func = getMixchFunc(depth);
 
     for( i = 0; i < it.nplanes; i++, ++it )
@@ -508,6 +728,17 @@ void cv::mixChannels( const Mat* src, size_t nsrcs, Mat* dst, size_t ndsts, cons
     }
 }
 
+}
+
+void cv::mixChannels( const Mat* src, size_t nsrcs, Mat* dst, size_t ndsts, const int* fromTo, size_t npairs )
+{
+    if( npairs == 0 )
+        return;
+    CV_Assert( src && nsrcs > 0 && dst && ndsts > 0 && fromTo && npairs > 0 );
+
+    runChannels(mixChannelsSerial, src, nsrcs, dst, ndsts, fromTo, npairs);
+}
+
 #ifdef HAVE_OPENCL
 
 namespace cv {
@@ -610,6 +841,8 @@ static bool ocl_mixChannels(InputArrayOfArrays _src, InputOutputArrayOfArrays _d
 void cv::mixChannels(InputArrayOfArrays src, InputOutputArrayOfArrays dst,
                  const int* fromTo, size_t npairs)
 {
+    CV_TRACE_FUNCTION();
+
     if (npairs == 0 || fromTo == NULL)
         return;
 
@@ -639,6 +872,8 @@ void cv::mixChannels(InputArrayOfArrays src, InputOutputArrayOfArrays dst,
 void cv::mixChannels(InputArrayOfArrays src, InputOutputArrayOfArrays dst,
                      const std::vector<int>& fromTo)
 {
+    CV_TRACE_FUNCTION();
+
     if (fromTo.empty())
         return;
 
@@ -1206,14 +1441,60 @@ struct cvtScale_SIMD
     }
 };
 
+// the kernels with the float working type are compiled for several instruction sets, see convert.simd.hpp
+#define DEF_CVT_SCALE_SIMD(stype, dtype) \
+template <> \
+struct cvtScale_SIMD<stype, dtype, float> \
+{ \
+    int operator () (const stype * src, dtype * dst, int width, float scale, float shift) const \
+    { \
+        return CV_CPU_DISPATCH(cvtScale_simd, (src, dst, width, scale, shift)); \
+    } \
+};
+
+DEF_CVT_SCALE_SIMD(uchar, uchar)
+DEF_CVT_SCALE_SIMD(uchar, schar)
+DEF_CVT_SCALE_SIMD(uchar, ushort)
+DEF_CVT_SCALE_SIMD(uchar, short)
+DEF_CVT_SCALE_SIMD(uchar, int)
+DEF_CVT_SCALE_SIMD(uchar, float)
+
+DEF_CVT_SCALE_SIMD(schar, uchar)
+DEF_CVT_SCALE_SIMD(schar, schar)
+DEF_CVT_SCALE_SIMD(schar, ushort)
+DEF_CVT_SCALE_SIMD(schar, short)
+DEF_CVT_SCALE_SIMD(schar, int)
+DEF_CVT_SCALE_SIMD(schar, float)
+
+DEF_CVT_SCALE_SIMD(ushort, uchar)
+DEF_CVT_SCALE_SIMD(ushort, schar)
+DEF_CVT_SCALE_SIMD(ushort, ushort)
+DEF_CVT_SCALE_SIMD(ushort, short)
+DEF_CVT_SCALE_SIMD(ushort, int)
+DEF_CVT_SCALE_SIMD(ushort, float)
+
+DEF_CVT_SCALE_SIMD(short, uchar)
+DEF_CVT_SCALE_SIMD(short, schar)
+DEF_CVT_SCALE_SIMD(short, ushort)
+DEF_CVT_SCALE_SIMD(short, float)
+
+DEF_CVT_SCALE_SIMD(float, uchar)
+DEF_CVT_SCALE_SIMD(float, schar)
+DEF_CVT_SCALE_SIMD(float, ushort)
+DEF_CVT_SCALE_SIMD(float, short)
+DEF_CVT_SCALE_SIMD(float, int)
+DEF_CVT_SCALE_SIMD(float, float)
+
+#undef DEF_CVT_SCALE_SIMD
+
 #if CV_SSE2
 
 // from uchar
 
 template <>
-struct cvtScale_SIMD<uchar, uchar, float>
+struct cvtScale_SIMD<uchar, double, double>
 {
-    int operator () (const uchar * src, uchar * dst, int width, float scale, float shift) const
+    int operator () (const uchar * src, double * dst, int width, double scale, double shift) const
     {
         int x = 0;
 
@@ -1221,30 +1502,35 @@ struct cvtScale_SIMD<uchar, uchar, float>
             return x;
 
         __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
+        __m128d v_scale = _mm_set1_pd(scale), v_shift = _mm_set1_pd(shift);
 
         for ( ; x <= width - 8; x += 8)
         {
             __m128i v_src = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i const *)(src + x)), v_zero);
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v_src, v_zero));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
 
-            v_src_f = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v_src, v_zero));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            __m128i v_src_s32 = _mm_unpacklo_epi16(v_src, v_zero);
+            __m128d v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src_s32), v_scale), v_shift);
+            __m128d v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(v_src_s32, 8)), v_scale), v_shift);
+            _mm_storeu_pd(dst + x, v_dst_0);
+            _mm_storeu_pd(dst + x + 2, v_dst_1);
 
-            __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
-                                            _mm_cvtps_epi32(v_dst_1));
-            _mm_storel_epi64((__m128i *)(dst + x), _mm_packus_epi16(v_dst, v_zero));
+            v_src_s32 = _mm_unpackhi_epi16(v_src, v_zero);
+            v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src_s32), v_scale), v_shift);
+            v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(v_src_s32, 8)), v_scale), v_shift);
+            _mm_storeu_pd(dst + x + 4, v_dst_0);
+            _mm_storeu_pd(dst + x + 6, v_dst_1);
         }
 
         return x;
     }
 };
 
+// from schar
+
 template <>
-struct cvtScale_SIMD<uchar, schar, float>
+struct cvtScale_SIMD<schar, double, double>
 {
-    int operator () (const uchar * src, schar * dst, int width, float scale, float shift) const
+    int operator () (const schar * src, double * dst, int width, double scale, double shift) const
     {
         int x = 0;
 
@@ -1252,72 +1538,72 @@ struct cvtScale_SIMD<uchar, schar, float>
             return x;
 
         __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
+        __m128d v_scale = _mm_set1_pd(scale), v_shift = _mm_set1_pd(shift);
 
         for ( ; x <= width - 8; x += 8)
         {
-            __m128i v_src = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i const *)(src + x)), v_zero);
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v_src, v_zero));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            __m128i v_src = _mm_unpacklo_epi8(v_zero, _mm_loadl_epi64((__m128i const *)(src + x)));
+            v_src = _mm_srai_epi16(v_src, 8);
 
-            v_src_f = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v_src, v_zero));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            __m128i v_src_s32 = _mm_srai_epi32(_mm_unpacklo_epi16(v_zero, v_src), 16);
+            __m128d v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src_s32), v_scale), v_shift);
+            __m128d v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(v_src_s32, 8)), v_scale), v_shift);
+            _mm_storeu_pd(dst + x, v_dst_0);
+            _mm_storeu_pd(dst + x + 2, v_dst_1);
 
-            __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
-                                            _mm_cvtps_epi32(v_dst_1));
-            _mm_storel_epi64((__m128i *)(dst + x), _mm_packs_epi16(v_dst, v_zero));
+            v_src_s32 = _mm_srai_epi32(_mm_unpackhi_epi16(v_zero, v_src), 16);
+            v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src_s32), v_scale), v_shift);
+            v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(v_src_s32, 8)), v_scale), v_shift);
+            _mm_storeu_pd(dst + x + 4, v_dst_0);
+            _mm_storeu_pd(dst + x + 6, v_dst_1);
         }
 
         return x;
     }
 };
 
-#if CV_SSE4_1
+// from ushort
 
 template <>
-struct cvtScale_SIMD<uchar, ushort, float>
+struct cvtScale_SIMD<ushort, double, double>
 {
-    cvtScale_SIMD()
-    {
-        haveSSE = checkHardwareSupport(CV_CPU_SSE4_1);
-    }
-
-    int operator () (const uchar * src, ushort * dst, int width, float scale, float shift) const
+    int operator () (const ushort * src, double * dst, int width, double scale, double shift) const
     {
         int x = 0;
 
-        if (!haveSSE)
+        if (!USE_SSE2)
             return x;
 
         __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
+        __m128d v_scale = _mm_set1_pd(scale), v_shift = _mm_set1_pd(shift);
 
         for ( ; x <= width - 8; x += 8)
         {
-            __m128i v_src = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i const *)(src + x)), v_zero);
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v_src, v_zero));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
 
-            v_src_f = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v_src, v_zero));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            __m128i v_src_s32 = _mm_unpacklo_epi16(v_src, v_zero);
+            __m128d v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src_s32), v_scale), v_shift);
+            __m128d v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(v_src_s32, 8)), v_scale), v_shift);
+            _mm_storeu_pd(dst + x, v_dst_0);
+            _mm_storeu_pd(dst + x + 2, v_dst_1);
 
-            __m128i v_dst = _mm_packus_epi32(_mm_cvtps_epi32(v_dst_0),
-                                             _mm_cvtps_epi32(v_dst_1));
-            _mm_storeu_si128((__m128i *)(dst + x), v_dst);
+            v_src_s32 = _mm_unpackhi_epi16(v_src, v_zero);
+            v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src_s32), v_scale), v_shift);
+            v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(v_src_s32, 8)), v_scale), v_shift);
+            _mm_storeu_pd(dst + x + 4, v_dst_0);
+            _mm_storeu_pd(dst + x + 6, v_dst_1);
         }
 
         return x;
     }
-
-    bool haveSSE;
 };
 
-#endif
+// from short
 
 template <>
-struct cvtScale_SIMD<uchar, short, float>
+struct cvtScale_SIMD<short, short, float>
 {
-    int operator () (const uchar * src, short * dst, int width, float scale, float shift) const
+    int operator () (const short * src, short * dst, int width, float scale, float shift) const
     {
         int x = 0;
 
@@ -1329,11 +1615,11 @@ struct cvtScale_SIMD<uchar, short, float>
 
         for ( ; x <= width - 8; x += 8)
         {
-            __m128i v_src = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i const *)(src + x)), v_zero);
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v_src, v_zero));
+            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
+            __m128 v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v_zero, v_src), 16));
             __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
 
-            v_src_f = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v_src, v_zero));
+            v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v_zero, v_src), 16));
             __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
 
             __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
@@ -1346,9 +1632,9 @@ struct cvtScale_SIMD<uchar, short, float>
 };
 
 template <>
-struct cvtScale_SIMD<uchar, int, float>
+struct cvtScale_SIMD<short, int, float>
 {
-    int operator () (const uchar * src, int * dst, int width, float scale, float shift) const
+    int operator () (const short * src, int * dst, int width, float scale, float shift) const
     {
         int x = 0;
 
@@ -1360,11 +1646,11 @@ struct cvtScale_SIMD<uchar, int, float>
 
         for ( ; x <= width - 8; x += 8)
         {
-            __m128i v_src = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i const *)(src + x)), v_zero);
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v_src, v_zero));
+            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
+            __m128 v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v_zero, v_src), 16));
             __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
 
-            v_src_f = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v_src, v_zero));
+            v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v_zero, v_src), 16));
             __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
 
             _mm_storeu_si128((__m128i *)(dst + x), _mm_cvtps_epi32(v_dst_0));
@@ -1376,39 +1662,9 @@ struct cvtScale_SIMD<uchar, int, float>
 };
 
 template <>
-struct cvtScale_SIMD<uchar, float, float>
-{
-    int operator () (const uchar * src, float * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128i v_src = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i const *)(src + x)), v_zero);
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v_src, v_zero));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
-
-            v_src_f = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v_src, v_zero));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
-
-            _mm_storeu_ps(dst + x, v_dst_0);
-            _mm_storeu_ps(dst + x + 4, v_dst_1);
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<uchar, double, double>
+struct cvtScale_SIMD<short, double, double>
 {
-    int operator () (const uchar * src, double * dst, int width, double scale, double shift) const
+    int operator () (const short * src, double * dst, int width, double scale, double shift) const
     {
         int x = 0;
 
@@ -1420,15 +1676,15 @@ struct cvtScale_SIMD<uchar, double, double>
 
         for ( ; x <= width - 8; x += 8)
         {
-            __m128i v_src = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i const *)(src + x)), v_zero);
+            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
 
-            __m128i v_src_s32 = _mm_unpacklo_epi16(v_src, v_zero);
+            __m128i v_src_s32 = _mm_srai_epi32(_mm_unpacklo_epi16(v_zero, v_src), 16);
             __m128d v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src_s32), v_scale), v_shift);
             __m128d v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(v_src_s32, 8)), v_scale), v_shift);
             _mm_storeu_pd(dst + x, v_dst_0);
             _mm_storeu_pd(dst + x + 2, v_dst_1);
 
-            v_src_s32 = _mm_unpackhi_epi16(v_src, v_zero);
+            v_src_s32 = _mm_srai_epi32(_mm_unpackhi_epi16(v_zero, v_src), 16);
             v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src_s32), v_scale), v_shift);
             v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(v_src_s32, 8)), v_scale), v_shift);
             _mm_storeu_pd(dst + x + 4, v_dst_0);
@@ -1439,12 +1695,12 @@ struct cvtScale_SIMD<uchar, double, double>
     }
 };
 
-// from schar
+// from int
 
 template <>
-struct cvtScale_SIMD<schar, uchar, float>
+struct cvtScale_SIMD<int, uchar, float>
 {
-    int operator () (const schar * src, uchar * dst, int width, float scale, float shift) const
+    int operator () (const int * src, uchar * dst, int width, float scale, float shift) const
     {
         int x = 0;
 
@@ -1456,12 +1712,11 @@ struct cvtScale_SIMD<schar, uchar, float>
 
         for ( ; x <= width - 8; x += 8)
         {
-            __m128i v_src = _mm_srai_epi16(_mm_unpacklo_epi8(v_zero, _mm_loadl_epi64((__m128i const *)(src + x))), 8);
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v_zero, v_src), 16));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
+            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(v_src), v_scale), v_shift);
 
-            v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v_zero, v_src), 16));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            v_src = _mm_loadu_si128((__m128i const *)(src + x + 4));
+            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(v_src), v_scale), v_shift);
 
             __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
                                             _mm_cvtps_epi32(v_dst_1));
@@ -1473,9 +1728,9 @@ struct cvtScale_SIMD<schar, uchar, float>
 };
 
 template <>
-struct cvtScale_SIMD<schar, schar, float>
+struct cvtScale_SIMD<int, schar, float>
 {
-    int operator () (const schar * src, schar * dst, int width, float scale, float shift) const
+    int operator () (const int * src, schar * dst, int width, float scale, float shift) const
     {
         int x = 0;
 
@@ -1487,12 +1742,11 @@ struct cvtScale_SIMD<schar, schar, float>
 
         for ( ; x <= width - 8; x += 8)
         {
-            __m128i v_src = _mm_srai_epi16(_mm_unpacklo_epi8(v_zero, _mm_loadl_epi64((__m128i const *)(src + x))), 8);
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v_zero, v_src), 16));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
+            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(v_src), v_scale), v_shift);
 
-            v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v_zero, v_src), 16));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            v_src = _mm_loadu_si128((__m128i const *)(src + x + 4));
+            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(v_src), v_scale), v_shift);
 
             __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
                                             _mm_cvtps_epi32(v_dst_1));
@@ -1506,31 +1760,29 @@ struct cvtScale_SIMD<schar, schar, float>
 #if CV_SSE4_1
 
 template <>
-struct cvtScale_SIMD<schar, ushort, float>
+struct cvtScale_SIMD<int, ushort, float>
 {
     cvtScale_SIMD()
     {
         haveSSE = checkHardwareSupport(CV_CPU_SSE4_1);
     }
 
-    int operator () (const schar * src, ushort * dst, int width, float scale, float shift) const
+    int operator () (const int * src, ushort * dst, int width, float scale, float shift) const
     {
         int x = 0;
 
         if (!haveSSE)
             return x;
 
-        __m128i v_zero = _mm_setzero_si128();
         __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
 
         for ( ; x <= width - 8; x += 8)
         {
-            __m128i v_src = _mm_srai_epi16(_mm_unpacklo_epi8(v_zero, _mm_loadl_epi64((__m128i const *)(src + x))), 8);
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v_zero, v_src), 16));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
+            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(v_src), v_scale), v_shift);
 
-            v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v_zero, v_src), 16));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            v_src = _mm_loadu_si128((__m128i const *)(src + x + 4));
+            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(v_src), v_scale), v_shift);
 
             __m128i v_dst = _mm_packus_epi32(_mm_cvtps_epi32(v_dst_0),
                                              _mm_cvtps_epi32(v_dst_1));
@@ -1546,26 +1798,24 @@ struct cvtScale_SIMD<schar, ushort, float>
 #endif
 
 template <>
-struct cvtScale_SIMD<schar, short, float>
+struct cvtScale_SIMD<int, short, float>
 {
-    int operator () (const schar * src, short * dst, int width, float scale, float shift) const
+    int operator () (const int * src, short * dst, int width, float scale, float shift) const
     {
         int x = 0;
 
         if (!USE_SSE2)
             return x;
 
-        __m128i v_zero = _mm_setzero_si128();
         __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
 
         for ( ; x <= width - 8; x += 8)
         {
-            __m128i v_src = _mm_srai_epi16(_mm_unpacklo_epi8(v_zero, _mm_loadl_epi64((__m128i const *)(src + x))), 8);
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v_zero, v_src), 16));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
+            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(v_src), v_scale), v_shift);
 
-            v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v_zero, v_src), 16));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            v_src = _mm_loadu_si128((__m128i const *)(src + x + 4));
+            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(v_src), v_scale), v_shift);
 
             __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
                                             _mm_cvtps_epi32(v_dst_1));
@@ -1577,29 +1827,29 @@ struct cvtScale_SIMD<schar, short, float>
 };
 
 template <>
-struct cvtScale_SIMD<schar, int, float>
+struct cvtScale_SIMD<int, int, double>
 {
-    int operator () (const schar * src, int * dst, int width, float scale, float shift) const
+    int operator () (const int * src, int * dst, int width, double scale, double shift) const
     {
         int x = 0;
 
         if (!USE_SSE2)
             return x;
 
-        __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
+        __m128d v_scale = _mm_set1_pd(scale), v_shift = _mm_set1_pd(shift);
 
-        for ( ; x <= width - 8; x += 8)
+        for ( ; x <= width - 4; x += 4)
         {
-            __m128i v_src = _mm_srai_epi16(_mm_unpacklo_epi8(v_zero, _mm_loadl_epi64((__m128i const *)(src + x))), 8);
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v_zero, v_src), 16));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
+            __m128d v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src), v_scale), v_shift);
 
-            v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v_zero, v_src), 16));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            v_src = _mm_srli_si128(v_src, 8);
+            __m128d v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src), v_scale), v_shift);
 
-            _mm_storeu_si128((__m128i *)(dst + x), _mm_cvtps_epi32(v_dst_0));
-            _mm_storeu_si128((__m128i *)(dst + x + 4), _mm_cvtps_epi32(v_dst_1));
+            __m128 v_dst = _mm_movelh_ps(_mm_castsi128_ps(_mm_cvtpd_epi32(v_dst_0)),
+                                         _mm_castsi128_ps(_mm_cvtpd_epi32(v_dst_1)));
+
+            _mm_storeu_si128((__m128i *)(dst + x), _mm_castps_si128(v_dst));
         }
 
         return x;
@@ -1607,29 +1857,27 @@ struct cvtScale_SIMD<schar, int, float>
 };
 
 template <>
-struct cvtScale_SIMD<schar, float, float>
+struct cvtScale_SIMD<int, float, double>
 {
-    int operator () (const schar * src, float * dst, int width, float scale, float shift) const
+    int operator () (const int * src, float * dst, int width, double scale, double shift) const
     {
         int x = 0;
 
         if (!USE_SSE2)
             return x;
 
-        __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
+        __m128d v_scale = _mm_set1_pd(scale), v_shift = _mm_set1_pd(shift);
 
-        for ( ; x <= width - 8; x += 8)
+        for ( ; x <= width - 4; x += 4)
         {
-            __m128i v_src = _mm_srai_epi16(_mm_unpacklo_epi8(v_zero, _mm_loadl_epi64((__m128i const *)(src + x))), 8);
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v_zero, v_src), 16));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
+            __m128d v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src), v_scale), v_shift);
 
-            v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v_zero, v_src), 16));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            v_src = _mm_srli_si128(v_src, 8);
+            __m128d v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src), v_scale), v_shift);
 
-            _mm_storeu_ps(dst + x, v_dst_0);
-            _mm_storeu_ps(dst + x + 4, v_dst_1);
+            _mm_storeu_ps(dst + x, _mm_movelh_ps(_mm_cvtpd_ps(v_dst_0),
+                                                 _mm_cvtpd_ps(v_dst_1)));
         }
 
         return x;
@@ -1637,46 +1885,68 @@ struct cvtScale_SIMD<schar, float, float>
 };
 
 template <>
-struct cvtScale_SIMD<schar, double, double>
+struct cvtScale_SIMD<int, double, double>
 {
-    int operator () (const schar * src, double * dst, int width, double scale, double shift) const
+    int operator () (const int * src, double * dst, int width, double scale, double shift) const
     {
         int x = 0;
 
         if (!USE_SSE2)
             return x;
 
-        __m128i v_zero = _mm_setzero_si128();
         __m128d v_scale = _mm_set1_pd(scale), v_shift = _mm_set1_pd(shift);
 
-        for ( ; x <= width - 8; x += 8)
+        for ( ; x <= width - 4; x += 4)
         {
-            __m128i v_src = _mm_unpacklo_epi8(v_zero, _mm_loadl_epi64((__m128i const *)(src + x)));
-            v_src = _mm_srai_epi16(v_src, 8);
+            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
+            __m128d v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src), v_scale), v_shift);
+
+            v_src = _mm_srli_si128(v_src, 8);
+            __m128d v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src), v_scale), v_shift);
 
-            __m128i v_src_s32 = _mm_srai_epi32(_mm_unpacklo_epi16(v_zero, v_src), 16);
-            __m128d v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src_s32), v_scale), v_shift);
-            __m128d v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(v_src_s32, 8)), v_scale), v_shift);
             _mm_storeu_pd(dst + x, v_dst_0);
             _mm_storeu_pd(dst + x + 2, v_dst_1);
+        }
 
-            v_src_s32 = _mm_srai_epi32(_mm_unpackhi_epi16(v_zero, v_src), 16);
-            v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src_s32), v_scale), v_shift);
-            v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(v_src_s32, 8)), v_scale), v_shift);
-            _mm_storeu_pd(dst + x + 4, v_dst_0);
-            _mm_storeu_pd(dst + x + 6, v_dst_1);
+        return x;
+    }
+};
+
+// from float
+
+template <>
+struct cvtScale_SIMD<float, double, double>
+{
+    int operator () (const float * src, double * dst, int width, double scale, double shift) const
+    {
+        int x = 0;
+
+        if (!USE_SSE2)
+            return x;
+
+        __m128d v_scale = _mm_set1_pd(scale), v_shift = _mm_set1_pd(shift);
+
+        for ( ; x <= width - 4; x += 4)
+        {
+            __m128 v_src = _mm_loadu_ps(src + x);
+            __m128d v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtps_pd(v_src), v_scale), v_shift);
+            v_src = _mm_castsi128_ps(_mm_srli_si128(_mm_castps_si128(v_src), 8));
+            __m128d v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtps_pd(v_src), v_scale), v_shift);
+
+            _mm_storeu_pd(dst + x, v_dst_0);
+            _mm_storeu_pd(dst + x + 2, v_dst_1);
         }
 
         return x;
     }
 };
 
-// from ushort
+// from double
 
 template <>
-struct cvtScale_SIMD<ushort, uchar, float>
+struct cvtScale_SIMD<double, uchar, float>
 {
-    int operator () (const ushort * src, uchar * dst, int width, float scale, float shift) const
+    int operator () (const double * src, uchar * dst, int width, float scale, float shift) const
     {
         int x = 0;
 
@@ -1688,12 +1958,13 @@ struct cvtScale_SIMD<ushort, uchar, float>
 
         for ( ; x <= width - 8; x += 8)
         {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v_src, v_zero));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            __m128 v_src = _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(src + x)),
+                                         _mm_cvtpd_ps(_mm_loadu_pd(src + x + 2)));
+            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
 
-            v_src_f = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v_src, v_zero));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            v_src = _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(src + x + 4)),
+                                  _mm_cvtpd_ps(_mm_loadu_pd(src + x + 6)));
+            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
 
             __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
                                             _mm_cvtps_epi32(v_dst_1));
@@ -1705,9 +1976,9 @@ struct cvtScale_SIMD<ushort, uchar, float>
 };
 
 template <>
-struct cvtScale_SIMD<ushort, schar, float>
+struct cvtScale_SIMD<double, schar, float>
 {
-    int operator () (const ushort * src, schar * dst, int width, float scale, float shift) const
+    int operator () (const double * src, schar * dst, int width, float scale, float shift) const
     {
         int x = 0;
 
@@ -1719,12 +1990,13 @@ struct cvtScale_SIMD<ushort, schar, float>
 
         for ( ; x <= width - 8; x += 8)
         {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v_src, v_zero));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            __m128 v_src = _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(src + x)),
+                                         _mm_cvtpd_ps(_mm_loadu_pd(src + x + 2)));
+            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
 
-            v_src_f = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v_src, v_zero));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            v_src = _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(src + x + 4)),
+                                  _mm_cvtpd_ps(_mm_loadu_pd(src + x + 6)));
+            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
 
             __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
                                             _mm_cvtps_epi32(v_dst_1));
@@ -1738,31 +2010,31 @@ struct cvtScale_SIMD<ushort, schar, float>
 #if CV_SSE4_1
 
 template <>
-struct cvtScale_SIMD<ushort, ushort, float>
+struct cvtScale_SIMD<double, ushort, float>
 {
     cvtScale_SIMD()
     {
         haveSSE = checkHardwareSupport(CV_CPU_SSE4_1);
     }
 
-    int operator () (const ushort * src, ushort * dst, int width, float scale, float shift) const
+    int operator () (const double * src, ushort * dst, int width, float scale, float shift) const
     {
         int x = 0;
 
         if (!haveSSE)
             return x;
 
-        __m128i v_zero = _mm_setzero_si128();
         __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
 
         for ( ; x <= width - 8; x += 8)
         {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v_src, v_zero));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            __m128 v_src = _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(src + x)),
+                                         _mm_cvtpd_ps(_mm_loadu_pd(src + x + 2)));
+            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
 
-            v_src_f = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v_src, v_zero));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
+            v_src = _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(src + x + 4)),
+                                  _mm_cvtpd_ps(_mm_loadu_pd(src + x + 6)));
+            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
 
             __m128i v_dst = _mm_packus_epi32(_mm_cvtps_epi32(v_dst_0),
                                              _mm_cvtps_epi32(v_dst_1));
@@ -1778,1524 +2050,30 @@ struct cvtScale_SIMD<ushort, ushort, float>
 #endif
 
 template <>
-struct cvtScale_SIMD<ushort, short, float>
-{
-    int operator () (const ushort * src, short * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v_src, v_zero));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
-
-            v_src_f = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v_src, v_zero));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
-
-            __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
-                                            _mm_cvtps_epi32(v_dst_1));
-            _mm_storeu_si128((__m128i *)(dst + x), v_dst);
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<ushort, int, float>
+struct cvtScale_SIMD<double, short, float>
 {
-    int operator () (const ushort * src, int * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v_src, v_zero));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
-
-            v_src_f = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v_src, v_zero));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
-
-            _mm_storeu_si128((__m128i *)(dst + x), _mm_cvtps_epi32(v_dst_0));
-            _mm_storeu_si128((__m128i *)(dst + x + 4), _mm_cvtps_epi32(v_dst_1));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<ushort, float, float>
-{
-    int operator () (const ushort * src, float * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v_src, v_zero));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
-
-            v_src_f = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v_src, v_zero));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
-
-            _mm_storeu_ps(dst + x, v_dst_0);
-            _mm_storeu_ps(dst + x + 4, v_dst_1);
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<ushort, double, double>
-{
-    int operator () (const ushort * src, double * dst, int width, double scale, double shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128i v_zero = _mm_setzero_si128();
-        __m128d v_scale = _mm_set1_pd(scale), v_shift = _mm_set1_pd(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-
-            __m128i v_src_s32 = _mm_unpacklo_epi16(v_src, v_zero);
-            __m128d v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src_s32), v_scale), v_shift);
-            __m128d v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(v_src_s32, 8)), v_scale), v_shift);
-            _mm_storeu_pd(dst + x, v_dst_0);
-            _mm_storeu_pd(dst + x + 2, v_dst_1);
-
-            v_src_s32 = _mm_unpackhi_epi16(v_src, v_zero);
-            v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src_s32), v_scale), v_shift);
-            v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(v_src_s32, 8)), v_scale), v_shift);
-            _mm_storeu_pd(dst + x + 4, v_dst_0);
-            _mm_storeu_pd(dst + x + 6, v_dst_1);
-        }
-
-        return x;
-    }
-};
-
-// from short
-
-template <>
-struct cvtScale_SIMD<short, uchar, float>
-{
-    int operator () (const short * src, uchar * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v_zero, v_src), 16));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
-
-            v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v_zero, v_src), 16));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
-
-            __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
-                                            _mm_cvtps_epi32(v_dst_1));
-            _mm_storel_epi64((__m128i *)(dst + x), _mm_packus_epi16(v_dst, v_zero));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<short, schar, float>
-{
-    int operator () (const short * src, schar * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v_zero, v_src), 16));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
-
-            v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v_zero, v_src), 16));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
-
-            __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
-                                            _mm_cvtps_epi32(v_dst_1));
-            _mm_storel_epi64((__m128i *)(dst + x), _mm_packs_epi16(v_dst, v_zero));
-        }
-
-        return x;
-    }
-};
-
-#if CV_SSE4_1
-
-template <>
-struct cvtScale_SIMD<short, ushort, float>
-{
-    cvtScale_SIMD()
-    {
-        haveSSE = checkHardwareSupport(CV_CPU_SSE4_1);
-    }
-
-    int operator () (const short * src, ushort * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!haveSSE)
-            return x;
-
-        __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v_zero, v_src), 16));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
-
-            v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v_zero, v_src), 16));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
-
-            __m128i v_dst = _mm_packus_epi32(_mm_cvtps_epi32(v_dst_0),
-                                             _mm_cvtps_epi32(v_dst_1));
-            _mm_storeu_si128((__m128i *)(dst + x), v_dst);
-        }
-
-        return x;
-    }
-
-    bool haveSSE;
-};
-
-#endif
-
-template <>
-struct cvtScale_SIMD<short, short, float>
-{
-    int operator () (const short * src, short * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v_zero, v_src), 16));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
-
-            v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v_zero, v_src), 16));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
-
-            __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
-                                            _mm_cvtps_epi32(v_dst_1));
-            _mm_storeu_si128((__m128i *)(dst + x), v_dst);
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<short, int, float>
-{
-    int operator () (const short * src, int * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v_zero, v_src), 16));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
-
-            v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v_zero, v_src), 16));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
-
-            _mm_storeu_si128((__m128i *)(dst + x), _mm_cvtps_epi32(v_dst_0));
-            _mm_storeu_si128((__m128i *)(dst + x + 4), _mm_cvtps_epi32(v_dst_1));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<short, float, float>
-{
-    int operator () (const short * src, float * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-            __m128 v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v_zero, v_src), 16));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
-
-            v_src_f = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v_zero, v_src), 16));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src_f, v_scale), v_shift);
-
-            _mm_storeu_ps(dst + x, v_dst_0);
-            _mm_storeu_ps(dst + x + 4, v_dst_1);
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<short, double, double>
-{
-    int operator () (const short * src, double * dst, int width, double scale, double shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128i v_zero = _mm_setzero_si128();
-        __m128d v_scale = _mm_set1_pd(scale), v_shift = _mm_set1_pd(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-
-            __m128i v_src_s32 = _mm_srai_epi32(_mm_unpacklo_epi16(v_zero, v_src), 16);
-            __m128d v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src_s32), v_scale), v_shift);
-            __m128d v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(v_src_s32, 8)), v_scale), v_shift);
-            _mm_storeu_pd(dst + x, v_dst_0);
-            _mm_storeu_pd(dst + x + 2, v_dst_1);
-
-            v_src_s32 = _mm_srai_epi32(_mm_unpackhi_epi16(v_zero, v_src), 16);
-            v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src_s32), v_scale), v_shift);
-            v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(v_src_s32, 8)), v_scale), v_shift);
-            _mm_storeu_pd(dst + x + 4, v_dst_0);
-            _mm_storeu_pd(dst + x + 6, v_dst_1);
-        }
-
-        return x;
-    }
-};
-
-// from int
-
-template <>
-struct cvtScale_SIMD<int, uchar, float>
-{
-    int operator () (const int * src, uchar * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(v_src), v_scale), v_shift);
-
-            v_src = _mm_loadu_si128((__m128i const *)(src + x + 4));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(v_src), v_scale), v_shift);
-
-            __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
-                                            _mm_cvtps_epi32(v_dst_1));
-            _mm_storel_epi64((__m128i *)(dst + x), _mm_packus_epi16(v_dst, v_zero));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<int, schar, float>
-{
-    int operator () (const int * src, schar * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(v_src), v_scale), v_shift);
-
-            v_src = _mm_loadu_si128((__m128i const *)(src + x + 4));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(v_src), v_scale), v_shift);
-
-            __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
-                                            _mm_cvtps_epi32(v_dst_1));
-            _mm_storel_epi64((__m128i *)(dst + x), _mm_packs_epi16(v_dst, v_zero));
-        }
-
-        return x;
-    }
-};
-
-#if CV_SSE4_1
-
-template <>
-struct cvtScale_SIMD<int, ushort, float>
-{
-    cvtScale_SIMD()
-    {
-        haveSSE = checkHardwareSupport(CV_CPU_SSE4_1);
-    }
-
-    int operator () (const int * src, ushort * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!haveSSE)
-            return x;
-
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(v_src), v_scale), v_shift);
-
-            v_src = _mm_loadu_si128((__m128i const *)(src + x + 4));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(v_src), v_scale), v_shift);
-
-            __m128i v_dst = _mm_packus_epi32(_mm_cvtps_epi32(v_dst_0),
-                                             _mm_cvtps_epi32(v_dst_1));
-            _mm_storeu_si128((__m128i *)(dst + x), v_dst);
-        }
-
-        return x;
-    }
-
-    bool haveSSE;
-};
-
-#endif
-
-template <>
-struct cvtScale_SIMD<int, short, float>
-{
-    int operator () (const int * src, short * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(v_src), v_scale), v_shift);
-
-            v_src = _mm_loadu_si128((__m128i const *)(src + x + 4));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(v_src), v_scale), v_shift);
-
-            __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
-                                            _mm_cvtps_epi32(v_dst_1));
-            _mm_storeu_si128((__m128i *)(dst + x), v_dst);
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<int, int, double>
-{
-    int operator () (const int * src, int * dst, int width, double scale, double shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128d v_scale = _mm_set1_pd(scale), v_shift = _mm_set1_pd(shift);
-
-        for ( ; x <= width - 4; x += 4)
-        {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-            __m128d v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src), v_scale), v_shift);
-
-            v_src = _mm_srli_si128(v_src, 8);
-            __m128d v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src), v_scale), v_shift);
-
-            __m128 v_dst = _mm_movelh_ps(_mm_castsi128_ps(_mm_cvtpd_epi32(v_dst_0)),
-                                         _mm_castsi128_ps(_mm_cvtpd_epi32(v_dst_1)));
-
-            _mm_storeu_si128((__m128i *)(dst + x), _mm_castps_si128(v_dst));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<int, float, double>
-{
-    int operator () (const int * src, float * dst, int width, double scale, double shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128d v_scale = _mm_set1_pd(scale), v_shift = _mm_set1_pd(shift);
-
-        for ( ; x <= width - 4; x += 4)
-        {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-            __m128d v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src), v_scale), v_shift);
-
-            v_src = _mm_srli_si128(v_src, 8);
-            __m128d v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src), v_scale), v_shift);
-
-            _mm_storeu_ps(dst + x, _mm_movelh_ps(_mm_cvtpd_ps(v_dst_0),
-                                                 _mm_cvtpd_ps(v_dst_1)));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<int, double, double>
-{
-    int operator () (const int * src, double * dst, int width, double scale, double shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128d v_scale = _mm_set1_pd(scale), v_shift = _mm_set1_pd(shift);
-
-        for ( ; x <= width - 4; x += 4)
-        {
-            __m128i v_src = _mm_loadu_si128((__m128i const *)(src + x));
-            __m128d v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src), v_scale), v_shift);
-
-            v_src = _mm_srli_si128(v_src, 8);
-            __m128d v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtepi32_pd(v_src), v_scale), v_shift);
-
-            _mm_storeu_pd(dst + x, v_dst_0);
-            _mm_storeu_pd(dst + x + 2, v_dst_1);
-        }
-
-        return x;
-    }
-};
-
-// from float
-
-template <>
-struct cvtScale_SIMD<float, uchar, float>
-{
-    int operator () (const float * src, uchar * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128 v_src = _mm_loadu_ps(src + x);
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
-
-            v_src = _mm_loadu_ps(src + x + 4);
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
-
-            __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
-                                            _mm_cvtps_epi32(v_dst_1));
-            _mm_storel_epi64((__m128i *)(dst + x), _mm_packus_epi16(v_dst, v_zero));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<float, schar, float>
-{
-    int operator () (const float * src, schar * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128 v_src = _mm_loadu_ps(src + x);
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
-
-            v_src = _mm_loadu_ps(src + x + 4);
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
-
-            __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
-                                            _mm_cvtps_epi32(v_dst_1));
-            _mm_storel_epi64((__m128i *)(dst + x), _mm_packs_epi16(v_dst, v_zero));
-        }
-
-        return x;
-    }
-};
-
-#if CV_SSE4_1
-
-template <>
-struct cvtScale_SIMD<float, ushort, float>
-{
-    cvtScale_SIMD()
-    {
-        haveSSE = checkHardwareSupport(CV_CPU_SSE4_1);
-    }
-
-    int operator () (const float * src, ushort * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!haveSSE)
-            return x;
-
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128 v_src = _mm_loadu_ps(src + x);
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
-
-            v_src = _mm_loadu_ps(src + x + 4);
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
-
-            __m128i v_dst = _mm_packus_epi32(_mm_cvtps_epi32(v_dst_0),
-                                             _mm_cvtps_epi32(v_dst_1));
-            _mm_storeu_si128((__m128i *)(dst + x), v_dst);
-        }
-
-        return x;
-    }
-
-    bool haveSSE;
-};
-
-#endif
-
-template <>
-struct cvtScale_SIMD<float, short, float>
-{
-    int operator () (const float * src, short * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128 v_src = _mm_loadu_ps(src + x);
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
-
-            v_src = _mm_loadu_ps(src + x + 4);
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
-
-            __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
-                                            _mm_cvtps_epi32(v_dst_1));
-            _mm_storeu_si128((__m128i *)(dst + x), v_dst);
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<float, int, float>
-{
-    int operator () (const float * src, int * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128 v_src = _mm_loadu_ps(src + x);
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
-
-            v_src = _mm_loadu_ps(src + x + 4);
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
-
-            _mm_storeu_si128((__m128i *)(dst + x), _mm_cvtps_epi32(v_dst_0));
-            _mm_storeu_si128((__m128i *)(dst + x + 4), _mm_cvtps_epi32(v_dst_1));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<float, float, float>
-{
-    int operator () (const float * src, float * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 4; x += 4)
-        {
-            __m128 v_src = _mm_loadu_ps(src + x);
-            __m128 v_dst = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
-            _mm_storeu_ps(dst + x, v_dst);
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<float, double, double>
-{
-    int operator () (const float * src, double * dst, int width, double scale, double shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128d v_scale = _mm_set1_pd(scale), v_shift = _mm_set1_pd(shift);
-
-        for ( ; x <= width - 4; x += 4)
-        {
-            __m128 v_src = _mm_loadu_ps(src + x);
-            __m128d v_dst_0 = _mm_add_pd(_mm_mul_pd(_mm_cvtps_pd(v_src), v_scale), v_shift);
-            v_src = _mm_castsi128_ps(_mm_srli_si128(_mm_castps_si128(v_src), 8));
-            __m128d v_dst_1 = _mm_add_pd(_mm_mul_pd(_mm_cvtps_pd(v_src), v_scale), v_shift);
-
-            _mm_storeu_pd(dst + x, v_dst_0);
-            _mm_storeu_pd(dst + x + 2, v_dst_1);
-        }
-
-        return x;
-    }
-};
-
-// from double
-
-template <>
-struct cvtScale_SIMD<double, uchar, float>
-{
-    int operator () (const double * src, uchar * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128 v_src = _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(src + x)),
-                                         _mm_cvtpd_ps(_mm_loadu_pd(src + x + 2)));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
-
-            v_src = _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(src + x + 4)),
-                                  _mm_cvtpd_ps(_mm_loadu_pd(src + x + 6)));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
-
-            __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
-                                            _mm_cvtps_epi32(v_dst_1));
-            _mm_storel_epi64((__m128i *)(dst + x), _mm_packus_epi16(v_dst, v_zero));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<double, schar, float>
-{
-    int operator () (const double * src, schar * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128i v_zero = _mm_setzero_si128();
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128 v_src = _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(src + x)),
-                                         _mm_cvtpd_ps(_mm_loadu_pd(src + x + 2)));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
-
-            v_src = _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(src + x + 4)),
-                                  _mm_cvtpd_ps(_mm_loadu_pd(src + x + 6)));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
-
-            __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
-                                            _mm_cvtps_epi32(v_dst_1));
-            _mm_storel_epi64((__m128i *)(dst + x), _mm_packs_epi16(v_dst, v_zero));
-        }
-
-        return x;
-    }
-};
-
-#if CV_SSE4_1
-
-template <>
-struct cvtScale_SIMD<double, ushort, float>
-{
-    cvtScale_SIMD()
-    {
-        haveSSE = checkHardwareSupport(CV_CPU_SSE4_1);
-    }
-
-    int operator () (const double * src, ushort * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!haveSSE)
-            return x;
-
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128 v_src = _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(src + x)),
-                                         _mm_cvtpd_ps(_mm_loadu_pd(src + x + 2)));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
-
-            v_src = _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(src + x + 4)),
-                                  _mm_cvtpd_ps(_mm_loadu_pd(src + x + 6)));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
-
-            __m128i v_dst = _mm_packus_epi32(_mm_cvtps_epi32(v_dst_0),
-                                             _mm_cvtps_epi32(v_dst_1));
-            _mm_storeu_si128((__m128i *)(dst + x), v_dst);
-        }
-
-        return x;
-    }
-
-    bool haveSSE;
-};
-
-#endif
-
-template <>
-struct cvtScale_SIMD<double, short, float>
-{
-    int operator () (const double * src, short * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            __m128 v_src = _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(src + x)),
-                                         _mm_cvtpd_ps(_mm_loadu_pd(src + x + 2)));
-            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
-
-            v_src = _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(src + x + 4)),
-                                  _mm_cvtpd_ps(_mm_loadu_pd(src + x + 6)));
-            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
-
-            __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
-                                            _mm_cvtps_epi32(v_dst_1));
-            _mm_storeu_si128((__m128i *)(dst + x), v_dst);
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<double, int, double>
-{
-    int operator () (const double * src, int * dst, int width, double scale, double shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128d v_scale = _mm_set1_pd(scale), v_shift = _mm_set1_pd(shift);
-
-        for ( ; x <= width - 4; x += 4)
-        {
-            __m128d v_src = _mm_loadu_pd(src + x);
-            __m128d v_dst0 = _mm_add_pd(_mm_mul_pd(v_src, v_scale), v_shift);
-
-            v_src = _mm_loadu_pd(src + x + 2);
-            __m128d v_dst1 = _mm_add_pd(_mm_mul_pd(v_src, v_scale), v_shift);
-
-            __m128 v_dst = _mm_movelh_ps(_mm_castsi128_ps(_mm_cvtpd_epi32(v_dst0)),
-                                         _mm_castsi128_ps(_mm_cvtpd_epi32(v_dst1)));
-
-            _mm_storeu_si128((__m128i *)(dst + x), _mm_castps_si128(v_dst));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<double, float, double>
-{
-    int operator () (const double * src, float * dst, int width, double scale, double shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128d v_scale = _mm_set1_pd(scale), v_shift = _mm_set1_pd(shift);
-
-        for ( ; x <= width - 4; x += 4)
-        {
-            __m128d v_src = _mm_loadu_pd(src + x);
-            __m128d v_dst0 = _mm_add_pd(_mm_mul_pd(v_src, v_scale), v_shift);
-
-            v_src = _mm_loadu_pd(src + x + 2);
-            __m128d v_dst1 = _mm_add_pd(_mm_mul_pd(v_src, v_scale), v_shift);
-
-            __m128 v_dst = _mm_movelh_ps(_mm_cvtpd_ps(v_dst0),
-                                         _mm_cvtpd_ps(v_dst1));
-
-            _mm_storeu_ps(dst + x, v_dst);
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<double, double, double>
-{
-    int operator () (const double * src, double * dst, int width, double scale, double shift) const
-    {
-        int x = 0;
-
-        if (!USE_SSE2)
-            return x;
-
-        __m128d v_scale = _mm_set1_pd(scale), v_shift = _mm_set1_pd(shift);
-
-        for ( ; x <= width - 2; x += 2)
-        {
-            __m128d v_src = _mm_loadu_pd(src + x);
-            __m128d v_dst = _mm_add_pd(_mm_mul_pd(v_src, v_scale), v_shift);
-            _mm_storeu_pd(dst + x, v_dst);
-        }
-
-        return x;
-    }
-};
-
-#elif CV_NEON
-
-// from uchar
-
-template <>
-struct cvtScale_SIMD<uchar, uchar, float>
-{
-    int operator () (const uchar * src, uchar * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            uint16x8_t v_src = vmovl_u8(vld1_u8(src + x));
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v_src))), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v_src))), v_scale), v_shift);
-
-            uint16x8_t v_dst = vcombine_u16(vqmovn_u32(cv_vrndq_u32_f32(v_dst1)),
-                                            vqmovn_u32(cv_vrndq_u32_f32(v_dst2)));
-            vst1_u8(dst + x, vqmovn_u16(v_dst));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<uchar, schar, float>
-{
-    int operator () (const uchar * src, schar * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            uint16x8_t v_src = vmovl_u8(vld1_u8(src + x));
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v_src))), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v_src))), v_scale), v_shift);
-
-            int16x8_t v_dst = vcombine_s16(vqmovn_s32(cv_vrndq_s32_f32(v_dst1)),
-                                           vqmovn_s32(cv_vrndq_s32_f32(v_dst2)));
-            vst1_s8(dst + x, vqmovn_s16(v_dst));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<uchar, ushort, float>
-{
-    int operator () (const uchar * src, ushort * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            uint16x8_t v_src = vmovl_u8(vld1_u8(src + x));
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v_src))), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v_src))), v_scale), v_shift);
-
-            uint16x8_t v_dst = vcombine_u16(vqmovn_u32(cv_vrndq_u32_f32(v_dst1)),
-                                            vqmovn_u32(cv_vrndq_u32_f32(v_dst2)));
-            vst1q_u16(dst + x, v_dst);
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<uchar, short, float>
-{
-    int operator () (const uchar * src, short * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            uint16x8_t v_src = vmovl_u8(vld1_u8(src + x));
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v_src))), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v_src))), v_scale), v_shift);
-
-            int16x8_t v_dst = vcombine_s16(vqmovn_s32(cv_vrndq_s32_f32(v_dst1)),
-                                           vqmovn_s32(cv_vrndq_s32_f32(v_dst2)));
-            vst1q_s16(dst + x, v_dst);
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<uchar, int, float>
-{
-    int operator () (const uchar * src, int * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            uint16x8_t v_src = vmovl_u8(vld1_u8(src + x));
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v_src))), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v_src))), v_scale), v_shift);
-
-            vst1q_s32(dst + x, cv_vrndq_s32_f32(v_dst1));
-            vst1q_s32(dst + x + 4, cv_vrndq_s32_f32(v_dst2));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<uchar, float, float>
-{
-    int operator () (const uchar * src, float * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            uint16x8_t v_src = vmovl_u8(vld1_u8(src + x));
-            vst1q_f32(dst + x, vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v_src))), v_scale), v_shift));
-            vst1q_f32(dst + x + 4, vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v_src))), v_scale), v_shift));
-        }
-
-        return x;
-    }
-};
-
-// from schar
-
-template <>
-struct cvtScale_SIMD<schar, uchar, float>
-{
-    int operator () (const schar * src, uchar * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            int16x8_t v_src = vmovl_s8(vld1_s8(src + x));
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v_src))), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v_src))), v_scale), v_shift);
-
-            uint16x8_t v_dst = vcombine_u16(vqmovn_u32(cv_vrndq_u32_f32(v_dst1)),
-                                            vqmovn_u32(cv_vrndq_u32_f32(v_dst2)));
-            vst1_u8(dst + x, vqmovn_u16(v_dst));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<schar, schar, float>
-{
-    int operator () (const schar * src, schar * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            int16x8_t v_src = vmovl_s8(vld1_s8(src + x));
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v_src))), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v_src))), v_scale), v_shift);
-
-            int16x8_t v_dst = vcombine_s16(vqmovn_s32(cv_vrndq_s32_f32(v_dst1)),
-                                           vqmovn_s32(cv_vrndq_s32_f32(v_dst2)));
-            vst1_s8(dst + x, vqmovn_s16(v_dst));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<schar, ushort, float>
-{
-    int operator () (const schar * src, ushort * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            int16x8_t v_src = vmovl_s8(vld1_s8(src + x));
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v_src))), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v_src))), v_scale), v_shift);
-
-            uint16x8_t v_dst = vcombine_u16(vqmovn_u32(cv_vrndq_u32_f32(v_dst1)),
-                                            vqmovn_u32(cv_vrndq_u32_f32(v_dst2)));
-            vst1q_u16(dst + x, v_dst);
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<schar, short, float>
-{
-    int operator () (const schar * src, short * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            int16x8_t v_src = vmovl_s8(vld1_s8(src + x));
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v_src))), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v_src))), v_scale), v_shift);
-
-            int16x8_t v_dst = vcombine_s16(vqmovn_s32(cv_vrndq_s32_f32(v_dst1)),
-                                           vqmovn_s32(cv_vrndq_s32_f32(v_dst2)));
-            vst1q_s16(dst + x, v_dst);
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<schar, int, float>
-{
-    int operator () (const schar * src, int * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            int16x8_t v_src = vmovl_s8(vld1_s8(src + x));
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v_src))), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v_src))), v_scale), v_shift);
-
-            vst1q_s32(dst + x, cv_vrndq_s32_f32(v_dst1));
-            vst1q_s32(dst + x + 4, cv_vrndq_s32_f32(v_dst2));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<schar, float, float>
-{
-    int operator () (const schar * src, float * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            int16x8_t v_src = vmovl_s8(vld1_s8(src + x));
-            vst1q_f32(dst + x, vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v_src))), v_scale), v_shift));
-            vst1q_f32(dst + x + 4, vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v_src))), v_scale), v_shift));
-        }
-
-        return x;
-    }
-};
-
-// from ushort
-
-template <>
-struct cvtScale_SIMD<ushort, uchar, float>
-{
-    int operator () (const ushort * src, uchar * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            uint16x8_t v_src = vld1q_u16(src + x);
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v_src))), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v_src))), v_scale), v_shift);
-
-            uint16x8_t v_dst = vcombine_u16(vqmovn_u32(cv_vrndq_u32_f32(v_dst1)),
-                                            vqmovn_u32(cv_vrndq_u32_f32(v_dst2)));
-            vst1_u8(dst + x, vqmovn_u16(v_dst));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<ushort, schar, float>
-{
-    int operator () (const ushort * src, schar * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            uint16x8_t v_src = vld1q_u16(src + x);
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v_src))), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v_src))), v_scale), v_shift);
-
-            int16x8_t v_dst = vcombine_s16(vqmovn_s32(cv_vrndq_s32_f32(v_dst1)),
-                                           vqmovn_s32(cv_vrndq_s32_f32(v_dst2)));
-            vst1_s8(dst + x, vqmovn_s16(v_dst));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<ushort, ushort, float>
-{
-    int operator () (const ushort * src, ushort * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            uint16x8_t v_src = vld1q_u16(src + x);
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v_src))), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v_src))), v_scale), v_shift);
-
-            uint16x8_t v_dst = vcombine_u16(vqmovn_u32(cv_vrndq_u32_f32(v_dst1)),
-                                            vqmovn_u32(cv_vrndq_u32_f32(v_dst2)));
-            vst1q_u16(dst + x, v_dst);
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<ushort, short, float>
-{
-    int operator () (const ushort * src, short * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            uint16x8_t v_src = vld1q_u16(src + x);
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v_src))), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v_src))), v_scale), v_shift);
-
-            int16x8_t v_dst = vcombine_s16(vqmovn_s32(cv_vrndq_s32_f32(v_dst1)),
-                                           vqmovn_s32(cv_vrndq_s32_f32(v_dst2)));
-            vst1q_s16(dst + x, v_dst);
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<ushort, int, float>
-{
-    int operator () (const ushort * src, int * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            uint16x8_t v_src = vld1q_u16(src + x);
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v_src))), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v_src))), v_scale), v_shift);
-
-            vst1q_s32(dst + x, cv_vrndq_s32_f32(v_dst1));
-            vst1q_s32(dst + x + 4, cv_vrndq_s32_f32(v_dst2));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<ushort, float, float>
-{
-    int operator () (const ushort * src, float * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            uint16x8_t v_src = vld1q_u16(src + x);
-            vst1q_f32(dst + x, vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v_src))), v_scale), v_shift));
-            vst1q_f32(dst + x + 4, vaddq_f32(vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v_src))), v_scale), v_shift));
-        }
-
-        return x;
-    }
-};
-
-// from short
-
-template <>
-struct cvtScale_SIMD<short, uchar, float>
-{
-    int operator () (const short * src, uchar * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            int16x8_t v_src = vld1q_s16(src + x);
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v_src))), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v_src))), v_scale), v_shift);
-
-            uint16x8_t v_dst = vcombine_u16(vqmovn_u32(cv_vrndq_u32_f32(v_dst1)),
-                                            vqmovn_u32(cv_vrndq_u32_f32(v_dst2)));
-            vst1_u8(dst + x, vqmovn_u16(v_dst));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<short, schar, float>
-{
-    int operator () (const short * src, schar * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            int16x8_t v_src = vld1q_s16(src + x);
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v_src))), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v_src))), v_scale), v_shift);
-
-            int16x8_t v_dst = vcombine_s16(vqmovn_s32(cv_vrndq_s32_f32(v_dst1)),
-                                           vqmovn_s32(cv_vrndq_s32_f32(v_dst2)));
-            vst1_s8(dst + x, vqmovn_s16(v_dst));
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<short, ushort, float>
-{
-    int operator () (const short * src, ushort * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            int16x8_t v_src = vld1q_s16(src + x);
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v_src))), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v_src))), v_scale), v_shift);
-
-            uint16x8_t v_dst = vcombine_u16(vqmovn_u32(cv_vrndq_u32_f32(v_dst1)),
-                                            vqmovn_u32(cv_vrndq_u32_f32(v_dst2)));
-            vst1q_u16(dst + x, v_dst);
-        }
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<short, float, float>
-{
-    int operator () (const short * src, float * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 8; x += 8)
-        {
-            int16x8_t v_src = vld1q_s16(src + x);
-            vst1q_f32(dst + x, vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v_src))), v_scale), v_shift));
-            vst1q_f32(dst + x + 4, vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v_src))), v_scale), v_shift));
-        }
-
-        return x;
-    }
-};
-
-// from int
-
-template <>
-struct cvtScale_SIMD<int, uchar, float>
-{
-    int operator () (const int * src, uchar * dst, int width, float scale, float shift) const
+    int operator () (const double * src, short * dst, int width, float scale, float shift) const
     {
         int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
+
+        if (!USE_SSE2)
+            return x;
+
+        __m128 v_scale = _mm_set1_ps(scale), v_shift = _mm_set1_ps(shift);
 
         for ( ; x <= width - 8; x += 8)
         {
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vld1q_s32(src + x)), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vld1q_s32(src + x + 4)), v_scale), v_shift);
+            __m128 v_src = _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(src + x)),
+                                         _mm_cvtpd_ps(_mm_loadu_pd(src + x + 2)));
+            __m128 v_dst_0 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
 
-            uint16x8_t v_dst = vcombine_u16(vqmovn_u32(cv_vrndq_u32_f32(v_dst1)),
-                                            vqmovn_u32(cv_vrndq_u32_f32(v_dst2)));
-            vst1_u8(dst + x, vqmovn_u16(v_dst));
+            v_src = _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(src + x + 4)),
+                                  _mm_cvtpd_ps(_mm_loadu_pd(src + x + 6)));
+            __m128 v_dst_1 = _mm_add_ps(_mm_mul_ps(v_src, v_scale), v_shift);
+
+            __m128i v_dst = _mm_packs_epi32(_mm_cvtps_epi32(v_dst_0),
+                                            _mm_cvtps_epi32(v_dst_1));
+            _mm_storeu_si128((__m128i *)(dst + x), v_dst);
         }
 
         return x;
@@ -3303,21 +2081,29 @@ struct cvtScale_SIMD<int, uchar, float>
 };
 
 template <>
-struct cvtScale_SIMD<int, schar, float>
+struct cvtScale_SIMD<double, int, double>
 {
-    int operator () (const int * src, schar * dst, int width, float scale, float shift) const
+    int operator () (const double * src, int * dst, int width, double scale, double shift) const
     {
         int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
 
-        for ( ; x <= width - 8; x += 8)
+        if (!USE_SSE2)
+            return x;
+
+        __m128d v_scale = _mm_set1_pd(scale), v_shift = _mm_set1_pd(shift);
+
+        for ( ; x <= width - 4; x += 4)
         {
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vld1q_s32(src + x)), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vld1q_s32(src + x + 4)), v_scale), v_shift);
+            __m128d v_src = _mm_loadu_pd(src + x);
+            __m128d v_dst0 = _mm_add_pd(_mm_mul_pd(v_src, v_scale), v_shift);
 
-            int16x8_t v_dst = vcombine_s16(vqmovn_s32(cv_vrndq_s32_f32(v_dst1)),
-                                           vqmovn_s32(cv_vrndq_s32_f32(v_dst2)));
-            vst1_s8(dst + x, vqmovn_s16(v_dst));
+            v_src = _mm_loadu_pd(src + x + 2);
+            __m128d v_dst1 = _mm_add_pd(_mm_mul_pd(v_src, v_scale), v_shift);
+
+            __m128 v_dst = _mm_movelh_ps(_mm_castsi128_ps(_mm_cvtpd_epi32(v_dst0)),
+                                         _mm_castsi128_ps(_mm_cvtpd_epi32(v_dst1)));
+
+            _mm_storeu_si128((__m128i *)(dst + x), _mm_castps_si128(v_dst));
         }
 
         return x;
@@ -3325,21 +2111,29 @@ struct cvtScale_SIMD<int, schar, float>
 };
 
 template <>
-struct cvtScale_SIMD<int, ushort, float>
+struct cvtScale_SIMD<double, float, double>
 {
-    int operator () (const int * src, ushort * dst, int width, float scale, float shift) const
+    int operator () (const double * src, float * dst, int width, double scale, double shift) const
     {
         int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
 
-        for ( ; x <= width - 8; x += 8)
+        if (!USE_SSE2)
+            return x;
+
+        __m128d v_scale = _mm_set1_pd(scale), v_shift = _mm_set1_pd(shift);
+
+        for ( ; x <= width - 4; x += 4)
         {
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vld1q_s32(src + x)), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vld1q_s32(src + x + 4)), v_scale), v_shift);
+            __m128d v_src = _mm_loadu_pd(src + x);
+            __m128d v_dst0 = _mm_add_pd(_mm_mul_pd(v_src, v_scale), v_shift);
 
-            uint16x8_t v_dst = vcombine_u16(vqmovn_u32(cv_vrndq_u32_f32(v_dst1)),
-                                            vqmovn_u32(cv_vrndq_u32_f32(v_dst2)));
-            vst1q_u16(dst + x, v_dst);
+            v_src = _mm_loadu_pd(src + x + 2);
+            __m128d v_dst1 = _mm_add_pd(_mm_mul_pd(v_src, v_scale), v_shift);
+
+            __m128 v_dst = _mm_movelh_ps(_mm_cvtpd_ps(v_dst0),
+                                         _mm_cvtpd_ps(v_dst1));
+
+            _mm_storeu_ps(dst + x, v_dst);
         }
 
         return x;
@@ -3347,41 +2141,44 @@ struct cvtScale_SIMD<int, ushort, float>
 };
 
 template <>
-struct cvtScale_SIMD<int, short, float>
+struct cvtScale_SIMD<double, double, double>
 {
-    int operator () (const int * src, short * dst, int width, float scale, float shift) const
+    int operator () (const double * src, double * dst, int width, double scale, double shift) const
     {
         int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
 
-        for ( ; x <= width - 8; x += 8)
-        {
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vld1q_s32(src + x)), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vld1q_s32(src + x + 4)), v_scale), v_shift);
+        if (!USE_SSE2)
+            return x;
 
-            int16x8_t v_dst = vcombine_s16(vqmovn_s32(cv_vrndq_s32_f32(v_dst1)),
-                                           vqmovn_s32(cv_vrndq_s32_f32(v_dst2)));
-            vst1q_s16(dst + x, v_dst);
+        __m128d v_scale = _mm_set1_pd(scale), v_shift = _mm_set1_pd(shift);
+
+        for ( ; x <= width - 2; x += 2)
+        {
+            __m128d v_src = _mm_loadu_pd(src + x);
+            __m128d v_dst = _mm_add_pd(_mm_mul_pd(v_src, v_scale), v_shift);
+            _mm_storeu_pd(dst + x, v_dst);
         }
 
         return x;
     }
 };
 
-// from float
+#elif CV_NEON
+
+// from int
 
 template <>
-struct cvtScale_SIMD<float, uchar, float>
+struct cvtScale_SIMD<int, uchar, float>
 {
-    int operator () (const float * src, uchar * dst, int width, float scale, float shift) const
+    int operator () (const int * src, uchar * dst, int width, float scale, float shift) const
     {
         int x = 0;
         float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
 
         for ( ; x <= width - 8; x += 8)
         {
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vld1q_f32(src + x), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vld1q_f32(src + x + 4), v_scale), v_shift);
+            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vld1q_s32(src + x)), v_scale), v_shift);
+            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vld1q_s32(src + x + 4)), v_scale), v_shift);
 
             uint16x8_t v_dst = vcombine_u16(vqmovn_u32(cv_vrndq_u32_f32(v_dst1)),
                                             vqmovn_u32(cv_vrndq_u32_f32(v_dst2)));
@@ -3393,17 +2190,17 @@ struct cvtScale_SIMD<float, uchar, float>
 };
 
 template <>
-struct cvtScale_SIMD<float, schar, float>
+struct cvtScale_SIMD<int, schar, float>
 {
-    int operator () (const float * src, schar * dst, int width, float scale, float shift) const
+    int operator () (const int * src, schar * dst, int width, float scale, float shift) const
     {
         int x = 0;
         float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
 
         for ( ; x <= width - 8; x += 8)
         {
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vld1q_f32(src + x), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vld1q_f32(src + x + 4), v_scale), v_shift);
+            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vld1q_s32(src + x)), v_scale), v_shift);
+            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vld1q_s32(src + x + 4)), v_scale), v_shift);
 
             int16x8_t v_dst = vcombine_s16(vqmovn_s32(cv_vrndq_s32_f32(v_dst1)),
                                            vqmovn_s32(cv_vrndq_s32_f32(v_dst2)));
@@ -3415,17 +2212,17 @@ struct cvtScale_SIMD<float, schar, float>
 };
 
 template <>
-struct cvtScale_SIMD<float, ushort, float>
+struct cvtScale_SIMD<int, ushort, float>
 {
-    int operator () (const float * src, ushort * dst, int width, float scale, float shift) const
+    int operator () (const int * src, ushort * dst, int width, float scale, float shift) const
     {
         int x = 0;
         float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
 
         for ( ; x <= width - 8; x += 8)
         {
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vld1q_f32(src + x), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vld1q_f32(src + x + 4), v_scale), v_shift);
+            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vld1q_s32(src + x)), v_scale), v_shift);
+            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vld1q_s32(src + x + 4)), v_scale), v_shift);
 
             uint16x8_t v_dst = vcombine_u16(vqmovn_u32(cv_vrndq_u32_f32(v_dst1)),
                                             vqmovn_u32(cv_vrndq_u32_f32(v_dst2)));
@@ -3437,20 +2234,20 @@ struct cvtScale_SIMD<float, ushort, float>
 };
 
 template <>
-struct cvtScale_SIMD<float, short, float>
+struct cvtScale_SIMD<int, short, float>
 {
-    int operator () (const float * src, short * dst, int width, float scale, float shift) const
+    int operator () (const int * src, short * dst, int width, float scale, float shift) const
     {
         int x = 0;
         float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
 
         for ( ; x <= width - 8; x += 8)
         {
-            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vld1q_f32(src + x), v_scale), v_shift);
-            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vld1q_f32(src + x + 4), v_scale), v_shift);
+            float32x4_t v_dst1 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vld1q_s32(src + x)), v_scale), v_shift);
+            float32x4_t v_dst2 = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vld1q_s32(src + x + 4)), v_scale), v_shift);
 
             int16x8_t v_dst = vcombine_s16(vqmovn_s32(cv_vrndq_s32_f32(v_dst1)),
-                                            vqmovn_s32(cv_vrndq_s32_f32(v_dst2)));
+                                           vqmovn_s32(cv_vrndq_s32_f32(v_dst2)));
             vst1q_s16(dst + x, v_dst);
         }
 
@@ -3458,36 +2255,6 @@ struct cvtScale_SIMD<float, short, float>
     }
 };
 
-template <>
-struct cvtScale_SIMD<float, int, float>
-{
-    int operator () (const float * src, int * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 4; x += 4)
-            vst1q_s32(dst + x, cv_vrndq_s32_f32(vaddq_f32(vmulq_f32(vld1q_f32(src + x), v_scale), v_shift)));
-
-        return x;
-    }
-};
-
-template <>
-struct cvtScale_SIMD<float, float, float>
-{
-    int operator () (const float * src, float * dst, int width, float scale, float shift) const
-    {
-        int x = 0;
-        float32x4_t v_shift = vdupq_n_f32(shift), v_scale = vdupq_n_f32(scale);
-
-        for ( ; x <= width - 4; x += 4)
-            vst1q_f32(dst + x, vaddq_f32(vmulq_f32(vld1q_f32(src + x), v_scale), v_shift));
-
-        return x;
-    }
-};
-
 #endif
 
 template<typename T, typename DT, typename WT> static void
@@ -4806,6 +3573,8 @@ void cv::convertScaleAbs( InputArray _src, OutputArray _dst, double alpha, doubl
 
 void cv::Mat::convertTo(OutputArray _dst, int _type, double alpha, double beta) const
 {
+    CV_TRACE_FUNCTION();
+
     bool noScale = fabs(alpha-1) < DBL_EPSILON && fabs(beta) < DBL_EPSILON;
 
     if( _type < 0 )
@@ -5187,6 +3956,8 @@ private:
 
 void cv::LUT( InputArray _src, InputArray _lut, OutputArray _dst )
 {
+    CV_TRACE_FUNCTION();
+
     int cn = _src.channels(), depth = _src.depth();
     int lutcn = _lut.channels();
 
@@ -5238,6 +4009,323 @@ void cv::LUT( InputArray _src, InputArray _lut, OutputArray _dst )
         func(ptrs[0], lut.ptr(), ptrs[1], len, cn, lutcn);
 }
 
+/****************************************************************************************\
+*                        Fused scale, LUT and channel reordering                         *
+\****************************************************************************************/
+
+namespace cv
+{
+
+// the pixels are converted by blocks that keep the intermediate buffers in L1 cache;
+// the block of any number of channels consists of whole 12-element alpha/beta patterns
+enum { CVT_LUT_BLOCK = 192 };
+
+// 8-bit sources: tab holds 256 final values for each destination channel
+template<typename T> static void
+convertScaleTab_( const uchar* src, int scn, T* dst, int dcn, const int* map, const T* tab, int len )
+{
+    int i, k;
+    if( dcn == 1 )
+    {
+        src += map[0];
+        for( i = 0; i < len; i++ )
+            dst[i] = tab[src[i*scn]];
+        return;
+    }
+
+    for( i = 0; i < len; i++, src += scn, dst += dcn )
+    {
+        // the source and the destination may be the same array
+        T buf[4];
+        for( k = 0; k < dcn; k++ )
+            buf[k] = tab[k*256 + src[map[k]]];
+        for( k = 0; k < dcn; k++ )
+            dst[k] = buf[k];
+    }
+}
+
+typedef void (*ConvertScaleTabFunc)( const uchar* src, int scn, uchar* dst, int dcn,
+                                     const int* map, const uchar* tab, int len );
+
+// the table values are already converted to the destination depth, so only their size matters
+static ConvertScaleTabFunc getConvertScaleTabFunc(int depth)
+{
+    static ConvertScaleTabFunc tabTab[] =
+    {
+        (ConvertScaleTabFunc)convertScaleTab_<uchar>, (ConvertScaleTabFunc)convertScaleTab_<uchar>,
+        (ConvertScaleTabFunc)convertScaleTab_<ushort>, (ConvertScaleTabFunc)convertScaleTab_<ushort>,
+        (ConvertScaleTabFunc)convertScaleTab_<int>, (ConvertScaleTabFunc)convertScaleTab_<int>,
+        (ConvertScaleTabFunc)convertScaleTab_<int64>, 0
+    };
+
+    return tabTab[depth];
+}
+
+// dst[i*cn + k] = lut[saturate_cast<uchar>(buf[i*cn + k])*lutstep + k]
+template<typename WT, typename T> static void
+applyLUT_( const WT* buf, const T* lut, int lutstep, T* dst, int len, int cn )
+{
+    int i, k;
+    if( cn == 1 )
+    {
+        for( i = 0; i < len; i++ )
+            dst[i] = lut[saturate_cast<uchar>(buf[i])*lutstep];
+        return;
+    }
+
+    for( i = 0; i < len*cn; i += cn )
+        for( k = 0; k < cn; k++ )
+            dst[i + k] = lut[saturate_cast<uchar>(buf[i + k])*lutstep + k];
+}
+
+typedef void (*ApplyLUTFunc)( const uchar* buf, const uchar* lut, int lutstep, uchar* dst, int len, int cn );
+
+static ApplyLUTFunc getApplyLUTFunc(int wdepth, int depth)
+{
+    static ApplyLUTFunc lutTab32f[] =
+    {
+        (ApplyLUTFunc)applyLUT_<float, uchar>, (ApplyLUTFunc)applyLUT_<float, uchar>,
+        (ApplyLUTFunc)applyLUT_<float, ushort>, (ApplyLUTFunc)applyLUT_<float, ushort>,
+        (ApplyLUTFunc)applyLUT_<float, int>, (ApplyLUTFunc)applyLUT_<float, int>,
+        (ApplyLUTFunc)applyLUT_<float, int64>, 0
+    };
+    static ApplyLUTFunc lutTab64f[] =
+    {
+        (ApplyLUTFunc)applyLUT_<double, uchar>, (ApplyLUTFunc)applyLUT_<double, uchar>,
+        (ApplyLUTFunc)applyLUT_<double, ushort>, (ApplyLUTFunc)applyLUT_<double, ushort>,
+        (ApplyLUTFunc)applyLUT_<double, int>, (ApplyLUTFunc)applyLUT_<double, int>,
+        (ApplyLUTFunc)applyLUT_<double, int64>, 0
+    };
+
+    return wdepth == CV_32F ? lutTab32f[depth] : lutTab64f[depth];
+}
+
+// buf[i] = buf[i]*alpha[i % 12] + beta[i % 12]
+static void scaleAdd12( float* buf, const float* alpha, const float* beta, int len )
+{
+    int i = 0, j;
+#if CV_SIMD128
+    v_float32x4 a0 = v_load(alpha), a1 = v_load(alpha + 4), a2 = v_load(alpha + 8);
+    v_float32x4 b0 = v_load(beta), b1 = v_load(beta + 4), b2 = v_load(beta + 8);
+    for( ; i <= len - 12; i += 12 )
+    {
+        v_store(buf + i, v_load(buf + i)*a0 + b0);
+        v_store(buf + i + 4, v_load(buf + i + 4)*a1 + b1);
+        v_store(buf + i + 8, v_load(buf + i + 8)*a2 + b2);
+    }
+#endif
+    for( ; i < len; i += 12 )
+        for( j = 0; j < 12 && i + j < len; j++ )
+            buf[i + j] = buf[i + j]*alpha[j] + beta[j];
+}
+
+static void scaleAdd12( double* buf, const double* alpha, const double* beta, int len )
+{
+    for( int i = 0; i < len; i += 12 )
+        for( int j = 0; j < 12 && i + j < len; j++ )
+            buf[i + j] = buf[i + j]*alpha[j] + beta[j];
+}
+
+class ConvertScaleLUT
+{
+public:
+    ConvertScaleLUT( int stype, int _ddepth, const Scalar& alpha, const Scalar& beta,
+                     const Mat& lut, const int* order, int _dcn )
+        : sdepth(CV_MAT_DEPTH(stype)), scn(CV_MAT_CN(stype)), ddepth(_ddepth), dcn(_dcn),
+          lutcn(lut.channels()), hasLUT(!lut.empty()), identity(scn == _dcn), noScale(true)
+    {
+        int j, k;
+        for( k = 0; k < dcn; k++ )
+        {
+            map[k] = order[k];
+            identity = identity && map[k] == k;
+        }
+        for( k = 0; k < scn; k++ )
+            noScale = noScale && alpha[k] == 1 && beta[k] == 0;
+        for( j = 0; j < 12; j++ )
+        {
+            dalpha[j] = alpha[j % scn]; falpha[j] = (float)dalpha[j];
+            dbeta[j] = beta[j % scn]; fbeta[j] = (float)dbeta[j];
+        }
+
+        // double precision is used where Mat::convertTo needs it and for 64f sources, which are not
+        // rounded to float before scaling; the values indexing the table only need 8 bits
+        int tdepth = hasLUT ? CV_8U : ddepth;
+        wdepth = tdepth == CV_64F || sdepth == CV_64F || (sdepth == CV_32S &&
+                 (tdepth == CV_32S || tdepth == CV_32F)) ? CV_64F : CV_32F;
+
+        if( hasLUT )
+            lut.reshape(1, 1).convertTo(lutd, ddepth);
+        cvtSrc = getConvertFunc(sdepth, wdepth);
+        cvtDst = getConvertFunc(wdepth, ddepth);
+        applyLUT = getApplyLUTFunc(wdepth, ddepth);
+        shuffle = getShuffleChannelsFunc(ddepth);
+        tabFunc = 0;
+
+        if( sdepth <= CV_8S )
+        {
+            // all 256 values of every channel are transformed in advance
+            tab.create(dcn, 256, ddepth);
+            AutoBuffer<double> _wbuf(256);
+            uchar* wbuf = (uchar*)(double*)_wbuf;
+            for( k = 0; k < dcn; k++ )
+            {
+                int c = map[k];
+                tabMap[k] = std::max(c, 0);
+                if( c < 0 )
+                {
+                    tab.row(k) = Scalar::all(0);
+                    continue;
+                }
+                for( j = 0; j < 256; j++ )
+                {
+                    double v = sdepth == CV_8U ? j : (schar)j;
+                    if( wdepth == CV_32F )
+                        ((float*)wbuf)[j] = (float)v*falpha[c] + fbeta[c];
+                    else
+                        ((double*)wbuf)[j] = v*dalpha[c] + dbeta[c];
+                }
+                if( hasLUT )
+                    applyLUT(wbuf, lutd.ptr() + (lutcn > 1 ? c*lutd.elemSize() : 0), lutcn,
+                             tab.ptr(k), 256, 1);
+                else
+                    cvtDst(wbuf, 0, 0, 0, tab.ptr(k), 0, Size(256, 1), 0);
+            }
+            tabFunc = getConvertScaleTabFunc(ddepth);
+        }
+    }
+
+    // processes 2D arrays of the same size or their stripes
+    void operator()( const Mat& src, Mat& dst ) const
+    {
+        Size sz = src.size();
+        if( src.isContinuous() && dst.isContinuous() )
+        {
+            sz.width *= sz.height;
+            sz.height = 1;
+        }
+
+        size_t sesz = src.elemSize(), desz = dst.elemSize();
+        AutoBuffer<double> _buf(CVT_LUT_BLOCK*4*2);
+        uchar* wbuf = (uchar*)(double*)_buf;
+        uchar* tbuf = (uchar*)((double*)_buf + CVT_LUT_BLOCK*4);
+
+        for( int y = 0; y < sz.height; y++ )
+        {
+            const uchar* sptr = src.ptr(y);
+            uchar* dptr = dst.ptr(y);
+
+            if( tabFunc )
+            {
+                tabFunc(sptr, scn, dptr, dcn, tabMap, tab.ptr(), sz.width);
+                continue;
+            }
+
+            for( int x = 0; x < sz.width; x += CVT_LUT_BLOCK )
+            {
+                int n = std::min(sz.width - x, (int)CVT_LUT_BLOCK);
+                uchar* t = identity ? dptr + x*desz : tbuf;
+
+                cvtSrc(sptr + x*sesz, 0, 0, 0, wbuf, 0, Size(n*scn, 1), 0);
+                if( !noScale )
+                {
+                    if( wdepth == CV_32F )
+                        scaleAdd12((float*)wbuf, falpha, fbeta, n*scn);
+                    else
+                        scaleAdd12((double*)wbuf, dalpha, dbeta, n*scn);
+                }
+                if( !hasLUT )
+                    cvtDst(wbuf, 0, 0, 0, t, 0, Size(n*scn, 1), 0);
+                else if( lutcn == 1 )
+                    applyLUT(wbuf, lutd.ptr(), 1, t, n*scn, 1);
+                else
+                    applyLUT(wbuf, lutd.ptr(), lutcn, t, n, scn);
+                if( !identity )
+                    shuffle(t, scn, dptr + x*desz, dcn, map, n);
+            }
+        }
+    }
+
+protected:
+    int sdepth, scn, ddepth, dcn, wdepth, lutcn;
+    bool hasLUT, identity, noScale;
+    int map[4], tabMap[4];
+    float falpha[12], fbeta[12];
+    double dalpha[12], dbeta[12];
+    Mat lutd, tab;
+    BinaryFunc cvtSrc, cvtDst;
+    ApplyLUTFunc applyLUT;
+    ShuffleChannelsFunc shuffle;
+    ConvertScaleTabFunc tabFunc;
+};
+
+class ConvertScaleLUTInvoker : public ParallelLoopBody
+{
+public:
+    ConvertScaleLUTInvoker( const ConvertScaleLUT& _cvt, const Mat& _src, Mat& _dst, const ParallelStripes& _stripes )
+        : cvt(_cvt), src(_src), dst(_dst), stripe(_stripes) {}
+
+    void operator()( const Range& range ) const
+    {
+        Mat dstStripe = stripe(dst, range);
+        cvt(stripe(src, range), dstStripe);
+    }
+
+protected:
+    const ConvertScaleLUT& cvt;
+    const Mat& src;
+    Mat& dst;
+    ParallelStripes stripe;
+};
+
+}
+
+void cv::convertScaleLUT( InputArray _src, OutputArray _dst, int ddepth,
+                          const Scalar& alpha, const Scalar& beta,
+                          InputArray _lut, const std::vector<int>& order )
+{
+    CV_TRACE_FUNCTION();
+
+    Mat src = _src.getMat(), lut = _lut.getMat();
+    int k, scn = src.channels(), dcn = order.empty() ? scn : (int)order.size();
+    int map[4] = { 0, 1, 2, 3 };
+
+    CV_Assert( scn <= 4 && dcn <= 4 );
+    for( k = 0; k < (int)order.size(); k++ )
+    {
+        CV_Assert( -1 <= order[k] && order[k] < scn );
+        map[k] = order[k];
+    }
+    CV_Assert( lut.empty() || ((lut.channels() == scn || lut.channels() == 1) &&
+               lut.total() == 256 && lut.isContinuous()) );
+    if( ddepth < 0 )
+        ddepth = lut.empty() ? src.depth() : lut.depth();
+    CV_Assert( 0 <= ddepth && ddepth <= CV_64F );
+
+    ConvertScaleLUT cvt(src.type(), ddepth, alpha, beta, lut, map, dcn);
+    _dst.create(src.dims, src.size, CV_MAKETYPE(ddepth, dcn));
+    Mat dst = _dst.getMat();
+
+    if( src.dims > 2 )
+    {
+        const Mat* arrays[] = {&src, &dst, 0};
+        Mat planes[2];
+        NAryMatIterator it(arrays, planes);
+        for( size_t i = 0; i < it.nplanes; i++, ++it )
+            cvt(planes[0], planes[1]);
+        return;
+    }
+
+    ParallelStripes stripes(src, src.total()*src.elemSize());
+    if( stripes.nstripes < 2 )
+    {
+        cvt(src, dst);
+        return;
+    }
+
+    parallel_for_(stripes.range(), ConvertScaleLUTInvoker(cvt, src, dst, stripes), stripes.nstripes);
+}
+
 namespace cv {
 
 #ifdef HAVE_OPENCL
@@ -5334,6 +4422,8 @@ static bool ocl_normalize( InputArray _src, InputOutputArray _dst, InputArray _m
 void cv::normalize( InputArray _src, InputOutputArray _dst, double a, double b,
                     int norm_type, int rtype, InputArray _mask )
 {
+    CV_TRACE_FUNCTION();
+
     double scale = 1, shift = 0;
     if( norm_type == CV_MINMAX )
     {
@@ -0,0 +1,182 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+// No include guard: the kernels are compiled once per dispatched instruction set,
+// see ocv_add_dispatched_file() in cmake/OpenCVCompilerOptimizations.cmake.
+// The kernels return the number of processed elements, the tail is handled by the caller.
+
+#include "opencv2/core/hal/intrin.hpp"
+
+namespace cv {
+CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
+
+// dst[x] = saturate_cast<dtype>(src[x]*scale + shift), computed in float
+int cvtScale_simd(const uchar* src, uchar* dst, int width, float scale, float shift);
+int cvtScale_simd(const uchar* src, schar* dst, int width, float scale, float shift);
+int cvtScale_simd(const uchar* src, ushort* dst, int width, float scale, float shift);
+int cvtScale_simd(const uchar* src, short* dst, int width, float scale, float shift);
+int cvtScale_simd(const uchar* src, int* dst, int width, float scale, float shift);
+int cvtScale_simd(const uchar* src, float* dst, int width, float scale, float shift);
+
+int cvtScale_simd(const schar* src, uchar* dst, int width, float scale, float shift);
+int cvtScale_simd(const schar* src, schar* dst, int width, float scale, float shift);
+int cvtScale_simd(const schar* src, ushort* dst, int width, float scale, float shift);
+int cvtScale_simd(const schar* src, short* dst, int width, float scale, float shift);
+int cvtScale_simd(const schar* src, int* dst, int width, float scale, float shift);
+int cvtScale_simd(const schar* src, float* dst, int width, float scale, float shift);
+
+int cvtScale_simd(const ushort* src, uchar* dst, int width, float scale, float shift);
+int cvtScale_simd(const ushort* src, schar* dst, int width, float scale, float shift);
+int cvtScale_simd(const ushort* src, ushort* dst, int width, float scale, float shift);
+int cvtScale_simd(const ushort* src, short* dst, int width, float scale, float shift);
+int cvtScale_simd(const ushort* src, int* dst, int width, float scale, float shift);
+int cvtScale_simd(const ushort* src, float* dst, int width, float scale, float shift);
+
+int cvtScale_simd(const short* src, uchar* dst, int width, float scale, float shift);
+int cvtScale_simd(const short* src, schar* dst, int width, float scale, float shift);
+int cvtScale_simd(const short* src, ushort* dst, int width, float scale, float shift);
+int cvtScale_simd(const short* src, float* dst, int width, float scale, float shift);
+
+int cvtScale_simd(const float* src, uchar* dst, int width, float scale, float shift);
+int cvtScale_simd(const float* src, schar* dst, int width, float scale, float shift);
+int cvtScale_simd(const float* src, ushort* dst, int width, float scale, float shift);
+int cvtScale_simd(const float* src, short* dst, int width, float scale, float shift);
+int cvtScale_simd(const float* src, int* dst, int width, float scale, float shift);
+int cvtScale_simd(const float* src, float* dst, int width, float scale, float shift);
+
+#ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+#if CV_SIMD
+
+// loads 2*v_float32::nlanes elements
+static inline void cvt_load_f32(const uchar* ptr, v_float32& a, v_float32& b)
+{
+    v_uint32 t0, t1;
+    v_expand(vx_load_expand(ptr), t0, t1);
+    a = v_cvt_f32(v_reinterpret_as_s32(t0));
+    b = v_cvt_f32(v_reinterpret_as_s32(t1));
+}
+
+static inline void cvt_load_f32(const schar* ptr, v_float32& a, v_float32& b)
+{
+    v_int32 t0, t1;
+    v_expand(vx_load_expand(ptr), t0, t1);
+    a = v_cvt_f32(t0);
+    b = v_cvt_f32(t1);
+}
+
+static inline void cvt_load_f32(const ushort* ptr, v_float32& a, v_float32& b)
+{
+    v_uint32 t0, t1;
+    v_expand(vx_load(ptr), t0, t1);
+    a = v_cvt_f32(v_reinterpret_as_s32(t0));
+    b = v_cvt_f32(v_reinterpret_as_s32(t1));
+}
+
+static inline void cvt_load_f32(const short* ptr, v_float32& a, v_float32& b)
+{
+    v_int32 t0, t1;
+    v_expand(vx_load(ptr), t0, t1);
+    a = v_cvt_f32(t0);
+    b = v_cvt_f32(t1);
+}
+
+static inline void cvt_load_f32(const float* ptr, v_float32& a, v_float32& b)
+{
+    a = vx_load(ptr);
+    b = vx_load(ptr + v_float32::nlanes);
+}
+
+// rounds and stores 2*v_float32::nlanes elements with saturation
+static inline void cvt_store_f32(uchar* ptr, const v_float32& a, const v_float32& b)
+{ v_pack_store(ptr, v_pack_u(v_round(a), v_round(b))); }
+
+static inline void cvt_store_f32(schar* ptr, const v_float32& a, const v_float32& b)
+{ v_pack_store(ptr, v_pack(v_round(a), v_round(b))); }
+
+static inline void cvt_store_f32(ushort* ptr, const v_float32& a, const v_float32& b)
+{ v_store(ptr, v_pack_u(v_round(a), v_round(b))); }
+
+static inline void cvt_store_f32(short* ptr, const v_float32& a, const v_float32& b)
+{ v_store(ptr, v_pack(v_round(a), v_round(b))); }
+
+static inline void cvt_store_f32(int* ptr, const v_float32& a, const v_float32& b)
+{
+    v_store(ptr, v_round(a));
+    v_store(ptr + v_int32::nlanes, v_round(b));
+}
+
+static inline void cvt_store_f32(float* ptr, const v_float32& a, const v_float32& b)
+{
+    v_store(ptr, a);
+    v_store(ptr + v_float32::nlanes, b);
+}
+
+#endif // CV_SIMD
+
+template<typename _Ts, typename _Td> static inline int
+cvtScale_simd_(const _Ts* src, _Td* dst, int width, float scale, float shift)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_float32::nlanes*2;
+    v_float32 v_scale = vx_setall_f32(scale), v_shift = vx_setall_f32(shift);
+
+    for ( ; x <= width - VECSZ; x += VECSZ)
+    {
+        v_float32 v0, v1;
+        cvt_load_f32(src + x, v0, v1);
+        v0 = v0 * v_scale + v_shift;
+        v1 = v1 * v_scale + v_shift;
+        cvt_store_f32(dst + x, v0, v1);
+    }
+#else
+    (void)src; (void)dst; (void)width; (void)scale; (void)shift;
+#endif
+    return x;
+}
+
+#define DEF_CVT_SCALE_SIMD(stype, dtype) \
+int cvtScale_simd(const stype* src, dtype* dst, int width, float scale, float shift) \
+{ return cvtScale_simd_(src, dst, width, scale, shift); }
+
+DEF_CVT_SCALE_SIMD(uchar, uchar)
+DEF_CVT_SCALE_SIMD(uchar, schar)
+DEF_CVT_SCALE_SIMD(uchar, ushort)
+DEF_CVT_SCALE_SIMD(uchar, short)
+DEF_CVT_SCALE_SIMD(uchar, int)
+DEF_CVT_SCALE_SIMD(uchar, float)
+
+DEF_CVT_SCALE_SIMD(schar, uchar)
+DEF_CVT_SCALE_SIMD(schar, schar)
+DEF_CVT_SCALE_SIMD(schar, ushort)
+DEF_CVT_SCALE_SIMD(schar, short)
+DEF_CVT_SCALE_SIMD(schar, int)
+DEF_CVT_SCALE_SIMD(schar, float)
+
+DEF_CVT_SCALE_SIMD(ushort, uchar)
+DEF_CVT_SCALE_SIMD(ushort, schar)
+DEF_CVT_SCALE_SIMD(ushort, ushort)
+DEF_CVT_SCALE_SIMD(ushort, short)
+DEF_CVT_SCALE_SIMD(ushort, int)
+DEF_CVT_SCALE_SIMD(ushort, float)
+
+DEF_CVT_SCALE_SIMD(short, uchar)
+DEF_CVT_SCALE_SIMD(short, schar)
+DEF_CVT_SCALE_SIMD(short, ushort)
+DEF_CVT_SCALE_SIMD(short, float)
+
+DEF_CVT_SCALE_SIMD(float, uchar)
+DEF_CVT_SCALE_SIMD(float, schar)
+DEF_CVT_SCALE_SIMD(float, ushort)
+DEF_CVT_SCALE_SIMD(float, short)
+DEF_CVT_SCALE_SIMD(float, int)
+DEF_CVT_SCALE_SIMD(float, float)
+
+#undef DEF_CVT_SCALE_SIMD
+
+#endif // CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+CV_CPU_OPTIMIZATION_NAMESPACE_END
+} // namespace cv
@@ -44,6 +44,7 @@
 #include "opencv2/core/opencl/runtime/opencl_core.hpp"
 #include "opencl_kernels_core.hpp"
 #include <map>
+#include <list>
 
 namespace cv
 {
@@ -977,7 +978,7 @@ DFT( const Complex<T>* src, Complex<T>* dst, int n,
      re(0), re(1), im(1), ... , re(n/2-1), im((n+1)/2-1) [, re((n+1)/2)] OR ...
      re(0), 0, re(1), im(1), ..., re(n/2-1), im((n+1)/2-1) [, re((n+1)/2), 0] */
 template<typename T> static void
-RealDFT( const T* src, T* dst, int n, int nf, int* factors, const int* itab,
+RealDFT( const T* src, T* dst, int n, int nf, const int* factors, const int* itab,
          const Complex<T>* wave, int tab_size, const void*
 #ifdef USE_IPP_DFT
          spec
@@ -1045,12 +1046,13 @@ RealDFT( const T* src, T* dst, int n, int nf, int* factors, const int* itab,
         T t0, t;
         T h1_re, h1_im, h2_re, h2_im;
         T scale2 = scale*(T)0.5;
-        factors[0] >>= 1;
+        int factors2[34];
+        memcpy( factors2, factors, nf*sizeof(factors[0]) );
+        factors2[0] >>= 1;
 
-        DFT( (Complex<T>*)src, (Complex<T>*)dst, n2, nf - (factors[0] == 1),
-             factors + (factors[0] == 1),
+        DFT( (Complex<T>*)src, (Complex<T>*)dst, n2, nf - (factors2[0] == 1),
+             factors2 + (factors2[0] == 1),
              itab, wave, tab_size, 0, buf, 0, 1 );
-        factors[0] <<= 1;
 
         t = dst[0] - dst[1];
         dst[0] = (dst[0] + dst[1])*scale;
@@ -1103,7 +1105,7 @@ RealDFT( const T* src, T* dst, int n, int nf, int* factors, const int* itab,
       re[0], re[1], im[1], ... , re[n/2-1], im[n/2-1], re[n/2] OR
       re(0), 0, re(1), im(1), ..., re(n/2-1), im((n+1)/2-1) [, re((n+1)/2), 0] */
 template<typename T> static void
-CCSIDFT( const T* src, T* dst, int n, int nf, int* factors, const int* itab,
+CCSIDFT( const T* src, T* dst, int n, int nf, const int* factors, const int* itab,
          const Complex<T>* wave, int tab_size,
          const void*
 #ifdef USE_IPP_DFT
@@ -1245,13 +1247,14 @@ CCSIDFT( const T* src, T* dst, int n, int nf, int* factors, const int* itab,
             }
         }
 
-        factors[0] >>= 1;
+        int factors2[34];
+        memcpy( factors2, factors, nf*sizeof(factors[0]) );
+        factors2[0] >>= 1;
         DFT( (Complex<T>*)dst, (Complex<T>*)dst, n2,
-             nf - (factors[0] == 1),
-             factors + (factors[0] == 1), itab,
+             nf - (factors2[0] == 1),
+             factors2 + (factors2[0] == 1), itab,
              wave, tab_size, 0, buf,
              inplace ? 0 : DFT_NO_PERMUTE, 1. );
-        factors[0] <<= 1;
 
         for( j = 0; j < n; j += 2 )
         {
@@ -1438,7 +1441,7 @@ ExpandCCS( uchar* _ptr, int n, int elem_size )
 
 
 typedef void (*DFTFunc)(
-     const void* src, void* dst, int n, int nf, int* factors,
+     const void* src, void* dst, int n, int nf, const int* factors,
      const int* itab, const void* wave, int tab_size,
      const void* spec, void* buf, int inv, double scale );
 
@@ -1461,28 +1464,28 @@ static void DFT_64f( const Complexd* src, Complexd* dst, int n,
 }
 
 
-static void RealDFT_32f( const float* src, float* dst, int n, int nf, int* factors,
+static void RealDFT_32f( const float* src, float* dst, int n, int nf, const int* factors,
         const int* itab,  const Complexf* wave, int tab_size, const void* spec,
         Complexf* buf, int flags, double scale )
 {
     RealDFT( src, dst, n, nf, factors, itab, wave, tab_size, spec, buf, flags, scale);
 }
 
-static void RealDFT_64f( const double* src, double* dst, int n, int nf, int* factors,
+static void RealDFT_64f( const double* src, double* dst, int n, int nf, const int* factors,
         const int* itab,  const Complexd* wave, int tab_size, const void* spec,
         Complexd* buf, int flags, double scale )
 {
     RealDFT( src, dst, n, nf, factors, itab, wave, tab_size, spec, buf, flags, scale);
 }
 
-static void CCSIDFT_32f( const float* src, float* dst, int n, int nf, int* factors,
+static void CCSIDFT_32f( const float* src, float* dst, int n, int nf, const int* factors,
                          const int* itab,  const Complexf* wave, int tab_size, const void* spec,
                          Complexf* buf, int flags, double scale )
 {
     CCSIDFT( src, dst, n, nf, factors, itab, wave, tab_size, spec, buf, flags, scale);
 }
 
-static void CCSIDFT_64f( const double* src, double* dst, int n, int nf, int* factors,
+static void CCSIDFT_64f( const double* src, double* dst, int n, int nf, const int* factors,
                          const int* itab,  const Complexd* wave, int tab_size, const void* spec,
                          Complexd* buf, int flags, double scale )
 {
@@ -2465,19 +2468,210 @@ static void complementComplexOutput(Mat& dst, int len, int dft_dims)
 }
 }
 
-void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
+namespace cv
 {
-#ifdef HAVE_CLAMDFFT
-    CV_OCL_RUN(ocl::haveAmdFft() && ocl::Device::getDefault().type() != ocl::Device::TYPE_CPU &&
-            _dst.isUMat() && _src0.dims() <= 2 && nonzero_rows == 0,
-               ocl_dft_amdfft(_src0, _dst, flags))
-#endif
 
-#ifdef HAVE_OPENCL
-    CV_OCL_RUN(_dst.isUMat() && _src0.dims() <= 2,
-               ocl_dft(_src0, _dst, flags, nonzero_rows))
-#endif
+// the factorization of the length, the permutation table and the twiddle factors of the 1D DFT,
+// they are not modified after the construction, so the threads share them
+struct DFTTables
+{
+    DFTTables(int _n, int depth, bool inv_itab) : n(_n)
+    {
+        int complex_elem_size = depth == CV_64F ? (int)sizeof(Complexd) : (int)sizeof(Complexf);
+        nf = DFTFactorize( n, factors );
+        itab.resize(n);
+        wave.resize((n*complex_elem_size + sizeof(double) - 1)/sizeof(double));
+        DFTInit( n, nf, factors, &itab[0], complex_elem_size, &wave[0], inv_itab );
+    }
+
+    int n, nf;
+    int factors[34];
+    std::vector<int> itab;
+    std::vector<double> wave;
+};
+
+// the row-wise stage of the transform: the rows are independent, every stripe has its own work buffer
+class DFTRowsInvoker : public ParallelLoopBody
+{
+public:
+    DFTRowsInvoker(const Mat& _src, Mat& _dst, DFTFunc _dft_func, const DFTTables& _tabs, const void* _spec,
+                   int _len, int _complex_elem_size, int _bufsz, bool _use_buf, int _dptr_offset,
+                   int _dst_full_len, int _flags, double _scale)
+        : src(_src), dst(_dst), dft_func(_dft_func), tabs(_tabs), spec(_spec), len(_len),
+          complex_elem_size(_complex_elem_size), bufsz(_bufsz), use_buf(_use_buf), dptr_offset(_dptr_offset),
+          dst_full_len(_dst_full_len), flags(_flags), scale(_scale) {}
+
+    void operator()(const Range& range) const
+    {
+        AutoBuffer<uchar> buf(bufsz + 32);
+        uchar* ptr = alignPtr((uchar*)buf, 16);
+        uchar* tmp_buf = 0;
+
+        if( use_buf )
+        {
+            tmp_buf = ptr;
+            ptr += len*complex_elem_size;
+        }
+
+        for( int i = range.start; i < range.end; i++ )
+        {
+            const uchar* sptr = src.ptr(i);
+            uchar* dptr0 = dst.ptr(i);
+            uchar* dptr = dptr0;
+
+            if( tmp_buf )
+                dptr = tmp_buf;
+
+            dft_func( sptr, dptr, len, tabs.nf, tabs.factors, &tabs.itab[0], &tabs.wave[0], len,
+                      spec, ptr, flags, scale );
+            if( dptr != dptr0 )
+                memcpy( dptr0, dptr + dptr_offset, dst_full_len );
+        }
+    }
+
+private:
+    const Mat& src;
+    Mat& dst;
+    DFTFunc dft_func;
+    const DFTTables& tabs;
+    const void* spec;
+    int len, complex_elem_size, bufsz;
+    bool use_buf;
+    int dptr_offset, dst_full_len, flags;
+    double scale;
+};
+
+class DFTPlanImpl : public DFTPlan
+{
+public:
+    DFTPlanImpl(Size _sz, int _type, int _flags) : sz(_sz), tp(_type), fl(_flags)
+    {
+        CV_Assert( tp == CV_32FC1 || tp == CV_32FC2 || tp == CV_64FC1 || tp == CV_64FC2 );
+        CV_Assert( sz.width > 0 && sz.height > 0 );
+
+        bool inv = (fl & DFT_INVERSE) != 0;
+        bool inv_real = inv && (CV_MAT_CN(tp) == 1 || (fl & DFT_REAL_OUTPUT) != 0);
+        int depth = CV_MAT_DEPTH(tp);
+        int len = sz.width == 1 && !(fl & DFT_ROWS) ? sz.height : sz.width;
+
+        rowTables = makePtr<DFTTables>(len, depth, inv_real);
+        if( !(fl & DFT_ROWS) && sz.height > 1 )
+            colTables = sz.height == len && !inv_real ? rowTables : makePtr<DFTTables>(sz.height, depth, false);
+    }
+
+    void apply(InputArray src, OutputArray dst, int nonzeroRows) const
+    {
+        CV_Assert( src.dims() <= 2 && src.size() == sz && src.type() == tp );
+        run(src.getMat(), dst, nonzeroRows);
+    }
+
+    void applyBatch(InputArrayOfArrays _src, OutputArrayOfArrays _dst) const;
+
+    Size size() const { return sz; }
+    int type() const { return tp; }
+    int flags() const { return fl; }
+
+    int dstType() const
+    {
+        int depth = CV_MAT_DEPTH(tp), cn = CV_MAT_CN(tp);
+        bool inv = (fl & DFT_INVERSE) != 0;
+        if( !inv && cn == 1 && (fl & DFT_COMPLEX_OUTPUT) )
+            return CV_MAKETYPE(depth, 2);
+        if( inv && cn == 2 && (fl & DFT_REAL_OUTPUT) )
+            return depth;
+        return tp;
+    }
+
+    void run(const Mat& src0, OutputArray _dst, int nonzero_rows) const;
+
+protected:
+    Size sz;
+    int tp, fl;
+    Ptr<DFTTables> rowTables, colTables;
+};
+
+class DFTBatchInvoker : public ParallelLoopBody
+{
+public:
+    DFTBatchInvoker(const DFTPlanImpl& _plan, const std::vector<Mat>& _src, std::vector<Mat>& _dst)
+        : plan(_plan), src(_src), dst(_dst) {}
+
+    void operator()(const Range& range) const
+    {
+        for( int i = range.start; i < range.end; i++ )
+            plan.run(src[i], dst[i], 0);
+    }
+
+private:
+    const DFTPlanImpl& plan;
+    const std::vector<Mat>& src;
+    std::vector<Mat>& dst;
+};
+
+void DFTPlanImpl::applyBatch(InputArrayOfArrays _src, OutputArrayOfArrays _dst) const
+{
+    std::vector<Mat> src, dst;
+    _src.getMatVector(src);
+
+    int i, n = (int)src.size(), dtype = dstType();
+    for( i = 0; i < n; i++ )
+        CV_Assert( src[i].dims <= 2 && src[i].size() == sz && src[i].type() == tp );
+
+    _dst.create(n, 1, dtype);
+    for( i = 0; i < n; i++ )
+        _dst.create(sz, dtype, i);
+    _dst.getMatVector(dst);
+
+    parallel_for_(Range(0, n), DFTBatchInvoker(*this, src, dst));
+}
+
+// the least recently used plans are evicted when the cache is full
+class DFTPlanCache
+{
+public:
+    enum { CAPACITY = 32 };
+
+    static DFTPlanCache& getInstance()
+    {
+        CV_SINGLETON_LAZY_INIT_REF(DFTPlanCache, new DFTPlanCache())
+    }
+
+    Ptr<DFTPlanImpl> getPlan(Size sz, int type, int flags)
+    {
+        flags &= DFT_INVERSE | DFT_SCALE | DFT_ROWS | DFT_COMPLEX_OUTPUT | DFT_REAL_OUTPUT;
+
+        AutoLock lock(mutex);
+        for( std::list<Ptr<DFTPlanImpl> >::iterator it = plans.begin(); it != plans.end(); ++it )
+        {
+            const DFTPlanImpl& p = **it;
+            if( p.size() == sz && p.type() == type && p.flags() == flags )
+            {
+                if( it != plans.begin() )
+                    plans.splice(plans.begin(), plans, it);
+                return plans.front();
+            }
+        }
+
+        Ptr<DFTPlanImpl> plan = makePtr<DFTPlanImpl>(sz, type, flags);
+        plans.push_front(plan);
+        if( ++count > CAPACITY )
+        {
+            plans.pop_back();
+            count--;
+        }
+        return plan;
+    }
 
+protected:
+    DFTPlanCache() : count(0) {}
+
+    Mutex mutex;
+    std::list<Ptr<DFTPlanImpl> > plans;
+    int count;
+};
+
+void DFTPlanImpl::run( const Mat& src0, OutputArray _dst, int nonzero_rows ) const
+{
     static DFTFunc dft_tbl[6] =
     {
         (DFTFunc)DFT_32f,
@@ -2488,27 +2682,20 @@ void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
         (DFTFunc)CCSIDFT_64f
     };
     AutoBuffer<uchar> buf;
-    Mat src0 = _src0.getMat(), src = src0;
-    int prev_len = 0, stage = 0;
+    Mat src = src0;
+    int stage = 0;
+    int flags = fl;
     bool inv = (flags & DFT_INVERSE) != 0;
-    int nf = 0, real_transform = src.channels() == 1 || (inv && (flags & DFT_REAL_OUTPUT)!=0);
-    int type = src.type(), depth = src.depth();
+    int real_transform = src.channels() == 1 || (inv && (flags & DFT_REAL_OUTPUT)!=0);
+    int depth = src.depth();
     int elem_size = (int)src.elemSize1(), complex_elem_size = elem_size*2;
-    int factors[34];
     bool inplace_transform = false;
 #ifdef USE_IPP_DFT
     AutoBuffer<uchar> ippbuf;
     int ipp_norm_flag = !(flags & DFT_SCALE) ? 8 : inv ? 2 : 1;
 #endif
 
-    CV_Assert( type == CV_32FC1 || type == CV_32FC2 || type == CV_64FC1 || type == CV_64FC2 );
-
-    if( !inv && src.channels() == 1 && (flags & DFT_COMPLEX_OUTPUT) )
-        _dst.create( src.size(), CV_MAKETYPE(depth, 2) );
-    else if( inv && src.channels() == 2 && (flags & DFT_REAL_OUTPUT) )
-        _dst.create( src.size(), depth );
-    else
-        _dst.create( src.size(), type );
+    _dst.create( src.size(), dstType() );
 
     Mat dst = _dst.getMat();
 
@@ -2583,10 +2770,8 @@ void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
     for(;;)
     {
         double scale = 1;
-        uchar* wave = 0;
-        int* itab = 0;
         uchar* ptr;
-        int i, len, count, sz = 0;
+        int i, len, count, bufsz = 0;
         int use_buf = 0, odd_real = 0;
         DFTFunc dft_func;
 
@@ -2605,9 +2790,16 @@ void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
         {
             len = dst.rows;
             count = !inv ? src0.cols : dst.cols;
-            sz = 2*len*complex_elem_size;
+            bufsz = 2*len*complex_elem_size;
         }
 
+        const DFTTables& tabs = stage == 0 ? *rowTables : *colTables;
+        int nf = tabs.nf;
+        const int* factors = tabs.factors;
+        const int* itab = &tabs.itab[0];
+        const double* wave = &tabs.wave[0];
+        CV_Assert( tabs.n == len );
+
         void *spec = 0;
 #ifdef USE_IPP_DFT
         if( CV_IPP_CHECK_COND && (len*count >= 64) ) // use IPP DFT if available
@@ -2649,7 +2841,7 @@ void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
                 uchar* initbuf = alignPtr((uchar*)spec + specsize, 32);
                 if( initFunc(len, ipp_norm_flag, ippAlgHintNone, spec, initbuf) < 0 )
                     spec = 0;
-                sz += worksize;
+                bufsz += worksize;
             }
             else
                 setIppErrorStatus();
@@ -2657,58 +2849,28 @@ void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
         else
 #endif
         {
-            if( len != prev_len )
-                nf = DFTFactorize( len, factors );
-
             inplace_transform = factors[0] == factors[nf-1];
-            sz += len*(complex_elem_size + sizeof(int));
             i = nf > 1 && (factors[0] & 1) == 0;
             if( (factors[i] & 1) != 0 && factors[i] > 5 )
-                sz += (factors[i]+1)*complex_elem_size;
+                bufsz += (factors[i]+1)*complex_elem_size;
 
             if( (stage == 0 && ((src.data == dst.data && !inplace_transform) || odd_real)) ||
                 (stage == 1 && !inplace_transform) )
             {
                 use_buf = 1;
-                sz += len*complex_elem_size;
+                bufsz += len*complex_elem_size;
             }
         }
 
-        ptr = (uchar*)buf;
-        buf.allocate( sz + 32 );
-        if( ptr != (uchar*)buf )
-            prev_len = 0; // because we release the buffer,
-                          // force recalculation of
-                          // twiddle factors and permutation table
-        ptr = (uchar*)buf;
-        if( !spec )
-        {
-            wave = ptr;
-            ptr += len*complex_elem_size;
-            itab = (int*)ptr;
-            ptr = (uchar*)cvAlignPtr( ptr + len*sizeof(int), 16 );
-
-            if( len != prev_len || (!inplace_transform && inv && real_transform))
-                DFTInit( len, nf, factors, itab, complex_elem_size,
-                            wave, stage == 0 && inv && real_transform );
-            // otherwise reuse the tables calculated on the previous stage
-        }
-
         if( stage == 0 )
         {
-            uchar* tmp_buf = 0;
             int dptr_offset = 0;
             int dst_full_len = len*elem_size;
             int _flags = (int)inv + (src.channels() != dst.channels() ?
                          DFT_COMPLEX_INPUT_OR_OUTPUT : 0);
-            if( use_buf )
-            {
-                tmp_buf = ptr;
-                ptr += len*complex_elem_size;
-                if( odd_real && !inv && len > 1 &&
-                    !(_flags & DFT_COMPLEX_INPUT_OR_OUTPUT))
-                    dptr_offset = elem_size;
-            }
+            if( use_buf && odd_real && !inv && len > 1 &&
+                !(_flags & DFT_COMPLEX_INPUT_OR_OUTPUT))
+                dptr_offset = elem_size;
 
             if( !inv && (_flags & DFT_COMPLEX_INPUT_OR_OUTPUT) )
                 dst_full_len += (len & 1) ? elem_size : complex_elem_size;
@@ -2723,21 +2885,16 @@ void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
             if( nonzero_rows <= 0 || nonzero_rows > count )
                 nonzero_rows = count;
 
-            for( i = 0; i < nonzero_rows; i++ )
-            {
-                const uchar* sptr = src.ptr(i);
-                uchar* dptr0 = dst.ptr(i);
-                uchar* dptr = dptr0;
-
-                if( tmp_buf )
-                    dptr = tmp_buf;
-
-                dft_func( sptr, dptr, len, nf, factors, itab, wave, len, spec, ptr, _flags, scale );
-                if( dptr != dptr0 )
-                    memcpy( dptr0, dptr + dptr_offset, dst_full_len );
-            }
+            // the rows are processed in parallel when there are at least 2 stripes of 16K elements
+            DFTRowsInvoker body(src, dst, dft_func, tabs, spec, len, complex_elem_size, bufsz,
+                                use_buf != 0, dptr_offset, dst_full_len, _flags, scale);
+            int nstripes = (int)std::min((size_t)nonzero_rows, (size_t)len*nonzero_rows >> 14);
+            if( nstripes >= 2 )
+                parallel_for_(Range(0, nonzero_rows), body, nstripes);
+            else
+                body(Range(0, nonzero_rows));
 
-            for( ; i < count; i++ )
+            for( i = nonzero_rows; i < count; i++ )
             {
                 uchar* dptr0 = dst.ptr(i);
                 memset( dptr0, 0, dst_full_len );
@@ -2757,6 +2914,8 @@ void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
             uchar *buf0, *buf1, *dbuf0, *dbuf1;
             const uchar* sptr0 = src.ptr();
             uchar* dptr0 = dst.ptr();
+            buf.allocate( bufsz + 32 );
+            ptr = alignPtr((uchar*)buf, 16);
             buf0 = ptr;
             ptr += len*complex_elem_size;
             buf1 = ptr;
@@ -2898,6 +3057,34 @@ void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
     }
 }
 
+Ptr<DFTPlan> DFTPlan::create(Size size, int type, int flags)
+{
+    return DFTPlanCache::getInstance().getPlan(size, type, flags);
+}
+
+DFTPlan::~DFTPlan() {}
+
+}
+
+void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
+{
+    CV_TRACE_FUNCTION();
+
+#ifdef HAVE_CLAMDFFT
+    CV_OCL_RUN(ocl::haveAmdFft() && ocl::Device::getDefault().type() != ocl::Device::TYPE_CPU &&
+            _dst.isUMat() && _src0.dims() <= 2 && nonzero_rows == 0,
+               ocl_dft_amdfft(_src0, _dst, flags))
+#endif
+
+#ifdef HAVE_OPENCL
+    CV_OCL_RUN(_dst.isUMat() && _src0.dims() <= 2,
+               ocl_dft(_src0, _dst, flags, nonzero_rows))
+#endif
+
+    Mat src = _src0.getMat();
+    CV_Assert( src.dims <= 2 );
+    DFTPlanCache::getInstance().getPlan(src.size(), src.type(), flags)->run(src, _dst, nonzero_rows);
+}
 
 void cv::idft( InputArray src, OutputArray dst, int flags, int nonzero_rows )
 {
@@ -3576,6 +3763,8 @@ static bool ippi_DCT_32f(const Mat& src, Mat& dst, bool inv, bool row)
 
 void cv::dct( InputArray _src0, OutputArray _dst, int flags )
 {
+    CV_TRACE_FUNCTION();
+
     static DCTFunc dct_tbl[4] =
     {
         (DCTFunc)DCT_32f,
@@ -56,44 +56,105 @@ static void generateRandomCenter(const std::vector<Vec2f>& box, float* center, R
         center[j] = ((float)rng*(1.f+margin*2.f)-margin)*(box[j][1] - box[j][0]) + box[j][0];
 }
 
+// the samples are split into the fixed number of stripes that does not depend on the number of threads,
+// so the partial sums and thus the chosen centers are the same with any number of threads
+enum { KMEANS_PP_GRAIN = 1 << 16 };
+
+static inline int kmeansStripeStart( int N, int nstripes, int s )
+{
+    return (int)((int64)N*s/nstripes);
+}
+
+/*
+computes the distances from every sample to its closest center when one of the candidate centers is added
+to the already chosen ones (dist, if not NULL); the samples are read once for all the candidates and
+the sums of the distances are accumulated by stripes
+*/
 class KMeansPPDistanceComputer : public ParallelLoopBody
 {
 public:
-    KMeansPPDistanceComputer( float *_tdist2,
+    KMeansPPDistanceComputer( float** _tdist,
+                              double* _tsums,
                               const float *_data,
                               const float *_dist,
                               int _dims,
                               size_t _step,
-                              size_t _stepci )
-        : tdist2(_tdist2),
+                              const int* _candidates,
+                              int _ncandidates,
+                              int _N,
+                              int _nstripes )
+        : tdist(_tdist),
+          tsums(_tsums),
           data(_data),
           dist(_dist),
           dims(_dims),
           step(_step),
-          stepci(_stepci) { }
+          candidates(_candidates),
+          ncandidates(_ncandidates),
+          N(_N),
+          nstripes(_nstripes) { }
 
     void operator()( const cv::Range& range ) const
     {
-        const int begin = range.start;
-        const int end = range.end;
+        AutoBuffer<double> _sums(ncandidates);
+        double* sums = _sums;
 
-        for ( int i = begin; i<end; i++ )
+        for( int s = range.start; s < range.end; s++ )
         {
-            tdist2[i] = std::min(normL2Sqr(data + step*i, data + stepci, dims), dist[i]);
+            const int begin = kmeansStripeStart(N, nstripes, s);
+            const int end = kmeansStripeStart(N, nstripes, s + 1);
+            int j;
+
+            for( j = 0; j < ncandidates; j++ )
+                sums[j] = 0;
+
+            for( int i = begin; i < end; i++ )
+            {
+                const float* sample = data + step*i;
+                for( j = 0; j < ncandidates; j++ )
+                {
+                    float d = normL2Sqr(sample, data + step*candidates[j], dims);
+                    if( dist )
+                        d = std::min(d, dist[i]);
+                    tdist[j][i] = d;
+                    sums[j] += d;
+                }
+            }
+
+            for( j = 0; j < ncandidates; j++ )
+                tsums[j*nstripes + s] = sums[j];
         }
     }
 
 private:
     KMeansPPDistanceComputer& operator=(const KMeansPPDistanceComputer&); // to quiet MSVC
 
-    float *tdist2;
+    float** tdist;
+    double* tsums;
     const float *data;
     const float *dist;
     const int dims;
     const size_t step;
-    const size_t stepci;
+    const int* candidates;
+    const int ncandidates;
+    const int N;
+    const int nstripes;
 };
 
+// picks the sample with the probability proportional to dist[i], p is uniformly distributed in [0, sum(dist))
+static int kmeansPPSample( const float* dist, const double* sums, int N, int nstripes, double p )
+{
+    int s = 0, i;
+    for( ; s < nstripes - 1 && p > sums[s]; s++ )
+        p -= sums[s];
+
+    int end = s == nstripes - 1 ? N - 1 : kmeansStripeStart(N, nstripes, s + 1);
+    for( i = kmeansStripeStart(N, nstripes, s); i < end; i++ )
+        if( (p -= dist[i]) <= 0 )
+            break;
+    return i;
+}
+
 /*
 k-means center initialization using the following algorithm:
 Arthur & Vassilvitskii (2007) k-means++: The Advantages of Careful Seeding
@@ -102,52 +163,57 @@ static void generateCentersPP(const Mat& _data, Mat& _out_centers,
                               int K, RNG& rng, int trials)
 {
     int i, j, k, dims = _data.cols, N = _data.rows;
+    int nstripes = (int)std::min(std::max((size_t)N*dims/KMEANS_PP_GRAIN, (size_t)1), (size_t)N);
     const float* data = _data.ptr<float>(0);
     size_t step = _data.step/sizeof(data[0]);
-    std::vector<int> _centers(K);
-    int* centers = &_centers[0];
-    std::vector<float> _dist(N*3);
-    float* dist = &_dist[0], *tdist = dist + N, *tdist2 = tdist + N;
+    std::vector<int> _centers(K), _candidates(trials);
+    int* centers = &_centers[0], *candidates = &_candidates[0];
+    std::vector<float> _dist((size_t)N*(trials + 1));
+    std::vector<float*> _tdist(trials + 1);
+    float** tdist = &_tdist[0];
+    for( j = 0; j <= trials; j++ )
+        tdist[j] = &_dist[0] + (size_t)N*j;
+    float* dist = tdist[trials];
+    std::vector<double> _sums(nstripes*(trials + 1));
+    double* tsums = &_sums[0], *sums = tsums + nstripes*trials;
     double sum0 = 0;
 
     centers[0] = (unsigned)rng % N;
 
-    for( i = 0; i < N; i++ )
-    {
-        dist[i] = normL2Sqr(data + step*i, data + step*centers[0], dims);
-        sum0 += dist[i];
-    }
+    parallel_for_(Range(0, nstripes),
+                  KMeansPPDistanceComputer(&dist, sums, data, 0, dims, step, centers, 1, N, nstripes));
+    for( i = 0; i < nstripes; i++ )
+        sum0 += sums[i];
 
     for( k = 1; k < K; k++ )
     {
         double bestSum = DBL_MAX;
-        int bestCenter = -1;
+        int bestTrial = -1;
 
+        // the candidates depend only on the current distances, so they are all evaluated in one pass
         for( j = 0; j < trials; j++ )
-        {
-            double p = (double)rng*sum0, s = 0;
-            for( i = 0; i < N-1; i++ )
-                if( (p -= dist[i]) <= 0 )
-                    break;
-            int ci = i;
+            candidates[j] = kmeansPPSample(dist, sums, N, nstripes, (double)rng*sum0);
 
-            parallel_for_(Range(0, N),
-                         KMeansPPDistanceComputer(tdist2, data, dist, dims, step, step*ci));
-            for( i = 0; i < N; i++ )
-            {
-                s += tdist2[i];
-            }
+        parallel_for_(Range(0, nstripes),
+                      KMeansPPDistanceComputer(tdist, tsums, data, dist, dims, step,
+                                               candidates, trials, N, nstripes));
+
+        for( j = 0; j < trials; j++ )
+        {
+            double s = 0;
+            for( i = 0; i < nstripes; i++ )
+                s += tsums[j*nstripes + i];
 
             if( s < bestSum )
             {
                 bestSum = s;
-                bestCenter = ci;
-                std::swap(tdist, tdist2);
+                bestTrial = j;
             }
         }
-        centers[k] = bestCenter;
+        centers[k] = candidates[bestTrial];
         sum0 = bestSum;
-        std::swap(dist, tdist);
+        std::swap(dist, tdist[bestTrial]);
+        std::copy(tsums + bestTrial*nstripes, tsums + (bestTrial + 1)*nstripes, sums);
     }
 
     for( k = 0; k < K; k++ )
@@ -212,6 +278,9 @@ private:
     const Mat& centers;
 };
 
+// the number of samples per iteration used by kmeans() with KMEANS_MINI_BATCH
+enum { KMEANS_DEFAULT_BATCH_SIZE = 1024 };
+
 }
 
 double cv::kmeans( InputArray _data, int K,
@@ -219,6 +288,12 @@ double cv::kmeans( InputArray _data, int K,
                    TermCriteria criteria, int attempts,
                    int flags, OutputArray _centers )
 {
+    CV_TRACE_FUNCTION();
+
+    if( flags & KMEANS_MINI_BATCH )
+        return kmeansMiniBatch(_data, K, _bestLabels, criteria, KMEANS_DEFAULT_BATCH_SIZE,
+                               attempts, flags & ~KMEANS_MINI_BATCH, _centers);
+
     const int SPP_TRIALS = 3;
     Mat data0 = _data.getMat();
     bool isrow = data0.rows == 1;
@@ -454,3 +529,189 @@ double cv::kmeans( InputArray _data, int K,
 
     return best_compactness;
 }
+
+/*
+mini-batch k-means:
+D. Sculley (2010) Web-Scale K-Means Clustering
+*/
+double cv::kmeansMiniBatch( InputArray _data, int K,
+                            InputOutputArray _bestLabels,
+                            TermCriteria criteria, int batchSize,
+                            int attempts, int flags, OutputArray _centers )
+{
+    CV_TRACE_FUNCTION();
+
+    const int SPP_TRIALS = 3;
+    Mat data0 = _data.getMat();
+    bool isrow = data0.rows == 1;
+    int N = isrow ? data0.cols : data0.rows;
+    int dims = (isrow ? 1 : data0.cols)*data0.channels();
+    int type = data0.depth();
+
+    attempts = std::max(attempts, 1);
+    CV_Assert( data0.dims <= 2 && type == CV_32F && K > 0 && batchSize > 0 );
+    CV_Assert( N >= K );
+
+    Mat data(N, dims, CV_32F, data0.ptr(), isrow ? dims * sizeof(float) : static_cast<size_t>(data0.step));
+
+    _bestLabels.create(N, 1, CV_32S, -1, true);
+
+    Mat _labels, best_labels = _bestLabels.getMat();
+    if( flags & KMEANS_USE_INITIAL_LABELS )
+    {
+        CV_Assert( (best_labels.cols == 1 || best_labels.rows == 1) &&
+                  best_labels.cols*best_labels.rows == N &&
+                  best_labels.type() == CV_32S &&
+                  best_labels.isContinuous());
+        best_labels.copyTo(_labels);
+    }
+    else
+    {
+        if( !((best_labels.cols == 1 || best_labels.rows == 1) &&
+             best_labels.cols*best_labels.rows == N &&
+            best_labels.type() == CV_32S &&
+            best_labels.isContinuous()))
+            best_labels.create(N, 1, CV_32S);
+        _labels.create(best_labels.size(), best_labels.type());
+    }
+    int* labels = _labels.ptr<int>();
+
+    if( criteria.type & TermCriteria::EPS )
+        criteria.epsilon = std::max(criteria.epsilon, 0.);
+    else
+        criteria.epsilon = 0;
+    criteria.epsilon *= criteria.epsilon;
+
+    // unlike the full iterations, the batches are cheap, so their number is not limited
+    if( criteria.type & TermCriteria::COUNT )
+        criteria.maxCount = std::max(criteria.maxCount, 1);
+    else
+        criteria.maxCount = 100;
+
+    batchSize = std::min(batchSize, N);
+    int initSize = std::min(N, std::max(batchSize*3, K));
+    Mat centers(K, dims, type), old_centers(K, dims, type), batch(batchSize, dims, type);
+    Mat initData(initSize, dims, type);
+    std::vector<int> counters(K), batch_labels(batchSize);
+    std::vector<double> batch_dists(batchSize);
+    std::vector<Vec2f> _box(dims);
+    double best_compactness = DBL_MAX, compactness = 0;
+    RNG& rng = theRNG();
+    int a, iter, i, j, k;
+
+    Mat dists(1, N, CV_64F);
+    double* dist = dists.ptr<double>();
+
+    for( a = 0; a < attempts; a++ )
+    {
+        if( a == 0 && (flags & KMEANS_USE_INITIAL_LABELS) )
+        {
+            centers = Scalar(0);
+            for( k = 0; k < K; k++ )
+                counters[k] = 0;
+            for( i = 0; i < N; i++ )
+            {
+                k = labels[i];
+                CV_Assert( (unsigned)k < (unsigned)K );
+                const float* sample = data.ptr<float>(i);
+                float* center = centers.ptr<float>(k);
+                for( j = 0; j < dims; j++ )
+                    center[j] += sample[j];
+                counters[k]++;
+            }
+            for( k = 0; k < K; k++ )
+            {
+                // an empty cluster starts from a random sample
+                if( counters[k] == 0 )
+                {
+                    data.row(rng.uniform(0, N)).copyTo(centers.row(k));
+                    continue;
+                }
+                float* center = centers.ptr<float>(k);
+                float scale = 1.f/counters[k];
+                for( j = 0; j < dims; j++ )
+                    center[j] *= scale;
+            }
+        }
+        else
+        {
+            // the initial centers are chosen from a random subset of the samples
+            Mat init = data;
+            if( initSize < N )
+            {
+                for( i = 0; i < initSize; i++ )
+                    data.row(rng.uniform(0, N)).copyTo(initData.row(i));
+                init = initData;
+            }
+
+            if( flags & KMEANS_PP_CENTERS )
+                generateCentersPP(init, centers, K, rng, SPP_TRIALS);
+            else
+            {
+                const float* sample = init.ptr<float>(0);
+                for( j = 0; j < dims; j++ )
+                    _box[j] = Vec2f(sample[j], sample[j]);
+                for( i = 1; i < init.rows; i++ )
+                {
+                    sample = init.ptr<float>(i);
+                    for( j = 0; j < dims; j++ )
+                    {
+                        _box[j][0] = std::min(_box[j][0], sample[j]);
+                        _box[j][1] = std::max(_box[j][1], sample[j]);
+                    }
+                }
+                for( k = 0; k < K; k++ )
+                    generateRandomCenter(_box, centers.ptr<float>(k), rng);
+            }
+        }
+
+        for( k = 0; k < K; k++ )
+            counters[k] = 0;
+
+        for( iter = 0; iter < criteria.maxCount; iter++ )
+        {
+            for( i = 0; i < batchSize; i++ )
+                data.row(rng.uniform(0, N)).copyTo(batch.row(i));
+
+            parallel_for_(Range(0, batchSize),
+                          KMeansDistanceComputer(&batch_dists[0], &batch_labels[0], batch, centers));
+
+            centers.copyTo(old_centers);
+
+            // every center moves towards its samples with the decreasing per-center learning rate
+            for( i = 0; i < batchSize; i++ )
+            {
+                k = batch_labels[i];
+                const float* sample = batch.ptr<float>(i);
+                float* center = centers.ptr<float>(k);
+                float eta = 1.f/++counters[k];
+                for( j = 0; j < dims; j++ )
+                    center[j] += (sample[j] - center[j])*eta;
+            }
+
+            double max_center_shift = 0;
+            for( k = 0; k < K; k++ )
+                max_center_shift = std::max(max_center_shift,
+                                            (double)normL2Sqr(centers.ptr<float>(k), old_centers.ptr<float>(k), dims));
+            if( max_center_shift <= criteria.epsilon )
+                break;
+        }
+
+        // assign labels
+        parallel_for_(Range(0, N),
+                      KMeansDistanceComputer(dist, labels, data, centers));
+        compactness = 0;
+        for( i = 0; i < N; i++ )
+            compactness += dist[i];
+
+        if( compactness < best_compactness )
+        {
+            best_compactness = compactness;
+            if( _centers.needed() )
+                centers.copyTo(_centers);
+            _labels.copyTo(best_labels);
+        }
+    }
+
+    return best_compactness;
+}
@@ -700,6 +700,583 @@ SVBkSb( int m, int n, const double* w, size_t wstep,
                 (double*)alignPtr(buffer, sizeof(double)), DBL_EPSILON*2 );
 }
 
+/////////////////// parallel decompositions of the large matrices ///////////////////
+
+/*
+The symmetric matrices of EIGEN_LARGE_SIZE or more rows and the matrices that need SVD_LARGE_WORK or
+more multiply-adds per Jacobi sweep are reduced to the tridiagonal or bidiagonal form by the Householder
+reflections, which are applied to the independent rows or columns in parallel. The plane rotations of
+the QL/QR iterations are accumulated into the small square matrices, a sweep at a time, and the
+singular/eigen vectors are finally assembled by gemm. Everything is computed in double precision.
+*/
+enum { EIGEN_LARGE_SIZE = 64, SVD_LARGE_MIN_SIZE = 32, SVD_LARGE_WORK = 1 << 21, LARGE_DECOMP_GRAIN = 1 << 15 };
+
+static inline bool useLargeSVD( int m, int n )
+{
+    return std::min(m, n) >= SVD_LARGE_MIN_SIZE && (double)m*n*std::min(m, n) >= SVD_LARGE_WORK;
+}
+
+// the rows of the ranges are independent, so the result does not depend on the number of threads
+static void parallelForWork( const Range& range, const ParallelLoopBody& body, double work )
+{
+    double nstripes = std::min((double)range.size(), work/LARGE_DECOMP_GRAIN);
+    if( nstripes < 2 )
+        body(range);
+    else
+        parallel_for_(range, body, nstripes);
+}
+
+// finds H = I - tau*v*v' such that H*x = beta*e0; v overwrites x, v[0] = 1
+static double makeHouseholder( double* x, int n, double& tau )
+{
+    double alpha = x[0], sigma = 0;
+    int i;
+    for( i = 1; i < n; i++ )
+        sigma += x[i]*x[i];
+    x[0] = 1;
+    if( sigma == 0 )
+    {
+        tau = 0;
+        return alpha;
+    }
+
+    double beta = std::sqrt(alpha*alpha + sigma);
+    if( alpha > 0 )
+        beta = -beta;
+    tau = (beta - alpha)/beta;
+    double scale = 1./(alpha - beta);
+    for( i = 1; i < n; i++ )
+        x[i] *= scale;
+    return beta;
+}
+
+// applies the reflection to the segments [ofs, ofs + len) of the rows: y -= tau*(v'*y)*v
+class HouseholderRowsInvoker : public ParallelLoopBody
+{
+public:
+    HouseholderRowsInvoker( Mat& _X, const double* _v, double _tau, int _ofs, int _len )
+        : X(_X), v(_v), tau(_tau), ofs(_ofs), len(_len) {}
+
+    void operator()( const Range& range ) const
+    {
+        for( int j = range.start; j < range.end; j++ )
+        {
+            double* y = X.ptr<double>(j) + ofs;
+            double t = 0;
+            int i;
+            for( i = 0; i < len; i++ )
+                t += v[i]*y[i];
+            t *= tau;
+            for( i = 0; i < len; i++ )
+                y[i] -= t*v[i];
+        }
+    }
+
+private:
+    HouseholderRowsInvoker& operator=(const HouseholderRowsInvoker&);
+
+    Mat& X;
+    const double* v;
+    double tau;
+    int ofs, len;
+};
+
+// applies the reflection to the columns of the rows [row0, row0 + len): X(row0:, i) -= tau*(v'*X(row0:, i))*v
+class HouseholderColsInvoker : public ParallelLoopBody
+{
+public:
+    HouseholderColsInvoker( Mat& _X, const double* _v, double _tau, int _row0, int _len )
+        : X(_X), v(_v), tau(_tau), row0(_row0), len(_len) {}
+
+    void operator()( const Range& range ) const
+    {
+        int i, j, i0 = range.start, n = range.size();
+        AutoBuffer<double> _w(n);
+        double* w = _w;
+
+        for( i = 0; i < n; i++ )
+            w[i] = 0;
+        for( j = 0; j < len; j++ )
+        {
+            const double* x = X.ptr<double>(row0 + j) + i0;
+            double vj = v[j];
+            for( i = 0; i < n; i++ )
+                w[i] += vj*x[i];
+        }
+        for( j = 0; j < len; j++ )
+        {
+            double* x = X.ptr<double>(row0 + j) + i0;
+            double t = tau*v[j];
+            for( i = 0; i < n; i++ )
+                x[i] -= t*w[i];
+        }
+    }
+
+private:
+    HouseholderColsInvoker& operator=(const HouseholderColsInvoker&);
+
+    Mat& X;
+    const double* v;
+    double tau;
+    int row0, len;
+};
+
+// the two passes of the symmetric update of A(ofs:, ofs:) by the reflection (v, tau):
+// p = tau*A*v, then A -= v*w' + w*v'
+class SymmetricHouseholderInvoker : public ParallelLoopBody
+{
+public:
+    SymmetricHouseholderInvoker( Mat& _A, const double* _v, double* _p, const double* _w,
+                                 double _tau, int _ofs )
+        : A(_A), v(_v), p(_p), w(_w), tau(_tau), ofs(_ofs) {}
+
+    void operator()( const Range& range ) const
+    {
+        int i, j, n = A.rows - ofs;
+        for( i = range.start; i < range.end; i++ )
+        {
+            double* a = A.ptr<double>(ofs + i) + ofs;
+            if( !w )
+            {
+                double t = 0;
+                for( j = 0; j < n; j++ )
+                    t += a[j]*v[j];
+                p[i] = tau*t;
+            }
+            else
+            {
+                double vi = v[i], wi = w[i];
+                for( j = 0; j < n; j++ )
+                    a[j] -= vi*w[j] + wi*v[j];
+            }
+        }
+    }
+
+private:
+    SymmetricHouseholderInvoker& operator=(const SymmetricHouseholderInvoker&);
+
+    Mat& A;
+    const double* v;
+    double* p;
+    const double* w;
+    double tau;
+    int ofs;
+};
+
+// x_i' = c*x_i + s*x_j, x_j' = c*x_j - s*x_i for the rows i and j
+struct PlaneRotation
+{
+    PlaneRotation( int _i, int _j, double _c, double _s ) : i(_i), j(_j), c(_c), s(_s) {}
+    int i, j;
+    double c, s;
+};
+
+// applies the sequence of the rotations to the rows; the columns are split between the threads
+class PlaneRotationsInvoker : public ParallelLoopBody
+{
+public:
+    PlaneRotationsInvoker( Mat& _X, const std::vector<PlaneRotation>& _rot ) : X(_X), rot(_rot) {}
+
+    void operator()( const Range& range ) const
+    {
+        for( size_t r = 0; r < rot.size(); r++ )
+        {
+            const PlaneRotation& pr = rot[r];
+            double* a = X.ptr<double>(pr.i);
+            double* b = X.ptr<double>(pr.j);
+            for( int k = range.start; k < range.end; k++ )
+            {
+                double t = pr.c*a[k] + pr.s*b[k];
+                b[k] = pr.c*b[k] - pr.s*a[k];
+                a[k] = t;
+            }
+        }
+    }
+
+private:
+    PlaneRotationsInvoker& operator=(const PlaneRotationsInvoker&);
+
+    Mat& X;
+    const std::vector<PlaneRotation>& rot;
+};
+
+static void applyRotations( Mat* X, std::vector<PlaneRotation>& rot )
+{
+    if( X && !rot.empty() )
+        parallelForWork(Range(0, X->cols), PlaneRotationsInvoker(*X, rot), (double)rot.size()*X->cols);
+    rot.clear();
+}
+
+// sorts the values in the descending order together with the rows of X and Y
+static void sortDescending( double* d, int n, Mat* X, Mat* Y=0 )
+{
+    for( int i = 0; i < n - 1; i++ )
+    {
+        int k = i;
+        for( int j = i + 1; j < n; j++ )
+            if( d[j] > d[k] )
+                k = j;
+        if( k != i )
+        {
+            std::swap(d[i], d[k]);
+            if( X )
+                std::swap_ranges(X->ptr<double>(i), X->ptr<double>(i) + X->cols, X->ptr<double>(k));
+            if( Y )
+                std::swap_ranges(Y->ptr<double>(i), Y->ptr<double>(i) + Y->cols, Y->ptr<double>(k));
+        }
+    }
+}
+
+/*
+The implicit QL iterations for the symmetric tridiagonal matrix with the diagonal d and the sub-diagonal e
+(e[n-1] is not used), based on the tql2 procedure of EISPACK (via JAMA, the public domain library).
+The eigenvectors are accumulated in the rows of Zt, if it is not NULL.
+*/
+static void tridiagonalQL( double* d, double* e, int n, Mat* Zt )
+{
+    const double eps = DBL_EPSILON;
+    std::vector<PlaneRotation> rot;
+    double f = 0, tst1 = 0;
+    int i, l, m;
+
+    e[n-1] = 0;
+    for( l = 0; l < n; l++ )
+    {
+        // find the small sub-diagonal element
+        tst1 = std::max(tst1, std::abs(d[l]) + std::abs(e[l]));
+        for( m = l; m < n - 1; m++ )
+            if( std::abs(e[m]) <= eps*tst1 )
+                break;
+
+        // if m == l, d[l] is an eigenvalue, otherwise iterate
+        if( m > l )
+        {
+            for( int iter = 0; iter < 100; iter++ )
+            {
+                // compute the implicit shift
+                double g = d[l];
+                double p = (d[l+1] - g)/(2*e[l]);
+                double r = hypot(p, 1.);
+                if( p < 0 )
+                    r = -r;
+                d[l] = e[l]/(p + r);
+                d[l+1] = e[l]*(p + r);
+                double dl1 = d[l+1], h = g - d[l];
+                for( i = l + 2; i < n; i++ )
+                    d[i] -= h;
+                f += h;
+
+                // implicit QL transformation
+                p = d[m];
+                double c = 1, c2 = c, c3 = c, el1 = e[l+1], s = 0, s2 = 0;
+                for( i = m - 1; i >= l; i-- )
+                {
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c*e[i];
+                    h = c*p;
+                    r = hypot(p, e[i]);
+                    e[i+1] = s*r;
+                    s = e[i]/r;
+                    c = p/r;
+                    p = c*d[i] - s*g;
+                    d[i+1] = h + s*(c*g + s*d[i]);
+                    if( Zt )
+                        rot.push_back(PlaneRotation(i + 1, i, c, s));
+                }
+                p = -s*s2*c3*el1*e[l]/dl1;
+                e[l] = s*p;
+                d[l] = c*p;
+                applyRotations(Zt, rot);
+
+                if( std::abs(e[l]) <= eps*tst1 )
+                    break;
+            }
+        }
+        d[l] += f;
+        e[l] = 0;
+    }
+}
+
+/*
+The implicit QR iterations for the upper bidiagonal matrix with the diagonal s and the super-diagonal e,
+based on the dsvdc procedure of LINPACK (via JAMA). The left and the right singular vectors are accumulated
+in the rows of Ut and Vt, if they are not NULL. The singular values are made non-negative.
+*/
+static void bidiagonalQR( double* s, double* e, int n, Mat* Ut, Mat* Vt )
+{
+    const double eps = DBL_EPSILON, tiny = DBL_MIN;
+    std::vector<PlaneRotation> urot, vrot;
+    int p = n, j, k, kase, iter = 0, maxIter = 75*n;
+
+    e[n-1] = 0;
+    while( p > 0 && iter < maxIter )
+    {
+        // inspect for the negligible elements in the s and e arrays
+        for( k = p - 2; k >= 0; k-- )
+            if( std::abs(e[k]) <= tiny + eps*(std::abs(s[k]) + std::abs(s[k+1])) )
+            {
+                e[k] = 0;
+                break;
+            }
+
+        if( k == p - 2 )
+            kase = 4;
+        else
+        {
+            int ks;
+            for( ks = p - 1; ks > k; ks-- )
+            {
+                double t = (ks != p ? std::abs(e[ks]) : 0.) + (ks != k + 1 ? std::abs(e[ks-1]) : 0.);
+                if( std::abs(s[ks]) <= tiny + eps*t )
+                {
+                    s[ks] = 0;
+                    break;
+                }
+            }
+            if( ks == k )
+                kase = 3;
+            else if( ks == p - 1 )
+                kase = 1;
+            else
+            {
+                kase = 2;
+                k = ks;
+            }
+        }
+        k++;
+
+        if( kase == 1 )
+        {
+            // deflate the negligible s[p-1]
+            double f = e[p-2];
+            e[p-2] = 0;
+            for( j = p - 2; j >= k; j-- )
+            {
+                double t = hypot(s[j], f), cs = s[j]/t, sn = f/t;
+                s[j] = t;
+                if( j != k )
+                {
+                    f = -sn*e[j-1];
+                    e[j-1] = cs*e[j-1];
+                }
+                if( Vt )
+                    vrot.push_back(PlaneRotation(j, p - 1, cs, sn));
+            }
+        }
+        else if( kase == 2 )
+        {
+            // split at the negligible s[k-1]
+            double f = e[k-1];
+            e[k-1] = 0;
+            for( j = k; j < p; j++ )
+            {
+                double t = hypot(s[j], f), cs = s[j]/t, sn = f/t;
+                s[j] = t;
+                f = -sn*e[j];
+                e[j] = cs*e[j];
+                if( Ut )
+                    urot.push_back(PlaneRotation(j, k - 1, cs, sn));
+            }
+        }
+        else if( kase == 3 )
+        {
+            // calculate the shift
+            double scale = std::max(std::max(std::max(std::max(std::abs(s[p-1]), std::abs(s[p-2])),
+                                    std::abs(e[p-2])), std::abs(s[k])), std::abs(e[k]));
+            double sp = s[p-1]/scale, spm1 = s[p-2]/scale, epm1 = e[p-2]/scale;
+            double sk = s[k]/scale, ek = e[k]/scale;
+            double b = ((spm1 + sp)*(spm1 - sp) + epm1*epm1)/2, c = (sp*epm1)*(sp*epm1);
+            double shift = 0;
+            if( b != 0 || c != 0 )
+            {
+                shift = std::sqrt(b*b + c);
+                if( b < 0 )
+                    shift = -shift;
+                shift = c/(b + shift);
+            }
+            double f = (sk + sp)*(sk - sp) + shift, g = sk*ek;
+
+            // chase zeros
+            for( j = k; j < p - 1; j++ )
+            {
+                double t = hypot(f, g), cs = f/t, sn = g/t;
+                if( j != k )
+                    e[j-1] = t;
+                f = cs*s[j] + sn*e[j];
+                e[j] = cs*e[j] - sn*s[j];
+                g = sn*s[j+1];
+                s[j+1] = cs*s[j+1];
+                if( Vt )
+                    vrot.push_back(PlaneRotation(j, j + 1, cs, sn));
+
+                t = hypot(f, g); cs = f/t; sn = g/t;
+                s[j] = t;
+                f = cs*e[j] + sn*s[j+1];
+                s[j+1] = -sn*e[j] + cs*s[j+1];
+                g = sn*e[j+1];
+                e[j+1] = cs*e[j+1];
+                if( Ut )
+                    urot.push_back(PlaneRotation(j, j + 1, cs, sn));
+            }
+            e[p-2] = f;
+            iter++;
+        }
+        else
+        {
+            // convergence
+            p--;
+        }
+
+        applyRotations(Ut, urot);
+        applyRotations(Vt, vrot);
+    }
+
+    for( k = 0; k < n; k++ )
+        if( s[k] < 0 )
+        {
+            s[k] = -s[k];
+            if( Vt )
+            {
+                double* v = Vt->ptr<double>(k);
+                for( j = 0; j < Vt->cols; j++ )
+                    v[j] = -v[j];
+            }
+        }
+
+    sortDescending(s, n, Ut, Vt);
+}
+
+/*
+The eigenvalues (in the descending order) and, if V is not NULL, the eigenvectors (in the rows of V)
+of the symmetric matrix A, which is destroyed
+*/
+static void LargeEigen( Mat& A, double* W, Mat* V )
+{
+    int i, k, n = A.rows;
+    std::vector<double> _e(n), _tau(n), _p(n);
+    double *d = W, *e = &_e[0], *tau = &_tau[0], *p = &_p[0];
+
+    // A = Q*T*Q', Q = H(0)*...*H(n-3), the Householder vectors are stored in the rows of A
+    for( k = 0; k < n - 2; k++ )
+    {
+        int nk = n - k - 1;
+        double* v = A.ptr<double>(k) + k + 1;
+        d[k] = A.at<double>(k, k);
+        e[k] = makeHouseholder(v, nk, tau[k]);
+        if( tau[k] == 0 )
+            continue;
+
+        parallelForWork(Range(0, nk), SymmetricHouseholderInvoker(A, v, p, 0, tau[k], k + 1), (double)nk*nk);
+        double K = 0;
+        for( i = 0; i < nk; i++ )
+            K += p[i]*v[i];
+        K *= tau[k]*0.5;
+        for( i = 0; i < nk; i++ )
+            p[i] -= K*v[i];
+        parallelForWork(Range(0, nk), SymmetricHouseholderInvoker(A, v, 0, p, tau[k], k + 1), (double)nk*nk);
+    }
+    if( n > 1 )
+        e[n-2] = A.at<double>(n-1, n-2);
+    for( k = std::max(n - 2, 0); k < n; k++ )
+        d[k] = A.at<double>(k, k);
+
+    Mat Qt, Zt;
+    if( V )
+    {
+        // the rows of Qt are the columns of Q
+        Qt = Mat::eye(n, n, CV_64F);
+        for( k = n - 3; k >= 0; k-- )
+            if( tau[k] != 0 )
+                parallelForWork(Range(k + 1, n),
+                                HouseholderRowsInvoker(Qt, A.ptr<double>(k) + k + 1, tau[k], k + 1, n - k - 1),
+                                (double)(n - k - 1)*(n - k - 1));
+        Zt = Mat::eye(n, n, CV_64F);
+    }
+
+    tridiagonalQL(d, e, n, V ? &Zt : 0);
+    sortDescending(d, n, V ? &Zt : 0);
+
+    if( V )
+        gemm(Zt, Qt, 1, noArray(), 0, *V);
+}
+
+/*
+SVD of A (m x n, m >= n) stored as At (the columns of A are the rows of At). The singular values are
+returned in W in the descending order; if Vt is not NULL, At is replaced with the left singular vectors
+and Vt (n x n) with the right ones.
+*/
+static void LargeSVD( Mat& At, double* W, Mat* Vt )
+{
+    int j, k, m = At.cols, n = At.rows;
+    std::vector<double> _e(n), _tauL(n), _tauR(n), _u(n);
+    double *d = W, *e = &_e[0], *tauL = &_tauL[0], *tauR = &_tauR[0], *u = &_u[0];
+
+    // A = QL*B*QR', B is upper bidiagonal; the left Householder vectors are stored in the rows of At
+    // starting from the diagonal, the right ones in the columns of At below the diagonal
+    for( k = 0; k < n; k++ )
+    {
+        double* x = At.ptr<double>(k) + k;
+        d[k] = makeHouseholder(x, m - k, tauL[k]);
+        if( tauL[k] != 0 && k < n - 1 )
+            parallelForWork(Range(k + 1, n), HouseholderRowsInvoker(At, x, tauL[k], k, m - k),
+                            (double)(n - k - 1)*(m - k));
+        tauR[k] = 0;
+        if( k >= n - 1 )
+            continue;
+
+        int nk = n - k - 1;
+        for( j = 0; j < nk; j++ )
+            u[j] = At.at<double>(k + 1 + j, k);
+        if( nk == 1 )
+        {
+            e[k] = u[0];
+            continue;
+        }
+        e[k] = makeHouseholder(u, nk, tauR[k]);
+        for( j = 0; j < nk; j++ )
+            At.at<double>(k + 1 + j, k) = u[j];
+        if( tauR[k] != 0 )
+            parallelForWork(Range(k + 1, m), HouseholderColsInvoker(At, u, tauR[k], k + 1, nk),
+                            (double)nk*(m - k - 1));
+    }
+
+    Mat QLt, QRt, Ubt, Vbt;
+    if( Vt )
+    {
+        // the rows of QLt and QRt are the columns of QL and QR
+        QLt = Mat::zeros(n, m, CV_64F);
+        for( k = 0; k < n; k++ )
+            QLt.at<double>(k, k) = 1;
+        for( k = n - 1; k >= 0; k-- )
+            if( tauL[k] != 0 )
+                parallelForWork(Range(k, n), HouseholderRowsInvoker(QLt, At.ptr<double>(k) + k, tauL[k], k, m - k),
+                                (double)(n - k)*(m - k));
+
+        QRt = Mat::eye(n, n, CV_64F);
+        for( k = n - 3; k >= 0; k-- )
+        {
+            if( tauR[k] == 0 )
+                continue;
+            int nk = n - k - 1;
+            for( j = 0; j < nk; j++ )
+                u[j] = At.at<double>(k + 1 + j, k);
+            parallelForWork(Range(k + 1, n), HouseholderRowsInvoker(QRt, u, tauR[k], k + 1, nk), (double)nk*nk);
+        }
+        Ubt = Mat::eye(n, n, CV_64F);
+        Vbt = Mat::eye(n, n, CV_64F);
+    }
+
+    bidiagonalQR(d, e, n, Vt ? &Ubt : 0, Vt ? &Vbt : 0);
+
+    if( Vt )
+    {
+        gemm(Ubt, QLt, 1, noArray(), 0, At);
+        gemm(Vbt, QRt, 1, noArray(), 0, *Vt);
+    }
+}
+
 }
 
 /****************************************************************************************\
@@ -791,6 +1368,8 @@ double cv::determinant( InputArray _mat )
 
 double cv::invert( InputArray _src, OutputArray _dst, int method )
 {
+    CV_TRACE_FUNCTION();
+
     bool result = false;
     Mat src = _src.getMat();
     int type = src.type();
@@ -1049,6 +1628,8 @@ double cv::invert( InputArray _src, OutputArray _dst, int method )
 
 bool cv::solve( InputArray _src, InputArray _src2arg, OutputArray _dst, int method )
 {
+    CV_TRACE_FUNCTION();
+
     bool result = true;
     Mat src = _src.getMat(), _src2 = _src2arg.getMat();
     int type = src.type();
@@ -1325,6 +1906,8 @@ bool cv::solve( InputArray _src, InputArray _src2arg, OutputArray _dst, int meth
 
 bool cv::eigen( InputArray _src, OutputArray _evals, OutputArray _evects )
 {
+    CV_TRACE_FUNCTION();
+
     Mat src = _src.getMat();
     int type = src.type();
     int n = src.rows;
@@ -1339,6 +1922,18 @@ bool cv::eigen( InputArray _src, OutputArray _evals, OutputArray _evects )
         v = _evects.getMat();
     }
 
+    if( n >= EIGEN_LARGE_SIZE )
+    {
+        Mat a, vd, w(n, 1, CV_64F);
+        src.convertTo(a, CV_64F);
+        completeSymm(a);
+        LargeEigen(a, w.ptr<double>(), v.data ? &vd : 0);
+        if( v.data )
+            vd.convertTo(v, type);
+        w.convertTo(_evals, type);
+        return true;
+    }
+
     size_t elemSize = src.elemSize(), astep = alignSize(n*elemSize, 16);
     AutoBuffer<uchar> buf(n*astep + n*5*elemSize + 32);
     uchar* ptr = alignPtr((uchar*)buf, 16);
@@ -1400,7 +1995,19 @@ static void _SVDcompute( InputArray _aarr, OutputArray _w,
     else
         src.copyTo(temp_a);
 
-    if( type == CV_32F )
+    if( useLargeSVD(m, n) && (!compute_uv || urows == n) )
+    {
+        Mat a, vt, w(n, 1, CV_64F);
+        temp_a.convertTo(a, CV_64F);
+        LargeSVD(a, w.ptr<double>(), compute_uv ? &vt : 0);
+        w.convertTo(temp_w, type);
+        if( compute_uv )
+        {
+            a.convertTo(temp_a, type);
+            vt.convertTo(temp_v, type);
+        }
+    }
+    else if( type == CV_32F )
     {
         JacobiSVD(temp_a.ptr<float>(), temp_u.step, temp_w.ptr<float>(),
               temp_v.ptr<float>(), temp_v.step, m, n, compute_uv ? urows : 0);
@@ -1494,6 +2101,90 @@ void cv::SVBackSubst(InputArray w, InputArray u, InputArray vt, InputArray rhs,
     SVD::backSubst(w, u, vt, rhs, dst);
 }
 
+namespace cv
+{
+
+// orthonormalizes the rows of Q by the modified Gram-Schmidt process (two passes per row);
+// the rows that are linearly dependent on the previous ones are replaced with the random vectors
+static void orthonormalizeRows( Mat& Q, RNG& rng )
+{
+    for( int i = 0; i < Q.rows; i++ )
+    {
+        Mat qi = Q.row(i);
+        for( int attempt = 0; attempt < 5; attempt++ )
+        {
+            double n0 = norm(qi);
+            for( int pass = 0; pass < 2; pass++ )
+                for( int j = 0; j < i; j++ )
+                {
+                    Mat qj = Q.row(j);
+                    scaleAdd(qj, -qj.dot(qi), qi, qi);
+                }
+            double n1 = norm(qi);
+            if( n1 > n0*1e-6 && n1 > DBL_MIN )
+            {
+                qi *= 1./n1;
+                break;
+            }
+            rng.fill(qi, RNG::NORMAL, 0, 1);
+        }
+    }
+}
+
+}
+
+void cv::SVDecompTruncated( InputArray _src, int k, OutputArray _w, OutputArray _u, OutputArray _vt,
+                            int oversampling, int powerIters )
+{
+    CV_TRACE_FUNCTION();
+
+    Mat A = _src.getMat();
+    int type = A.type(), m = A.rows, n = A.cols, mn = std::min(m, n);
+
+    CV_Assert( type == CV_32F || type == CV_64F );
+    CV_Assert( 0 < k && k <= mn && oversampling >= 0 && powerIters >= 0 );
+
+    int l = std::min(k + oversampling, mn);
+    Mat w, u, vt;
+
+    if( l == mn )
+    {
+        // the sketch would be as large as the matrix itself
+        SVD::compute(A, w, u, vt);
+        if( _u.needed() )
+            u = u.colRange(0, k);
+    }
+    else
+    {
+        // the rows of Qt form the orthonormal basis of the range of A*Omega, Omega is n x l Gaussian matrix;
+        // the power iterations Qt <- orth(orth(Qt*A)*A') sharpen it when the spectrum decays slowly
+        RNG rng(0x12345678);
+        Mat omegaT(l, n, type), Qt, Zt, B, ub;
+        rng.fill(omegaT, RNG::NORMAL, 0, 1);
+        gemm(omegaT, A, 1, noArray(), 0, Qt, GEMM_2_T);
+        orthonormalizeRows(Qt, rng);
+        for( int i = 0; i < powerIters; i++ )
+        {
+            gemm(Qt, A, 1, noArray(), 0, Zt);
+            orthonormalizeRows(Zt, rng);
+            gemm(Zt, A, 1, noArray(), 0, Qt, GEMM_2_T);
+            orthonormalizeRows(Qt, rng);
+        }
+
+        // A ~ Q*B, B = Q'*A is l x n; B = Ub*W*Vt -> A ~ (Q*Ub)*W*Vt
+        gemm(Qt, A, 1, noArray(), 0, B);
+        SVD::compute(B, w, ub, vt);
+        if( _u.needed() )
+            gemm(Qt, ub.colRange(0, k), 1, noArray(), 0, u, GEMM_1_T);
+    }
+
+    w.rowRange(0, k).copyTo(_w);
+    if( _u.needed() )
+        u.copyTo(_u);
+    if( _vt.needed() )
+        vt.rowRange(0, k).copyTo(_vt);
+}
+
 
 CV_IMPL double
 cvDet( const CvArr* arr )
@@ -44,6 +44,8 @@
 #include "precomp.hpp"
 #include "opencl_kernels_core.hpp"
 #include "opencv2/core/opencl/runtime/opencl_clamdblas.hpp"
+#include "matmul.simd.hpp"
+#include "matmul.simd_declarations.hpp"
 
 namespace cv
 {
@@ -692,6 +694,86 @@ static void GEMMStore_64fc( const Complexd* c_data, size_t c_step,
     GEMMStore(c_data, c_step, d_buf, d_buf_step, d_data, d_step, d_size, alpha, beta, flags);
 }
 
+// The large real matrices are multiplied by the packed-panel kernel from matmul.simd.hpp.
+// The output is split into the tiles of GEMM_TILE_M x GEMM_TILE_N elements which are computed
+// independently, so the result does not depend on the number of threads.
+enum { GEMM_TILE_M = 64, GEMM_TILE_N = 256 };
+
+template<typename T> class GEMMTileInvoker : public ParallelLoopBody
+{
+public:
+    GEMMTileInvoker( const Mat& _A, const Mat& _B, const Mat& _C, Mat& _D,
+                     double _alpha, double _beta, int _len, int flags )
+        : A(_A), B(_B), C(_C), D(_D), alpha(_alpha), beta(_beta), len(_len)
+    {
+        a_step0 = A.step/sizeof(T), a_step1 = 1;
+        b_step0 = B.step/sizeof(T), b_step1 = 1;
+        c_step0 = C.step/sizeof(T), c_step1 = 1;
+        if( flags & GEMM_1_T )
+            std::swap(a_step0, a_step1);
+        if( flags & GEMM_2_T )
+            std::swap(b_step0, b_step1);
+        if( flags & GEMM_3_T )
+            std::swap(c_step0, c_step1);
+        ntilesX = (D.cols + GEMM_TILE_N - 1)/GEMM_TILE_N;
+    }
+
+    void operator()( const Range& range ) const
+    {
+        for( int t = range.start; t < range.end; t++ )
+        {
+            int i = (t / ntilesX)*GEMM_TILE_M, j = (t % ntilesX)*GEMM_TILE_N;
+            int m = std::min((int)GEMM_TILE_M, D.rows - i), n = std::min((int)GEMM_TILE_N, D.cols - j);
+            const T* c = C.data ? (const T*)C.data + c_step0*i + c_step1*j : 0;
+
+            CV_CPU_DISPATCH(gemmTile, ((const T*)A.data + a_step0*i, a_step0, a_step1,
+                                       (const T*)B.data + b_step1*j, b_step0, b_step1,
+                                       c, c_step0, c_step1, D.ptr<T>(i) + j, D.step/sizeof(T),
+                                       m, n, len, alpha, beta));
+        }
+    }
+
+    int tiles() const { return ntilesX*((D.rows + GEMM_TILE_M - 1)/GEMM_TILE_M); }
+
+protected:
+    const Mat& A;
+    const Mat& B;
+    const Mat& C;
+    Mat& D;
+    double alpha, beta;
+    int len, ntilesX;
+    size_t a_step0, a_step1, b_step0, b_step1, c_step0, c_step1;
+};
+
+// the packed kernel pays off when every dimension of the product is big enough to fill the micro-kernel
+static bool usePackedGEMM( int type, Size d_size, int len )
+{
+    return (type == CV_32FC1 || type == CV_64FC1) &&
+        d_size.width >= 8 && d_size.height >= 8 && len >= 8 &&
+        (double)d_size.width*d_size.height*len >= 32*32*32;
+}
+
+static void packedGEMM( const Mat& A, const Mat& B, double alpha, const Mat& C, double beta,
+                        Mat& D, int len, int flags )
+{
+    Mat tmat, &dst = D.data == A.data || D.data == B.data ? tmat : D;
+    dst.create(D.size(), D.type());
+
+    if( D.depth() == CV_32F )
+    {
+        GEMMTileInvoker<float> invoker(A, B, C, dst, alpha, beta, len, flags);
+        parallel_for_(Range(0, invoker.tiles()), invoker);
+    }
+    else
+    {
+        GEMMTileInvoker<double> invoker(A, B, C, dst, alpha, beta, len, flags);
+        parallel_for_(Range(0, invoker.tiles()), invoker);
+    }
+
+    if( &dst != &D )
+        dst.copyTo(D);
+}
+
 #ifdef HAVE_CLAMDBLAS
 
 static bool ocl_gemm_amdblas( InputArray matA, InputArray matB, double alpha,
@@ -869,6 +951,8 @@ static bool ocl_gemm( InputArray matA, InputArray matB, double alpha,
 void cv::gemm( InputArray matA, InputArray matB, double alpha,
            InputArray matC, double beta, OutputArray _matD, int flags )
 {
+    CV_TRACE_FUNCTION();
+
 #ifdef HAVE_CLAMDBLAS
     CV_OCL_RUN(ocl::haveAmdBlas() && matA.dims() <= 2 && matB.dims() <= 2 && matC.dims() <= 2 && _matD.isUMat() &&
         matA.cols() > 20 && matA.rows() > 20 && matB.cols() > 20, // since it works incorrect for small sizes
@@ -1189,6 +1273,12 @@ void cv::gemm( InputArray matA, InputArray matB, double alpha,
         }
     }
 
+    if( usePackedGEMM(type, d_size, len) )
+    {
+        packedGEMM(A, B, alpha, C, beta, D, len, flags);
+        return;
+    }
+
     {
     size_t b_step = B.step;
     GEMMSingleMulFunc singleMulFunc;
@@ -1942,6 +2032,8 @@ static TransformFunc getDiagTransformFunc(int depth)
 
 void cv::transform( InputArray _src, OutputArray _dst, InputArray _mtx )
 {
+    CV_TRACE_FUNCTION();
+
     Mat src = _src.getMat(), m = _mtx.getMat();
     int depth = src.depth(), scn = src.channels(), dcn = m.rows;
     CV_Assert( scn == m.cols || scn + 1 == m.cols );
@@ -2120,6 +2212,8 @@ perspectiveTransform_64f(const double* src, double* dst, const double* m, int le
 
 void cv::perspectiveTransform( InputArray _src, OutputArray _dst, InputArray _mtx )
 {
+    CV_TRACE_FUNCTION();
+
     Mat src = _src.getMat(), m = _mtx.getMat();
     int depth = src.depth(), scn = src.channels(), dcn = m.rows-1;
     CV_Assert( scn + 1 == m.cols );
@@ -2314,6 +2408,8 @@ static bool ocl_scaleAdd( InputArray _src1, double alpha, InputArray _src2, Outp
 
 void cv::scaleAdd( InputArray _src1, double alpha, InputArray _src2, OutputArray _dst )
 {
+    CV_TRACE_FUNCTION();
+
     int type = _src1.type(), depth = CV_MAT_DEPTH(type), cn = CV_MAT_CN(type);
     CV_Assert( type == _src2.type() );
 
@@ -0,0 +1,215 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+// No include guard: the kernels are compiled once per dispatched instruction set,
+// see ocv_add_dispatched_file() in cmake/OpenCVCompilerOptimizations.cmake.
+// The packed-panel GEMM kernel: the block of op(A) is packed into the row slivers of GEMM_MR rows
+// and the block of op(B) into the column slivers of 2 vectors, the micro-kernel keeps the
+// GEMM_MR x (2 vectors) block of the product in registers. The float matrices are converted to
+// double while packing. Every element of the product is summed in the same order with the separate
+// multiplications and additions whatever the vector width is, so all the compiled copies give
+// bit-exact results.
+
+#include "opencv2/core/utility.hpp"
+#include "opencv2/core/hal/intrin.hpp"
+
+namespace cv {
+CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
+
+// D = alpha*op(A)*op(B) + beta*op(C), where op(A) is m x len, op(B) is len x n, D is m x n.
+// The element (i, k) of op(A) is a[a_step0*i + a_step1*k], the steps are in elements,
+// op(B) and op(C) are addressed the same way. c is NULL if there is no C.
+void gemmTile(const float* a, size_t a_step0, size_t a_step1,
+              const float* b, size_t b_step0, size_t b_step1,
+              const float* c, size_t c_step0, size_t c_step1,
+              float* d, size_t d_step, int m, int n, int len, double alpha, double beta);
+void gemmTile(const double* a, size_t a_step0, size_t a_step1,
+              const double* b, size_t b_step0, size_t b_step1,
+              const double* c, size_t c_step0, size_t c_step1,
+              double* d, size_t d_step, int m, int n, int len, double alpha, double beta);
+
+#ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+enum { GEMM_MR = 4, GEMM_KC = 256 };
+
+template<typename T> struct GemmKernel
+{
+    enum { NR = 4 };
+
+    // t[GEMM_MR][NR] = pa*pb, pa is the packed row sliver, pb is the packed column sliver
+    static void run(const T* pa, const T* pb, int kc, T* t)
+    {
+        for( int i = 0; i < GEMM_MR*NR; i++ )
+            t[i] = 0;
+        for( int k = 0; k < kc; k++, pa += GEMM_MR, pb += NR )
+            for( int i = 0; i < GEMM_MR; i++ )
+            {
+                T ai = pa[i];
+                for( int j = 0; j < NR; j++ )
+                    t[i*NR + j] += ai*pb[j];
+            }
+    }
+};
+
+#if CV_SIMD
+
+template<typename T, typename VT> struct GemmKernelSIMD
+{
+    enum { NR = VT::nlanes*2 };
+
+    static void run(const T* pa, const T* pb, int kc, T* t)
+    {
+        const int VL = VT::nlanes;
+        VT z = v_setzero_(pa[0]);
+        VT t00 = z, t01 = z, t10 = z, t11 = z, t20 = z, t21 = z, t30 = z, t31 = z;
+
+        // no v_muladd(), it may be a fused operation with the different rounding
+        for( int k = 0; k < kc; k++, pa += GEMM_MR, pb += NR )
+        {
+            VT b0 = vx_load(pb), b1 = vx_load(pb + VL), a;
+            a = v_setall_(pa[0]); t00 += a*b0; t01 += a*b1;
+            a = v_setall_(pa[1]); t10 += a*b0; t11 += a*b1;
+            a = v_setall_(pa[2]); t20 += a*b0; t21 += a*b1;
+            a = v_setall_(pa[3]); t30 += a*b0; t31 += a*b1;
+        }
+
+        v_store(t, t00); v_store(t + VL, t01); t += NR;
+        v_store(t, t10); v_store(t + VL, t11); t += NR;
+        v_store(t, t20); v_store(t + VL, t21); t += NR;
+        v_store(t, t30); v_store(t + VL, t31);
+    }
+
+#if CV_SIMD_64F
+    static VT v_setzero_(double) { return vx_setzero_f64(); }
+    static VT v_setall_(double v) { return vx_setall_f64(v); }
+#endif
+};
+
+#if CV_SIMD_64F
+template<> struct GemmKernel<double> : GemmKernelSIMD<double, v_float64> {};
+#endif
+
+#endif
+
+// packs the kc columns of m rows of op(A) into the slivers of GEMM_MR rows, the missing rows are zero
+template<typename T, typename WT> static void
+gemmPackA( const T* a, size_t step0, size_t step1, int m, int kc, WT* buf )
+{
+    for( int i = 0; i < m; i += GEMM_MR, buf += GEMM_MR*kc )
+    {
+        const T* src = a + step0*i;
+        int r, mr = std::min(m - i, (int)GEMM_MR);
+        for( int k = 0; k < kc; k++ )
+        {
+            for( r = 0; r < mr; r++ )
+                buf[k*GEMM_MR + r] = src[step0*r + step1*k];
+            for( ; r < GEMM_MR; r++ )
+                buf[k*GEMM_MR + r] = 0;
+        }
+    }
+}
+
+// packs the n columns of kc rows of op(B) into the slivers of NR columns, the missing columns are zero
+template<typename T, typename WT, int NR> static void
+gemmPackB( const T* b, size_t step0, size_t step1, int n, int kc, WT* buf )
+{
+    for( int j = 0; j < n; j += NR, buf += NR*kc )
+    {
+        const T* src = b + step1*j;
+        int c, nr = std::min(n - j, NR);
+        for( int k = 0; k < kc; k++ )
+        {
+            const T* row = src + step0*k;
+            WT* dst = buf + k*NR;
+            if( step1 == 1 )
+                for( c = 0; c < nr; c++ )
+                    dst[c] = row[c];
+            else
+                for( c = 0; c < nr; c++ )
+                    dst[c] = row[step1*c];
+            for( ; c < NR; c++ )
+                dst[c] = 0;
+        }
+    }
+}
+
+// the products are accumulated in double, like in the non-packed GEMM functions
+template<typename T, typename WT> static void
+gemmTile_( const T* a, size_t a_step0, size_t a_step1,
+           const T* b, size_t b_step0, size_t b_step1,
+           const T* c, size_t c_step0, size_t c_step1,
+           T* d, size_t d_step, int m, int n, int len, WT alpha, WT beta )
+{
+    const int NR = GemmKernel<WT>::NR;
+    int kc0 = std::min(len, (int)GEMM_KC);
+    int m1 = (m + GEMM_MR - 1)/GEMM_MR*GEMM_MR, n1 = (n + NR - 1)/NR*NR;
+    AutoBuffer<WT> _buf((size_t)(m1 + n1)*kc0 + (size_t)m1*n1 + GEMM_MR*NR + CV_SIMD_WIDTH/sizeof(WT));
+    WT* pa = alignPtr((WT*)_buf, CV_SIMD_WIDTH);
+    WT* pb = pa + (size_t)m1*kc0;
+    WT* acc = pb + (size_t)n1*kc0;
+    WT* t = acc + (size_t)m1*n1;
+    int i, j, r, x;
+
+    for( int k = 0; k < len; k += kc0 )
+    {
+        int kc = std::min(len - k, kc0);
+        gemmPackA(a + a_step1*k, a_step0, a_step1, m, kc, pa);
+        gemmPackB<T, WT, NR>(b + b_step0*k, b_step0, b_step1, n, kc, pb);
+
+        for( j = 0; j < n1; j += NR )
+            for( i = 0; i < m1; i += GEMM_MR )
+            {
+                GemmKernel<WT>::run(pa + (size_t)i*kc, pb + (size_t)j*kc, kc, t);
+                for( r = 0; r < GEMM_MR; r++ )
+                {
+                    WT* arow = acc + (size_t)n1*(i + r) + j;
+                    const WT* trow = t + r*NR;
+                    if( k == 0 )
+                        for( x = 0; x < NR; x++ )
+                            arow[x] = trow[x];
+                    else
+                        for( x = 0; x < NR; x++ )
+                            arow[x] += trow[x];
+                }
+            }
+    }
+
+    for( i = 0; i < m; i++ )
+    {
+        T* drow = d + d_step*i;
+        const WT* arow = acc + (size_t)n1*i;
+        if( c )
+        {
+            const T* crow = c + c_step0*i;
+            for( j = 0; j < n; j++ )
+                drow[j] = (T)(arow[j]*alpha + crow[c_step1*j]*beta);
+        }
+        else
+            for( j = 0; j < n; j++ )
+                drow[j] = (T)(arow[j]*alpha);
+    }
+}
+
+void gemmTile(const float* a, size_t a_step0, size_t a_step1,
+              const float* b, size_t b_step0, size_t b_step1,
+              const float* c, size_t c_step0, size_t c_step1,
+              float* d, size_t d_step, int m, int n, int len, double alpha, double beta)
+{
+    gemmTile_(a, a_step0, a_step1, b, b_step0, b_step1, c, c_step0, c_step1,
+              d, d_step, m, n, len, alpha, beta);
+}
+
+void gemmTile(const double* a, size_t a_step0, size_t a_step1,
+              const double* b, size_t b_step0, size_t b_step1,
+              const double* c, size_t c_step0, size_t c_step1,
+              double* d, size_t d_step, int m, int n, int len, double alpha, double beta)
+{
+    gemmTile_(a, a_step0, a_step1, b, b_step0, b_step1, c, c_step0, c_step1,
+              d, d_step, m, n, len, alpha, beta);
+}
+
+#endif // CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+CV_CPU_OPTIMIZATION_NAMESPACE_END
+}
@@ -208,6 +208,33 @@ static MatOp_Initializer* getGlobalMatOpInitializer()
     CV_SINGLETON_LAZY_INIT(MatOp_Initializer, new MatOp_Initializer())
 }
 
+class MatOp_Fused : public MatOp
+{
+public:
+    MatOp_Fused() {}
+    virtual ~MatOp_Fused() {}
+
+    bool elementWise(const MatExpr& /*expr*/) const { return true; }
+    void assign(const MatExpr& expr, Mat& m, int type=-1) const;
+
+    void roi(const MatExpr& expr, const Range& rowRange, const Range& colRange, MatExpr& res) const;
+    void diag(const MatExpr& expr, int d, MatExpr& res) const;
+
+    void add(const MatExpr& e, const Scalar& s, MatExpr& res) const;
+    void subtract(const Scalar& s, const MatExpr& e, MatExpr& res) const;
+    void multiply(const MatExpr& e, double s, MatExpr& res) const;
+    void divide(double s, const MatExpr& e, MatExpr& res) const;
+    void abs(const MatExpr& e, MatExpr& res) const;
+
+    Size size(const MatExpr& expr) const;
+    int type(const MatExpr& expr) const;
+
+    static bool makeExpr(MatExpr& res, char op, const MatExpr& e1, const MatExpr& e2, double scale=1);
+    static bool makeExpr(MatExpr& res, char op, const MatExpr& e, double alpha, const Scalar& s=Scalar());
+};
+
+static MatOp_Fused g_MatOp_Fused;
+
 static inline bool isIdentity(const MatExpr& e) { return e.op == &g_MatOp_Identity; }
 static inline bool isAddEx(const MatExpr& e) { return e.op == &g_MatOp_AddEx; }
 static inline bool isScaled(const MatExpr& e) { return isAddEx(e) && (!e.b.data || e.beta == 0) && e.s == Scalar(); }
@@ -220,6 +247,15 @@ static inline bool isSolve(const MatExpr& e) { return e.op == &g_MatOp_Solve; }
 static inline bool isGEMM(const MatExpr& e) { return e.op == &g_MatOp_GEMM; }
 static inline bool isMatProd(const MatExpr& e) { return e.op == &g_MatOp_GEMM && (!e.c.data || e.beta == 0); }
 static inline bool isInitializer(const MatExpr& e) { return e.op == getGlobalMatOpInitializer(); }
+static inline bool isFused(const MatExpr& e) { return e.op == &g_MatOp_Fused; }
+
+// checks whether the generic operation would compute the operand into a temporary matrix,
+// the operands folded into the coefficients of the operation are not computed
+static inline bool needsFusion(const MatExpr& e, bool folded)
+{
+    return isFused(e) || (!folded && (isAddEx(e) || isCmp(e) ||
+           (e.op == &g_MatOp_Bin && e.flags != 0 && strchr("*/mMnNa", e.flags) != 0)));
+}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -277,6 +313,13 @@ void MatOp::diag(const MatExpr& expr, int d, MatExpr& e) const
 
 void MatOp::augAssignAdd(const MatExpr& expr, Mat& m) const
 {
+    MatExpr e;
+    if( needsFusion(expr, false) && MatOp_Fused::makeExpr(e, '+', MatExpr(m), expr) )
+    {
+        e.op->assign(e, m);
+        return;
+    }
+
     Mat temp;
     expr.op->assign(expr, temp);
     m += temp;
@@ -285,6 +328,13 @@ void MatOp::augAssignAdd(const MatExpr& expr, Mat& m) const
 
 void MatOp::augAssignSubtract(const MatExpr& expr, Mat& m) const
 {
+    MatExpr e;
+    if( needsFusion(expr, false) && MatOp_Fused::makeExpr(e, '-', MatExpr(m), expr) )
+    {
+        e.op->assign(e, m);
+        return;
+    }
+
     Mat temp;
     expr.op->assign(expr, temp);
     m -= temp;
@@ -335,6 +385,11 @@ void MatOp::add(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const
 {
     if( this == e2.op )
     {
+        if( (needsFusion(e1, isAddEx(e1) && (!e1.b.data || e1.beta == 0)) ||
+             needsFusion(e2, isAddEx(e2) && (!e2.b.data || e2.beta == 0))) &&
+            MatOp_Fused::makeExpr(res, '+', e1, e2) )
+            return;
+
         double alpha = 1, beta = 1;
         Scalar s;
         Mat m1, m2;
@@ -364,6 +419,9 @@ void MatOp::add(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const
 
 void MatOp::add(const MatExpr& expr1, const Scalar& s, MatExpr& res) const
 {
+    if( needsFusion(expr1, false) && MatOp_Fused::makeExpr(res, 's', expr1, 1, s) )
+        return;
+
     Mat m1;
     expr1.op->assign(expr1, m1);
     MatOp_AddEx::makeExpr(res, m1, Mat(), 1, 0, s);
@@ -374,6 +432,11 @@ void MatOp::subtract(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const
 {
     if( this == e2.op )
     {
+        if( (needsFusion(e1, isAddEx(e1) && (!e1.b.data || e1.beta == 0)) ||
+             needsFusion(e2, isAddEx(e2) && (!e2.b.data || e2.beta == 0))) &&
+            MatOp_Fused::makeExpr(res, '-', e1, e2) )
+            return;
+
         double alpha = 1, beta = -1;
         Scalar s;
         Mat m1, m2;
@@ -403,6 +466,9 @@ void MatOp::subtract(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const
 
 void MatOp::subtract(const Scalar& s, const MatExpr& expr, MatExpr& res) const
 {
+    if( needsFusion(expr, false) && MatOp_Fused::makeExpr(res, 's', expr, -1, s) )
+        return;
+
     Mat m;
     expr.op->assign(expr, m);
     MatOp_AddEx::makeExpr(res, m, Mat(), -1, 0, s);
@@ -429,6 +495,10 @@ void MatOp::multiply(const MatExpr& e1, const MatExpr& e2, MatExpr& res, double
         }
         else
         {
+            if( (needsFusion(e1, isScaled(e1)) || needsFusion(e2, isScaled(e2) || isReciprocal(e2))) &&
+                MatOp_Fused::makeExpr(res, '*', e1, e2, scale) )
+                return;
+
             char op = '*';
             if( isScaled(e1) )
             {
@@ -462,6 +532,9 @@ void MatOp::multiply(const MatExpr& e1, const MatExpr& e2, MatExpr& res, double
 
 void MatOp::multiply(const MatExpr& expr, double s, MatExpr& res) const
 {
+    if( needsFusion(expr, false) && MatOp_Fused::makeExpr(res, 's', expr, s) )
+        return;
+
     Mat m;
     expr.op->assign(expr, m);
     MatOp_AddEx::makeExpr(res, m, Mat(), s, 0);
@@ -476,6 +549,10 @@ void MatOp::divide(const MatExpr& e1, const MatExpr& e2, MatExpr& res, double sc
             MatOp_Bin::makeExpr(res, '/', e2.a, e1.a, e1.alpha/e2.alpha);
         else
         {
+            if( (needsFusion(e1, isScaled(e1)) || needsFusion(e2, isScaled(e2) || isReciprocal(e2))) &&
+                MatOp_Fused::makeExpr(res, '/', e1, e2, scale) )
+                return;
+
             Mat m1, m2;
             char op = '/';
 
@@ -510,6 +587,9 @@ void MatOp::divide(const MatExpr& e1, const MatExpr& e2, MatExpr& res, double sc
 
 void MatOp::divide(double s, const MatExpr& expr, MatExpr& res) const
 {
+    if( needsFusion(expr, false) && MatOp_Fused::makeExpr(res, '/', expr, s) )
+        return;
+
     Mat m;
     expr.op->assign(expr, m);
     MatOp_Bin::makeExpr(res, '/', m, Mat(), s);
@@ -518,6 +598,9 @@ void MatOp::divide(double s, const MatExpr& expr, MatExpr& res) const
 
 void MatOp::abs(const MatExpr& expr, MatExpr& res) const
 {
+    if( needsFusion(expr, false) && MatOp_Fused::makeExpr(res, 'a', expr, 1) )
+        return;
+
     Mat m;
     expr.op->assign(expr, m);
     MatOp_Bin::makeExpr(res, 'a', m, Mat());
@@ -1415,6 +1498,1145 @@ inline void MatOp_Cmp::makeExpr(MatExpr& res, int cmpop, const Mat& a, double al
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/* The fused expressions are the chains of element-wise operations, which are evaluated in a single
+   pass over the operands by blocks of elements. The operations are stored as the postfix program
+   of the stack machine (MatExprGraph). Like in MatOp_AddEx and MatOp_Bin, the last operation of
+   the chain is kept in the fields of MatExpr (flags, alpha, beta, s), so that the subsequent scalar
+   operations are folded into its coefficients instead of being added to the program:
+
+   '+' - x*alpha + y*beta + s    's' - x*alpha + s
+   '*' - x*y*alpha               '/' - x*alpha/y           'r' - alpha/x
+   0   - the program computes the final result
+
+   Each operation rounds and saturates its result to the type of the operands and uses the same
+   formula and precision as the function called by the step-by-step computation (e.g. cv::addWeighted()
+   computes in double for 32F, cv::scaleAdd() in float), so the result is the same bit for bit.
+*/
+
+enum
+{
+    FUSED_LOAD = 0,     // push mats[arg]
+    FUSED_ADDW,         // x*alpha + y*beta + s[0], in double if arg != 0
+    FUSED_SCALE,        // x*alpha + s
+    FUSED_MUL,          // x*y*alpha
+    FUSED_DIV,          // y != 0 ? x*alpha/y : 0, the matrices have depth arg
+    FUSED_RECIP,        // x != 0 ? alpha/x : 0, the matrices have depth arg
+    FUSED_MIN,          // min(x, y)
+    FUSED_MAX,          // max(x, y)
+    FUSED_ABSDIFF,      // |x - y|
+    FUSED_MIN_S,        // min(x, s)
+    FUSED_MAX_S,        // max(x, s)
+    FUSED_ABSDIFF_S,    // |x - s|
+    FUSED_CMP,          // x arg y ? 255 : 0, arg is CMP_EQ, CMP_LT ...
+    FUSED_CMP_S,        // x arg alpha ? 255 : 0
+    FUSED_SAT           // saturate_cast to depth arg
+};
+
+static inline bool isBinaryInstr(int op)
+{
+    return op == FUSED_ADDW || op == FUSED_MUL || op == FUSED_DIV || op == FUSED_MIN ||
+           op == FUSED_MAX || op == FUSED_ABSDIFF || op == FUSED_CMP;
+}
+
+static inline bool hasScalarPattern(int op)
+{
+    return op == FUSED_SCALE || op == FUSED_MIN_S || op == FUSED_MAX_S || op == FUSED_ABSDIFF_S;
+}
+
+struct MatExprGraph
+{
+    struct Instr
+    {
+        Instr(int _op, int _arg, double _alpha, double _beta, const Scalar& _s)
+            : op(_op), arg(_arg), alpha(_alpha), beta(_beta), s(_s) {}
+
+        int op, arg;
+        double alpha, beta;
+        Scalar s;
+    };
+
+    MatExprGraph() : type(-1), top(0), stackSize(0) {}
+
+    int load(const Mat& m)
+    {
+        emit(FUSED_LOAD, (int)mats.size());
+        mats.push_back(m);
+        return m.type();
+    }
+
+    void emit(int op, int arg=0, double alpha=1, double beta=0, const Scalar& s=Scalar())
+    {
+        code.push_back(Instr(op, arg, alpha, beta, s));
+        if( op == FUSED_LOAD )
+            stackSize = std::max(stackSize, ++top);
+        else if( isBinaryInstr(op) )
+            top--;
+    }
+
+    std::vector<Mat> mats;              // the operands
+    std::vector<Instr> code;            // the program
+    int type;                           // the type of the values left on the stack
+    int top, stackSize;                 // the current and the maximum number of the values on the stack
+};
+
+// The program of the fused expression is kept in MatExpr::c, a 1x1 matrix whose buffer is
+// the MatExprGraph itself, so it is shared and released together with the expression.
+class MatExprGraphAllocator : public MatAllocator
+{
+public:
+    UMatData* allocate(int dims, const int* sizes, int type,
+                       void* data0, size_t* step, int /*flags*/, UMatUsageFlags /*usageFlags*/) const
+    {
+        CV_Assert( dims == 2 && sizes[0] == 1 && sizes[1] == 1 && type == CV_8U && !data0 );
+        step[0] = step[1] = 1;
+        UMatData* u = new UMatData(this);
+        u->data = u->origdata = (uchar*)new MatExprGraph;
+        u->size = 1;
+        u->flags |= UMatData::HOST_MEMORY;
+        return u;
+    }
+
+    bool allocate(UMatData* u, int /*accessFlags*/, UMatUsageFlags /*usageFlags*/) const
+    {
+        return u != 0;
+    }
+
+    void deallocate(UMatData* u) const
+    {
+        if( !u )
+            return;
+        CV_Assert( u->urefcount == 0 && u->refcount == 0 );
+        delete (MatExprGraph*)u->origdata;
+        delete u;
+    }
+};
+
+static MatExprGraphAllocator g_matExprGraphAllocator;
+
+// creates the empty program or the copy of src
+static Mat createExprGraph(const MatExprGraph* src=0)
+{
+    Mat m;
+    m.allocator = &g_matExprGraphAllocator;
+    m.create(1, 1, CV_8U);
+    CV_Assert( m.u->currAllocator == &g_matExprGraphAllocator );
+    if( src )
+        *(MatExprGraph*)m.data = *src;
+    return m;
+}
+
+static inline MatExprGraph& exprGraph(const Mat& m) { return *(MatExprGraph*)m.data; }
+static inline const MatExprGraph& exprGraph(const MatExpr& e) { return *(const MatExprGraph*)e.c.data; }
+
+static const double fusedMinVals[] = { 0, SCHAR_MIN, 0, SHRT_MIN, INT_MIN };
+static const double fusedMaxVals[] = { UCHAR_MAX, SCHAR_MAX, USHRT_MAX, SHRT_MAX, INT_MAX };
+
+// the scalar as it is used by cv::add(), cv::absdiff() etc. with the matrix of the given depth
+static Scalar roundScalar(const Scalar& s, int depth)
+{
+    Scalar r;
+    for( int i = 0; i < 4; i++ )
+        r[i] = depth < CV_32F ? (double)saturate_cast<int>(s[i]) : depth == CV_32F ? (double)(float)s[i] : s[i];
+    return r;
+}
+
+// the scalar as it is used by cv::min(), cv::max() with the matrix of the given depth
+static double saturateScalar(double v, int depth)
+{
+    switch( depth )
+    {
+    case CV_8U: return saturate_cast<uchar>(v);
+    case CV_8S: return saturate_cast<schar>(v);
+    case CV_16U: return saturate_cast<ushort>(v);
+    case CV_16S: return saturate_cast<short>(v);
+    case CV_32S: return saturate_cast<int>(v);
+    case CV_32F: return (float)v;
+    default: return v;
+    }
+}
+
+// a*alpha + b*beta + s, the same steps as in MatOp_AddEx::assign(). cv::add(), cv::subtract() and
+// cv::scaleAdd() compute in the type of the operands, cv::addWeighted() computes 32F in double.
+static void fuseAddWeighted(MatExprGraph& g, int type, double alpha, double beta, const Scalar& s)
+{
+    int depth = CV_MAT_DEPTH(type);
+    bool real = s.isReal();
+    bool weighted = (real && s[0] != 0) || (alpha != 1 && beta != 1);
+
+    g.emit(FUSED_ADDW, weighted && depth == CV_32F, alpha, beta, Scalar::all(real ? s[0] : 0));
+    g.emit(FUSED_SAT, depth);
+    if( !real )
+    {
+        g.emit(FUSED_SCALE, 0, 1, 0, roundScalar(s, depth));
+        g.emit(FUSED_SAT, depth);
+    }
+}
+
+// a*alpha + s, the same steps as in MatOp_AddEx::assign()
+static void fuseScaleAdd(MatExprGraph& g, int type, double alpha, const Scalar& s)
+{
+    int depth = CV_MAT_DEPTH(type);
+
+    if( s.isReal() && fabs(alpha) != 1 )
+        g.emit(FUSED_SCALE, 0, alpha, 0, Scalar::all(s[0]));
+    else if( fabs(alpha) == 1 )
+        g.emit(FUSED_SCALE, 0, alpha, 0, roundScalar(s, depth));
+    else
+    {
+        g.emit(FUSED_SCALE, 0, alpha, 0, Scalar());
+        g.emit(FUSED_SAT, depth);
+        g.emit(FUSED_SCALE, 0, 1, 0, roundScalar(s, depth));
+    }
+    g.emit(FUSED_SAT, depth);
+}
+
+// appends the program of the fused expression without its last operation
+static int appendProgram(MatExprGraph& g, const MatExprGraph& src)
+{
+    int ofs = (int)g.mats.size();
+    g.mats.insert(g.mats.end(), src.mats.begin(), src.mats.end());
+    for( size_t i = 0; i < src.code.size(); i++ )
+    {
+        const MatExprGraph::Instr& instr = src.code[i];
+        g.emit(instr.op, instr.op == FUSED_LOAD ? instr.arg + ofs : instr.arg,
+               instr.alpha, instr.beta, instr.s);
+    }
+    return src.type;
+}
+
+// appends the last operation of the fused expression
+static void appendRoot(MatExprGraph& g, const MatExpr& e)
+{
+    int type = exprGraph(e).type, depth = CV_MAT_DEPTH(type);
+
+    switch( e.flags )
+    {
+    case '+':
+        fuseAddWeighted(g, type, e.alpha, e.beta, e.s);
+        break;
+    case 's':
+        fuseScaleAdd(g, type, e.alpha, e.s);
+        break;
+    case '*':
+    case '/':
+    case 'r':
+        g.emit(e.flags == '*' ? FUSED_MUL : e.flags == '/' ? FUSED_DIV : FUSED_RECIP, depth, e.alpha);
+        g.emit(FUSED_SAT, depth);
+        break;
+    default:
+        break;
+    }
+}
+
+// appends the program computing the expression and returns the type of the result or -1 if the
+// types of the operands do not match. The operations that can not be fused are computed as before.
+static int fuseExpr(MatExprGraph& g, const MatExpr& e)
+{
+    if( isFused(e) )
+    {
+        int type = appendProgram(g, exprGraph(e));
+        appendRoot(g, e);
+        return type;
+    }
+
+    if( isAddEx(e) )
+    {
+        int type = g.load(e.a);
+        if( e.b.data )
+        {
+            if( g.load(e.b) != type )
+                return -1;
+            fuseAddWeighted(g, type, e.alpha, e.beta, e.s);
+        }
+        else
+            fuseScaleAdd(g, type, e.alpha, e.s);
+        return type;
+    }
+
+    if( e.op == &g_MatOp_Bin && e.flags != 0 && strchr("*/mMnNa", e.flags) != 0 )
+    {
+        int type = g.load(e.a), depth = CV_MAT_DEPTH(type);
+        if( e.b.data && g.load(e.b) != type )
+            return -1;
+
+        switch( e.flags )
+        {
+        case '*':
+            g.emit(FUSED_MUL, depth, e.alpha);
+            break;
+        case '/':
+            g.emit(e.b.data ? FUSED_DIV : FUSED_RECIP, depth, e.alpha);
+            break;
+        case 'm':
+        case 'M':
+            g.emit(e.flags == 'm' ? FUSED_MIN : FUSED_MAX);
+            return type;
+        case 'n':
+        case 'N':
+            g.emit(e.flags == 'n' ? FUSED_MIN_S : FUSED_MAX_S, 0, 1, 0,
+                   Scalar::all(saturateScalar(e.s[0], depth)));
+            return type;
+        default:
+            if( e.b.data )
+                g.emit(FUSED_ABSDIFF);
+            else
+                g.emit(FUSED_ABSDIFF_S, 0, 1, 0, roundScalar(e.s, depth));
+            break;
+        }
+        g.emit(FUSED_SAT, depth);
+        return type;
+    }
+
+    if( isCmp(e) )
+    {
+        int type = g.load(e.a), depth = CV_MAT_DEPTH(type), cn = CV_MAT_CN(type);
+        if( e.b.data )
+        {
+            if( g.load(e.b) != type )
+                return -1;
+            g.emit(FUSED_CMP, e.flags);
+            return CV_8UC(cn);
+        }
+
+        // the comparison with the scalar is adjusted for the integer matrices as in cv::compare()
+        double v = e.alpha;
+        int cmpop = e.flags, result = -1;
+        if( depth < CV_32F )
+        {
+            if( v < fusedMinVals[depth] )
+                result = cmpop == CMP_GT || cmpop == CMP_GE || cmpop == CMP_NE ? 255 : 0;
+            else if( v > fusedMaxVals[depth] )
+                result = cmpop == CMP_LT || cmpop == CMP_LE || cmpop == CMP_NE ? 255 : 0;
+            else
+            {
+                int iv = cvRound(v);
+                if( v != iv )
+                {
+                    if( cmpop == CMP_LT || cmpop == CMP_GE )
+                        iv = cvCeil(v);
+                    else if( cmpop == CMP_LE || cmpop == CMP_GT )
+                        iv = cvFloor(v);
+                    else
+                        result = cmpop == CMP_NE ? 255 : 0;
+                }
+                v = iv;
+            }
+        }
+        else
+            v = saturateScalar(v, depth);
+
+        if( result >= 0 )
+            g.emit(FUSED_SCALE, 0, 0, 0, Scalar::all(result));
+        else
+            g.emit(FUSED_CMP_S, cmpop, v);
+        return CV_8UC(cn);
+    }
+
+    Mat m;
+    e.op->assign(e, m);
+    return g.load(m);
+}
+
+// The expressions on the integer matrices are not fused: they are evaluated in floating-point
+// then, which is slower than the separate passes of the integer kernels.
+static bool isFloatExpr(const MatExpr& e)
+{
+    if( isFused(e) )
+        return true;
+    if( isIdentity(e) || isAddEx(e) || isCmp(e) || e.op == &g_MatOp_Bin )
+        return e.a.depth() >= CV_32F;
+    return CV_MAT_DEPTH(e.type()) >= CV_32F;
+}
+
+static bool makeFusedExpr(MatExpr& res, const Mat& gm, int type, char op,
+                          double alpha=1, double beta=0, const Scalar& s=Scalar())
+{
+    MatExprGraph* g = &exprGraph(gm);
+    if( type < 0 || CV_MAT_CN(type) > 4 )
+        return false;
+
+    const Mat& m0 = g->mats[0];
+    for( size_t i = 0; i < g->mats.size(); i++ )
+    {
+        const Mat& m = g->mats[i];
+        if( m.dims > 2 || m.size() != m0.size() || m.channels() != CV_MAT_CN(type) || m.depth() < CV_32F )
+            return false;
+    }
+
+    g->type = type;
+    res = MatExpr(&g_MatOp_Fused, op, m0, Mat(), gm, alpha, beta, s);
+    return true;
+}
+
+bool MatOp_Fused::makeExpr(MatExpr& res, char op, const MatExpr& e1, const MatExpr& e2, double scale)
+{
+    if( !isFloatExpr(e1) || !isFloatExpr(e2) )
+        return false;
+
+    Mat gm = createExprGraph();
+    MatExprGraph* g = &exprGraph(gm);
+    int type1, type2;
+
+    if( op == '+' || op == '-' )
+    {
+        // the scaled operands are folded into the coefficients as in MatOp::add()
+        double alpha = 1, beta = op == '+' ? 1 : -1;
+        Scalar s;
+
+        bool folded1 = isFused(e1) ? e1.flags == 's' : isAddEx(e1) && (!e1.b.data || e1.beta == 0);
+        if( !folded1 )
+            type1 = fuseExpr(*g, e1);
+        else
+            type1 = isFused(e1) ? appendProgram(*g, exprGraph(e1)) : g->load(e1.a);
+        if( folded1 )
+        {
+            alpha = e1.alpha;
+            s = e1.s;
+        }
+
+        bool folded2 = isFused(e2) ? e2.flags == 's' : isAddEx(e2) && (!e2.b.data || e2.beta == 0);
+        if( !folded2 )
+            type2 = fuseExpr(*g, e2);
+        else
+            type2 = isFused(e2) ? appendProgram(*g, exprGraph(e2)) : g->load(e2.a);
+        if( folded2 )
+        {
+            beta *= e2.alpha;
+            s = op == '+' ? s + e2.s : s - e2.s;
+        }
+
+        return type1 >= 0 && type1 == type2 && makeFusedExpr(res, gm, type1, '+', alpha, beta, s);
+    }
+
+    char rop = op;
+    if( isScaled(e1) )
+    {
+        type1 = g->load(e1.a);
+        scale *= e1.alpha;
+    }
+    else if( isFused(e1) && e1.flags == 's' && e1.s == Scalar() )
+    {
+        type1 = appendProgram(*g, exprGraph(e1));
+        scale *= e1.alpha;
+    }
+    else
+        type1 = fuseExpr(*g, e1);
+
+    bool scaled2 = isScaled(e2) || (isFused(e2) && e2.flags == 's' && e2.s == Scalar());
+    bool reciprocal2 = isReciprocal(e2) || (isFused(e2) && e2.flags == 'r');
+    if( scaled2 || reciprocal2 )
+    {
+        type2 = isFused(e2) ? appendProgram(*g, exprGraph(e2)) : g->load(e2.a);
+        scale = op == '*' ? scale*e2.alpha : scale/e2.alpha;
+        if( reciprocal2 )
+            rop = op == '*' ? '/' : '*';
+    }
+    else
+        type2 = fuseExpr(*g, e2);
+
+    return type1 >= 0 && type1 == type2 && makeFusedExpr(res, gm, type1, rop, scale);
+}
+
+bool MatOp_Fused::makeExpr(MatExpr& res, char op, const MatExpr& e, double alpha, const Scalar& s)
+{
+    if( !isFloatExpr(e) )
+        return false;
+
+    Mat gm = createExprGraph();
+    MatExprGraph* g = &exprGraph(gm);
+    int type = fuseExpr(*g, e);
+
+    if( op == 'a' )
+    {
+        if( type >= 0 )
+        {
+            g->emit(FUSED_ABSDIFF_S);
+            g->emit(FUSED_SAT, CV_MAT_DEPTH(type));
+        }
+        return makeFusedExpr(res, gm, type, 0);
+    }
+    return makeFusedExpr(res, gm, type, op == '/' ? 'r' : 's', alpha, 0, s);
+}
+
+template<typename WT> static void
+fusedAddWeighted(const WT* x, const WT* y, WT* d, int len, WT alpha, WT beta, WT gamma)
+{
+    int i;
+    if( alpha == 1 && gamma == 0 && (beta == 1 || beta == -1) )
+    {
+        if( beta == 1 )
+            for( i = 0; i < len; i++ )
+                d[i] = x[i] + y[i];
+        else
+            for( i = 0; i < len; i++ )
+                d[i] = x[i] - y[i];
+    }
+    else if( gamma == 0 )
+        for( i = 0; i < len; i++ )
+            d[i] = x[i]*alpha + y[i]*beta;
+    else
+        for( i = 0; i < len; i++ )
+            d[i] = x[i]*alpha + y[i]*beta + gamma;
+}
+
+// cv::addWeighted() on 32F and 64F matrices
+template<typename WT> static void
+fusedAddWeighted64f(const WT* x, const WT* y, WT* d, int len, double alpha, double beta, double gamma)
+{
+    for( int i = 0; i < len; i++ )
+        d[i] = (WT)(x[i]*alpha + y[i]*beta + gamma);
+}
+
+template<typename WT> static void
+fusedScale(const WT* x, const WT* s, WT* d, int len, WT alpha)
+{
+    for( int i = 0; i < len; i++ )
+        d[i] = x[i]*alpha + s[i];
+}
+
+template<typename WT> static void
+fusedMul(const WT* x, const WT* y, WT* d, int len, WT alpha)
+{
+    int i;
+    if( alpha == 1 )
+        for( i = 0; i < len; i++ )
+            d[i] = x[i]*y[i];
+    else
+        for( i = 0; i < len; i++ )
+            d[i] = x[i]*y[i]*alpha;
+}
+
+template<typename WT> static void
+fusedMin(const WT* x, const WT* y, WT* d, int len)
+{
+    for( int i = 0; i < len; i++ )
+        d[i] = std::min(x[i], y[i]);
+}
+
+template<typename WT> static void
+fusedMax(const WT* x, const WT* y, WT* d, int len)
+{
+    for( int i = 0; i < len; i++ )
+        d[i] = std::max(x[i], y[i]);
+}
+
+template<typename WT> static void
+fusedAbsDiff(const WT* x, const WT* y, WT* d, int len)
+{
+    for( int i = 0; i < len; i++ )
+        d[i] = std::abs(x[i] - y[i]);
+}
+
+#if CV_SIMD
+
+static void fusedAddWeighted(const float* x, const float* y, float* d, int len, float alpha, float beta, float gamma)
+{
+    int i = 0;
+    if( alpha == 1 && gamma == 0 && (beta == 1 || beta == -1) )
+    {
+        if( beta == 1 )
+            for( ; i <= len - v_float32::nlanes; i += v_float32::nlanes )
+                v_store(d + i, vx_load(x + i) + vx_load(y + i));
+        else
+            for( ; i <= len - v_float32::nlanes; i += v_float32::nlanes )
+                v_store(d + i, vx_load(x + i) - vx_load(y + i));
+        for( ; i < len; i++ )
+            d[i] = x[i] + y[i]*beta;
+        return;
+    }
+    v_float32 va = vx_setall_f32(alpha), vb = vx_setall_f32(beta), vg = vx_setall_f32(gamma);
+    if( gamma == 0 )
+    {
+        for( ; i <= len - v_float32::nlanes; i += v_float32::nlanes )
+            v_store(d + i, vx_load(x + i)*va + vx_load(y + i)*vb);
+        for( ; i < len; i++ )
+            d[i] = x[i]*alpha + y[i]*beta;
+        return;
+    }
+    for( ; i <= len - v_float32::nlanes; i += v_float32::nlanes )
+        v_store(d + i, vx_load(x + i)*va + vx_load(y + i)*vb + vg);
+    for( ; i < len; i++ )
+        d[i] = x[i]*alpha + y[i]*beta + gamma;
+}
+
+static void fusedScale(const float* x, const float* s, float* d, int len, float alpha)
+{
+    int i = 0;
+    v_float32 va = vx_setall_f32(alpha);
+    for( ; i <= len - v_float32::nlanes; i += v_float32::nlanes )
+        v_store(d + i, vx_load(x + i)*va + vx_load(s + i));
+    for( ; i < len; i++ )
+        d[i] = x[i]*alpha + s[i];
+}
+
+static void fusedMul(const float* x, const float* y, float* d, int len, float alpha)
+{
+    int i = 0;
+    if( alpha == 1 )
+    {
+        for( ; i <= len - v_float32::nlanes; i += v_float32::nlanes )
+            v_store(d + i, vx_load(x + i)*vx_load(y + i));
+        for( ; i < len; i++ )
+            d[i] = x[i]*y[i];
+        return;
+    }
+    v_float32 va = vx_setall_f32(alpha);
+    for( ; i <= len - v_float32::nlanes; i += v_float32::nlanes )
+        v_store(d + i, vx_load(x + i)*vx_load(y + i)*va);
+    for( ; i < len; i++ )
+        d[i] = x[i]*y[i]*alpha;
+}
+
+static void fusedMin(const float* x, const float* y, float* d, int len)
+{
+    int i = 0;
+    for( ; i <= len - v_float32::nlanes; i += v_float32::nlanes )
+        v_store(d + i, v_min(vx_load(x + i), vx_load(y + i)));
+    for( ; i < len; i++ )
+        d[i] = std::min(x[i], y[i]);
+}
+
+static void fusedMax(const float* x, const float* y, float* d, int len)
+{
+    int i = 0;
+    for( ; i <= len - v_float32::nlanes; i += v_float32::nlanes )
+        v_store(d + i, v_max(vx_load(x + i), vx_load(y + i)));
+    for( ; i < len; i++ )
+        d[i] = std::max(x[i], y[i]);
+}
+
+static void fusedAbsDiff(const float* x, const float* y, float* d, int len)
+{
+    int i = 0;
+    for( ; i <= len - v_float32::nlanes; i += v_float32::nlanes )
+        v_store(d + i, v_absdiff(vx_load(x + i), vx_load(y + i)));
+    for( ; i < len; i++ )
+        d[i] = std::abs(x[i] - y[i]);
+}
+
+#endif
+
+// saturate_cast to the depth, the result is kept in the working type
+template<typename WT> static void
+fusedSaturate(const WT* x, WT* d, int len, int depth)
+{
+    int i;
+    if( depth == CV_32F )
+    {
+        for( i = 0; i < len; i++ )
+            d[i] = (WT)(float)x[i];
+    }
+    else
+    {
+        WT lo = (WT)fusedMinVals[depth], hi = (WT)fusedMaxVals[depth];
+        for( i = 0; i < len; i++ )
+            d[i] = (WT)cvRound(std::min(std::max(x[i], lo), hi));
+    }
+}
+
+// the conversions of the operands and the result, false means that the generic function is used
+template<typename WT> static bool fusedLoad(const uchar*, int, WT*, int) { return false; }
+template<typename WT> static bool fusedStore(const WT*, uchar*, int, int) { return false; }
+
+#if CV_SIMD
+
+static void fusedSaturate(const float* x, float* d, int len, int depth)
+{
+    int i = 0;
+    float lo = (float)fusedMinVals[depth], hi = (float)fusedMaxVals[depth];
+    v_float32 vlo = vx_setall_f32(lo), vhi = vx_setall_f32(hi);
+    for( ; i <= len - v_float32::nlanes; i += v_float32::nlanes )
+        v_store(d + i, v_cvt_f32(v_round(v_min(v_max(vx_load(x + i), vlo), vhi))));
+    for( ; i < len; i++ )
+        d[i] = (float)cvRound(std::min(std::max(x[i], lo), hi));
+}
+
+static bool fusedLoad(const uchar* src, int depth, float* d, int len)
+{
+    int i = 0;
+    const int VECSZ = v_float32::nlanes;
+    switch( depth )
+    {
+    case CV_8U:
+        for( ; i <= len - VECSZ; i += VECSZ )
+            v_store(d + i, v_cvt_f32(v_reinterpret_as_s32(vx_load_expand_q(src + i))));
+        for( ; i < len; i++ )
+            d[i] = src[i];
+        return true;
+    case CV_8S:
+        for( ; i <= len - VECSZ; i += VECSZ )
+            v_store(d + i, v_cvt_f32(vx_load_expand_q((const schar*)src + i)));
+        for( ; i < len; i++ )
+            d[i] = ((const schar*)src)[i];
+        return true;
+    case CV_16U:
+        for( ; i <= len - VECSZ; i += VECSZ )
+            v_store(d + i, v_cvt_f32(v_reinterpret_as_s32(vx_load_expand((const ushort*)src + i))));
+        for( ; i < len; i++ )
+            d[i] = ((const ushort*)src)[i];
+        return true;
+    case CV_16S:
+        for( ; i <= len - VECSZ; i += VECSZ )
+            v_store(d + i, v_cvt_f32(vx_load_expand((const short*)src + i)));
+        for( ; i < len; i++ )
+            d[i] = ((const short*)src)[i];
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool fusedStore(const float* x, uchar* dst, int depth, int len)
+{
+    int i = 0;
+    const int VECSZ = v_float32::nlanes;
+    if( depth > CV_16S )
+        return false;
+
+    v_float32 vlo = vx_setall_f32((float)fusedMinVals[depth]), vhi = vx_setall_f32((float)fusedMaxVals[depth]);
+    if( depth <= CV_8S )
+    {
+        for( ; i <= len - VECSZ*2; i += VECSZ*2 )
+        {
+            v_int32 r0 = v_round(v_min(v_max(vx_load(x + i), vlo), vhi));
+            v_int32 r1 = v_round(v_min(v_max(vx_load(x + i + VECSZ), vlo), vhi));
+            if( depth == CV_8U )
+                v_pack_u_store(dst + i, v_pack(r0, r1));
+            else
+                v_pack_store((schar*)dst + i, v_pack(r0, r1));
+        }
+    }
+    else
+    {
+        for( ; i <= len - VECSZ; i += VECSZ )
+        {
+            v_int32 r = v_round(v_min(v_max(vx_load(x + i), vlo), vhi));
+            if( depth == CV_16U )
+                v_pack_u_store((ushort*)dst + i, r);
+            else
+                v_pack_store((short*)dst + i, r);
+        }
+    }
+
+    for( ; i < len; i++ )
+    {
+        if( depth == CV_8U )
+            dst[i] = saturate_cast<uchar>(x[i]);
+        else if( depth == CV_8S )
+            ((schar*)dst)[i] = saturate_cast<schar>(x[i]);
+        else if( depth == CV_16U )
+            ((ushort*)dst)[i] = saturate_cast<ushort>(x[i]);
+        else
+            ((short*)dst)[i] = saturate_cast<short>(x[i]);
+    }
+    return true;
+}
+
+#endif
+
+// the division is done in single precision for all the depths except CV_64F, as in cv::divide()
+template<typename WT> static void
+fusedDiv(const WT* x, const WT* y, WT* d, int len, double scale, int depth)
+{
+    int i;
+    if( depth == CV_64F )
+    {
+        for( i = 0; i < len; i++ )
+            d[i] = y[i] != 0 ? (WT)(x[i]*scale/y[i]) : (WT)0;
+    }
+    else
+    {
+        float scale_f = (float)scale;
+        for( i = 0; i < len; i++ )
+            d[i] = y[i] != 0 ? (WT)((float)x[i]*scale_f/(float)y[i]) : (WT)0;
+    }
+}
+
+template<typename WT> static void
+fusedRecip(const WT* x, WT* d, int len, double scale, int depth)
+{
+    int i;
+    if( depth == CV_64F )
+    {
+        for( i = 0; i < len; i++ )
+            d[i] = x[i] != 0 ? (WT)(scale/x[i]) : (WT)0;
+    }
+    else
+    {
+        float scale_f = (float)scale;
+        for( i = 0; i < len; i++ )
+            d[i] = x[i] != 0 ? (WT)(scale_f/(float)x[i]) : (WT)0;
+    }
+}
+
+template<typename WT, class Op> static void
+fusedCmp_(const WT* x, const WT* y, WT v, WT* d, int len, Op op)
+{
+    int i;
+    if( y )
+    {
+        for( i = 0; i < len; i++ )
+            d[i] = op(x[i], y[i]) ? (WT)255 : (WT)0;
+    }
+    else
+    {
+        for( i = 0; i < len; i++ )
+            d[i] = op(x[i], v) ? (WT)255 : (WT)0;
+    }
+}
+
+template<typename WT> static void
+fusedCmp(const WT* x, const WT* y, WT v, WT* d, int len, int cmpop)
+{
+    switch( cmpop )
+    {
+    case CMP_EQ: fusedCmp_(x, y, v, d, len, std::equal_to<WT>()); break;
+    case CMP_GT: fusedCmp_(x, y, v, d, len, std::greater<WT>()); break;
+    case CMP_GE: fusedCmp_(x, y, v, d, len, std::greater_equal<WT>()); break;
+    case CMP_LT: fusedCmp_(x, y, v, d, len, std::less<WT>()); break;
+    case CMP_LE: fusedCmp_(x, y, v, d, len, std::less_equal<WT>()); break;
+    default: fusedCmp_(x, y, v, d, len, std::not_equal_to<WT>()); break;
+    }
+}
+
+template<typename WT> class FusedExprInvoker : public ParallelLoopBody
+{
+public:
+    FusedExprInvoker(const MatExprGraph& _g, Mat& _dst, int _blockSize, int _width, int _nblocks)
+        : g(_g), dst(_dst), blockSize(_blockSize), width(_width), nblocks(_nblocks)
+    {
+        int i, j, n = (int)g.code.size(), cn = dst.channels();
+        wdepth = DataType<WT>::depth;
+
+        for( i = 0; i < (int)g.mats.size(); i++ )
+            loadFuncs.push_back(getConvertFunc(g.mats[i].depth(), wdepth));
+        storeFunc = getConvertFunc(wdepth, dst.depth());
+
+        // the last operation writes the result directly to dst when it has the working type
+        lastOp = -1;
+        for( i = n - 1; i >= 0 && dst.depth() == wdepth; i-- )
+            if( g.code[i].op != FUSED_SAT || g.code[i].arg != wdepth )
+            {
+                lastOp = g.code[i].op == FUSED_LOAD ? -1 : i;
+                break;
+            }
+
+        // the scalars are unrolled to the block size
+        scalarOfs.resize(n, 0);
+        for( i = 0; i < n; i++ )
+        {
+            const MatExprGraph::Instr& instr = g.code[i];
+            if( hasScalarPattern(instr.op) )
+            {
+                scalarOfs[i] = (int)scalars.size();
+                for( j = 0; j < blockSize; j++ )
+                    scalars.push_back(saturate_cast<WT>(instr.s[j % cn]));
+            }
+        }
+    }
+
+    void operator()(const Range& range) const
+    {
+        int n = (int)g.code.size();
+        AutoBuffer<WT> _buf(blockSize*g.stackSize);
+        AutoBuffer<const WT*> _stack(g.stackSize);
+        WT* buf = _buf;
+        const WT** stack = _stack;
+        const WT* svals = scalars.empty() ? 0 : &scalars[0];
+
+        for( int u = range.start; u < range.end; u++ )
+        {
+            int y = u / nblocks, x0 = (u - y*nblocks)*blockSize;
+            int len = std::min(blockSize, width - x0), k = 0;
+            Size sz(len, 1);
+            uchar* dptr = dst.ptr(y) + (size_t)x0*dst.elemSize1();
+
+            for( int i = 0; i < n; i++ )
+            {
+                const MatExprGraph::Instr& instr = g.code[i];
+                if( instr.op == FUSED_LOAD )
+                {
+                    const Mat& m = g.mats[instr.arg];
+                    const uchar* sptr = m.ptr(y) + (size_t)x0*m.elemSize1();
+                    if( m.depth() == wdepth )
+                        stack[k] = (const WT*)sptr;
+                    else
+                    {
+                        WT* d = buf + blockSize*k;
+                        if( !fusedLoad(sptr, m.depth(), d, len) )
+                            loadFuncs[instr.arg](sptr, 0, 0, 0, (uchar*)d, 0, sz, 0);
+                        stack[k] = d;
+                    }
+                    k++;
+                    continue;
+                }
+
+                if( isBinaryInstr(instr.op) )
+                    k--;
+                const WT* a = stack[k-1];
+                const WT* b = isBinaryInstr(instr.op) ? stack[k] : 0;
+                const WT* s = svals + scalarOfs[i];
+                WT* d = i == lastOp ? (WT*)dptr : buf + blockSize*(k-1);
+
+                switch( instr.op )
+                {
+                case FUSED_ADDW:
+                    if( instr.arg )
+                        fusedAddWeighted64f(a, b, d, len, instr.alpha, instr.beta, instr.s[0]);
+                    else
+                        fusedAddWeighted(a, b, d, len, (WT)instr.alpha, (WT)instr.beta, (WT)instr.s[0]);
+                    break;
+                case FUSED_SCALE:
+                    fusedScale(a, s, d, len, (WT)instr.alpha);
+                    break;
+                case FUSED_MUL:
+                    fusedMul(a, b, d, len, (WT)instr.alpha);
+                    break;
+                case FUSED_DIV:
+                    fusedDiv(a, b, d, len, instr.alpha, instr.arg);
+                    break;
+                case FUSED_RECIP:
+                    fusedRecip(a, d, len, instr.alpha, instr.arg);
+                    break;
+                case FUSED_MIN:
+                case FUSED_MIN_S:
+                    fusedMin(a, b ? b : s, d, len);
+                    break;
+                case FUSED_MAX:
+                case FUSED_MAX_S:
+                    fusedMax(a, b ? b : s, d, len);
+                    break;
+                case FUSED_ABSDIFF:
+                case FUSED_ABSDIFF_S:
+                    fusedAbsDiff(a, b ? b : s, d, len);
+                    break;
+                case FUSED_CMP:
+                case FUSED_CMP_S:
+                    fusedCmp(a, b, (WT)instr.alpha, d, len, instr.arg);
+                    break;
+                default: // FUSED_SAT
+                    if( instr.arg == wdepth )
+                        continue;
+                    fusedSaturate(a, d, len, instr.arg);
+                    break;
+                }
+                stack[k-1] = d;
+            }
+
+            if( lastOp < 0 && !fusedStore(stack[0], dptr, dst.depth(), len) )
+                storeFunc((const uchar*)stack[0], 0, 0, 0, dptr, 0, sz, 0);
+        }
+    }
+
+protected:
+    const MatExprGraph& g;
+    Mat& dst;
+    int blockSize, width, nblocks, wdepth, lastOp;
+    std::vector<BinaryFunc> loadFuncs;
+    BinaryFunc storeFunc;
+    std::vector<WT> scalars;
+    std::vector<int> scalarOfs;
+};
+
+// checks whether writing dst while reading src may change the values of src that are not read yet
+static bool isUnsafeAlias(const Mat& src, const Mat& dst)
+{
+    if( src.empty() || dst.empty() )
+        return false;
+    if( src.data == dst.data )
+        return src.step[0] != dst.step[0] || src.elemSize1() != dst.elemSize1();
+    const uchar* s0 = src.data, *s1 = src.ptr(src.rows-1) + src.cols*src.elemSize();
+    const uchar* d0 = dst.data, *d1 = dst.ptr(dst.rows-1) + dst.cols*dst.elemSize();
+    return s0 < d1 && d0 < s1;
+}
+
+static void evalFusedExpr(const MatExprGraph& g, Mat& dst)
+{
+    int i, wdepth = CV_32F, cn = dst.channels();
+    bool continuous = dst.isContinuous() && (int64)dst.total()*cn <= INT_MAX;
+
+    for( i = 0; i < (int)g.mats.size(); i++ )
+    {
+        int depth = g.mats[i].depth();
+        if( depth == CV_32S || depth == CV_64F )
+            wdepth = CV_64F;
+        continuous = continuous && g.mats[i].isContinuous();
+    }
+    for( i = 0; i < (int)g.code.size(); i++ )
+        if( g.code[i].op == FUSED_SAT && (g.code[i].arg == CV_32S || g.code[i].arg == CV_64F) )
+            wdepth = CV_64F;
+
+    int rows = continuous ? 1 : dst.rows;
+    int width = continuous ? (int)dst.total()*cn : dst.cols*cn;
+    int blockSize = std::max(1024/cn, 1)*cn;
+    int nblocks = (width + blockSize - 1)/blockSize;
+    Range range(0, rows*nblocks);
+    double nstripes = (double)rows*width/(1 << 16);
+
+    if( wdepth == CV_32F )
+        parallel_for_(range, FusedExprInvoker<float>(g, dst, blockSize, width, nblocks), nstripes);
+    else
+        parallel_for_(range, FusedExprInvoker<double>(g, dst, blockSize, width, nblocks), nstripes);
+}
+
+void MatOp_Fused::assign(const MatExpr& e, Mat& m, int _type) const
+{
+    // the scaling with the conversion to 64F is done by Mat::convertTo() in double,
+    // as in MatOp_AddEx::assign()
+    if( e.flags == 's' && e.s.isReal() && fabs(e.alpha) != 1 && _type != -1 &&
+        CV_MAT_DEPTH(_type) == CV_64F && CV_MAT_DEPTH(exprGraph(e).type) != CV_64F )
+    {
+        MatExpr prog = e;
+        prog.flags = 0;
+        Mat temp;
+        assign(prog, temp);
+        temp.convertTo(m, _type, e.alpha, e.s[0]);
+        return;
+    }
+
+    const MatExprGraph* g = &exprGraph(e);
+    MatExprGraph root;
+    if( e.flags != 0 )
+    {
+        appendProgram(root, exprGraph(e));
+        appendRoot(root, e);
+        root.type = exprGraph(e).type;
+        g = &root;
+    }
+
+    // the result is converted to the destination type when it is stored
+    int cn = CV_MAT_CN(g->type);
+    if( _type != -1 && CV_MAT_CN(_type) != cn )
+    {
+        Mat temp;
+        assign(e, temp);
+        temp.convertTo(m, _type);
+        return;
+    }
+
+    Mat temp;
+    m.create(g->mats[0].size(), _type == -1 ? g->type : _type);
+    for( size_t i = 0; i < g->mats.size(); i++ )
+        if( isUnsafeAlias(g->mats[i], m) )
+        {
+            temp.create(m.size(), m.type());
+            break;
+        }
+
+    evalFusedExpr(*g, temp.data ? temp : m);
+    if( temp.data )
+        temp.copyTo(m);
+}
+
+void MatOp_Fused::roi(const MatExpr& e, const Range& rowRange, const Range& colRange, MatExpr& res) const
+{
+    Mat gm = createExprGraph(&exprGraph(e));
+    MatExprGraph* g = &exprGraph(gm);
+    for( size_t i = 0; i < g->mats.size(); i++ )
+        g->mats[i] = g->mats[i](rowRange, colRange);
+    res = e;
+    res.a = g->mats[0];
+    res.c = gm;
+}
+
+void MatOp_Fused::diag(const MatExpr& e, int d, MatExpr& res) const
+{
+    Mat gm = createExprGraph(&exprGraph(e));
+    MatExprGraph* g = &exprGraph(gm);
+    for( size_t i = 0; i < g->mats.size(); i++ )
+        g->mats[i] = g->mats[i].diag(d);
+    res = e;
+    res.a = g->mats[0];
+    res.c = gm;
+}
+
+void MatOp_Fused::add(const MatExpr& e, const Scalar& s, MatExpr& res) const
+{
+    if( e.flags == '+' || e.flags == 's' )
+    {
+        res = e;
+        res.s += s;
+    }
+    else
+        MatOp::add(e, s, res);
+}
+
+void MatOp_Fused::subtract(const Scalar& s, const MatExpr& e, MatExpr& res) const
+{
+    if( e.flags == '+' || e.flags == 's' )
+    {
+        res = e;
+        res.alpha = -res.alpha;
+        res.beta = -res.beta;
+        res.s = s - res.s;
+    }
+    else
+        MatOp::subtract(s, e, res);
+}
+
+void MatOp_Fused::multiply(const MatExpr& e, double s, MatExpr& res) const
+{
+    if( e.flags == '+' || e.flags == 's' )
+    {
+        res = e;
+        res.alpha *= s;
+        res.beta *= s;
+        res.s *= s;
+    }
+    else if( e.flags == '*' || e.flags == '/' || e.flags == 'r' )
+    {
+        res = e;
+        res.alpha *= s;
+    }
+    else
+        MatOp::multiply(e, s, res);
+}
+
+void MatOp_Fused::divide(double s, const MatExpr& e, MatExpr& res) const
+{
+    if( (e.flags == 's' && e.s == Scalar()) || e.flags == 'r' )
+    {
+        res = e;
+        res.flags = e.flags == 's' ? 'r' : 's';
+        res.alpha = s/e.alpha;
+    }
+    else
+        MatOp::divide(s, e, res);
+}
+
+void MatOp_Fused::abs(const MatExpr& e, MatExpr& res) const
+{
+    // |x - y| and |x*alpha + s| are computed directly, as in MatOp_AddEx::abs()
+    bool absdiff2 = e.flags == '+' && e.alpha + e.beta == 0 && e.alpha*e.beta == -1 && e.s == Scalar();
+    bool absdiff1 = e.flags == 's' && fabs(e.alpha) == 1;
+    if( absdiff1 || absdiff2 )
+    {
+        Mat gm = createExprGraph();
+        MatExprGraph* g = &exprGraph(gm);
+        int type = appendProgram(*g, exprGraph(e)), depth = CV_MAT_DEPTH(type);
+        if( absdiff2 )
+            g->emit(FUSED_ABSDIFF);
+        else
+            g->emit(FUSED_ABSDIFF_S, 0, 1, 0, roundScalar(-e.s*e.alpha, depth));
+        g->emit(FUSED_SAT, depth);
+        makeFusedExpr(res, gm, type, 0);
+    }
+    else
+        MatOp::abs(e, res);
+}
+
+Size MatOp_Fused::size(const MatExpr& e) const
+{
+    return exprGraph(e).mats[0].size();
+}
+
+int MatOp_Fused::type(const MatExpr& e) const
+{
+    return exprGraph(e).type;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void MatOp_T::assign(const MatExpr& e, Mat& m, int _type) const
 {
     Mat temp, &dst = _type == -1 || _type == e.a.type() ? m : temp;
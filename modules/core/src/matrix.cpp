@@ -188,9 +188,12 @@ public:
             total *= sizes[i];
         }
         uchar* data = data0 ? (uchar*)data0 : (uchar*)fastMalloc(total);
+        if(!data0)
+            numaFirstTouch(data, total);
         UMatData* u = new UMatData(this);
         u->data = u->origdata = data;
         u->size = total;
+        u->flags |= UMatData::HOST_MEMORY;
         if(data0)
             u->flags |= UMatData::USER_ALLOCATED;
 
@@ -224,8 +227,16 @@ namespace
 }
 
 
+volatile int g_matAllocatorScopes = 0;
+
 MatAllocator* Mat::getDefaultAllocator()
 {
+    if (g_matAllocatorScopes > 0)
+    {
+        MatAllocator* a = getCoreTlsData().get()->matAllocator;
+        if (a)
+            return a;
+    }
     if (g_matAllocator == NULL)
     {
         g_matAllocator = getStdAllocator();
@@ -3237,6 +3248,8 @@ static bool ipp_transpose( Mat &src, Mat &dst )
 
 void cv::transpose( InputArray _src, OutputArray _dst )
 {
+    CV_TRACE_FUNCTION();
+
     int type = _src.type(), esz = CV_ELEM_SIZE(type);
     CV_Assert( _src.dims() <= 2 && esz <= 32 );
 
@@ -3899,20 +3912,21 @@ static IppFlipFunc getFlipFunc(int depth)
 
 #endif
 
-template<typename T> static void sort_( const Mat& src, Mat& dst, int flags )
+// sorts the rows or the columns from the range
+template<typename T> static void sort_( const Mat& src, Mat& dst, int flags, const Range& range )
 {
     AutoBuffer<T> buf;
     T* bptr;
-    int i, j, n, len;
+    int i, j, len;
     bool sortRows = (flags & 1) == CV_SORT_EVERY_ROW;
     bool inplace = src.data == dst.data;
     bool sortDescending = (flags & CV_SORT_DESCENDING) != 0;
 
     if( sortRows )
-        n = src.rows, len = src.cols;
+        len = src.cols;
     else
     {
-        n = src.cols, len = src.rows;
+        len = src.rows;
         buf.allocate(len);
     }
     bptr = (T*)buf;
@@ -3928,7 +3942,7 @@ template<typename T> static void sort_( const Mat& src, Mat& dst, int flags )
     }
 #endif
 
-    for( i = 0; i < n; i++ )
+    for( i = range.start; i < range.end; i++ )
     {
         T* ptr = bptr;
         if( sortRows )
@@ -4021,23 +4035,23 @@ static IppSortIndexFunc getSortIndexFunc(int depth, bool sortDescending)
 
 #endif
 
-template<typename T> static void sortIdx_( const Mat& src, Mat& dst, int flags )
+template<typename T> static void sortIdx_( const Mat& src, Mat& dst, int flags, const Range& range )
 {
     AutoBuffer<T> buf;
     AutoBuffer<int> ibuf;
     T* bptr;
     int* _iptr;
-    int i, j, n, len;
+    int i, j, len;
     bool sortRows = (flags & 1) == CV_SORT_EVERY_ROW;
     bool sortDescending = (flags & CV_SORT_DESCENDING) != 0;
 
     CV_Assert( src.data != dst.data );
 
     if( sortRows )
-        n = src.rows, len = src.cols;
+        len = src.cols;
     else
     {
-        n = src.cols, len = src.rows;
+        len = src.rows;
         buf.allocate(len);
         ibuf.allocate(len);
     }
@@ -4055,7 +4069,7 @@ template<typename T> static void sortIdx_( const Mat& src, Mat& dst, int flags )
     }
 #endif
 
-    for( i = 0; i < n; i++ )
+    for( i = range.start; i < range.end; i++ )
     {
         T* ptr = bptr;
         int* iptr = _iptr;
@@ -4114,12 +4128,193 @@ template<typename T> static void sortIdx_( const Mat& src, Mat& dst, int flags )
     }
 }
 
-typedef void (*SortFunc)(const Mat& src, Mat& dst, int flags);
+// "a is selected before b": the smaller (the larger with SORT_DESCENDING) values go first,
+// the equal values are ordered by their positions
+template<typename T> class SelectBefore
+{
+public:
+    SelectBefore( const T* _arr, bool _descending ) : arr(_arr), descending(_descending) {}
+    bool operator()(int a, int b) const
+    {
+        return descending ? (arr[a] > arr[b] || (arr[a] == arr[b] && a < b)) :
+                            (arr[a] < arr[b] || (arr[a] == arr[b] && a < b));
+    }
+    const T* arr;
+    bool descending;
+};
+
+// returns the position of the first element from [j, len) that is strictly better than thr
+template<typename T> struct SelectSkip
+{
+    int operator()( const T* ptr, int j, int len, T thr, bool descending ) const
+    {
+        if( descending )
+            for( ; j < len && !(ptr[j] > thr); j++ )
+                ;
+        else
+            for( ; j < len && !(ptr[j] < thr); j++ )
+                ;
+        return j;
+    }
+};
+
+#if CV_SIMD128
+
+#define CV_SELECT_SKIP_SIMD(T, _Tpvec, setall) \
+template<> struct SelectSkip<T> \
+{ \
+    int operator()( const T* ptr, int j, int len, T thr, bool descending ) const \
+    { \
+        _Tpvec t = setall(thr); \
+        if( descending ) \
+        { \
+            for( ; j <= len - 8; j += 8 ) \
+                if( v_check_any((v_load(ptr + j) > t) | (v_load(ptr + j + 4) > t)) ) \
+                    break; \
+            for( ; j < len && !(ptr[j] > thr); j++ ) \
+                ; \
+        } \
+        else \
+        { \
+            for( ; j <= len - 8; j += 8 ) \
+                if( v_check_any((v_load(ptr + j) < t) | (v_load(ptr + j + 4) < t)) ) \
+                    break; \
+            for( ; j < len && !(ptr[j] < thr); j++ ) \
+                ; \
+        } \
+        return j; \
+    } \
+};
+
+CV_SELECT_SKIP_SIMD(int, v_int32x4, v_setall_s32)
+CV_SELECT_SKIP_SIMD(float, v_float32x4, v_setall_f32)
+
+#undef CV_SELECT_SKIP_SIMD
+
+#endif
+
+// selects the k first elements of each row or each column from the range. The candidates are
+// kept in a heap whose top is the last of them; the elements that do not go before the top are
+// skipped, so for k << len almost all the elements are only compared with the threshold
+template<typename T> static void partialSort_( const Mat& src, Mat& dst, Mat& idx, int k, int flags, const Range& range )
+{
+    AutoBuffer<T> buf;
+    AutoBuffer<int> hbuf(k);
+    int* heap = hbuf;
+    int i, j, len;
+    bool sortRows = (flags & 1) == CV_SORT_EVERY_ROW;
+    bool sortDescending = (flags & CV_SORT_DESCENDING) != 0;
+    SelectSkip<T> skip;
+
+    if( sortRows )
+        len = src.cols;
+    else
+    {
+        len = src.rows;
+        buf.allocate(len);
+    }
+
+    for( i = range.start; i < range.end; i++ )
+    {
+        const T* ptr = buf;
+        if( sortRows )
+            ptr = src.ptr<T>(i);
+        else
+        {
+            T* bptr = buf;
+            for( j = 0; j < len; j++ )
+                bptr[j] = src.ptr<T>(j)[i];
+        }
+
+        SelectBefore<T> before(ptr, sortDescending);
+        for( j = 0; j < k; j++ )
+            heap[j] = j;
+        std::make_heap(heap, heap + k, before);
+        T thr = ptr[heap[0]];
+
+        for( j = k; (j = skip(ptr, j, len, thr, sortDescending)) < len; j++ )
+        {
+            std::pop_heap(heap, heap + k, before);
+            heap[k-1] = j;
+            std::push_heap(heap, heap + k, before);
+            thr = ptr[heap[0]];
+        }
+        std::sort_heap(heap, heap + k, before);
+
+        for( j = 0; j < k; j++ )
+        {
+            if( !dst.empty() )
+                (sortRows ? dst.ptr<T>(i)[j] : dst.ptr<T>(j)[i]) = ptr[heap[j]];
+            if( !idx.empty() )
+                (sortRows ? idx.ptr<int>(i)[j] : idx.ptr<int>(j)[i]) = heap[j];
+        }
+    }
+}
+
+typedef void (*SortFunc)(const Mat& src, Mat& dst, int flags, const Range& range);
+typedef void (*PartialSortFunc)(const Mat& src, Mat& dst, Mat& idx, int k, int flags, const Range& range);
+
+// sorting is more work per byte than the element-wise operations, so the stripes are smaller
+enum { SORT_GRAIN = PARALLEL_STRIPE_GRAIN/2 };
+
+static int sortStripes( const Mat& src, int n )
+{
+    return std::min(getParallelStripes(src.total()*src.elemSize(), SORT_GRAIN), n);
+}
+
+class SortInvoker : public ParallelLoopBody
+{
+public:
+    SortInvoker(SortFunc _func, const Mat& _src, Mat& _dst, int _flags)
+        : func(_func), src(_src), dst(_dst), flags(_flags) {}
+
+    void operator()(const Range& range) const
+    {
+        func(src, dst, flags, range);
+    }
+
+protected:
+    SortFunc func;
+    const Mat& src;
+    Mat& dst;
+    int flags;
+};
+
+class PartialSortInvoker : public ParallelLoopBody
+{
+public:
+    PartialSortInvoker(PartialSortFunc _func, const Mat& _src, Mat& _dst, Mat& _idx, int _k, int _flags)
+        : func(_func), src(_src), dst(_dst), idx(_idx), k(_k), flags(_flags) {}
+
+    void operator()(const Range& range) const
+    {
+        func(src, dst, idx, k, flags, range);
+    }
+
+protected:
+    PartialSortFunc func;
+    const Mat& src;
+    Mat& dst;
+    Mat& idx;
+    int k, flags;
+};
+
+static void runSort( SortFunc func, const Mat& src, Mat& dst, int flags )
+{
+    int n = (flags & 1) == CV_SORT_EVERY_ROW ? src.rows : src.cols;
+    int nstripes = sortStripes(src, n);
+    if( nstripes < 2 )
+        func(src, dst, flags, Range(0, n));
+    else
+        parallel_for_(Range(0, n), SortInvoker(func, src, dst, flags), nstripes);
+}
 
 }
 
 void cv::sort( InputArray _src, OutputArray _dst, int flags )
 {
+    CV_TRACE_FUNCTION();
+
     static SortFunc tab[] =
     {
         sort_<uchar>, sort_<schar>, sort_<ushort>, sort_<short>,
@@ -4130,11 +4325,13 @@ void cv::sort( InputArray _src, OutputArray _dst, int flags )
     CV_Assert( src.dims <= 2 && src.channels() == 1 && func != 0 );
     _dst.create( src.size(), src.type() );
     Mat dst = _dst.getMat();
-    func( src, dst, flags );
+    runSort( func, src, dst, flags );
 }
 
 void cv::sortIdx( InputArray _src, OutputArray _dst, int flags )
 {
+    CV_TRACE_FUNCTION();
+
     static SortFunc tab[] =
     {
         sortIdx_<uchar>, sortIdx_<schar>, sortIdx_<ushort>, sortIdx_<short>,
@@ -4149,7 +4346,50 @@ void cv::sortIdx( InputArray _src, OutputArray _dst, int flags )
         _dst.release();
     _dst.create( src.size(), CV_32S );
     dst = _dst.getMat();
-    func( src, dst, flags );
+    runSort( func, src, dst, flags );
+}
+
+void cv::partialSort( InputArray _src, OutputArray _dst, OutputArray _idx, int k, int flags )
+{
+    CV_TRACE_FUNCTION();
+
+    static PartialSortFunc tab[] =
+    {
+        partialSort_<uchar>, partialSort_<schar>, partialSort_<ushort>, partialSort_<short>,
+        partialSort_<int>, partialSort_<float>, partialSort_<double>, 0
+    };
+    Mat src = _src.getMat();
+    PartialSortFunc func = tab[src.depth()];
+    CV_Assert( src.dims <= 2 && src.channels() == 1 && func != 0 );
+
+    bool sortRows = (flags & 1) == CV_SORT_EVERY_ROW;
+    int n = sortRows ? src.rows : src.cols, len = sortRows ? src.cols : src.rows;
+    CV_Assert( 0 < k && k <= len );
+    Size dsz = sortRows ? Size(k, n) : Size(n, k);
+
+    Mat dst, idx;
+    if( _dst.needed() )
+    {
+        if( _dst.getMat().data == src.data )
+            _dst.release();
+        _dst.create( dsz, src.type() );
+        dst = _dst.getMat();
+    }
+    if( _idx.needed() )
+    {
+        if( _idx.getMat().data == src.data )
+            _idx.release();
+        _idx.create( dsz, CV_32S );
+        idx = _idx.getMat();
+    }
+    if( dst.empty() && idx.empty() )
+        return;
+
+    int nstripes = sortStripes(src, n);
+    if( nstripes < 2 )
+        func( src, dst, idx, k, flags, Range(0, n) );
+    else
+        parallel_for_(Range(0, n), PartialSortInvoker(func, src, dst, idx, k, flags), nstripes);
 }
 
 
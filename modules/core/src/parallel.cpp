@@ -56,6 +56,8 @@
     #include <sys/types.h>
     #if defined ANDROID
         #include <sys/sysconf.h>
+    #elif defined __linux__
+        #include <sched.h>
     #elif defined __APPLE__
         #include <sys/sysctl.h>
     #endif
@@ -80,7 +82,8 @@
    4. HAVE_GCD         - system wide, used automatically        (APPLE only)
    5. WINRT            - system wide, used automatically        (Windows RT only)
    6. HAVE_CONCURRENCY - part of runtime, used automatically    (Windows only - MSVS 10, MSVS 11)
-   7. HAVE_PTHREADS_PF - pthreads if available
+   7. HAVE_WORKSTEALING_PF - built-in work-stealing scheduler, should be explicitly enabled
+   8. HAVE_PTHREADS_PF - pthreads if available
 */
 
 #if defined HAVE_TBB
@@ -126,6 +129,8 @@
 #  define CV_PARALLEL_FRAMEWORK "winrt-concurrency"
 #elif defined HAVE_CONCURRENCY
 #  define CV_PARALLEL_FRAMEWORK "ms-concurrency"
+#elif defined HAVE_WORKSTEALING_PF
+#  define CV_PARALLEL_FRAMEWORK "workstealing"
 #elif defined HAVE_PTHREADS_PF
 #  define CV_PARALLEL_FRAMEWORK "pthreads"
 #endif
@@ -133,7 +138,12 @@
 namespace cv
 {
     ParallelLoopBody::~ParallelLoopBody() {}
-#ifdef HAVE_PTHREADS_PF
+#if defined HAVE_WORKSTEALING_PF
+    void parallel_for_workstealing(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes);
+    size_t parallel_workstealing_get_threads_num();
+    void parallel_workstealing_set_threads_num(int num);
+    int parallel_workstealing_get_thread_num();
+#elif defined HAVE_PTHREADS_PF
     void parallel_for_pthreads(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes);
     size_t parallel_pthreads_get_threads_num();
     void parallel_pthreads_set_threads_num(int num);
@@ -250,7 +260,7 @@ static SchedPtr pplScheduler;
 
 /* ================================   parallel_for_  ================================ */
 
-void cv::parallel_for_(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes)
+static void parallel_for_impl(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes)
 {
 #ifdef CV_PARALLEL_FRAMEWORK
 
@@ -307,6 +317,10 @@ void cv::parallel_for_(const cv::Range& range, const cv::ParallelLoopBody& body,
             Concurrency::CurrentScheduler::Detach();
         }
 
+#elif defined HAVE_WORKSTEALING_PF
+
+        parallel_for_workstealing(range, body, nstripes);
+
 #elif defined HAVE_PTHREADS_PF
 
         parallel_for_pthreads(range, body, nstripes);
@@ -327,6 +341,19 @@ void cv::parallel_for_(const cv::Range& range, const cv::ParallelLoopBody& body,
     }
 }
 
+void cv::parallel_for_(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes)
+{
+#if CV_TRACE
+    if (cv::tracing::getLevel() != cv::tracing::LEVEL_DISABLED)
+    {
+        cv::tracing::TraceParallelLoopBody tbody(body);
+        parallel_for_impl(range, tbody, nstripes);
+        return;
+    }
+#endif
+    parallel_for_impl(range, body, nstripes);
+}
+
 int cv::getNumThreads(void)
 {
 #ifdef CV_PARALLEL_FRAMEWORK
@@ -366,6 +393,10 @@ int cv::getNumThreads(void)
         ? Concurrency::CurrentScheduler::Get()->GetNumberOfVirtualProcessors()
         : pplScheduler->GetNumberOfVirtualProcessors());
 
+#elif defined HAVE_WORKSTEALING_PF
+
+    return (int)parallel_workstealing_get_threads_num();
+
 #elif defined HAVE_PTHREADS_PF
 
         return parallel_pthreads_get_threads_num();
@@ -427,6 +458,10 @@ void cv::setNumThreads( int threads )
                        Concurrency::MaxConcurrency, threads-1));
     }
 
+#elif defined HAVE_WORKSTEALING_PF
+
+    parallel_workstealing_set_threads_num(threads);
+
 #elif defined HAVE_PTHREADS_PF
 
     parallel_pthreads_set_threads_num(threads);
@@ -453,6 +488,8 @@ int cv::getThreadNum(void)
     return 0;
 #elif defined HAVE_CONCURRENCY
     return std::max(0, (int)Concurrency::Context::VirtualProcessorId()); // zero for master thread, unique number for others but not necessary 1,2,3,...
+#elif defined HAVE_WORKSTEALING_PF
+    return parallel_workstealing_get_thread_num(); // zero for non-worker threads, 1..N-1 for workers
 #elif defined HAVE_PTHREADS_PF
     return (int)(size_t)(void*)pthread_self(); // no zero-based indexing
 #else
@@ -460,42 +497,57 @@ int cv::getThreadNum(void)
 #endif
 }
 
-#ifdef ANDROID
-static inline int getNumberOfCPUsImpl()
+#if defined __linux__
+//parse string of form "0-1,3,5-7,10,13-15"
+static std::vector<int> parseCPUList(char* pbuf)
 {
-   FILE* cpuPossible = fopen("/sys/devices/system/cpu/possible", "r");
-   if(!cpuPossible)
-       return 1;
-
-   char buf[2000]; //big enough for 1000 CPUs in worst possible configuration
-   char* pbuf = fgets(buf, sizeof(buf), cpuPossible);
-   fclose(cpuPossible);
-   if(!pbuf)
-      return 1;
-
-   //parse string of form "0-1,3,5-7,10,13-15"
-   int cpusAvailable = 0;
+   std::vector<int> cpus;
 
-   while(*pbuf)
+   while(*pbuf && *pbuf != '\n')
    {
       const char* pos = pbuf;
       bool range = false;
-      while(*pbuf && *pbuf != ',')
+      while(*pbuf && *pbuf != ',' && *pbuf != '\n')
       {
           if(*pbuf == '-') range = true;
           ++pbuf;
       }
       if(*pbuf) *pbuf++ = 0;
+      int rstart = 0, rend = 0;
       if(!range)
-        ++cpusAvailable;
-      else
       {
-          int rstart = 0, rend = 0;
-          sscanf(pos, "%d-%d", &rstart, &rend);
-          cpusAvailable += rend - rstart + 1;
+          if(sscanf(pos, "%d", &rstart) == 1)
+              cpus.push_back(rstart);
+      }
+      else if(sscanf(pos, "%d-%d", &rstart, &rend) == 2)
+      {
+          for(int i = rstart; i <= rend; i++)
+              cpus.push_back(i);
       }
-
    }
+   return cpus;
+}
+
+static std::vector<int> readCPUList(const char* filename)
+{
+   FILE* f = fopen(filename, "r");
+   if(!f)
+       return std::vector<int>();
+
+   char buf[2000]; //big enough for 1000 CPUs in worst possible configuration
+   char* pbuf = fgets(buf, sizeof(buf), f);
+   fclose(f);
+   if(!pbuf)
+      return std::vector<int>();
+
+   return parseCPUList(pbuf);
+}
+#endif
+
+#ifdef ANDROID
+static inline int getNumberOfCPUsImpl()
+{
+   int cpusAvailable = (int)readCPUList("/sys/devices/system/cpu/possible").size();
    return cpusAvailable ? cpusAvailable : 1;
 }
 #endif
@@ -551,6 +603,136 @@ const char* cv::currentParallelFramework() {
 #endif
 }
 
+/* ================================   NUMA  ================================ */
+
+namespace cv
+{
+
+class NumaTopology
+{
+public:
+    static NumaTopology& instance()
+    {
+        CV_SINGLETON_LAZY_INIT_REF(NumaTopology, new NumaTopology())
+    }
+
+    int nodesCount() const { return std::max((int)nodeCPUs.size(), 1); }
+
+#if defined __linux__ && !defined ANDROID
+    //binds the calling thread to the CPUs of the node, node < 0 restores the initial process mask
+    void bindCurrentThread(int node) const
+    {
+        if( node >= 0 && node < (int)nodeCPUs.size() )
+        {
+            cpu_set_t mask;
+            CPU_ZERO(&mask);
+            for( size_t i = 0; i < nodeCPUs[node].size(); i++ )
+                if( nodeCPUs[node][i] < CPU_SETSIZE )
+                    CPU_SET(nodeCPUs[node][i], &mask);
+            sched_setaffinity(0, sizeof(mask), &mask);
+        }
+        else if( processMaskValid )
+            sched_setaffinity(0, sizeof(processMask), &processMask);
+    }
+#else
+    void bindCurrentThread(int) const {}
+#endif
+
+private:
+    NumaTopology()
+    {
+#if defined __linux__ && !defined ANDROID
+        processMaskValid = sched_getaffinity(0, sizeof(processMask), &processMask) == 0;
+
+        std::vector<int> nodes = readCPUList("/sys/devices/system/node/online");
+        for( size_t i = 0; i < nodes.size(); i++ )
+        {
+            char filename[64];
+            sprintf(filename, "/sys/devices/system/node/node%d/cpulist", nodes[i]);
+            std::vector<int> cpus = readCPUList(filename);
+            //memory-only nodes have no CPUs to run the workers on
+            if( !cpus.empty() )
+                nodeCPUs.push_back(cpus);
+        }
+#endif
+    }
+
+    std::vector<std::vector<int> > nodeCPUs;
+#if defined __linux__ && !defined ANDROID
+    cpu_set_t processMask;
+    bool processMaskValid;
+#endif
+};
+
+static volatile bool numaAware = false;
+static volatile int numaGeneration = 0;
+
+int getNumaNodesInUse()
+{
+    return numaAware ? NumaTopology::instance().nodesCount() : 1;
+}
+
+int updateNumaAffinity(int threadIdx, int nthreads, int& generation)
+{
+    int nodes = getNumaNodesInUse();
+    int node = nodes > 1 && nthreads > 0 ? (int)((int64)threadIdx*nodes/nthreads) : 0;
+
+    if( generation != numaGeneration )
+    {
+        generation = numaGeneration;
+        NumaTopology::instance().bindCurrentThread(nodes > 1 ? node : -1);
+    }
+
+    return node;
+}
+
+class NumaFirstTouchBody : public ParallelLoopBody
+{
+public:
+    NumaFirstTouchBody(uchar* _data, size_t _size, size_t _pageSize) :
+        data(_data), size(_size), pageSize(_pageSize) {}
+
+    void operator()(const Range& range) const
+    {
+        for( int i = range.start; i < range.end; i++ )
+            data[std::min(i*pageSize, size - 1)] = 0;
+    }
+
+private:
+    uchar* data;
+    size_t size;
+    size_t pageSize;
+};
+
+void numaFirstTouch(void* data, size_t size)
+{
+    const size_t pageSize = 4096, minSize = (size_t)1 << 22;
+
+    if( !data || size < minSize || getNumaNodesInUse() <= 1 )
+        return;
+
+    parallel_for_(Range(0, (int)((size + pageSize - 1)/pageSize)),
+                  NumaFirstTouchBody((uchar*)data, size, pageSize));
+}
+
+}
+
+void cv::setNumaAware(bool enabled)
+{
+    numaAware = enabled;
+    CV_XADD(&numaGeneration, 1);
+}
+
+bool cv::isNumaAware()
+{
+    return numaAware;
+}
+
+int cv::getNumberOfNumaNodes()
+{
+    return NumaTopology::instance().nodesCount();
+}
+
 CV_IMPL void cvSetNumThreads(int nt)
 {
     cv::setNumThreads(nt);
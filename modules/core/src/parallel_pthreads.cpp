@@ -80,7 +80,7 @@ struct work_load
         set(range, body, nstripes);
     }
 
-    void set(const cv::Range& range, const cv::ParallelLoopBody& body, unsigned int nstripes)
+    void set(const cv::Range& range, const cv::ParallelLoopBody& body, unsigned int nstripes, unsigned int numa_nodes = 1)
     {
         m_body = &body;
         m_range = &range;
@@ -92,12 +92,21 @@ struct work_load
 
         //ensure that nstripes not larger than blocks count, so we would never go out of range
         m_nstripes = std::min(m_nstripes, unsigned(((m_range->end - m_range->start - 1)/m_block_size) + 1) );
+
+        //the stripes are split between the NUMA nodes in contiguous chunks
+        m_numa_nodes = std::max(1u, std::min(numa_nodes, m_nstripes));
+    }
+
+    unsigned int numaChunkStart(unsigned int node) const
+    {
+        return (unsigned int)((uint64)node*m_nstripes/m_numa_nodes);
     }
 
     const cv::ParallelLoopBody* m_body;
     const cv::Range*            m_range;
     unsigned int                         m_nstripes;
     int                m_block_size;
+    unsigned int                         m_numa_nodes;
 
     void clear()
     {
@@ -105,6 +114,7 @@ struct work_load
         m_range = 0;
         m_nstripes = 0;
         m_block_size = 0;
+        m_numa_nodes = 1;
     }
 };
 
@@ -112,7 +122,7 @@ class ForThread
 {
 public:
 
-    ForThread(): m_task_start(false), m_parent(0), m_state(eFTNotStarted), m_id(0)
+    ForThread(): m_task_start(false), m_parent(0), m_state(eFTNotStarted), m_id(0), m_numa_generation(0)
     {
     }
 
@@ -135,6 +145,9 @@ private:
     //called from worker thread
     void execute();
 
+    //called from worker thread
+    void execute_stripes(unsigned int* position, unsigned int first, unsigned int last);
+
     //called from worker thread
     void thread_body();
 
@@ -146,6 +159,7 @@ private:
     ThreadManager*  m_parent;
     ForThreadState  m_state;
     size_t          m_id;
+    int             m_numa_generation;
 };
 
 class ThreadManager
@@ -203,6 +217,9 @@ private:
     unsigned int m_task_position;
     unsigned int m_num_of_completed_tasks;
 
+    //positions inside the chunks of stripes assigned to the NUMA nodes
+    std::vector<unsigned int> m_numa_positions;
+
     pthread_mutex_t m_manager_access_mutex;
 
     static const char m_env_name[];
@@ -301,18 +318,40 @@ void* ForThread::thread_loop_wrapper(void* thread_object)
 
 void ForThread::execute()
 {
-    unsigned int m_current_pos = CV_XADD(&m_parent->m_task_position, 1);
+    work_load& load = m_parent->m_work_load;
+
+    int node = updateNumaAffinity((int)m_id, (int)m_parent->m_num_threads, m_numa_generation);
+
+    if(load.m_numa_nodes > 1)
+    {
+        //process the chunk of own node first, then help the other nodes
+        for(unsigned int i = 0; i < load.m_numa_nodes; ++i)
+        {
+            unsigned int chunk = (node + i) % load.m_numa_nodes;
 
+            execute_stripes(&m_parent->m_numa_positions[chunk], load.numaChunkStart(chunk), load.numaChunkStart(chunk + 1));
+        }
+    }
+    else
+    {
+        execute_stripes(&m_parent->m_task_position, 0, load.m_nstripes);
+    }
+}
+
+void ForThread::execute_stripes(unsigned int* position, unsigned int first, unsigned int last)
+{
     work_load& load = m_parent->m_work_load;
 
-    while(m_current_pos < load.m_nstripes)
+    unsigned int m_current_pos = first + CV_XADD(position, 1);
+
+    while(m_current_pos < last)
     {
         int start = load.m_range->start + m_current_pos*load.m_block_size;
         int end = std::min(start + load.m_block_size, load.m_range->end);
 
         load.m_body->operator()(cv::Range(start, end));
 
-        m_current_pos = CV_XADD(&m_parent->m_task_position, 1);
+        m_current_pos = first + CV_XADD(position, 1);
     }
 }
 
@@ -411,7 +450,16 @@ void ThreadManager::run(const cv::Range& range, const cv::ParallelLoopBody& body
 
                 m_task_complete = false;
 
-                m_work_load.set(range, body, cvCeil(nstripes));
+                unsigned int numa_nodes = (unsigned int)getNumaNodesInUse();
+
+                if(numa_nodes > 1)
+                {
+                    //at least one stripe per node
+                    nstripes = std::max(nstripes, (double)numa_nodes);
+                    m_numa_positions.assign(numa_nodes, 0u);
+                }
+
+                m_work_load.set(range, body, cvCeil(nstripes), numa_nodes);
 
                 for(size_t i = 0; i < m_threads.size(); ++i)
                 {
@@ -0,0 +1,588 @@
+/*M///////////////////////////////////////////////////////////////////////////////////////
+//
+//  IMPORTANT: READ BEFORE DOWNLOADING, COPYING, INSTALLING OR USING.
+//
+//  By downloading, copying, installing or using the software you agree to this license.
+//  If you do not agree to this license, do not download, install,
+//  copy or use the software.
+//
+//
+//                           License Agreement
+//                For Open Source Computer Vision Library
+//
+// Copyright (C) 2000-2008, Intel Corporation, all rights reserved.
+// Copyright (C) 2009-2011, Willow Garage Inc., all rights reserved.
+// Third party copyrights are property of their respective owners.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+//   * Redistribution's of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//
+//   * Redistribution's in binary form must reproduce the above copyright notice,
+//     this list of conditions and the following disclaimer in the documentation
+//     and/or other materials provided with the distribution.
+//
+//   * The name of the copyright holders may not be used to endorse or promote products
+//     derived from this software without specific prior written permission.
+//
+// This software is provided by the copyright holders and contributors "as is" and
+// any express or implied warranties, including, but not limited to, the implied
+// warranties of merchantability and fitness for a particular purpose are disclaimed.
+// In no event shall the Intel Corporation or contributors be liable for any direct,
+// indirect, incidental, special, exemplary, or consequential damages
+// (including, but not limited to, procurement of substitute goods or services;
+// loss of use, data, or profits; or business interruption) however caused
+// and on any theory of liability, whether in contract, strict liability,
+// or tort (including negligence or otherwise) arising in any way out of
+// the use of this software, even if advised of the possibility of such damage.
+//
+//M*/
+
+#include "precomp.hpp"
+
+#ifdef HAVE_WORKSTEALING_PF
+
+#include <algorithm>
+#include <deque>
+#include <pthread.h>
+#include <sched.h>
+
+/*
+   Work-stealing parallel_for_ backend.
+
+   Every worker thread owns a deque of tasks, where a task is a contiguous range of stripes of one
+   parallel_for_ call (a "job"). A thread that starts processing a task splits it in halves, pushes
+   the upper halves to the back of its own deque and executes the smallest remaining piece itself.
+   The owner takes tasks from the back of its deque (most recent and smallest, best cache locality),
+   idle threads steal from the front of other deques (oldest and largest pieces).
+
+   Threads that are not part of the pool (the application threads) push their tasks to a shared
+   deque, so several application threads can run parallel_for_ concurrently without serializing
+   each other. A parallel_for_ called from inside a loop body is not serialized either: the calling
+   thread pushes the nested job to its own deque and the idle workers steal pieces of it.
+
+   While a thread waits for completion of its job it helps executing the pieces of the same job
+   only. Executing unrelated tasks inside a loop body could deadlock if the body holds a lock that
+   the other task also needs.
+*/
+
+namespace cv
+{
+
+struct WSJob
+{
+    WSJob(const cv::Range& _range, const cv::ParallelLoopBody& _body, int _nstripes)
+        : body(&_body), range(_range), nstripes(_nstripes), remaining(_nstripes), done(false)
+    {
+        pthread_mutex_init(&mutex, NULL);
+        pthread_cond_init(&cond_done, NULL);
+    }
+
+    ~WSJob()
+    {
+        pthread_cond_destroy(&cond_done);
+        pthread_mutex_destroy(&mutex);
+    }
+
+    //maps [stripe_start, stripe_end) to the original range the same way as other frameworks do
+    void execute(int stripe_start, int stripe_end) const
+    {
+        int len = range.end - range.start;
+        cv::Range r;
+        r.start = (int)(range.start + ((uint64)stripe_start*len + nstripes/2)/nstripes);
+        r.end = stripe_end >= nstripes ? range.end :
+                (int)(range.start + ((uint64)stripe_end*len + nstripes/2)/nstripes);
+        if( r.start < r.end )
+            (*body)(r);
+    }
+
+    const cv::ParallelLoopBody* body;
+    cv::Range range;
+    int nstripes;
+
+    //number of stripes not processed yet
+    volatile int remaining;
+
+    bool done;
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond_done;
+
+private:
+    WSJob(const WSJob&);
+    WSJob& operator=(const WSJob&);
+};
+
+struct WSTask
+{
+    WSTask() : job(0), start(0), end(0) {}
+    WSTask(WSJob* _job, int _start, int _end) : job(_job), start(_start), end(_end) {}
+
+    WSJob* job;
+    int start;
+    int end;
+};
+
+class WSDeque
+{
+public:
+    WSDeque()
+    {
+        pthread_mutex_init(&m_mutex, NULL);
+    }
+
+    ~WSDeque()
+    {
+        pthread_mutex_destroy(&m_mutex);
+    }
+
+    void push(const WSTask& task)
+    {
+        pthread_mutex_lock(&m_mutex);
+        m_tasks.push_back(task);
+        pthread_mutex_unlock(&m_mutex);
+    }
+
+    //called by the owner; if job is not NULL, only a task of this job is taken
+    bool pop(WSTask& task, const WSJob* job)
+    {
+        bool res = false;
+        pthread_mutex_lock(&m_mutex);
+        if( !m_tasks.empty() && (!job || m_tasks.back().job == job) )
+        {
+            task = m_tasks.back();
+            m_tasks.pop_back();
+            res = true;
+        }
+        pthread_mutex_unlock(&m_mutex);
+        return res;
+    }
+
+    //called by the other threads; if job is not NULL, only a task of this job is taken
+    bool steal(WSTask& task, const WSJob* job)
+    {
+        bool res = false;
+        pthread_mutex_lock(&m_mutex);
+        if( !m_tasks.empty() && (!job || m_tasks.front().job == job) )
+        {
+            task = m_tasks.front();
+            m_tasks.pop_front();
+            res = true;
+        }
+        pthread_mutex_unlock(&m_mutex);
+        return res;
+    }
+
+private:
+    std::deque<WSTask> m_tasks;
+    pthread_mutex_t m_mutex;
+
+    WSDeque(const WSDeque&);
+    WSDeque& operator=(const WSDeque&);
+};
+
+class WSThreadPool;
+
+struct WSWorker
+{
+    WSWorker(WSThreadPool* _pool, int _id) : pool(_pool), id(_id), started(false), numa_node(0), numa_generation(0) {}
+
+    WSThreadPool* pool;
+    int id;
+    bool started;
+    volatile int numa_node;
+    int numa_generation;
+    pthread_t posix_thread;
+    WSDeque tasks;
+};
+
+class WSThreadPool
+{
+public:
+    static WSThreadPool& instance()
+    {
+        CV_SINGLETON_LAZY_INIT_REF(WSThreadPool, new WSThreadPool())
+    }
+
+    void run(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes);
+
+    size_t getNumOfThreads() const { return m_num_threads; }
+
+    void setNumOfThreads(size_t n);
+
+    //zero for the threads not belonging to the pool, 1..N-1 for the workers
+    int getThreadNum() const { return m_worker_id.get()->value + 1; }
+
+private:
+    WSThreadPool();
+
+    ~WSThreadPool();
+
+    bool initPool();
+
+    void stopPool();
+
+    void joinWorkers();
+
+    size_t defaultNumberOfThreads() const;
+
+    WSDeque& currentDeque(int worker_id) { return worker_id >= 0 ? m_workers[worker_id]->tasks : m_shared; }
+
+    void push(WSDeque& queue, const WSTask& task);
+
+    void process(WSDeque& queue, WSTask task);
+
+    bool findTask(int worker_id, WSTask& task, const WSJob* job);
+
+    void wait(int worker_id, WSJob& job);
+
+    static void* thread_loop_wrapper(void* worker);
+
+    void thread_body(WSWorker& worker);
+
+    std::vector<WSWorker*> m_workers;
+    size_t m_num_threads;
+    bool m_pool_inited;
+
+    //application threads put their tasks here
+    WSDeque m_shared;
+
+    //number of tasks in all the deques
+    volatile int m_queued;
+    volatile int m_sleeping;
+    volatile bool m_stop;
+
+    pthread_mutex_t m_sleep_mutex;
+    pthread_cond_t  m_cond_wakeup;
+
+    pthread_mutex_t m_pool_mutex;
+
+    static const char m_env_name[];
+
+    struct worker_id_t
+    {
+        worker_id_t(): value(-1) { }
+        int value;
+    };
+
+    cv::TLSData<worker_id_t> m_worker_id;
+};
+
+const char WSThreadPool::m_env_name[] = "OPENCV_FOR_THREADS_NUM";
+
+WSThreadPool::WSThreadPool() : m_num_threads(1), m_pool_inited(false), m_queued(0), m_sleeping(0), m_stop(false)
+{
+    pthread_mutex_init(&m_sleep_mutex, NULL);
+    pthread_cond_init(&m_cond_wakeup, NULL);
+    pthread_mutex_init(&m_pool_mutex, NULL);
+
+    m_num_threads = defaultNumberOfThreads();
+}
+
+WSThreadPool::~WSThreadPool()
+{
+    stopPool();
+
+    pthread_mutex_destroy(&m_pool_mutex);
+    pthread_cond_destroy(&m_cond_wakeup);
+    pthread_mutex_destroy(&m_sleep_mutex);
+}
+
+size_t WSThreadPool::defaultNumberOfThreads() const
+{
+    unsigned int result = (unsigned int)std::max(cv::getNumberOfCPUs(), 1);
+
+    char* env = getenv(m_env_name);
+
+    if(env != NULL)
+    {
+        sscanf(env, "%u", &result);
+
+        result = std::max(1u, result);
+    }
+
+    return result;
+}
+
+bool WSThreadPool::initPool()
+{
+    if( m_pool_inited )
+        return true;
+
+    pthread_mutex_lock(&m_pool_mutex);
+
+    //the calling thread takes part in the computations, so N-1 workers are enough
+    size_t nworkers = m_num_threads - 1;
+
+    while( !m_pool_inited && nworkers > 0 )
+    {
+        m_stop = false;
+
+        for( size_t i = 0; i < nworkers; ++i )
+        {
+            WSWorker* worker = new WSWorker(this, (int)i);
+            m_workers.push_back(worker);
+        }
+
+        //the workers may start stealing from each other as soon as they are created,
+        //so all the deques must exist before the first thread starts
+        size_t started = 0;
+        for( ; started < nworkers; ++started )
+        {
+            WSWorker* worker = m_workers[started];
+            if( pthread_create(&worker->posix_thread, NULL, thread_loop_wrapper, (void*)worker) != 0 )
+                break;
+            worker->started = true;
+        }
+
+        //the running workers may steal from the deques of the missing ones,
+        //so the pool is recreated with as many workers as could be started
+        if( started < nworkers )
+            joinWorkers();
+        else
+            m_pool_inited = true;
+        nworkers = started;
+    }
+
+    //with no workers started the loops are run by the calling thread
+    m_num_threads = nworkers + 1;
+    bool inited = m_pool_inited;
+
+    pthread_mutex_unlock(&m_pool_mutex);
+
+    return inited;
+}
+
+//the pool mutex is held by the caller
+void WSThreadPool::joinWorkers()
+{
+    pthread_mutex_lock(&m_sleep_mutex);
+    m_stop = true;
+    pthread_cond_broadcast(&m_cond_wakeup);
+    pthread_mutex_unlock(&m_sleep_mutex);
+
+    for( size_t i = 0; i < m_workers.size(); ++i )
+    {
+        if( m_workers[i]->started )
+            pthread_join(m_workers[i]->posix_thread, NULL);
+        delete m_workers[i];
+    }
+    m_workers.clear();
+}
+
+void WSThreadPool::stopPool()
+{
+    pthread_mutex_lock(&m_pool_mutex);
+
+    if( m_pool_inited )
+    {
+        joinWorkers();
+        m_pool_inited = false;
+    }
+
+    pthread_mutex_unlock(&m_pool_mutex);
+}
+
+void WSThreadPool::setNumOfThreads(size_t n)
+{
+    if( n == 0 )
+        n = defaultNumberOfThreads();
+
+    if( n != m_num_threads )
+    {
+        stopPool();
+        m_num_threads = n;
+    }
+}
+
+void WSThreadPool::push(WSDeque& queue, const WSTask& task)
+{
+    queue.push(task);
+
+    CV_XADD(&m_queued, 1);
+
+    //both counters are modified with full barriers, so either the sleeping worker
+    //sees the new task or we see the sleeping worker
+    if( CV_XADD(&m_sleeping, 0) > 0 )
+    {
+        pthread_mutex_lock(&m_sleep_mutex);
+        pthread_cond_signal(&m_cond_wakeup);
+        pthread_mutex_unlock(&m_sleep_mutex);
+    }
+}
+
+void WSThreadPool::process(WSDeque& queue, WSTask task)
+{
+    WSJob* job = task.job;
+
+    //split on demand: leave the upper halves for the thieves, keep the smallest piece
+    while( task.end - task.start > 1 )
+    {
+        int middle = task.start + (task.end - task.start)/2;
+        push(queue, WSTask(job, middle, task.end));
+        task.end = middle;
+    }
+
+    job->execute(task.start, task.end);
+
+    int count = task.end - task.start;
+    if( CV_XADD(&job->remaining, -count) == count )
+    {
+        pthread_mutex_lock(&job->mutex);
+        job->done = true;
+        pthread_cond_broadcast(&job->cond_done);
+        pthread_mutex_unlock(&job->mutex);
+    }
+}
+
+bool WSThreadPool::findTask(int worker_id, WSTask& task, const WSJob* job)
+{
+    bool res = currentDeque(worker_id).pop(task, job);
+
+    if( !res && worker_id >= 0 )
+        res = m_shared.steal(task, job);
+
+    //in the NUMA mode the workers of the same node are robbed first
+    int node = worker_id >= 0 && getNumaNodesInUse() > 1 ? m_workers[worker_id]->numa_node : -1;
+
+    for( int pass = node >= 0 ? 0 : 1; !res && pass < 2; ++pass )
+    {
+        for( size_t i = 1; !res && i <= m_workers.size(); ++i )
+        {
+            size_t victim = (size_t)(worker_id + i) % m_workers.size();
+            if( (int)victim != worker_id && (pass > 0 || m_workers[victim]->numa_node == node) )
+                res = m_workers[victim]->tasks.steal(task, job);
+        }
+    }
+
+    if( res )
+        CV_XADD(&m_queued, -1);
+
+    return res;
+}
+
+void WSThreadPool::wait(int worker_id, WSJob& job)
+{
+    WSDeque& queue = currentDeque(worker_id);
+    WSTask task;
+
+    while( job.remaining > 0 && findTask(worker_id, task, &job) )
+        process(queue, task);
+
+    //the rest of the job is being processed by the other threads
+    pthread_mutex_lock(&job.mutex);
+    while( !job.done )
+        pthread_cond_wait(&job.cond_done, &job.mutex);
+    pthread_mutex_unlock(&job.mutex);
+}
+
+void* WSThreadPool::thread_loop_wrapper(void* worker)
+{
+    WSWorker* w = (WSWorker*)worker;
+    w->pool->thread_body(*w);
+    return 0;
+}
+
+void WSThreadPool::thread_body(WSWorker& worker)
+{
+    const int max_spin_count = 64;
+
+    m_worker_id.get()->value = worker.id;
+
+    int spin_count = 0;
+
+    for(;;)
+    {
+        WSTask task;
+
+        //the calling thread is not bound to any node, so the workers are distributed as if it were the last one
+        worker.numa_node = updateNumaAffinity(worker.id, (int)m_num_threads, worker.numa_generation);
+
+        if( findTask(worker.id, task, NULL) )
+        {
+            process(worker.tasks, task);
+            spin_count = 0;
+            continue;
+        }
+
+        if( spin_count < max_spin_count && !m_stop )
+        {
+            ++spin_count;
+            sched_yield();
+            continue;
+        }
+
+        pthread_mutex_lock(&m_sleep_mutex);
+
+        if( m_stop && m_queued == 0 )
+        {
+            pthread_mutex_unlock(&m_sleep_mutex);
+            break;
+        }
+
+        CV_XADD(&m_sleeping, 1);
+
+        while( m_queued == 0 && !m_stop )
+            pthread_cond_wait(&m_cond_wakeup, &m_sleep_mutex);
+
+        CV_XADD(&m_sleeping, -1);
+
+        pthread_mutex_unlock(&m_sleep_mutex);
+
+        spin_count = 0;
+    }
+}
+
+void WSThreadPool::run(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes)
+{
+    int len = range.end - range.start;
+
+    if( m_num_threads <= 1 || len <= 1 || (nstripes > 0 && nstripes < 1.5) || !initPool() )
+    {
+        body(range);
+        return;
+    }
+
+    if( nstripes <= 0 )
+        nstripes = 4.*m_num_threads;
+
+    int stripes = std::min(cvCeil(nstripes), len);
+
+    WSJob job(range, body, stripes);
+
+    int worker_id = m_worker_id.get()->value;
+
+    process(currentDeque(worker_id), WSTask(&job, 0, stripes));
+
+    wait(worker_id, job);
+}
+
+size_t parallel_workstealing_get_threads_num();
+void parallel_workstealing_set_threads_num(int num);
+int parallel_workstealing_get_thread_num();
+void parallel_for_workstealing(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes);
+
+size_t parallel_workstealing_get_threads_num()
+{
+    return WSThreadPool::instance().getNumOfThreads();
+}
+
+void parallel_workstealing_set_threads_num(int num)
+{
+    WSThreadPool::instance().setNumOfThreads(num < 0 ? 0 : size_t(num));
+}
+
+int parallel_workstealing_get_thread_num()
+{
+    return WSThreadPool::instance().getThreadNum();
+}
+
+void parallel_for_workstealing(const cv::Range& range, const cv::ParallelLoopBody& body, double nstripes)
+{
+    WSThreadPool::instance().run(range, body, nstripes);
+}
+
+}
+
+#endif
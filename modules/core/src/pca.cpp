@@ -97,8 +97,6 @@ PCA& PCA::operator()(InputArray _data, InputArray __mean, int flags, int maxComp
     int ctype = std::max(CV_32F, data.depth());
     mean.create( mean_sz, ctype );
 
-    Mat covar( count, count, ctype );
-
     if( !_mean.empty() )
     {
         CV_Assert( _mean.size() == mean_sz );
@@ -106,6 +104,23 @@ PCA& PCA::operator()(InputArray _data, InputArray __mean, int flags, int maxComp
         covar_flags |= CV_COVAR_USE_AVG;
     }
 
+    if( (flags & PCA::RANDOMIZED) && out_count < count )
+    {
+        // the eigenvectors of the covariance matrix are the right singular vectors
+        // of the centered samples stored as rows, eigenvalue = singular_value^2/in_count
+        Mat centered, w;
+        data.convertTo( centered, ctype );
+        if( _mean.empty() )
+            reduce( centered, mean, (flags & CV_PCA_DATA_AS_COL) ? 1 : 0, REDUCE_AVG, ctype );
+        subtract( centered, repeat(mean, data.rows/mean.rows, data.cols/mean.cols), centered );
+        if( flags & CV_PCA_DATA_AS_COL )
+            centered = centered.t();
+        SVDecompTruncated( centered, out_count, w, noArray(), eigenvectors );
+        multiply( w, w, eigenvalues, 1./in_count );
+        return *this;
+    }
+
+    Mat covar( count, count, ctype );
     calcCovarMatrix( data, covar, mean, covar_flags, ctype );
     eigen( covar, eigenvalues, eigenvectors );
 
@@ -347,6 +362,111 @@ Mat PCA::backProject(InputArray data) const
     return result;
 }
 
+PCAAccumulator::PCAAccumulator() : count(0), depth(CV_32F) {}
+
+void PCAAccumulator::clear()
+{
+    count = 0;
+    mean.release();
+    scatter.release();
+    depth = CV_32F;
+}
+
+void PCAAccumulator::add(InputArray _data, int flags)
+{
+    Mat data = _data.getMat();
+    CV_Assert( data.channels() == 1 && (data.depth() == CV_32F || data.depth() == CV_64F) );
+    if( data.empty() )
+        return;
+
+    // the statistics of the batch are computed in double precision and then merged
+    PCAAccumulator batch;
+    Mat samples, centered;
+    if( flags & CV_PCA_DATA_AS_COL )
+        transpose(data, samples);
+    else
+        samples = data;
+    batch.count = samples.rows;
+    batch.depth = samples.depth();
+    reduce(samples, batch.mean, 0, REDUCE_AVG, CV_64F);
+
+    samples.convertTo(centered, CV_64F);
+    subtract(centered, repeat(batch.mean, samples.rows, 1), centered);
+    gemm(centered, centered, 1, noArray(), 0, batch.scatter, GEMM_1_T);
+
+    merge(batch);
+}
+
+void PCAAccumulator::merge(const PCAAccumulator& other)
+{
+    if( other.count == 0 )
+        return;
+    depth = std::max(depth, other.depth);
+    if( count == 0 )
+    {
+        count = other.count;
+        other.mean.copyTo(mean);
+        other.scatter.copyTo(scatter);
+        return;
+    }
+    CV_Assert( other.mean.size() == mean.size() && other.scatter.size() == scatter.size() );
+
+    // n = na + nb, mean = mean_a + delta*nb/n, scatter = scatter_a + scatter_b + delta'*delta*na*nb/n,
+    // where delta = mean_b - mean_a
+    double na = (double)count, nb = (double)other.count, n = na + nb;
+    Mat delta = other.mean - mean;
+    scaleAdd(delta, nb/n, mean, mean);
+    scatter += other.scatter;
+    gemm(delta, delta, na*nb/n, scatter, 1, scatter, GEMM_1_T);
+    count += other.count;
+}
+
+static int computeAccumulatedPCA( const PCAAccumulator& acc, PCA& pca, int flags )
+{
+    CV_Assert( acc.count > 0 );
+    Mat covar = acc.scatter*(1./acc.count), evals, evects;
+    eigen(covar, evals, evects);
+
+    evals.convertTo(pca.eigenvalues, acc.depth);
+    evects.convertTo(pca.eigenvectors, acc.depth);
+    if( flags & CV_PCA_DATA_AS_COL )
+        transpose(acc.mean, pca.mean);
+    else
+        acc.mean.copyTo(pca.mean);
+    pca.mean.convertTo(pca.mean, acc.depth);
+
+    // there is no more components than the samples
+    return (int)std::min((int64)evals.rows, acc.count);
+}
+
+void PCAAccumulator::compute(PCA& pca, int flags, int maxComponents) const
+{
+    int out_count = computeAccumulatedPCA(*this, pca, flags);
+    if( maxComponents > 0 )
+        out_count = std::min(out_count, maxComponents);
+
+    if( out_count < pca.eigenvalues.rows )
+    {
+        pca.eigenvalues = pca.eigenvalues.rowRange(0, out_count).clone();
+        pca.eigenvectors = pca.eigenvectors.rowRange(0, out_count).clone();
+    }
+}
+
+void PCAAccumulator::compute(PCA& pca, int flags, double retainedVariance) const
+{
+    CV_Assert( retainedVariance > 0 && retainedVariance <= 1 );
+    int out_count = computeAccumulatedPCA(*this, pca, flags);
+    int L = depth == CV_32F ? computeCumulativeEnergy<float>(pca.eigenvalues, retainedVariance) :
+                              computeCumulativeEnergy<double>(pca.eigenvalues, retainedVariance);
+    L = std::min(L, out_count);
+
+    if( L < pca.eigenvalues.rows )
+    {
+        pca.eigenvalues = pca.eigenvalues.rowRange(0, L).clone();
+        pca.eigenvectors = pca.eigenvectors.rowRange(0, L).clone();
+    }
+}
+
 }
 
 void cv::PCACompute(InputArray data, InputOutputArray mean,
@@ -46,6 +46,15 @@
 #include <deque>
 #include <iterator>
 
+#if defined _WIN32 && !defined WINRT
+#  include <windows.h>
+#elif defined __unix__ || defined __APPLE__
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#endif
+
 #define USE_ZLIB 1
 
 #ifdef __APPLE__
@@ -239,6 +248,13 @@ typedef struct CvFileStorage
     std::deque<char>* outbuf;
 
     bool is_opened;
+
+    // binary container: the text part is kept in outbuf and written after the raw blocks
+    bool is_binary;
+    int64 rawpos;
+    // the mapped file the raw blocks are read from
+    struct CvFileStorageMapping* mapping;
+    size_t rawsize;
 }
 CvFileStorage;
 
@@ -325,11 +341,210 @@ static void icvRewind( CvFileStorage* fs )
     fs->strbufpos = 0;
 }
 
+/****************************************************************************************\
+*                     Binary container with the memory-mapped raw blocks                 *
+\****************************************************************************************/
+
+/*
+  The binary container (CV_STORAGE_FORMAT_BINARY) keeps the data of the matrices as raw blocks
+  and the rest of the document in the usual YAML form:
+
+    the header (64 bytes): the signature, the byte order mark, the offset and the size of the text;
+    the raw blocks, each is aligned to CV_FS_BINARY_ALIGN bytes;
+    the YAML document, where the matrices refer to their data with "block: <offset/CV_FS_BINARY_ALIGN>".
+
+  The file is memory-mapped for reading, so the matrices returned by cv::read() reference the mapped
+  pages (copy-on-write) and only the pages which are actually accessed are loaded.
+*/
+
+#define CV_FS_BINARY_SIGNATURE "%OPENCV-BIN:1.0\n"
+#define CV_FS_BINARY_SIGNATURE_LEN 16
+#define CV_FS_BINARY_HEADER_SIZE 64
+#define CV_FS_BINARY_ALIGN 64
+#define CV_FS_BINARY_BYTE_ORDER 0x01020304
+
+typedef struct CvFileStorageBinaryHeader
+{
+    char signature[CV_FS_BINARY_SIGNATURE_LEN];
+    unsigned byte_order;
+    unsigned reserved;
+    uint64 text_offset;
+    uint64 text_size;
+    char pad[CV_FS_BINARY_HEADER_SIZE - CV_FS_BINARY_SIGNATURE_LEN - 24];
+}
+CvFileStorageBinaryHeader;
+
+struct CvFileStorageMapping
+{
+    uchar* data;
+    size_t size;
+    int refcount;
+};
+
+static CvFileStorageMapping* icvMapFile( const char* filename )
+{
+    uchar* data = 0;
+    size_t size = 0;
+#if defined _WIN32 && !defined WINRT
+    HANDLE file = CreateFileA( filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL, NULL );
+    if( file == INVALID_HANDLE_VALUE )
+        return 0;
+    LARGE_INTEGER fsize;
+    HANDLE mapping = 0;
+    if( GetFileSizeEx( file, &fsize ) && fsize.QuadPart > 0 && (uint64)fsize.QuadPart <= (uint64)(size_t)-1 )
+    {
+        size = (size_t)fsize.QuadPart;
+        mapping = CreateFileMappingA( file, NULL, PAGE_WRITECOPY, 0, 0, NULL );
+    }
+    if( mapping )
+    {
+        data = (uchar*)MapViewOfFile( mapping, FILE_MAP_COPY, 0, 0, 0 );
+        CloseHandle( mapping );
+    }
+    CloseHandle( file );
+#elif defined __unix__ || defined __APPLE__
+    int fd = open( filename, O_RDONLY );
+    if( fd < 0 )
+        return 0;
+    struct stat st;
+    if( fstat( fd, &st ) == 0 && st.st_size > 0 && (uint64)st.st_size <= (uint64)(size_t)-1 )
+    {
+        size = (size_t)st.st_size;
+        // private writable mapping: the pages modified by the user are copied, the file is not changed
+        void* ptr = mmap( 0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+        data = ptr != MAP_FAILED ? (uchar*)ptr : 0;
+    }
+    close( fd );
+#else
+    FILE* f = fopen( filename, "rb" );
+    if( !f )
+        return 0;
+    fseek( f, 0, SEEK_END );
+    long fsize = ftell( f );
+    fseek( f, 0, SEEK_SET );
+    if( fsize > 0 )
+    {
+        size = (size_t)fsize;
+        data = (uchar*)malloc( size );
+        if( data && fread( data, 1, size, f ) != size )
+        {
+            free( data );
+            data = 0;
+        }
+    }
+    fclose( f );
+#endif
+    if( !data )
+        return 0;
+    CvFileStorageMapping* m = new CvFileStorageMapping;
+    m->data = data;
+    m->size = size;
+    m->refcount = 1;
+    return m;
+}
+
+static void icvReleaseMapping( CvFileStorageMapping* m )
+{
+    if( !m || CV_XADD(&m->refcount, -1) != 1 )
+        return;
+#if defined _WIN32 && !defined WINRT
+    UnmapViewOfFile( m->data );
+#elif defined __unix__ || defined __APPLE__
+    munmap( m->data, m->size );
+#else
+    free( m->data );
+#endif
+    delete m;
+}
+
+static bool icvIsBinaryStorage( FILE* f )
+{
+    char buf[CV_FS_BINARY_SIGNATURE_LEN];
+    bool ok = fread( buf, 1, sizeof(buf), f ) == sizeof(buf) &&
+              memcmp( buf, CV_FS_BINARY_SIGNATURE, CV_FS_BINARY_SIGNATURE_LEN ) == 0;
+    rewind( f );
+    return ok;
+}
+
+// checks the header of the mapped container and returns the location of the text part
+static bool icvOpenBinaryStorage( CvFileStorage* fs )
+{
+    CvFileStorageMapping* m = fs->mapping;
+    CvFileStorageBinaryHeader hdr;
+    if( m->size < sizeof(hdr) )
+        return false;
+    memcpy( &hdr, m->data, sizeof(hdr) );
+    if( memcmp( hdr.signature, CV_FS_BINARY_SIGNATURE, CV_FS_BINARY_SIGNATURE_LEN ) != 0 )
+        return false;
+    if( hdr.byte_order != CV_FS_BINARY_BYTE_ORDER )
+        CV_Error( CV_StsNotImplemented, "The binary storage was written on a platform with a different byte order" );
+    if( hdr.text_offset < sizeof(hdr) || hdr.text_offset > m->size || hdr.text_size > m->size - hdr.text_offset )
+        CV_Error( CV_StsParseError, "The binary storage is corrupted" );
+    fs->strbuf = (const char*)m->data + hdr.text_offset;
+    fs->strbufsize = (size_t)hdr.text_size;
+    fs->strbufpos = 0;
+    fs->rawsize = (size_t)hdr.text_offset;
+    return true;
+}
+
+static void icvWriteRawBytes( CvFileStorage* fs, const void* data, size_t size )
+{
+    if( size > 0 && fwrite( data, 1, size, fs->file ) != size )
+        CV_Error( CV_StsError, "Could not write the raw data block" );
+    fs->rawpos += size;
+}
+
+// aligns the position of the next raw block and returns its index
+static int icvStartRawBlock( CvFileStorage* fs )
+{
+    static const char zeros[CV_FS_BINARY_ALIGN] = {0};
+    icvWriteRawBytes( fs, zeros, (size_t)(-fs->rawpos & (CV_FS_BINARY_ALIGN - 1)) );
+    int64 block = fs->rawpos / CV_FS_BINARY_ALIGN;
+    if( block > INT_MAX )
+        CV_Error( CV_StsOutOfRange, "The binary storage is too large" );
+    return (int)block;
+}
+
+// writes the text part after the raw blocks and completes the header
+static void icvFinishBinaryStorage( CvFileStorage* fs )
+{
+    CvFileStorageBinaryHeader hdr;
+    memset( &hdr, 0, sizeof(hdr) );
+    memcpy( hdr.signature, CV_FS_BINARY_SIGNATURE, CV_FS_BINARY_SIGNATURE_LEN );
+    hdr.byte_order = CV_FS_BINARY_BYTE_ORDER;
+    hdr.text_offset = (uint64)icvStartRawBlock( fs )*CV_FS_BINARY_ALIGN;
+    hdr.text_size = fs->outbuf->size();
+
+    std::vector<char> text(fs->outbuf->begin(), fs->outbuf->end());
+    if( !text.empty() )
+        icvWriteRawBytes( fs, &text[0], text.size() );
+    fseek( fs->file, 0, SEEK_SET );
+    if( fwrite( &hdr, 1, sizeof(hdr), fs->file ) != sizeof(hdr) )
+        CV_Error( CV_StsError, "Could not write the header of the binary storage" );
+}
+
+// returns the raw block of the given size referenced by the "block" node
+static uchar* icvGetRawBlock( CvFileStorage* fs, const CvFileNode* node, size_t size )
+{
+    if( !fs->mapping )
+        CV_Error( CV_StsParseError, "The raw data blocks are only supported in the binary storage" );
+    if( !CV_NODE_IS_INT(node->tag) || node->data.i < 0 )
+        CV_Error( CV_StsParseError, "Invalid raw data block" );
+    uint64 ofs = (uint64)node->data.i*CV_FS_BINARY_ALIGN;
+    if( ofs < CV_FS_BINARY_HEADER_SIZE || ofs > fs->rawsize || size > fs->rawsize - ofs )
+        CV_Error( CV_StsParseError, "The raw data block is out of the file" );
+    return fs->mapping->data + ofs;
+}
+
 #define CV_YML_INDENT  3
 #define CV_XML_INDENT  2
 #define CV_YML_INDENT_FLOW  1
 #define CV_FS_MAX_LEN 4096
 
+// the internal flag of cvOpenFileStorage: open the file for cv::FileStreamReader without parsing it
+#define CV_FS_STREAM_READER (1 << 16)
+
 #define CV_FILE_STORAGE ('Y' + ('A' << 8) + ('M' << 16) + ('L' << 24))
 #define CV_IS_FILE_STORAGE(fs) ((fs) != 0 && (fs)->flags == CV_FILE_STORAGE)
 
@@ -530,6 +745,8 @@ icvClose( CvFileStorage* fs, cv::String* out )
             icvFSFlush(fs);
             if( fs->fmt == CV_STORAGE_FORMAT_XML )
                 icvPuts( fs, "</opencv_storage>\n" );
+            if( fs->is_binary && fs->file )
+                icvFinishBinaryStorage(fs);
         }
 
         icvCloseFile(fs);
@@ -562,6 +779,7 @@ cvReleaseFileStorage( CvFileStorage** p_fs )
 
         if( fs->outbuf )
             delete fs->outbuf;
+        icvReleaseMapping( fs->mapping );
 
         memset( fs, 0, sizeof(*fs) );
         cvFree( &fs );
@@ -636,7 +854,7 @@ cvGetFileNode( CvFileStorage* fs, CvFileNode* _map_node,
     if( !key )
         CV_Error( CV_StsNullPtr, "Null key element" );
 
-    if( _map_node )
+    if( !_map_node )
     {
         if( !fs->roots )
             return 0;
@@ -2656,6 +2874,7 @@ cvOpenFileStorage( const char* filename, CvMemStorage* dststorage, int flags, co
     bool mem = (flags & CV_STORAGE_MEMORY) != 0;
     bool write_mode = (flags & 3) != 0;
     bool isGZ = false;
+    bool binary = write_mode && (flags & CV_STORAGE_FORMAT_MASK) == CV_STORAGE_FORMAT_BINARY;
     size_t fnamelen = 0;
 
     if( !filename || filename[0] == '\0' )
@@ -2669,6 +2888,8 @@ cvOpenFileStorage( const char* filename, CvMemStorage* dststorage, int flags, co
 
     if( mem && append )
         CV_Error( CV_StsBadFlag, "CV_STORAGE_APPEND and CV_STORAGE_MEMORY are not currently compatible" );
+    if( mem && binary )
+        CV_Error( CV_StsBadFlag, "The binary storage can only be written to a file" );
 
     fs = (CvFileStorage*)cvAlloc( sizeof(*fs) );
     memset( fs, 0, sizeof(*fs));
@@ -2701,11 +2922,42 @@ cvOpenFileStorage( const char* filename, CvMemStorage* dststorage, int flags, co
                 dot_pos[3] = '\0', fnamelen--;
         }
 
+        if( write_mode && (flags & CV_STORAGE_FORMAT_MASK) == CV_STORAGE_FORMAT_AUTO )
+        {
+            const char* ext = ".cvbin";
+            size_t extlen = strlen(ext);
+            binary = fnamelen >= extlen && strcmp( fs->filename + fnamelen - extlen, ext ) == 0;
+        }
+        if( binary && (append || isGZ) )
+        {
+            cvReleaseFileStorage( &fs );
+            CV_Error( CV_StsNotImplemented, "The binary storage can not be appended or compressed" );
+        }
+
         if( !isGZ )
         {
-            fs->file = fopen(fs->filename, !fs->write_mode ? "rt" : !append ? "wt" : "a+t" );
+            fs->file = fopen(fs->filename, !fs->write_mode ? "rt" : binary ? "wb" : !append ? "wt" : "a+t" );
             if( !fs->file )
                 goto _exit_;
+            if( !fs->write_mode && icvIsBinaryStorage( fs->file ) )
+            {
+                fclose( fs->file );
+                fs->file = 0;
+                fs->mapping = icvMapFile( fs->filename );
+                bool ok = false;
+                try
+                {
+                    ok = fs->mapping && icvOpenBinaryStorage( fs );
+                }
+                catch (...)
+                {
+                    cvReleaseFileStorage( &fs );
+                    throw;
+                }
+                if( !ok )
+                    goto _exit_;
+                binary = true;
+            }
         }
         else
         {
@@ -2730,10 +2982,19 @@ cvOpenFileStorage( const char* filename, CvMemStorage* dststorage, int flags, co
     {
         int fmt = flags & CV_STORAGE_FORMAT_MASK;
 
-        if( mem )
+        if( mem || binary )
             fs->outbuf = new std::deque<char>;
 
-        if( fmt == CV_STORAGE_FORMAT_AUTO && filename )
+        if( binary )
+        {
+            // the text part of the binary storage is YAML
+            CvFileStorageBinaryHeader hdr;
+            memset( &hdr, 0, sizeof(hdr) );
+            icvWriteRawBytes( fs, &hdr, sizeof(hdr) );
+            fs->is_binary = true;
+            fs->fmt = CV_STORAGE_FORMAT_YAML;
+        }
+        else if( fmt == CV_STORAGE_FORMAT_AUTO && filename )
         {
             const char* dot_pos = filename + fnamelen - (isGZ ? 7 : 4);
             fs->fmt = (dot_pos >= filename && (memcmp( dot_pos, ".xml", 4) == 0 ||
@@ -2851,6 +3112,7 @@ cvOpenFileStorage( const char* filename, CvMemStorage* dststorage, int flags, co
             fs->strbuf = filename;
             fs->strbufsize = fnamelen;
         }
+        fs->is_binary = binary;
 
         size_t buf_size = 1 << 20;
         const char* yaml_signature = "%YAML:";
@@ -2861,7 +3123,7 @@ cvOpenFileStorage( const char* filename, CvMemStorage* dststorage, int flags, co
 
         if( !isGZ )
         {
-            if( !mem )
+            if( !mem && !binary )
             {
                 fseek( fs->file, 0, SEEK_END );
                 buf_size = ftell( fs->file );
@@ -2884,6 +3146,13 @@ cvOpenFileStorage( const char* filename, CvMemStorage* dststorage, int flags, co
         fs->buffer[0] = '\n';
         fs->buffer[1] = '\0';
 
+        // FileStreamReader parses the file itself
+        if( flags & CV_FS_STREAM_READER )
+        {
+            fs->is_opened = true;
+            return fs;
+        }
+
         //mode = cvGetErrMode();
         //cvSetErrMode( CV_ErrModeSilent );
         try
@@ -3511,9 +3780,22 @@ icvWriteMat( CvFileStorage* fs, const char* name,
     cvWriteInt( fs, "rows", mat->rows );
     cvWriteInt( fs, "cols", mat->cols );
     cvWriteString( fs, "dt", icvEncodeFormat( CV_MAT_TYPE(mat->type), dt ), 0 );
-    cvStartWriteStruct( fs, "data", CV_NODE_SEQ + CV_NODE_FLOW );
 
     size = cvGetSize(mat);
+    if( fs->is_binary )
+    {
+        cvWriteInt( fs, "block", icvStartRawBlock( fs ));
+        if( mat->data.ptr )
+        {
+            size_t esz = CV_ELEM_SIZE(mat->type);
+            for( y = 0; y < size.height; y++ )
+                icvWriteRawBytes( fs, mat->data.ptr + (size_t)y*mat->step, size.width*esz );
+        }
+        cvEndWriteStruct( fs );
+        return;
+    }
+
+    cvStartWriteStruct( fs, "data", CV_NODE_SEQ + CV_NODE_FLOW );
     if( size.height > 0 && size.width > 0 && mat->data.ptr )
     {
         if( CV_IS_MAT_CONT(mat->type) )
@@ -3558,7 +3840,19 @@ icvReadMat( CvFileStorage* fs, CvFileNode* node )
 
     data = cvGetFileNodeByName( fs, node, "data" );
     if( !data )
-        CV_Error( CV_StsError, "The matrix data is not found in file storage" );
+    {
+        CvFileNode* block = cvGetFileNodeByName( fs, node, "block" );
+        if( !block )
+            CV_Error( CV_StsError, "The matrix data is not found in file storage" );
+        mat = rows > 0 && cols > 0 ? cvCreateMat( rows, cols, elem_type ) :
+            rows == 0 && cols == 0 ? cvCreateMatHeader( 0, 1, elem_type ) : cvCreateMatHeader( rows, cols, elem_type );
+        if( mat->data.ptr )
+        {
+            size_t size = (size_t)rows*cols*CV_ELEM_SIZE(elem_type);
+            memcpy( mat->data.ptr, icvGetRawBlock( fs, block, size ), size );
+        }
+        return mat;
+    }
 
     int nelems = icvFileNodeSeqLen( data );
     if( nelems > 0 && nelems != rows*cols*CV_MAT_CN(elem_type) )
@@ -3607,6 +3901,20 @@ icvWriteMatND( CvFileStorage* fs, const char* name,
     cvWriteRawData( fs, sizes, dims, "i" );
     cvEndWriteStruct( fs );
     cvWriteString( fs, "dt", icvEncodeFormat( cvGetElemType(mat), dt ), 0 );
+    if( fs->is_binary )
+    {
+        cvWriteInt( fs, "block", icvStartRawBlock( fs ));
+        if( mat->dim[0].size > 0 && mat->data.ptr )
+        {
+            size_t esz = CV_ELEM_SIZE(mat->type);
+            cvInitNArrayIterator( 1, (CvArr**)&mat, 0, &stub, &iterator );
+            do
+                icvWriteRawBytes( fs, iterator.ptr[0], iterator.size.width*esz );
+            while( cvNextNArraySlice( &iterator ));
+        }
+        cvEndWriteStruct( fs );
+        return;
+    }
     cvStartWriteStruct( fs, "data", CV_NODE_SEQ + CV_NODE_FLOW );
 
     if( mat->dim[0].size > 0 && mat->data.ptr )
@@ -3649,14 +3957,23 @@ icvReadMatND( CvFileStorage* fs, CvFileNode* node )
     elem_type = icvDecodeSimpleFormat( dt );
 
     data = cvGetFileNodeByName( fs, node, "data" );
-    if( !data )
+    CvFileNode* block = data ? 0 : cvGetFileNodeByName( fs, node, "block" );
+    if( !data && !block )
         CV_Error( CV_StsError, "The matrix data is not found in file storage" );
 
-
-
     for( total_size = CV_MAT_CN(elem_type), i = 0; i < dims; i++ )
         total_size *= sizes[i];
 
+    if( block )
+    {
+        if( total_size == 0 )
+            return cvCreateMatNDHeader( dims, sizes, elem_type );
+        mat = cvCreateMatND( dims, sizes, elem_type );
+        size_t size = (size_t)total_size*CV_ELEM_SIZE1(elem_type);
+        memcpy( mat->data.ptr, icvGetRawBlock( fs, block, size ), size );
+        return mat;
+    }
+
     int nelems = icvFileNodeSeqLen( data );
 
     if( nelems > 0 && nelems != total_size )
@@ -5182,7 +5499,7 @@ void FileStorage::release()
 String FileStorage::releaseAndGetString()
 {
     String buf;
-    if( fs && fs->outbuf )
+    if( fs && fs->outbuf && !fs->is_binary )
         icvClose(fs, &buf);
 
     release();
@@ -5526,6 +5843,97 @@ internal::WriteStructContext::~WriteStructContext()
 }
 
 
+// the matrices of the binary storage reference the mapped file, which is released with the last of them
+class MappedFileAllocator : public MatAllocator
+{
+public:
+    UMatData* allocate(int, const int*, int, void*, size_t*, int, UMatUsageFlags) const
+    {
+        CV_Error(Error::StsNotImplemented, "The mapped file can not be used to allocate the new matrices");
+        return 0;
+    }
+
+    bool allocate(UMatData* u, int, UMatUsageFlags) const
+    {
+        return u != 0;
+    }
+
+    void deallocate(UMatData* u) const
+    {
+        if(!u)
+            return;
+
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        icvReleaseMapping((CvFileStorageMapping*)u->userdata);
+        delete u;
+    }
+};
+
+static MatAllocator* getMappedFileAllocator()
+{
+    CV_SINGLETON_LAZY_INIT(MatAllocator, new MappedFileAllocator())
+}
+
+// makes the matrix that references its raw block in the mapped file without copying
+static bool readMappedMat( CvFileStorage* fs, CvFileNode* node, Mat& mat )
+{
+    if( !fs->mapping || !CV_NODE_IS_MAP(node->tag) || !node->info )
+        return false;
+    CvFileNode* block = cvGetFileNodeByName( fs, node, "block" );
+    const char* dt = cvReadStringByName( fs, node, "dt", 0 );
+    if( !block || !dt )
+        return false;
+
+    int dims, sizes[CV_MAX_DIM];
+    if( strcmp( node->info->type_name, CV_TYPE_NAME_MAT ) == 0 )
+    {
+        dims = 2;
+        sizes[0] = cvReadIntByName( fs, node, "rows", -1 );
+        sizes[1] = cvReadIntByName( fs, node, "cols", -1 );
+    }
+    else if( strcmp( node->info->type_name, CV_TYPE_NAME_MATND ) == 0 )
+    {
+        CvFileNode* sizes_node = cvGetFileNodeByName( fs, node, "sizes" );
+        dims = !sizes_node ? -1 : CV_NODE_IS_SEQ(sizes_node->tag) ? sizes_node->data.seq->total :
+               CV_NODE_IS_INT(sizes_node->tag) ? 1 : -1;
+        if( dims <= 0 || dims > CV_MAX_DIM )
+            CV_Error( CV_StsParseError, "Could not determine the matrix dimensionality" );
+        cvReadRawData( fs, sizes_node, sizes, "i" );
+        if( dims == 1 )
+            sizes[dims++] = 1;
+    }
+    else
+        return false;
+
+    int type = icvDecodeSimpleFormat( dt );
+    size_t total = CV_ELEM_SIZE(type);
+    for( int i = 0; i < dims; i++ )
+    {
+        if( sizes[i] < 0 )
+            CV_Error( CV_StsError, "Some of essential matrix attributes are absent" );
+        total *= sizes[i];
+    }
+    if( total == 0 )
+    {
+        mat.release();
+        return true;
+    }
+
+    uchar* data = icvGetRawBlock( fs, block, total );
+    Mat m( dims, sizes, type, data );
+    UMatData* u = new UMatData( getMappedFileAllocator() );
+    u->data = u->origdata = data;
+    u->size = total;
+    u->flags |= UMatData::USER_ALLOCATED;
+    u->userdata = fs->mapping;
+    CV_XADD( &fs->mapping->refcount, 1 );
+    u->refcount = 1;
+    m.u = u;
+    mat = m;
+    return true;
+}
+
 void read( const FileNode& node, Mat& mat, const Mat& default_mat )
 {
     if( node.empty() )
@@ -5533,6 +5941,8 @@ void read( const FileNode& node, Mat& mat, const Mat& default_mat )
         default_mat.copyTo(mat);
         return;
     }
+    if( readMappedMat((CvFileStorage*)node.fs, (CvFileNode*)*node, mat) )
+        return;
     void* obj = cvRead((CvFileStorage*)node.fs, (CvFileNode*)*node);
     if(CV_IS_MAT_HDR_Z(obj))
     {
@@ -5661,4 +6071,942 @@ void read(const FileNode& node, String& value, const String& default_value)
 
 }
 
+/****************************************************************************************\
+*                                    Streaming reader                                    *
+\****************************************************************************************/
+
+namespace cv
+{
+
+enum
+{
+    FS_STREAM_YML_BLOCK = 0, // the block collection, the elements start at the given indentation
+    FS_STREAM_YML_FLOW = 1,  // [...] or {...}
+    FS_STREAM_XML = 2,       // the tags inside of the collection tag
+    FS_STREAM_XML_TEXT = 3,  // the literals inside of the tag (only the element), parsed on demand
+    FS_STREAM_NODE = 4       // the collection that has been already parsed
+};
+
+struct FileStreamElement
+{
+    const CvStringHashNode* key;
+    CvStringHashNode* tag;  // XML: the tag of the element
+    int syntax;
+    int type;               // CV_NODE_* or CV_NODE_NONE if not known yet
+    int explicitType;       // the type specified in the file (!!str, type_id="seq" etc.)
+    CvTypeInfo* info;
+    int parentFlags;        // YAML: the flags of the collection which contains the element
+    int minIndent;          // YAML: the minimal indentation of the value
+    bool consumed;          // the value has been parsed, skipped or entered and left
+    bool parsed;            // the node below is valid
+};
+
+struct FileStreamLevel
+{
+    int syntax;
+    int type;               // CV_NODE_SEQ or CV_NODE_MAP
+    int indent;             // YAML: the indentation of the elements (block) or the minimal one (flow)
+    int count;              // the number of the passed elements
+    FileNodeIterator it;    // FS_STREAM_NODE: the next element
+    FileStreamElement parent;
+};
+
+struct FileStreamReader::Impl
+{
+    Impl() : fs(0), storage(0), scratch(0), ptr(0), valid(false), finished(false)
+    {
+        memset( &elem, 0, sizeof(elem) );
+        memset( &node, 0, sizeof(node) );
+    }
+
+    ~Impl() { release(); }
+
+    bool open( const String& filename )
+    {
+        release();
+        fs = cvOpenFileStorage( filename.c_str(), 0, CV_STORAGE_READ + CV_FS_STREAM_READER );
+        if( !fs )
+            return false;
+        storage = fs->memstorage;
+        scratch = cvCreateMemStorage( 1 << 16 );
+        fs->memstorage = scratch;
+        ptr = fs->buffer_start;
+        try
+        {
+            if( fs->fmt == CV_STORAGE_FORMAT_XML )
+                startXML();
+            else
+                startYML();
+        }
+        catch(...)
+        {
+            release();
+            throw;
+        }
+        return true;
+    }
+
+    void release()
+    {
+        if( fs )
+        {
+            fs->memstorage = storage;
+            cvReleaseFileStorage( &fs );
+        }
+        cvReleaseMemStorage( &scratch );
+        storage = 0;
+        ptr = 0;
+        levels.clear();
+        valid = finished = false;
+    }
+
+    // the document has to be a map or a sequence, the reader starts inside of it
+    void startYML()
+    {
+        for(;;)
+        {
+            ptr = icvYMLSkipSpaces( fs, ptr, 0, INT_MAX );
+            if( *ptr == '%' )
+            {
+                if( memcmp( ptr, "%YAML:", 6 ) == 0 &&
+                    memcmp( ptr, "%YAML:1.", 8 ) != 0 )
+                    CV_PARSE_ERROR( "Unsupported YAML version (it must be 1.x)" );
+                *ptr = '\0';
+            }
+            else if( *ptr == '-' )
+            {
+                if( memcmp( ptr, "---", 3 ) == 0 )
+                    ptr += 3;
+                break;
+            }
+            else if( cv_isalnum(*ptr) || *ptr == '_' || fs->dummy_eof )
+                break;
+            else
+                CV_PARSE_ERROR( "Invalid or unsupported syntax" );
+        }
+
+        ptr = icvYMLSkipSpaces( fs, ptr, 0, INT_MAX );
+        beginElement( 0 );
+        if( memcmp( ptr, "...", 3 ) == 0 )
+        {
+            // an empty document
+            elem.type = CV_NODE_MAP;
+            elem.syntax = FS_STREAM_YML_BLOCK;
+        }
+        else
+        {
+            elem.parentFlags = CV_NODE_NONE;
+            elem.minIndent = 0;
+            readYMLHeader();
+            if( !CV_NODE_IS_COLLECTION(elem.type) || elem.parsed )
+                CV_PARSE_ERROR( "Only collections as YAML streams are supported by this parser" );
+        }
+        enter();
+    }
+
+    void startXML()
+    {
+        CvStringHashNode* tag = 0;
+        CvAttrList* list = 0;
+        int tag_type = 0;
+
+        ptr = icvXMLSkipSpaces( fs, ptr, CV_XML_INSIDE_TAG );
+        if( memcmp( ptr, "<?xml", 5 ) != 0 )
+            CV_PARSE_ERROR( "Valid XML should start with \'<?xml ...?>\'" );
+        ptr = icvXMLParseTag( fs, ptr, &tag, &list, &tag_type );
+        ptr = icvXMLSkipSpaces( fs, ptr, 0 );
+        ptr = icvXMLParseTag( fs, ptr, &tag, &list, &tag_type );
+        if( tag_type != CV_XML_OPENING_TAG || strcmp( tag->str.ptr, "opencv_storage" ) != 0 )
+            CV_PARSE_ERROR( "<opencv_storage> tag is missing" );
+
+        beginElement( 0 );
+        elem.tag = tag;
+        readXMLHeader();
+        if( elem.syntax == FS_STREAM_XML_TEXT )
+        {
+            parseValue();
+            if( CV_NODE_TYPE(node.tag) != CV_NODE_NONE )
+                CV_PARSE_ERROR( "The root of the storage should be a collection" );
+            // an empty storage
+            node.tag = CV_NODE_MAP;
+            icvFSCreateCollection( fs, CV_NODE_MAP, &node );
+        }
+        enter();
+    }
+
+    void beginElement( const CvStringHashNode* key )
+    {
+        memset( &elem, 0, sizeof(elem) );
+        elem.key = key;
+        valid = true;
+    }
+
+    static bool isNumberStart( char c, char d )
+    {
+        return cv_isdigit(c) || ((c == '-' || c == '+') && (cv_isdigit(d) || d == '.')) ||
+               (c == '.' && cv_isalnum(d));
+    }
+
+    // recognizes the value the pointer is at; the scalars are parsed right away,
+    // the collections are left for enter(), node() or skipping
+    void readYMLHeader()
+    {
+        char c = *ptr, d;
+        if( c == '!' )
+        {
+            char* endptr;
+            int is_user = 0, len;
+            d = ptr[1];
+            if( d == '!' || d == '^' )
+            {
+                ptr++;
+                is_user = 1;
+            }
+
+            endptr = ptr++;
+            do d = *++endptr;
+            while( cv_isprint(d) && d != ' ' );
+            len = (int)(endptr - ptr);
+            if( len == 0 )
+                CV_PARSE_ERROR( "Empty type name" );
+            d = *endptr;
+            *endptr = '\0';
+
+            if( is_user )
+                elem.info = cvFindType( ptr );
+            else if( len == 3 && memcmp( ptr, "str", 3 ) == 0 )
+                elem.explicitType = CV_NODE_STRING;
+            else if( len == 3 && memcmp( ptr, "int", 3 ) == 0 )
+                elem.explicitType = CV_NODE_INT;
+            else if( len == 3 && memcmp( ptr, "seq", 3 ) == 0 )
+                elem.explicitType = CV_NODE_SEQ;
+            else if( len == 3 && memcmp( ptr, "map", 3 ) == 0 )
+                elem.explicitType = CV_NODE_MAP;
+            else if( len == 5 && memcmp( ptr, "float", 5 ) == 0 )
+                elem.explicitType = CV_NODE_REAL;
+
+            *endptr = d;
+            ptr = icvYMLSkipSpaces( fs, endptr, elem.minIndent, INT_MAX );
+            c = *ptr;
+        }
+
+        d = ptr[1];
+        bool is_parent_flow = CV_NODE_IS_FLOW(elem.parentFlags) != 0;
+        bool is_scalar = elem.explicitType == CV_NODE_STRING || elem.explicitType == CV_NODE_INT ||
+                         elem.explicitType == CV_NODE_REAL;
+        elem.type = CV_NODE_NONE;
+
+        if( c == '[' || c == '{' )
+        {
+            elem.type = c == '[' ? CV_NODE_SEQ : CV_NODE_MAP;
+            elem.syntax = FS_STREAM_YML_FLOW;
+        }
+        else if( !is_parent_flow && !is_scalar && !isNumberStart(c, d) && c != '\'' && c != '\"' )
+        {
+            if( c == '-' )
+                elem.type = CV_NODE_SEQ;
+            else
+            {
+                // the same rule as in icvYMLParseValue: a key in the line starts the block map
+                char* endptr = ptr - 1;
+                do d = *++endptr;
+                while( cv_isprint(d) && d != ':' );
+                if( d == ':' )
+                    elem.type = CV_NODE_MAP;
+            }
+            elem.syntax = FS_STREAM_YML_BLOCK;
+        }
+
+        if( elem.type == CV_NODE_NONE )
+            parseValue();
+    }
+
+    // recognizes the content of the tag the pointer is after
+    void readXMLHeader()
+    {
+        ptr = icvXMLSkipSpaces( fs, ptr, 0 );
+        if( ptr[0] == '<' && ptr[1] != '/' )
+        {
+            // the first child tag determines the type of the collection
+            const char* name = ptr + 1;
+            bool is_noname = name[0] == '_' && !cv_isalnum(name[1]) && name[1] != '_' && name[1] != '-';
+            elem.type = is_noname ? CV_NODE_SEQ : CV_NODE_MAP;
+            elem.syntax = FS_STREAM_XML;
+            if( CV_NODE_IS_COLLECTION(elem.explicitType) && elem.explicitType != elem.type )
+                CV_PARSE_ERROR( "The actual type is different from the specified type" );
+        }
+        else
+        {
+            // a scalar, a sequence of the literals or an empty tag
+            elem.type = CV_NODE_NONE;
+            elem.syntax = FS_STREAM_XML_TEXT;
+        }
+    }
+
+    void readXMLTag()
+    {
+        CvAttrList* list = 0;
+        int tag_type = 0;
+        ptr = icvXMLParseTag( fs, ptr, &elem.tag, &list, &tag_type );
+        if( tag_type == CV_XML_DIRECTIVE_TAG )
+            CV_PARSE_ERROR( "Directive tags are not allowed here" );
+        if( tag_type == CV_XML_EMPTY_TAG )
+            CV_PARSE_ERROR( "Empty tags are not supported" );
+        if( tag_type != CV_XML_OPENING_TAG )
+            CV_PARSE_ERROR( "The opening tag is expected" );
+
+        const char* type_name = list ? cvAttrValue( list, "type_id" ) : 0;
+        if( type_name )
+        {
+            if( strcmp( type_name, "str" ) == 0 )
+                elem.explicitType = CV_NODE_STRING;
+            else if( strcmp( type_name, "map" ) == 0 )
+                elem.explicitType = CV_NODE_MAP;
+            else if( strcmp( type_name, "seq" ) == 0 )
+                elem.explicitType = CV_NODE_SEQ;
+            else
+                elem.info = cvFindType( type_name );
+        }
+    }
+
+    void readXMLClosingTag( const CvStringHashNode* tag )
+    {
+        CvStringHashNode* key2 = 0;
+        CvAttrList* list = 0;
+        int tag_type = 0;
+        ptr = icvXMLSkipSpaces( fs, ptr, 0 );
+        ptr = icvXMLParseTag( fs, ptr, &key2, &list, &tag_type );
+        if( tag_type != CV_XML_CLOSING_TAG || key2 != tag )
+            CV_PARSE_ERROR( "Mismatched closing tag" );
+    }
+
+    // parses the whole value of the current element into the node
+    void parseValue()
+    {
+        CV_Assert( !elem.consumed );
+        if( elem.syntax == FS_STREAM_XML || elem.syntax == FS_STREAM_XML_TEXT )
+        {
+            int value_type = elem.info ? CV_NODE_USER : elem.explicitType;
+            ptr = icvXMLParseValue( fs, ptr, &node, value_type );
+            readXMLClosingTag( elem.tag );
+        }
+        else
+        {
+            if( elem.explicitType != CV_NODE_NONE && !CV_NODE_IS_COLLECTION(elem.explicitType) )
+                parseYMLScalar( elem.explicitType );
+            else
+                ptr = icvYMLParseValue( fs, ptr, &node, elem.parentFlags, elem.minIndent );
+        }
+        node.info = elem.info;
+        if( elem.info && CV_NODE_IS_COLLECTION(node.tag) )
+            node.tag |= CV_NODE_USER;
+        elem.type = CV_NODE_TYPE(node.tag);
+        elem.consumed = elem.parsed = true;
+    }
+
+    // the scalar with the explicit type; its tag has already been read
+    void parseYMLScalar( int value_type )
+    {
+        char* endptr = 0;
+        memset( &node, 0, sizeof(node) );
+        if( value_type == CV_NODE_STRING && *ptr != '\'' && *ptr != '\"' )
+        {
+            bool is_parent_flow = CV_NODE_IS_FLOW(elem.parentFlags) != 0;
+            char c, *str_end;
+            endptr = ptr - 1;
+            do c = *++endptr;
+            while( cv_isprint(c) && (!is_parent_flow || (c != ',' && c != '}' && c != ']')) );
+            str_end = endptr;
+            do c = *--str_end;
+            while( str_end > ptr && c == ' ' );
+            str_end++;
+            node.tag = CV_NODE_STRING;
+            node.data.str = cvMemStorageAllocString( fs->memstorage, ptr, (int)(str_end - ptr) );
+        }
+        else if( value_type == CV_NODE_INT )
+        {
+            node.tag = CV_NODE_INT;
+            node.data.i = (int)strtol( ptr, &endptr, 0 );
+        }
+        else if( value_type == CV_NODE_REAL )
+        {
+            node.tag = CV_NODE_REAL;
+            node.data.f = icv_strtod( fs, ptr, &endptr );
+        }
+        else
+        {
+            ptr = icvYMLParseValue( fs, ptr, &node, elem.parentFlags, elem.minIndent );
+            return;
+        }
+        if( !endptr || endptr == ptr )
+            CV_PARSE_ERROR( "Invalid numeric value (inconsistent explicit type specification?)" );
+        ptr = endptr;
+    }
+
+    void skipValue()
+    {
+        if( elem.consumed )
+            return;
+        if( elem.syntax == FS_STREAM_YML_FLOW )
+            skipYMLFlow();
+        else if( elem.syntax == FS_STREAM_YML_BLOCK )
+            skipYMLBlock( levels.empty() ? -1 : levels.back().indent );
+        else if( elem.syntax == FS_STREAM_XML || elem.syntax == FS_STREAM_XML_TEXT )
+            skipXML();
+        elem.consumed = true;
+    }
+
+    void skipYMLFlow()
+    {
+        int depth = 0;
+        for(;;)
+        {
+            char c = *ptr;
+            if( c == '[' || c == '{' )
+            {
+                depth++;
+                ptr++;
+            }
+            else if( c == ']' || c == '}' )
+            {
+                ptr++;
+                if( --depth == 0 )
+                    break;
+            }
+            else if( c == '\'' || c == '\"' )
+            {
+                char q = c;
+                for(;;)
+                {
+                    c = *++ptr;
+                    if( c == '\\' && q == '\"' && cv_isprint(ptr[1]) )
+                        ptr++;
+                    else if( c == q )
+                    {
+                        ptr++;
+                        if( q != '\'' || *ptr != '\'' )
+                            break;
+                    }
+                    else if( !cv_isprint(c) )
+                        CV_PARSE_ERROR( "Closing quote is expected" );
+                }
+            }
+            else if( c == ' ' || c == '\0' || c == '\n' || c == '\r' )
+            {
+                ptr = icvYMLSkipSpaces( fs, ptr, 0, INT_MAX );
+                if( fs->dummy_eof )
+                    CV_PARSE_ERROR( "Unexpected end of the stream" );
+            }
+            else if( !cv_isprint(c) )
+                CV_PARSE_ERROR( "Invalid character" );
+            else
+                ptr++;
+        }
+    }
+
+    // skips the lines indented deeper than the collection the value belongs to
+    void skipYMLBlock( int parent_indent )
+    {
+        for(;;)
+        {
+            ptr += strlen(ptr);
+            ptr = icvYMLSkipSpaces( fs, ptr, 0, INT_MAX );
+            if( ptr - fs->buffer_start <= parent_indent || fs->dummy_eof ||
+                memcmp( ptr, "...", 3 ) == 0 || memcmp( ptr, "---", 3 ) == 0 )
+                break;
+        }
+    }
+
+    void skipXML()
+    {
+        int depth = 0;
+        for(;;)
+        {
+            ptr = icvXMLSkipSpaces( fs, ptr, 0 );
+            if( *ptr == '\0' )
+                CV_PARSE_ERROR( "Preliminary end of the stream" );
+            if( *ptr == '<' )
+            {
+                CvStringHashNode* tag = 0;
+                CvAttrList* list = 0;
+                int tag_type = 0;
+                ptr = icvXMLParseTag( fs, ptr, &tag, &list, &tag_type );
+                if( tag_type == CV_XML_OPENING_TAG )
+                    depth++;
+                else if( tag_type == CV_XML_CLOSING_TAG && depth-- == 0 )
+                {
+                    if( tag != elem.tag )
+                        CV_PARSE_ERROR( "Mismatched closing tag" );
+                    break;
+                }
+            }
+            else if( *ptr == '\"' )
+            {
+                do ptr++;
+                while( cv_isprint_or_tab(*ptr) && *ptr != '\"' );
+                if( *ptr != '\"' )
+                    CV_PARSE_ERROR( "Closing \" is expected" );
+                ptr++;
+            }
+            else
+            {
+                while( cv_isprint(*ptr) && *ptr != '<' && !cv_isspace(*ptr) )
+                    ptr++;
+            }
+        }
+    }
+
+    bool next()
+    {
+        if( levels.empty() || finished )
+            return false;
+
+        if( valid )
+            skipValue();
+        valid = false;
+
+        FileStreamLevel& l = levels.back();
+        bool parsed_levels = false;
+        for( size_t i = 0; i < levels.size(); i++ )
+            parsed_levels |= levels[i].syntax == FS_STREAM_NODE;
+        if( !parsed_levels )
+            cvClearMemStorage( scratch );
+
+        if( l.syntax == FS_STREAM_NODE )
+        {
+            if( l.it.remaining == 0 )
+            {
+                finished = true;
+                return false;
+            }
+            const CvFileNode* n = (const CvFileNode*)l.it.reader.ptr;
+            beginElement( l.type == CV_NODE_MAP ? ((const CvFileMapNode*)n)->key : 0 );
+            node = *n;
+            elem.info = node.info;
+            elem.type = CV_NODE_TYPE(node.tag);
+            elem.syntax = FS_STREAM_NODE;
+            elem.consumed = elem.parsed = true;
+            ++l.it;
+        }
+        else if( l.syntax == FS_STREAM_YML_BLOCK )
+        {
+            ptr = icvYMLSkipSpaces( fs, ptr, 0, INT_MAX );
+            int indent = (int)(ptr - fs->buffer_start);
+            if( indent < l.indent || fs->dummy_eof ||
+                memcmp( ptr, "...", 3 ) == 0 || memcmp( ptr, "---", 3 ) == 0 )
+            {
+                finished = true;
+                return false;
+            }
+            if( indent > l.indent )
+                CV_PARSE_ERROR( "Incorrect indentation" );
+
+            if( l.type == CV_NODE_MAP )
+                beginElement( readYMLKey() );
+            else
+            {
+                if( *ptr != '-' )
+                    CV_PARSE_ERROR( "Block sequence elements must be preceded with \'-\'" );
+                ptr++;
+                beginElement( 0 );
+            }
+            ptr = icvYMLSkipSpaces( fs, ptr, l.indent + 1, INT_MAX );
+            elem.parentFlags = l.type;
+            elem.minIndent = l.indent + 1;
+            readYMLHeader();
+        }
+        else if( l.syntax == FS_STREAM_YML_FLOW )
+        {
+            char d = l.type == CV_NODE_SEQ ? ']' : '}';
+            ptr = icvYMLSkipSpaces( fs, ptr, l.indent, INT_MAX );
+            if( l.count > 0 && *ptr != ']' && *ptr != '}' )
+            {
+                if( *ptr != ',' )
+                    CV_PARSE_ERROR( "Missing , between the elements" );
+                ptr = icvYMLSkipSpaces( fs, ptr + 1, l.indent, INT_MAX );
+            }
+            if( *ptr == ']' || *ptr == '}' )
+            {
+                if( *ptr != d )
+                    CV_PARSE_ERROR( "The wrong closing bracket" );
+                ptr++;
+                finished = true;
+                return false;
+            }
+
+            if( l.type == CV_NODE_MAP )
+            {
+                beginElement( readYMLKey() );
+                ptr = icvYMLSkipSpaces( fs, ptr, l.indent, INT_MAX );
+            }
+            else
+                beginElement( 0 );
+            elem.parentFlags = l.type + CV_NODE_FLOW;
+            elem.minIndent = l.indent;
+            readYMLHeader();
+        }
+        else
+        {
+            ptr = icvXMLSkipSpaces( fs, ptr, 0 );
+            if( *ptr == '\0' )
+                CV_PARSE_ERROR( "Preliminary end of the stream" );
+            if( ptr[0] == '<' && ptr[1] == '/' )
+            {
+                finished = true;
+                return false;
+            }
+            if( ptr[0] != '<' )
+                CV_PARSE_ERROR( "The literals can not be mixed with the tags" );
+
+            beginElement( 0 );
+            readXMLTag();
+            bool is_noname = elem.tag->str.len == 1 && elem.tag->str.ptr[0] == '_';
+            if( is_noname != (l.type == CV_NODE_SEQ) )
+                CV_PARSE_ERROR( is_noname ? "Map element should have a name" :
+                                "Sequence element should not have name (use <_></_>)" );
+            elem.key = is_noname ? 0 : elem.tag;
+            readXMLHeader();
+        }
+        l.count++;
+        return true;
+    }
+
+    const CvStringHashNode* readYMLKey()
+    {
+        char c;
+        char *endptr = ptr - 1, *saveptr;
+
+        if( *ptr == '-' )
+            CV_PARSE_ERROR( "Key may not start with \'-\'" );
+
+        do c = *++endptr;
+        while( cv_isprint(c) && c != ':' );
+
+        if( c != ':' )
+            CV_PARSE_ERROR( "Missing \':\'" );
+
+        saveptr = endptr + 1;
+        do c = *--endptr;
+        while( c == ' ' );
+
+        ++endptr;
+        if( endptr == ptr )
+            CV_PARSE_ERROR( "An empty key" );
+
+        const CvStringHashNode* key = cvGetHashedKey( fs, ptr, (int)(endptr - ptr), 1 );
+        ptr = saveptr;
+        return key;
+    }
+
+    int type()
+    {
+        if( !valid )
+            return CV_NODE_NONE;
+        if( elem.syntax == FS_STREAM_XML_TEXT && !elem.consumed )
+            parseValue();
+        return elem.type;
+    }
+
+    void enter()
+    {
+        if( type() == CV_NODE_NONE || !CV_NODE_IS_COLLECTION(elem.type) || (elem.consumed && !elem.parsed) )
+            CV_Error( CV_StsError, "The current element is not a collection" );
+
+        FileStreamLevel l;
+        l.type = elem.type;
+        l.count = 0;
+        l.indent = 0;
+        l.parent = elem;
+        if( elem.parsed )
+        {
+            CvFileNode* copy = (CvFileNode*)cvMemStorageAlloc( scratch, sizeof(CvFileNode) );
+            *copy = node;
+            l.syntax = FS_STREAM_NODE;
+            l.it = FileNodeIterator( fs, copy, 0 );
+        }
+        else if( elem.syntax == FS_STREAM_YML_FLOW )
+        {
+            l.syntax = FS_STREAM_YML_FLOW;
+            l.indent = elem.minIndent + !CV_NODE_IS_FLOW(elem.parentFlags);
+            ptr++;
+        }
+        else if( elem.syntax == FS_STREAM_YML_BLOCK )
+        {
+            l.syntax = FS_STREAM_YML_BLOCK;
+            l.indent = (int)(ptr - fs->buffer_start);
+        }
+        else
+            l.syntax = FS_STREAM_XML;
+        levels.push_back( l );
+        valid = finished = false;
+    }
+
+    void leave()
+    {
+        if( levels.size() < 2 )
+            CV_Error( CV_StsError, "There is no collection to leave" );
+        while( next() )
+            ;
+        FileStreamLevel& l = levels.back();
+        if( l.syntax == FS_STREAM_XML )
+            readXMLClosingTag( l.parent.tag );
+        elem = l.parent;
+        elem.consumed = true;
+        elem.parsed = false;
+        levels.pop_back();
+        valid = true;
+        finished = false;
+    }
+
+    FileNode getNode()
+    {
+        if( !valid )
+            return FileNode();
+        if( !elem.consumed )
+            parseValue();
+        return elem.parsed ? FileNode( fs, &node ) : FileNode();
+    }
+
+    void readMat( Mat& m )
+    {
+        if( !valid )
+            CV_Error( CV_StsError, "There is no current element" );
+        bool is_matrix = elem.info && (strcmp( elem.info->type_name, CV_TYPE_NAME_MAT ) == 0 ||
+                                       strcmp( elem.info->type_name, CV_TYPE_NAME_MATND ) == 0);
+        if( elem.consumed || fs->mapping || !is_matrix || !CV_NODE_IS_MAP(type()) )
+        {
+            // the raw blocks of the binary storage are mapped by cv::read()
+            cv::read( getNode(), m, Mat() );
+            return;
+        }
+
+        String dt;
+        int rows = -1, cols = -1, dims = -1, sizes[CV_MAX_DIM];
+        bool have_data = false;
+
+        enter();
+        while( next() )
+        {
+            String name = elem.key ? String(elem.key->str.ptr) : String();
+            if( name == "data" )
+            {
+                if( dt.empty() || (dims < 0 && (rows < 0 || cols < 0)) )
+                    CV_PARSE_ERROR( "The size and the type of the matrix should precede its data" );
+                int mtype = icvDecodeSimpleFormat( dt.c_str() );
+                if( dims < 0 )
+                {
+                    dims = 2;
+                    sizes[0] = rows;
+                    sizes[1] = cols;
+                }
+                size_t total = 1;
+                for( int i = 0; i < dims; i++ )
+                    total *= (size_t)sizes[i];
+                if( total == 0 )
+                    m.release();
+                else
+                {
+                    m.create( dims, sizes, mtype );
+                    Mat dst = m.isContinuous() ? m : Mat( dims, sizes, mtype );
+                    readRawValues( dst );
+                    if( dst.data != m.data )
+                        dst.copyTo( m );
+                }
+                have_data = true;
+            }
+            else if( name == "rows" || name == "cols" || name == "dt" || name == "sizes" )
+            {
+                FileNode n = getNode();
+                if( name == "rows" )
+                    rows = (int)n;
+                else if( name == "cols" )
+                    cols = (int)n;
+                else if( name == "dt" )
+                    dt = (String)n;
+                else
+                {
+                    dims = (int)n.size();
+                    if( dims <= 0 || dims > CV_MAX_DIM )
+                        CV_PARSE_ERROR( "Could not determine the matrix dimensionality" );
+                    cvReadRawData( fs, n.node, sizes, "i" );
+                    if( dims == 1 )
+                        sizes[dims++] = 1;
+                }
+            }
+        }
+        leave();
+
+        if( !have_data )
+            CV_Error( CV_StsError, "The matrix data is not found in file storage" );
+    }
+
+    // reads the numbers of the current element directly into the continuous matrix
+    void readRawValues( Mat& m )
+    {
+        size_t total = m.total()*m.channels(), count = 0;
+        int depth = m.depth();
+        uchar* data = m.ptr();
+
+        if( elem.syntax == FS_STREAM_YML_FLOW && elem.type == CV_NODE_SEQ )
+        {
+            int min_indent = elem.minIndent + !CV_NODE_IS_FLOW(elem.parentFlags);
+            ptr++;
+            for(;;)
+            {
+                ptr = icvYMLSkipSpaces( fs, ptr, min_indent, INT_MAX );
+                if( count > 0 && *ptr == ',' )
+                    ptr = icvYMLSkipSpaces( fs, ptr + 1, min_indent, INT_MAX );
+                else if( count > 0 && *ptr != ']' )
+                    CV_PARSE_ERROR( "Missing , between the elements" );
+                if( *ptr == ']' )
+                {
+                    ptr++;
+                    break;
+                }
+                if( count >= total )
+                    CV_Error( CV_StsUnmatchedSizes, "The matrix size does not match to the number of stored elements" );
+                ptr = readNumber( ptr, depth, data, count++ );
+            }
+        }
+        else if( elem.syntax == FS_STREAM_XML_TEXT )
+        {
+            for(;;)
+            {
+                ptr = icvXMLSkipSpaces( fs, ptr, 0 );
+                if( *ptr == '<' || *ptr == '\0' )
+                    break;
+                if( count >= total )
+                    CV_Error( CV_StsUnmatchedSizes, "The matrix size does not match to the number of stored elements" );
+                ptr = readNumber( ptr, depth, data, count++ );
+                if( *ptr != '<' && !cv_isspace(*ptr) && *ptr != '\0' )
+                    CV_PARSE_ERROR( "There should be space between literals" );
+            }
+            readXMLClosingTag( elem.tag );
+        }
+        else
+        {
+            // any other layout is parsed as usual
+            FileNode n = getNode();
+            if( n.size() != total )
+                CV_Error( CV_StsUnmatchedSizes, "The matrix size does not match to the number of stored elements" );
+            char dt[16];
+            cvReadRawData( fs, n.node, data, icvEncodeFormat( CV_MAKETYPE(depth, 1), dt ));
+            count = total;
+        }
+        elem.consumed = true;
+
+        if( count != total )
+            CV_Error( CV_StsUnmatchedSizes, "The matrix size does not match to the number of stored elements" );
+    }
+
+    char* readNumber( char* str, int depth, uchar* data, size_t idx )
+    {
+        char* endptr = str + (*str == '-' || *str == '+');
+        double val;
+        if( !isNumberStart( str[0], str[1] ))
+            CV_PARSE_ERROR( "A number is expected" );
+        while( cv_isdigit(*endptr) )
+            endptr++;
+        if( *endptr == '.' || *endptr == 'e' )
+            val = icv_strtod( fs, str, &endptr );
+        else
+            val = (double)strtol( str, &endptr, 0 );
+        if( endptr == str )
+            CV_PARSE_ERROR( "Invalid numeric value" );
+
+        switch( depth )
+        {
+        case CV_8U: ((uchar*)data)[idx] = saturate_cast<uchar>(val); break;
+        case CV_8S: ((schar*)data)[idx] = saturate_cast<schar>(val); break;
+        case CV_16U: ((ushort*)data)[idx] = saturate_cast<ushort>(val); break;
+        case CV_16S: ((short*)data)[idx] = saturate_cast<short>(val); break;
+        case CV_32S: ((int*)data)[idx] = saturate_cast<int>(val); break;
+        case CV_32F: ((float*)data)[idx] = (float)val; break;
+        default: ((double*)data)[idx] = val; break;
+        }
+        return endptr;
+    }
+
+    CvFileStorage* fs;
+    CvMemStorage* storage;   // the keys; fs->memstorage is switched to the scratch storage
+    CvMemStorage* scratch;   // the nodes of the current element, cleared by next()
+    char* ptr;
+    std::vector<FileStreamLevel> levels;
+
+    bool valid;              // there is the current element
+    bool finished;           // the end of the innermost collection has been reached
+    FileStreamElement elem;
+    CvFileNode node;
+};
+
+FileStreamReader::FileStreamReader() : p(new Impl)
+{
+}
+
+FileStreamReader::FileStreamReader(const String& filename) : p(new Impl)
+{
+    open(filename);
+}
+
+FileStreamReader::~FileStreamReader()
+{
+}
+
+bool FileStreamReader::open(const String& filename)
+{
+    return p->open(filename);
+}
+
+bool FileStreamReader::isOpened() const
+{
+    return p->fs != 0;
+}
+
+void FileStreamReader::release()
+{
+    p->release();
+}
+
+bool FileStreamReader::next()
+{
+    return p->fs && p->next();
+}
+
+String FileStreamReader::name() const
+{
+    return p->valid && p->elem.key ? String(p->elem.key->str.ptr) : String();
+}
+
+int FileStreamReader::type() const
+{
+    return p->type();
+}
+
+int FileStreamReader::depth() const
+{
+    return (int)p->levels.size();
+}
+
+void FileStreamReader::enter()
+{
+    p->enter();
+}
+
+void FileStreamReader::leave()
+{
+    p->leave();
+}
+
+FileNode FileStreamReader::node() const
+{
+    return p->getNode();
+}
+
+void FileStreamReader::read(Mat& m)
+{
+    p->readMat(m);
+}
+
+}
+
 /* End of file. */
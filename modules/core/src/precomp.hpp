@@ -193,6 +193,33 @@ inline Size getContinuousSize( const Mat& m1, const Mat& m2,
                               m1.cols, m1.rows, widthScale);
 }
 
+// The arrays are processed in parallel by the stripes of ~PARALLEL_STRIPE_GRAIN bytes,
+// the smaller arrays are not worth the threading overhead.
+enum { PARALLEL_STRIPE_GRAIN = 1 << 17 };
+
+inline int getParallelStripes( size_t bytes, size_t grain = PARALLEL_STRIPE_GRAIN )
+{
+    return (int)std::min(bytes/grain, (size_t)INT_MAX);
+}
+
+// splits the 2D arrays of the same size into the stripes of rows when there are enough of them,
+// into the stripes of columns otherwise
+struct ParallelStripes
+{
+    ParallelStripes( const Mat& m, size_t bytes )
+    {
+        nstripes = getParallelStripes(bytes);
+        byRows = m.rows >= nstripes;
+        len = byRows ? m.rows : m.cols;
+    }
+
+    Range range() const { return Range(0, len); }
+    Mat operator()( const Mat& m, const Range& r ) const { return byRows ? m.rowRange(r) : m.colRange(r); }
+
+    int nstripes, len;
+    bool byRows;
+};
+
 struct NoVec
 {
     size_t operator()(const void*, const void*, void*, size_t) const { return 0; }
@@ -260,7 +287,7 @@ struct CoreTLSData
 //#ifdef HAVE_OPENCL
         device(0), useOpenCL(-1),
 //#endif
-        useIPP(-1)
+        useIPP(-1), matAllocator(0)
     {
 #ifdef HAVE_TEGRA_OPTIMIZATION
         useTegra = -1;
@@ -277,10 +304,15 @@ struct CoreTLSData
 #ifdef HAVE_TEGRA_OPTIMIZATION
     int useTegra; // 1 - use, 0 - do not use, -1 - auto/not initialized
 #endif
+    MatAllocator* matAllocator; // set by MatAllocatorScope, overrides the default allocator
 };
 
 TLSData<CoreTLSData>& getCoreTlsData();
 
+// the number of the active MatAllocatorScope objects in all the threads,
+// the thread-local allocator is not looked up while there are none
+extern volatile int g_matAllocatorScopes;
+
 #if defined(BUILD_SHARED_LIBS)
 #if defined WIN32 || defined _WIN32 || defined WINCE
 #define CL_RUNTIME_EXPORT __declspec(dllexport)
@@ -298,6 +330,35 @@ extern bool __termination; // skip some cleanups, because process is terminating
 
 cv::Mutex& getInitializationMutex();
 
+// reads a size from the environment variable, "KB" and "MB" suffixes are accepted
+size_t getConfigurationParameterForSize(const char* name, size_t defaultValue);
+
+// NUMA-aware execution of parallel regions, see setNumaAware()
+// number of nodes the stripes should be distributed between, 1 if the NUMA mode is off
+int getNumaNodesInUse();
+// binds the worker thread threadIdx of nthreads to its node if the NUMA mode has changed
+// since the previous call with the same generation variable; returns the node of the worker
+int updateNumaAffinity(int threadIdx, int nthreads, int& generation);
+// touches the pages of a freshly allocated buffer in parallel, so they are placed to the nodes
+// which will process the corresponding parts of it
+void numaFirstTouch(void* data, size_t size);
+
+namespace tracing {
+// wraps the body of parallel_for_ while the trace is on: the stripes executed by each thread
+// are reported as one region of the job, see trace.cpp
+class TraceParallelLoopBody : public ParallelLoopBody
+{
+public:
+    TraceParallelLoopBody(const ParallelLoopBody& body);
+    ~TraceParallelLoopBody();
+    void operator()(const Range& r) const;
+private:
+    const ParallelLoopBody* body;
+    int job;
+    int64 parent;
+};
+}
+
 // TODO Memory barriers?
 #define CV_SINGLETON_LAZY_INIT_(TYPE, INITIALIZER, RET_VALUE) \
     static TYPE* volatile instance = NULL; \
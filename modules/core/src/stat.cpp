@@ -1190,35 +1190,98 @@ static bool ipp_sum(Mat &src, Scalar &_res)
 
 }
 
-cv::Scalar cv::sum( InputArray _src )
+namespace cv
 {
-#if defined HAVE_OPENCL || defined HAVE_IPP
-    Scalar _res;
-#endif
 
-#ifdef HAVE_OPENCL
-    CV_OCL_RUN_(OCL_PERFORMANCE_CHECK(_src.isUMat()) && _src.dims() <= 2,
-                ocl_sum(_src, _res, OCL_OP_SUM),
-                _res)
-#endif
+// The reductions of the large arrays are split into the stripes of ~REDUCE_GRAIN bytes. The stripes
+// depend only on the array size and the partial results are merged in the stripe order, so
+// the result does not depend on the number of threads, it is the same with setNumThreads(0).
+enum { REDUCE_GRAIN = 1 << 18 };
 
-    Mat src = _src.getMat();
-    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_sum(src, _res), _res);
+struct ReduceStripes
+{
+    ReduceStripes(const Mat& m) : count(1), len(0), byRows(true)
+    {
+        size_t total = m.total()*m.elemSize();
+        int nstripes = (int)std::min(total/REDUCE_GRAIN, (size_t)INT_MAX);
+        if( nstripes < 2 || m.dims > 2 )
+            return;
+        // the rows are split when there are enough of them, the columns otherwise
+        byRows = m.rows >= nstripes;
+        len = byRows ? m.rows : m.cols;
+        count = std::min(nstripes, len);
+    }
+
+    Range range(int i) const
+    {
+        return Range((int)((int64)len*i/count), (int)((int64)len*(i+1)/count));
+    }
+
+    Mat slice(const Mat& m, int i) const
+    {
+        if( m.empty() )
+            return m;
+        Range r = range(i);
+        return byRows ? m.rowRange(r) : m.colRange(r);
+    }
+
+    int count, len;
+    bool byRows;
+};
+
+// Body::operator()(stripes, i) computes the partial result of the i-th stripe,
+// Body::merge(a, b) adds the partial result b of the next stripe to a
+template<typename Body> class ReduceInvoker : public ParallelLoopBody
+{
+public:
+    ReduceInvoker(const Body& _body, const ReduceStripes& _stripes, typename Body::Result* _partial)
+        : body(_body), stripes(_stripes), partial(_partial) {}
+
+    void operator()(const Range& range) const
+    {
+        for( int i = range.start; i < range.end; i++ )
+            partial[i] = body(stripes, i);
+    }
+
+protected:
+    const Body& body;
+    const ReduceStripes& stripes;
+    typename Body::Result* partial;
+};
+
+// returns false if the array is too small to be split, the caller does the serial reduction then
+template<typename Body> static bool
+parallelReduce( const Body& body, const Mat& src, typename Body::Result& result )
+{
+    ReduceStripes stripes(src);
+    if( stripes.count < 2 )
+        return false;
+
+    std::vector<typename Body::Result> partial(stripes.count);
+    parallel_for_(Range(0, stripes.count), ReduceInvoker<Body>(body, stripes, &partial[0]), stripes.count);
 
+    result = partial[0];
+    for( int i = 1; i < stripes.count; i++ )
+        body.merge(result, partial[i]);
+    return true;
+}
+
+// adds the sum of the elements of src where the mask is set to s, returns the number of such elements
+static size_t sumSerial( const Mat& src, const Mat& mask, Scalar& s )
+{
     int k, cn = src.channels(), depth = src.depth();
     SumFunc func = getSumFunc(depth);
     CV_Assert( cn <= 4 && func != 0 );
 
-    const Mat* arrays[] = {&src, 0};
-    uchar* ptrs[1];
+    const Mat* arrays[] = {&src, &mask, 0};
+    uchar* ptrs[2];
     NAryMatIterator it(arrays, ptrs);
-    Scalar s;
     int total = (int)it.size, blockSize = total, intSumBlockSize = 0;
     int j, count = 0;
     AutoBuffer<int> _buf;
     int* buf = (int*)&s[0];
-    size_t esz = 0;
     bool blockSum = depth < CV_32S;
+    size_t esz = 0, nz0 = 0;
 
     if( blockSum )
     {
@@ -1237,8 +1300,9 @@ cv::Scalar cv::sum( InputArray _src )
         for( j = 0; j < total; j += blockSize )
         {
             int bsz = std::min(total - j, blockSize);
-            func( ptrs[0], 0, (uchar*)buf, bsz, cn );
-            count += bsz;
+            int nz = func( ptrs[0], ptrs[1], (uchar*)buf, bsz, cn );
+            count += nz;
+            nz0 += nz;
             if( blockSum && (count + blockSize >= intSumBlockSize || (i+1 >= it.nplanes && j+bsz >= total)) )
             {
                 for( k = 0; k < cn; k++ )
@@ -1249,9 +1313,65 @@ cv::Scalar cv::sum( InputArray _src )
                 count = 0;
             }
             ptrs[0] += bsz*esz;
+            if( ptrs[1] )
+                ptrs[1] += bsz;
         }
     }
-    return s;
+    return nz0;
+}
+
+struct SumReduceBody
+{
+    struct Result
+    {
+        Result() : nz(0) {}
+        Scalar s;
+        size_t nz;
+    };
+
+    SumReduceBody(const Mat& _src, const Mat& _mask) : src(_src), mask(_mask) {}
+
+    Result operator()(const ReduceStripes& stripes, int i) const
+    {
+        Result r;
+        r.nz = sumSerial(stripes.slice(src, i), stripes.slice(mask, i), r.s);
+        return r;
+    }
+
+    void merge(Result& a, const Result& b) const
+    {
+        a.s += b.s;
+        a.nz += b.nz;
+    }
+
+    const Mat& src;
+    const Mat& mask;
+};
+
+}
+
+cv::Scalar cv::sum( InputArray _src )
+{
+    CV_TRACE_FUNCTION();
+
+#if defined HAVE_OPENCL || defined HAVE_IPP
+    Scalar _res;
+#endif
+
+#ifdef HAVE_OPENCL
+    CV_OCL_RUN_(OCL_PERFORMANCE_CHECK(_src.isUMat()) && _src.dims() <= 2,
+                ocl_sum(_src, _res, OCL_OP_SUM),
+                _res)
+#endif
+
+    Mat src = _src.getMat(), mask;
+    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_sum(src, _res), _res);
+    CV_Assert( src.channels() <= 4 );
+
+    SumReduceBody::Result r;
+    if( !parallelReduce(SumReduceBody(src, mask), src, r) )
+        sumSerial(src, mask, r.s);
+    return r.s;
 }
 
 #ifdef HAVE_OPENCL
@@ -1335,9 +1455,46 @@ static bool ipp_countNonZero( Mat &src, int &res )
 }
 #endif
 
+namespace cv {
+
+static int countNonZeroSerial( const Mat& src )
+{
+    CountNonZeroFunc func = getCountNonZeroTab(src.depth());
+    CV_Assert( func != 0 );
+
+    const Mat* arrays[] = {&src, 0};
+    uchar* ptrs[1];
+    NAryMatIterator it(arrays, ptrs);
+    int total = (int)it.size, nz = 0;
+
+    for( size_t i = 0; i < it.nplanes; i++, ++it )
+        nz += func( ptrs[0], total );
+
+    return nz;
+}
+
+struct CountNonZeroReduceBody
+{
+    typedef int Result;
+
+    CountNonZeroReduceBody(const Mat& _src) : src(_src) {}
+
+    int operator()(const ReduceStripes& stripes, int i) const
+    {
+        return countNonZeroSerial(stripes.slice(src, i));
+    }
+
+    void merge(int& a, int b) const { a += b; }
+
+    const Mat& src;
+};
+
+}
 
 int cv::countNonZero( InputArray _src )
 {
+    CV_TRACE_FUNCTION();
+
     int type = _src.type(), cn = CV_MAT_CN(type);
     CV_Assert( cn == 1 );
 
@@ -1354,17 +1511,9 @@ int cv::countNonZero( InputArray _src )
     Mat src = _src.getMat();
     CV_IPP_RUN(0 && (_src.dims() <= 2 || _src.isContinuous()), ipp_countNonZero(src, res), res);
 
-    CountNonZeroFunc func = getCountNonZeroTab(src.depth());
-    CV_Assert( func != 0 );
-
-    const Mat* arrays[] = {&src, 0};
-    uchar* ptrs[1];
-    NAryMatIterator it(arrays, ptrs);
-    int total = (int)it.size, nz = 0;
-
-    for( size_t i = 0; i < it.nplanes; i++, ++it )
-        nz += func( ptrs[0], total );
-
+    int nz = 0;
+    if( !parallelReduce(CountNonZeroReduceBody(src), src, nz) )
+        nz = countNonZeroSerial(src);
     return nz;
 }
 
@@ -1461,63 +1610,20 @@ static bool ipp_mean( Mat &src, Mat &mask, Scalar &ret )
 
 cv::Scalar cv::mean( InputArray _src, InputArray _mask )
 {
+    CV_TRACE_FUNCTION();
+
     Mat src = _src.getMat(), mask = _mask.getMat();
     CV_Assert( mask.empty() || mask.type() == CV_8U );
 
-    int k, cn = src.channels(), depth = src.depth();
     Scalar s;
 
     CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_mean(src, mask, s), s)
+    CV_Assert( src.channels() <= 4 );
 
-    SumFunc func = getSumFunc(depth);
-
-    CV_Assert( cn <= 4 && func != 0 );
-
-    const Mat* arrays[] = {&src, &mask, 0};
-    uchar* ptrs[2];
-    NAryMatIterator it(arrays, ptrs);
-    int total = (int)it.size, blockSize = total, intSumBlockSize = 0;
-    int j, count = 0;
-    AutoBuffer<int> _buf;
-    int* buf = (int*)&s[0];
-    bool blockSum = depth <= CV_16S;
-    size_t esz = 0, nz0 = 0;
-
-    if( blockSum )
-    {
-        intSumBlockSize = depth <= CV_8S ? (1 << 23) : (1 << 15);
-        blockSize = std::min(blockSize, intSumBlockSize);
-        _buf.allocate(cn);
-        buf = _buf;
-
-        for( k = 0; k < cn; k++ )
-            buf[k] = 0;
-        esz = src.elemSize();
-    }
-
-    for( size_t i = 0; i < it.nplanes; i++, ++it )
-    {
-        for( j = 0; j < total; j += blockSize )
-        {
-            int bsz = std::min(total - j, blockSize);
-            int nz = func( ptrs[0], ptrs[1], (uchar*)buf, bsz, cn );
-            count += nz;
-            nz0 += nz;
-            if( blockSum && (count + blockSize >= intSumBlockSize || (i+1 >= it.nplanes && j+bsz >= total)) )
-            {
-                for( k = 0; k < cn; k++ )
-                {
-                    s[k] += buf[k];
-                    buf[k] = 0;
-                }
-                count = 0;
-            }
-            ptrs[0] += bsz*esz;
-            if( ptrs[1] )
-                ptrs[1] += bsz;
-        }
-    }
-    return s*(nz0 ? 1./nz0 : 0);
+    SumReduceBody::Result r;
+    if( !parallelReduce(SumReduceBody(src, mask), src, r) )
+        r.nz = sumSerial(src, mask, r.s);
+    return r.s*(r.nz ? 1./r.nz : 0);
 }
 
 #ifdef HAVE_OPENCL
@@ -1753,16 +1859,13 @@ static bool ipp_meanStdDev(Mat& src, OutputArray _mean, OutputArray _sdv, Mat& m
 }
 #endif
 
-void cv::meanStdDev( InputArray _src, OutputArray _mean, OutputArray _sdv, InputArray _mask )
+namespace cv
 {
-    CV_OCL_RUN(OCL_PERFORMANCE_CHECK(_src.isUMat()) && _src.dims() <= 2,
-               ocl_meanStdDev(_src, _mean, _sdv, _mask))
-
-    Mat src = _src.getMat(), mask = _mask.getMat();
-    CV_Assert( mask.empty() || mask.type() == CV_8UC1 );
-
-    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_meanStdDev(src, _mean, _sdv, mask));
 
+// adds the sums and the sums of squares of the elements of src where the mask is set to s and sq,
+// returns the number of such elements
+static int sumSqrSerial( const Mat& src, const Mat& mask, double* s, double* sq )
+{
     int k, cn = src.channels(), depth = src.depth();
 
     SumSqrFunc func = getSumSqrTab(depth);
@@ -1774,20 +1877,17 @@ void cv::meanStdDev( InputArray _src, OutputArray _mean, OutputArray _sdv, Input
     NAryMatIterator it(arrays, ptrs);
     int total = (int)it.size, blockSize = total, intSumBlockSize = 0;
     int j, count = 0, nz0 = 0;
-    AutoBuffer<double> _buf(cn*4);
-    double *s = (double*)_buf, *sq = s + cn;
+    AutoBuffer<int> _ibuf;
     int *sbuf = (int*)s, *sqbuf = (int*)sq;
     bool blockSum = depth <= CV_16S, blockSqSum = depth <= CV_8S;
     size_t esz = 0;
 
-    for( k = 0; k < cn; k++ )
-        s[k] = sq[k] = 0;
-
     if( blockSum )
     {
         intSumBlockSize = 1 << 15;
         blockSize = std::min(blockSize, intSumBlockSize);
-        sbuf = (int*)(sq + cn);
+        _ibuf.allocate(cn*2);
+        sbuf = _ibuf;
         if( blockSqSum )
             sqbuf = sbuf + cn;
         for( k = 0; k < cn; k++ )
@@ -1825,6 +1925,65 @@ void cv::meanStdDev( InputArray _src, OutputArray _mean, OutputArray _sdv, Input
                 ptrs[1] += bsz;
         }
     }
+    return nz0;
+}
+
+struct SumSqrReduceBody
+{
+    struct Result
+    {
+        Result() : nz(0) {}
+        // the sums of the channels, then the sums of squares
+        std::vector<double> s;
+        int nz;
+    };
+
+    SumSqrReduceBody(const Mat& _src, const Mat& _mask) : src(_src), mask(_mask) {}
+
+    Result operator()(const ReduceStripes& stripes, int i) const
+    {
+        int cn = src.channels();
+        Result r;
+        r.s.resize(cn*2, 0.);
+        r.nz = sumSqrSerial(stripes.slice(src, i), stripes.slice(mask, i), &r.s[0], &r.s[cn]);
+        return r;
+    }
+
+    void merge(Result& a, const Result& b) const
+    {
+        for( size_t k = 0; k < a.s.size(); k++ )
+            a.s[k] += b.s[k];
+        a.nz += b.nz;
+    }
+
+    const Mat& src;
+    const Mat& mask;
+};
+
+}
+
+void cv::meanStdDev( InputArray _src, OutputArray _mean, OutputArray _sdv, InputArray _mask )
+{
+    CV_TRACE_FUNCTION();
+
+    CV_OCL_RUN(OCL_PERFORMANCE_CHECK(_src.isUMat()) && _src.dims() <= 2,
+               ocl_meanStdDev(_src, _mean, _sdv, _mask))
+
+    Mat src = _src.getMat(), mask = _mask.getMat();
+    CV_Assert( mask.empty() || mask.type() == CV_8UC1 );
+
+    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_meanStdDev(src, _mean, _sdv, mask));
+
+    int j, k, cn = src.channels();
+
+    SumSqrReduceBody::Result r;
+    if( !parallelReduce(SumSqrReduceBody(src, mask), src, r) )
+    {
+        r.s.resize(cn*2, 0.);
+        r.nz = sumSqrSerial(src, mask, &r.s[0], &r.s[cn]);
+    }
+    double *s = &r.s[0], *sq = s + cn;
+    int nz0 = r.nz;
 
     double scale = nz0 ? 1./nz0 : 0.;
     for( k = 0; k < cn; k++ )
@@ -1973,6 +2132,85 @@ static void ofs2idx(const Mat& a, size_t ofs, int* idx)
     }
 }
 
+struct MinMaxIdxResult
+{
+    // the indices are 1-based, 0 means that no element has been found
+    double minVal, maxVal;
+    size_t minIdx, maxIdx;
+};
+
+static void minMaxIdxSerial( const Mat& src, const Mat& mask, MinMaxIdxResult& r )
+{
+    int depth = src.depth(), cn = src.channels();
+    MinMaxIdxFunc func = getMinmaxTab(depth);
+    CV_Assert( func != 0 );
+
+    const Mat* arrays[] = {&src, &mask, 0};
+    uchar* ptrs[2];
+    NAryMatIterator it(arrays, ptrs);
+
+    size_t minidx = 0, maxidx = 0;
+    int iminval = INT_MAX, imaxval = INT_MIN;
+    float  fminval = std::numeric_limits<float>::infinity(),  fmaxval = -fminval;
+    double dminval = std::numeric_limits<double>::infinity(), dmaxval = -dminval;
+    size_t startidx = 1;
+    int *minval = &iminval, *maxval = &imaxval;
+    int planeSize = (int)it.size*cn;
+
+    if( depth == CV_32F )
+        minval = (int*)&fminval, maxval = (int*)&fmaxval;
+    else if( depth == CV_64F )
+        minval = (int*)&dminval, maxval = (int*)&dmaxval;
+
+    for( size_t i = 0; i < it.nplanes; i++, ++it, startidx += planeSize )
+        func( ptrs[0], ptrs[1], minval, maxval, &minidx, &maxidx, planeSize, startidx );
+
+    if( depth == CV_32F )
+        dminval = fminval, dmaxval = fmaxval;
+    else if( depth <= CV_32S )
+        dminval = iminval, dmaxval = imaxval;
+
+    r.minVal = dminval;
+    r.maxVal = dmaxval;
+    r.minIdx = minidx;
+    r.maxIdx = maxidx;
+}
+
+// the indices of the stripes are converted to the indices in the whole array, the equal values
+// are resolved to the smaller index, so the result is the same as the serial one
+struct MinMaxReduceBody
+{
+    typedef MinMaxIdxResult Result;
+
+    MinMaxReduceBody(const Mat& _src, const Mat& _mask) : src(_src), mask(_mask) {}
+
+    Result operator()(const ReduceStripes& stripes, int i) const
+    {
+        Mat part = stripes.slice(src, i);
+        Result r;
+        minMaxIdxSerial(part, stripes.slice(mask, i), r);
+        int cols = src.cols*src.channels(), pcols = part.cols*src.channels();
+        size_t r0 = stripes.byRows ? stripes.range(i).start : 0;
+        size_t c0 = stripes.byRows ? 0 : stripes.range(i).start*src.channels();
+        if( r.minIdx )
+            r.minIdx = ((r.minIdx - 1)/pcols + r0)*cols + (r.minIdx - 1)%pcols + c0 + 1;
+        if( r.maxIdx )
+            r.maxIdx = ((r.maxIdx - 1)/pcols + r0)*cols + (r.maxIdx - 1)%pcols + c0 + 1;
+        return r;
+    }
+
+    void merge(Result& a, const Result& b) const
+    {
+        if( b.minIdx && (!a.minIdx || b.minVal < a.minVal || (b.minVal == a.minVal && b.minIdx < a.minIdx)) )
+            a.minVal = b.minVal, a.minIdx = b.minIdx;
+        if( b.maxIdx && (!a.maxIdx || b.maxVal > a.maxVal || (b.maxVal == a.maxVal && b.maxIdx < a.maxIdx)) )
+            a.maxVal = b.maxVal, a.maxIdx = b.maxIdx;
+    }
+
+    const Mat& src;
+    const Mat& mask;
+};
+
 #ifdef HAVE_OPENCL
 
 #define MINMAX_STRUCT_ALIGNMENT 8 // sizeof double
@@ -2323,7 +2561,9 @@ void cv::minMaxIdx(InputArray _src, double* minVal,
                    double* maxVal, int* minIdx, int* maxIdx,
                    InputArray _mask)
 {
-    int type = _src.type(), depth = CV_MAT_DEPTH(type), cn = CV_MAT_CN(type);
+    CV_TRACE_FUNCTION();
+
+    int type = _src.type(), cn = CV_MAT_CN(type);
     CV_Assert( (cn == 1 && (_mask.empty() || _mask.type() == CV_8U)) ||
         (cn > 1 && _mask.empty() && !minIdx && !maxIdx) );
 
@@ -2333,28 +2573,11 @@ void cv::minMaxIdx(InputArray _src, double* minVal,
     Mat src = _src.getMat(), mask = _mask.getMat();
     CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_minMaxIdx(src, minVal, maxVal, minIdx, maxIdx, mask))
 
-    MinMaxIdxFunc func = getMinmaxTab(depth);
-    CV_Assert( func != 0 );
-
-    const Mat* arrays[] = {&src, &mask, 0};
-    uchar* ptrs[2];
-    NAryMatIterator it(arrays, ptrs);
-
-    size_t minidx = 0, maxidx = 0;
-    int iminval = INT_MAX, imaxval = INT_MIN;
-    float  fminval = std::numeric_limits<float>::infinity(),  fmaxval = -fminval;
-    double dminval = std::numeric_limits<double>::infinity(), dmaxval = -dminval;
-    size_t startidx = 1;
-    int *minval = &iminval, *maxval = &imaxval;
-    int planeSize = (int)it.size*cn;
-
-    if( depth == CV_32F )
-        minval = (int*)&fminval, maxval = (int*)&fmaxval;
-    else if( depth == CV_64F )
-        minval = (int*)&dminval, maxval = (int*)&dmaxval;
-
-    for( size_t i = 0; i < it.nplanes; i++, ++it, startidx += planeSize )
-        func( ptrs[0], ptrs[1], minval, maxval, &minidx, &maxidx, planeSize, startidx );
+    MinMaxReduceBody::Result r;
+    if( !parallelReduce(MinMaxReduceBody(src, mask), src, r) )
+        minMaxIdxSerial(src, mask, r);
+    size_t minidx = r.minIdx, maxidx = r.maxIdx;
+    double dminval = r.minVal, dmaxval = r.maxVal;
 
     if (!src.empty() && mask.empty())
     {
@@ -2366,10 +2589,6 @@ void cv::minMaxIdx(InputArray _src, double* minVal,
 
     if( minidx == 0 )
         dminval = dmaxval = 0;
-    else if( depth == CV_32F )
-        dminval = fminval, dmaxval = fmaxval;
-    else if( depth <= CV_32S )
-        dminval = iminval, dmaxval = imaxval;
 
     if( minVal )
         *minVal = dminval;
@@ -2838,26 +3057,11 @@ static bool ipp_norm(Mat &src, int normType, Mat &mask, double &result)
 #endif
 }
 
-double cv::norm( InputArray _src, int normType, InputArray _mask )
+namespace cv
 {
-    normType &= NORM_TYPE_MASK;
-    CV_Assert( normType == NORM_INF || normType == NORM_L1 ||
-               normType == NORM_L2 || normType == NORM_L2SQR ||
-               ((normType == NORM_HAMMING || normType == NORM_HAMMING2) && _src.type() == CV_8U) );
-
-#if defined HAVE_OPENCL || defined HAVE_IPP
-    double _result = 0;
-#endif
-
-#ifdef HAVE_OPENCL
-    CV_OCL_RUN_(OCL_PERFORMANCE_CHECK(_src.isUMat()) && _src.dims() <= 2,
-                ocl_norm(_src, normType, _mask, _result),
-                _result)
-#endif
-
-    Mat src = _src.getMat(), mask = _mask.getMat();
-    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_norm(src, normType, mask, _result), _result);
 
+static double normSerial( const Mat& src, int normType, const Mat& mask )
+{
     int depth = src.depth(), cn = src.channels();
     if( src.isContinuous() && mask.empty() )
     {
@@ -2999,6 +3203,66 @@ double cv::norm( InputArray _src, int normType, InputArray _mask )
     return result.d;
 }
 
+// the L2 norm is reduced as NORM_L2SQR, the square root is taken after the merge
+struct NormReduceBody
+{
+    typedef double Result;
+
+    NormReduceBody(const Mat& _src, int _normType, const Mat& _mask)
+        : src(_src), mask(_mask), normType(_normType == NORM_L2 ? NORM_L2SQR : _normType) {}
+
+    double operator()(const ReduceStripes& stripes, int i) const
+    {
+        return normSerial(stripes.slice(src, i), normType, stripes.slice(mask, i));
+    }
+
+    void merge(double& a, double b) const
+    {
+        if( normType == NORM_INF )
+            a = std::max(a, b);
+        else
+            a += b;
+    }
+
+    const Mat& src;
+    const Mat& mask;
+    int normType;
+};
+
+}
+
+double cv::norm( InputArray _src, int normType, InputArray _mask )
+{
+    CV_TRACE_FUNCTION();
+
+    normType &= NORM_TYPE_MASK;
+    CV_Assert( normType == NORM_INF || normType == NORM_L1 ||
+               normType == NORM_L2 || normType == NORM_L2SQR ||
+               ((normType == NORM_HAMMING || normType == NORM_HAMMING2) && _src.type() == CV_8U) );
+
+#if defined HAVE_OPENCL || defined HAVE_IPP
+    double _result = 0;
+#endif
+
+#ifdef HAVE_OPENCL
+    CV_OCL_RUN_(OCL_PERFORMANCE_CHECK(_src.isUMat()) && _src.dims() <= 2,
+                ocl_norm(_src, normType, _mask, _result),
+                _result)
+#endif
+
+    Mat src = _src.getMat(), mask = _mask.getMat();
+    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_norm(src, normType, mask, _result), _result);
+
+    CV_Assert( mask.empty() || mask.type() == CV_8U );
+
+    double result = 0;
+    if( normType != NORM_HAMMING && normType != NORM_HAMMING2 &&
+        parallelReduce(NormReduceBody(src, normType, mask), src, result) )
+        return normType == NORM_L2 ? std::sqrt(result) : result;
+
+    return normSerial(src, normType, mask);
+}
+
 #ifdef HAVE_OPENCL
 
 namespace cv {
@@ -3357,35 +3621,13 @@ static bool ipp_norm(InputArray _src1, InputArray _src2, int normType, InputArra
 #endif
 
 
-double cv::norm( InputArray _src1, InputArray _src2, int normType, InputArray _mask )
+namespace cv
 {
-    CV_Assert( _src1.sameSize(_src2) && _src1.type() == _src2.type() );
-
-#if defined HAVE_OPENCL || defined HAVE_IPP
-    double _result = 0;
-#endif
-
-#ifdef HAVE_OPENCL
-    CV_OCL_RUN_(OCL_PERFORMANCE_CHECK(_src1.isUMat()),
-                ocl_norm(_src1, _src2, normType, _mask, _result),
-                _result)
-#endif
 
-    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_norm(_src1, _src2, normType, _mask, _result), _result);
-
-    if( normType & CV_RELATIVE )
-    {
-        return norm(_src1, _src2, normType & ~CV_RELATIVE, _mask)/(norm(_src2, normType, _mask) + DBL_EPSILON);
-    }
-
-    Mat src1 = _src1.getMat(), src2 = _src2.getMat(), mask = _mask.getMat();
+static double normDiffSerial( const Mat& src1, const Mat& src2, int normType, const Mat& mask )
+{
     int depth = src1.depth(), cn = src1.channels();
 
-    normType &= 7;
-    CV_Assert( normType == NORM_INF || normType == NORM_L1 ||
-               normType == NORM_L2 || normType == NORM_L2SQR ||
-              ((normType == NORM_HAMMING || normType == NORM_HAMMING2) && src1.type() == CV_8U) );
-
     if( src1.isContinuous() && src2.isContinuous() && mask.empty() )
     {
         size_t len = src1.total()*src1.channels();
@@ -3516,6 +3758,74 @@ double cv::norm( InputArray _src1, InputArray _src2, int normType, InputArray _m
     return result.d;
 }
 
+struct NormDiffReduceBody
+{
+    typedef double Result;
+
+    NormDiffReduceBody(const Mat& _src1, const Mat& _src2, int _normType, const Mat& _mask)
+        : src1(_src1), src2(_src2), mask(_mask), normType(_normType == NORM_L2 ? NORM_L2SQR : _normType) {}
+
+    double operator()(const ReduceStripes& stripes, int i) const
+    {
+        return normDiffSerial(stripes.slice(src1, i), stripes.slice(src2, i), normType, stripes.slice(mask, i));
+    }
+
+    void merge(double& a, double b) const
+    {
+        if( normType == NORM_INF )
+            a = std::max(a, b);
+        else
+            a += b;
+    }
+
+    const Mat& src1;
+    const Mat& src2;
+    const Mat& mask;
+    int normType;
+};
+
+}
+
+double cv::norm( InputArray _src1, InputArray _src2, int normType, InputArray _mask )
+{
+    CV_TRACE_FUNCTION();
+
+    CV_Assert( _src1.sameSize(_src2) && _src1.type() == _src2.type() );
+
+#if defined HAVE_OPENCL || defined HAVE_IPP
+    double _result = 0;
+#endif
+
+#ifdef HAVE_OPENCL
+    CV_OCL_RUN_(OCL_PERFORMANCE_CHECK(_src1.isUMat()),
+                ocl_norm(_src1, _src2, normType, _mask, _result),
+                _result)
+#endif
+
+    CV_IPP_RUN(IPP_VERSION_X100 >= 700, ipp_norm(_src1, _src2, normType, _mask, _result), _result);
+
+    if( normType & CV_RELATIVE )
+    {
+        return norm(_src1, _src2, normType & ~CV_RELATIVE, _mask)/(norm(_src2, normType, _mask) + DBL_EPSILON);
+    }
+
+    Mat src1 = _src1.getMat(), src2 = _src2.getMat(), mask = _mask.getMat();
+
+    normType &= 7;
+    CV_Assert( normType == NORM_INF || normType == NORM_L1 ||
+               normType == NORM_L2 || normType == NORM_L2SQR ||
+              ((normType == NORM_HAMMING || normType == NORM_HAMMING2) && src1.type() == CV_8U) );
+
+    CV_Assert( mask.empty() || mask.type() == CV_8U );
+
+    double result = 0;
+    if( normType != NORM_HAMMING && normType != NORM_HAMMING2 &&
+        parallelReduce(NormDiffReduceBody(src1, src2, normType, mask), src1, result) )
+        return normType == NORM_L2 ? std::sqrt(result) : result;
+
+    return normDiffSerial(src1, src2, normType, mask);
+}
+
 
 ///////////////////////////////////// batch distance ///////////////////////////////////////
 
@@ -56,6 +56,36 @@ Mutex& getInitializationMutex()
 // force initialization (single-threaded environment)
 Mutex* __initialization_mutex_initializer = &getInitializationMutex();
 
+size_t getConfigurationParameterForSize(const char* name, size_t defaultValue)
+{
+#ifdef NO_GETENV
+    const char* envValue = NULL;
+#else
+    const char* envValue = getenv(name);
+#endif
+    if (envValue == NULL)
+    {
+        return defaultValue;
+    }
+    cv::String value = envValue;
+    size_t pos = 0;
+    for (; pos < value.size(); pos++)
+    {
+        if (!isdigit(value[pos]))
+            break;
+    }
+    cv::String valueStr = value.substr(0, pos);
+    cv::String suffixStr = value.substr(pos, value.length() - pos);
+    int v = atoi(valueStr.c_str());
+    if (suffixStr.length() == 0)
+        return v;
+    else if (suffixStr == "MB" || suffixStr == "Mb" || suffixStr == "mb")
+        return (size_t)v * 1024 * 1024;
+    else if (suffixStr == "KB" || suffixStr == "Kb" || suffixStr == "kb")
+        return (size_t)v * 1024;
+    CV_ErrorNoReturn(cv::Error::StsBadArg, cv::format("Invalid value for %s parameter: %s", name, value.c_str()));
+}
+
 } // namespace cv
 
 #ifdef _MSC_VER
@@ -247,6 +277,24 @@ struct HWFeatures
         x86_family = 0;
     }
 
+    // XCR0 register tells which register sets are enabled by the OS, osxsave is the CPUID.1:ECX.OSXSAVE bit
+    static int getXCR0(bool osxsave)
+    {
+        if( !osxsave )
+            return 0;
+    #if defined _MSC_VER && (defined _M_IX86 || defined _M_X64) && _MSC_FULL_VER >= 160040219
+        return (int)_xgetbv(0);
+    #elif defined __GNUC__ && (defined __i386__ || defined __x86_64__)
+        int eax, edx;
+        // xgetbv opcode, the old assemblers don't know the mnemonic
+        asm volatile(".byte 0x0f, 0x01, 0xd0" : "=a"(eax), "=d"(edx) : "c"(0));
+        (void)edx;
+        return eax;
+    #else
+        return 0;
+    #endif
+    }
+
     static HWFeatures initialize(void)
     {
         HWFeatures f;
@@ -333,6 +381,15 @@ struct HWFeatures
             f.have[CV_CPU_AVX_512BW]      = (cpuid_data[1] & (1<<30)) != 0;
             f.have[CV_CPU_AVX_512VL]      = (cpuid_data[1] & (1<<31)) != 0;
             f.have[CV_CPU_AVX_512VBMI]    = (cpuid_data[2] &  (1<<1)) != 0;
+
+            // the wide registers are usable only if the OS saves them on the context switch
+            int xcr0 = getXCR0(f.have[CV_CPU_AVX]);
+            bool haveYMM = (xcr0 & 0x06) == 0x06, haveZMM = (xcr0 & 0xe6) == 0xe6;
+            f.have[CV_CPU_AVX] = f.have[CV_CPU_AVX] && haveYMM;
+            f.have[CV_CPU_AVX2] = f.have[CV_CPU_AVX2] && haveYMM;
+            f.have[CV_CPU_FMA3] = f.have[CV_CPU_FMA3] && haveYMM;
+            for( int i = CV_CPU_AVX_512F; i <= CV_CPU_AVX_512VL; i++ )
+                f.have[i] = f.have[i] && haveZMM;
         }
 
     #if defined ANDROID || defined __linux__
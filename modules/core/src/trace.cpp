@@ -0,0 +1,458 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include <stdio.h>
+#if defined WIN32 || defined _WIN32 || defined WINCE
+#  include <process.h>
+#  define cv_trace_getpid _getpid
+#else
+#  include <unistd.h>
+#  define cv_trace_getpid getpid
+#endif
+
+namespace cv {
+namespace tracing {
+
+// The regions are kept in the per-thread stacks, the finished ones are buffered per thread and
+// written as the "complete" events of the Trace Event Format (chrome://tracing, Perfetto UI):
+//
+//   [
+//   {"name":"GaussianBlur","cat":"opencv","ph":"X","pid":1234,"tid":1,"ts":10.250,"dur":310.750,
+//    "args":{"id":4294967297,"parent":0,"impl":"plain","file":"smooth.cpp:1650"}},
+//   ...
+//   ]
+
+enum
+{
+    TRACE_MAX_DEPTH = 64,
+    TRACE_BUFFER_SIZE = 1024 // events per thread kept before writing them to the file
+};
+
+struct TraceEvent
+{
+    const char* name;
+    const char* filename;
+    int line;
+    int impl;
+    int64 begin, end;
+    int64 id, parent;
+    // the stripes of one parallel_for_ executed by the thread
+    int stripes;
+    Range range;
+    int64 busy;
+};
+
+struct TraceOpenRegion
+{
+    const Region::LocationStaticStorage* location;
+    int64 begin;
+    int64 id;
+    int impl;
+    bool recorded;
+};
+
+struct TraceThreadData
+{
+    TraceThreadData() : threadId(0), lastId(0), depth(0), stripeParent(0), stripeDepth(0), stripeJob(0) {}
+
+    int64 nextId() { return ((int64)threadId << 32) + (++lastId); }
+
+    // the innermost recorded region, the region of the parallel_for_ caller for the stripes
+    int64 currentId() const
+    {
+        for( int i = std::min(depth, (int)TRACE_MAX_DEPTH) - 1; i >= 0; i-- )
+            if( stack[i].recorded )
+                return stack[i].id;
+        return stripeParent;
+    }
+
+    int threadId;
+    int64 lastId;
+    int depth; // can exceed TRACE_MAX_DEPTH, the deeper regions are not tracked
+    TraceOpenRegion stack[TRACE_MAX_DEPTH];
+    int64 stripeParent;
+    int stripeDepth; // > 0 while a stripe of parallel_for_ is executed
+
+    // guards the fields below, they are taken by flush() called from other threads
+    Mutex mutex;
+    std::vector<TraceEvent> events;
+    int stripeJob;
+    TraceEvent stripe;
+};
+
+static volatile int traceLevel = 0;
+
+class TraceManager
+{
+public:
+    TraceManager() : file(NULL), firstEvent(true), threadsCount(0)
+    {
+        startTick = getTickCount();
+        tickFrequency = getTickFrequency();
+        pid = (int)cv_trace_getpid();
+#ifdef NO_GETENV
+        const char* location = NULL;
+#else
+        const char* location = getenv("OPENCV_TRACE_LOCATION");
+#endif
+        filename = location && *location ? location : "OpenCVTrace.json";
+    }
+
+    TraceThreadData* getThreadData()
+    {
+        TraceThreadData* data = tls.get();
+        if( data->threadId == 0 )
+        {
+            AutoLock lock(mutex);
+            data->threadId = ++threadsCount;
+            threads.push_back(data);
+        }
+        return data;
+    }
+
+    void addEvent(TraceThreadData& data, const TraceEvent& e)
+    {
+        std::vector<TraceEvent> events;
+        {
+            AutoLock lock(data.mutex);
+            data.events.push_back(e);
+            if( data.events.size() < TRACE_BUFFER_SIZE )
+                return;
+            std::swap(events, data.events);
+            data.events.reserve(TRACE_BUFFER_SIZE);
+        }
+        write(data.threadId, events);
+    }
+
+    // the pending stripes are reported when the thread picks up the stripes of another parallel_for_
+    void addStripe(TraceThreadData& data, int job, int64 parent, const Range& r, int64 begin, int64 end)
+    {
+        AutoLock lock(data.mutex);
+        TraceEvent& s = data.stripe;
+        if( data.stripeJob != job )
+        {
+            if( data.stripeJob != 0 )
+                data.events.push_back(s);
+            data.stripeJob = job;
+            s.name = "parallel_for_";
+            s.filename = NULL;
+            s.line = 0;
+            s.impl = 0;
+            s.begin = begin;
+            s.id = 0;
+            s.parent = parent;
+            s.stripes = 0;
+            s.range = r;
+            s.busy = 0;
+        }
+        s.end = end;
+        s.stripes++;
+        s.range.start = std::min(s.range.start, r.start);
+        s.range.end = std::max(s.range.end, r.end);
+        s.busy += end - begin;
+    }
+
+    void finishStripes(TraceThreadData& data, int job)
+    {
+        AutoLock lock(data.mutex);
+        if( data.stripeJob == job )
+        {
+            data.events.push_back(data.stripe);
+            data.stripeJob = 0;
+        }
+    }
+
+    // the regions which are open at the moment are not written
+    void flush()
+    {
+        std::vector<TraceThreadData*> allThreads;
+        {
+            AutoLock lock(mutex);
+            allThreads = threads;
+        }
+        for( size_t i = 0; i < allThreads.size(); i++ )
+        {
+            TraceThreadData& data = *allThreads[i];
+            std::vector<TraceEvent> events;
+            {
+                AutoLock lock(data.mutex);
+                if( data.stripeJob != 0 )
+                {
+                    data.events.push_back(data.stripe);
+                    data.stripeJob = 0;
+                }
+                std::swap(events, data.events);
+            }
+            write(data.threadId, events);
+        }
+        AutoLock lock(mutex);
+        if( file )
+            fflush(file);
+    }
+
+    void setLevel(int level)
+    {
+        CV_Assert( LEVEL_DISABLED <= level && level <= LEVEL_FINE );
+        if( level == traceLevel )
+            return;
+        if( level == LEVEL_DISABLED )
+        {
+            traceLevel = level;
+            close();
+        }
+        else
+        {
+            if( traceLevel == LEVEL_DISABLED )
+                open();
+            traceLevel = level;
+        }
+    }
+
+    void setOutputFile(const String& _filename)
+    {
+        CV_Assert( !_filename.empty() );
+        bool reopen = traceLevel != LEVEL_DISABLED;
+        if( reopen )
+            close();
+        {
+            AutoLock lock(mutex);
+            filename = _filename;
+        }
+        if( reopen )
+            open();
+    }
+
+    void open()
+    {
+        AutoLock lock(mutex);
+        if( file )
+            return;
+        file = fopen(filename.c_str(), "wt");
+        if( !file )
+            CV_Error_(Error::StsError, ("Can't open the trace file '%s'", filename.c_str()));
+        fputs("[\n", file);
+        firstEvent = true;
+    }
+
+    void close()
+    {
+        flush();
+        AutoLock lock(mutex);
+        if( file )
+        {
+            fputs("\n]\n", file);
+            fclose(file);
+            file = NULL;
+        }
+    }
+
+protected:
+    void write(int threadId, const std::vector<TraceEvent>& events)
+    {
+        if( events.empty() )
+            return;
+        AutoLock lock(mutex);
+        if( !file )
+            return;
+        double scale = 1e6/tickFrequency;
+        for( size_t i = 0; i < events.size(); i++ )
+        {
+            const TraceEvent& e = events[i];
+            fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"opencv\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,"
+                    "\"ts\":%.3f,\"dur\":%.3f,\"args\":{",
+                    firstEvent ? "" : ",\n", escape(e.name).c_str(), pid, threadId,
+                    (e.begin - startTick)*scale, (e.end - e.begin)*scale);
+            firstEvent = false;
+            if( e.filename )
+            {
+                static const char* impls[] = { "plain", "IPP", "OpenCL", "IPP+OpenCL" };
+                fprintf(file, "\"id\":%lld,\"parent\":%lld,\"impl\":\"%s\",\"file\":\"%s:%d\"}}",
+                        (long long)e.id, (long long)e.parent, impls[e.impl & 3],
+                        escape(fileName(e.filename)).c_str(), e.line);
+            }
+            else
+            {
+                fprintf(file, "\"parent\":%lld,\"stripes\":%d,\"begin\":%d,\"end\":%d,\"busy\":%.3f}}",
+                        (long long)e.parent, e.stripes, e.range.start, e.range.end, e.busy*scale);
+            }
+        }
+    }
+
+    static const char* fileName(const char* path)
+    {
+        const char* name = path;
+        for( const char* p = path; *p; p++ )
+            if( *p == '/' || *p == '\\' )
+                name = p + 1;
+        return name;
+    }
+
+    static String escape(const char* str)
+    {
+        String result;
+        for( ; *str; str++ )
+        {
+            char c = *str;
+            if( c == '"' || c == '\\' )
+                result += '\\';
+            result += (unsigned char)c < ' ' ? ' ' : c;
+        }
+        return result;
+    }
+
+    FILE* file;
+    String filename;
+    bool firstEvent;
+    int threadsCount;
+    int pid;
+    int64 startTick;
+    double tickFrequency;
+    Mutex mutex;
+    std::vector<TraceThreadData*> threads;
+    TLSData<TraceThreadData> tls;
+};
+
+static TraceManager& getTraceManager()
+{
+    CV_SINGLETON_LAZY_INIT_REF(TraceManager, new TraceManager())
+}
+
+// starts the trace if the OPENCV_TRACE environment variable is set and
+// writes the events which are still buffered when the process exits
+static struct TraceInitializer
+{
+    TraceInitializer()
+    {
+#ifndef NO_GETENV
+        const char* value = getenv("OPENCV_TRACE");
+        int level = value ? std::min(std::max(atoi(value), (int)LEVEL_DISABLED), (int)LEVEL_FINE) : 0;
+        if( level != LEVEL_DISABLED )
+            getTraceManager().setLevel(level);
+#endif
+    }
+
+    ~TraceInitializer()
+    {
+        if( traceLevel != LEVEL_DISABLED && !__termination )
+            getTraceManager().setLevel(LEVEL_DISABLED);
+    }
+} traceInitializer;
+
+void setLevel(int level)
+{
+    getTraceManager().setLevel(level);
+}
+
+int getLevel()
+{
+    return traceLevel;
+}
+
+void setOutputFile(const String& filename)
+{
+    getTraceManager().setOutputFile(filename);
+}
+
+void flush()
+{
+    if( traceLevel != LEVEL_DISABLED )
+        getTraceManager().flush();
+}
+
+void setImpl(int impl)
+{
+    if( traceLevel == LEVEL_DISABLED )
+        return;
+    TraceThreadData* data = getTraceManager().getThreadData();
+    for( int i = std::min(data->depth, (int)TRACE_MAX_DEPTH) - 1; i >= 0; i-- )
+        data->stack[i].impl |= impl;
+}
+
+Region::Region(const LocationStaticStorage& location) : data(NULL)
+{
+    int level = traceLevel;
+    if( level == LEVEL_DISABLED )
+        return;
+    TraceThreadData* d = getTraceManager().getThreadData();
+    data = d;
+    int depth = d->depth++;
+    if( depth >= TRACE_MAX_DEPTH )
+        return;
+    TraceOpenRegion& r = d->stack[depth];
+    r.location = &location;
+    r.impl = 0;
+    // only the outermost regions outside of the parallel_for_ stripes are recorded at the coarse level
+    r.recorded = level >= LEVEL_FINE || (depth == 0 && d->stripeDepth == 0);
+    r.id = r.recorded ? d->nextId() : 0;
+    r.begin = r.recorded ? getTickCount() : 0;
+}
+
+void Region::destroy()
+{
+    TraceThreadData* d = (TraceThreadData*)data;
+    int depth = --d->depth;
+    if( depth >= TRACE_MAX_DEPTH )
+        return;
+    const TraceOpenRegion& r = d->stack[depth];
+    if( !r.recorded || traceLevel == LEVEL_DISABLED )
+        return;
+    TraceEvent e;
+    e.end = getTickCount();
+    e.name = r.location->name;
+    e.filename = r.location->filename;
+    e.line = r.location->line;
+    e.impl = r.impl;
+    e.begin = r.begin;
+    e.id = r.id;
+    e.parent = d->currentId();
+    e.stripes = 0;
+    e.range = Range();
+    e.busy = 0;
+    getTraceManager().addEvent(*d, e);
+}
+
+static int traceJobs = 0;
+
+TraceParallelLoopBody::TraceParallelLoopBody(const ParallelLoopBody& _body)
+    : body(&_body), parent(0)
+{
+    job = CV_XADD(&traceJobs, 1) + 1;
+    if( job == 0 )
+        job = CV_XADD(&traceJobs, 1) + 1;
+    if( traceLevel != LEVEL_DISABLED )
+        parent = getTraceManager().getThreadData()->currentId();
+}
+
+TraceParallelLoopBody::~TraceParallelLoopBody()
+{
+    if( traceLevel != LEVEL_DISABLED )
+    {
+        TraceManager& manager = getTraceManager();
+        manager.finishStripes(*manager.getThreadData(), job);
+    }
+}
+
+void TraceParallelLoopBody::operator()(const Range& r) const
+{
+    if( traceLevel == LEVEL_DISABLED )
+    {
+        (*body)(r);
+        return;
+    }
+    TraceManager& manager = getTraceManager();
+    TraceThreadData* d = manager.getThreadData();
+    int64 prevParent = d->stripeParent;
+    d->stripeParent = parent;
+    d->stripeDepth++;
+    int64 begin = getTickCount();
+    (*body)(r);
+    int64 end = getTickCount();
+    d->stripeDepth--;
+    d->stripeParent = prevParent;
+    manager.addStripe(*d, job, parent, r, begin, end);
+}
+
+}} // namespace cv::tracing
@@ -144,7 +144,10 @@ MatAllocator* UMat::getStdAllocator()
     if( ocl::haveOpenCL() && ocl::useOpenCL() )
         return ocl::getOpenCLAllocator();
 #endif
-    return Mat::getDefaultAllocator();
+    // UMat is a plain host buffer then; unless the user has installed a custom allocator,
+    // the buffers are pooled, since T-API code creates the same temporary arrays over and over
+    MatAllocator* a = Mat::getDefaultAllocator();
+    return a == Mat::getStdAllocator() ? getPoolMatAllocator() : a;
 }
 
 void swap( UMat& a, UMat& b )
@@ -714,25 +717,36 @@ UMat UMat::reshape(int _cn, int _newndims, const int* _newsz) const
     return UMat();
 }
 
+// the Mat header of the mapped UMat; the caller has already incremented u->refcount
+static Mat getMatHeader(const UMat& m)
+{
+    UMatData* u = m.u;
+    Mat hdr(m.dims, m.size.p, m.type(), u->data + m.offset, m.step.p);
+    hdr.flags = m.flags;
+    hdr.u = u;
+    hdr.datastart = u->data;
+    hdr.data = u->data + m.offset;
+    hdr.datalimit = hdr.dataend = u->data + u->size;
+    return hdr;
+}
+
 Mat UMat::getMat(int accessFlags) const
 {
     if(!u)
         return Mat();
+    if (u->hostMemory())
+    {
+        // the host buffer is shared as is, only the reference counter is updated
+        CV_XADD(&u->refcount, 1);
+        return getMatHeader(*this);
+    }
     // TODO Support ACCESS_READ (ACCESS_WRITE) without unnecessary data transfers
     accessFlags |= ACCESS_RW;
     UMatDataAutoLock autolock(u);
     if(CV_XADD(&u->refcount, 1) == 0)
         u->currAllocator->map(u, accessFlags);
     if (u->data != 0)
-    {
-        Mat hdr(dims, size.p, type(), u->data + offset, step.p);
-        hdr.flags = flags;
-        hdr.u = u;
-        hdr.datastart = u->data;
-        hdr.data = u->data + offset;
-        hdr.datalimit = hdr.dataend = u->data + u->size;
-        return hdr;
-    }
+        return getMatHeader(*this);
     else
     {
         CV_XADD(&u->refcount, -1);
@@ -1844,3 +1844,225 @@ TEST(Normalize, regression_5876_inplace_change_type)
     normalize(m, m, 1, 0, NORM_MINMAX, CV_32F);
     EXPECT_EQ(0, cvtest::norm(m, result, NORM_INF));
 }
+
+typedef testing::TestWithParam<perf::MatDepth> Core_DivideDispatch;
+
+// the widest available kernel (SSE2/NEON, AVX2 or AVX-512) must match the scalar code,
+// the odd widths cover the tails of the vector loops
+TEST_P(Core_DivideDispatch, matches_scalar_code)
+{
+    int depth = GetParam();
+    RNG& rng = theRNG();
+    bool useOptimized = cv::useOptimized();
+
+    for (int width = 1; width <= 259; width += 17)
+    {
+        Mat src1(3, width, depth), src2(3, width, depth);
+        rng.fill(src1, RNG::UNIFORM, -100, 100);
+        rng.fill(src2, RNG::UNIFORM, -10, 10);
+        src2.row(1).setTo(Scalar::all(0));
+        double scale = rng.uniform(0.5, 2.0);
+
+        Mat div_simd, recip_simd, div_ref, recip_ref;
+        cv::setUseOptimized(true);
+        cv::divide(src1, src2, div_simd, scale);
+        cv::divide(scale, src2, recip_simd);
+        cv::setUseOptimized(false);
+        cv::divide(src1, src2, div_ref, scale);
+        cv::divide(scale, src2, recip_ref);
+        cv::setUseOptimized(useOptimized);
+
+        double eps = depth <= CV_32S ? 1 : 0;
+        ASSERT_LE(cvtest::norm(div_simd, div_ref, NORM_INF), eps) << "width=" << width;
+        ASSERT_LE(cvtest::norm(recip_simd, recip_ref, NORM_INF), eps) << "width=" << width;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Arithm, Core_DivideDispatch,
+                        testing::Values(CV_8U, CV_8S, CV_16U, CV_16S, CV_32S, CV_32F, CV_64F));
+
+typedef testing::TestWithParam<perf::MatDepth> Core_ArithmDispatch;
+
+// add, subtract, absdiff, multiply and addWeighted: the dispatched kernels must be bit-exact
+// with the scalar code, the odd widths cover the tails of the vector loops
+TEST_P(Core_ArithmDispatch, matches_scalar_code)
+{
+    int depth = GetParam();
+    RNG& rng = theRNG();
+    bool useOptimized = cv::useOptimized();
+    const int nops = 6;
+
+    for (int width = 1; width <= 259; width += 17)
+    {
+        Mat src1(3, width, depth), src2(3, width, depth);
+        rng.fill(src1, RNG::UNIFORM, -1000, 1000);
+        rng.fill(src2, RNG::UNIFORM, -1000, 1000);
+        double scale = rng.uniform(0.01, 0.1), alpha = rng.uniform(-2.0, 2.0),
+               beta = rng.uniform(-2.0, 2.0), gamma = rng.uniform(-100.0, 100.0);
+
+        Mat dst[2][nops];
+        for (int k = 0; k < 2; k++)
+        {
+            cv::setUseOptimized(k == 0);
+            cv::add(src1, src2, dst[k][0]);
+            cv::subtract(src1, src2, dst[k][1]);
+            cv::absdiff(src1, src2, dst[k][2]);
+            cv::multiply(src1, src2, dst[k][3]);
+            cv::multiply(src1, src2, dst[k][4], scale);
+            cv::addWeighted(src1, alpha, src2, beta, gamma, dst[k][5]);
+        }
+        cv::setUseOptimized(useOptimized);
+
+        for (int i = 0; i < nops; i++)
+            ASSERT_EQ(0, cvtest::norm(dst[0][i], dst[1][i], NORM_INF)) << "width=" << width << " op=" << i;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Arithm, Core_ArithmDispatch,
+                        testing::Values(CV_8U, CV_8S, CV_16U, CV_16S, CV_32S, CV_32F, CV_64F));
+
+typedef testing::TestWithParam<perf::MatDepth> Core_ConvertScaleDispatch;
+
+// convertTo with the float working type: the dispatched AVX2/AVX-512 kernels must be bit-exact
+// with the baseline ones, which are used when the optimizations are turned off
+TEST_P(Core_ConvertScaleDispatch, bitexact)
+{
+    int sdepth = GetParam();
+    RNG& rng = theRNG();
+    bool useOptimized = cv::useOptimized();
+
+    for (int width = 1; width <= 259; width += 17)
+    {
+        Mat src(3, width, sdepth);
+        rng.fill(src, RNG::UNIFORM, -1000, 1000);
+        double scale = rng.uniform(-3.0, 3.0), shift = rng.uniform(-100.0, 100.0);
+
+        for (int ddepth = CV_8U; ddepth <= CV_32F; ddepth++)
+        {
+            Mat dst_opt, dst_ref;
+            cv::setUseOptimized(true);
+            src.convertTo(dst_opt, ddepth, scale, shift);
+            cv::setUseOptimized(false);
+            src.convertTo(dst_ref, ddepth, scale, shift);
+            cv::setUseOptimized(useOptimized);
+
+            ASSERT_EQ(0, cvtest::norm(dst_opt, dst_ref, NORM_INF)) << "width=" << width << " ddepth=" << ddepth;
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Arithm, Core_ConvertScaleDispatch,
+                        testing::Values(CV_8U, CV_8S, CV_16U, CV_16S, CV_32F));
+
+// the large arrays are processed by the parallel stripes of rows (or of columns when there are few rows),
+// the result must be the same as the one computed by the single thread
+TEST(Core_Arithm, parallel_stripes)
+{
+    RNG& rng = theRNG();
+    int nthreads = cv::getNumThreads();
+    Size sizes[] = { Size(640, 480), Size(300000, 3) };
+
+    for (int k = 0; k < 2; k++)
+    {
+        Mat big1(sizes[k].height + 2, sizes[k].width + 2, CV_8UC3), big2(big1.size(), CV_16SC3);
+        Mat src1 = big1(Rect(Point(1, 1), sizes[k])), src2 = big2(Rect(Point(1, 1), sizes[k]));
+        Mat mask(sizes[k], CV_8U), src1s;
+        rng.fill(big1, RNG::UNIFORM, 0, 256);
+        rng.fill(big2, RNG::UNIFORM, -1000, 1000);
+        rng.fill(mask, RNG::UNIFORM, 0, 2);
+        src1.convertTo(src1s, CV_16S);
+
+        Mat dst[2][9];
+        for (int i = 0; i < 2; i++)
+        {
+            cv::setNumThreads(i == 0 ? 1 : 4);
+            dst[i][0] = Mat::zeros(src1.size(), src1.type());
+            cv::add(src1, src1, dst[i][0], mask);
+            cv::subtract(src1, src2, dst[i][1], noArray(), CV_32F);
+            cv::multiply(src1s, src2, dst[i][2], 0.3);
+            cv::absdiff(src1, Scalar(10, 100, 200), dst[i][3]);
+            cv::compare(src1s, src2, dst[i][4], CMP_GT);
+            cv::compare(src2, 100.5, dst[i][5], CMP_LE);
+            dst[i][6] = Mat::zeros(src1.size(), src1.type());
+            cv::bitwise_and(src1, Scalar(0x0f, 0xf0, 0x3c), dst[i][6], mask);
+            cv::bitwise_xor(src1, src1.clone(), dst[i][7]);
+            dst[i][8] = Mat::zeros(src1.size(), CV_32FC3);
+            cv::add(src1, src2, dst[i][8], mask, CV_32F);
+        }
+        cv::setNumThreads(nthreads);
+
+        for (int j = 0; j < 9; j++)
+            ASSERT_EQ(0, cvtest::norm(dst[0][j], dst[1][j], NORM_INF)) << "size=" << sizes[k] << " op=" << j;
+    }
+}
+
+TEST(Core_Stat, parallel_stripes)
+{
+    RNG& rng = theRNG();
+    int nthreads = cv::getNumThreads();
+    Size sizes[] = { Size(640, 480), Size(300000, 3), Size(1000000, 1) };
+
+    for (int k = 0; k < 3; k++)
+    {
+        Mat big(sizes[k].height + 2, sizes[k].width + 2, CV_32FC1);
+        Mat src = big(Rect(Point(1, 1), sizes[k])), src2(sizes[k], CV_32FC1), src8u, mask(sizes[k], CV_8U);
+        rng.fill(big, RNG::UNIFORM, -100, 100);
+        rng.fill(src2, RNG::UNIFORM, -100, 100);
+        rng.fill(mask, RNG::UNIFORM, 0, 2);
+        src.convertTo(src8u, CV_8U);
+
+        // the equal extremums in the different stripes, the first one in the row-major order is reported
+        int w = sizes[k].width, h = sizes[k].height;
+        Point minLoc0(w/2, 0), maxLoc0(w/3, 0);
+        src.at<float>(h - 1, w - 1) = src.at<float>(h - 1, h > 1 ? 0 : w - 3) = src.at<float>(minLoc0) = -200.f;
+        src.at<float>(h - 1, w - 2) = src.at<float>(h - 1, h > 1 ? 1 : w - 4) = src.at<float>(maxLoc0) = 200.f;
+
+        Scalar s[2], m[2], sdv[2];
+        double n[2][6], minv[2], maxv[2];
+        Point minLoc[2], maxLoc[2];
+        int nz[2];
+        for (int i = 0; i < 2; i++)
+        {
+            cv::setNumThreads(i == 0 ? 1 : 4);
+            s[i] = cv::sum(src);
+            m[i] = cv::mean(src8u, mask);
+            cv::meanStdDev(src, m[i], sdv[i], mask);
+            n[i][0] = cv::norm(src, NORM_L1);
+            n[i][1] = cv::norm(src, NORM_L2);
+            n[i][2] = cv::norm(src8u, NORM_INF, mask);
+            n[i][3] = cv::norm(src, src2, NORM_L2SQR);
+            n[i][4] = cv::norm(src, src2, NORM_INF, mask);
+            n[i][5] = cv::norm(src8u, src2 > 0, NORM_L1);
+            cv::minMaxLoc(src, &minv[i], &maxv[i], &minLoc[i], &maxLoc[i]);
+            nz[i] = cv::countNonZero(src8u);
+        }
+        cv::setNumThreads(nthreads);
+
+        for (int j = 0; j < 4; j++)
+        {
+            EXPECT_EQ(s[0][j], s[1][j]) << "size=" << sizes[k];
+            EXPECT_EQ(m[0][j], m[1][j]) << "size=" << sizes[k];
+            EXPECT_EQ(sdv[0][j], sdv[1][j]) << "size=" << sizes[k];
+        }
+        for (int j = 0; j < 6; j++)
+            EXPECT_EQ(n[0][j], n[1][j]) << "size=" << sizes[k] << " norm=" << j;
+        EXPECT_EQ(nz[0], nz[1]);
+        EXPECT_EQ(minv[0], minv[1]);
+        EXPECT_EQ(maxv[0], maxv[1]);
+
+        EXPECT_EQ(-200., minv[1]);
+        EXPECT_EQ(200., maxv[1]);
+        EXPECT_EQ(minLoc0, minLoc[1]) << "size=" << sizes[k];
+        EXPECT_EQ(maxLoc0, maxLoc[1]) << "size=" << sizes[k];
+
+        double s0 = 0, n0 = 0;
+        for (int y = 0; y < src.rows; y++)
+        {
+            s0 += cv::sum(src.row(y))[0];
+            n0 += cv::norm(src.row(y), src2.row(y), NORM_L2SQR);
+        }
+        EXPECT_LE(fabs(s[1][0] - s0), 1e-6*cvtest::norm(src, NORM_L1)) << "size=" << sizes[k];
+        EXPECT_LE(fabs(n[1][3] - n0), 1e-6*n0) << "size=" << sizes[k];
+        EXPECT_EQ(cvtest::norm(src8u, NORM_L1) > 0, nz[1] > 0);
+    }
+}
@@ -887,3 +887,64 @@ TEST(Core_DFT, complex_output2)
         }
     }
 }
+
+TEST(Core_DFT, plan)
+{
+    RNG& rng = theRNG();
+    int nthreads = getNumThreads();
+    const int flags[] = { 0, DFT_INVERSE, DFT_SCALE, DFT_ROWS, DFT_COMPLEX_OUTPUT,
+                          DFT_INVERSE | DFT_REAL_OUTPUT | DFT_SCALE, DFT_ROWS | DFT_COMPLEX_OUTPUT };
+    const int types[] = { CV_32FC1, CV_32FC2, CV_64FC1, CV_64FC2 };
+
+    for( int iter = 0; iter < 40; iter++ )
+    {
+        Size sz(rng.uniform(1, 300), rng.uniform(1, 300));
+        if( iter % 4 == 0 )
+            sz.height = 1;
+        int type = types[rng.uniform(0, 4)], fl = flags[rng.uniform(0, 7)];
+        if( (fl & DFT_REAL_OUTPUT) && CV_MAT_CN(type) == 1 )
+            fl &= ~DFT_REAL_OUTPUT;
+
+        Mat src(sz, type), ref, dst;
+        randu(src, -1., 1.);
+
+        // the rows of the large arrays are transformed in parallel, the result must not depend on it
+        setNumThreads(1);
+        dft(src, ref, fl);
+        setNumThreads(4);
+        dft(src, dst, fl);
+        setNumThreads(nthreads);
+        ASSERT_EQ(0, cvtest::norm(ref, dst, NORM_INF)) << "size=" << sz << " type=" << type << " flags=" << fl;
+
+        Ptr<DFTPlan> plan = DFTPlan::create(sz, type, fl);
+        ASSERT_EQ(sz, plan->size());
+        ASSERT_EQ(type, plan->type());
+        plan->apply(src, dst);
+        ASSERT_EQ(0, cvtest::norm(ref, dst, NORM_INF)) << "size=" << sz << " type=" << type << " flags=" << fl;
+
+        dst = src.clone();
+        if( dst.type() == ref.type() )
+        {
+            plan->apply(dst, dst);
+            ASSERT_EQ(0, cvtest::norm(ref, dst, NORM_INF)) << "in-place, size=" << sz << " type=" << type << " flags=" << fl;
+        }
+
+        std::vector<Mat> srcs(5), dsts;
+        for( size_t i = 0; i < srcs.size(); i++ )
+        {
+            srcs[i].create(sz, type);
+            randu(srcs[i], -1., 1.);
+        }
+        plan->applyBatch(srcs, dsts);
+        ASSERT_EQ(srcs.size(), dsts.size());
+        for( size_t i = 0; i < srcs.size(); i++ )
+        {
+            dft(srcs[i], ref, fl);
+            ASSERT_EQ(0, cvtest::norm(ref, dsts[i], NORM_INF)) << "batch, size=" << sz << " type=" << type << " flags=" << fl;
+        }
+    }
+
+    Mat src(8, 8, CV_32FC1, Scalar::all(1)), dst;
+    EXPECT_THROW(DFTPlan::create(Size(8, 8), CV_32FC2)->apply(src, dst), cv::Exception);
+    EXPECT_THROW(DFTPlan::create(Size(8, 8), CV_8UC1), cv::Exception);
+}
@@ -412,3 +412,34 @@ TEST(Core_Eigen, scalar_32) {Core_EigenTest_Scalar_32 test; test.safe_run(); }
 TEST(Core_Eigen, scalar_64) {Core_EigenTest_Scalar_64 test; test.safe_run(); }
 TEST(Core_Eigen, vector_32) { Core_EigenTest_32 test; test.safe_run(); }
 TEST(Core_Eigen, vector_64) { Core_EigenTest_64 test; test.safe_run(); }
+
+TEST(Core_Eigen, large)
+{
+    RNG& rng = theRNG();
+    const int n = 300;
+
+    for( int type = CV_32F; type <= CV_64F; type++ )
+    {
+        Mat a(n, n, type), evals, evects;
+        rng.fill(a, RNG::UNIFORM, -1, 1);
+        completeSymm(a);
+        ASSERT_TRUE(eigen(a, evals, evects));
+        ASSERT_EQ(Size(1, n), evals.size());
+        ASSERT_EQ(Size(n, n), evects.size());
+
+        Mat ad, wd, vd;
+        a.convertTo(ad, CV_64F);
+        evals.convertTo(wd, CV_64F);
+        evects.convertTo(vd, CV_64F);
+        for( int i = 1; i < n; i++ )
+            ASSERT_LE(wd.at<double>(i), wd.at<double>(i-1));
+
+        double eps = type == CV_32F ? 1e-4 : 1e-10;
+        EXPECT_LE(cvtest::norm(vd*vd.t(), Mat::eye(n, n, CV_64F), NORM_INF), eps);
+        EXPECT_LE(cvtest::norm(vd*ad, Mat::diag(wd)*vd, NORM_INF), eps*cvtest::norm(wd, NORM_INF));
+
+        Mat evals1;
+        eigen(a, evals1);
+        EXPECT_LE(cvtest::norm(evals, evals1, NORM_INF), eps*cvtest::norm(wd, NORM_INF));
+    }
+}
@@ -566,3 +566,170 @@ TEST(Core_InputOutput, FileStorage)
     sprintf(arr, "sprintf is hell %d", 666);
     EXPECT_NO_THROW(f << arr);
 }
+
+TEST(Core_InputOutput, FileStorage_binary)
+{
+    std::string file = cv::tempfile(".cvbin");
+    RNG& rng = theRNG();
+
+    Mat m8u(37, 41, CV_8UC3), m32f(100, 7, CV_32F), m64f(5, 5, CV_64FC2), big(480, 640, CV_16S);
+    rng.fill(m8u, RNG::UNIFORM, 0, 256);
+    rng.fill(m32f, RNG::UNIFORM, -1000, 1000);
+    rng.fill(m64f, RNG::UNIFORM, -1, 1);
+    rng.fill(big, RNG::UNIFORM, -30000, 30000);
+    Mat roi = big(Rect(13, 17, 101, 33));
+    int sz[] = { 3, 4, 5 };
+    Mat nd(3, sz, CV_32S);
+    rng.fill(nd, RNG::UNIFORM, -100, 100);
+
+    {
+        FileStorage fs(file, FileStorage::WRITE);
+        ASSERT_TRUE(fs.isOpened());
+        fs << "name" << "model" << "count" << 7;
+        fs << "m8u" << m8u << "m32f" << m32f << "m64f" << m64f;
+        fs << "roi" << roi << "nd" << nd << "empty" << Mat();
+        fs << "seq" << "[" << m32f.row(3) << m8u.col(5) << "]";
+    }
+
+    Mat r8u, r32f, r64f, rroi, rnd, rempty, rseq0, rseq1;
+    {
+        FileStorage fs(file, FileStorage::READ);
+        ASSERT_TRUE(fs.isOpened());
+        EXPECT_EQ("model", (String)fs["name"]);
+        EXPECT_EQ(7, (int)fs["count"]);
+        fs["m8u"] >> r8u;
+        fs["m32f"] >> r32f;
+        fs["m64f"] >> r64f;
+        fs["roi"] >> rroi;
+        fs["nd"] >> rnd;
+        fs["empty"] >> rempty;
+        FileNode seq = fs["seq"];
+        ASSERT_EQ(2u, seq.size());
+        seq[0] >> rseq0;
+        seq[1] >> rseq1;
+    }
+
+    // the matrices stay valid after the storage is released
+    EXPECT_EQ(0, cvtest::norm(m8u, r8u, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(m32f, r32f, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(m64f, r64f, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(roi, rroi, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(nd, rnd, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(m32f.row(3), rseq0, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(m8u.col(5), rseq1, NORM_INF));
+    EXPECT_TRUE(rempty.empty());
+    EXPECT_EQ(0, (int)((size_t)r32f.data % 64));
+
+    // the modifications of the loaded matrices do not reach the file
+    r32f.setTo(Scalar::all(0));
+    {
+        FileStorage fs(file, FileStorage::READ);
+        Mat again;
+        fs["m32f"] >> again;
+        EXPECT_EQ(0, cvtest::norm(m32f, again, NORM_INF));
+
+        // the C API copies the data out of the mapped file
+        CvMat* cm = (CvMat*)fs["m64f"].readObj();
+        ASSERT_TRUE(cm != NULL);
+        EXPECT_EQ(0, cvtest::norm(m64f, cvarrToMat(cm), NORM_INF));
+        cvReleaseMat(&cm);
+    }
+
+    EXPECT_THROW(FileStorage(file, FileStorage::WRITE + FileStorage::MEMORY + FileStorage::FORMAT_BINARY), cv::Exception);
+    remove(file.c_str());
+}
+
+TEST(Core_InputOutput, FileStreamReader)
+{
+    const char* exts[] = { ".yml", ".xml", ".cvbin", ".yml.gz" };
+    RNG& rng = theRNG();
+
+    Mat m8u(37, 41, CV_8UC3), m32f(100, 7, CV_32F), m64f(5, 5, CV_64FC2);
+    rng.fill(m8u, RNG::UNIFORM, 0, 256);
+    rng.fill(m32f, RNG::UNIFORM, -1000, 1000);
+    rng.fill(m64f, RNG::UNIFORM, -1, 1);
+    int sz[] = { 3, 4, 5 };
+    Mat nd(3, sz, CV_16S);
+    rng.fill(nd, RNG::UNIFORM, -1000, 1000);
+
+    for( size_t k = 0; k < sizeof(exts)/sizeof(exts[0]); k++ )
+    {
+        SCOPED_TRACE(exts[k]);
+        std::string file = cv::tempfile(exts[k]);
+        {
+            FileStorage fs(file, FileStorage::WRITE);
+            ASSERT_TRUE(fs.isOpened());
+            fs << "name" << "model" << "skipped" << "{" << "a" << m8u << "b" << "[:" << 1 << 2 << 3 << "]" << "}";
+            fs << "trees" << "[";
+            for( int i = 0; i < 3; i++ )
+                fs << "{" << "id" << i << "weights" << m32f.row(i) << "}";
+            fs << "]";
+            fs << "m8u" << m8u << "m32f" << m32f << "m64f" << m64f << "nd" << nd << "empty" << Mat();
+            fs << "tail" << 3.5;
+        }
+
+        FileStreamReader reader(file);
+        ASSERT_TRUE(reader.isOpened());
+        EXPECT_EQ(1, reader.depth());
+
+        ASSERT_TRUE(reader.next());
+        EXPECT_EQ("name", reader.name());
+        EXPECT_EQ(FileNode::STRING, reader.type());
+        EXPECT_EQ("model", (String)reader.node());
+
+        ASSERT_TRUE(reader.next());
+        EXPECT_EQ("skipped", reader.name());
+        EXPECT_EQ(FileNode::MAP, reader.type());
+
+        ASSERT_TRUE(reader.next());
+        EXPECT_EQ("trees", reader.name());
+        ASSERT_EQ(FileNode::SEQ, reader.type());
+        reader.enter();
+        EXPECT_EQ(2, reader.depth());
+        for( int i = 0; i < 2; i++ )
+        {
+            ASSERT_TRUE(reader.next());
+            EXPECT_TRUE(reader.name().empty());
+            FileNode tree = reader.node();
+            ASSERT_TRUE(tree.isMap());
+            EXPECT_EQ(i, (int)tree["id"]);
+            Mat w;
+            tree["weights"] >> w;
+            EXPECT_EQ(0, cvtest::norm(m32f.row(i), w, NORM_INF));
+        }
+        // the last tree is left unread
+        reader.leave();
+        EXPECT_EQ(1, reader.depth());
+        EXPECT_EQ("trees", reader.name());
+
+        Mat r8u, r32f, r64f, rnd, rempty;
+        ASSERT_TRUE(reader.next());
+        EXPECT_EQ("m8u", reader.name());
+        reader.read(r8u);
+        ASSERT_TRUE(reader.next());
+        reader.read(r32f);
+        ASSERT_TRUE(reader.next());
+        reader.read(r64f);
+        ASSERT_TRUE(reader.next());
+        reader.read(rnd);
+        ASSERT_TRUE(reader.next());
+        EXPECT_EQ("empty", reader.name());
+        reader.read(rempty);
+        EXPECT_EQ(0, cvtest::norm(m8u, r8u, NORM_INF));
+        EXPECT_EQ(0, cvtest::norm(m32f, r32f, NORM_INF));
+        EXPECT_EQ(0, cvtest::norm(m64f, r64f, NORM_INF));
+        EXPECT_EQ(0, cvtest::norm(nd, rnd, NORM_INF));
+        EXPECT_TRUE(rempty.empty());
+
+        ASSERT_TRUE(reader.next());
+        EXPECT_EQ("tail", reader.name());
+        EXPECT_EQ(FileNode::REAL, reader.type());
+        EXPECT_EQ(3.5, (double)reader.node());
+        EXPECT_FALSE(reader.next());
+        EXPECT_FALSE(reader.next());
+        EXPECT_THROW(reader.leave(), cv::Exception);
+
+        reader.release();
+        remove(file.c_str());
+    }
+}
@@ -1147,6 +1147,118 @@ protected:
 };
 
 TEST(Core_PCA, accuracy) { Core_PCATest test; test.safe_run(); }
+
+TEST(Core_PCA, randomized)
+{
+    RNG& rng = theRNG();
+    const int count = 1000, len = 200, maxComponents = 5;
+
+    // the samples are concentrated around the low-dimensional subspace
+    Mat basis(maxComponents, len, CV_32F), coeffs(count, maxComponents, CV_32F), data(count, len, CV_32F);
+    rng.fill(basis, RNG::NORMAL, 0, 1);
+    rng.fill(coeffs, RNG::NORMAL, 0, 10);
+    rng.fill(data, RNG::NORMAL, 1, 0.01);
+    data += coeffs*basis;
+
+    for( int flags = PCA::DATA_AS_ROW; flags <= PCA::DATA_AS_COL; flags++ )
+    {
+        Mat samples = flags == PCA::DATA_AS_COL ? Mat(data.t()) : data;
+        PCA pca0(samples, noArray(), flags, maxComponents);
+        PCA pca(samples, noArray(), flags | PCA::RANDOMIZED, maxComponents);
+
+        ASSERT_EQ(pca0.mean.size(), pca.mean.size());
+        ASSERT_EQ(pca0.eigenvalues.size(), pca.eigenvalues.size());
+        ASSERT_EQ(pca0.eigenvectors.size(), pca.eigenvectors.size());
+        EXPECT_LE(cvtest::norm(pca.mean, pca0.mean, NORM_INF), 1e-4);
+        EXPECT_LE(cvtest::norm(pca.eigenvalues, pca0.eigenvalues, NORM_RELATIVE + NORM_INF), 1e-3);
+
+        // the eigenvectors are defined up to the sign
+        Mat prod = abs(pca.eigenvectors*pca0.eigenvectors.t());
+        EXPECT_LE(cvtest::norm(prod, Mat::eye(maxComponents, maxComponents, CV_32F), NORM_INF), 1e-3);
+
+        Mat rec = pca.backProject(pca.project(samples)), rec0 = pca0.backProject(pca0.project(samples));
+        EXPECT_LE(cvtest::norm(rec, rec0, NORM_INF), 1e-2);
+    }
+}
+
+class PCAAccumulatorShards : public ParallelLoopBody
+{
+public:
+    PCAAccumulatorShards(const Mat& _data, std::vector<PCAAccumulator>& _acc) : data(_data), acc(_acc) {}
+
+    void operator()(const Range& range) const
+    {
+        int nshards = (int)acc.size();
+        for( int i = range.start; i < range.end; i++ )
+        {
+            // each shard is added by the batches of the different sizes
+            Mat shard = data.rowRange(data.rows*i/nshards, data.rows*(i+1)/nshards);
+            for( int y = 0, batch = 1; y < shard.rows; y += batch, batch = batch*3 + 1 )
+                acc[i].add(shard.rowRange(y, std::min(y + batch, shard.rows)));
+        }
+    }
+
+private:
+    PCAAccumulatorShards& operator=(const PCAAccumulatorShards&);
+
+    const Mat& data;
+    std::vector<PCAAccumulator>& acc;
+};
+
+TEST(Core_PCA, accumulator)
+{
+    RNG& rng = theRNG();
+    const int count = 3000, dims = 40, maxComponents = 10;
+
+    // the samples with the distinct variances along the random orthogonal axes and the large offset
+    Mat axes(dims, dims, CV_64F), w, u, vt, coeffs(count, dims, CV_64F), data;
+    rng.fill(axes, RNG::NORMAL, 0, 1);
+    SVD::compute(axes, w, u, vt);
+    rng.fill(coeffs, RNG::NORMAL, 0, 1);
+    for( int i = 0; i < dims; i++ )
+    {
+        Mat c = coeffs.col(i);
+        c *= dims - i;
+    }
+    Mat(coeffs*vt + 1000).convertTo(data, CV_32F);
+
+    PCA pca0(data, noArray(), PCA::DATA_AS_ROW, maxComponents);
+
+    std::vector<PCAAccumulator> acc(7);
+    parallel_for_(Range(0, (int)acc.size()), PCAAccumulatorShards(data, acc));
+    PCAAccumulator total;
+    for( size_t i = 0; i < acc.size(); i++ )
+        total.merge(acc[i]);
+    ASSERT_EQ((int64)count, total.count);
+
+    PCA pca;
+    total.compute(pca, PCA::DATA_AS_ROW, maxComponents);
+    ASSERT_EQ(CV_32F, pca.eigenvectors.type());
+    ASSERT_EQ(pca0.mean.size(), pca.mean.size());
+    ASSERT_EQ(pca0.eigenvectors.size(), pca.eigenvectors.size());
+    EXPECT_LE(cvtest::norm(pca.mean, pca0.mean, NORM_INF), 1e-2);
+    EXPECT_LE(cvtest::norm(pca.eigenvalues, pca0.eigenvalues, NORM_RELATIVE + NORM_INF), 1e-4);
+    Mat prod = abs(pca.eigenvectors*pca0.eigenvectors.t());
+    EXPECT_LE(cvtest::norm(prod, Mat::eye(maxComponents, maxComponents, CV_32F), NORM_INF), 1e-3);
+
+    // the samples stored as columns, all at once
+    PCAAccumulator accCols;
+    accCols.add(Mat(data.t()), PCA::DATA_AS_COL);
+    PCA pcaCols;
+    accCols.compute(pcaCols, PCA::DATA_AS_COL, maxComponents);
+    ASSERT_EQ(Size(1, dims), pcaCols.mean.size());
+    EXPECT_LE(cvtest::norm(pcaCols.mean.t(), pca.mean, NORM_INF), 1e-2);
+    EXPECT_LE(cvtest::norm(pcaCols.eigenvalues, pca.eigenvalues, NORM_RELATIVE + NORM_INF), 1e-4);
+
+    // retained variance
+    PCA pcaVar0(data, noArray(), PCA::DATA_AS_ROW, 0.9), pcaVar;
+    total.compute(pcaVar, PCA::DATA_AS_ROW, 0.9);
+    EXPECT_EQ(pcaVar0.eigenvalues.rows, pcaVar.eigenvalues.rows);
+
+    total.clear();
+    EXPECT_EQ(0, total.count);
+    EXPECT_THROW(total.compute(pca), cv::Exception);
+}
 TEST(Core_Reduce, accuracy) { Core_ReduceTest test; test.safe_run(); }
 TEST(Core_Array, basic_operations) { Core_ArrayOpTest test; test.safe_run(); }
 
@@ -1483,3 +1595,345 @@ TEST(Mat, regression_5991)
     EXPECT_EQ(sz[2], mat.size[2]);
     EXPECT_EQ(0, cvtest::norm(mat, Mat(3, sz, CV_8U, Scalar(1)), NORM_INF));
 }
+
+TEST(Core_MatAllocator, pool_reuses_released_buffers)
+{
+    MatAllocator* pool = getPoolMatAllocator();
+    BufferPoolController* c = pool->getBufferPoolController();
+    c->freeAllReservedBuffers();
+    resetPoolMatAllocatorStats();
+    EXPECT_EQ(0u, c->getReservedSize());
+
+    MatAllocator* prevAllocator = Mat::getDefaultAllocator();
+    {
+        MatAllocatorScope scope(pool);
+        EXPECT_EQ(pool, Mat::getDefaultAllocator());
+
+        uchar* data = 0;
+        {
+            Mat m(480, 640, CV_8UC3);
+            EXPECT_EQ(pool, m.u->currAllocator);
+            data = m.data;
+        }
+        EXPECT_GE(c->getReservedSize(), (size_t)480*640*3);
+
+        // the same size class
+        Mat m(481, 640, CV_8UC3);
+        EXPECT_EQ(data, m.data);
+        EXPECT_EQ(0u, c->getReservedSize());
+    }
+    EXPECT_EQ(prevAllocator, Mat::getDefaultAllocator());
+
+    BufferPoolStats stats = getPoolMatAllocatorStats();
+    EXPECT_EQ(2u, stats.allocations);
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_DOUBLE_EQ(0.5, stats.hitRate());
+
+    c->freeAllReservedBuffers();
+    EXPECT_EQ(0u, c->getReservedSize());
+}
+
+class MatAllocatorScopeBody : public ParallelLoopBody
+{
+public:
+    MatAllocatorScopeBody(int* _errors) : errors(_errors) {}
+
+    void operator()(const Range& range) const
+    {
+        for( int i = range.start; i < range.end; i++ )
+        {
+            // the neighbor stripes, which run concurrently, install different allocators
+            MatAllocator* a = i % 2 ? getPoolMatAllocator() : Mat::getStdAllocator();
+            MatAllocatorScope scope(a);
+            for( int j = 0; j < 10; j++ )
+            {
+                Mat m(64, 64 + j, CV_8UC1);
+                if( m.u->currAllocator != a || Mat::getDefaultAllocator() != a )
+                    CV_XADD(errors, 1);
+            }
+        }
+    }
+
+private:
+    int* errors;
+};
+
+TEST(Core_MatAllocator, scope_is_thread_local)
+{
+    MatAllocator* prevAllocator = Mat::getDefaultAllocator();
+    int errors = 0;
+    parallel_for_(Range(0, 64), MatAllocatorScopeBody(&errors), 64);
+    EXPECT_EQ(0, errors);
+    EXPECT_EQ(prevAllocator, Mat::getDefaultAllocator());
+}
+
+class PoolChurnBody : public ParallelLoopBody
+{
+public:
+    void operator()(const Range& range) const
+    {
+        MatAllocatorScope scope(getPoolMatAllocator());
+        std::vector<Mat> mats;
+        for( int i = range.start; i < range.end; i++ )
+            mats.push_back(Mat(1, 1024*(1 + i % 32), CV_8UC1));
+    }
+};
+
+TEST(Core_MatAllocator, pool_limit_includes_thread_caches)
+{
+    BufferPoolController* c = getPoolMatAllocator()->getBufferPoolController();
+    size_t prevLimit = c->getMaxReservedSize();
+    c->setMaxReservedSize((size_t)1 << 20);
+
+    parallel_for_(Range(0, 4096), PoolChurnBody(), 64);
+    EXPECT_LE(c->getReservedSize(), (size_t)1 << 20);
+
+    c->setMaxReservedSize(prevLimit);
+    c->freeAllReservedBuffers();
+    EXPECT_EQ(0u, c->getReservedSize());
+}
+
+TEST(Core_Sort, parallel_rows_and_columns)
+{
+    RNG& rng = theRNG();
+    int nthreads = cv::getNumThreads();
+    int types[] = { CV_8U, CV_16S, CV_32S, CV_32F, CV_64F };
+
+    for (int t = 0; t < 5; t++)
+    {
+        Mat src(400, 300, types[t]);
+        rng.fill(src, RNG::UNIFORM, 0, 100);
+        for (int flags = 0; flags < 4; flags++)
+        {
+            int sflags = (flags & 1 ? SORT_EVERY_COLUMN : SORT_EVERY_ROW) + (flags & 2 ? SORT_DESCENDING : SORT_ASCENDING);
+            Mat dst[2], idx[2];
+            for (int i = 0; i < 2; i++)
+            {
+                cv::setNumThreads(i == 0 ? 1 : 4);
+                cv::sort(src, dst[i], sflags);
+                cv::sortIdx(src, idx[i], sflags);
+            }
+            cv::setNumThreads(nthreads);
+
+            ASSERT_EQ(0, cvtest::norm(dst[0], dst[1], NORM_INF)) << "type=" << types[t] << " flags=" << sflags;
+            ASSERT_EQ(0, cvtest::norm(idx[0], idx[1], NORM_INF)) << "type=" << types[t] << " flags=" << sflags;
+        }
+    }
+}
+
+TEST(Core_Sort, partialSort)
+{
+    RNG& rng = theRNG();
+    int types[] = { CV_8U, CV_16U, CV_32S, CV_32F, CV_64F };
+
+    for (int t = 0; t < 5; t++)
+    {
+        // few distinct values for CV_8U to check the order of the equal elements
+        Mat src(37, 1003, types[t]);
+        rng.fill(src, RNG::UNIFORM, 0, types[t] == CV_8U ? 20 : 10000);
+        for (int flags = 0; flags < 4; flags++)
+        {
+            bool byCols = (flags & 1) != 0, descending = (flags & 2) != 0;
+            Mat m = byCols ? Mat(src.t()) : src;
+            int sflags = (byCols ? SORT_EVERY_COLUMN : SORT_EVERY_ROW) + (descending ? SORT_DESCENDING : SORT_ASCENDING);
+            int ks[] = { 1, 7, 100, 1003 };
+
+            for (int j = 0; j < 4; j++)
+            {
+                int k = ks[j];
+                Mat dst, idx, idxOnly, ref, srcd, dstd;
+                cv::partialSort(m, dst, idx, k, sflags);
+                cv::partialSort(m, noArray(), idxOnly, k, sflags);
+                ASSERT_EQ(0, cvtest::norm(idx, idxOnly, NORM_INF));
+
+                if (byCols)
+                    dst = dst.t(), idx = idx.t();
+                ASSERT_EQ(Size(k, src.rows), dst.size());
+                ASSERT_EQ(Size(k, src.rows), idx.size());
+                src.convertTo(srcd, CV_64F);
+                dst.convertTo(dstd, CV_64F);
+                cv::sort(srcd, ref, SORT_EVERY_ROW + (descending ? SORT_DESCENDING : SORT_ASCENDING));
+
+                for (int y = 0; y < src.rows; y++)
+                {
+                    const double* s = srcd.ptr<double>(y);
+                    for (int x = 0; x < k; x++)
+                    {
+                        int i = idx.at<int>(y, x);
+                        ASSERT_EQ(ref.at<double>(y, x), s[i]) << "type=" << types[t] << " flags=" << sflags << " k=" << k;
+                        ASSERT_EQ(ref.at<double>(y, x), dstd.at<double>(y, x));
+                        if (x > 0 && s[idx.at<int>(y, x - 1)] == s[i])
+                        {
+                            ASSERT_LT(idx.at<int>(y, x - 1), i);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+static Mat extractChannelRef(const Mat& src, int k)
+{
+    Mat dst(src.size(), src.depth());
+    size_t esz1 = src.elemSize1();
+    int cn = src.channels();
+    for (int y = 0; y < src.rows; y++)
+        for (int x = 0; x < src.cols; x++)
+            memcpy(dst.ptr(y) + x*esz1, src.ptr(y) + (x*cn + k)*esz1, esz1);
+    return dst;
+}
+
+TEST(Core_MixChannels, vectorized_and_parallel)
+{
+    RNG& rng = theRNG();
+    int depths[] = { CV_8U, CV_16U, CV_32F, CV_64F };
+    Size sizes[] = { Size(37, 5), Size(1027, 513), Size(200001, 1) };
+
+    for (int d = 0; d < 4; d++)
+        for (int s = 0; s < 3; s++)
+            for (int cn = 2; cn <= 4; cn++)
+            {
+                Size sz = sizes[s];
+                Mat src(sz, CV_MAKETYPE(depths[d], cn));
+                rng.fill(src, RNG::UNIFORM, 1, 200);
+
+                std::vector<Mat> planes;
+                cv::split(src, planes);
+                ASSERT_EQ(cn, (int)planes.size());
+                for (int k = 0; k < cn; k++)
+                    ASSERT_EQ(0, cvtest::norm(planes[k], extractChannelRef(src, k), NORM_INF))
+                        << "depth=" << depths[d] << " cn=" << cn << " size=" << sz;
+
+                Mat merged;
+                cv::merge(planes, merged);
+                ASSERT_EQ(0, cvtest::norm(src, merged, NORM_INF)) << "depth=" << depths[d] << " cn=" << cn << " size=" << sz;
+
+                // reversed channels
+                std::vector<int> fromTo;
+                for (int k = 0; k < cn; k++)
+                {
+                    fromTo.push_back(k);
+                    fromTo.push_back(cn - 1 - k);
+                }
+                Mat dst(sz, src.type());
+                cv::mixChannels(&src, 1, &dst, 1, &fromTo[0], cn);
+                for (int k = 0; k < cn; k++)
+                    ASSERT_EQ(0, cvtest::norm(extractChannelRef(dst, k), planes[cn - 1 - k], NORM_INF))
+                        << "depth=" << depths[d] << " cn=" << cn << " size=" << sz;
+
+                // one channel
+                Mat ch(sz, depths[d]);
+                int fromTo1[] = { cn - 1, 0 };
+                cv::mixChannels(&src, 1, &ch, 1, fromTo1, 1);
+                ASSERT_EQ(0, cvtest::norm(ch, planes[cn - 1], NORM_INF)) << "depth=" << depths[d] << " cn=" << cn;
+
+                // dropping the last channel (4 -> 3) or adding the zero one (2 -> 3, 3 -> 4)
+                int dcn = cn == 4 ? 3 : cn + 1;
+                Mat dst2(sz, CV_MAKETYPE(depths[d], dcn));
+                fromTo.clear();
+                for (int k = 0; k < dcn; k++)
+                {
+                    fromTo.push_back(k < cn ? k : -1);
+                    fromTo.push_back(k);
+                }
+                cv::mixChannels(&src, 1, &dst2, 1, &fromTo[0], dcn);
+                for (int k = 0; k < dcn; k++)
+                {
+                    Mat ref = k < cn ? planes[k] : Mat::zeros(sz, depths[d]);
+                    ASSERT_EQ(0, cvtest::norm(extractChannelRef(dst2, k), ref, NORM_INF))
+                        << "depth=" << depths[d] << " cn=" << cn << " size=" << sz;
+                }
+            }
+}
+
+TEST(Core_ConvertScaleLUT, accuracy)
+{
+    RNG& rng = theRNG();
+    int sdepths[] = { CV_8U, CV_8S, CV_16U, CV_16S, CV_32S, CV_32F, CV_64F };
+    int ddepths[] = { CV_8U, CV_16S, CV_32F, CV_64F };
+    Size sizes[] = { Size(37, 5), Size(1027, 513) };
+
+    for (int sd = 0; sd < 7; sd++)
+        for (int dd = 0; dd < 4; dd++)
+            for (int useLUT = 0; useLUT < 2; useLUT++)
+            {
+                int sdepth = sdepths[sd], ddepth = ddepths[dd];
+                int cn = rng.uniform(1, 5), dcn = rng.uniform(1, 5);
+                Size sz = sizes[rng.uniform(0, 2)];
+                Mat src(sz, CV_MAKETYPE(sdepth, cn));
+                rng.fill(src, RNG::UNIFORM, -300, 300);
+
+                Scalar alpha, beta;
+                for (int c = 0; c < 4; c++)
+                {
+                    alpha[c] = rng.uniform(-2., 2.);
+                    beta[c] = rng.uniform(-50., 50.);
+                }
+
+                // a monotonic table, so that rounding of the index changes the result by at most 1
+                Mat lut;
+                if (useLUT)
+                {
+                    int lutcn = rng.uniform(0, 2) ? cn : 1;
+                    lut.create(1, 256, CV_MAKETYPE(CV_8U, lutcn));
+                    for (int i = 0; i < 256; i++)
+                        for (int c = 0; c < lutcn; c++)
+                            lut.ptr(0, i)[c] = saturate_cast<uchar>(255 - i + c*10);
+                }
+
+                std::vector<int> order(dcn);
+                for (int k = 0; k < dcn; k++)
+                    order[k] = rng.uniform(-1, cn);
+
+                Mat dst;
+                cv::convertScaleLUT(src, dst, ddepth, alpha, beta, lut, order);
+                ASSERT_EQ(CV_MAKETYPE(ddepth, dcn), dst.type());
+                ASSERT_EQ(sz, dst.size());
+
+                // the sequence of convertTo, LUT and mixChannels
+                std::vector<Mat> planes, dplanes(dcn);
+                cv::split(src, planes);
+                for (int c = 0; c < cn; c++)
+                {
+                    if (lut.empty())
+                        planes[c].convertTo(planes[c], ddepth, alpha[c], beta[c]);
+                    else
+                    {
+                        Mat idx, lutc = lut.channels() == 1 ? lut : Mat();
+                        if (lutc.empty())
+                            cv::extractChannel(lut, lutc, c);
+                        planes[c].convertTo(idx, CV_8U, alpha[c], beta[c]);
+                        cv::LUT(idx, lutc, planes[c]);
+                        planes[c].convertTo(planes[c], ddepth);
+                    }
+                }
+                for (int k = 0; k < dcn; k++)
+                    dplanes[k] = order[k] >= 0 ? planes[order[k]] : Mat::zeros(sz, ddepth);
+                Mat ref;
+                cv::merge(dplanes, ref);
+
+                double maxdiff = ddepth <= CV_32S ? 1 : std::max(cvtest::norm(ref, NORM_INF), 1.)*1e-5;
+                if (!lut.empty())
+                    maxdiff = 1;
+                ASSERT_LE(cvtest::norm(ref, dst, NORM_INF), maxdiff)
+                    << "sdepth=" << sdepth << " ddepth=" << ddepth << " cn=" << cn << " dcn=" << dcn
+                    << " lut=" << useLUT << " size=" << sz;
+            }
+
+    // in-place BGR -> RGB with scaling of 8-bit image
+    Mat img(513, 1027, CV_8UC3), ref;
+    rng.fill(img, RNG::UNIFORM, 0, 256);
+    std::vector<int> order(3);
+    order[0] = 2; order[1] = 1; order[2] = 0;
+    int fromTo[] = { 0, 2, 1, 1, 2, 0 };
+    Mat tmp;
+    img.convertTo(tmp, CV_8U, 0.5, 10);
+    ref.create(img.size(), img.type());
+    cv::mixChannels(&tmp, 1, &ref, 1, fromTo, 3);
+    cv::convertScaleLUT(img, img, -1, Scalar::all(0.5), Scalar::all(10), noArray(), order);
+    ASSERT_EQ(0, cvtest::norm(ref, img, NORM_INF));
+
+    Mat dst;
+    EXPECT_THROW(cv::convertScaleLUT(img, dst, CV_USRTYPE1, Scalar::all(1), Scalar::all(0), noArray()), cv::Exception);
+}
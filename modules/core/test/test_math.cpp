@@ -2858,6 +2858,72 @@ TEST_P(Core_KMeans_InputVariants, singular)
 
 INSTANTIATE_TEST_CASE_P(AllVariants, Core_KMeans_InputVariants, KMeansInputVariant::all());
 
+static Mat kmeansBlobs(int N, int dims, int K, Mat& trueCenters)
+{
+    RNG& rng = theRNG();
+    trueCenters.create(K, dims, CV_32F);
+    rng.fill(trueCenters, RNG::UNIFORM, -100, 100);
+    Mat data(N, dims, CV_32F), noise(1, dims, CV_32F);
+    for (int i = 0; i < N; i++)
+    {
+        rng.fill(noise, RNG::NORMAL, 0, 1);
+        data.row(i) = trueCenters.row(rng.uniform(0, K)) + noise;
+    }
+    return data;
+}
+
+TEST(Core_KMeans, pp_centers_do_not_depend_on_threads)
+{
+    Mat trueCenters, data = kmeansBlobs(30000, 16, 20, trueCenters);
+    TermCriteria crit(TermCriteria::MAX_ITER + TermCriteria::EPS, 10, 0);
+    int nthreads = getNumThreads();
+
+    Mat labels1, centers1, labels2, centers2;
+    theRNG().state = 12345;
+    double c1 = kmeans(data, 20, labels1, crit, 1, KMEANS_PP_CENTERS, centers1);
+
+    setNumThreads(1);
+    theRNG().state = 12345;
+    double c2 = kmeans(data, 20, labels2, crit, 1, KMEANS_PP_CENTERS, centers2);
+    setNumThreads(nthreads);
+
+    EXPECT_EQ(c1, c2);
+    EXPECT_EQ(0, cvtest::norm(labels1, labels2, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(centers1, centers2, NORM_INF));
+}
+
+TEST(Core_KMeans, mini_batch)
+{
+    const int N = 50000, dims = 8, K = 10;
+    Mat trueCenters, data = kmeansBlobs(N, dims, K, trueCenters);
+    TermCriteria crit(TermCriteria::MAX_ITER + TermCriteria::EPS, 200, 0);
+
+    Mat labels, centers;
+    double compactness = kmeans(data, K, labels, crit, 3, KMEANS_PP_CENTERS, centers);
+
+    Mat mbLabels, mbCenters;
+    double mbCompactness = kmeansMiniBatch(data, K, mbLabels, crit, 500, 3, KMEANS_PP_CENTERS, mbCenters);
+    ASSERT_EQ(N, (int)mbLabels.total());
+    ASSERT_EQ(K, mbCenters.rows);
+    EXPECT_LE(mbCompactness, compactness*1.05);
+
+    // the labels are consistent with the centers
+    double sum = 0;
+    for (int i = 0; i < N; i++)
+    {
+        int l = mbLabels.at<int>(i);
+        ASSERT_TRUE(0 <= l && l < K);
+        sum += cvtest::norm(data.row(i), mbCenters.row(l), NORM_L2SQR);
+    }
+    EXPECT_NEAR(mbCompactness, sum, sum*1e-5);
+
+    // the same through the flag of kmeans, starting from the found labels
+    Mat flagLabels = mbLabels.clone(), flagCenters;
+    double flagCompactness = kmeans(data, K, flagLabels, crit, 1,
+                                    KMEANS_USE_INITIAL_LABELS + KMEANS_MINI_BATCH, flagCenters);
+    EXPECT_LE(flagCompactness, mbCompactness*1.05);
+}
+
 TEST(CovariationMatrixVectorOfMat, accuracy)
 {
     unsigned int col_problem_size = 8, row_problem_size = 8, vector_size = 16;
@@ -2976,4 +3042,143 @@ TEST(Core_Pow, special)
     }
 }
 
+TEST(Core_GEMM, large_packed)
+{
+    RNG& rng = theRNG();
+    bool useOptimized = cv::useOptimized();
+
+    for( int iter = 0; iter < 32; iter++ )
+    {
+        int type = iter % 2 == 0 ? CV_32F : CV_64F, flags = (iter / 2) % 8;
+        int m = rng.uniform(9, 150), n = rng.uniform(9, 300), len = iter % 4 == 1 ? n : rng.uniform(9, 600);
+        Size asz = flags & GEMM_1_T ? Size(m, len) : Size(len, m);
+        Size bsz = flags & GEMM_2_T ? Size(len, n) : Size(n, len);
+        Size csz = flags & GEMM_3_T ? Size(m, n) : Size(n, m);
+        Mat abuf(asz.height + 2, asz.width + 3, type), b(bsz, type), c(csz, type);
+        Mat a = abuf(Rect(Point(1, 2), asz));
+        rng.fill(abuf, RNG::UNIFORM, -1, 1);
+        rng.fill(b, RNG::UNIFORM, -1, 1);
+        rng.fill(c, RNG::UNIFORM, -1, 1);
+        double alpha = rng.uniform(-2., 2.), beta = iter % 3 == 0 ? 0. : rng.uniform(-2., 2.);
+
+        Mat dst, dst_ref, dst_base;
+        cvtest::gemm(a, b, alpha, c, beta, dst_ref, flags);
+        cv::gemm(a, b, alpha, c, beta, dst, flags);
+        double eps = type == CV_32F ? 1e-5 : 1e-12;
+        ASSERT_LE(cvtest::norm(dst, dst_ref, NORM_INF), eps*cvtest::norm(dst_ref, NORM_INF))
+            << "m=" << m << ", n=" << n << ", len=" << len << ", flags=" << flags;
+
+        // the dispatched kernels give the same results as the baseline one
+        cv::setUseOptimized(false);
+        cv::gemm(a, b, alpha, c, beta, dst_base, flags);
+        cv::setUseOptimized(useOptimized);
+        ASSERT_EQ(0, cvtest::norm(dst, dst_base, NORM_INF));
+
+        // the destination is one of the operands
+        if( !(flags & GEMM_1_T) && len == n )
+        {
+            Mat a1 = a.clone();
+            cv::gemm(a1, b, alpha, c, beta, a1, flags);
+            ASSERT_EQ(0, cvtest::norm(a1, dst, NORM_INF));
+        }
+    }
+}
+
+static void checkSVD( const Mat& a, const Mat& w, const Mat& u, const Mat& vt, double eps )
+{
+    int mn = std::min(a.rows, a.cols);
+    ASSERT_EQ(Size(1, mn), w.size());
+    ASSERT_EQ(Size(mn, a.rows), u.size());
+    ASSERT_EQ(Size(a.cols, mn), vt.size());
+
+    Mat wd, ud, vtd, ad;
+    w.convertTo(wd, CV_64F);
+    u.convertTo(ud, CV_64F);
+    vt.convertTo(vtd, CV_64F);
+    a.convertTo(ad, CV_64F);
+    for( int i = 0; i < mn; i++ )
+        ASSERT_GE(wd.at<double>(i), 0.);
+    for( int i = 1; i < mn; i++ )
+        ASSERT_LE(wd.at<double>(i), wd.at<double>(i-1));
+
+    Mat I = Mat::eye(mn, mn, CV_64F), a1 = ud*Mat::diag(wd)*vtd;
+    EXPECT_LE(cvtest::norm(ud.t()*ud, I, NORM_INF), eps);
+    EXPECT_LE(cvtest::norm(vtd*vtd.t(), I, NORM_INF), eps);
+    EXPECT_LE(cvtest::norm(a1, ad, NORM_INF), eps*std::max(cvtest::norm(ad, NORM_INF), 1.));
+}
+
+TEST(Core_SVD, large)
+{
+    RNG& rng = theRNG();
+    Size sizes[] = { Size(200, 300), Size(300, 200), Size(150, 150), Size(40, 1000) };
+
+    for( int iter = 0; iter < 10; iter++ )
+    {
+        int type = iter % 2 == 0 ? CV_64F : CV_32F;
+        Size sz = sizes[(iter/2) % 4];
+        Mat a(sz, type), w, u, vt;
+        rng.fill(a, RNG::UNIFORM, -1, 1);
+        if( iter >= 8 )
+        {
+            // rank-deficient matrix: the last rows repeat the first ones
+            a.rowRange(0, sz.height/2).copyTo(a.rowRange(sz.height - sz.height/2, sz.height));
+        }
+
+        double eps = type == CV_32F ? 1e-4 : 1e-10;
+        SVD::compute(a, w, u, vt);
+        checkSVD(a, w, u, vt, eps);
+
+        Mat w1;
+        SVD::compute(a, w1, SVD::NO_UV);
+        EXPECT_LE(cvtest::norm(w, w1, NORM_INF), eps*cvtest::norm(w, NORM_INF));
+    }
+}
+
+TEST(Core_SVD, truncated)
+{
+    RNG& rng = theRNG();
+    const int m = 400, n = 300, k = 10;
+
+    for( int type = CV_32F; type <= CV_64F; type++ )
+    {
+        // a matrix with the known, quickly decaying spectrum
+        Mat q1(m, n, CV_64F), q2(n, n, CV_64F), w0(n, 1, CV_64F), qu, qvt, tmp;
+        rng.fill(q1, RNG::NORMAL, 0, 1);
+        rng.fill(q2, RNG::NORMAL, 0, 1);
+        SVD::compute(q1, tmp, qu, tmp);
+        SVD::compute(q2, tmp, tmp, qvt);
+        for( int i = 0; i < n; i++ )
+            w0.at<double>(i) = 100*std::pow(0.7, i);
+        Mat a0 = qu*Mat::diag(w0)*qvt, a;
+        a0.convertTo(a, type);
+
+        Mat w, u, vt;
+        SVDecompTruncated(a, k, w, u, vt);
+        ASSERT_EQ(type, w.type());
+        ASSERT_EQ(Size(1, k), w.size());
+        ASSERT_EQ(Size(k, m), u.size());
+        ASSERT_EQ(Size(n, k), vt.size());
+
+        Mat wd, ud, vtd;
+        w.convertTo(wd, CV_64F);
+        u.convertTo(ud, CV_64F);
+        vt.convertTo(vtd, CV_64F);
+        double eps = type == CV_32F ? 1e-3 : 1e-6;
+        EXPECT_LE(cvtest::norm(wd, w0.rowRange(0, k), NORM_INF), eps*w0.at<double>(0));
+        Mat I = Mat::eye(k, k, CV_64F);
+        EXPECT_LE(cvtest::norm(ud.t()*ud, I, NORM_INF), eps);
+        EXPECT_LE(cvtest::norm(vtd*vtd.t(), I, NORM_INF), eps);
+
+        // the rank-k approximation is as good as the optimal one
+        double err = cvtest::norm(ud*Mat::diag(wd)*vtd, a0, NORM_L2);
+        double err0 = cvtest::norm(w0.rowRange(k, n), NORM_L2);
+        EXPECT_LE(err, err0*1.01 + eps*w0.at<double>(0));
+
+        // the result is reproducible
+        Mat w2;
+        SVDecompTruncated(a, k, w2, noArray(), noArray());
+        EXPECT_EQ(0, cvtest::norm(w, w2, NORM_INF));
+    }
+}
+
 /* End of file. */
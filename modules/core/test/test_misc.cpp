@@ -138,3 +138,61 @@ TEST(Core_String, find_last_of__with__empty_string)
     // npos is not exported: EXPECT_EQ(cv::String::npos, p);
     EXPECT_EQ(std::string::npos, p);
 }
+
+namespace {
+
+class CountVisitsBody : public cv::ParallelLoopBody
+{
+public:
+    CountVisitsBody(cv::Mat& _counter, int _row) : counter(_counter), row(_row) {}
+
+    void operator()(const cv::Range& range) const
+    {
+        for (int x = range.start; x < range.end; x++)
+            counter.at<int>(row, x)++;
+    }
+
+private:
+    cv::Mat& counter;
+    int row;
+};
+
+class NestedVisitsBody : public cv::ParallelLoopBody
+{
+public:
+    NestedVisitsBody(cv::Mat& _counter) : counter(_counter) {}
+
+    void operator()(const cv::Range& range) const
+    {
+        for (int y = range.start; y < range.end; y++)
+            cv::parallel_for_(cv::Range(0, counter.cols), CountVisitsBody(counter, y));
+    }
+
+private:
+    cv::Mat& counter;
+};
+
+}
+
+TEST(Core_Parallel, nested_parallel_for_visits_every_element_once)
+{
+    cv::Mat counter(37, 1013, CV_32S, cv::Scalar::all(0));
+
+    cv::parallel_for_(cv::Range(0, counter.rows), NestedVisitsBody(counter));
+
+    EXPECT_EQ(0, cvtest::norm(counter, cv::Mat(counter.size(), CV_32S, cv::Scalar::all(1)), cv::NORM_INF));
+}
+
+TEST(Core_Parallel, numa_aware_mode_visits_every_element_once)
+{
+    cv::Mat counter(37, 1013, CV_32S, cv::Scalar::all(0));
+
+    EXPECT_GE(cv::getNumberOfNumaNodes(), 1);
+
+    cv::setNumaAware(true);
+    EXPECT_TRUE(cv::isNumaAware());
+    cv::parallel_for_(cv::Range(0, counter.rows), NestedVisitsBody(counter));
+    cv::setNumaAware(false);
+
+    EXPECT_EQ(0, cvtest::norm(counter, cv::Mat(counter.size(), CV_32S, cv::Scalar::all(1)), cv::NORM_INF));
+}
@@ -1152,6 +1152,105 @@ void CV_OperationsTest::run( int /* start_from */)
 
 TEST(Core_Array, expressions) { CV_OperationsTest test; test.safe_run(); }
 
+TEST(Core_MatExpr, fused_evaluation)
+{
+    // the fused expressions give the same results bit for bit, the integer ones are evaluated by the separate passes
+    const int depths[] = { CV_8U, CV_16S, CV_32S, CV_32F, CV_64F };
+    RNG& rng = theRNG();
+
+    for( int k = 0; k < 10; k++ )
+    {
+        int depth = depths[k/2], cn = k % 2 == 0 ? 1 : 3, type = CV_MAKETYPE(depth, cn);
+        double lo = depth == CV_8U ? 0 : depth >= CV_32F ? -100 : -1000, hi = depth == CV_8U ? 256 : -lo;
+        SCOPED_TRACE(cv::format("type = %d", type));
+
+        // the operands are the submatrices of one buffer to cover the non-continuous and aliased cases
+        Mat buf(110, 180, type);
+        rng.fill(buf, RNG::UNIFORM, lo, hi);
+        Mat a = buf(Rect(0, 0, 97, 51)), b = buf(Rect(80, 0, 97, 51)), c = buf(Rect(3, 55, 97, 51));
+        Mat r, ref, t, t2;
+
+        r = a*0.5 + b*2 - c;
+        addWeighted(a, 0.5, b, 2, 0, t);
+        subtract(t, c, ref);
+        EXPECT_EQ(0, cvtest::norm(r, ref, NORM_INF));
+
+        Mat roi = (a*0.5 + b*2 - c)(Rect(5, 7, 40, 30));
+        EXPECT_EQ(0, cvtest::norm(roi, ref(Rect(5, 7, 40, 30)), NORM_INF));
+
+        r = (a + b).mul(c, 0.25) + 3;
+        add(a, b, t);
+        multiply(t, c, t, 0.25);
+        add(t, Scalar(3), ref);
+        EXPECT_EQ(0, cvtest::norm(r, ref, NORM_INF));
+
+        r = abs(a + b - c);
+        add(a, b, t);
+        absdiff(t, c, ref);
+        EXPECT_EQ(0, cvtest::norm(r, ref, NORM_INF));
+
+        r = (a + c)/(b*2);
+        add(a, c, t);
+        divide(t, b, ref, 0.5);
+        EXPECT_EQ(0, cvtest::norm(r, ref, NORM_INF));
+
+        r = 10/(a - c)*3;
+        subtract(a, c, t);
+        divide(30, t, ref);
+        EXPECT_EQ(0, cvtest::norm(r, ref, NORM_INF));
+
+        r = max(a, b).mul(c) - Scalar(1, 2, 3);
+        cv::max(a, b, t);
+        multiply(t, c, t);
+        subtract(t, Scalar(1, 2, 3), ref);
+        EXPECT_EQ(0, cvtest::norm(r, ref, NORM_INF));
+
+        r = (a > b) - (c < 5.5);
+        compare(a, b, t, CMP_GT);
+        compare(c, 5.5, t2, CMP_LT);
+        subtract(t, t2, ref);
+        EXPECT_EQ(0, cvtest::norm(r, ref, NORM_INF));
+
+        r = ((a > b) - (c < 5.5))*0.3 + (a <= 0);
+        compare(a, b, t, CMP_GT);
+        compare(c, 5.5, t2, CMP_LT);
+        subtract(t, t2, t);
+        compare(a, 0, t2, CMP_LE);
+        addWeighted(t, 0.3, t2, 1, 0, ref);
+        EXPECT_EQ(0, cvtest::norm(r, ref, NORM_INF));
+
+        // the result is converted to the destination type
+        if( cn == 1 )
+        {
+            Mat_<double> r64 = (a + b).mul(c);
+            add(a, b, t);
+            multiply(t, c, t);
+            t.convertTo(ref, CV_64F);
+            EXPECT_EQ(0, cvtest::norm(r64, ref, NORM_INF));
+
+            r64 = max(a, b)*0.3 + 1;
+            cv::max(a, b, t);
+            t.convertTo(ref, CV_64F, 0.3, 1);
+            EXPECT_EQ(0, cvtest::norm(r64, ref, NORM_INF));
+        }
+
+        // the destination is one of the operands or overlaps them
+        add(a, b, t);
+        multiply(t, c, t);
+        add(b, t, ref);
+        Mat b0 = b.clone();
+        b += (a + b).mul(c);
+        EXPECT_EQ(0, cvtest::norm(b, ref, NORM_INF));
+        b0.copyTo(b);
+
+        addWeighted(a, 0.5, b, 2, 0, t);
+        subtract(t, c, ref);
+        Mat d = buf(Rect(40, 20, 97, 51));
+        d = a*0.5 + b*2 - c;
+        EXPECT_EQ(0, cvtest::norm(d, ref, NORM_INF));
+    }
+}
+
 class CV_SparseMatTest : public cvtest::BaseTest
 {
 public:
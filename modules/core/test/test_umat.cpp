@@ -1308,7 +1308,7 @@ TEST(UMat, testTempObjects_UMat)
 //  C++11 is enabled by default ==>
 //  destructors have implicit 'noexcept(true)' specifier ==>
 //  throwing exception from destructor is not handled correctly
-#if defined(_MSC_VER) && _MSC_VER >= 1900 /* MSVC 14 */
+#if (defined(_MSC_VER) && _MSC_VER >= 1900) /* MSVC 14 */ || __cplusplus >= 201103L
 TEST(UMat, DISABLED_testTempObjects_Mat)
 #else
 TEST(UMat, testTempObjects_Mat)
@@ -1354,4 +1354,81 @@ TEST(UMat, DISABLED_regression_5991)
     EXPECT_EQ(0, cvtest::norm(mat.getMat(ACCESS_READ), Mat(3, sz, CV_8U, Scalar(1)), NORM_INF));
 }
 
+// without OpenCL UMat wraps the host memory, both ways
+TEST(UMat, host_memory_is_shared)
+{
+    if (cv::ocl::useOpenCL())
+        return; // test skipped, UMat is in the device memory
+
+    Mat m(10, 10, CV_8UC1, Scalar(1));
+    {
+        UMat u = m.getUMat(ACCESS_RW);
+        Mat m2 = u.getMat(ACCESS_RW);
+        EXPECT_EQ(m.data, m2.data);
+        m2.setTo(Scalar(2));
+    }
+    EXPECT_EQ(0, cvtest::norm(m, Mat(10, 10, CV_8UC1, Scalar(2)), NORM_INF));
+
+    UMat u(100, 100, CV_32FC1, Scalar(3)), uroi = u(Rect(10, 20, 30, 40));
+    {
+        Mat m1 = u.getMat(ACCESS_READ), m2 = uroi.getMat(ACCESS_RW);
+        EXPECT_EQ(m1.ptr<float>(20) + 10, m2.ptr<float>());
+        m2.setTo(Scalar(4));
+        EXPECT_NEAR(3 + 30*40/(100*100.), cv::mean(m1)[0], 1e-6);
+    }
+    EXPECT_EQ(0, u.u->refcount);
+}
+
+class UMatGetMatInvoker : public ParallelLoopBody
+{
+public:
+    UMatGetMatInvoker(const UMat& _u) : u(_u) {}
+
+    void operator()(const cv::Range& range) const
+    {
+        for (int i = range.start; i < range.end; i++)
+        {
+            Mat m = u.getMat(ACCESS_RW);
+            CV_XADD(m.ptr<int>(i % m.rows), 1);
+        }
+    }
+
+private:
+    UMatGetMatInvoker& operator=(const UMatGetMatInvoker&);
+
+    const UMat& u;
+};
+
+TEST(UMat, host_memory_getMat_parallel)
+{
+    UMat u(16, 1, CV_32SC1, Scalar(0));
+    parallel_for_(cv::Range(0, 16*1000), UMatGetMatInvoker(u));
+    EXPECT_EQ(0, u.u->refcount);
+    EXPECT_EQ(0, cvtest::norm(u.getMat(ACCESS_READ), Mat(16, 1, CV_32SC1, Scalar(1000)), NORM_INF));
+}
+
+TEST(UMat, host_memory_is_pooled)
+{
+    if (cv::ocl::useOpenCL() || Mat::getDefaultAllocator() != Mat::getStdAllocator())
+        return; // test skipped, UMat does not use the buffer pool
+
+    ASSERT_EQ(getPoolMatAllocator(), UMat::getStdAllocator());
+
+    const uchar* ptr = 0;
+    {
+        UMat u(480, 640, CV_8UC3);
+        ptr = u.getMat(ACCESS_READ).ptr();
+    }
+    resetPoolMatAllocatorStats();
+    for (int i = 0; i < 10; i++)
+    {
+        UMat u(480, 640, CV_8UC3), u1;
+        EXPECT_EQ(ptr, u.getMat(ACCESS_READ).ptr());
+        cv::add(u, Scalar::all(1), u1);
+    }
+    // only the first destination array is a new one
+    BufferPoolStats stats = getPoolMatAllocatorStats();
+    EXPECT_LE(stats.allocations - stats.hits, 1u);
+}
+
 } } // namespace cvtest::ocl
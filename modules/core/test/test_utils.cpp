@@ -3,6 +3,7 @@
 // of this distribution and at http://opencv.org/license.html.
 
 #include "test_precomp.hpp"
+#include <fstream>
 
 using namespace cv;
 
@@ -218,4 +219,66 @@ TEST(CommandLineParser, positional_regression_5074_equal_sign)
     EXPECT_TRUE(parser.check());
 }
 
+#if CV_TRACE
+
+class TraceTestBody : public ParallelLoopBody
+{
+public:
+    void operator()(const Range& r) const
+    {
+        CV_TRACE_REGION("trace_test_stripe");
+        volatile double s = 0;
+        for (int i = r.start; i < r.end; i++)
+            s += std::sqrt((double)i);
+    }
+};
+
+static void traceTestFunction()
+{
+    CV_TRACE_REGION("trace_test_outer");
+    {
+        CV_TRACE_REGION("trace_test_inner");
+        parallel_for_(Range(0, 1000), TraceTestBody());
+    }
+}
+
+static std::string traceTestRun(int level)
+{
+    std::string filename = cv::tempfile(".json");
+    cv::tracing::setOutputFile(filename);
+    cv::tracing::setLevel(level);
+    traceTestFunction();
+    cv::tracing::setLevel(cv::tracing::LEVEL_DISABLED);
+
+    std::ifstream f(filename.c_str());
+    std::string content((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    f.close();
+    remove(filename.c_str());
+    return content;
+}
+
+TEST(Core_Trace, fine)
+{
+    std::string content = traceTestRun(cv::tracing::LEVEL_FINE);
+    ASSERT_FALSE(content.empty());
+    EXPECT_EQ('[', content[0]);
+    EXPECT_EQ(']', content[content.find_last_not_of(" \n")]);
+    EXPECT_NE(std::string::npos, content.find("\"trace_test_outer\""));
+    EXPECT_NE(std::string::npos, content.find("\"trace_test_inner\""));
+    EXPECT_NE(std::string::npos, content.find("\"trace_test_stripe\""));
+    EXPECT_NE(std::string::npos, content.find("\"parallel_for_\""));
+}
+
+TEST(Core_Trace, coarse)
+{
+    std::string content = traceTestRun(cv::tracing::LEVEL_COARSE);
+    ASSERT_FALSE(content.empty());
+    EXPECT_NE(std::string::npos, content.find("\"trace_test_outer\""));
+    EXPECT_EQ(std::string::npos, content.find("\"trace_test_inner\""));
+    EXPECT_EQ(std::string::npos, content.find("\"trace_test_stripe\""));
+    EXPECT_NE(std::string::npos, content.find("\"parallel_for_\""));
+}
+
+#endif // CV_TRACE
+
 } // namespace
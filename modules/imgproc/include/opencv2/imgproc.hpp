@@ -253,6 +253,13 @@ enum MorphShapes {
                       //!< into the rectangle Rect(0, 0, esize.width, 0.esize.height)
 };
 
+//! type of the bilateral filter, see cv::bilateralFilter
+enum BilateralFilterTypes {
+    BILATERAL_EXACT  = 0, //!< direct filtering within the circular neighborhood of diameter d
+    BILATERAL_APPROX = 1  //!< approximation on the permutohedral lattice, the cost does not grow
+                          //!< with sigmaSpace and sigmaColor
+};
+
 //! @} imgproc_filter
 
 //! @addtogroup imgproc_transform
@@ -1309,8 +1316,9 @@ The function smoothes an image using the median filter with the \f$\texttt{ksize
 \texttt{ksize}\f$ aperture. Each channel of a multi-channel image is processed independently.
 In-place operation is supported.
 
-@param src input 1-, 3-, or 4-channel image; when ksize is 3 or 5, the image depth should be
-CV_8U, CV_16U, or CV_32F, for larger aperture sizes, it can only be CV_8U.
+@param src input 1-, 3-, or 4-channel image; the image depth should be CV_8U, CV_16U, CV_16S or
+CV_32F. For larger aperture sizes the CV_8U images are processed in constant time per pixel, and the
+other depths take O(ksize) time per pixel.
 @param dst destination array of the same size and type as src.
 @param ksize aperture linear size; it must be odd and greater than 1, for example: 3, 5, 7 ...
 @sa  bilateralFilter, blur, boxFilter, GaussianBlur
@@ -1355,6 +1363,9 @@ strong effect, making the image look "cartoonish".
 _Filter size_: Large filters (d \> 5) are very slow, so it is recommended to use d=5 for real-time
 applications, and perhaps d=9 for offline applications that need heavy noise filtering.
 
+The overload with the mode parameter can also compute an approximation of the filter, see
+cv::BilateralFilterTypes.
+
 This filter does not work inplace.
 @param src Source 8-bit or floating-point, 1-channel or 3-channel image.
 @param dst Destination image of the same size and type as src .
@@ -1373,6 +1384,27 @@ CV_EXPORTS_W void bilateralFilter( InputArray src, OutputArray dst, int d,
                                    double sigmaColor, double sigmaSpace,
                                    int borderType = BORDER_DEFAULT );
 
+/** @overload
+
+With mode=BILATERAL_APPROX the filter is computed on the sparse permutohedral lattice, see
+@cite ABD10 . The cost of this mode does not grow with the filter size, so it is faster than the
+exact filter when sigmaSpace is larger than 8 or so (and the more, the larger sigmaSpace is),
+while the result differs from the exact filter by about 1% of the intensity range. In this mode
+the neighborhood is not truncated (d is ignored), the colors are compared by the Euclidean
+distance, and the pixels outside of the image are not used (borderType is ignored).
+
+@param src Source 8-bit or floating-point, 1-channel or 3-channel image.
+@param dst Destination image of the same size and type as src .
+@param d Diameter of each pixel neighborhood, see above.
+@param sigmaColor Filter sigma in the color space.
+@param sigmaSpace Filter sigma in the coordinate space.
+@param borderType border mode used to extrapolate pixels outside of the image, see cv::BorderTypes
+@param mode the filter type, see cv::BilateralFilterTypes
+ */
+CV_EXPORTS_W void bilateralFilter( InputArray src, OutputArray dst, int d,
+                                   double sigmaColor, double sigmaSpace,
+                                   int borderType, int mode );
+
 /** @brief Blurs an image using the box filter.
 
 The function smoothes an image using the kernel:
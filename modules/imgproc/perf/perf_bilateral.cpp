@@ -36,3 +36,50 @@ PERF_TEST_P( TestBilateralFilter, BilateralFilter,
 
     SANITY_CHECK(dst, .01, ERROR_RELATIVE);
 }
+
+CV_ENUM(BilateralMode, BILATERAL_EXACT, BILATERAL_APPROX)
+
+typedef TestBaseWithParam< tr1::tuple<Size, int, Mat_Type, BilateralMode> > TestBilateralFilterLarge;
+
+PERF_TEST_P( TestBilateralFilterLarge, BilateralFilter_large,
+             Combine(
+                Values( szVGA, sz720p ), // image size
+                Values( 4, 12 ), // sigmaSpace, d is computed from it
+                Mat_Type::all(), // image type
+                BilateralMode::all()
+             )
+)
+{
+    Size sz = get<0>(GetParam());
+    double sigmaSpace = get<1>(GetParam()), sigmaColor = 40.;
+    int type = get<2>(GetParam()), mode = get<3>(GetParam());
+
+    Mat src, dst(sz, type);
+
+    // smooth gradients with noise, so that the color kernel matters
+    Mat pattern(4, 4, CV_MAKETYPE(CV_32F, CV_MAT_CN(type)), Scalar::all(20)), img, noise(sz, pattern.type());
+    pattern.setTo(Scalar::all(220), Mat::eye(4, 4, CV_8U));
+    resize(pattern, img, sz);
+    randn(noise, Scalar::all(0), Scalar::all(10));
+    img += noise;
+    img.convertTo(src, type);
+
+    declare.in(src).out(dst).time(60);
+
+    TEST_CYCLE() bilateralFilter(src, dst, 0, sigmaColor, sigmaSpace, BORDER_DEFAULT, mode);
+
+    if( mode == BILATERAL_APPROX )
+    {
+        // the accuracy of the approximation against the exact filter, in dB
+        Mat exact;
+        bilateralFilter(src, exact, 0, sigmaColor, sigmaSpace, BORDER_DEFAULT, BILATERAL_EXACT);
+        if( CV_MAT_DEPTH(type) == CV_32F )
+        {
+            exact.convertTo(exact, CV_8U);
+            dst.convertTo(dst, CV_8U);
+        }
+        RecordProperty("psnr", cv::format("%.2f", PSNR(exact, dst)));
+    }
+
+    SANITY_CHECK_NOTHING();
+}
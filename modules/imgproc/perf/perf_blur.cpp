@@ -34,6 +34,28 @@ PERF_TEST_P(Size_MatType_kSize, medianBlur,
     SANITY_CHECK(dst);
 }
 
+PERF_TEST_P(Size_MatType_kSize, medianBlur_large,
+            testing::Combine(
+                testing::Values(sz720p, sz1080p),
+                testing::Values(CV_8UC1, CV_16UC1, CV_32FC1),
+                testing::Values(7, 15, 31)
+                )
+            )
+{
+    Size size = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    int ksize = get<2>(GetParam());
+
+    Mat src(size, type);
+    Mat dst(size, type);
+
+    declare.in(src, WARMUP_RNG).out(dst).time(30);
+
+    TEST_CYCLE() medianBlur(src, dst, ksize);
+
+    SANITY_CHECK_NOTHING();
+}
+
 CV_ENUM(BorderType3x3, BORDER_REPLICATE, BORDER_CONSTANT)
 CV_ENUM(BorderType, BORDER_REPLICATE, BORDER_CONSTANT, BORDER_REFLECT, BORDER_REFLECT101)
 
@@ -186,6 +208,28 @@ PERF_TEST_P(Size_MatType_BorderType, gaussianBlur5x5,
     SANITY_CHECK(dst, 1);
 }
 
+PERF_TEST_P(Size_MatType_kSize, gaussianBlur_large,
+            testing::Combine(
+                testing::Values(sz720p, sz1080p),
+                testing::Values(CV_8UC1, CV_8UC3, CV_16UC1),
+                testing::Values(7, 15, 31)
+                )
+            )
+{
+    Size size = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    int ksize = get<2>(GetParam());
+
+    Mat src(size, type);
+    Mat dst(size, type);
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() GaussianBlur(src, dst, Size(ksize, ksize), 0, 0);
+
+    SANITY_CHECK_NOTHING();
+}
+
 PERF_TEST_P(Size_MatType_BorderType, blur5x5,
             testing::Combine(
                 testing::Values(szVGA, sz720p),
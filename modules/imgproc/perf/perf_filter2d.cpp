@@ -42,6 +42,37 @@ PERF_TEST_P( TestFilter2d, Filter2d,
     SANITY_CHECK(dst, 1);
 }
 
+typedef TestBaseWithParam< tr1::tuple<int, int, MatType> > Threads_KernelSize_MatType;
+
+// the scaling of the stripe-parallel filtering of the 1080p image with the number of threads;
+// the larger kernels are processed in the frequency domain
+PERF_TEST_P( Threads_KernelSize_MatType, Filter2d_threads,
+             Combine(
+                Values( 1, 2, 4, 8 ),
+                Values( 3, 5, 7, 11 ),
+                Values( CV_8UC1, CV_32FC1 )
+             )
+)
+{
+    int threads = get<0>(GetParam());
+    int kSize = get<1>(GetParam());
+    int type = get<2>(GetParam());
+
+    Mat src(sz1080p, type), dst(sz1080p, type);
+    Mat kernel(kSize, kSize, CV_32FC1);
+    randu(kernel, -1, 1);
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    setNumThreads(threads);
+
+    TEST_CYCLE() filter2D(src, dst, -1, kernel);
+
+    setNumThreads(-1);
+
+    SANITY_CHECK_NOTHING();
+}
+
 PERF_TEST_P( Image_KernelSize, GaborFilter2d,
              Combine(
                  Values("stitching/a1.png", "cv/shared/pic5.png"),
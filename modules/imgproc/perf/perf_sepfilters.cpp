@@ -242,3 +242,106 @@ PERF_TEST_P(Size_MatType_dx_dy_Border3x3ROI, scharrViaSobelFilter,
 
     SANITY_CHECK(dst);
 }
+
+typedef std::tr1::tuple<int, int, MatType> Threads_KernelSize_MatType_t;
+typedef perf::TestBaseWithParam<Threads_KernelSize_MatType_t> Threads_KernelSize_MatType;
+
+// the scaling of the stripe-parallel separable filtering of the 1080p image with the number of threads
+PERF_TEST_P(Threads_KernelSize_MatType, sepFilter2D_threads,
+            testing::Combine(
+                testing::Values(1, 2, 4, 8),
+                testing::Values(3, 7, 15, 31),
+                testing::Values(CV_8UC1, CV_8UC3, CV_32FC1)
+            )
+          )
+{
+    int threads = get<0>(GetParam());
+    int ksize = get<1>(GetParam());
+    int type = get<2>(GetParam());
+
+    Mat src(sz1080p, type), dst(sz1080p, type);
+    Mat kx = getGaussianKernel(ksize, -1, CV_32F), ky = getGaussianKernel(ksize, -1, CV_32F);
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    setNumThreads(threads);
+
+    TEST_CYCLE() sepFilter2D(src, dst, -1, kx, ky);
+
+    setNumThreads(-1);
+
+    SANITY_CHECK_NOTHING();
+}
+
+typedef std::tr1::tuple<int, int> Threads_KernelSize_t;
+typedef perf::TestBaseWithParam<Threads_KernelSize_t> Threads_KernelSize;
+
+PERF_TEST_P(Threads_KernelSize, Laplacian_threads,
+            testing::Combine(
+                testing::Values(1, 2, 4, 8),
+                testing::Values(5, 7, 15, 31)
+            )
+          )
+{
+    int threads = get<0>(GetParam());
+    int ksize = get<1>(GetParam());
+
+    Mat src(sz1080p, CV_8UC1), dst(sz1080p, CV_32FC1);
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    setNumThreads(threads);
+
+    TEST_CYCLE() Laplacian(src, dst, CV_32F, ksize);
+
+    setNumThreads(-1);
+
+    SANITY_CHECK_NOTHING();
+}
+
+typedef std::tr1::tuple<Size, int, MatType> Size_KernelSize_MatType_t;
+typedef perf::TestBaseWithParam<Size_KernelSize_MatType_t> Size_KernelSize_MatType;
+
+// the large images, where the intermediate rows of the large kernels do not fit the cache
+PERF_TEST_P(Size_KernelSize_MatType, sepFilter2D_large,
+            testing::Combine(
+                testing::Values(sz1080p, sz2160p),
+                testing::Values(3, 7, 15, 31),
+                testing::Values(CV_8UC1, CV_8UC3, CV_16UC1, CV_16SC1, CV_32FC1)
+            )
+          )
+{
+    Size size = get<0>(GetParam());
+    int ksize = get<1>(GetParam());
+    int type = get<2>(GetParam());
+
+    Mat src(size, type), dst(size, type);
+    Mat kx = getGaussianKernel(ksize, -1, CV_32F), ky = getGaussianKernel(ksize, -1, CV_32F);
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() sepFilter2D(src, dst, -1, kx, ky);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(Size_KernelSize_MatType, Sobel_large,
+            testing::Combine(
+                testing::Values(sz1080p, sz2160p),
+                testing::Values(3, 7, 15, 31),
+                testing::Values(CV_8UC1, CV_16UC1)
+            )
+          )
+{
+    Size size = get<0>(GetParam());
+    int ksize = get<1>(GetParam());
+    int type = get<2>(GetParam());
+
+    Mat src(size, type), dst(size, CV_32F);
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() Sobel(src, dst, CV_32F, 1, 1, ksize);
+
+    SANITY_CHECK_NOTHING();
+}
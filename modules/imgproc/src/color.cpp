@@ -92,6 +92,8 @@
 
 #include "precomp.hpp"
 #include "opencl_kernels_imgproc.hpp"
+#include "color.simd.hpp"
+#include "color.simd_declarations.hpp"
 #include <limits>
 
 #define  CV_DESCALE(x,n)     (((x) + (1 << ((n)-1))) >> (n))
@@ -1289,16 +1291,27 @@ template<> struct RGB2Gray<uchar>
             tab[i+256] = g;
             tab[i+512] = r;
         }
+
+        c0 = db; c1 = dg; c2 = dr;
+        useSIMD = c0 >= 0 && c1 >= 0 && c2 >= 0 && c0 + c1 + c2 <= (1 << yuv_shift);
     }
     void operator()(const uchar* src, uchar* dst, int n) const
     {
-        int scn = srccn;
+        int scn = srccn, i = 0;
         const int* _tab = tab;
-        for(int i = 0; i < n; i++, src += scn)
+        if( useSIMD )
+        {
+            CV_Assert( yuv_shift == 14 );
+            i = CV_CPU_DISPATCH(rgb2gray_simd, (src, dst, n, scn, c0, c1, c2));
+            src += i*scn;
+        }
+        for( ; i < n; i++, src += scn)
             dst[i] = (uchar)((_tab[src[0]] + _tab[src[1]+256] + _tab[src[2]+512]) >> yuv_shift);
     }
     int srccn;
     int tab[256*3];
+    int c0, c1, c2;
+    bool useSIMD;
 };
 
 #if CV_NEON
@@ -7924,6 +7937,8 @@ static bool ipp_cvtColor( Mat &src, OutputArray _dst, int code, int dcn )
 
 void cv::cvtColor( InputArray _src, OutputArray _dst, int code, int dcn )
 {
+    CV_TRACE_FUNCTION();
+
     int stype = _src.type();
     int scn = CV_MAT_CN(stype), depth = CV_MAT_DEPTH(stype), bidx;
 
@@ -0,0 +1,61 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+// No include guard: the kernels are compiled once per dispatched instruction set,
+// see ocv_add_dispatched_file() in cmake/OpenCVCompilerOptimizations.cmake.
+// The kernels return the number of processed pixels, the tail is handled by the caller.
+
+#include "opencv2/core/hal/intrin.hpp"
+
+namespace cv {
+CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
+
+// dst[i] = (src[0]*c0 + src[1]*c1 + src[2]*c2 + 2^13) >> 14, where src is the i-th pixel;
+// the coefficients must be non-negative with c0 + c1 + c2 <= 2^14
+int rgb2gray_simd(const uchar* src, uchar* dst, int n, int scn, int c0, int c1, int c2);
+
+#ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+int rgb2gray_simd(const uchar* src, uchar* dst, int n, int scn, int c0, int c1, int c2)
+{
+    int i = 0;
+#if CV_SIMD
+    const int VECSZ = v_uint8::nlanes;
+    const int shift = 14;
+    v_uint16 v_c0 = vx_setall_u16((ushort)c0), v_c1 = vx_setall_u16((ushort)c1), v_c2 = vx_setall_u16((ushort)c2);
+    v_uint32 v_delta = vx_setall_u32(1 << (shift - 1));
+
+    for ( ; i <= n - VECSZ; i += VECSZ, src += scn*VECSZ)
+    {
+        v_uint8 s0, s1, s2, s3;
+        if (scn == 3)
+            v_load_deinterleave(src, s0, s1, s2);
+        else
+            v_load_deinterleave(src, s0, s1, s2, s3);
+
+        v_uint16 x[2], y[2], z[2], gray[2];
+        v_expand(s0, x[0], x[1]);
+        v_expand(s1, y[0], y[1]);
+        v_expand(s2, z[0], z[1]);
+
+        for (int k = 0; k < 2; k++)
+        {
+            v_uint32 x0, x1, y0, y1, z0, z1;
+            v_mul_expand(x[k], v_c0, x0, x1);
+            v_mul_expand(y[k], v_c1, y0, y1);
+            v_mul_expand(z[k], v_c2, z0, z1);
+            gray[k] = v_pack((x0 + y0 + z0 + v_delta) >> shift, (x1 + y1 + z1 + v_delta) >> shift);
+        }
+        v_store(dst + i, v_pack(gray[0], gray[1]));
+    }
+#else
+    (void)src; (void)dst; (void)n; (void)scn; (void)c0; (void)c1; (void)c2;
+#endif
+    return i;
+}
+
+#endif // CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+CV_CPU_OPTIMIZATION_NAMESPACE_END
+} // namespace cv
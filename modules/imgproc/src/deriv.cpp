@@ -513,6 +513,8 @@ static bool ipp_sobel(InputArray _src, OutputArray _dst, int ddepth, int dx, int
 void cv::Sobel( InputArray _src, OutputArray _dst, int ddepth, int dx, int dy,
                 int ksize, double scale, double delta, int borderType )
 {
+    CV_TRACE_FUNCTION();
+
     int stype = _src.type(), sdepth = CV_MAT_DEPTH(stype), cn = CV_MAT_CN(stype);
     if (ddepth < 0)
         ddepth = sdepth;
@@ -552,6 +554,8 @@ void cv::Sobel( InputArray _src, OutputArray _dst, int ddepth, int dx, int dy,
 void cv::Scharr( InputArray _src, OutputArray _dst, int ddepth, int dx, int dy,
                  double scale, double delta, int borderType )
 {
+    CV_TRACE_FUNCTION();
+
     int stype = _src.type(), sdepth = CV_MAT_DEPTH(stype), cn = CV_MAT_CN(stype);
     if (ddepth < 0)
         ddepth = sdepth;
@@ -799,9 +803,74 @@ static bool ipp_Laplacian(InputArray _src, OutputArray _dst, int ddepth, int ksi
 #endif
 
 
+namespace cv
+{
+
+// computes the sum of the second derivatives over a horizontal stripe of the image;
+// every stripe uses its own pair of the filter engines
+class LaplacianInvoker : public ParallelLoopBody
+{
+public:
+    LaplacianInvoker(const Mat& _src, Mat& _dst, const Size& _wsz, const Point& _ofs,
+                     const Mat& _kd, const Mat& _ks, int _wtype,
+                     double _scale, double _delta, int _borderType) :
+        src(&_src), dst(&_dst), wsz(_wsz), ofs(_ofs), kd(_kd), ks(_ks), wtype(_wtype),
+        scale(_scale), delta(_delta), borderType(_borderType)
+    {
+    }
+
+    void operator()(const Range& range) const
+    {
+        const size_t STRIPE_SIZE = 1 << 14;
+        int stype = src->type(), ddepth = dst->depth();
+        Ptr<FilterEngine> fx = createSeparableLinearFilter(stype,
+            wtype, kd, ks, Point(-1,-1), 0, borderType, borderType, Scalar() );
+        Ptr<FilterEngine> fy = createSeparableLinearFilter(stype,
+            wtype, ks, kd, Point(-1,-1), 0, borderType, borderType, Scalar() );
+
+        Mat srcStripe = src->rowRange(range), dstStripe = dst->rowRange(range);
+        Point sofs(ofs.x, ofs.y + range.start);
+
+        int y = fx->start(srcStripe, wsz, sofs), dsty = 0, dy = 0;
+        fy->start(srcStripe, wsz, sofs);
+        const uchar* sptr = srcStripe.ptr() + srcStripe.step[0] * y;
+
+        int dy0 = std::min(std::max((int)(STRIPE_SIZE/(CV_ELEM_SIZE(stype)*srcStripe.cols)), 1), srcStripe.rows);
+        Mat d2x( dy0 + kd.rows - 1, srcStripe.cols, wtype );
+        Mat d2y( dy0 + kd.rows - 1, srcStripe.cols, wtype );
+
+        for( ; dsty < srcStripe.rows; sptr += dy0*srcStripe.step, dsty += dy )
+        {
+            fx->proceed( sptr, (int)srcStripe.step, dy0, d2x.ptr(), (int)d2x.step );
+            dy = fy->proceed( sptr, (int)srcStripe.step, dy0, d2y.ptr(), (int)d2y.step );
+            if( dy > 0 )
+            {
+                Mat dstripe = dstStripe.rowRange(dsty, dsty + dy);
+                d2x.rows = d2y.rows = dy; // modify the headers, which should work
+                d2x += d2y;
+                d2x.convertTo( dstripe, ddepth, scale, delta );
+            }
+        }
+    }
+
+private:
+    const Mat* src;
+    Mat* dst;
+    Size wsz;
+    Point ofs;
+    Mat kd, ks;
+    int wtype;
+    double scale, delta;
+    int borderType;
+};
+
+}
+
 void cv::Laplacian( InputArray _src, OutputArray _dst, int ddepth, int ksize,
                     double scale, double delta, int borderType )
 {
+    CV_TRACE_FUNCTION();
+
     int stype = _src.type(), sdepth = CV_MAT_DEPTH(stype), cn = CV_MAT_CN(stype);
     if (ddepth < 0)
         ddepth = sdepth;
@@ -849,37 +918,18 @@ void cv::Laplacian( InputArray _src, OutputArray _dst, int ddepth, int ksize,
                    ocl_Laplacian5(_src, _dst, kd, ks, scale,
                                   delta, borderType, wdepth, ddepth))
 
-        const size_t STRIPE_SIZE = 1 << 14;
-        Ptr<FilterEngine> fx = createSeparableLinearFilter(stype,
-            wtype, kd, ks, Point(-1,-1), 0, borderType, borderType, Scalar() );
-        Ptr<FilterEngine> fy = createSeparableLinearFilter(stype,
-            wtype, ks, kd, Point(-1,-1), 0, borderType, borderType, Scalar() );
-
         Mat src = _src.getMat(), dst = _dst.getMat();
         Point ofs;
         Size wsz(src.cols, src.rows);
         src.locateROI( wsz, ofs );
 
-        int y = fx->start(src, wsz, ofs), dsty = 0, dy = 0;
-        fy->start(src, wsz, ofs);
-        const uchar* sptr = src.ptr() + src.step[0] * y;
-
-        int dy0 = std::min(std::max((int)(STRIPE_SIZE/(CV_ELEM_SIZE(stype)*src.cols)), 1), src.rows);
-        Mat d2x( dy0 + kd.rows - 1, src.cols, wtype );
-        Mat d2y( dy0 + kd.rows - 1, src.cols, wtype );
-
-        for( ; dsty < src.rows; sptr += dy0*src.step, dsty += dy )
-        {
-            fx->proceed( sptr, (int)src.step, dy0, d2x.ptr(), (int)d2x.step );
-            dy = fy->proceed( sptr, (int)src.step, dy0, d2y.ptr(), (int)d2y.step );
-            if( dy > 0 )
-            {
-                Mat dstripe = dst.rowRange(dsty, dsty + dy);
-                d2x.rows = d2y.rows = dy; // modify the headers, which should work
-                d2x += d2y;
-                d2x.convertTo( dstripe, ddepth, scale, delta );
-            }
-        }
+        LaplacianInvoker invoker(src, dst, wsz, ofs, kd, ks, wtype, scale, delta, borderType);
+        int nstripes = getFilterStripes(src.size(), Size(ksize, ksize), ksize*4);
+        // the stripes read the source rows around them, so in-place processing is done serially
+        if( nstripes > 1 && (dst.datastart >= src.dataend || dst.dataend <= src.datastart) )
+            parallel_for_(Range(0, src.rows), invoker, nstripes);
+        else
+            invoker(Range(0, src.rows));
     }
 }
 
@@ -44,6 +44,8 @@
 #include "opencv2/core/opencl/ocl_defs.hpp"
 #include "opencl_kernels_imgproc.hpp"
 #include "hal_replacement.hpp"
+#include "filter.simd.hpp"
+#include "filter.simd_declarations.hpp"
 
 /****************************************************************************************\
                                     Base Image Filter
@@ -389,6 +391,118 @@ void FilterEngine::apply(const Mat& src, Mat& dst, const Size & wsz, const Point
             (int)dst.step );
 }
 
+/****************************************************************************************\
+*                               Stripe-parallel filtering                                *
+\****************************************************************************************/
+
+FilterEngineFactory::~FilterEngineFactory() {}
+
+// every stripe filters ksize.height-1 extra source rows and allocates its own ring buffer,
+// so the stripes are kept several kernels high
+enum { FILTER_STRIPE_GRAIN = 1 << 16, FILTER_STRIPE_KERNELS = 4, FILTER_MIN_STRIPE_ROWS = 16 };
+
+int getFilterStripes(Size size, Size ksize, double pixelCost)
+{
+    int nthreads = getNumThreads();
+    if( nthreads <= 1 )
+        return 1;
+    double nstripes = (double)size.area()*pixelCost/FILTER_STRIPE_GRAIN;
+    int maxStripes = size.height/std::max(ksize.height*FILTER_STRIPE_KERNELS, (int)FILTER_MIN_STRIPE_ROWS);
+    return std::max(std::min(std::min(cvFloor(nstripes), maxStripes), nthreads*2), 1);
+}
+
+// the ring buffer of a tile is kept in L2 cache together with the source and the destination rows;
+// the narrower tiles would spend too much time on the row tails and the horizontal borders
+enum { FILTER_TILE_BUFFER = 1 << 17, FILTER_MIN_TILE_WIDTH = 256 };
+
+static int getFilterTileWidth(const FilterEngine& f, int width)
+{
+    int bufRows = std::max(f.ksize.height + 3,
+                           std::max(f.anchor.y, f.ksize.height - f.anchor.y - 1)*2 + 1);
+    int bufElemSize = (int)getElemSize(f.bufType);
+    int tileWidth = FILTER_TILE_BUFFER/(bufRows*bufElemSize) - (f.isSeparable() ? 0 : f.ksize.width - 1);
+    tileWidth = std::max(tileWidth, (int)FILTER_MIN_TILE_WIDTH);
+    if( width < tileWidth*2 )
+        return width;
+    int ntiles = (width + tileWidth - 1)/tileWidth;
+    return std::min((int)alignSize((width + ntiles - 1)/ntiles, 16), width);
+}
+
+void applyFilterTiles(FilterEngine& f, const Mat& src, Mat& dst, const Size& wsz, const Point& ofs)
+{
+    CV_Assert( src.size() == dst.size() );
+
+    int tileWidth = getFilterTileWidth(f, src.cols);
+    for( int x = 0; x < src.cols; x += tileWidth )
+    {
+        Range cols(x, std::min(x + tileWidth, src.cols));
+        Mat srcTile = src.colRange(cols), dstTile = dst.colRange(cols);
+        f.apply(srcTile, dstTile, wsz, Point(ofs.x + x, ofs.y));
+    }
+}
+
+class FilterStripesInvoker : public ParallelLoopBody
+{
+public:
+    FilterStripesInvoker(const FilterEngineFactory& _factory, const Mat& _src, Mat& _dst,
+                         const Size& _wsz, const Point& _ofs) :
+        factory(&_factory), src(&_src), dst(&_dst), wsz(_wsz), ofs(_ofs)
+    {
+    }
+
+    void operator()(const Range& range) const
+    {
+        Ptr<FilterEngine> f = factory->createEngine();
+        Mat srcStripe = src->rowRange(range), dstStripe = dst->rowRange(range);
+        applyFilterTiles(*f, srcStripe, dstStripe, wsz, Point(ofs.x, ofs.y + range.start));
+    }
+
+private:
+    const FilterEngineFactory* factory;
+    const Mat* src;
+    Mat* dst;
+    Size wsz;
+    Point ofs;
+};
+
+void applyFilterStripes(const FilterEngineFactory& factory, const Mat& src, Mat& dst,
+                        const Size& wsz, const Point& ofs, int nstripes)
+{
+    CV_Assert( src.size() == dst.size() );
+
+    FilterStripesInvoker invoker(factory, src, dst, wsz, ofs);
+    if( nstripes <= 1 )
+        invoker(Range(0, src.rows));
+    else
+        parallel_for_(Range(0, src.rows), invoker, nstripes);
+}
+
+// the stripes and the tiles read the source pixels around them, so the destination of the stripe-parallel
+// and the tiled filtering may not overwrite any part of the source image
+static bool overlapsFilterSource(const uchar* src_data, size_t src_step, int full_height, int offset_y,
+                                 const uchar* dst_data, size_t dst_step, int height)
+{
+    const uchar* src0 = src_data - src_step*offset_y;
+    const uchar* src1 = src0 + src_step*full_height;
+    return src0 < dst_data + dst_step*height && dst_data < src1;
+}
+
+void applyFilter(const FilterEngineFactory& factory, FilterEngine& f, const Mat& src, Mat& dst,
+                 const Size& wsz, const Point& ofs, double pixelCost)
+{
+    if( overlapsFilterSource(src.data, src.step, wsz.height, ofs.y, dst.data, dst.step, dst.rows) )
+    {
+        f.apply(src, dst, wsz, ofs);
+        return;
+    }
+
+    int nstripes = getFilterStripes(dst.size(), f.ksize, pixelCost);
+    if( nstripes > 1 )
+        applyFilterStripes(factory, src, dst, wsz, ofs, nstripes);
+    else
+        applyFilterTiles(f, src, dst, wsz, ofs);
+}
+
 }
 
 /****************************************************************************************\
@@ -471,8 +585,6 @@ struct FilterNoVec
 };
 
 
-#if CV_SSE2
-
 ///////////////////////////////////// 8u-16s & 8u-8u //////////////////////////////////
 
 struct RowVec_8u32s
@@ -496,75 +608,80 @@ struct RowVec_8u32s
 
     int operator()(const uchar* _src, uchar* _dst, int width, int cn) const
     {
-        if( !checkHardwareSupport(CV_CPU_SSE2) )
+        if( !smallValues )
             return 0;
 
-        int i = 0, k, _ksize = kernel.rows + kernel.cols - 1;
-        int* dst = (int*)_dst;
-        const int* _kx = kernel.ptr<int>();
-        width *= cn;
+        return CV_CPU_DISPATCH(rowFilter_simd, (_src, (int*)_dst, kernel.ptr<int>(),
+                                                kernel.rows + kernel.cols - 1, width*cn, cn));
+    }
 
-        if( smallValues )
-        {
-            for( ; i <= width - 16; i += 16 )
-            {
-                const uchar* src = _src + i;
-                __m128i f, z = _mm_setzero_si128(), s0 = z, s1 = z, s2 = z, s3 = z;
-                __m128i x0, x1, x2, x3;
+    Mat kernel;
+    bool smallValues;
+};
 
-                for( k = 0; k < _ksize; k++, src += cn )
-                {
-                    f = _mm_cvtsi32_si128(_kx[k]);
-                    f = _mm_shuffle_epi32(f, 0);
-                    f = _mm_packs_epi32(f, f);
-
-                    x0 = _mm_loadu_si128((const __m128i*)src);
-                    x2 = _mm_unpackhi_epi8(x0, z);
-                    x0 = _mm_unpacklo_epi8(x0, z);
-                    x1 = _mm_mulhi_epi16(x0, f);
-                    x3 = _mm_mulhi_epi16(x2, f);
-                    x0 = _mm_mullo_epi16(x0, f);
-                    x2 = _mm_mullo_epi16(x2, f);
-
-                    s0 = _mm_add_epi32(s0, _mm_unpacklo_epi16(x0, x1));
-                    s1 = _mm_add_epi32(s1, _mm_unpackhi_epi16(x0, x1));
-                    s2 = _mm_add_epi32(s2, _mm_unpacklo_epi16(x2, x3));
-                    s3 = _mm_add_epi32(s3, _mm_unpackhi_epi16(x2, x3));
-                }
 
-                _mm_store_si128((__m128i*)(dst + i), s0);
-                _mm_store_si128((__m128i*)(dst + i + 4), s1);
-                _mm_store_si128((__m128i*)(dst + i + 8), s2);
-                _mm_store_si128((__m128i*)(dst + i + 12), s3);
-            }
+///////////////////////////////// 8u-32f, 16u-32f & 16s-32f /////////////////////////////////
 
-            for( ; i <= width - 4; i += 4 )
-            {
-                const uchar* src = _src + i;
-                __m128i f, z = _mm_setzero_si128(), s0 = z, x0, x1;
+template<typename T> struct RowVecToFloat
+{
+    RowVecToFloat() {}
+    RowVecToFloat( const Mat& _kernel ) { kernel = _kernel; }
 
-                for( k = 0; k < _ksize; k++, src += cn )
-                {
-                    f = _mm_cvtsi32_si128(_kx[k]);
-                    f = _mm_shuffle_epi32(f, 0);
-                    f = _mm_packs_epi32(f, f);
-
-                    x0 = _mm_cvtsi32_si128(*(const int*)src);
-                    x0 = _mm_unpacklo_epi8(x0, z);
-                    x1 = _mm_mulhi_epi16(x0, f);
-                    x0 = _mm_mullo_epi16(x0, f);
-                    s0 = _mm_add_epi32(s0, _mm_unpacklo_epi16(x0, x1));
-                }
-                _mm_store_si128((__m128i*)(dst + i), s0);
-            }
-        }
-        return i;
+    int operator()(const uchar* _src, uchar* _dst, int width, int cn) const
+    {
+        return rowFilterToFloat((const T*)_src, (float*)_dst, kernel.ptr<float>(),
+                                kernel.rows + kernel.cols - 1, width*cn, cn);
     }
 
+    static int rowFilterToFloat(const uchar* src, float* dst, const float* kx, int ksize, int width, int cn)
+    { return CV_CPU_DISPATCH(rowFilter8u32f_simd, (src, dst, kx, ksize, width, cn)); }
+    static int rowFilterToFloat(const ushort* src, float* dst, const float* kx, int ksize, int width, int cn)
+    { return CV_CPU_DISPATCH(rowFilter16u32f_simd, (src, dst, kx, ksize, width, cn)); }
+    static int rowFilterToFloat(const short* src, float* dst, const float* kx, int ksize, int width, int cn)
+    { return CV_CPU_DISPATCH(rowFilter16s32f_simd, (src, dst, kx, ksize, width, cn)); }
+
+    Mat kernel;
+};
+
+typedef RowVecToFloat<uchar> RowVec_8u32f;
+typedef RowVecToFloat<ushort> RowVec_16u32f;
+typedef RowVecToFloat<short> RowVec_16s32f;
+
+template<typename T> struct SymmColumnVecFromFloat
+{
+    SymmColumnVecFromFloat() { symmetryType=0; delta = 0; }
+    SymmColumnVecFromFloat(const Mat& _kernel, int _symmetryType, int, double _delta)
+    {
+        symmetryType = _symmetryType;
+        kernel = _kernel;
+        delta = (float)_delta;
+        CV_Assert( (symmetryType & (KERNEL_SYMMETRICAL | KERNEL_ASYMMETRICAL)) != 0 );
+    }
+
+    int operator()(const uchar** _src, uchar* _dst, int width) const
+    {
+        int ksize2 = (kernel.rows + kernel.cols - 1)/2;
+        return symmColumnFilterFromFloat((const float**)_src, (T*)_dst, kernel.ptr<float>() + ksize2,
+                                         ksize2, delta, width, (symmetryType & KERNEL_SYMMETRICAL) != 0);
+    }
+
+    static int symmColumnFilterFromFloat(const float** src, uchar* dst, const float* ky, int ksize2,
+                                         float delta, int width, bool symmetrical)
+    { return CV_CPU_DISPATCH(symmColumnFilter32f8u_simd, (src, dst, ky, ksize2, delta, width, symmetrical)); }
+    static int symmColumnFilterFromFloat(const float** src, ushort* dst, const float* ky, int ksize2,
+                                         float delta, int width, bool symmetrical)
+    { return CV_CPU_DISPATCH(symmColumnFilter32f16u_simd, (src, dst, ky, ksize2, delta, width, symmetrical)); }
+
+    int symmetryType;
+    float delta;
     Mat kernel;
-    bool smallValues;
 };
 
+typedef SymmColumnVecFromFloat<uchar> SymmColumnVec_32f8u;
+typedef SymmColumnVecFromFloat<ushort> SymmColumnVec_32f16u;
+
+
+#if CV_SSE2
 
 struct SymmRowSmallVec_8u32s
 {
@@ -1178,53 +1295,6 @@ struct SymmColumnSmallVec_32s16s
 
 /////////////////////////////////////// 16s //////////////////////////////////
 
-struct RowVec_16s32f
-{
-    RowVec_16s32f() {}
-    RowVec_16s32f( const Mat& _kernel )
-    {
-        kernel = _kernel;
-        sse2_supported = checkHardwareSupport(CV_CPU_SSE2);
-    }
-
-    int operator()(const uchar* _src, uchar* _dst, int width, int cn) const
-    {
-        if( !sse2_supported )
-            return 0;
-
-        int i = 0, k, _ksize = kernel.rows + kernel.cols - 1;
-        float* dst = (float*)_dst;
-        const float* _kx = kernel.ptr<float>();
-        width *= cn;
-
-        for( ; i <= width - 8; i += 8 )
-        {
-            const short* src = (const short*)_src + i;
-            __m128 f, s0 = _mm_setzero_ps(), s1 = s0, x0, x1;
-            for( k = 0; k < _ksize; k++, src += cn )
-            {
-                f = _mm_load_ss(_kx+k);
-                f = _mm_shuffle_ps(f, f, 0);
-
-                __m128i x0i = _mm_loadu_si128((const __m128i*)src);
-                __m128i x1i = _mm_srai_epi32(_mm_unpackhi_epi16(x0i, x0i), 16);
-                x0i = _mm_srai_epi32(_mm_unpacklo_epi16(x0i, x0i), 16);
-                x0 = _mm_cvtepi32_ps(x0i);
-                x1 = _mm_cvtepi32_ps(x1i);
-                s0 = _mm_add_ps(s0, _mm_mul_ps(x0, f));
-                s1 = _mm_add_ps(s1, _mm_mul_ps(x1, f));
-            }
-            _mm_store_ps(dst + i, s0);
-            _mm_store_ps(dst + i + 4, s1);
-        }
-        return i;
-    }
-
-    Mat kernel;
-    bool sse2_supported;
-};
-
-
 struct SymmColumnVec_32f16s
 {
     SymmColumnVec_32f16s() { symmetryType=0; }
@@ -3010,8 +3080,6 @@ struct SymmRowSmallVec_32f
 };
 
 
-typedef RowNoVec RowVec_8u32s;
-typedef RowNoVec RowVec_16s32f;
 typedef RowNoVec RowVec_32f;
 typedef ColumnNoVec SymmColumnVec_32f;
 typedef SymmColumnSmallNoVec SymmColumnSmallVec_32f;
@@ -3022,8 +3090,6 @@ typedef FilterNoVec FilterVec_32f;
 
 #else
 
-typedef RowNoVec RowVec_8u32s;
-typedef RowNoVec RowVec_16s32f;
 typedef RowNoVec RowVec_32f;
 typedef SymmRowSmallNoVec SymmRowSmallVec_8u32s;
 typedef SymmRowSmallNoVec SymmRowSmallVec_32f;
@@ -3619,11 +3685,13 @@ cv::Ptr<cv::BaseRowFilter> cv::getLinearRowFilter( int srcType, int bufType,
         return makePtr<RowFilter<uchar, int, RowVec_8u32s> >
             (kernel, anchor, RowVec_8u32s(kernel));
     if( sdepth == CV_8U && ddepth == CV_32F )
-        return makePtr<RowFilter<uchar, float, RowNoVec> >(kernel, anchor);
+        return makePtr<RowFilter<uchar, float, RowVec_8u32f> >
+            (kernel, anchor, RowVec_8u32f(kernel));
     if( sdepth == CV_8U && ddepth == CV_64F )
         return makePtr<RowFilter<uchar, double, RowNoVec> >(kernel, anchor);
     if( sdepth == CV_16U && ddepth == CV_32F )
-        return makePtr<RowFilter<ushort, float, RowNoVec> >(kernel, anchor);
+        return makePtr<RowFilter<ushort, float, RowVec_16u32f> >
+            (kernel, anchor, RowVec_16u32f(kernel));
     if( sdepth == CV_16U && ddepth == CV_64F )
         return makePtr<RowFilter<ushort, double, RowNoVec> >(kernel, anchor);
     if( sdepth == CV_16S && ddepth == CV_32F )
@@ -3706,14 +3774,16 @@ cv::Ptr<cv::BaseColumnFilter> cv::getLinearColumnFilter( int bufType, int dstTyp
                 (kernel, anchor, delta, symmetryType, FixedPtCastEx<int, uchar>(bits),
                 SymmColumnVec_32s8u(kernel, symmetryType, bits, delta));
         if( ddepth == CV_8U && sdepth == CV_32F )
-            return makePtr<SymmColumnFilter<Cast<float, uchar>, ColumnNoVec> >
-                (kernel, anchor, delta, symmetryType);
+            return makePtr<SymmColumnFilter<Cast<float, uchar>, SymmColumnVec_32f8u> >
+                (kernel, anchor, delta, symmetryType, Cast<float, uchar>(),
+                SymmColumnVec_32f8u(kernel, symmetryType, 0, delta));
         if( ddepth == CV_8U && sdepth == CV_64F )
             return makePtr<SymmColumnFilter<Cast<double, uchar>, ColumnNoVec> >
                 (kernel, anchor, delta, symmetryType);
         if( ddepth == CV_16U && sdepth == CV_32F )
-            return makePtr<SymmColumnFilter<Cast<float, ushort>, ColumnNoVec> >
-                (kernel, anchor, delta, symmetryType);
+            return makePtr<SymmColumnFilter<Cast<float, ushort>, SymmColumnVec_32f16u> >
+                (kernel, anchor, delta, symmetryType, Cast<float, ushort>(),
+                SymmColumnVec_32f16u(kernel, symmetryType, 0, delta));
         if( ddepth == CV_16U && sdepth == CV_64F )
             return makePtr<SymmColumnFilter<Cast<double, ushort>, ColumnNoVec> >
                 (kernel, anchor, delta, symmetryType);
@@ -4814,31 +4884,40 @@ struct DftFilter : public hal::Filter2D
     }
 };
 
-struct OcvFilter : public hal::Filter2D
+struct OcvFilter : public hal::Filter2D, public FilterEngineFactory
 {
     Ptr<FilterEngine> f;
     int src_type;
     int dst_type;
     bool isIsolated;
+    Mat kernel;
+    Point anchor;
+    double delta;
+    int borderTypeValue;
 
     bool init(uchar* kernel_data, size_t kernel_step, int kernel_type, int kernel_width,
-              int kernel_height, int, int, int stype, int dtype, int borderType, double delta,
+              int kernel_height, int, int, int stype, int dtype, int borderType, double delta_,
               int anchor_x, int anchor_y, bool, bool)
     {
         isIsolated = (borderType & BORDER_ISOLATED) != 0;
         src_type = stype;
         dst_type = dtype;
-        int borderTypeValue = borderType & ~BORDER_ISOLATED;
-        Mat kernel = Mat(Size(kernel_width, kernel_height), kernel_type, kernel_data, kernel_step);
-        f = createLinearFilter(src_type, dst_type, kernel, Point(anchor_x, anchor_y), delta,
-                               borderTypeValue);
+        borderTypeValue = borderType & ~BORDER_ISOLATED;
+        kernel = Mat(Size(kernel_width, kernel_height), kernel_type, kernel_data, kernel_step).clone();
+        anchor = Point(anchor_x, anchor_y);
+        delta = delta_;
+        f = createEngine();
         return true;
     }
+    Ptr<FilterEngine> createEngine() const
+    {
+        return createLinearFilter(src_type, dst_type, kernel, anchor, delta, borderTypeValue);
+    }
     void apply(uchar* src_data, size_t src_step, uchar* dst_data, size_t dst_step, int width, int height, int full_width, int full_height, int offset_x, int offset_y)
     {
         Mat src(Size(width, height), src_type, src_data, src_step);
         Mat dst(Size(width, height), dst_type, dst_data, dst_step);
-        f->apply(src, dst, Size(full_width, full_height), Point(offset_x, offset_y));
+        applyFilter(*this, *f, src, dst, Size(full_width, full_height), Point(offset_x, offset_y), kernel.total());
     }
 };
 
@@ -4882,33 +4961,45 @@ struct ReplacementSepFilter : public hal::SepFilter2D
     }
 };
 
-struct OcvSepFilter : public hal::SepFilter2D
+struct OcvSepFilter : public hal::SepFilter2D, public FilterEngineFactory
 {
     Ptr<FilterEngine> f;
     int src_type;
     int dst_type;
+    Mat kernelX;
+    Mat kernelY;
+    Point anchor;
+    double delta;
+    int borderTypeValue;
     bool init(int stype, int dtype, int ktype,
               uchar * kernelx_data, size_t kernelx_step, int kernelx_width, int kernelx_height,
               uchar * kernely_data, size_t kernely_step, int kernely_width, int kernely_height,
-              int anchor_x, int anchor_y, double delta, int borderType)
+              int anchor_x, int anchor_y, double delta_, int borderType)
     {
         src_type = stype;
         dst_type = dtype;
-        Mat kernelX(Size(kernelx_width, kernelx_height), ktype, kernelx_data, kernelx_step);
-        Mat kernelY(Size(kernely_width, kernely_height), ktype, kernely_data, kernely_step);
+        kernelX = Mat(Size(kernelx_width, kernelx_height), ktype, kernelx_data, kernelx_step).clone();
+        kernelY = Mat(Size(kernely_width, kernely_height), ktype, kernely_data, kernely_step).clone();
+        anchor = Point(anchor_x, anchor_y);
+        delta = delta_;
+        borderTypeValue = borderType & ~BORDER_ISOLATED;
 
-        f = createSeparableLinearFilter( stype, dtype, kernelX, kernelY,
-                                         Point(anchor_x, anchor_y),
-                                         delta, borderType & ~BORDER_ISOLATED );
+        f = createEngine();
         return true;
     }
+    Ptr<FilterEngine> createEngine() const
+    {
+        return createSeparableLinearFilter( src_type, dst_type, kernelX, kernelY,
+                                            anchor, delta, borderTypeValue );
+    }
     void apply(uchar* src_data, size_t src_step, uchar* dst_data, size_t dst_step,
              int width, int height, int full_width, int full_height,
              int offset_x, int offset_y)
     {
         Mat src(Size(width, height), src_type, src_data, src_step);
         Mat dst(Size(width, height), dst_type, dst_data, dst_step);
-        f->apply(src, dst, Size(full_width, full_height), Point(offset_x, offset_y));
+        applyFilter(*this, *f, src, dst, Size(full_width, full_height), Point(offset_x, offset_y),
+                    f->ksize.width + f->ksize.height);
     }
 };
 
@@ -5022,6 +5113,8 @@ void cv::filter2D( InputArray _src, OutputArray _dst, int ddepth,
                    InputArray _kernel, Point anchor0,
                    double delta, int borderType )
 {
+    CV_TRACE_FUNCTION();
+
     CV_OCL_RUN(_dst.isUMat() && _src.dims() <= 2,
                ocl_filter2D(_src, _dst, ddepth, _kernel, anchor0, delta, borderType))
 
@@ -5049,6 +5142,8 @@ void cv::sepFilter2D( InputArray _src, OutputArray _dst, int ddepth,
                       InputArray _kernelX, InputArray _kernelY, Point anchor,
                       double delta, int borderType )
 {
+    CV_TRACE_FUNCTION();
+
     CV_OCL_RUN(_dst.isUMat() && _src.dims() <= 2,
                ocl_sepFilter2D(_src, _dst, ddepth, _kernelX, _kernelY, anchor, delta, borderType))
 
@@ -0,0 +1,210 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+// No include guard: the kernels are compiled once per dispatched instruction set,
+// see ocv_add_dispatched_file() in cmake/OpenCVCompilerOptimizations.cmake.
+// The kernels return the number of processed elements, the tail is handled by the caller.
+
+#include "opencv2/core/hal/intrin.hpp"
+
+namespace cv {
+CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
+
+// dst[i] = sum(src[i + k*cn]*kx[k], k = 0..ksize-1) for i = 0..width-1;
+// the kernel coefficients must fit into short
+int rowFilter_simd(const uchar* src, int* dst, const int* kx, int ksize, int width, int cn);
+
+// dst[i] = sum(src[i + k*cn]*kx[k], k = 0..ksize-1) in floating point,
+// the products are accumulated in the same order as in the scalar RowFilter and without the fused
+// multiply-add (v_muladd is FMA with AVX-512), so the result is the same with all the instruction sets
+int rowFilter8u32f_simd(const uchar* src, float* dst, const float* kx, int ksize, int width, int cn);
+int rowFilter16u32f_simd(const ushort* src, float* dst, const float* kx, int ksize, int width, int cn);
+int rowFilter16s32f_simd(const short* src, float* dst, const float* kx, int ksize, int width, int cn);
+
+// the symmetrical or asymmetrical column filter, src points to the central row of ksize2*2+1 ones
+// and ky to the central kernel coefficient; the same order of operations as in the scalar SymmColumnFilter
+int symmColumnFilter32f8u_simd(const float** src, uchar* dst, const float* ky, int ksize2,
+                               float delta, int width, bool symmetrical);
+int symmColumnFilter32f16u_simd(const float** src, ushort* dst, const float* ky, int ksize2,
+                                float delta, int width, bool symmetrical);
+
+#ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+int rowFilter_simd(const uchar* _src, int* dst, const int* kx, int ksize, int width, int cn)
+{
+    int i = 0, k;
+#if CV_SIMD
+    const int VECSZ = v_uint8::nlanes, NLANES32 = v_int32::nlanes;
+
+    for ( ; i <= width - VECSZ; i += VECSZ)
+    {
+        const uchar* src = _src + i;
+        v_int32 s0 = vx_setzero_s32(), s1 = vx_setzero_s32(), s2 = vx_setzero_s32(), s3 = vx_setzero_s32();
+
+        for (k = 0; k < ksize; k++, src += cn)
+        {
+            v_int16 f = vx_setall_s16((short)kx[k]);
+            v_uint16 x0, x1;
+            v_expand(vx_load(src), x0, x1);
+
+            v_int32 y0, y1, y2, y3;
+            v_mul_expand(v_reinterpret_as_s16(x0), f, y0, y1);
+            v_mul_expand(v_reinterpret_as_s16(x1), f, y2, y3);
+            s0 += y0; s1 += y1; s2 += y2; s3 += y3;
+        }
+
+        v_store(dst + i, s0);
+        v_store(dst + i + NLANES32, s1);
+        v_store(dst + i + NLANES32*2, s2);
+        v_store(dst + i + NLANES32*3, s3);
+    }
+#endif
+#if CV_SIMD128
+    // the rest with the narrow vectors, the row tails are comparable with the wide vectors
+    for ( ; i <= width - v_uint16x8::nlanes; i += v_uint16x8::nlanes)
+    {
+        const uchar* src = _src + i;
+        v_int32x4 s0 = v_setzero_s32(), s1 = v_setzero_s32();
+
+        for (k = 0; k < ksize; k++, src += cn)
+        {
+            v_int32x4 y0, y1;
+            v_mul_expand(v_reinterpret_as_s16(v_load_expand(src)), v_setall_s16((short)kx[k]), y0, y1);
+            s0 += y0; s1 += y1;
+        }
+
+        v_store(dst + i, s0);
+        v_store(dst + i + v_int32x4::nlanes, s1);
+    }
+#else
+    (void)_src; (void)dst; (void)kx; (void)ksize; (void)width; (void)cn; (void)k;
+#endif
+    return i;
+}
+
+#if CV_SIMD
+
+static inline v_float32 vx_load_f32(const uchar* ptr)
+{ return v_cvt_f32(v_reinterpret_as_s32(vx_load_expand_q(ptr))); }
+
+static inline v_float32 vx_load_f32(const ushort* ptr)
+{ return v_cvt_f32(v_reinterpret_as_s32(vx_load_expand(ptr))); }
+
+static inline v_float32 vx_load_f32(const short* ptr)
+{ return v_cvt_f32(vx_load_expand(ptr)); }
+
+// stores 2*v_float32::nlanes rounded and saturated values
+static inline void v_store_f32x2(uchar* ptr, const v_float32& a, const v_float32& b)
+{ v_pack_u_store(ptr, v_pack(v_round(a), v_round(b))); }
+
+static inline void v_store_f32x2(ushort* ptr, const v_float32& a, const v_float32& b)
+{
+    v_pack_u_store(ptr, v_round(a));
+    v_pack_u_store(ptr + v_float32::nlanes, v_round(b));
+}
+
+#endif
+
+template<typename T> static int rowFilterToFloat(const T* _src, float* dst, const float* kx, int ksize, int width, int cn)
+{
+    int i = 0;
+#if CV_SIMD
+    const int VECSZ = v_float32::nlanes;
+
+    for ( ; i <= width - VECSZ*2; i += VECSZ*2)
+    {
+        const T* src = _src + i;
+        v_float32 f = vx_setall_f32(kx[0]);
+        v_float32 s0 = vx_load_f32(src)*f, s1 = vx_load_f32(src + VECSZ)*f;
+
+        for (int k = 1; k < ksize; k++)
+        {
+            src += cn;
+            f = vx_setall_f32(kx[k]);
+            s0 = s0 + vx_load_f32(src)*f;
+            s1 = s1 + vx_load_f32(src + VECSZ)*f;
+        }
+
+        v_store(dst + i, s0);
+        v_store(dst + i + VECSZ, s1);
+    }
+#else
+    (void)_src; (void)dst; (void)kx; (void)ksize; (void)width; (void)cn;
+#endif
+    return i;
+}
+
+template<typename T> static int symmColumnFilterFromFloat(const float** src, T* dst, const float* ky, int ksize2,
+                                                          float delta, int width, bool symmetrical)
+{
+    int i = 0;
+#if CV_SIMD
+    const int VECSZ = v_float32::nlanes;
+    v_float32 d = vx_setall_f32(delta);
+
+    for ( ; i <= width - VECSZ*2; i += VECSZ*2)
+    {
+        v_float32 s0 = d, s1 = d;
+        if (symmetrical)
+        {
+            v_float32 f = vx_setall_f32(ky[0]);
+            s0 = d + vx_load(src[0] + i)*f;
+            s1 = d + vx_load(src[0] + i + VECSZ)*f;
+            for (int k = 1; k <= ksize2; k++)
+            {
+                const float *S = src[k] + i, *S2 = src[-k] + i;
+                f = vx_setall_f32(ky[k]);
+                s0 = s0 + (vx_load(S) + vx_load(S2))*f;
+                s1 = s1 + (vx_load(S + VECSZ) + vx_load(S2 + VECSZ))*f;
+            }
+        }
+        else
+        {
+            for (int k = 1; k <= ksize2; k++)
+            {
+                const float *S = src[k] + i, *S2 = src[-k] + i;
+                v_float32 f = vx_setall_f32(ky[k]);
+                s0 = s0 + (vx_load(S) - vx_load(S2))*f;
+                s1 = s1 + (vx_load(S + VECSZ) - vx_load(S2 + VECSZ))*f;
+            }
+        }
+        v_store_f32x2(dst + i, s0, s1);
+    }
+#else
+    (void)src; (void)dst; (void)ky; (void)ksize2; (void)delta; (void)width; (void)symmetrical;
+#endif
+    return i;
+}
+
+int rowFilter8u32f_simd(const uchar* src, float* dst, const float* kx, int ksize, int width, int cn)
+{
+    return rowFilterToFloat(src, dst, kx, ksize, width, cn);
+}
+
+int rowFilter16u32f_simd(const ushort* src, float* dst, const float* kx, int ksize, int width, int cn)
+{
+    return rowFilterToFloat(src, dst, kx, ksize, width, cn);
+}
+
+int rowFilter16s32f_simd(const short* src, float* dst, const float* kx, int ksize, int width, int cn)
+{
+    return rowFilterToFloat(src, dst, kx, ksize, width, cn);
+}
+
+int symmColumnFilter32f8u_simd(const float** src, uchar* dst, const float* ky, int ksize2,
+                               float delta, int width, bool symmetrical)
+{
+    return symmColumnFilterFromFloat(src, dst, ky, ksize2, delta, width, symmetrical);
+}
+
+int symmColumnFilter32f16u_simd(const float** src, ushort* dst, const float* ky, int ksize2,
+                                float delta, int width, bool symmetrical)
+{
+    return symmColumnFilterFromFloat(src, dst, ky, ksize2, delta, width, symmetrical);
+}
+
+#endif // CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+CV_CPU_OPTIMIZATION_NAMESPACE_END
+} // namespace cv
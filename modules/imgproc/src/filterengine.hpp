@@ -277,6 +277,57 @@ public:
 };
 
 
+/*!
+ The Factory of Filter Engines for the Stripe-Parallel Filtering.
+
+ FilterEngine and the primitive filters keep the intermediate rows and the other context,
+ so an engine may not be shared between threads. The stripe-parallel filtering
+ (see cv::applyFilterStripes()) creates a separate engine for every stripe
+ of the image, each with its own ring buffer.
+*/
+class FilterEngineFactory
+{
+public:
+    //! the destructor
+    virtual ~FilterEngineFactory();
+    //! creates a new filter engine instance
+    virtual Ptr<FilterEngine> createEngine() const = 0;
+};
+
+/*!
+ applies the filter engine to the ROI of the image, like FilterEngine::apply() does, splitting it into vertical tiles.
+
+ The tiles are narrow enough to keep the ring buffer of the engine in L2 cache, so the intermediate
+ rows of the large kernels are not evicted between the row and the column passes. The output is identical
+ to the processing of the whole ROI. The source and the destination images must not overlap.
+*/
+void applyFilterTiles(FilterEngine& f, const Mat& src, Mat& dst, const Size& wsz, const Point& ofs);
+
+//! returns the number of horizontal stripes, in which the image can be filtered in parallel.
+//! pixelCost is the number of the multiply-add operations per output pixel. 1 means the serial processing.
+int getFilterStripes(Size size, Size ksize, double pixelCost);
+
+/*!
+ applies the filter to the ROI of the image, like FilterEngine::apply() does, splitting it into nstripes horizontal stripes.
+
+ Every stripe is processed by its own engine (see cv::applyFilterTiles()), which starts at the ROI of the stripe within the whole image,
+ so the rows above and below the inner stripes are read from the source image, and only the stripes
+ at the top and at the bottom of the image extrapolate the border rows. The output is identical to the serial processing.
+ The source and the destination images must not overlap.
+*/
+void applyFilterStripes(const FilterEngineFactory& factory, const Mat& src, Mat& dst,
+                        const Size& wsz, const Point& ofs, int nstripes);
+
+/*!
+ applies the filter to the ROI of the image, like FilterEngine::apply() does, in parallel stripes or in tiles.
+
+ The engine f, created by the factory, is used for the tiles and, when the destination overlaps the source image
+ (e.g. the in-place filtering), for the serial processing. pixelCost is passed to cv::getFilterStripes().
+*/
+void applyFilter(const FilterEngineFactory& factory, FilterEngine& f, const Mat& src, Mat& dst,
+                 const Size& wsz, const Point& ofs, double pixelCost);
+
+
 //! returns type (one of KERNEL_*) of 1D or 2D kernel specified by its coefficients.
 int getKernelType(InputArray kernel, Point anchor);
 
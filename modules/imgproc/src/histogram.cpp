@@ -3684,6 +3684,8 @@ static bool ocl_equalizeHist(InputArray _src, OutputArray _dst)
 
 void cv::equalizeHist( InputArray _src, OutputArray _dst )
 {
+    CV_TRACE_FUNCTION();
+
     CV_Assert( _src.type() == CV_8UC1 );
 
     if (_src.empty())
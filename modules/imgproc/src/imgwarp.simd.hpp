@@ -0,0 +1,61 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+// No include guard: the kernels are compiled once per dispatched instruction set,
+// see ocv_add_dispatched_file() in cmake/OpenCVCompilerOptimizations.cmake.
+// The kernels return the number of processed elements, the tail is handled by the caller.
+
+#include "opencv2/core/hal/intrin.hpp"
+
+namespace cv {
+CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
+
+// vertical pass of the fixed-point bilinear resize:
+// dst[x] = (((beta[0]*(S0[x] >> 4)) >> 16) + ((beta[1]*(S1[x] >> 4)) >> 16) + 2) >> 2
+int vResizeLinear_simd(const int* S0, const int* S1, uchar* dst, const short* beta, int width);
+
+#ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+#if CV_SIMD
+// (a*b) >> 16
+static inline v_int16 vresize_mul_hi(const v_int16& a, const v_int16& b)
+{
+    v_int32 c, d;
+    v_mul_expand(a, b, c, d);
+    return v_pack(c >> 16, d >> 16);
+}
+#endif
+
+int vResizeLinear_simd(const int* S0, const int* S1, uchar* dst, const short* beta, int width)
+{
+    int x = 0;
+#if CV_SIMD
+    const int VECSZ = v_uint8::nlanes, NLANES32 = v_int32::nlanes;
+    v_int16 b0 = vx_setall_s16(beta[0]), b1 = vx_setall_s16(beta[1]);
+    v_int16 delta = vx_setall_s16(2);
+
+    for ( ; x <= width - VECSZ; x += VECSZ)
+    {
+        v_int16 x0 = v_pack(vx_load(S0 + x) >> 4, vx_load(S0 + x + NLANES32) >> 4);
+        v_int16 x1 = v_pack(vx_load(S0 + x + NLANES32*2) >> 4, vx_load(S0 + x + NLANES32*3) >> 4);
+        v_int16 y0 = v_pack(vx_load(S1 + x) >> 4, vx_load(S1 + x + NLANES32) >> 4);
+        v_int16 y1 = v_pack(vx_load(S1 + x + NLANES32*2) >> 4, vx_load(S1 + x + NLANES32*3) >> 4);
+
+        x0 = vresize_mul_hi(x0, b0) + vresize_mul_hi(y0, b1);
+        x1 = vresize_mul_hi(x1, b0) + vresize_mul_hi(y1, b1);
+
+        x0 = (x0 + delta) >> 2;
+        x1 = (x1 + delta) >> 2;
+        v_store(dst + x, v_pack_u(x0, x1));
+    }
+#else
+    (void)S0; (void)S1; (void)dst; (void)beta; (void)width;
+#endif
+    return x;
+}
+
+#endif // CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+CV_CPU_OPTIMIZATION_NAMESPACE_END
+} // namespace cv
@@ -43,6 +43,8 @@
 
 #include "precomp.hpp"
 #include "opencl_kernels_imgproc.hpp"
+#include "smooth.simd.hpp"
+#include "smooth.simd_declarations.hpp"
 
 /*
  * This file includes the code, contributed by Simon Perreault
@@ -1402,6 +1404,8 @@ void cv::boxFilter( InputArray _src, OutputArray _dst, int ddepth,
                 Size ksize, Point anchor,
                 bool normalize, int borderType )
 {
+    CV_TRACE_FUNCTION();
+
     CV_OCL_RUN(_dst.isUMat(), ocl_boxFilter(_src, _dst, ddepth, ksize, anchor, borderType, normalize))
 
     Mat src = _src.getMat();
@@ -1450,6 +1454,8 @@ void cv::boxFilter( InputArray _src, OutputArray _dst, int ddepth,
 void cv::blur( InputArray src, OutputArray dst,
            Size ksize, Point anchor, int borderType )
 {
+    CV_TRACE_FUNCTION();
+
     boxFilter( src, dst, -1, ksize, anchor, true, borderType );
 }
 
@@ -1657,6 +1663,175 @@ static void createGaussianKernels( Mat & kx, Mat & ky, int type, Size ksize,
         ky = getGaussianKernel( ksize.height, sigma2, std::max(depth, CV_32F) );
 }
 
+/*
+ The fixed-point Gaussian blur of 8u and 16u images.
+
+ The kernel coefficients are rounded to 8 (for 8u) or 16 (for 16u) fractional bits and the rounding error
+ is moved to the central coefficient, so the kernel sum is exactly 1. The row and the column passes
+ are computed in integers without overflow, so the result is the same with all the instruction sets,
+ numbers of threads and splittings of the image.
+
+ The 8u path rounds once, at the end of the column pass. The 16u row sums are halved with rounding
+ to 15 fractional bits, so the column pass can add the symmetrical rows before the multiplication.
+ That is a second rounding: it adds at most 2^-16 of a level to the error of the final one (0.5 level).
+*/
+
+// returns the central and the right coefficients of the symmetrical kernel with the sum of 1 << bits,
+// or the empty vector if the kernel is too flat to be represented with so few bits
+template<typename KT> static std::vector<KT> getGaussianKernelFixedPoint( const Mat& kernel, int bits )
+{
+    CV_Assert( kernel.type() == CV_32F );
+    int ksize2 = (int)kernel.total()/2;
+    const float* kf = kernel.ptr<float>() + ksize2;
+    std::vector<int> k(ksize2 + 1);
+    int sum = 0;
+
+    for( int i = 0; i <= ksize2; i++ )
+    {
+        k[i] = cvRound(kf[i]*(1 << bits));
+        sum += i == 0 ? k[i] : k[i]*2;
+    }
+
+    k[0] += (1 << bits) - sum;
+    if( k[0] < 0 )
+        return std::vector<KT>();
+    return std::vector<KT>(k.begin(), k.end());
+}
+
+static inline int gaussianRow( const uchar* src, ushort* dst, const ushort* kx, int ksize2, int width, int cn )
+{ return CV_CPU_DISPATCH(gaussianRow8u_simd, (src, dst, kx, ksize2, width, cn)); }
+
+static inline int gaussianRow( const ushort* src, unsigned* dst, const unsigned* kx, int ksize2, int width, int cn )
+{ return CV_CPU_DISPATCH(gaussianRow16u_simd, (src, dst, kx, ksize2, width, cn)); }
+
+static inline int gaussianColumn( const ushort** src, uchar* dst, const ushort* ky, int ksize2, int width )
+{ return CV_CPU_DISPATCH(gaussianColumn8u_simd, (src, dst, ky, ksize2, width)); }
+
+static inline int gaussianColumn( const unsigned** src, ushort* dst, const unsigned* ky, int ksize2, int width )
+{ return CV_CPU_DISPATCH(gaussianColumn16u_simd, (src, dst, ky, ksize2, width)); }
+
+template<typename T, typename BT, int shift>
+struct GaussianRowFilterFixedPoint :
+        public BaseRowFilter
+{
+    GaussianRowFilterFixedPoint( const std::vector<BT>& _kernel ) :
+        BaseRowFilter(), kernel(_kernel)
+    {
+        ksize = (int)kernel.size()*2 - 1;
+        anchor = ksize/2;
+    }
+
+    virtual void operator()(const uchar* _src, uchar* _dst, int width, int cn)
+    {
+        const T* src = (const T*)_src;
+        BT* dst = (BT*)_dst;
+        const BT* kx = &kernel[0];
+        int ksize2 = anchor;
+
+        width *= cn;
+        int i = gaussianRow(src, dst, kx, ksize2, width, cn);
+        for( ; i < width; i++ )
+        {
+            const T* S = src + i + ksize2*cn;
+            BT s = S[0]*kx[0];
+            for( int k = 1; k <= ksize2; k++ )
+                s += (S[-k*cn] + S[k*cn])*kx[k];
+            dst[i] = (BT)((s + ((1 << shift) >> 1)) >> shift);
+        }
+    }
+
+    std::vector<BT> kernel;
+};
+
+template<typename BT, typename WT, typename T, int shift>
+struct GaussianColumnFilterFixedPoint :
+        public BaseColumnFilter
+{
+    GaussianColumnFilterFixedPoint( const std::vector<BT>& _kernel ) :
+        BaseColumnFilter(), kernel(_kernel)
+    {
+        ksize = (int)kernel.size()*2 - 1;
+        anchor = ksize/2;
+    }
+
+    virtual void operator()(const uchar** _src, uchar* _dst, int dststep, int count, int width)
+    {
+        const BT** src = (const BT**)_src + anchor;
+        const BT* ky = &kernel[0];
+        int ksize2 = anchor;
+        const WT delta = (WT)1 << (shift - 1);
+
+        for( ; count--; _dst += dststep, src++ )
+        {
+            T* dst = (T*)_dst;
+            int i = gaussianColumn(src, dst, ky, ksize2, width);
+            for( ; i < width; i++ )
+            {
+                WT s = (WT)src[0][i]*ky[0] + delta;
+                for( int k = 1; k <= ksize2; k++ )
+                    s += ((WT)src[k][i] + src[-k][i])*ky[k];
+                dst[i] = (T)(s >> shift);
+            }
+        }
+    }
+
+    std::vector<BT> kernel;
+};
+
+// returns the fixed-point Gaussian filter engine, or the empty pointer
+// if the image depth or the kernels are not supported by it
+static Ptr<FilterEngine> createGaussianFilterFixedPoint( int type, const Mat& kx, const Mat& ky, int borderType )
+{
+    int depth = CV_MAT_DEPTH(type), cn = CV_MAT_CN(type);
+
+    if( depth == CV_8U && kx.type() == CV_32F && ky.type() == CV_32F )
+    {
+        std::vector<ushort> hx = getGaussianKernelFixedPoint<ushort>(kx, 8);
+        std::vector<ushort> hy = getGaussianKernelFixedPoint<ushort>(ky, 8);
+        if( hx.empty() || hy.empty() )
+            return Ptr<FilterEngine>();
+        return makePtr<FilterEngine>(Ptr<BaseFilter>(),
+            makePtr<GaussianRowFilterFixedPoint<uchar, ushort, 0> >(hx),
+            makePtr<GaussianColumnFilterFixedPoint<ushort, unsigned, uchar, 16> >(hy),
+            type, type, CV_MAKETYPE(CV_16U, cn), borderType );
+    }
+
+    if( depth == CV_16U && kx.type() == CV_32F && ky.type() == CV_32F )
+    {
+        std::vector<unsigned> hx = getGaussianKernelFixedPoint<unsigned>(kx, 16);
+        std::vector<unsigned> hy = getGaussianKernelFixedPoint<unsigned>(ky, 16);
+        if( hx.empty() || hy.empty() )
+            return Ptr<FilterEngine>();
+        // there is no 32u type, the ring buffer keeps the unsigned sums in the 32s rows
+        return makePtr<FilterEngine>(Ptr<BaseFilter>(),
+            makePtr<GaussianRowFilterFixedPoint<ushort, unsigned, 1> >(hx),
+            makePtr<GaussianColumnFilterFixedPoint<unsigned, uint64, ushort, 31> >(hy),
+            type, type, CV_MAKETYPE(CV_32S, cn), borderType );
+    }
+
+    return Ptr<FilterEngine>();
+}
+
+class GaussianFilterFixedPointFactory :
+        public FilterEngineFactory
+{
+public:
+    GaussianFilterFixedPointFactory( int _type, const Mat& _kx, const Mat& _ky, int _borderType ) :
+        type(_type), kx(_kx), ky(_ky), borderType(_borderType)
+    {
+    }
+
+    Ptr<FilterEngine> createEngine() const
+    {
+        return createGaussianFilterFixedPoint(type, kx, ky, borderType);
+    }
+
+private:
+    int type;
+    Mat kx, ky;
+    int borderType;
+};
+
 }
 
 cv::Ptr<cv::FilterEngine> cv::createGaussianFilter( int type, Size ksize,
@@ -1666,6 +1841,10 @@ cv::Ptr<cv::FilterEngine> cv::createGaussianFilter( int type, Size ksize,
     Mat kx, ky;
     createGaussianKernels(kx, ky, type, ksize, sigma1, sigma2);
 
+    Ptr<FilterEngine> f = createGaussianFilterFixedPoint(type, kx, ky, borderType);
+    if( f )
+        return f;
+
     return createSeparableLinearFilter( type, type, kx, ky, Point(-1,-1), 0, borderType );
 }
 
@@ -1768,6 +1947,8 @@ void cv::GaussianBlur( InputArray _src, OutputArray _dst, Size ksize,
                    double sigma1, double sigma2,
                    int borderType )
 {
+    CV_TRACE_FUNCTION();
+
     int type = _src.type();
     Size size = _src.size();
     _dst.create( size, type );
@@ -1786,6 +1967,28 @@ void cv::GaussianBlur( InputArray _src, OutputArray _dst, Size ksize,
         return;
     }
 
+    Mat kx, ky;
+    createGaussianKernels(kx, ky, type, ksize, sigma1, sigma2);
+
+    // the bit-exact fixed-point path goes first, so 8u and 16u results do not depend on the platform
+    int depth = CV_MAT_DEPTH(type);
+    if( (depth == CV_8U || depth == CV_16U) && !(_dst.isUMat() && ocl::useOpenCL()) )
+    {
+        GaussianFilterFixedPointFactory factory(type, kx, ky, borderType & ~BORDER_ISOLATED);
+        Ptr<FilterEngine> f = factory.createEngine();
+        if( f )
+        {
+            Mat src = _src.getMat(), dst = _dst.getMat();
+            Point ofs;
+            Size wsz(src.cols, src.rows);
+            if( (borderType & BORDER_ISOLATED) == 0 )
+                src.locateROI( wsz, ofs );
+
+            applyFilter(factory, *f, src, dst, wsz, ofs, (double)(f->ksize.width + f->ksize.height));
+            return;
+        }
+    }
+
 #ifdef HAVE_TEGRA_OPTIMIZATION
     Mat src = _src.getMat();
     Mat dst = _dst.getMat();
@@ -1795,8 +1998,6 @@ void cv::GaussianBlur( InputArray _src, OutputArray _dst, Size ksize,
 
     CV_IPP_RUN(true, ipp_GaussianBlur( _src,  _dst,  ksize, sigma1,  sigma2, borderType));
 
-    Mat kx, ky;
-    createGaussianKernels(kx, ky, type, ksize, sigma1, sigma2);
     sepFilter2D(_src, _dst, CV_MAT_DEPTH(type), kx, ky, Point(-1,-1), 0, borderType );
 }
 
@@ -2651,6 +2852,263 @@ medianBlur_SortNet( const Mat& _src, Mat& _dst, int m )
     }
 }
 
+// Large-aperture median for 16u, 16s and 32f images. The 8u histogram-based filters can not be used
+// for them directly, so the image is processed by tiles and the pixels of each (bordered) tile are
+// replaced with their ranks within the tile. The median of the ranks is tracked by the sliding (Huang)
+// histogram of the tile size, which moves over the tile in zig-zag order
+// and costs O(ksize) operations per pixel.
+
+template<typename T> struct MedianRankKey;
+
+template<> struct MedianRankKey<ushort>
+{
+    enum { bits = 16 };
+    unsigned operator()(ushort v) const { return v; }
+};
+
+template<> struct MedianRankKey<short>
+{
+    enum { bits = 16 };
+    unsigned operator()(short v) const { return (ushort)v ^ 0x8000u; }
+};
+
+template<> struct MedianRankKey<float>
+{
+    enum { bits = 32 };
+    // the order of the keys is the order of the values
+    unsigned operator()(float v) const
+    {
+        Cv32suf u;
+        u.f = v;
+        return u.i < 0 ? ~(unsigned)u.i : (unsigned)u.i | 0x80000000u;
+    }
+};
+
+// The ranks are distinct, so the histogram is a bit set with the numbers of the ranks in each 64-bit word
+class MedianRankHistogram
+{
+public:
+    void init(int nbins)
+    {
+        int nwords = (nbins >> 6) + 1;
+        bits.allocate(nwords);
+        counts.allocate(nwords);
+        memset((uint64*)bits, 0, nwords*sizeof(bits[0]));
+        memset((int*)counts, 0, nwords*sizeof(counts[0]));
+        c = below = 0;
+    }
+
+    void add(int r)
+    {
+        int k = r >> 6;
+        bits[k] |= (uint64)1 << (r & 63);
+        counts[k]++;
+        below += k < c;
+    }
+
+    void remove(int r)
+    {
+        int k = r >> 6;
+        bits[k] &= ~((uint64)1 << (r & 63));
+        counts[k]--;
+        below -= k < c;
+    }
+
+    // returns the rank that has n smaller ranks in the histogram
+    int nth(int n)
+    {
+        // 'below' is the number of ranks in the words left to c
+        while( below > n )
+            below -= counts[--c];
+        while( below + counts[c] <= n )
+            below += counts[c++];
+        uint64 w = bits[c];
+        for( int k = n - below; k > 0; k-- )
+            w &= w - 1;
+        return (c << 6) + trailingZeros(w);
+    }
+
+protected:
+    static int trailingZeros(uint64 w)
+    {
+#if defined __GNUC__
+        return __builtin_ctzll(w);
+#else
+        int i = 0;
+        for( ; (w & 255) == 0; w >>= 8 )
+            i += 8;
+        for( ; (w & 1) == 0; w >>= 1 )
+            i++;
+        return i;
+#endif
+    }
+
+    AutoBuffer<uint64> bits;
+    AutoBuffer<int> counts;
+    int c, below;
+};
+
+template<typename T>
+class MedianBlurRankInvoker : public ParallelLoopBody
+{
+public:
+    MedianBlurRankInvoker(const Mat& _src, Mat& _dst, int _ksize, int _tileSize) :
+        src(&_src), dst(&_dst), ksize(_ksize), tileSize(_tileSize)
+    {
+        tilesX = (src->cols + tileSize - 1)/tileSize;
+    }
+
+    virtual void operator() (const Range& range) const
+    {
+        const int r = ksize/2, cn = src->channels();
+        const int extSize = tileSize + ksize - 1, N = extSize*extSize;
+        const int bits = MedianRankKey<T>::bits;
+        MedianRankKey<T> getKey;
+
+        AutoBuffer<unsigned> _keys(N*2);
+        AutoBuffer<int> _idx(N*2), _ranks(N), _xofs(extSize);
+        AutoBuffer<T> _vals(N), _sorted(N);
+        AutoBuffer<int> _hist(256*(bits/8));
+        unsigned *keys = _keys, *keys1 = keys + N;
+        int *idx = _idx, *idx1 = idx + N, *ranks = _ranks, *xofs = _xofs, *hist = _hist;
+        T *vals = _vals, *sorted = _sorted;
+        MedianRankHistogram h;
+
+        for( int t = range.start; t < range.end; t++ )
+        {
+            int x0 = (t % tilesX)*tileSize, y0 = (t / tilesX)*tileSize;
+            int tw = std::min(tileSize, src->cols - x0), th = std::min(tileSize, src->rows - y0);
+            int ew = tw + ksize - 1, eh = th + ksize - 1, n = ew*eh;
+
+            for( int x = 0; x < ew; x++ )
+                xofs[x] = std::min(std::max(x0 + x - r, 0), src->cols - 1)*cn;
+
+            for( int c = 0; c < cn; c++ )
+            {
+                // gather the bordered tile and compute the digit histograms of the keys
+                memset(hist, 0, 256*(bits/8)*sizeof(hist[0]));
+                for( int y = 0, k = 0; y < eh; y++ )
+                {
+                    const T* sptr = src->ptr<T>(std::min(std::max(y0 + y - r, 0), src->rows - 1)) + c;
+                    for( int x = 0; x < ew; x++, k++ )
+                    {
+                        T v = sptr[xofs[x]];
+                        unsigned key = getKey(v);
+                        vals[k] = v;
+                        keys[k] = key;
+                        idx[k] = k;
+                        for( int d = 0; d < bits/8; d++ )
+                            hist[d*256 + ((key >> d*8) & 255)]++;
+                    }
+                }
+
+                // stable LSD radix sort of the keys; the passes where all the digits are the same are skipped
+                unsigned *skeys = keys, *dkeys = keys1;
+                int *sidx = idx, *didx = idx1;
+                for( int d = 0; d < bits/8; d++ )
+                {
+                    int* dh = hist + d*256;
+                    if( dh[(skeys[0] >> d*8) & 255] == n )
+                        continue;
+                    for( int i = 0, sum = 0; i < 256; i++ )
+                    {
+                        int cnt = dh[i];
+                        dh[i] = sum;
+                        sum += cnt;
+                    }
+                    for( int i = 0; i < n; i++ )
+                    {
+                        unsigned key = skeys[i];
+                        int pos = dh[(key >> d*8) & 255]++;
+                        dkeys[pos] = key;
+                        didx[pos] = sidx[i];
+                    }
+                    std::swap(skeys, dkeys);
+                    std::swap(sidx, didx);
+                }
+
+                for( int i = 0; i < n; i++ )
+                {
+                    ranks[sidx[i]] = i;
+                    sorted[i] = vals[sidx[i]];
+                }
+
+                // slide the window over the tile: left to right on the even rows and back on the odd ones
+                const int m = ksize, half = m*m/2;
+                h.init(n);
+                for( int y = 0; y < m; y++ )
+                    for( int x = 0; x < m; x++ )
+                        h.add(ranks[y*ew + x]);
+
+                for( int y = 0, x = 0; y < th; y++ )
+                {
+                    T* dptr = dst->ptr<T>(y0 + y) + x0*cn + c;
+                    if( y > 0 )
+                    {
+                        const int *rtop = ranks + (y - 1)*ew + x, *rbottom = rtop + m*ew;
+                        for( int k = 0; k < m; k++ )
+                        {
+                            h.remove(rtop[k]);
+                            h.add(rbottom[k]);
+                        }
+                    }
+                    dptr[x*cn] = sorted[h.nth(half)];
+
+                    if( y % 2 == 0 )
+                    {
+                        for( ; x < tw - 1; x++ )
+                        {
+                            const int* rp = ranks + y*ew + x;
+                            for( int k = 0; k < m; k++, rp += ew )
+                            {
+                                h.remove(rp[0]);
+                                h.add(rp[m]);
+                            }
+                            dptr[(x + 1)*cn] = sorted[h.nth(half)];
+                        }
+                    }
+                    else
+                    {
+                        for( ; x > 0; x-- )
+                        {
+                            const int* rp = ranks + y*ew + x - 1;
+                            for( int k = 0; k < m; k++, rp += ew )
+                            {
+                                h.remove(rp[m]);
+                                h.add(rp[0]);
+                            }
+                            dptr[(x - 1)*cn] = sorted[h.nth(half)];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    const Mat* src;
+    Mat* dst;
+    int ksize, tileSize, tilesX;
+};
+
+static void
+medianBlur_Rank( const Mat& src, Mat& dst, int ksize )
+{
+    CV_Assert( src.depth() == CV_16U || src.depth() == CV_16S || src.depth() == CV_32F );
+
+    // larger tiles reduce the overhead of the tile borders, smaller ones keep the histogram in cache
+    int tileSize = std::min(std::max(32, ksize*4), 256);
+    int tilesX = (src.cols + tileSize - 1)/tileSize, tilesY = (src.rows + tileSize - 1)/tileSize;
+    Range range(0, tilesX*tilesY);
+
+    if( src.depth() == CV_16U )
+        parallel_for_(range, MedianBlurRankInvoker<ushort>(src, dst, ksize, tileSize));
+    else if( src.depth() == CV_16S )
+        parallel_for_(range, MedianBlurRankInvoker<short>(src, dst, ksize, tileSize));
+    else
+        parallel_for_(range, MedianBlurRankInvoker<float>(src, dst, ksize, tileSize));
+}
+
 #ifdef HAVE_OPENCL
 
 static bool ocl_medianFilter(InputArray _src, OutputArray _dst, int m)
@@ -2767,6 +3225,8 @@ static bool ipp_medianFilter( InputArray _src0, OutputArray _dst, int ksize )
 
 void cv::medianBlur( InputArray _src0, OutputArray _dst, int ksize )
 {
+    CV_TRACE_FUNCTION();
+
     CV_Assert( (ksize % 2 == 1) && (_src0.dims() <= 2 ));
 
     if( ksize <= 1 )
@@ -2816,6 +3276,15 @@ void cv::medianBlur( InputArray _src0, OutputArray _dst, int ksize )
 
         return;
     }
+    else if( src0.depth() != CV_8U )
+    {
+        if( dst.data != src0.data )
+            src = src0;
+        else
+            src0.copyTo(src);
+
+        medianBlur_Rank( src, dst, ksize );
+    }
     else
     {
         cv::copyMakeBorder( src0, src, 0, 0, ksize/2, ksize/2, BORDER_REPLICATE );
@@ -3491,20 +3960,482 @@ bilateralFilter_32f( const Mat& src, Mat& dst, int d,
     parallel_for_(Range(0, size.height), body, dst.total()/(double)(1<<16));
 }
 
+/****************************************************************************************\
+                  Approximate Bilateral Filtering with the Permutohedral Lattice
+\****************************************************************************************/
+
+// A. Adams, J. Baek, M. A. Davis. Fast High-Dimensional Filtering Using the Permutohedral Lattice.
+// The pixels are embedded into the (2 + cn)-dimensional space of (x/sigma_space, y/sigma_space,
+// color/sigma_color), splatted to the vertices of the enclosing simplices of the lattice, the lattice
+// is blurred along each of its d + 1 axes and the result is sliced back at the pixel positions.
+// The lattice is sparse and its size decreases with the sigmas, so the cost does not grow with the
+// kernel size.
+
+class BilateralLattice
+{
+public:
+    BilateralLattice(int _d, int _vd) : d(_d), vd(_vd), count(0), table(64, -1) {}
+
+    int size() const { return count; }
+    const int* key(int i) const { return &keys[i*d]; }
+
+    // returns the index of the lattice point or -1 if there is no such point
+    int find(const int* k) const
+    {
+        size_t mask = table.size() - 1;
+        for( size_t h = hash(k) & mask; ; h = (h + 1) & mask )
+        {
+            int i = table[h];
+            if( i < 0 || equal(key(i), k) )
+                return i;
+        }
+    }
+
+    // returns the index of the lattice point, the new points have zero values
+    int insert(const int* k)
+    {
+        if( (size_t)count*2 >= table.size() )
+            grow();
+        size_t mask = table.size() - 1;
+        for( size_t h = hash(k) & mask; ; h = (h + 1) & mask )
+        {
+            int i = table[h];
+            if( i >= 0 && !equal(key(i), k) )
+                continue;
+            if( i < 0 )
+            {
+                table[h] = i = count++;
+                keys.insert(keys.end(), k, k + d);
+                values.resize(values.size() + vd, 0.f);
+            }
+            return i;
+        }
+    }
+
+    std::vector<float> values;
+
+private:
+    size_t hash(const int* k) const
+    {
+        uint64 h = 0;
+        for( int i = 0; i < d; i++ )
+        {
+            h += (unsigned)k[i];
+            h *= 2531011;
+        }
+        // the coordinates of the lattice points are congruent modulo d + 1,
+        // so the higher bits are mixed into the lower ones used by the table
+        h ^= h >> 33;
+        h *= CV_BIG_UINT(0xff51afd7ed558ccd);
+        h ^= h >> 33;
+        return (size_t)h;
+    }
+
+    bool equal(const int* a, const int* b) const
+    {
+        for( int i = 0; i < d; i++ )
+            if( a[i] != b[i] )
+                return false;
+        return true;
+    }
+
+    void grow()
+    {
+        std::vector<int> t(table.size()*2, -1);
+        size_t mask = t.size() - 1;
+        for( int i = 0; i < count; i++ )
+        {
+            size_t h = hash(key(i)) & mask;
+            while( t[h] >= 0 )
+                h = (h + 1) & mask;
+            t[h] = i;
+        }
+        table.swap(t);
+    }
+
+    int d, vd, count;
+    std::vector<int> keys;
+    std::vector<int> table;
+};
+
+class BilateralLatticeEmbedding
+{
+public:
+    enum { MAX_DIMS = 5 };
+
+    explicit BilateralLatticeEmbedding(int _d) : d(_d)
+    {
+        CV_Assert( d <= MAX_DIMS );
+        // with this scale the blur of the lattice approximates the Gaussian with unit sigma
+        double invStdDev = (d + 1)*std::sqrt(2./3);
+        for( int i = 0; i < d; i++ )
+            scale[i] = (float)(invStdDev/std::sqrt((double)(i + 1)*(i + 2)));
+    }
+
+    // finds the enclosing simplex of the point f and the barycentric coordinates in it;
+    // the simplex is given by the closest remainder-0 point and the ranks of the coordinates
+    void operator()(const float* f, int* simplex, float* bary) const
+    {
+        float elevated[MAX_DIMS + 1];
+        int *rem0 = simplex, *rank = simplex + d + 1;
+        const float invd1 = 1.f/(d + 1);
+
+        // the hyperplane sum(x) = 0 of the (d + 1)-dimensional space
+        float sm = 0;
+        for( int j = d; j > 0; j-- )
+        {
+            float cf = f[j - 1]*scale[j - 1];
+            elevated[j] = sm - j*cf;
+            sm += cf;
+        }
+        elevated[0] = sm;
+
+        // the closest remainder-0 point
+        int sum = 0;
+        for( int i = 0; i <= d; i++ )
+        {
+            int down = cvFloor(elevated[i]*invd1)*(d + 1), up = down + d + 1;
+            rem0[i] = up - elevated[i] < elevated[i] - down ? up : down;
+            sum += rem0[i];
+        }
+        sum /= d + 1;
+
+        for( int i = 0; i <= d; i++ )
+            rank[i] = 0;
+        for( int i = 0; i < d; i++ )
+        {
+            float di = elevated[i] - rem0[i];
+            for( int j = i + 1; j <= d; j++ )
+            {
+                // branchless, the comparisons are unpredictable on the noisy images
+                int b = di < elevated[j] - rem0[j];
+                rank[i] += b;
+                rank[j] += b ^ 1;
+            }
+        }
+
+        // the coordinates of the remainder-0 point should sum to 0
+        for( int i = 0; i <= d; i++ )
+        {
+            rank[i] += sum;
+            if( rank[i] < 0 )
+            {
+                rank[i] += d + 1;
+                rem0[i] += d + 1;
+            }
+            else if( rank[i] > d )
+            {
+                rank[i] -= d + 1;
+                rem0[i] -= d + 1;
+            }
+        }
+
+        for( int i = 0; i <= d + 1; i++ )
+            bary[i] = 0.f;
+        for( int i = 0; i <= d; i++ )
+        {
+            float v = (elevated[i] - rem0[i])*invd1;
+            bary[d - rank[i]] += v;
+            bary[d - rank[i] + 1] -= v;
+        }
+        bary[0] += 1.f + bary[d + 1];
+    }
+
+    // the key of the vertex with the given remainder, the last coordinate is omitted
+    void vertex(const int* simplex, int remainder, int* key) const
+    {
+        const int *rem0 = simplex, *rank = simplex + d + 1;
+        for( int i = 0; i < d; i++ )
+            key[i] = rem0[i] + (rank[i] <= d - remainder ? remainder : remainder - (d + 1));
+    }
+
+    int simplexSize() const { return (d + 1)*2; }
+
+    int d;
+    float scale[MAX_DIMS];
+};
+
+template<typename T> static inline void
+bilateralLatticeFeatures( const T* p, int x, int y, int cn, float invSpace, float invColor,
+                          float nanValue, float* f, float* v )
+{
+    f[0] = x*invSpace;
+    f[1] = y*invSpace;
+    for( int c = 0; c < cn; c++ )
+    {
+        float val = (float)p[c];
+        if( cvIsNaN(val) )
+            val = nanValue;
+        f[c + 2] = val*invColor;
+        v[c] = val;
+    }
+    v[cn] = 1.f;
+}
+
+template<typename T>
+class BilateralLatticeSplat_Invoker : public ParallelLoopBody
+{
+public:
+    BilateralLatticeSplat_Invoker(const Mat& _src, std::vector<BilateralLattice>& _lattices, int _stripeRows,
+                                  float _invSpace, float _invColor, float _nanValue) :
+        src(&_src), lattices(&_lattices), stripeRows(_stripeRows),
+        invSpace(_invSpace), invColor(_invColor), nanValue(_nanValue)
+    {
+    }
+
+    virtual void operator() (const Range& range) const
+    {
+        const int cn = src->channels(), d = cn + 2, vd = cn + 1;
+        BilateralLatticeEmbedding embed(d);
+        int simplex[(BilateralLatticeEmbedding::MAX_DIMS + 1)*2], prev[(BilateralLatticeEmbedding::MAX_DIMS + 1)*2];
+        int key[BilateralLatticeEmbedding::MAX_DIMS], idx[BilateralLatticeEmbedding::MAX_DIMS + 1];
+        float f[BilateralLatticeEmbedding::MAX_DIMS], v[4], bary[BilateralLatticeEmbedding::MAX_DIMS + 2];
+        size_t simplexSize = embed.simplexSize()*sizeof(simplex[0]);
+
+        for( int s = range.start; s < range.end; s++ )
+        {
+            BilateralLattice& lattice = (*lattices)[s];
+            bool havePrev = false;
+            int y1 = std::min((s + 1)*stripeRows, src->rows);
+            for( int y = s*stripeRows; y < y1; y++ )
+            {
+                const T* sptr = src->ptr<T>(y);
+                for( int x = 0; x < src->cols; x++, sptr += cn )
+                {
+                    bilateralLatticeFeatures(sptr, x, y, cn, invSpace, invColor, nanValue, f, v);
+                    embed(f, simplex, bary);
+
+                    // the neighbor pixels often fall into the same simplex
+                    if( !havePrev || memcmp(simplex, prev, simplexSize) != 0 )
+                    {
+                        for( int r = 0; r <= d; r++ )
+                        {
+                            embed.vertex(simplex, r, key);
+                            idx[r] = lattice.insert(key);
+                        }
+                        memcpy(prev, simplex, simplexSize);
+                        havePrev = true;
+                    }
+
+                    for( int r = 0; r <= d; r++ )
+                    {
+                        float* val = &lattice.values[idx[r]*vd];
+                        for( int c = 0; c < vd; c++ )
+                            val[c] += v[c]*bary[r];
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    const Mat* src;
+    std::vector<BilateralLattice>* lattices;
+    int stripeRows;
+    float invSpace, invColor, nanValue;
+};
+
+class BilateralLatticeBlur_Invoker : public ParallelLoopBody
+{
+public:
+    BilateralLatticeBlur_Invoker(const BilateralLattice& _lattice, int _d, int _vd, int _axis,
+                                 const float* _src, float* _dst) :
+        lattice(&_lattice), d(_d), vd(_vd), axis(_axis), src(_src), dst(_dst)
+    {
+    }
+
+    virtual void operator() (const Range& range) const
+    {
+        int n1[BilateralLatticeEmbedding::MAX_DIMS], n2[BilateralLatticeEmbedding::MAX_DIMS];
+
+        for( int i = range.start; i < range.end; i++ )
+        {
+            // the neighbors along the axis differ by (d + 1) in the axis coordinate and by 1 in the others
+            const int* key = lattice->key(i);
+            for( int k = 0; k < d; k++ )
+            {
+                n1[k] = key[k] - 1;
+                n2[k] = key[k] + 1;
+            }
+            if( axis < d )
+            {
+                n1[axis] = key[axis] + d;
+                n2[axis] = key[axis] - d;
+            }
+
+            int i1 = lattice->find(n1), i2 = lattice->find(n2);
+            const float* s0 = src + i*vd;
+            float* dptr = dst + i*vd;
+            for( int c = 0; c < vd; c++ )
+                dptr[c] = s0[c]*2.f;
+            if( i1 >= 0 )
+                for( int c = 0; c < vd; c++ )
+                    dptr[c] += src[i1*vd + c];
+            if( i2 >= 0 )
+                for( int c = 0; c < vd; c++ )
+                    dptr[c] += src[i2*vd + c];
+        }
+    }
+
+private:
+    const BilateralLattice* lattice;
+    int d, vd, axis;
+    const float* src;
+    float* dst;
+};
+
+template<typename T>
+class BilateralLatticeSlice_Invoker : public ParallelLoopBody
+{
+public:
+    BilateralLatticeSlice_Invoker(const Mat& _src, Mat& _dst, const BilateralLattice& _lattice,
+                                  float _invSpace, float _invColor, float _nanValue) :
+        src(&_src), dst(&_dst), lattice(&_lattice),
+        invSpace(_invSpace), invColor(_invColor), nanValue(_nanValue)
+    {
+    }
+
+    virtual void operator() (const Range& range) const
+    {
+        const int cn = src->channels(), d = cn + 2, vd = cn + 1;
+        BilateralLatticeEmbedding embed(d);
+        int simplex[(BilateralLatticeEmbedding::MAX_DIMS + 1)*2], prev[(BilateralLatticeEmbedding::MAX_DIMS + 1)*2];
+        int key[BilateralLatticeEmbedding::MAX_DIMS], idx[BilateralLatticeEmbedding::MAX_DIMS + 1];
+        float f[BilateralLatticeEmbedding::MAX_DIMS], v[4], bary[BilateralLatticeEmbedding::MAX_DIMS + 2];
+        size_t simplexSize = embed.simplexSize()*sizeof(simplex[0]);
+        const float* values = &lattice->values[0];
+
+        for( int y = range.start; y < range.end; y++ )
+        {
+            bool havePrev = false;
+            const T* sptr = src->ptr<T>(y);
+            T* dptr = dst->ptr<T>(y);
+            for( int x = 0; x < src->cols; x++, sptr += cn, dptr += cn )
+            {
+                bilateralLatticeFeatures(sptr, x, y, cn, invSpace, invColor, nanValue, f, v);
+                embed(f, simplex, bary);
+
+                if( !havePrev || memcmp(simplex, prev, simplexSize) != 0 )
+                {
+                    for( int r = 0; r <= d; r++ )
+                    {
+                        embed.vertex(simplex, r, key);
+                        idx[r] = lattice->find(key);
+                    }
+                    memcpy(prev, simplex, simplexSize);
+                    havePrev = true;
+                }
+
+                float sum[4] = { 0.f, 0.f, 0.f, 0.f };
+                for( int r = 0; r <= d; r++ )
+                {
+                    int i = idx[r];
+                    if( i < 0 )
+                        continue;
+                    for( int c = 0; c < vd; c++ )
+                        sum[c] += values[i*vd + c]*bary[r];
+                }
+
+                // the pixel itself contributes to the vertices, so the weight is positive
+                float scale = 1.f/sum[cn];
+                for( int c = 0; c < cn; c++ )
+                    dptr[c] = saturate_cast<T>(sum[c]*scale);
+            }
+        }
+    }
+
+private:
+    const Mat* src;
+    Mat* dst;
+    const BilateralLattice* lattice;
+    float invSpace, invColor, nanValue;
+};
+
+static void
+bilateralFilter_Lattice( const Mat& src, Mat& dst, double sigma_color, double sigma_space )
+{
+    int cn = src.channels(), d = cn + 2, vd = cn + 1;
+
+    CV_Assert( src.type() == CV_8UC1 || src.type() == CV_8UC3 ||
+               src.type() == CV_32FC1 || src.type() == CV_32FC3 );
+
+    if( src.empty() )
+        return;
+
+    if( sigma_color <= 0 )
+        sigma_color = 1;
+    if( sigma_space <= 0 )
+        sigma_space = 1;
+
+    float invSpace = (float)(1./sigma_space), invColor = (float)(1./sigma_color);
+    // the same replacement of NaNs as in bilateralFilter_32f
+    float nanValue = (float)(-5.*sigma_color);
+
+    // the stripes are built independently and merged in order, so the result does not depend
+    // on the number of threads
+    int stripeRows = std::max((1 << 17)/std::max(src.cols, 1), 1);
+    int nstripes = (src.rows + stripeRows - 1)/stripeRows;
+    std::vector<BilateralLattice> lattices(nstripes, BilateralLattice(d, vd));
+
+    if( src.depth() == CV_8U )
+        parallel_for_(Range(0, nstripes), BilateralLatticeSplat_Invoker<uchar>(src, lattices, stripeRows,
+                                                                               invSpace, invColor, nanValue));
+    else
+        parallel_for_(Range(0, nstripes), BilateralLatticeSplat_Invoker<float>(src, lattices, stripeRows,
+                                                                               invSpace, invColor, nanValue));
+
+    BilateralLattice& lattice = lattices[0];
+    for( int s = 1; s < nstripes; s++ )
+    {
+        const BilateralLattice& l = lattices[s];
+        for( int i = 0; i < l.size(); i++ )
+        {
+            float* val = &lattice.values[lattice.insert(l.key(i))*vd];
+            for( int c = 0; c < vd; c++ )
+                val[c] += l.values[i*vd + c];
+        }
+        lattices[s] = BilateralLattice(d, vd);
+    }
+
+    std::vector<float> buf(lattice.values.size());
+    for( int axis = 0; axis <= d; axis++ )
+    {
+        parallel_for_(Range(0, lattice.size()),
+                      BilateralLatticeBlur_Invoker(lattice, d, vd, axis, &lattice.values[0], &buf[0]),
+                      lattice.size()/(double)(1 << 14));
+        lattice.values.swap(buf);
+    }
+
+    if( src.depth() == CV_8U )
+        parallel_for_(Range(0, src.rows), BilateralLatticeSlice_Invoker<uchar>(src, dst, lattice,
+                                                                               invSpace, invColor, nanValue),
+                      dst.total()/(double)(1 << 16));
+    else
+        parallel_for_(Range(0, src.rows), BilateralLatticeSlice_Invoker<float>(src, dst, lattice,
+                                                                               invSpace, invColor, nanValue),
+                      dst.total()/(double)(1 << 16));
+}
+
 }
 
 void cv::bilateralFilter( InputArray _src, OutputArray _dst, int d,
                       double sigmaColor, double sigmaSpace,
-                      int borderType )
+                      int borderType, int mode )
 {
+    CV_TRACE_FUNCTION();
+
+    CV_Assert( mode == BILATERAL_EXACT || mode == BILATERAL_APPROX );
+
     _dst.create( _src.size(), _src.type() );
 
-    CV_OCL_RUN(_src.dims() <= 2 && _dst.isUMat(),
+    CV_OCL_RUN(mode == BILATERAL_EXACT && _src.dims() <= 2 && _dst.isUMat(),
                ocl_bilateralFilter_8u(_src, _dst, d, sigmaColor, sigmaSpace, borderType))
 
     Mat src = _src.getMat(), dst = _dst.getMat();
 
-    if( src.depth() == CV_8U )
+    if( mode == BILATERAL_APPROX )
+        bilateralFilter_Lattice( src, dst, sigmaColor, sigmaSpace );
+    else if( src.depth() == CV_8U )
         bilateralFilter_8u( src, dst, d, sigmaColor, sigmaSpace, borderType );
     else if( src.depth() == CV_32F )
         bilateralFilter_32f( src, dst, d, sigmaColor, sigmaSpace, borderType );
@@ -3513,6 +4444,13 @@ void cv::bilateralFilter( InputArray _src, OutputArray _dst, int d,
         "Bilateral filtering is only implemented for 8u and 32f images" );
 }
 
+void cv::bilateralFilter( InputArray _src, OutputArray _dst, int d,
+                      double sigmaColor, double sigmaSpace,
+                      int borderType )
+{
+    bilateralFilter( _src, _dst, d, sigmaColor, sigmaSpace, borderType, BILATERAL_EXACT );
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 
 CV_IMPL void
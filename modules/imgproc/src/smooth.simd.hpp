@@ -0,0 +1,142 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+// No include guard: the kernels are compiled once per dispatched instruction set,
+// see ocv_add_dispatched_file() in cmake/OpenCVCompilerOptimizations.cmake.
+// The kernels return the number of processed elements, the tail is handled by the caller.
+
+#include "opencv2/core/hal/intrin.hpp"
+
+namespace cv {
+CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
+
+// The fixed-point Gaussian blur: the symmetrical non-negative kernels are given by the halves,
+// kx[0] and ky[0] are the central coefficients. All the computations are done in integers,
+// so the results are the same with all the instruction sets and with the scalar code.
+
+// 8u -> 16u with Q8 kernel: dst[i] = sum(src[i + (k + ksize2)*cn]*kx[|k|], k = -ksize2..ksize2)
+int gaussianRow8u_simd(const uchar* src, ushort* dst, const ushort* kx, int ksize2, int width, int cn);
+// 16u -> 32u with Q16 kernel, the sums are rounded to Q15 (halved), so the sum of two rows fits into 32 bits
+// and the column filter adds the symmetrical rows before the multiplication. This is the first of the two
+// roundings of the 16u path, the scalar code rounds the same way
+int gaussianRow16u_simd(const ushort* src, unsigned* dst, const unsigned* kx, int ksize2, int width, int cn);
+
+// src points to the central row; 16u (Q8) -> 8u with Q8 kernel and 32u (Q15) -> 16u with Q16 kernel,
+// the sums are rounded to the nearest
+int gaussianColumn8u_simd(const ushort** src, uchar* dst, const ushort* ky, int ksize2, int width);
+int gaussianColumn16u_simd(const unsigned** src, ushort* dst, const unsigned* ky, int ksize2, int width);
+
+#ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+int gaussianRow8u_simd(const uchar* src, ushort* dst, const ushort* kx, int ksize2, int width, int cn)
+{
+    int i = 0;
+#if CV_SIMD
+    const int VECSZ = v_uint16::nlanes;
+
+    // the kernel sum is 256, so neither the partial nor the full sums overflow 16 bits
+    for ( ; i <= width - VECSZ; i += VECSZ)
+    {
+        const uchar* S = src + i + ksize2*cn;
+        v_uint16 s = vx_load_expand(S)*vx_setall_u16(kx[0]);
+
+        for (int k = 1; k <= ksize2; k++)
+            s += (vx_load_expand(S - k*cn) + vx_load_expand(S + k*cn))*vx_setall_u16(kx[k]);
+
+        v_store(dst + i, s);
+    }
+#else
+    (void)src; (void)dst; (void)kx; (void)ksize2; (void)width; (void)cn;
+#endif
+    return i;
+}
+
+int gaussianRow16u_simd(const ushort* src, unsigned* dst, const unsigned* kx, int ksize2, int width, int cn)
+{
+    int i = 0;
+#if CV_SIMD
+    const int VECSZ = v_uint32::nlanes;
+    const v_uint32 one = vx_setall_u32(1);
+
+    // the kernel sum is 65536, so the sums fit into 32 bits
+    for ( ; i <= width - VECSZ; i += VECSZ)
+    {
+        const ushort* S = src + i + ksize2*cn;
+        v_uint32 s = vx_load_expand(S)*vx_setall_u32(kx[0]);
+
+        for (int k = 1; k <= ksize2; k++)
+            s += (vx_load_expand(S - k*cn) + vx_load_expand(S + k*cn))*vx_setall_u32(kx[k]);
+
+        v_store(dst + i, v_shr<1>(s + one));
+    }
+#else
+    (void)src; (void)dst; (void)kx; (void)ksize2; (void)width; (void)cn;
+#endif
+    return i;
+}
+
+int gaussianColumn8u_simd(const ushort** src, uchar* dst, const ushort* ky, int ksize2, int width)
+{
+    int i = 0;
+#if CV_SIMD
+    const int VECSZ = v_uint16::nlanes;
+
+    for ( ; i <= width - VECSZ; i += VECSZ)
+    {
+        v_uint32 s0, s1, y0, y1;
+        v_mul_expand(vx_load(src[0] + i), vx_setall_u16(ky[0]), s0, s1);
+
+        for (int k = 1; k <= ksize2; k++)
+        {
+            // the sum of the symmetrical rows may not fit into 16 bits, so they are multiplied separately
+            v_uint16 f = vx_setall_u16(ky[k]);
+            v_mul_expand(vx_load(src[k] + i), f, y0, y1);
+            s0 += y0; s1 += y1;
+            v_mul_expand(vx_load(src[-k] + i), f, y0, y1);
+            s0 += y0; s1 += y1;
+        }
+
+        v_pack_store(dst + i, v_rshr_pack<16>(s0, s1));
+    }
+#else
+    (void)src; (void)dst; (void)ky; (void)ksize2; (void)width;
+#endif
+    return i;
+}
+
+int gaussianColumn16u_simd(const unsigned** src, ushort* dst, const unsigned* ky, int ksize2, int width)
+{
+    int i = 0;
+#if CV_SIMD
+    const int VECSZ = v_uint32::nlanes;
+
+    for ( ; i <= width - VECSZ*2; i += VECSZ*2)
+    {
+        v_uint64 s0, s1, s2, s3, y0, y1;
+        v_uint32 f = vx_setall_u32(ky[0]);
+        v_mul_expand(vx_load(src[0] + i), f, s0, s1);
+        v_mul_expand(vx_load(src[0] + i + VECSZ), f, s2, s3);
+
+        for (int k = 1; k <= ksize2; k++)
+        {
+            const unsigned *S = src[k] + i, *S2 = src[-k] + i;
+            f = vx_setall_u32(ky[k]);
+            v_mul_expand(vx_load(S) + vx_load(S2), f, y0, y1);
+            s0 += y0; s1 += y1;
+            v_mul_expand(vx_load(S + VECSZ) + vx_load(S2 + VECSZ), f, y0, y1);
+            s2 += y0; s3 += y1;
+        }
+
+        v_store(dst + i, v_pack(v_rshr_pack<31>(s0, s1), v_rshr_pack<31>(s2, s3)));
+    }
+#else
+    (void)src; (void)dst; (void)ky; (void)ksize2; (void)width;
+#endif
+    return i;
+}
+
+#endif // CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+CV_CPU_OPTIMIZATION_NAMESPACE_END
+} // namespace cv
@@ -287,4 +287,75 @@ namespace cvtest
         test.safe_run();
     }
 
+    // piecewise constant image with noise, so there are the edges to preserve and the noise to remove
+    static Mat makeBilateralTestImage(RNG& rng, Size size, int type)
+    {
+        Mat img(size, CV_MAKETYPE(CV_32F, CV_MAT_CN(type))), noise(img.size(), img.type()), dst;
+        img.setTo(Scalar::all(128));
+        for( int i = 0; i < 8; i++ )
+        {
+            Point c(rng.uniform(0, size.width), rng.uniform(0, size.height));
+            Scalar color(rng.uniform(0, 256), rng.uniform(0, 256), rng.uniform(0, 256));
+            if( i % 2 == 0 )
+                circle(img, c, rng.uniform(10, size.width/2), color, -1);
+            else
+                rectangle(img, Rect(c, Size(rng.uniform(10, size.width/2), rng.uniform(10, size.height/2))), color, -1);
+        }
+        rng.fill(noise, RNG::NORMAL, 0, 10);
+        img += noise;
+        img.convertTo(dst, type);
+        return dst;
+    }
+
+    TEST(Imgproc_BilateralFilter, approx_accuracy)
+    {
+        RNG& rng = theRNG();
+        const int types[] = { CV_8UC1, CV_8UC3, CV_32FC1, CV_32FC3 };
+
+        for( int iter = 0; iter < 8; iter++ )
+        {
+            int type = types[iter % 4];
+            double sigmaSpace = iter < 4 ? 3 : 6, sigmaColor = iter < 4 ? 30 : 50;
+            Mat src = makeBilateralTestImage(rng, Size(rng.uniform(100, 200), rng.uniform(100, 200)), type);
+            Mat exact, approx;
+
+            // the exact filter with the neighborhood of +/-3 sigmas
+            bilateralFilter(src, exact, 6*(int)sigmaSpace + 1, sigmaColor, sigmaSpace, BORDER_REFLECT_101, BILATERAL_EXACT);
+            bilateralFilter(src, approx, 0, sigmaColor, sigmaSpace, BORDER_DEFAULT, BILATERAL_APPROX);
+            src.convertTo(src, CV_32F);
+            exact.convertTo(exact, CV_32F);
+            approx.convertTo(approx, CV_32F);
+
+            // the filters are compared away from the borders, which are handled differently
+            int b = 3*(int)sigmaSpace;
+            Rect roi(b, b, src.cols - 2*b, src.rows - 2*b);
+            double srcErr = cvtest::norm(src(roi), exact(roi), NORM_L1)/(roi.area()*src.channels());
+            double err = cvtest::norm(approx(roi), exact(roi), NORM_L1)/(roi.area()*src.channels());
+
+            // the approximation error should be small comparing with the effect of the filter
+            EXPECT_LE(err, 0.25*srcErr) << "type=" << type << " sigmaSpace=" << sigmaSpace;
+            EXPECT_LE(err, 2.) << "type=" << type << " sigmaSpace=" << sigmaSpace;
+        }
+    }
+
+    TEST(Imgproc_BilateralFilter, approx_threads)
+    {
+        RNG& rng = theRNG();
+        int nthreads = cv::getNumThreads();
+
+        for( int iter = 0; iter < 4; iter++ )
+        {
+            int type = iter % 2 == 0 ? CV_8UC3 : CV_32FC1;
+            Mat src = makeBilateralTestImage(rng, Size(rng.uniform(200, 600), rng.uniform(200, 600)), type);
+            Mat dst[2];
+
+            cv::setNumThreads(1);
+            bilateralFilter(src, dst[0], 0, 40, 5, BORDER_DEFAULT, BILATERAL_APPROX);
+            cv::setNumThreads(nthreads);
+            bilateralFilter(src, dst[1], 0, 40, 5, BORDER_DEFAULT, BILATERAL_APPROX);
+
+            ASSERT_EQ(0, cvtest::norm(dst[0], dst[1], NORM_INF)) << "type=" << type;
+        }
+    }
+
 } // end of namespace cvtest
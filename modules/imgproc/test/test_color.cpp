@@ -2190,3 +2190,27 @@ TEST(ImgProc_Bayer2RGBA, accuracy)
         }
     }
 }
+
+// the dispatched AVX2/AVX-512 kernel must be bit-exact with the baseline one
+TEST(Imgproc_ColorGray, dispatch_bitexact)
+{
+    RNG& rng = theRNG();
+    bool useOptimized = cv::useOptimized();
+
+    for (int scn = 3; scn <= 4; scn++)
+    {
+        for (int width = 1; width <= 259; width += 17)
+        {
+            Mat src(3, width, CV_8UC(scn)), dst_opt, dst_ref;
+            rng.fill(src, RNG::UNIFORM, 0, 256);
+
+            cv::setUseOptimized(true);
+            cvtColor(src, dst_opt, scn == 3 ? COLOR_BGR2GRAY : COLOR_BGRA2GRAY);
+            cv::setUseOptimized(false);
+            cvtColor(src, dst_ref, scn == 3 ? COLOR_BGR2GRAY : COLOR_BGRA2GRAY);
+            cv::setUseOptimized(useOptimized);
+
+            ASSERT_EQ(0, cvtest::norm(dst_opt, dst_ref, NORM_INF)) << "scn=" << scn << " width=" << width;
+        }
+    }
+}
@@ -2015,3 +2015,260 @@ TEST(Imgproc_Morphology, iterated)
         ASSERT_EQ(0.0, norm(dst0, dst2, NORM_INF));
     }
 }
+
+// the dispatched AVX2/AVX-512 row filter must be bit-exact with the baseline one
+TEST(Imgproc_GaussianBlur, dispatch_bitexact)
+{
+    RNG& rng = theRNG();
+    bool useOptimized = cv::useOptimized();
+
+    for (int cn = 1; cn <= 3; cn += 2)
+    {
+        for (int width = 9; width <= 259; width += 25)
+        {
+            Mat src(7, width, CV_8UC(cn)), dst_opt, dst_ref;
+            rng.fill(src, RNG::UNIFORM, 0, 256);
+
+            cv::setUseOptimized(true);
+            GaussianBlur(src, dst_opt, Size(9, 9), 2.0);
+            cv::setUseOptimized(false);
+            GaussianBlur(src, dst_ref, Size(9, 9), 2.0);
+            cv::setUseOptimized(useOptimized);
+
+            ASSERT_EQ(0, cvtest::norm(dst_opt, dst_ref, NORM_INF)) << "cn=" << cn << " width=" << width;
+        }
+    }
+}
+
+// the stripe-parallel filtering must produce the same result as the serial one,
+// including the ROI, where the border rows of the stripes come from the parent image
+TEST(Imgproc_Filtering, stripes_bitexact)
+{
+    RNG& rng = theRNG();
+    int nthreads = cv::getNumThreads();
+    const int borderTypes[] = { BORDER_REPLICATE, BORDER_REFLECT_101, BORDER_CONSTANT, BORDER_REFLECT_101 | BORDER_ISOLATED };
+
+    for( int iter = 0; iter < 12; iter++ )
+    {
+        int ksize = 3 + 2*(iter % 6);
+        int borderType = borderTypes[iter % 4];
+        int type = iter % 3 == 0 ? CV_8UC1 : iter % 3 == 1 ? CV_8UC3 : CV_32FC1;
+        Mat whole(rng.uniform(400, 600), rng.uniform(300, 500), type);
+        rng.fill(whole, RNG::UNIFORM, 0, 256);
+        Mat src = whole(Rect(7, 11, whole.cols - 20, whole.rows - 30));
+
+        Mat kernel(ksize, ksize, CV_32F), kx(ksize, 1, CV_32F), ky(ksize, 1, CV_32F);
+        rng.fill(kernel, RNG::UNIFORM, -1, 1);
+        rng.fill(kx, RNG::UNIFORM, -1, 1);
+        rng.fill(ky, RNG::UNIFORM, -1, 1);
+        int ddepth = CV_MAT_DEPTH(type) == CV_8U ? CV_16S : CV_32F;
+        int lapksize = std::min(ksize, 7);
+
+        Mat dst[2][4];
+        for( int k = 0; k < 2; k++ )
+        {
+            cv::setNumThreads(k == 0 ? 1 : 4);
+            filter2D(src, dst[k][0], ddepth, kernel, Point(-1,-1), 0, borderType);
+            sepFilter2D(src, dst[k][1], ddepth, kx, ky, Point(-1,-1), 0, borderType);
+            Sobel(src, dst[k][2], ddepth, 1, 1, std::min(ksize, 7), 1, 0, borderType);
+            Laplacian(src, dst[k][3], ddepth, lapksize, 1, 0, borderType);
+        }
+        cv::setNumThreads(nthreads);
+
+        for( int i = 0; i < 4; i++ )
+            ASSERT_EQ(0, cvtest::norm(dst[0][i], dst[1][i], NORM_INF))
+                << "op=" << i << " ksize=" << ksize << " type=" << type << " border=" << borderType;
+    }
+}
+
+TEST(Imgproc_Filtering, stripes_inplace)
+{
+    int nthreads = cv::getNumThreads();
+    Mat src(480, 640, CV_32FC1), kernel(5, 5, CV_32F, Scalar::all(1./25));
+    randu(src, 0, 1);
+
+    Mat dst0, dst1 = src.clone();
+    cv::setNumThreads(4);
+    filter2D(src, dst0, -1, kernel);
+    filter2D(dst1, dst1, -1, kernel);
+    cv::setNumThreads(nthreads);
+
+    EXPECT_EQ(0, cvtest::norm(dst0, dst1, NORM_INF));
+}
+
+// the vectorized 8u, 16u and 16s row and column filters must give the same result as the 32f ones,
+// and the tiled processing the same result as the in-place one, which goes through the whole rows
+TEST(Imgproc_Filtering, sepFilter2D_tiles_bitexact)
+{
+    RNG& rng = theRNG();
+    const int types[] = { CV_8UC1, CV_8UC3, CV_16UC1, CV_16UC3, CV_16SC1 };
+    // the rows of these are wider than two tiles of the 128KB ring buffer, so they are split into several tiles
+    const struct { int type, ksize, width; } tiled[] =
+    {
+        { CV_8UC1, 7, 8000 }, { CV_16UC1, 9, 9000 }, { CV_16SC1, 15, 5000 }, { CV_8UC3, 31, 2000 }
+    };
+    const int nrandom = 20, ntiled = (int)(sizeof(tiled)/sizeof(tiled[0]));
+
+    for( int iter = 0; iter < nrandom + ntiled; iter++ )
+    {
+        bool fixedSize = iter >= nrandom;
+        int type = fixedSize ? tiled[iter - nrandom].type : types[iter % 5], depth = CV_MAT_DEPTH(type);
+        int ksize = fixedSize ? tiled[iter - nrandom].ksize : 7 + 2*rng.uniform(0, 13);
+        bool symmetrical = iter % 2 == 0;
+        int borderType = iter % 3 == 0 ? BORDER_CONSTANT : iter % 3 == 1 ? BORDER_REPLICATE : BORDER_REFLECT_101;
+
+        Mat whole(fixedSize ? 24 : rng.uniform(20, 60), fixedSize ? tiled[iter - nrandom].width : rng.uniform(1000, 2500), type);
+        rng.fill(whole, RNG::UNIFORM, 0, depth == CV_8U ? 256 : 4096);
+        Mat src = whole(Rect(3, 5, whole.cols - 9, whole.rows - 10));
+
+        Mat kx(1, ksize, CV_32F), ky(ksize, 1, CV_32F);
+        rng.fill(kx, RNG::UNIFORM, -1, 1);
+        rng.fill(ky, RNG::UNIFORM, 0, 1);
+        for( int k = 0; k < ksize/2; k++ )
+            ky.at<float>(ksize - k - 1) = symmetrical ? ky.at<float>(k) : -ky.at<float>(k);
+        if( !symmetrical )
+            ky.at<float>(ksize/2) = 0;
+
+        Mat dst, dst32f, ref, inplace = whole.clone();
+        sepFilter2D(src, dst, -1, kx, ky, Point(-1,-1), 0, borderType);
+
+        Mat src32f;
+        whole.convertTo(src32f, CV_32F);
+        sepFilter2D(src32f(Rect(3, 5, src.cols, src.rows)), dst32f, CV_32F, kx, ky, Point(-1,-1), 0, borderType);
+        dst32f.convertTo(ref, depth);
+        ASSERT_EQ(0, cvtest::norm(dst, ref, NORM_INF))
+            << "type=" << type << " ksize=" << ksize << " symmetrical=" << symmetrical;
+
+        Mat inplaceRoi = inplace(Rect(3, 5, src.cols, src.rows));
+        sepFilter2D(inplaceRoi, inplaceRoi, -1, kx, ky, Point(-1,-1), 0, borderType);
+        ASSERT_EQ(0, cvtest::norm(dst, inplaceRoi, NORM_INF))
+            << "type=" << type << " ksize=" << ksize << " border=" << borderType;
+    }
+}
+
+// the fixed-point 8u and 16u Gaussian blur must not depend on the instruction set, the number of threads
+// and the in-place processing, and must keep the constant images unchanged (the kernel sum is exactly 1)
+TEST(Imgproc_GaussianBlur, fixedpoint_bitexact)
+{
+    RNG& rng = theRNG();
+    bool useOptimized = cv::useOptimized();
+    int nthreads = cv::getNumThreads();
+
+    for( int iter = 0; iter < 24; iter++ )
+    {
+        int depth = iter % 2 == 0 ? CV_8U : CV_16U, cn = 1 + iter % 4;
+        int ksize = iter % 3 == 0 ? 0 : 3 + 2*rng.uniform(0, 15);
+        double sigma = ksize == 0 || iter % 4 == 1 ? rng.uniform(0.5, 8.) : 0.;
+        int borderType = iter % 3 == 0 ? BORDER_REFLECT_101 : iter % 3 == 1 ? BORDER_REPLICATE : BORDER_CONSTANT;
+
+        Mat whole(rng.uniform(100, 300), rng.uniform(7, 700), CV_MAKETYPE(depth, cn));
+        rng.fill(whole, RNG::UNIFORM, 0, depth == CV_8U ? 256 : 65536);
+        Mat src = whole(Rect(2, 3, whole.cols - 4, whole.rows - 6));
+
+        Mat dst[3];
+        cv::setNumThreads(1);
+        cv::setUseOptimized(false);
+        GaussianBlur(src, dst[0], Size(ksize, ksize), sigma, sigma, borderType);
+        cv::setUseOptimized(useOptimized);
+        cv::setNumThreads(4);
+        GaussianBlur(src, dst[1], Size(ksize, ksize), sigma, sigma, borderType);
+        cv::setNumThreads(nthreads);
+        dst[2] = whole.clone();
+        Mat inplace = dst[2](Rect(2, 3, src.cols, src.rows));
+        GaussianBlur(inplace, inplace, Size(ksize, ksize), sigma, sigma, borderType);
+
+        ASSERT_EQ(0, cvtest::norm(dst[0], dst[1], NORM_INF)) << "depth=" << depth << " cn=" << cn << " ksize=" << ksize;
+        ASSERT_EQ(0, cvtest::norm(dst[0], inplace, NORM_INF)) << "depth=" << depth << " cn=" << cn << " ksize=" << ksize;
+
+        Mat flat(src.size(), src.type(), Scalar::all(depth == CV_8U ? 255 : 65535)), flatDst;
+        GaussianBlur(flat, flatDst, Size(ksize, ksize), sigma, sigma, BORDER_REPLICATE);
+        ASSERT_EQ(0, cvtest::norm(flat, flatDst, NORM_INF)) << "depth=" << depth << " ksize=" << ksize;
+    }
+}
+
+TEST(Imgproc_GaussianBlur, fixedpoint_accuracy)
+{
+    RNG& rng = theRNG();
+
+    for( int iter = 0; iter < 20; iter++ )
+    {
+        int depth = iter % 2 == 0 ? CV_8U : CV_16U;
+        int ksize = 3 + 2*rng.uniform(0, 15);
+        double sigma = iter % 4 < 2 ? 0. : rng.uniform(0.5, 8.);
+
+        Mat src(rng.uniform(50, 200), rng.uniform(50, 200), depth), src32f, dst, dst32f, ref;
+        rng.fill(src, RNG::UNIFORM, 0, depth == CV_8U ? 256 : 65536);
+        src.convertTo(src32f, CV_32F);
+
+        GaussianBlur(src, dst, Size(ksize, ksize), sigma);
+        GaussianBlur(src32f, dst32f, Size(ksize, ksize), sigma);
+        dst32f.convertTo(ref, depth);
+
+        // the kernels are rounded to 8 and 16 fractional bits for 8u and 16u respectively
+        EXPECT_LE(cvtest::norm(dst, ref, NORM_INF), 4) << "ksize=" << ksize << " sigma=" << sigma;
+        EXPECT_LE(cvtest::norm(dst, ref, NORM_L1)/src.total(), 1.) << "ksize=" << ksize << " sigma=" << sigma;
+    }
+}
+
+template<typename T> static void
+test_medianBlurReplicate( const Mat& src, Mat& dst, int ksize )
+{
+    int r = ksize/2, cn = src.channels();
+    std::vector<T> buf(ksize*ksize);
+    dst.create(src.size(), src.type());
+
+    for( int y = 0; y < src.rows; y++ )
+        for( int x = 0; x < src.cols; x++ )
+            for( int c = 0; c < cn; c++ )
+            {
+                int k = 0;
+                for( int dy = -r; dy <= r; dy++ )
+                {
+                    const T* sptr = src.ptr<T>(std::min(std::max(y + dy, 0), src.rows - 1));
+                    for( int dx = -r; dx <= r; dx++ )
+                        buf[k++] = sptr[std::min(std::max(x + dx, 0), src.cols - 1)*cn + c];
+                }
+                std::nth_element(buf.begin(), buf.begin() + k/2, buf.end());
+                dst.ptr<T>(y)[x*cn + c] = buf[k/2];
+            }
+}
+
+TEST(Imgproc_MedianBlur, large_aperture)
+{
+    RNG& rng = theRNG();
+    int nthreads = cv::getNumThreads();
+
+    for( int iter = 0; iter < 18; iter++ )
+    {
+        int depth = iter % 3 == 0 ? CV_16U : iter % 3 == 1 ? CV_32F : CV_16S;
+        int cn = iter % 4 == 3 ? 4 : iter % 2 == 0 ? 1 : 3;
+        int ksize = 7 + 2*rng.uniform(0, 13);
+
+        Mat whole(rng.uniform(20, 150), rng.uniform(20, 300), CV_MAKETYPE(depth, cn));
+        if( depth == CV_32F )
+            rng.fill(whole, RNG::NORMAL, 0, 100);
+        else
+            // a narrow range produces a lot of equal values
+            rng.fill(whole, RNG::UNIFORM, depth == CV_16S ? -8 : 0, iter % 2 == 0 ? 16 : 65536);
+        Mat src = whole(Rect(2, 3, whole.cols - 4, whole.rows - 6)), ref;
+
+        if( depth == CV_16U )
+            test_medianBlurReplicate<ushort>(src, ref, ksize);
+        else if( depth == CV_16S )
+            test_medianBlurReplicate<short>(src, ref, ksize);
+        else
+            test_medianBlurReplicate<float>(src, ref, ksize);
+
+        Mat dst[2];
+        cv::setNumThreads(1);
+        medianBlur(src, dst[0], ksize);
+        cv::setNumThreads(nthreads);
+        medianBlur(src, dst[1], ksize);
+        Mat inplace = whole.clone()(Rect(2, 3, src.cols, src.rows));
+        medianBlur(inplace, inplace, ksize);
+
+        ASSERT_EQ(0, cvtest::norm(ref, dst[0], NORM_INF)) << "depth=" << depth << " cn=" << cn << " ksize=" << ksize;
+        ASSERT_EQ(0, cvtest::norm(ref, dst[1], NORM_INF)) << "depth=" << depth << " cn=" << cn << " ksize=" << ksize;
+        ASSERT_EQ(0, cvtest::norm(ref, inplace, NORM_INF)) << "depth=" << depth << " cn=" << cn << " ksize=" << ksize;
+    }
+}
@@ -1684,6 +1684,31 @@ TEST(Resize, Area_half)
     }
 }
 
+// the dispatched AVX2/AVX-512 vertical pass must be bit-exact with the baseline one
+TEST(Resize, Linear_8u_dispatch_bitexact)
+{
+    RNG& rng = theRNG();
+    bool useOptimized = cv::useOptimized();
+
+    for (int cn = 1; cn <= 4; cn += 3)
+    {
+        for (int width = 8; width <= 260; width += 28)
+        {
+            Mat src(16, width, CV_8UC(cn)), dst_opt, dst_ref;
+            rng.fill(src, RNG::UNIFORM, 0, 256);
+            Size dsize(width*3/2 + 1, 37);
+
+            cv::setUseOptimized(true);
+            resize(src, dst_opt, dsize, 0, 0, INTER_LINEAR);
+            cv::setUseOptimized(false);
+            resize(src, dst_ref, dsize, 0, 0, INTER_LINEAR);
+            cv::setUseOptimized(useOptimized);
+
+            ASSERT_EQ(0, cvtest::norm(dst_opt, dst_ref, NORM_INF)) << "cn=" << cn << " width=" << width;
+        }
+    }
+}
+
 TEST(Imgproc_Warp, multichannel)
 {
     RNG& rng = theRNG();